@@ -0,0 +1,171 @@
+#pragma once
+#include "HephAudioShared.h"
+#include "IAudioEncoder.h"
+#include "AudioRingBuffer.h"
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/** @file */
+
+/**
+ * default number of frames the encode thread passes to the wrapped encoder at once.
+ *
+ */
+#define HEPHAUDIO_ASYNC_ENCODER_DEFAULT_BLOCK_FRAME_COUNT (4096)
+
+/**
+ * default number of blocks the queue of the \link HephAudio::AsyncAudioEncoder AsyncAudioEncoder \endlink can hold.
+ *
+ */
+#define HEPHAUDIO_ASYNC_ENCODER_DEFAULT_BLOCK_COUNT (32)
+
+namespace HephAudio
+{
+	/**
+	 * what \link HephAudio::AsyncAudioEncoder::Encode AsyncAudioEncoder::Encode \endlink does when the queue is full.
+	 *
+	 */
+	enum EncoderOverrunPolicy
+	{
+		/**
+		 * the producer waits until the encode thread frees enough space, no audio is lost.
+		 *
+		 */
+		BlockProducer = 0,
+
+		/**
+		 * the frames that do not fit are dropped and counted, the producer never waits.
+		 * Suitable for real-time threads such as the capture thread.
+		 *
+		 */
+		DropNewest = 1
+	};
+
+	/**
+	 * @brief wraps another encoder and runs it on a dedicated thread.
+	 * \link HephAudio::AsyncAudioEncoder::Encode Encode \endlink only copies the frames to a preallocated lock-free queue,
+	 * so the producer is not stalled by the codec or the disk. Closing the file flushes the queue first, so no queued frame is lost.
+	 *
+	 */
+	class HEPH_API AsyncAudioEncoder final : public IAudioEncoder
+	{
+	private:
+		std::shared_ptr<IAudioEncoder> pEncoder;
+		/** locked while the wrapped encoder is in use. */
+		mutable std::mutex encoderMutex;
+		AudioRingBuffer queue;
+		size_t blockFrameCount;
+		size_t blockCount;
+		std::atomic<EncoderOverrunPolicy> overrunPolicy;
+		std::thread encodeThread;
+		std::mutex signalMutex;
+		std::condition_variable dataCondition;
+		std::condition_variable spaceCondition;
+		std::atomic_bool isClosing;
+		std::atomic_bool isFailed;
+		std::exception_ptr pException;
+
+	public:
+		/**
+		 * @copydoc constructor
+		 *
+		 * @param pEncoder encoder that will run on the encode thread.
+		 * @param blockFrameCount number of frames passed to the wrapped encoder at once.
+		 * @param blockCount number of blocks the queue can hold.
+		 * @param overrunPolicy what to do when the queue is full.
+		 */
+		explicit AsyncAudioEncoder(std::shared_ptr<IAudioEncoder> pEncoder,
+			size_t blockFrameCount = HEPHAUDIO_ASYNC_ENCODER_DEFAULT_BLOCK_FRAME_COUNT,
+			size_t blockCount = HEPHAUDIO_ASYNC_ENCODER_DEFAULT_BLOCK_COUNT,
+			EncoderOverrunPolicy overrunPolicy = BlockProducer);
+
+		AsyncAudioEncoder(const AsyncAudioEncoder&) = delete;
+
+		/** @copydoc destructor */
+		~AsyncAudioEncoder();
+
+		AsyncAudioEncoder& operator=(const AsyncAudioEncoder&) = delete;
+		void ChangeFile(const std::filesystem::path& newAudioFilePath, const AudioFormatInfo& outputFormatInfo, bool overwrite) override;
+
+		/**
+		 * waits until the queued frames are encoded, then closes the file.
+		 * Must not be called while the producer thread is in \link HephAudio::AsyncAudioEncoder::Encode Encode \endlink.
+		 * If the encode thread failed, the exception is rethrown after the file is closed.
+		 *
+		 */
+		void CloseFile() override;
+
+		bool IsFileOpen() const override;
+
+		/**
+		 * queues the frames for encoding, must only be called from a single producer thread.
+		 * The first call allocates the queue with the format of the buffer, later buffers must have the same channel layout and sample rate.
+		 * If the encode thread failed, its exception is rethrown.
+		 *
+		 */
+		void Encode(const AudioBuffer& bufferToEncode) override;
+
+		/**
+		 * encodes the provided audio data synchronously with the wrapped encoder.
+		 *
+		 */
+		void Encode(const AudioBuffer& inputBuffer, EncodedAudioBuffer& outputBuffer) override;
+
+		/**
+		 * transcodes the provided audio data synchronously with the wrapped encoder.
+		 *
+		 */
+		void Transcode(const EncodedAudioBuffer& inputBuffer, EncodedAudioBuffer& outputBuffer) override;
+
+		/**
+		 * gets the wrapped encoder.
+		 *
+		 */
+		std::shared_ptr<IAudioEncoder> GetEncoder() const;
+
+		/**
+		 * gets what \link HephAudio::AsyncAudioEncoder::Encode Encode \endlink does when the queue is full.
+		 *
+		 */
+		EncoderOverrunPolicy GetOverrunPolicy() const;
+
+		/**
+		 * sets what \link HephAudio::AsyncAudioEncoder::Encode Encode \endlink does when the queue is full.
+		 *
+		 */
+		void SetOverrunPolicy(EncoderOverrunPolicy overrunPolicy);
+
+		/**
+		 * gets the maximum number of frames the queue can hold.
+		 *
+		 */
+		size_t GetQueueCapacity() const;
+
+		/**
+		 * gets the number of frames waiting to be encoded.
+		 *
+		 */
+		size_t GetQueuedFrameCount() const;
+
+		/**
+		 * gets the number of \link HephAudio::AsyncAudioEncoder::Encode Encode \endlink calls that dropped frames since the first call for the current file.
+		 *
+		 */
+		uint64_t GetOverrunCount() const;
+
+		/**
+		 * gets the total number of frames dropped since the first \link HephAudio::AsyncAudioEncoder::Encode Encode \endlink call for the current file.
+		 *
+		 */
+		uint64_t GetDroppedFrameCount() const;
+
+	private:
+		void StopEncodeThread();
+		void EncodeThread();
+		void ThrowIfFailed();
+	};
+}
\ No newline at end of file
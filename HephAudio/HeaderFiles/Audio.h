@@ -37,6 +37,12 @@ namespace HephAudio
 #if defined(__linux__) && !defined(__ANDROID__)
 		ALSA,
 #endif
+
+		/**
+		 * no audio hardware, see \link HephAudio::Native::NullAudio NullAudio \endlink.
+		 *
+		 */
+		Headless
 	};
 
 	/**
@@ -81,12 +87,69 @@ namespace HephAudio
 		/** @copydoc HephAudio::Native::NativeAudio::SetAudioDecoder */
 		void SetAudioDecoder(std::shared_ptr<IAudioDecoder> pNewDecoder);
 
+		/** @copydoc HephAudio::Native::NativeAudio::GetAudioDecoderFactory */
+		Native::AudioDecoderFactory GetAudioDecoderFactory() const;
+
+		/** @copydoc HephAudio::Native::NativeAudio::SetAudioDecoderFactory */
+		void SetAudioDecoderFactory(Native::AudioDecoderFactory newDecoderFactory);
+
 		/** @copydoc HephAudio::Native::NativeAudio::GetAudioEncoder */
 		std::shared_ptr<IAudioEncoder> GetAudioEncoder() const;
 
 		/** @copydoc HephAudio::Native::NativeAudio::SetAudioEncoder */
 		void SetAudioEncoder(std::shared_ptr<IAudioEncoder> pNewEncoder);
 
+		/** @copydoc HephAudio::Native::NativeAudio::GetAssetCache */
+		std::shared_ptr<AudioAssetCache> GetAssetCache() const;
+
+		/** @copydoc HephAudio::Native::NativeAudio::SetAssetCache */
+		void SetAssetCache(std::shared_ptr<AudioAssetCache> pNewAssetCache);
+
+		/** @copydoc HephAudio::Native::NativeAudio::GetCompressedResidencyThreshold */
+		size_t GetCompressedResidencyThreshold() const;
+
+		/** @copydoc HephAudio::Native::NativeAudio::SetCompressedResidencyThreshold */
+		void SetCompressedResidencyThreshold(size_t threshold_frame);
+
+		/** @copydoc HephAudio::Native::NativeAudio::GetMaxRealVoiceCount */
+		size_t GetMaxRealVoiceCount() const;
+
+		/** @copydoc HephAudio::Native::NativeAudio::SetMaxRealVoiceCount */
+		void SetMaxRealVoiceCount(size_t maxRealVoiceCount);
+
+		/** @copydoc HephAudio::Native::NativeAudio::GetVoiceStealingPolicy */
+		Native::VoiceStealingPolicy GetVoiceStealingPolicy() const;
+
+		/** @copydoc HephAudio::Native::NativeAudio::SetVoiceStealingPolicy */
+		void SetVoiceStealingPolicy(Native::VoiceStealingPolicy voiceStealingPolicy);
+
+		/** @copydoc HephAudio::Native::NativeAudio::GetVirtualVolumeThreshold */
+		double GetVirtualVolumeThreshold() const;
+
+		/** @copydoc HephAudio::Native::NativeAudio::SetVirtualVolumeThreshold */
+		void SetVirtualVolumeThreshold(double virtualVolumeThreshold);
+
+		/** @copydoc HephAudio::Native::NativeAudio::CreateBus */
+		AudioBus* CreateBus(const std::string& name, const std::string& outputBusName = "");
+
+		/** @copydoc HephAudio::Native::NativeAudio::DestroyBus */
+		bool DestroyBus(const std::string& name);
+
+		/** @copydoc HephAudio::Native::NativeAudio::GetBus */
+		AudioBus* GetBus(const std::string& name);
+
+		/** @copydoc HephAudio::Native::NativeAudio::GetMasterBus */
+		AudioBus* GetMasterBus();
+
+		/** @copydoc HephAudio::Native::NativeAudio::GetBusCount */
+		size_t GetBusCount() const;
+
+		/** @copydoc HephAudio::Native::NativeAudio::GetBusThreadCount */
+		size_t GetBusThreadCount() const;
+
+		/** @copydoc HephAudio::Native::NativeAudio::SetBusThreadCount */
+		void SetBusThreadCount(size_t threadCount);
+
 		/** @copydoc HephAudio::Native::NativeAudio::Play(const std::filesystem::path&) */
 		AudioObject* Play(const std::filesystem::path& filePath);
 
@@ -99,6 +162,26 @@ namespace HephAudio
 		/** @copydoc HephAudio::Native::NativeAudio::Load(const std::filesystem::path&,uint32_t) */
 		AudioObject* Load(const std::filesystem::path& filePath, uint32_t playCount);
 
+		/** @copydoc HephAudio::Native::NativeAudio::PlayAsync(const std::filesystem::path&) */
+		std::future<AudioObject*> PlayAsync(const std::filesystem::path& filePath);
+
+		/** @copydoc HephAudio::Native::NativeAudio::PlayAsync(const std::filesystem::path&,uint32_t) */
+		std::future<AudioObject*> PlayAsync(const std::filesystem::path& filePath, uint32_t playCount);
+
+		/** @copydoc HephAudio::Native::NativeAudio::LoadAsync(const std::filesystem::path&) */
+		std::future<AudioObject*> LoadAsync(const std::filesystem::path& filePath);
+
+		/** @copydoc HephAudio::Native::NativeAudio::LoadAsync(const std::filesystem::path&,uint32_t) */
+		std::future<AudioObject*> LoadAsync(const std::filesystem::path& filePath, uint32_t playCount);
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+		/** @copydoc HephAudio::Native::NativeAudio::AwaitPlay */
+		Native::AudioObjectAwaitable AwaitPlay(const std::filesystem::path& filePath, uint32_t playCount = 1);
+
+		/** @copydoc HephAudio::Native::NativeAudio::AwaitLoad */
+		Native::AudioObjectAwaitable AwaitLoad(const std::filesystem::path& filePath, uint32_t playCount = 1);
+#endif
+
 		/** @copydoc HephAudio::Native::NativeAudio::CreateAudioObject */
 		AudioObject* CreateAudioObject(const std::string& name, size_t bufferFrameCount, AudioChannelLayout channelLayout, uint32_t sampleRate);
 
@@ -141,6 +224,27 @@ namespace HephAudio
 		/** @copydoc HephAudio::Native::NativeAudio::SetDeviceEnumerationPeriod */
 		void SetDeviceEnumerationPeriod(uint32_t deviceEnumerationPeriod_ms);
 
+		/** @copydoc HephAudio::Native::NativeAudio::GetRenderMetrics() */
+		Native::RenderMetrics& GetRenderMetrics();
+
+		/** @copydoc HephAudio::Native::NativeAudio::GetRenderMetrics() const */
+		const Native::RenderMetrics& GetRenderMetrics() const;
+
+		/** @copydoc HephAudio::Native::NativeAudio::GetCaptureRingBuffer */
+		AudioRingBuffer& GetCaptureRingBuffer();
+
+		/** @copydoc HephAudio::Native::NativeAudio::GetCaptureRingBufferDuration */
+		uint32_t GetCaptureRingBufferDuration() const;
+
+		/** @copydoc HephAudio::Native::NativeAudio::SetCaptureRingBufferDuration */
+		void SetCaptureRingBufferDuration(uint32_t captureRingBufferDuration_ms);
+
+		/** @copydoc HephAudio::Native::NativeAudio::GetRenderDitherMode */
+		DitherMode GetRenderDitherMode() const;
+
+		/** @copydoc HephAudio::Native::NativeAudio::SetRenderDitherMode */
+		void SetRenderDitherMode(DitherMode ditherMode);
+
 		/** @copydoc HephAudio::Native::NativeAudio::SetMasterVolume */
 		void SetMasterVolume(double volume);
 
@@ -0,0 +1,155 @@
+#pragma once
+#include "HephAudioShared.h"
+#include "AudioBuffer.h"
+#include "CompressedAudioBuffer.h"
+#include "IAudioDecoder.h"
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/** @file */
+
+/**
+ * default memory budget of the \link HephAudio::AudioAssetCache AudioAssetCache \endlink in bytes.
+ *
+ */
+#define HEPHAUDIO_ASSET_CACHE_DEFAULT_BUDGET (256ull * 1024 * 1024)
+
+namespace HephAudio
+{
+	/**
+	 * @brief stores the decoded audio files so the objects that play the same file share a single copy of the samples.
+	 * Entries are keyed by the file path and its last modification time, a modified file is decoded again.
+	 * When the total size exceeds the memory budget the least recently used entries that are not referenced outside of the cache are evicted.
+	 * All methods are thread safe.
+	 *
+	 */
+	class HEPH_API AudioAssetCache final
+	{
+	private:
+		struct Entry
+		{
+			std::string key;
+			std::filesystem::file_time_type lastWriteTime;
+			std::shared_ptr<const AudioBuffer> pBuffer;
+			std::shared_ptr<const CompressedAudioBuffer> pCompressedBuffer;
+			size_t size_byte;
+		};
+
+	private:
+		mutable std::mutex mutex;
+		/** most recently used entry is at the front. */
+		std::list<Entry> entries;
+		std::unordered_map<std::string, std::list<Entry>::iterator> entryMap;
+		size_t memoryBudget_byte;
+		size_t memoryUsage_byte;
+		size_t hitCount;
+		size_t missCount;
+
+	public:
+		/** @copydoc default_constructor */
+		AudioAssetCache();
+
+		/**
+		 * @copydoc constructor
+		 *
+		 * @param memoryBudget_byte maximum number of bytes the unreferenced entries can occupy before they are evicted.
+		 */
+		explicit AudioAssetCache(size_t memoryBudget_byte);
+
+		AudioAssetCache(const AudioAssetCache&) = delete;
+		AudioAssetCache& operator=(const AudioAssetCache&) = delete;
+
+		/**
+		 * gets the decoded audio data of the file, decodes the file if it's not cached or modified since it was cached.
+		 * The cache is not locked while decoding, hence different files can be decoded in parallel.
+		 *
+		 * @param filePath path of the file.
+		 * @param decoder decoder that will be used on a cache miss. The file is closed after decoding.
+		 * @return the shared audio data, never nullptr.
+		 */
+		std::shared_ptr<const AudioBuffer> Get(const std::filesystem::path& filePath, IAudioDecoder& decoder);
+
+		/**
+		 * gets the compressed audio data of the file, compresses the file if it's not cached or modified since it was cached.
+		 * Cached separately from the data returned by \link AudioAssetCache::Get Get \endlink, the memory usage is the size of the compressed data.
+		 *
+		 * @param filePath path of the file.
+		 * @param decoder decoder that will be used on a cache miss. The file is closed after compressing.
+		 * @return the shared compressed audio data, never nullptr.
+		 */
+		std::shared_ptr<const CompressedAudioBuffer> GetCompressed(const std::filesystem::path& filePath, IAudioDecoder& decoder);
+
+		/**
+		 * checks whether the decoded data of the file is cached.
+		 *
+		 */
+		bool Contains(const std::filesystem::path& filePath) const;
+
+		/**
+		 * removes the decoded and compressed data of the file from the cache. The objects that reference its data keep them alive.
+		 *
+		 * @return true if the file was cached, otherwise false.
+		 */
+		bool Remove(const std::filesystem::path& filePath);
+
+		/**
+		 * removes all entries.
+		 *
+		 */
+		void Clear();
+
+		/**
+		 * evicts the least recently used unreferenced entries until the memory usage is within the budget.
+		 *
+		 */
+		void Trim();
+
+		/**
+		 * gets the memory budget in bytes.
+		 *
+		 */
+		size_t GetMemoryBudget() const;
+
+		/**
+		 * sets the memory budget in bytes and evicts the entries that no longer fit.
+		 *
+		 */
+		void SetMemoryBudget(size_t memoryBudget_byte);
+
+		/**
+		 * gets the total size of the cached audio data in bytes.
+		 *
+		 */
+		size_t GetMemoryUsage() const;
+
+		/**
+		 * gets the number of cached files.
+		 *
+		 */
+		size_t GetEntryCount() const;
+
+		/**
+		 * gets the number of \link AudioAssetCache::Get Get \endlink and \link AudioAssetCache::GetCompressed GetCompressed \endlink calls that were served from the cache.
+		 *
+		 */
+		size_t GetHitCount() const;
+
+		/**
+		 * gets the number of \link AudioAssetCache::Get Get \endlink and \link AudioAssetCache::GetCompressed GetCompressed \endlink calls that decoded the file.
+		 *
+		 */
+		size_t GetMissCount() const;
+
+	private:
+		static std::string GetKey(const std::filesystem::path& filePath);
+		Entry* FindEntry(const std::string& key, std::filesystem::file_time_type lastWriteTime);
+		void InsertEntry(Entry&& entry);
+		bool EraseKey(const std::string& key);
+		void EraseEntry(std::list<Entry>::iterator it);
+		void TrimInternal();
+	};
+}
\ No newline at end of file
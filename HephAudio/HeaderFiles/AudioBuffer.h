@@ -9,10 +9,14 @@
 namespace HephAudio
 {
 	/**
-	 * @brief class for storing the audio samples in internal format.
+	 * @brief class for storing the audio samples in the provided sample type.
+	 * Instantiated for <b>int16_t</b>, <b>int32_t</b>, <b>int64_t</b>, <b>float</b> and <b>double</b>, 
+	 * use \link HephAudio::SampleFormatConverter::Convert SampleFormatConverter::Convert \endlink to convert between them.
 	 * 
+	 * @tparam Tdata type of the samples, integer samples are full scale at 2^(bits - 1) and floating point samples at 1.
 	 */
-	class HEPH_API AudioBuffer final : public Heph::SignedArithmeticBuffer<AudioBuffer, heph_audio_sample_t>
+	template <typename Tdata>
+	class HEPH_API BasicAudioBuffer final : public Heph::SignedArithmeticBuffer<BasicAudioBuffer<Tdata>, Tdata>
 	{
 	private:
 		size_t frameCount;
@@ -20,7 +24,7 @@ namespace HephAudio
 
 	public:
 		/** @copydoc default_constructor */
-		AudioBuffer();
+		BasicAudioBuffer();
 
 		/**
 		 * @copydoc constructor
@@ -29,45 +33,45 @@ namespace HephAudio
 		 * @param channelLayout channel layout of the buffer.
 		 * @param sampleRate sample rate of the buffer.
 		 */
-		AudioBuffer(size_t frameCount, const AudioChannelLayout& channelLayout, uint32_t sampleRate);
+		BasicAudioBuffer(size_t frameCount, const AudioChannelLayout& channelLayout, uint32_t sampleRate);
 
 		/**
-		 * @copydoc AudioBuffer(size_t,const AudioChannelLayout&,uint32_t)
+		 * @copydoc BasicAudioBuffer(size_t,const AudioChannelLayout&,uint32_t)
 		 * 
 		 * @param flags flags.
 		 */
-		AudioBuffer(size_t frameCount, const AudioChannelLayout& channelLayout, uint32_t sampleRate, Heph::BufferFlags flags);
+		BasicAudioBuffer(size_t frameCount, const AudioChannelLayout& channelLayout, uint32_t sampleRate, Heph::BufferFlags flags);
 		
 		/** @copydoc copy_constructor */
-		AudioBuffer(const AudioBuffer& rhs);
+		BasicAudioBuffer(const BasicAudioBuffer& rhs);
 		
 		/** @copydoc move_constructor */
-		AudioBuffer(AudioBuffer&& rhs) noexcept;
+		BasicAudioBuffer(BasicAudioBuffer&& rhs) noexcept;
 		
 		/** @copydoc destructor */
-		~AudioBuffer();
+		~BasicAudioBuffer();
 		
-		AudioBuffer& operator=(const AudioBuffer& rhs);
-		AudioBuffer& operator=(AudioBuffer&& rhs) noexcept;
-		AudioBuffer operator<<(size_t rhs) const override;
-		AudioBuffer& operator<<=(size_t rhs) override;
-		AudioBuffer operator>>(size_t rhs) const override;
-		AudioBuffer& operator>>=(size_t rhs) override;
-		bool operator==(const AudioBuffer& rhs) const override;
+		BasicAudioBuffer& operator=(const BasicAudioBuffer& rhs);
+		BasicAudioBuffer& operator=(BasicAudioBuffer&& rhs) noexcept;
+		BasicAudioBuffer operator<<(size_t rhs) const override;
+		BasicAudioBuffer& operator<<=(size_t rhs) override;
+		BasicAudioBuffer operator>>(size_t rhs) const override;
+		BasicAudioBuffer& operator>>=(size_t rhs) override;
+		bool operator==(const BasicAudioBuffer& rhs) const override;
 
 		/**
 		 * gets the pointer to the first sample of the audio frame at the provided index.
 		 * 
 		 */
-		heph_audio_sample_t* operator[](size_t frameIndex) const;
+		Tdata* operator[](size_t frameIndex) const;
 		
 		void Release() override;
-		AudioBuffer SubBuffer(size_t frameIndex, size_t frameCount) const override;
-		void Prepend(const AudioBuffer& rhs) override;
-		void Append(const AudioBuffer& rhs) override;
-		void Insert(const AudioBuffer& rhs, size_t frameIndex) override;
+		BasicAudioBuffer SubBuffer(size_t frameIndex, size_t frameCount) const override;
+		void Prepend(const BasicAudioBuffer& rhs) override;
+		void Append(const BasicAudioBuffer& rhs) override;
+		void Insert(const BasicAudioBuffer& rhs, size_t frameIndex) override;
 		void Cut(size_t frameIndex, size_t frameCount) override;
-		void Replace(const AudioBuffer& rhs, size_t frameIndex, size_t frameCount) override;
+		void Replace(const BasicAudioBuffer& rhs, size_t frameIndex, size_t frameCount) override;
 		void Resize(size_t newFrameCount) override;
 		void Reverse() override;
 
@@ -95,10 +99,48 @@ namespace HephAudio
 		 */
 		void SetSampleRate(uint32_t sampleRate);
 
+		/**
+		 * creates the format of the buffers that store \a Tdata samples.
+		 * 
+		 * @param channelLayout channel layout of the buffer.
+		 * @param sampleRate sample rate of the buffer.
+		 */
+		static AudioFormatInfo CreateFormatInfo(const AudioChannelLayout& channelLayout, uint32_t sampleRate);
+
 	private:
 		static inline bool ADD_EVENT_HANDLERS = false;
 		static void AddEventHandlers();
 		static void ResultCreatedEventHandler(const Heph::EventParams& params);
 		static void ResultCreatedEventHandlerBuffer(const Heph::EventParams& params);
 	};
+
+	/**
+	 * @brief class for storing the audio samples in internal format.
+	 * 
+	 */
+	using AudioBuffer = BasicAudioBuffer<heph_audio_sample_t>;
+
+	/**
+	 * @brief class for storing the audio samples as signed 16 bit integers, for example to halve the memory used by the assets.
+	 * 
+	 */
+	using AudioBufferS16 = BasicAudioBuffer<int16_t>;
+
+	/**
+	 * @brief class for storing the audio samples as signed 32 bit integers.
+	 * 
+	 */
+	using AudioBufferS32 = BasicAudioBuffer<int32_t>;
+
+	/**
+	 * @brief class for storing the audio samples as 32 bit IEEE floats.
+	 * 
+	 */
+	using AudioBufferF32 = BasicAudioBuffer<float>;
+
+	/**
+	 * @brief class for storing the audio samples as 64 bit IEEE floats, for example for processing that requires higher precision.
+	 * 
+	 */
+	using AudioBufferF64 = BasicAudioBuffer<double>;
 }
\ No newline at end of file
@@ -0,0 +1,115 @@
+#pragma once
+#include "HephAudioShared.h"
+#include "AudioBuffer.h"
+#include "AudioEffects/AudioEffect.h"
+#include <string>
+#include <vector>
+#include <memory>
+
+/** @file */
+
+/**
+ * name of the bus every other bus and audio object is eventually mixed into.
+ *
+ */
+#define HEPHAUDIO_MASTER_BUS_NAME "master"
+
+namespace HephAudio
+{
+	/**
+	 * @brief sends a copy of the audio to a bus in addition to the regular output, for example to share a reverb between multiple buses.
+	 *
+	 */
+	struct HEPH_API AudioBusSend
+	{
+		/**
+		 * name of the bus that receives the audio.
+		 *
+		 */
+		std::string busName;
+
+		/**
+		 * gain applied to the sent audio.
+		 *
+		 */
+		double level;
+
+		/** @copydoc default_constructor */
+		AudioBusSend();
+
+		/**
+		 * @copydoc constructor
+		 *
+		 * @param busName @copydetails busName
+		 * @param level @copydetails level
+		 */
+		AudioBusSend(const std::string& busName, double level);
+	};
+
+	/**
+	 * @brief mixes the audio objects and the buses routed to it, applies its effects, then passes the result to its output bus.
+	 * Created via \link HephAudio::Native::NativeAudio::CreateBus NativeAudio::CreateBus \endlink.
+	 *
+	 */
+	struct HEPH_API AudioBus
+	{
+		friend class AudioBusGraph;
+
+		/**
+		 * unique name of the bus.
+		 *
+		 */
+		std::string name;
+
+		/**
+		 * name of the bus the output is mixed into, empty for the master bus.
+		 * Ignored for the master bus and for the routes that would form a cycle.
+		 *
+		 */
+		std::string outputBusName;
+
+		/**
+		 * gain applied to the output of the bus, also applies to the sends.
+		 *
+		 */
+		double volume;
+
+		/**
+		 * effects applied in order to the mixed audio each render period.
+		 * The effects must not change the channel layout or the sample rate, and must not be shared with other buses since the buses are processed in parallel.
+		 *
+		 */
+		std::vector<std::shared_ptr<AudioEffect>> effects;
+
+		/**
+		 * buses that receive a copy of the output, sends that would form a cycle are ignored.
+		 *
+		 */
+		std::vector<AudioBusSend> sends;
+
+	private:
+		/** audio mixed into the bus in the current period, the output buffer of the mix for the master bus. */
+		AudioBuffer buffer;
+		AudioBuffer* pBuffer;
+		AudioBus* pOutputBus;
+		std::vector<double> resolvedSendLevels;
+		std::vector<AudioBus*> resolvedSendBuses;
+		size_t height;
+		uint8_t visitState;
+
+	public:
+		/** @copydoc default_constructor */
+		AudioBus();
+
+		/**
+		 * @copydoc constructor
+		 *
+		 * @param name @copydetails name
+		 * @param outputBusName @copydetails outputBusName
+		 */
+		AudioBus(const std::string& name, const std::string& outputBusName);
+
+		AudioBus(const AudioBus&) = delete;
+		AudioBus& operator=(const AudioBus&) = delete;
+	};
+}
\ No newline at end of file
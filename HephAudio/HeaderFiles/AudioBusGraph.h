@@ -0,0 +1,148 @@
+#pragma once
+#include "HephAudioShared.h"
+#include "AudioBus.h"
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/** @file */
+
+namespace HephAudio
+{
+	/**
+	 * @brief routes the buses into each other and processes them each render period.
+	 * The buses are processed from the ones farthest from the master bus towards it. Buses at the same distance do not depend on each other,
+	 * so their effects can be applied in parallel by worker threads while the render thread processes one of them.
+	 * By default the buses are processed on the render thread only. The workers are started when the thread count is set to more than 1
+	 * and sleep between the levels, hence processing a period does not create threads or allocate.
+	 * The routing is resolved each period, hence the fields of the buses can be changed between the periods.
+	 *
+	 * @note not thread safe, \link HephAudio::Native::NativeAudio NativeAudio \endlink locks the audio objects while using it.
+	 *
+	 */
+	class HEPH_API AudioBusGraph final
+	{
+	private:
+		/** the master bus is always the first one. */
+		std::list<AudioBus> buses;
+		std::unordered_map<std::string, AudioBus*> busMap;
+		/** buses grouped by their distance to the master bus. */
+		std::vector<std::vector<AudioBus*>> levels;
+		size_t threadCount;
+		std::vector<std::thread> workers;
+
+		// the level that's processed in parallel, buses are claimed by incrementing the low 32 bits of levelTask.
+		// the workers wait for levelGeneration to change, the fields other than the atomics are guarded by levelMutex.
+		// levelException holds the first exception thrown by the effects of the level, it's rethrown by the render thread.
+		AudioBus* const* pLevelBuses;
+		size_t levelBusCount;
+		uint32_t levelGeneration;
+		bool stopWorkers;
+		std::exception_ptr levelException;
+		std::atomic<uint64_t> levelTask;
+		std::atomic<size_t> levelRemainingCount;
+		std::mutex levelMutex;
+		std::condition_variable levelCondition;
+		std::condition_variable workerCondition;
+
+	public:
+		/** @copydoc default_constructor */
+		AudioBusGraph();
+
+		AudioBusGraph(const AudioBusGraph&) = delete;
+
+		/** @copydoc destructor */
+		~AudioBusGraph();
+
+		AudioBusGraph& operator=(const AudioBusGraph&) = delete;
+
+		/**
+		 * creates a bus.
+		 *
+		 * @param name unique name of the bus.
+		 * @param outputBusName name of the bus the output is mixed into, empty for the master bus.
+		 * @return pointer to the bus, valid until it's destroyed.
+		 */
+		AudioBus* CreateBus(const std::string& name, const std::string& outputBusName);
+
+		/**
+		 * destroys a bus, the buses and the audio objects routed to it are mixed into the master bus instead.
+		 *
+		 * @param name name of the bus.
+		 * @return true if the bus is found and destroyed, otherwise false. The master bus can not be destroyed.
+		 */
+		bool DestroyBus(const std::string& name);
+
+		/**
+		 * gets a bus.
+		 *
+		 * @param name name of the bus.
+		 * @return pointer to the bus if found, otherwise nullptr.
+		 */
+		AudioBus* GetBus(const std::string& name);
+
+		/**
+		 * gets the bus every other bus is eventually mixed into.
+		 *
+		 */
+		AudioBus& GetMasterBus();
+
+		/**
+		 * gets the number of buses, including the master bus.
+		 *
+		 */
+		size_t GetBusCount() const;
+
+		/**
+		 * gets the maximum number of threads, including the render thread, that process the buses.
+		 *
+		 */
+		size_t GetThreadCount() const;
+
+		/**
+		 * sets the maximum number of threads, including the render thread, that process the buses. The default is 1.
+		 *
+		 * @param threadCount 1 to process the buses on the render thread only, 0 to use the number of hardware threads.
+		 */
+		void SetThreadCount(size_t threadCount);
+
+		/**
+		 * prepares the buses for mixing a new period.
+		 *
+		 * @param outputBuffer receives the output of the master bus, must be cleared by the caller.
+		 * Its frame count and format are used for the other buses as well.
+		 */
+		void BeginPeriod(AudioBuffer& outputBuffer);
+
+		/**
+		 * gets the buffer the audio routed to a bus is mixed into, must be called after \link AudioBusGraph::BeginPeriod BeginPeriod \endlink.
+		 *
+		 * @param busName name of the bus, empty for the master bus.
+		 * @return pointer to the buffer if the bus is found, otherwise nullptr.
+		 */
+		AudioBuffer* GetInputBuffer(const std::string& busName);
+
+		/**
+		 * applies the effects of the buses and mixes them into each other, then into the output buffer.
+		 * If an effect throws, the exception is rethrown after the other buses of the same level are processed.
+		 *
+		 */
+		void Process();
+
+	private:
+		size_t Visit(AudioBus& bus);
+		void ProcessLevel(const std::vector<AudioBus*>& levelBuses);
+		void JoinWorkers();
+		void RunWorker();
+		void RunLevelTasks(uint32_t generation, size_t busCount);
+		static void ApplyEffects(AudioBus& bus);
+		static void MixInto(AudioBuffer& target, const AudioBuffer& source, double gain);
+	};
+}
\ No newline at end of file
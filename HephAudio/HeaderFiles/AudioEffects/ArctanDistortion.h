@@ -1,6 +1,6 @@
 #pragma once
 #include "HephAudioShared.h"
-#include "AudioEffect.h"
+#include "WaveshaperEffect.h"
 
 /** @file */
 
@@ -10,7 +10,7 @@ namespace HephAudio
 	 * @brief applies soft-clipping distortion via arctan function.
 	 * 
 	 */
-	class HEPH_API ArctanDistortion : public AudioEffect
+	class HEPH_API ArctanDistortion : public WaveshaperEffect
 	{
 	protected:
 		/**
@@ -51,6 +51,6 @@ namespace HephAudio
 		virtual void SetFactor(double factor);
 
 	protected:
-		virtual void ProcessST(const AudioBuffer& inputBuffer, AudioBuffer& outputBuffer, size_t startIndex, size_t frameCount) override;
+		virtual void TransferFunction(float* pSamples, size_t sampleCount) const override;
 	};
 }
\ No newline at end of file
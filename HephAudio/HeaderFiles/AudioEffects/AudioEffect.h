@@ -1,7 +1,9 @@
 #pragma once
 #include "HephAudioShared.h"
 #include "AudioBuffer.h"
+#include "TimingStatistics.h"
 #include <string>
+#include <chrono>
 
 /** @file */
 
@@ -13,12 +15,47 @@ namespace HephAudio
 	 */
 	class HEPH_API AudioEffect
 	{
+	protected:
+		/**
+		 * @brief records the duration of the outermost \link AudioEffect::Process Process \endlink call to the #processStatistics.
+		 * Overrides of the Process methods that call each other only record once.
+		 *
+		 */
+		struct ProcessTimer final
+		{
+			AudioEffect& effect;
+			const std::chrono::steady_clock::time_point start;
+			const bool isOutermost;
+
+			explicit ProcessTimer(AudioEffect& effect)
+				: effect(effect), start(std::chrono::steady_clock::now()), isOutermost(effect.processDepth++ == 0) {}
+
+			~ProcessTimer()
+			{
+				this->effect.processDepth--;
+				if (this->isOutermost)
+				{
+					this->effect.processStatistics.Record(std::chrono::steady_clock::now() - this->start);
+				}
+			}
+		};
+
 	protected:
 		/**
 		 * number of threads that will be used.
 		 */
 		size_t threadCount;
 
+		/**
+		 * time spent in each \link AudioEffect::Process Process \endlink call.
+		 */
+		Heph::TimingStatistics processStatistics;
+
+		/**
+		 * number of nested \link AudioEffect::Process Process \endlink calls that are currently running.
+		 */
+		size_t processDepth;
+
 	protected:
 		/** @copydoc default_constructor */
 		AudioEffect();
@@ -58,6 +95,19 @@ namespace HephAudio
 		 */
 		virtual void SetThreadCount(size_t threadCount);
 
+		/**
+		 * gets the time spent applying the effect, each call to \link AudioEffect::Process Process \endlink is recorded separately.
+		 * Can be read from any thread while the effect is being applied.
+		 *
+		 */
+		virtual Heph::TimingStatisticsSnapshot GetProcessStatistics() const;
+
+		/**
+		 * clears the recorded processing times.
+		 *
+		 */
+		virtual void ResetProcessStatistics();
+
 		/**
 		 * calculates the number of frames required to obtain the number of frames desired for the output buffer.
 		 *
@@ -8,12 +8,21 @@ namespace HephAudio
 {
 	/**
 	 * @brief base class for audio effects that use a temporary buffer while processing.
+	 * When the output has the same shape as the input, the processed range is written to a temporary buffer that's kept between the calls
+	 * and then copied back to the input buffer, so processing buffers of the same size repeatedly does not allocate.
 	 */
 	class HEPH_API DoubleBufferedAudioEffect : public AudioEffect
 	{
 	public:
 		using AudioEffect::Process;
 
+	protected:
+		/**
+		 * temporary buffer the processed range is written to, ends at the end of the processed range.
+		 * 
+		 */
+		AudioBuffer outputBuffer;
+
 	protected:
 		/** @copydoc default_constructor */
 		DoubleBufferedAudioEffect();
@@ -23,8 +32,21 @@ namespace HephAudio
 		virtual ~DoubleBufferedAudioEffect() = default;
 
 		virtual void Process(AudioBuffer& buffer, size_t startIndex, size_t frameCount) override;
+		virtual void ResetInternalState() override;
 
 	protected:
+		/**
+		 * checks whether the output buffer has the same frame count and format as the input buffer,
+		 * in which case the stored buffer is reused instead of calling \link DoubleBufferedAudioEffect::CreateOutputBuffer CreateOutputBuffer \endlink
+		 * and \link DoubleBufferedAudioEffect::InitializeOutputBuffer InitializeOutputBuffer \endlink.
+		 * 
+		 * @param inputBuffer contains the audio data which will be processed.
+		 * @param startIndex index of the first sample to process.
+		 * @param frameCount number of frames to process.
+		 *
+		 */
+		virtual bool CanReuseOutputBuffer(const AudioBuffer& inputBuffer, size_t startIndex, size_t frameCount) const;
+
 		/**
 		 * creates the output buffer but does not initialize it.
 		 * 
@@ -0,0 +1,179 @@
+#pragma once
+#include "HephAudioShared.h"
+#include "AudioEffect.h"
+#include <vector>
+#include <memory>
+#include <initializer_list>
+
+/** @file */
+
+/** @def HEPHAUDIO_EFFECT_CHAIN_DEFAULT_BLOCK_FRAME_COUNT
+ * default number of frames passed through the whole chain at once.
+ *
+ */
+
+#define HEPHAUDIO_EFFECT_CHAIN_DEFAULT_BLOCK_FRAME_COUNT 1024
+
+namespace HephAudio
+{
+	/**
+	 * @brief applies a list of effects in order, one block at a time.
+	 * Each block goes through every effect before the next one is read, so the data stays in the cache between the effects
+	 * and only block sized buffers are created instead of a copy of the whole input per effect.
+	 * The effects that do not support real-time processing are applied to the whole range at once.
+	 * The effects see the processed range as a stream, hence the position based effects start at the first frame of the range.
+	 * 
+	 * @note the chain can be attached to an \link HephAudio::AudioObject AudioObject \endlink, added to a bus or used offline.
+	 * 
+	 */
+	class HEPH_API EffectChain : public AudioEffect
+	{
+	public:
+		using AudioEffect::Process;
+
+	protected:
+		/**
+		 * effects in the order they are applied.
+		 * 
+		 */
+		std::vector<std::shared_ptr<AudioEffect>> effects;
+
+		/**
+		 * number of output frames produced per block.
+		 * 
+		 */
+		size_t blockFrameCount;
+
+		/**
+		 * block that's passed through the effects, reused between the blocks.
+		 * 
+		 */
+		AudioBuffer blockBuffer;
+
+	public:
+		/** @copydoc default_constructor */
+		EffectChain();
+
+		/**
+		 * @copydoc constructor
+		 * 
+		 * @param effects effects in the order they are applied.
+		 */
+		EffectChain(const std::initializer_list<std::shared_ptr<AudioEffect>>& effects);
+
+		/**
+		 * @copydoc constructor
+		 * 
+		 * @param effects effects in the order they are applied.
+		 */
+		EffectChain(const std::vector<std::shared_ptr<AudioEffect>>& effects);
+
+		/** @copydoc destructor */
+		virtual ~EffectChain() = default;
+
+		virtual std::string Name() const override;
+
+		/**
+		 * the effects use their own thread counts.
+		 * 
+		 */
+		virtual bool HasMTSupport() const override;
+
+		/**
+		 * true if all effects support real-time processing.
+		 * 
+		 */
+		virtual bool HasRTSupport() const override;
+
+		/**
+		 * calculates the number of frames the first effect requires for the last one to output \a outputFrameCount frames.
+		 * The effects are assumed to keep the format of \a formatInfo.
+		 * 
+		 * @param outputFrameCount the number of frames desired for the output buffer.
+		 * @param formatInfo the format info of the input buffer.
+		 * 
+		 */
+		virtual size_t CalculateRequiredFrameCount(size_t outputFrameCount, const AudioFormatInfo& formatInfo) const override;
+
+		/**
+		 * calculates the number of frames the buffer will contain after applying all effects.
+		 * The effects are assumed to keep the format of \a formatInfo.
+		 * 
+		 * @param inputFrameCount the number of frames of the input buffer.
+		 * @param formatInfo the format info of the input buffer.
+		 * 
+		 */
+		virtual size_t CalculateOutputFrameCount(size_t inputFrameCount, const AudioFormatInfo& formatInfo) const override;
+
+		/**
+		 * calculates the number of input frames to advance for the last effect to output \a renderFrameCount frames.
+		 * The effects are assumed to keep the format of \a formatInfo.
+		 * 
+		 * @param renderFrameCount number of audio frames that will be rendered.
+		 * @param formatInfo the format info of the input buffer.
+		 * 
+		 */
+		virtual size_t CalculateAdvanceSize(size_t renderFrameCount, const AudioFormatInfo& formatInfo) const override;
+
+		/**
+		 * resets the internal state of all effects.
+		 * 
+		 */
+		virtual void ResetInternalState() override;
+
+		virtual void Process(AudioBuffer& buffer, size_t startIndex, size_t frameCount) override;
+
+		/**
+		 * gets the effects in the order they are applied.
+		 * 
+		 */
+		virtual const std::vector<std::shared_ptr<AudioEffect>>& GetEffects() const;
+
+		/**
+		 * adds an effect to the end of the chain.
+		 * 
+		 */
+		virtual void AddEffect(std::shared_ptr<AudioEffect> pEffect);
+
+		/**
+		 * inserts an effect before the effect at \a index.
+		 * 
+		 */
+		virtual void InsertEffect(size_t index, std::shared_ptr<AudioEffect> pEffect);
+
+		/**
+		 * removes the effect at \a index.
+		 * 
+		 */
+		virtual void RemoveEffect(size_t index);
+
+		/**
+		 * gets the number of output frames produced per block.
+		 * 
+		 */
+		virtual size_t GetBlockFrameCount() const;
+
+		/**
+		 * sets the number of output frames produced per block.
+		 * Small blocks keep the data in the cache, large blocks reduce the per call overhead of the effects.
+		 * 
+		 */
+		virtual void SetBlockFrameCount(size_t blockFrameCount);
+
+	protected:
+		virtual void ProcessST(const AudioBuffer& inputBuffer, AudioBuffer& outputBuffer, size_t startIndex, size_t frameCount) override;
+
+		/**
+		 * applies the effects in [\a firstIndex, \a endIndex), which support real-time processing, one block at a time.
+		 * 
+		 * @return number of frames the processed range contains after applying the effects.
+		 */
+		virtual size_t ProcessBlocks(AudioBuffer& buffer, size_t startIndex, size_t frameCount, size_t firstIndex, size_t endIndex);
+
+		/**
+		 * checks whether the effects in [\a firstIndex, \a endIndex) keep the number of frames of a block.
+		 * 
+		 */
+		virtual bool KeepsFrameCount(size_t firstIndex, size_t endIndex, const AudioFormatInfo& formatInfo) const;
+	};
+}
\ No newline at end of file
@@ -1,6 +1,6 @@
 #pragma once
 #include "HephAudioShared.h"
-#include "AudioEffect.h"
+#include "WaveshaperEffect.h"
 
 /** @file */
 
@@ -10,7 +10,7 @@ namespace HephAudio
 	 * @brief applies hard-clipping distortion.
 	 * 
 	 */
-	class HEPH_API HardClipDistortion : public AudioEffect
+	class HEPH_API HardClipDistortion : public WaveshaperEffect
 	{
 	protected:
 		/**
@@ -50,6 +50,6 @@ namespace HephAudio
 		virtual void SetClippingLevel(double clippingLevel);
 
 	protected:
-		virtual void ProcessST(const AudioBuffer& inputBuffer, AudioBuffer& outputBuffer, size_t startIndex, size_t frameCount) override;
+		virtual void TransferFunction(float* pSamples, size_t sampleCount) const override;
 	};
 }
\ No newline at end of file
@@ -1,7 +1,7 @@
 #pragma once
 #include "HephAudioShared.h"
 #include "FrequencyDomainEffect.h"
-#include "Buffers/ComplexBuffer.h"
+#include "Buffers/SplitComplexBuffer.h"
 #include <filesystem>
 #include <mysofa.h>
 #include <array>
@@ -90,7 +90,7 @@ namespace HephAudio
 		 * an array of transfer functions where the first element is the left channel, and the second element is the right channel.
 		 * 
 		 */
-		std::array<Heph::ComplexBuffer, 2> transferFunctions;
+		std::array<Heph::SplitComplexBuffer, 2> transferFunctions;
 
 	public:
 		/** @copydoc default_constructor */
@@ -0,0 +1,80 @@
+#pragma once
+#include "HephAudioShared.h"
+#include "WaveshaperEffect.h"
+#include <functional>
+
+/** @file */
+
+/** @def HEPHAUDIO_WAVESHAPER_DEFAULT_TABLE_SIZE
+ * default number of points the custom transfer functions are sampled at.
+ *
+ */
+
+#define HEPHAUDIO_WAVESHAPER_DEFAULT_TABLE_SIZE 4096
+
+namespace HephAudio
+{
+	/**
+	 * @brief applies a custom transfer function to the samples.
+	 * The function is sampled into a lookup table, so it is evaluated only when the table is built.
+	 *
+	 */
+	class HEPH_API Waveshaper : public WaveshaperEffect
+	{
+	public:
+		/**
+		 * maps an IEEE float sample in the range of [-1, 1] to the output sample.
+		 *
+		 */
+		using TransferFunctionType = std::function<double(double)>;
+
+	protected:
+		/**
+		 * the custom transfer function.
+		 *
+		 */
+		TransferFunctionType transferFunction;
+
+	public:
+		/** @copydoc default_constructor */
+		Waveshaper();
+
+		/**
+		 * @copydoc constructor
+		 *
+		 * @param transferFunction @copydetails transferFunction
+		 *
+		 */
+		explicit Waveshaper(const TransferFunctionType& transferFunction);
+
+		/**
+		 * @copydoc constructor
+		 *
+		 * @param transferFunction @copydetails transferFunction
+		 * @param tableSize number of points the transfer function is sampled at.
+		 *
+		 */
+		Waveshaper(const TransferFunctionType& transferFunction, size_t tableSize);
+
+		/** @copydoc destructor */
+		virtual ~Waveshaper() = default;
+
+		virtual std::string Name() const override;
+
+		/**
+		 * gets the transfer function.
+		 *
+		 */
+		virtual const TransferFunctionType& GetTransferFunction() const;
+
+		/**
+		 * sets the transfer function.
+		 *
+		 * @param transferFunction @copydetails transferFunction
+		 */
+		virtual void SetTransferFunction(const TransferFunctionType& transferFunction);
+
+	protected:
+		virtual void TransferFunction(float* pSamples, size_t sampleCount) const override;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,179 @@
+#pragma once
+#include "HephAudioShared.h"
+#include "AudioEffect.h"
+#include <vector>
+
+/** @file */
+
+/** @def HEPHAUDIO_WAVESHAPER_MAX_OVERSAMPLING_FACTOR
+ * maximum oversampling factor supported by the waveshaper effects.
+ *
+ */
+
+/** @def HEPHAUDIO_WAVESHAPER_HALFBAND_MAX_COEF_COUNT
+ * maximum number of allpass coefficients a single halfband stage can have.
+ *
+ */
+
+#define HEPHAUDIO_WAVESHAPER_MAX_OVERSAMPLING_FACTOR 8
+#define HEPHAUDIO_WAVESHAPER_HALFBAND_MAX_COEF_COUNT 8
+
+namespace HephAudio
+{
+	/**
+	 * @brief base class for the effects that apply a memoryless transfer function (waveshaping) to the samples.
+	 * Provides polyphase IIR halfband oversampling (1x, 2x, 4x or 8x) to suppress the aliasing caused by the non-linearity
+	 * and an optional lookup table that replaces the transfer function with linear interpolation over [-1, 1].
+	 * Samples are processed in blocks in single precision so the derived classes can apply the transfer function to contiguous arrays.
+	 *
+	 * @note oversampling uses minimum-phase allpass filters, so the output is delayed by a few samples (mostly at high frequencies).
+	 * The filter state is kept per channel, hence when oversampling the multithreaded processing splits the channels instead of the frames.
+	 *
+	 */
+	class HEPH_API WaveshaperEffect : public AudioEffect
+	{
+	protected:
+		/**
+		 * @brief state of a single polyphase halfband stage.
+		 *
+		 */
+		struct HalfbandState
+		{
+			/**
+			 * previous inputs of the allpass sections.
+			 *
+			 */
+			float x[HEPHAUDIO_WAVESHAPER_HALFBAND_MAX_COEF_COUNT];
+
+			/**
+			 * previous outputs of the allpass sections.
+			 *
+			 */
+			float y[HEPHAUDIO_WAVESHAPER_HALFBAND_MAX_COEF_COUNT];
+		};
+
+		/**
+		 * @brief oversampling filter states of a single channel.
+		 *
+		 */
+		struct ChannelState
+		{
+			/**
+			 * states of the upsampling stages.
+			 *
+			 */
+			HalfbandState upsampler[3];
+
+			/**
+			 * states of the downsampling stages.
+			 *
+			 */
+			HalfbandState downsampler[3];
+		};
+
+	protected:
+		/**
+		 * number of samples the transfer function is applied per input sample.
+		 * Must be 1, 2, 4 or 8.
+		 *
+		 */
+		size_t oversamplingFactor;
+
+		/**
+		 * transfer function sampled over [-1, 1], empty if the transfer function is evaluated directly.
+		 *
+		 */
+		std::vector<float> lookupTable;
+
+		/**
+		 * oversampling filter states, one per channel.
+		 *
+		 */
+		std::vector<ChannelState> channelStates;
+
+	protected:
+		/** @copydoc default_constructor */
+		WaveshaperEffect();
+
+	public:
+		/** @copydoc destructor */
+		virtual ~WaveshaperEffect() = default;
+
+		virtual void ResetInternalState() override;
+
+		/**
+		 * gets the oversampling factor.
+		 *
+		 */
+		virtual size_t GetOversamplingFactor() const;
+
+		/**
+		 * sets the oversampling factor.
+		 *
+		 * @param oversamplingFactor @copydetails oversamplingFactor
+		 */
+		virtual void SetOversamplingFactor(size_t oversamplingFactor);
+
+		/**
+		 * gets the delay caused by the oversampling filters in samples, 0 if oversampling is disabled.
+		 * The filters are minimum-phase, hence the delay is calculated at low frequencies and increases towards the Nyquist frequency.
+		 *
+		 */
+		virtual double GetLatency() const;
+
+		/**
+		 * checks whether the transfer function is approximated via lookup table.
+		 *
+		 */
+		virtual bool IsLookupTableEnabled() const;
+
+		/**
+		 * samples the transfer function over [-1, 1] and uses the table instead of evaluating the function.
+		 * Inputs outside of [-1, 1] are clamped to the edges of the table.
+		 *
+		 * @param tableSize number of points in the table, must be at least 2.
+		 */
+		virtual void EnableLookupTable(size_t tableSize);
+
+		/**
+		 * releases the lookup table and evaluates the transfer function directly.
+		 *
+		 */
+		virtual void DisableLookupTable();
+
+	protected:
+		/**
+		 * applies the transfer function in-place.
+		 *
+		 * @param pSamples IEEE float samples, nominally in the range of [-1, 1].
+		 * @param sampleCount number of samples.
+		 *
+		 */
+		virtual void TransferFunction(float* pSamples, size_t sampleCount) const = 0;
+
+		/**
+		 * resamples the transfer function if the lookup table is enabled.
+		 * Derived classes must call this after changing a parameter of the transfer function.
+		 *
+		 */
+		virtual void UpdateLookupTable();
+
+		/**
+		 * applies the transfer function to a single channel.
+		 *
+		 * @param buffer contains the audio data which will be processed.
+		 * @param channelIndex index of the channel to process.
+		 * @param startIndex index of the first frame to process.
+		 * @param frameCount number of frames to process.
+		 *
+		 */
+		virtual void ProcessChannel(AudioBuffer& buffer, size_t channelIndex, size_t startIndex, size_t frameCount);
+
+		virtual void ProcessST(const AudioBuffer& inputBuffer, AudioBuffer& outputBuffer, size_t startIndex, size_t frameCount) override;
+		virtual void ProcessMT(const AudioBuffer& inputBuffer, AudioBuffer& outputBuffer, size_t startIndex, size_t frameCount) override;
+
+	private:
+		void ApplyTransferFunction(float* pSamples, size_t sampleCount) const;
+		void UpdateChannelStates(size_t channelCount);
+	};
+}
\ No newline at end of file
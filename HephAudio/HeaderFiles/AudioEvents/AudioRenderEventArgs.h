@@ -26,6 +26,12 @@ namespace HephAudio
 		 */
 		size_t renderFrameCount;
 
+		/**
+		 * indicates the object is virtual, the handler should only advance the position and may leave the render buffer empty.
+		 * 
+		 */
+		bool isVirtual;
+
 		/** 
 		 * @copydoc constructor
 		 * 
@@ -1,10 +1,16 @@
 #pragma once
 #include "HephAudioShared.h"
 #include "AudioBuffer.h"
+#include "AudioBus.h"
+#include "AudioEffects/EffectChain.h"
+#include "CompressedAudioBuffer.h"
 #include "Event.h"
 #include "Guid.h"
+#include "TimingStatistics.h"
 #include <vector>
 #include <filesystem>
+#include <memory>
+#include <limits>
 
 /** @file */
 
@@ -70,12 +76,81 @@ namespace HephAudio
 		 */
 		double volume;
 
+		/**
+		 * importance of the object when the number of real voices is limited, higher values are kept real first.
+		 * See \link HephAudio::Native::NativeAudio::SetMaxRealVoiceCount NativeAudio::SetMaxRealVoiceCount \endlink.
+		 *
+		 */
+		int32_t priority;
+
+		/**
+		 * distance between the source of the sound and the listener, in the units of the application.
+		 *
+		 */
+		double distance;
+
+		/**
+		 * the object is inaudible, hence virtual, while \link HephAudio::AudioObject::distance distance \endlink is greater than this value.
+		 *
+		 */
+		double maxDistance;
+
+		/**
+		 * indicates whether the object was virtual in the last render period.
+		 * Virtual objects only advance their position, they are not decoded, resampled or mixed. Set by the render thread.
+		 *
+		 */
+		bool isVirtual;
+
+		/**
+		 * name of the bus the object is mixed into, empty for the master bus.
+		 * The object is mixed into the master bus if the bus does not exist.
+		 *
+		 */
+		std::string busName;
+
+		/**
+		 * buses that receive a copy of the object's audio in addition to \link HephAudio::AudioObject::busName busName \endlink.
+		 *
+		 */
+		std::vector<AudioBusSend> sends;
+
+		/**
+		 * effects applied by the default render handlers each render period, nullptr for none.
+		 * The number of frames read and advanced is negotiated with the chain, hence the effects may change the frame count.
+		 *
+		 */
+		std::shared_ptr<EffectChain> pEffectChain;
+
 		/**
 		 * contains the audio data.
+		 * Empty while the object plays the data shared via \link HephAudio::AudioObject::pSharedBuffer pSharedBuffer \endlink
+		 * or \link HephAudio::AudioObject::pCompressedBuffer pCompressedBuffer \endlink.
 		 *
 		 */
 		AudioBuffer buffer;
 
+		/**
+		 * read-only audio data shared with the other objects created from the same file, nullptr if the object owns its data.
+		 * Only set for the objects created while an \link HephAudio::Native::NativeAudio::SetAssetCache asset cache \endlink is set.
+		 * Call \link HephAudio::AudioObject::DetachSharedBuffer DetachSharedBuffer \endlink before modifying the audio data.
+		 *
+		 */
+		std::shared_ptr<const AudioBuffer> pSharedBuffer;
+
+		/**
+		 * read-only compressed audio data that's decoded a block at a time while rendering, nullptr if not used.
+		 * Takes precedence over \link HephAudio::AudioObject::pSharedBuffer pSharedBuffer \endlink and \link HephAudio::AudioObject::buffer buffer \endlink.
+		 *
+		 */
+		std::shared_ptr<const CompressedAudioBuffer> pCompressedBuffer;
+
+		/**
+		 * decoder state of the object for \link HephAudio::AudioObject::pCompressedBuffer pCompressedBuffer \endlink, acquired on the first render.
+		 *
+		 */
+		std::shared_ptr<CompressedAudioBuffer::DecoderState> pDecoderState;
+
 		/**
 		 * index of the first audio frame that will be rendered (played) next.
 		 *
@@ -94,6 +169,13 @@ namespace HephAudio
 		 */
 		Heph::Event OnFinishedPlaying;
 
+		/**
+		 * time spent in the \link HephAudio::AudioObject::OnRender AudioObject::OnRender \endlink event each time the object is rendered.
+		 * Recorded by the render thread, can be read from any thread.
+		 *
+		 */
+		Heph::TimingStatistics renderStatistics;
+
 		/** @copydoc default_constructor */
 		AudioObject();
 
@@ -102,6 +184,40 @@ namespace HephAudio
 
 		AudioObject& operator=(AudioObject&& rhs) noexcept;
 
+		/**
+		 * gets the audio data that's played, either the shared data or \link HephAudio::AudioObject::buffer buffer \endlink.
+		 * Does not include the compressed data, use \link HephAudio::AudioObject::GetFrames GetFrames \endlink to read it.
+		 *
+		 */
+		const AudioBuffer& GetBuffer() const;
+
+		/**
+		 * gets the number of frames of the audio data that's played.
+		 *
+		 */
+		size_t GetFrameCount() const;
+
+		/**
+		 * gets the format of the audio data that's played.
+		 *
+		 */
+		AudioFormatInfo GetFormatInfo() const;
+
+		/**
+		 * gets a copy of the frames in the range [frameIndex, frameIndex + frameCount), decoding the compressed data if necessary.
+		 * Frames past the end are set to zero.
+		 *
+		 */
+		AudioBuffer GetFrames(size_t frameIndex, size_t frameCount);
+
+		/**
+		 * copies the shared or decompressed audio data to \link HephAudio::AudioObject::buffer buffer \endlink so it can be modified.
+		 * Does nothing if the object already owns its data.
+		 *
+		 * @return reference to \link HephAudio::AudioObject::buffer buffer \endlink.
+		 */
+		AudioBuffer& DetachSharedBuffer();
+
 		/**
 		 * calculates the playback position between 0 and 1.
 		 *
@@ -22,6 +22,7 @@ namespace HephAudio
 	/**
 	 * @brief class for creating playlists.
 	 * Uses \link HephAudio::AudioStream AudioStream \endlink internally to play the files.
+	 * The next file is opened and partially decoded in the background while the current one plays, so the files are played without gaps.
 	 *
 	 */
 	class HEPH_API AudioPlaylist final
@@ -174,8 +175,22 @@ namespace HephAudio
 		 */
 		void Clear();
 
+		/**
+		 * gets the duration, in milliseconds, of the crossfade between consecutive files.
+		 *
+		 */
+		uint32_t GetCrossfadeDuration() const;
+
+		/**
+		 * sets the duration, in milliseconds, of the crossfade between consecutive files, 0 to play them back to back.
+		 *
+		 */
+		void SetCrossfadeDuration(uint32_t crossfadeDuration_ms);
+
 	private:
 		void ChangeFile();
+		void QueueNextFile();
 		static void OnFinishedPlaying(const Heph::EventParams& eventParams);
+		static void OnNextFileStarted(const Heph::EventParams& eventParams);
 	};
 }
\ No newline at end of file
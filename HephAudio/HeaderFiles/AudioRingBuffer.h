@@ -0,0 +1,152 @@
+#pragma once
+#include "HephAudioShared.h"
+#include "AudioBuffer.h"
+#include <atomic>
+#include <cstdint>
+
+/** @file */
+
+namespace HephAudio
+{
+	/**
+	 * @brief lock-free single producer, single consumer ring buffer of audio frames in internal format.
+	 * One thread writes (i.e. the capture thread) while another reads at its own pace, neither blocks the other.
+	 * When the consumer falls behind, the frames that do not fit are dropped and counted as an overrun.
+	 *
+	 */
+	class HEPH_API AudioRingBuffer final
+	{
+	private:
+		AudioBuffer buffer;
+		std::atomic<uint64_t> writeIndex;
+		std::atomic<uint64_t> readIndex;
+		std::atomic<uint64_t> overrunCount;
+		std::atomic<uint64_t> droppedFrameCount;
+
+	public:
+		/** @copydoc default_constructor */
+		AudioRingBuffer();
+
+		/**
+		 * @copydoc constructor
+		 *
+		 * @param capacity_frame maximum number of frames the buffer can hold.
+		 * @param channelLayout channel layout of the frames.
+		 * @param sampleRate sample rate of the frames.
+		 */
+		AudioRingBuffer(size_t capacity_frame, const AudioChannelLayout& channelLayout, uint32_t sampleRate);
+
+		AudioRingBuffer(const AudioRingBuffer&) = delete;
+		AudioRingBuffer& operator=(const AudioRingBuffer&) = delete;
+
+		/**
+		 * changes the capacity and the format, and clears the buffer.
+		 * Memory is reallocated only if the capacity or the channel layout changes.
+		 *
+		 * @important not thread safe, must not be called while the buffer is being read or written.
+		 * @param capacity_frame maximum number of frames the buffer can hold.
+		 * @param channelLayout channel layout of the frames.
+		 * @param sampleRate sample rate of the frames.
+		 */
+		void Reset(size_t capacity_frame, const AudioChannelLayout& channelLayout, uint32_t sampleRate);
+
+		/**
+		 * copies the frames to the buffer, must only be called from the producer thread.
+		 * Frames that do not fit are dropped.
+		 *
+		 * @param pFrames interleaved frames in internal format.
+		 * @param frameCount number of frames to write.
+		 * @return number of frames written.
+		 */
+		size_t Write(const heph_audio_sample_t* pFrames, size_t frameCount);
+
+		/**
+		 * copies the frames of the provided buffer to the ring buffer, must only be called from the producer thread.
+		 * Frames that do not fit are dropped.
+		 *
+		 * @param buffer buffer that has the same channel count as the ring buffer.
+		 * @return number of frames written.
+		 */
+		size_t Write(const AudioBuffer& buffer);
+
+		/**
+		 * copies the oldest frames to the provided memory and removes them from the buffer, must only be called from the consumer thread.
+		 *
+		 * @param pFrames memory that will receive the interleaved frames.
+		 * @param frameCount maximum number of frames to read.
+		 * @return number of frames read.
+		 */
+		size_t Read(heph_audio_sample_t* pFrames, size_t frameCount);
+
+		/**
+		 * fills the provided buffer with the oldest frames and removes them from the ring buffer, must only be called from the consumer thread.
+		 * If fewer frames are available the rest of the buffer is left unchanged.
+		 *
+		 * @param buffer buffer that has the same channel count as the ring buffer.
+		 * @return number of frames read.
+		 */
+		size_t Read(AudioBuffer& buffer);
+
+		/**
+		 * removes the oldest frames without copying them, must only be called from the consumer thread.
+		 *
+		 * @param frameCount maximum number of frames to remove.
+		 * @return number of frames removed.
+		 */
+		size_t Skip(size_t frameCount);
+
+		/**
+		 * gets the contiguous writable region that starts at the write position, so the producer can write the frames in place.
+		 * Call \link HephAudio::AudioRingBuffer::CommitWrite CommitWrite \endlink to publish the written frames.
+		 * Must only be called by the producer thread.
+		 *
+		 * @param ppFrames receives the pointer to the first writable frame.
+		 * @return number of frames that can be written to the region, may be less than the writable frame count when the region wraps around.
+		 */
+		size_t GetWriteRegion(heph_audio_sample_t** ppFrames);
+
+		/**
+		 * publishes the frames written to the region returned by \link HephAudio::AudioRingBuffer::GetWriteRegion GetWriteRegion \endlink.
+		 * Must only be called by the producer thread.
+		 *
+		 * @param frameCount number of frames written, must not exceed the size of the region.
+		 */
+		void CommitWrite(size_t frameCount);
+
+		/**
+		 * gets the number of frames that can be read.
+		 *
+		 */
+		size_t GetReadableFrameCount() const;
+
+		/**
+		 * gets the number of frames that can be written without dropping.
+		 *
+		 */
+		size_t GetWritableFrameCount() const;
+
+		/**
+		 * gets the maximum number of frames the buffer can hold.
+		 *
+		 */
+		size_t GetCapacity() const;
+
+		/**
+		 * gets the format of the frames.
+		 *
+		 */
+		const AudioFormatInfo& FormatInfo() const;
+
+		/**
+		 * gets the number of writes that dropped frames because the buffer was full.
+		 *
+		 */
+		uint64_t GetOverrunCount() const;
+
+		/**
+		 * gets the total number of frames dropped because the buffer was full.
+		 *
+		 */
+		uint64_t GetDroppedFrameCount() const;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+#pragma once
+#include "HephAudioShared.h"
+#include <cstdint>
+#include <vector>
+#include <filesystem>
+
+/** @file */
+
+/** @def HEPHAUDIO_SEEK_INDEX_EXTENSION
+ * extension that's appended to the path of an audio file to create the path of its persisted seek index.
+ *
+ */
+
+#define HEPHAUDIO_SEEK_INDEX_EXTENSION ".hephseek"
+
+namespace HephAudio
+{
+	/**
+	 * @brief saves and loads the seek index of an audio file, the byte offsets of its packets and the index of the first frame each packet decodes to.
+	 * The index is stored next to the audio file as a cache, in the native byte order along with the size and the modification time of the audio file.
+	 * A saved index is ignored once the audio file is modified or if it cannot be read completely.
+	 *
+	 */
+	class HEPH_API AudioSeekIndex final
+	{
+	public:
+		/**
+		 * @brief a packet of the audio file.
+		 *
+		 */
+		struct SeekPoint
+		{
+			/**
+			 * byte offset of the packet in the audio file.
+			 *
+			 */
+			int64_t pos;
+
+			/**
+			 * index of the first frame the packet decodes to.
+			 *
+			 */
+			size_t frameIndex;
+		};
+
+	public:
+		AudioSeekIndex() = delete;
+		AudioSeekIndex(const AudioSeekIndex&) = delete;
+		AudioSeekIndex& operator=(const AudioSeekIndex&) = delete;
+
+	public:
+		/**
+		 * gets the path the seek index of the audio file is saved to.
+		 *
+		 * @param audioFilePath path of the audio file.
+		 */
+		static std::filesystem::path GetIndexFilePath(const std::filesystem::path& audioFilePath);
+
+		/**
+		 * loads the saved seek index of the audio file.
+		 *
+		 * @param audioFilePath path of the audio file.
+		 * @param seekIndex receives the seek points, cleared if the index cannot be loaded.
+		 * @return true if the index is loaded, false if it does not exist, is outdated or is corrupt.
+		 */
+		static bool Load(const std::filesystem::path& audioFilePath, std::vector<SeekPoint>& seekIndex);
+
+		/**
+		 * saves the seek index of the audio file, overwriting the previously saved one.
+		 *
+		 * @param audioFilePath path of the audio file.
+		 * @param seekIndex seek points of the audio file.
+		 * @return true if the index is saved, the partially written file is removed otherwise.
+		 */
+		static bool Save(const std::filesystem::path& audioFilePath, const std::vector<SeekPoint>& seekIndex);
+	};
+}
\ No newline at end of file
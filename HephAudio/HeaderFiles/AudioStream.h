@@ -2,7 +2,12 @@
 #include "HephAudioShared.h"
 #include "Audio.h"
 #include "AudioBuffer.h"
+#include "Event.h"
+#include <atomic>
 #include <filesystem>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 /** @file */
 
@@ -12,6 +17,12 @@
  */
 #define HEPHAUDIO_STREAM_EVENT_USER_ARG_KEY "audio_stream"
 
+/**
+ * duration, in milliseconds, of the audio data that's decoded in advance from the queued file.
+ * 
+ */
+#define HEPHAUDIO_STREAM_PREFETCH_DURATION_MS (500)
+
 namespace HephAudio
 {
 	/**
@@ -21,6 +32,31 @@ namespace HephAudio
 	 */
 	class HEPH_API AudioStream final
 	{
+	private:
+		struct NextFile
+		{
+			/** locked by the render thread while it reads the head of the file. */
+			std::mutex mutex;
+			std::filesystem::path filePath;
+			std::shared_ptr<IAudioDecoder> pDecoder;
+			/** first frames of the file, decoded by the prefetch thread. */
+			AudioBuffer headBuffer;
+			/** index of the first frame of the head that's not played yet. */
+			size_t headFrameIndex;
+			size_t frameCount;
+			std::thread prefetchThread;
+			std::atomic_bool isReady;
+			NextFile();
+		};
+
+	public:
+		/**
+		 * raised on the render thread when the current file ends and the queued file takes its place.
+		 * A new file can be queued from the handler.
+		 * 
+		 */
+		Heph::Event OnNextFileStarted;
+
 	private:
 		std::shared_ptr<Native::NativeAudio> pNativeAudio;
 		std::shared_ptr<IAudioDecoder> pAudioDecoder;
@@ -28,6 +64,25 @@ namespace HephAudio
 		size_t frameCount;
 		AudioObject* pAudioObject;
 		AudioBuffer decodedBuffer;
+		std::unique_ptr<NextFile> pNextFile;
+		uint32_t crossfadeDuration_ms;
+		/** number of frames the current decoder has produced since the file was opened or seeked. */
+		size_t decodedFrameCount;
+		/** the head of the next file is being mixed into the end of the current one. */
+		bool isCrossfading;
+		/** the next file is decoded into \a decodedBuffer but not rendered yet. */
+		bool isSplicePending;
+		/** index of the first frame of the next file within \a decodedBuffer. */
+		size_t spliceFrameIndex;
+		size_t splicedFrameCount;
+		std::filesystem::path splicedFilePath;
+		/** 
+		 * head of the current file if it was spliced, its frames are rendered before the ones the decoder produces.
+		 * Swapped with the head of the next file, so the render thread neither allocates nor frees it.
+		 */
+		AudioBuffer headBuffer;
+		/** index of the first frame of \a headBuffer that's not decoded into \a decodedBuffer yet. */
+		size_t headFrameIndex;
 
 	public:
 		/** 
@@ -120,6 +175,42 @@ namespace HephAudio
 		 */
 		void CloseFile();
 
+		/**
+		 * sets the file that will be played right after the current one without a gap.
+		 * The file is opened and its first frames are decoded on a background thread while the current file plays.
+		 * If its channel layout and sample rate match the current file, the two are spliced sample-accurately on the render thread,
+		 * otherwise the prefetched decoder is reused when \link HephAudio::AudioStream::ChangeFile ChangeFile \endlink is called with the same path.
+		 * Ignored while the current file is crossfading into the queued one.
+		 * 
+		 * @param filePath path of the file, or empty to remove the queued file.
+		 */
+		void QueueNextFile(const std::filesystem::path& filePath);
+
+		/**
+		 * gets the path of the queued file, empty if no file is queued.
+		 * 
+		 */
+		std::filesystem::path GetNextFile() const;
+
+		/**
+		 * checks whether the queued file is opened and its first frames are decoded, so it can be spliced.
+		 * 
+		 */
+		bool IsNextFileReady() const;
+
+		/**
+		 * gets the duration, in milliseconds, of the crossfade between the current file and the queued file.
+		 * 
+		 */
+		uint32_t GetCrossfadeDuration() const;
+
+		/**
+		 * sets the duration, in milliseconds, of the crossfade between the current file and the queued file, 0 to splice without a crossfade.
+		 * The crossfade is limited to the frames that are decoded in advance, which are at least #HEPHAUDIO_STREAM_PREFETCH_DURATION_MS long.
+		 * 
+		 */
+		void SetCrossfadeDuration(uint32_t crossfadeDuration_ms);
+
 		/**
 		 * starts (resumes) playing the file.
 		 * 
@@ -146,6 +237,13 @@ namespace HephAudio
 
 	private:
 		void Release();
+		void ResetSplice();
+		size_t DecodeFrames(size_t frameIndex, size_t frameCount);
+		void SwapToNextFile();
+		void ApplySplice(size_t frameIndex);
+		void CompleteSplice();
+		void RaiseNextFileStarted();
+		static void PrefetchNextFile(NextFile* pNextFile, uint32_t headDuration_ms);
 		static void OnRender(const Heph::EventParams& eventParams);
 		static void OnFinishedPlaying(const Heph::EventParams& eventParams);
 	};
@@ -0,0 +1,146 @@
+#pragma once
+#include "HephAudioShared.h"
+#include "AudioBuffer.h"
+#include "IAudioDecoder.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/** @file */
+
+/**
+ * default number of frames per \link HephAudio::CompressedAudioBuffer CompressedAudioBuffer \endlink block.
+ *
+ */
+#define HEPHAUDIO_COMPRESSED_BUFFER_DEFAULT_BLOCK_FRAME_COUNT (1025)
+
+namespace HephAudio
+{
+	/**
+	 * @brief read-only audio data kept in memory as 4 bit IMA ADPCM, about an eighth of the size of the decoded data.
+	 * The data is split into blocks that can be decoded independently,
+	 * so any number of voices can play the same buffer at different positions by decoding a block at a time while rendering.
+	 *
+	 */
+	class HEPH_API CompressedAudioBuffer final
+	{
+	public:
+		/**
+		 * @brief per voice state that caches the last decoded block.
+		 * Acquired from the pool of the buffer via \link HephAudio::CompressedAudioBuffer::AcquireDecoderState AcquireDecoderState \endlink.
+		 *
+		 */
+		struct HEPH_API DecoderState
+		{
+			/**
+			 * index of the block that's stored in \link HephAudio::CompressedAudioBuffer::DecoderState::decodedBlock decodedBlock \endlink.
+			 *
+			 */
+			size_t blockIndex;
+
+			/**
+			 * interleaved samples of the last decoded block.
+			 *
+			 */
+			std::vector<heph_audio_sample_t> decodedBlock;
+
+			/** @copydoc default_constructor */
+			DecoderState();
+		};
+
+	private:
+		struct DecoderStatePool
+		{
+			std::mutex mutex;
+			std::vector<std::unique_ptr<DecoderState>> freeStates;
+		};
+
+	private:
+		AudioFormatInfo formatInfo;
+		size_t frameCount;
+		size_t blockFrameCount;
+		size_t blockSize_byte;
+		std::vector<uint8_t> data;
+		std::shared_ptr<DecoderStatePool> pDecoderStatePool;
+
+	public:
+		/**
+		 * @copydoc constructor
+		 *
+		 * @param buffer audio data that will be compressed.
+		 * @param blockFrameCount number of frames per block, must be an odd number greater than 1.
+		 */
+		explicit CompressedAudioBuffer(const AudioBuffer& buffer, size_t blockFrameCount = HEPHAUDIO_COMPRESSED_BUFFER_DEFAULT_BLOCK_FRAME_COUNT);
+
+		/**
+		 * @copydoc constructor
+		 * Compresses the file that's open in the decoder a block at a time, so the whole file is never decoded into memory.
+		 *
+		 * @param decoder decoder with the file open and positioned at the first frame.
+		 * @param blockFrameCount number of frames per block, must be an odd number greater than 1.
+		 */
+		explicit CompressedAudioBuffer(IAudioDecoder& decoder, size_t blockFrameCount = HEPHAUDIO_COMPRESSED_BUFFER_DEFAULT_BLOCK_FRAME_COUNT);
+
+		CompressedAudioBuffer(const CompressedAudioBuffer&) = delete;
+		CompressedAudioBuffer& operator=(const CompressedAudioBuffer&) = delete;
+
+		/**
+		 * gets the format of the decoded audio data.
+		 *
+		 */
+		const AudioFormatInfo& FormatInfo() const;
+
+		/**
+		 * gets the number of frames.
+		 *
+		 */
+		size_t FrameCount() const;
+
+		/**
+		 * gets the number of frames per block.
+		 *
+		 */
+		size_t BlockFrameCount() const;
+
+		/**
+		 * gets the size of the compressed data in bytes.
+		 *
+		 */
+		size_t Size() const;
+
+		/**
+		 * decodes the frames in the range [frameIndex, frameIndex + frameCount).
+		 * Frames past the end are set to zero.
+		 *
+		 * @param frameIndex index of the first frame.
+		 * @param frameCount number of frames to decode.
+		 * @param pOutput memory that will receive the interleaved samples.
+		 * @param state state of the voice, blocks that were decoded by the previous call are reused.
+		 */
+		void Decode(size_t frameIndex, size_t frameCount, heph_audio_sample_t* pOutput, DecoderState& state) const;
+
+		/**
+		 * decodes all frames.
+		 *
+		 */
+		AudioBuffer Decode() const;
+
+		/**
+		 * gets a decoder state from the pool, the state is returned to the pool when the last reference is released.
+		 * The pool outlives the buffer if a state is still referenced.
+		 *
+		 */
+		std::shared_ptr<DecoderState> AcquireDecoderState() const;
+
+		/**
+		 * gets the number of decoder states that are in the pool waiting to be reused.
+		 *
+		 */
+		size_t GetIdleDecoderStateCount() const;
+
+	private:
+		void Initialize(const AudioFormatInfo& formatInfo, size_t frameCount, size_t blockFrameCount);
+		void EncodeBlock(const heph_audio_sample_t* pInput, size_t frameCount, size_t blockIndex, std::vector<int32_t>& encoderIndices);
+		void DecodeBlock(size_t blockIndex, heph_audio_sample_t* pOutput) const;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+#pragma once
+#include "HephAudioShared.h"
+#include "AudioBuffer.h"
+#include "StftAnalyzer.h"
+#include <vector>
+
+/** @file */
+
+namespace HephAudio
+{
+	/**
+	 * @brief calculates the constant-Q transform (CQT) of a channel, whose bins are geometrically spaced and have the same frequency to bandwidth ratio.
+	 * Uses the kernel-based method, a precalculated spectral kernel is multiplied with the FFT of each frame for each bin.
+	 * Only the part of each kernel that's above a threshold is stored, hence each bin costs a short dot product.
+	 * Results are stored frame by frame, like the output of \link HephAudio::StftAnalyzer StftAnalyzer \endlink.
+	 *
+	 */
+	class HEPH_API ConstantQTransform final
+	{
+	private:
+		/**
+		 * sample rate of the analyzed audio.
+		 *
+		 */
+		uint32_t sampleRate;
+
+		/**
+		 * center frequency of the first bin in Hz.
+		 *
+		 */
+		double minFrequency;
+
+		/**
+		 * number of bins in each octave.
+		 *
+		 */
+		size_t binsPerOctave;
+
+		/** calculates the FFT of the frames, the frame size is the FFT size so the longest kernel fits. */
+		StftAnalyzer stft;
+
+		/** first FFT bin each kernel covers. */
+		std::vector<size_t> kernelStartBins;
+		/** index of the first element of each kernel, followed by the total number of elements. */
+		std::vector<size_t> kernelOffsets;
+		/** complex conjugate of the kernels divided by the FFT size. */
+		std::vector<double> kernelReal;
+		std::vector<double> kernelImag;
+
+	public:
+		/**
+		 * @copydoc constructor
+		 *
+		 * @param sampleRate @copydetails sampleRate
+		 * @param minFrequency @copydetails minFrequency
+		 * @param maxFrequency maximum center frequency in Hz, must be less than the Nyquist frequency.
+		 * @param binsPerOctave @copydetails binsPerOctave
+		 * @param hopSize number of samples between the starts of the consecutive frames.
+		 */
+		ConstantQTransform(uint32_t sampleRate, double minFrequency, double maxFrequency, size_t binsPerOctave, size_t hopSize);
+
+		/**
+		 * gets the number of bins each frame has.
+		 *
+		 */
+		size_t GetBinCount() const;
+
+		/**
+		 * gets the number of bins in each octave.
+		 *
+		 */
+		size_t GetBinsPerOctave() const;
+
+		/**
+		 * gets the center frequency of a bin in Hz.
+		 *
+		 */
+		double GetBinFrequency(size_t binIndex) const;
+
+		/**
+		 * gets the size of the FFT, also the number of samples each frame has.
+		 *
+		 */
+		size_t GetFFTSize() const;
+
+		/**
+		 * gets the hop size.
+		 *
+		 */
+		size_t GetHopSize() const;
+
+		/**
+		 * gets the number of threads used.
+		 *
+		 */
+		size_t GetThreadCount() const;
+
+		/**
+		 * sets the number of threads used.
+		 *
+		 * @param threadCount number of threads, 0 to use the number of hardware threads.
+		 */
+		void SetThreadCount(size_t threadCount);
+
+		/**
+		 * calculates the number of frames produced for the provided number of samples.
+		 * The last frame is zero padded if the samples do not fill it.
+		 *
+		 */
+		size_t CalculateFrameCount(size_t sampleCount) const;
+
+		/**
+		 * calculates the CQT of a channel of the whole buffer.
+		 * The kernels are centered in the frames, hence the frame f is centered at the sample <b>f * GetHopSize() + GetFFTSize() / 2</b>.
+		 *
+		 * @param buffer the audio data.
+		 * @param channelIndex index of the channel that will be analyzed.
+		 * @param outputType value calculated for each bin.
+		 * @param pOutput memory that will receive the results,
+		 * must have space for at least <b>CalculateFrameCount(buffer.FrameCount()) * GetBinCount()</b> elements.
+		 */
+		void Analyze(const AudioBuffer& buffer, size_t channelIndex, StftOutputType outputType, double* pOutput) const;
+
+	private:
+		void AnalyzeST(const AudioBuffer& buffer, size_t channelIndex, size_t firstFrameIndex, size_t frameCount, StftOutputType outputType, double* pOutput) const;
+	};
+}
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include "FFmpegAudioShared.h"
 #include "IAudioDecoder.h"
 #include "FFmpegEncodedAudioBuffer.h"
+#include "AudioSeekIndex.h"
+#include <vector>
 
 /** @file */
 
@@ -10,6 +12,8 @@ namespace HephAudio
 {
 	/**
 	 * @brief implements audio decoding via [FFmpeg](https://www.ffmpeg.org/).
+	 * The first seek to a non-zero position scans the packets of the file once and builds a seek index of their byte offsets,
+	 * the following seeks jump to the exact packet and discard the decoded frames up to the requested one.
 	 * 
 	 */
 	class HEPH_API FFmpegAudioDecoder final : public IAudioDecoder
@@ -17,6 +21,8 @@ namespace HephAudio
 	private:
 		static constexpr size_t AUDIO_STREAM_INDEX_NOT_FOUND = -1;
 
+		using SeekPoint = AudioSeekIndex::SeekPoint;
+
 	private:
 		size_t fileDuration_frame;
 		size_t audioStreamIndex;
@@ -26,6 +32,12 @@ namespace HephAudio
 		SwrContext* swrContext;
 		AVFrame* avFrame;
 		AVPacket* avPacket;
+		std::vector<SeekPoint> seekIndex;
+		bool isSeekIndexBuilt;
+		bool isSeekIndexPersistent;
+		size_t pendingSkipFrameCount;
+		size_t primingFrameCount;
+		size_t threadCount;
 
 	public:
 		/** @copydoc default_constructor */
@@ -58,9 +70,56 @@ namespace HephAudio
 		AudioBuffer Decode(size_t frameCount) override;
 		AudioBuffer Decode(size_t frameIndex, size_t frameCount) override;
 		AudioBuffer Decode(const EncodedAudioBuffer& encodedBuffer) override;
+		size_t DecodeInto(heph_audio_sample_t* pOutput, size_t frameCount) override;
+		using IAudioDecoder::DecodeInto;
+
+		/**
+		 * builds the seek index of the open file now instead of on the first seek, then seeks to the beginning of the file.
+		 * Does nothing if the index is already built or the container does not support seeking by byte offset.
+		 * 
+		 */
+		void BuildSeekIndex();
+
+		/**
+		 * checks whether the seek index of the open file is built and used for seeking.
+		 * 
+		 */
+		bool HasSeekIndex() const;
+
+		/**
+		 * checks whether the seek index is saved next to the file and loaded the next time the file is opened.
+		 * 
+		 */
+		bool IsSeekIndexPersistent() const;
+
+		/**
+		 * sets whether the seek index is saved next to the file (with the #HEPHAUDIO_SEEK_INDEX_EXTENSION extension)
+		 * and loaded the next time the file is opened. A saved index is ignored once the file is modified.
+		 * 
+		 */
+		void SetSeekIndexPersistent(bool isSeekIndexPersistent);
+
+		/**
+		 * gets the number of threads used for decoding.
+		 * 
+		 */
+		size_t GetThreadCount() const;
+
+		/**
+		 * sets the number of threads used for decoding, 0 to use one per core. Default is 1.
+		 * When decoding the whole file, long files are split into segments at the packets of the seek index
+		 * and each segment is decoded on its own thread by a separate decoder.
+		 * Codecs that support it also use frame or slice threading, which takes effect the next time a file is opened.
+		 * 
+		 */
+		void SetThreadCount(size_t threadCount);
 
 	private:
 		void OpenFile(const std::filesystem::path& filePath);
 		int SeekFrame(size_t& frameIndex);
+		AudioBuffer DecodeParallel(size_t segmentCount);
+		size_t ConvertFrame(const AVFrame* pFrame, heph_audio_sample_t* pOutput, size_t frameCount);
+		int SeekFrameIndexed(size_t& frameIndex);
+		void ScanSeekIndex();
 	};
 }
\ No newline at end of file
@@ -54,6 +54,7 @@
 /**
  * logs messages to the console.
  * Enabled by defining <b>HEPHAUDIO_INFO_LOGGING</b>.
+ * Call \link Heph::ConsoleLogger::EnableAsyncLogging ConsoleLogger::EnableAsyncLogging \endlink to keep the logging from blocking the render and capture threads.
  *
  */
 #if defined(HEPHAUDIO_INFO_LOGGING)
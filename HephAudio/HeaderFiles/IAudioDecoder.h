@@ -2,6 +2,7 @@
 #include "HephAudioShared.h"
 #include "AudioBuffer.h"
 #include "EncodedAudioBuffer.h"
+#include "AudioRingBuffer.h"
 #include <filesystem>
 
 /** @file */
@@ -95,5 +96,38 @@ namespace HephAudio
 		 * 
 		 */
 		virtual AudioBuffer Decode(const EncodedAudioBuffer& encodedBuffer) = 0;
+
+		/**
+		 * decodes the next frames directly into the memory provided by the caller without allocating.
+		 * Unlike \link HephAudio::IAudioDecoder::Decode(size_t) Decode \endlink, the output is not padded,
+		 * the callers rely on the returned frame count to detect the end of the file.
+		 * 
+		 * @param pOutput memory that will receive the interleaved samples in the output format, must be large enough to hold frameCount frames.
+		 * @param frameCount number of frames to decode.
+		 * @return number of frames written, less than frameCount at the end of the file.
+		 * 
+		 */
+		virtual size_t DecodeInto(heph_audio_sample_t* pOutput, size_t frameCount) = 0;
+
+		/**
+		 * decodes the next frames directly into the buffer.
+		 * 
+		 * @param buffer the buffer that will receive the frames, must have the same channel count as the output format.
+		 * @param frameIndex index of the first frame of the buffer that will be written.
+		 * @param frameCount number of frames to decode.
+		 * @return number of frames written, less than frameCount at the end of the file.
+		 * 
+		 */
+		size_t DecodeInto(AudioBuffer& buffer, size_t frameIndex, size_t frameCount);
+
+		/**
+		 * decodes the next frames directly into the writable region of the ring buffer.
+		 * 
+		 * @param ringBuffer the ring buffer that will receive the frames, must have the same channel count as the output format.
+		 * @param frameCount maximum number of frames to decode, limited by the writable frame count of the ring buffer.
+		 * @return number of frames written.
+		 * 
+		 */
+		size_t DecodeInto(AudioRingBuffer& ringBuffer, size_t frameCount);
 	};
 }
\ No newline at end of file
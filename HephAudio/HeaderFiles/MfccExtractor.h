@@ -0,0 +1,157 @@
+#pragma once
+#include "HephAudioShared.h"
+#include "AudioBuffer.h"
+#include "IAudioDecoder.h"
+#include "StftAnalyzer.h"
+#include "SpectralFilterbank.h"
+#include <vector>
+#include <memory>
+#include <functional>
+#include <filesystem>
+
+/** @file */
+
+namespace HephAudio
+{
+	/**
+	 * @brief extracts the log filterbank energies (i.e. log-mel spectrogram) and the mel-frequency cepstral coefficients (MFCC) of a channel.
+	 * The power spectrum of each frame is calculated via \link HephAudio::StftAnalyzer StftAnalyzer \endlink, passed through a \link HephAudio::SpectralFilterbank SpectralFilterbank \endlink
+	 * and the natural logarithm of the filter outputs are transformed with the orthonormal DCT-II.
+	 * Results are stored frame by frame, like the output of \link HephAudio::StftAnalyzer StftAnalyzer \endlink.
+	 *
+	 */
+	class HEPH_API MfccExtractor final
+	{
+	public:
+		/**
+		 * creates a new decoder instance, see \link HephAudio::Native::AudioDecoderFactory AudioDecoderFactory \endlink.
+		 *
+		 */
+		using DecoderFactory = std::function<std::shared_ptr<IAudioDecoder>()>;
+
+	private:
+		/**
+		 * calculates the power spectra.
+		 *
+		 */
+		StftAnalyzer stft;
+
+		/**
+		 * filters applied to the power spectra.
+		 *
+		 */
+		SpectralFilterbank filterbank;
+
+		/**
+		 * number of coefficients calculated for each frame, starting from the 0th coefficient.
+		 *
+		 */
+		size_t coefficientCount;
+
+		/** coefficientCount x filterCount DCT-II matrix. */
+		std::vector<double> dctMatrix;
+
+	public:
+		/**
+		 * @copydoc constructor
+		 * Uses mel filters that cover the frequencies from 0 to the Nyquist frequency.
+		 *
+		 * @param wnd window that's applied to each frame, the frames are zero padded to the next power of 2.
+		 * @param hopSize number of samples between the starts of the consecutive frames.
+		 * @param sampleRate sample rate of the analyzed audio.
+		 * @param filterCount number of mel filters.
+		 * @param coefficientCount @copydetails coefficientCount
+		 */
+		MfccExtractor(const Window& wnd, size_t hopSize, uint32_t sampleRate, size_t filterCount, size_t coefficientCount);
+
+		/**
+		 * @copydoc constructor
+		 *
+		 * @param stft @copydetails stft
+		 * @param filterbank @copydetails filterbank Must have \link HephAudio::StftAnalyzer::GetBinCount stft.GetBinCount() \endlink bins.
+		 * @param coefficientCount @copydetails coefficientCount Must not be greater than the number of filters.
+		 */
+		MfccExtractor(const StftAnalyzer& stft, const SpectralFilterbank& filterbank, size_t coefficientCount);
+
+		/**
+		 * gets the STFT analyzer.
+		 *
+		 */
+		const StftAnalyzer& GetStftAnalyzer() const;
+
+		/**
+		 * gets the filterbank.
+		 *
+		 */
+		const SpectralFilterbank& GetFilterbank() const;
+
+		/**
+		 * gets the number of coefficients calculated for each frame.
+		 *
+		 */
+		size_t GetCoefficientCount() const;
+
+		/**
+		 * gets the number of threads used, per buffer for a single buffer and per file for multiple files.
+		 *
+		 */
+		size_t GetThreadCount() const;
+
+		/**
+		 * sets the number of threads used, per buffer for a single buffer and per file for multiple files.
+		 *
+		 * @param threadCount number of threads, 0 to use the number of hardware threads.
+		 */
+		void SetThreadCount(size_t threadCount);
+
+		/**
+		 * calculates the number of frames produced for the provided number of samples.
+		 *
+		 */
+		size_t CalculateFrameCount(size_t sampleCount) const;
+
+		/**
+		 * calculates the log filterbank energies of a channel of the whole buffer.
+		 *
+		 * @param buffer the audio data.
+		 * @param channelIndex index of the channel that will be analyzed.
+		 * @param pOutput memory that will receive the results,
+		 * must have space for at least <b>CalculateFrameCount(buffer.FrameCount()) * GetFilterbank().GetFilterCount()</b> elements.
+		 */
+		void ExtractLogEnergies(const AudioBuffer& buffer, size_t channelIndex, double* pOutput) const;
+
+		/**
+		 * calculates the MFCCs of a channel of the whole buffer.
+		 *
+		 * @param buffer the audio data.
+		 * @param channelIndex index of the channel that will be analyzed.
+		 * @param pOutput memory that will receive the results,
+		 * must have space for at least <b>CalculateFrameCount(buffer.FrameCount()) * GetCoefficientCount()</b> elements.
+		 */
+		void Extract(const AudioBuffer& buffer, size_t channelIndex, double* pOutput) const;
+
+		/**
+		 * calculates the MFCCs of a channel while decoding the rest of the file a block at a time,
+		 * hence the decoded audio is never stored as a whole.
+		 * The results are the same as decoding the file and calling \link HephAudio::MfccExtractor::Extract(const AudioBuffer&, size_t, double*) const Extract \endlink.
+		 *
+		 * @param decoder decoder that has the file open.
+		 * @param channelIndex index of the channel that will be analyzed.
+		 * @return the MFCCs of each frame.
+		 */
+		std::vector<double> Extract(IAudioDecoder& decoder, size_t channelIndex) const;
+
+		/**
+		 * calculates the MFCCs of a channel of each file, multiple files are processed at once.
+		 *
+		 * @param filePaths paths of the files.
+		 * @param channelIndex index of the channel that will be analyzed.
+		 * @param decoderFactory creates the decoder of each thread.
+		 * @return the MFCCs of each file in the same order as the paths.
+		 */
+		std::vector<std::vector<double>> Extract(const std::vector<std::filesystem::path>& filePaths, size_t channelIndex, const DecoderFactory& decoderFactory) const;
+
+	private:
+		void ProcessFrames(const double* pPowerSpectra, size_t frameCount, double* pEnergies, double* pOutput) const;
+	};
+}
\ No newline at end of file
@@ -27,6 +27,8 @@ namespace HephAudio
 			AAudioStream* pCaptureStream;
 			size_t renderBufferFrameCount;
 			size_t captureBufferFrameCount;
+			int32_t renderXRunCount;
+			int32_t captureXRunCount;
 			double masterVolume;
 
 		public:
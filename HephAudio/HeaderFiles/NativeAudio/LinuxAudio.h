@@ -30,6 +30,10 @@ namespace HephAudio
 			AlsaParams params;
 			snd_pcm_t* renderPcm;
 			snd_pcm_t* capturePcm;
+			bool isRenderMmap;
+			bool isCaptureMmap;
+			std::vector<uint8_t> renderTransferBuffer;
+			std::vector<uint8_t> captureTransferBuffer;
 
 		public:
 			/** @copydoc default_constructor */
@@ -52,8 +56,10 @@ namespace HephAudio
 
 		private:
 			bool EnumerateAudioDevices() override;
-			void RenderData(useconds_t bufferDuration_us);
-			void CaptureData(useconds_t bufferDuration_us);
+			void RenderData();
+			void CaptureData();
+			void ConfigurePcm(snd_pcm_t* pcm, AudioFormatInfo& format, double periodDuration_ms, uint32_t& periodSize_frame, uint32_t& periodCount, uint32_t& bufferSize_frame, bool& isMmap);
+			bool RecoverPcm(snd_pcm_t* pcm, int error);
 			snd_pcm_format_t ToPcmFormat(const AudioFormatInfo& format) const;
 			snd_pcm_chmap* ToPcmChmap(const AudioFormatInfo& format) const;
 		};
@@ -5,28 +5,128 @@
 #include "AudioFormatInfo.h"
 #include "IAudioDecoder.h"
 #include "IAudioEncoder.h"
+#include "AudioAssetCache.h"
 #include "Params/NativeAudioParams.h"
+#include "RenderMetrics.h"
+#include "AudioBusGraph.h"
+#include "AudioRingBuffer.h"
+#include "SampleFormatConverter.h"
 #include "Event.h"
 #include "StringHelpers.h"
+#include "ThreadPool.h"
 #include <memory>
 #include <string>
 #include <vector>
 #include <list>
 #include <thread>
 #include <mutex>
+#include <functional>
+#include <future>
+#include <exception>
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#endif
 
 /** @file */
 
+/**
+ * maximum number of threads that decode the files loaded by \link HephAudio::Native::NativeAudio::LoadAsync NativeAudio::LoadAsync \endlink
+ * and \link HephAudio::Native::NativeAudio::PlayAsync NativeAudio::PlayAsync \endlink.
+ *
+ */
+#define HEPHAUDIO_LOAD_THREAD_COUNT (4)
+
 namespace HephAudio
 {
 	namespace Native
 	{
+		/**
+		 * creates a new decoder instance, used for the files that are loaded asynchronously so the loads do not share a decoder.
+		 *
+		 */
+		using AudioDecoderFactory = std::function<std::shared_ptr<IAudioDecoder>()>;
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+		class AudioObjectAwaitable;
+#endif
+
+		/**
+		 * decides which audio objects become virtual when more audible objects are playing than the real voice limit.
+		 * Objects with higher \link HephAudio::AudioObject::priority priority \endlink are always kept real first,
+		 * the policy is applied among the objects with the same priority.
+		 * 
+		 */
+		enum VoiceStealingPolicy
+		{
+			/**
+			 * the objects with the lowest volume become virtual.
+			 * 
+			 */
+			StealQuietest = 0,
+
+			/**
+			 * the objects that are created first become virtual.
+			 * 
+			 */
+			StealOldest = 1,
+
+			/**
+			 * the objects that are created last become virtual, hence new objects wait until a real voice is available.
+			 * 
+			 */
+			StealNewest = 2
+		};
+
 		/**
 		 * @brief base class for the classes that interact with the native audio APIs.
 		 * 
 		 */
 		class HEPH_API NativeAudio
 		{
+		protected:
+			/**
+			 * @brief an audio object that's playing in the current render period.
+			 * 
+			 */
+			struct Voice
+			{
+				/**
+				 * pointer to the audio object.
+				 * 
+				 */
+				AudioObject* pAudioObject;
+
+				/**
+				 * unique identifier of the audio object, used to check whether it's destroyed by an event handler.
+				 * 
+				 */
+				Heph::Guid id;
+
+				/**
+				 * final volume of the audio object.
+				 * 
+				 */
+				double volume;
+
+				/**
+				 * indicates whether the object is mixed.
+				 * 
+				 */
+				bool isReal;
+
+				/**
+				 * indicates the object was virtual and is faded in during the period.
+				 * 
+				 */
+				bool isFadingIn;
+
+				/**
+				 * indicates the object became virtual and is faded out during the period, it's virtual from the next period on.
+				 * 
+				 */
+				bool isFadingOut;
+			};
+
 		protected:
 			/**
 			 * indicates the device enumeration has failed.
@@ -47,18 +147,61 @@ namespace HephAudio
 			 */
 			std::shared_ptr<IAudioDecoder> pAudioDecoder;
 
+			/**
+			 * creates the decoders that are used by the asynchronous loads.
+			 * 
+			 */
+			AudioDecoderFactory audioDecoderFactory;
+
 			/**
 			 * shared pointer to the encoder instance that's used internally.
 			 * 
 			 */
 			std::shared_ptr<IAudioEncoder> pAudioEncoder;
 
+			/**
+			 * shared pointer to the cache that stores the files decoded by \link HephAudio::Native::NativeAudio::Play Play \endlink, nullptr if caching is disabled.
+			 * Caching is disabled by default.
+			 * 
+			 */
+			std::shared_ptr<AudioAssetCache> pAssetCache;
+
+			/**
+			 * files longer than this number of frames are kept in memory compressed and decoded while rendering, 0 to disable.
+			 * 
+			 */
+			size_t compressedResidencyThreshold_frame;
+
+			/**
+			 * maximum number of audio objects that are mixed each period, 0 for no limit.
+			 * 
+			 */
+			size_t maxRealVoiceCount;
+
+			/**
+			 * decides which audio objects become virtual when the real voice limit is exceeded.
+			 * 
+			 */
+			VoiceStealingPolicy voiceStealingPolicy;
+
+			/**
+			 * audio objects whose final volume is less than or equal to this value are virtual.
+			 * 
+			 */
+			double virtualVolumeThreshold;
+
 			/**
 			 * a list of audio objects.
 			 * 
 			 */
 			std::list<AudioObject> audioObjects;
 
+			/**
+			 * incremented each time an audio object is created or destroyed, the mixer uses it to detect the changes made by the event handlers.
+			 * 
+			 */
+			uint64_t audioObjectsGeneration;
+
 			/**
 			 * a list of audio devices present in the system.
 			 * 
@@ -143,6 +286,12 @@ namespace HephAudio
 			 */
 			uint32_t deviceEnumerationPeriod_ms;
 
+			/**
+			 * minimum duration, in milliseconds, of the audio the capture ring buffer can hold.
+			 * 
+			 */
+			uint32_t captureRingBufferDuration_ms;
+
 			/**
 			 * to prevent race condition when accessing/enumerating audio devices.
 			 * 
@@ -155,6 +304,66 @@ namespace HephAudio
 			 */
 			mutable std::recursive_mutex audioObjectsMutex;
 
+			/**
+			 * timings and error counters of the render and capture threads.
+			 * 
+			 */
+			RenderMetrics renderMetrics;
+
+			/**
+			 * mix buffer that's reused by the render thread to avoid allocating each period.
+			 * 
+			 */
+			AudioBuffer renderMixBuffer;
+
+			/**
+			 * dither applied when the mixed audio is converted to an integer render format.
+			 * 
+			 */
+			DitherState renderDitherState;
+
+			/**
+			 * captured audio, written by every backend through \link NativeAudio::DeliverCapturedData DeliverCapturedData \endlink and shared with the consumer threads.
+			 * 
+			 */
+			AudioRingBuffer captureRingBuffer;
+
+			/**
+			 * buffer the captured periods are converted into, preallocated when the capture is initialized.
+			 * 
+			 */
+			AudioBuffer capturePeriodBuffer;
+
+			/**
+			 * captured periods whose byte order differs from the system's are swapped into this buffer before the conversion, empty if the capture format does not need it.
+			 * 
+			 */
+			std::vector<uint8_t> captureSwapBuffer;
+
+			/**
+			 * playing audio objects of the current render period, reused to avoid allocating each period.
+			 * 
+			 */
+			std::vector<Voice> voices;
+
+			/**
+			 * indices of the audible voices, reused to avoid allocating each period.
+			 * 
+			 */
+			std::vector<size_t> audibleVoiceIndices;
+
+			/**
+			 * submix buses the audio objects are routed to.
+			 * 
+			 */
+			AudioBusGraph busGraph;
+
+			/**
+			 * decodes the files loaded asynchronously, declared last so the running loads finish before the other members are destroyed.
+			 * 
+			 */
+			Heph::ThreadPool loadThreadPool;
+
 		public:
 			/**
 			 * raised when an audio device is connected to the device or activated.
@@ -169,8 +378,12 @@ namespace HephAudio
 			Heph::Event OnAudioDeviceRemoved;
 
 			/**
-			 * raised when sufficient amount of audio data is captured.
+			 * raised on the capture thread each time a period is captured, kept for compatibility.
+			 * The handlers run synchronously before the next period is read, so slow handlers make the device overrun.
+			 * Consumers should read the \link NativeAudio::GetCaptureRingBuffer capture ring buffer \endlink instead.
 			 * 
+			 * @note \link HephAudio::AudioCaptureEventArgs::captureBuffer captureBuffer \endlink is the internal period buffer lent to the handlers for the duration of the event,
+			 * copy it to keep the data.
 			 */
 			Heph::Event OnCapture;
 
@@ -197,6 +410,20 @@ namespace HephAudio
 			 */
 			void SetAudioDecoder(std::shared_ptr<IAudioDecoder> pNewDecoder);
 
+			/**
+			 * gets the function that creates the decoders used by the asynchronous loads.
+			 * 
+			 */
+			AudioDecoderFactory GetAudioDecoderFactory() const;
+
+			/**
+			 * sets the function that creates the decoders used by the asynchronous loads.
+			 * Each load creates its own decoder, hence the loads can run in parallel.
+			 * 
+			 * @param newDecoderFactory function that returns a new decoder each time it's called, must be callable from any thread.
+			 */
+			void SetAudioDecoderFactory(AudioDecoderFactory newDecoderFactory);
+
 			/**
 			 * gets the shared pointer to the audio encoder instance.
 			 * 
@@ -210,6 +437,128 @@ namespace HephAudio
 			 */
 			void SetAudioEncoder(std::shared_ptr<IAudioEncoder> pNewEncoder);
 
+			/**
+			 * gets the shared pointer to the cache that stores the decoded files.
+			 * 
+			 */
+			std::shared_ptr<AudioAssetCache> GetAssetCache() const;
+
+			/**
+			 * sets the cache that stores the decoded files, the same cache can be shared between multiple instances.
+			 * The objects created while a cache is set play the data via \link HephAudio::AudioObject::pSharedBuffer pSharedBuffer \endlink
+			 * and leave \link HephAudio::AudioObject::buffer buffer \endlink empty until \link HephAudio::AudioObject::DetachSharedBuffer DetachSharedBuffer \endlink is called.
+			 * 
+			 * @param pNewAssetCache shared pointer to the new cache, nullptr to decode the file each time it's played.
+			 */
+			void SetAssetCache(std::shared_ptr<AudioAssetCache> pNewAssetCache);
+
+			/**
+			 * gets the minimum number of frames a file must have to be kept in memory compressed.
+			 * 
+			 */
+			size_t GetCompressedResidencyThreshold() const;
+
+			/**
+			 * sets the minimum number of frames a file must have to be kept in memory compressed.
+			 * Files longer than the threshold are stored as \link HephAudio::CompressedAudioBuffer CompressedAudioBuffer \endlink
+			 * and each playing object decodes a block at a time while rendering.
+			 * 
+			 * @param threshold_frame number of frames, 0 to always keep the decoded data.
+			 */
+			void SetCompressedResidencyThreshold(size_t threshold_frame);
+
+			/**
+			 * gets the maximum number of audio objects that are mixed each period.
+			 * 
+			 */
+			size_t GetMaxRealVoiceCount() const;
+
+			/**
+			 * sets the maximum number of audio objects that are mixed each period.
+			 * The other playing objects are virtual, they only advance their position and cost no decoding, resampling or mixing.
+			 * 
+			 * @param maxRealVoiceCount maximum number of real voices, 0 for no limit.
+			 */
+			void SetMaxRealVoiceCount(size_t maxRealVoiceCount);
+
+			/**
+			 * gets the policy that decides which audio objects become virtual when the real voice limit is exceeded.
+			 * 
+			 */
+			VoiceStealingPolicy GetVoiceStealingPolicy() const;
+
+			/**
+			 * sets the policy that decides which audio objects become virtual when the real voice limit is exceeded.
+			 * 
+			 */
+			void SetVoiceStealingPolicy(VoiceStealingPolicy voiceStealingPolicy);
+
+			/**
+			 * gets the volume at or below which the audio objects are virtual.
+			 * 
+			 */
+			double GetVirtualVolumeThreshold() const;
+
+			/**
+			 * sets the volume at or below which the audio objects are virtual.
+			 * The objects that are farther than their \link HephAudio::AudioObject::maxDistance maxDistance \endlink are virtual as well.
+			 * 
+			 * @param virtualVolumeThreshold final volume of the object, 0 to virtualize only the silent objects.
+			 */
+			void SetVirtualVolumeThreshold(double virtualVolumeThreshold);
+
+			/**
+			 * creates a submix bus.
+			 * 
+			 * @param name unique name of the bus.
+			 * @param outputBusName name of the bus the output is mixed into, empty for the master bus.
+			 * @return pointer to the bus, valid until it's destroyed. Lock the audio objects while modifying it.
+			 */
+			AudioBus* CreateBus(const std::string& name, const std::string& outputBusName = "");
+
+			/**
+			 * destroys a submix bus, the buses and the audio objects routed to it are mixed into the master bus instead.
+			 * 
+			 * @param name name of the bus.
+			 * @return true if the bus is found and destroyed, otherwise false. The master bus can not be destroyed.
+			 */
+			bool DestroyBus(const std::string& name);
+
+			/**
+			 * gets a submix bus.
+			 * 
+			 * @param name name of the bus.
+			 * @return pointer to the bus if found, otherwise nullptr.
+			 */
+			AudioBus* GetBus(const std::string& name);
+
+			/**
+			 * gets the bus every other bus and audio object is eventually mixed into.
+			 * 
+			 */
+			AudioBus* GetMasterBus();
+
+			/**
+			 * gets the number of buses, including the master bus.
+			 * 
+			 */
+			size_t GetBusCount() const;
+
+			/**
+			 * gets the maximum number of threads, including the render thread, that apply the effects of the buses.
+			 * 
+			 */
+			size_t GetBusThreadCount() const;
+
+			/**
+			 * sets the maximum number of threads, including the render thread, that apply the effects of the buses.
+			 * Buses that do not feed into each other, directly or through other buses, are processed in parallel.
+			 * The default is 1, no worker threads are started until this is called with a larger count.
+			 * 
+			 * @param threadCount 1 to process the buses on the render thread only, 0 to use the number of hardware threads.
+			 */
+			void SetBusThreadCount(size_t threadCount);
+
 			/**
 			 * reads the file, then starts playing it.
 			 * 
@@ -245,6 +594,64 @@ namespace HephAudio
 			 */			
 			AudioObject* Load(const std::filesystem::path& filePath, uint32_t playCount);
 
+			/**
+			 * reads the file on a worker thread, then starts playing it.
+			 * The file is decoded without locking the audio objects, so the render thread is not stalled.
+			 * 
+			 * @param filePath path of the file which will be played.
+			 * @return future that provides the pointer to the audio object instance, or the exception if the file could not be read.
+			 */
+			std::future<AudioObject*> PlayAsync(const std::filesystem::path& filePath);
+
+			/**
+			 * reads the file on a worker thread, then starts playing it.
+			 * The file is decoded without locking the audio objects, so the render thread is not stalled.
+			 * 
+			 * @param filePath path of the file which will be played.
+			 * @param playCount number of times the file will be played.
+			 * @return future that provides the pointer to the audio object instance, or the exception if the file could not be read.
+			 */
+			std::future<AudioObject*> PlayAsync(const std::filesystem::path& filePath, uint32_t playCount);
+
+			/**
+			 * reads the file on a worker thread but does not start playing it.
+			 * The file is decoded without locking the audio objects, so the render thread is not stalled.
+			 * 
+			 * @param filePath path of the file which will be loaded.
+			 * @return future that provides the pointer to the audio object instance, or the exception if the file could not be read.
+			 */
+			std::future<AudioObject*> LoadAsync(const std::filesystem::path& filePath);
+
+			/**
+			 * reads the file on a worker thread but does not start playing it.
+			 * The file is decoded without locking the audio objects, so the render thread is not stalled.
+			 * 
+			 * @param filePath path of the file which will be loaded.
+			 * @param playCount number of times the file will be played.
+			 * @return future that provides the pointer to the audio object instance, or the exception if the file could not be read.
+			 */
+			std::future<AudioObject*> LoadAsync(const std::filesystem::path& filePath, uint32_t playCount);
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+			/**
+			 * same as \link HephAudio::Native::NativeAudio::PlayAsync PlayAsync \endlink but the result is obtained with co_await.
+			 * The coroutine is resumed on the worker thread that loaded the file.
+			 * 
+			 * @param filePath path of the file which will be played.
+			 * @param playCount number of times the file will be played.
+			 */
+			AudioObjectAwaitable AwaitPlay(const std::filesystem::path& filePath, uint32_t playCount = 1);
+
+			/**
+			 * same as \link HephAudio::Native::NativeAudio::LoadAsync LoadAsync \endlink but the result is obtained with co_await.
+			 * The coroutine is resumed on the worker thread that loaded the file.
+			 * 
+			 * @param filePath path of the file which will be loaded.
+			 * @param playCount number of times the file will be played.
+			 */
+			AudioObjectAwaitable AwaitLoad(const std::filesystem::path& filePath, uint32_t playCount = 1);
+#endif
+
 			/**
 			 * creates an audio object with the provided buffer info.
 			 * 
@@ -349,6 +756,54 @@ namespace HephAudio
 			 */
 			void SetDeviceEnumerationPeriod(uint32_t deviceEnumerationPeriod_ms);
 
+			/**
+			 * gets the timings and the error counters of the render and capture threads.
+			 * Can be read from any thread without blocking rendering.
+			 * 
+			 */
+			RenderMetrics& GetRenderMetrics();
+
+			/**
+			 * gets the timings and the error counters of the render and capture threads.
+			 * Can be read from any thread without blocking rendering.
+			 * 
+			 */
+			const RenderMetrics& GetRenderMetrics() const;
+
+			/**
+			 * gets the ring buffer that receives the captured audio in internal format.
+			 * A single consumer thread can read from it at its own pace without blocking the capture thread,
+			 * frames that do not fit when the consumer falls behind are dropped and counted.
+			 * 
+			 * @important the ring buffer is reset when the capture is initialized, reading must be stopped beforehand.
+			 */
+			AudioRingBuffer& GetCaptureRingBuffer();
+
+			/**
+			 * gets the \link NativeAudio::captureRingBufferDuration_ms capture ring buffer duration.
+			 * 
+			 */
+			uint32_t GetCaptureRingBufferDuration() const;
+
+			/**
+			 * sets the \link NativeAudio::captureRingBufferDuration_ms capture ring buffer duration.
+			 * Takes effect the next time the capture is initialized.
+			 * 
+			 */
+			void SetCaptureRingBufferDuration(uint32_t captureRingBufferDuration_ms);
+
+			/**
+			 * gets the dither that's applied when the mixed audio is converted to an integer render format.
+			 * 
+			 */
+			DitherMode GetRenderDitherMode() const;
+
+			/**
+			 * sets the dither that's applied when the mixed audio is converted to an integer render format.
+			 * 
+			 */
+			void SetRenderDitherMode(DitherMode ditherMode);
+
 			/**
 			 * sets the master volume. 
 			 * 
@@ -526,22 +981,157 @@ namespace HephAudio
 
 			/**
 			 * mixes the audio objects that are currently playing into one buffer.
+			 * Allocates the returned buffer each call, the backends use the overload that writes directly to the device buffer.
 			 * 
 			 * @param frameCount number of frames the output buffer will have.
 			 */
 			EncodedAudioBuffer Mix(uint32_t frameCount);
 
+			/**
+			 * mixes the audio objects that are currently playing and writes the result, in the render format, directly to the provided memory.
+			 * Does not allocate unless the frame count or the render format changes.
+			 * 
+			 * @param frameCount number of frames to mix.
+			 * @param pOutput memory that will receive the mixed audio, must be at least <b>frameCount * renderFormat.FrameSize()</b> bytes.
+			 */
+			void Mix(uint32_t frameCount, void* pOutput);
+
+			/**
+			 * renders the audio objects that are currently playing, mixes them into their buses, then processes the buses into the mix buffer.
+			 * 
+			 * @param mixBuffer buffer that will receive the mixed audio, must be silent and have \a frameCount frames.
+			 * @param frameCount number of frames to mix.
+			 */
+			void MixAudioObjects(AudioBuffer& mixBuffer, uint32_t frameCount);
+
+			/**
+			 * adds the rendered audio of a voice to a buffer, ramping the gain if the voice is fading in or out.
+			 * 
+			 */
+			static void MixVoice(AudioBuffer& targetBuffer, const AudioBuffer& renderBuffer, uint32_t frameCount, double volume, const Voice& voice);
+
+			/**
+			 * allocates the capture ring buffer and the period buffer, must be called before the capture thread starts.
+			 * 
+			 * @param periodSize_frame maximum number of frames the capture thread delivers at once.
+			 */
+			void PrepareCaptureBuffers(size_t periodSize_frame);
+
+			/**
+			 * converts the captured audio to the internal format, writes it to the capture ring buffer and raises the \link NativeAudio::OnCapture OnCapture \endlink event.
+			 * Does not allocate unless a partial period is delivered while an \link NativeAudio::OnCapture OnCapture \endlink handler is attached,
+			 * or the capture format cannot be converted without the decoder.
+			 * 
+			 * @param pCapturedData interleaved audio data in capture format.
+			 * @param frameCount number of frames, must not exceed the period size provided to \link NativeAudio::PrepareCaptureBuffers PrepareCaptureBuffers.
+			 */
+			void DeliverCapturedData(const void* pCapturedData, size_t frameCount);
+
 			/**
 			 * gets the number of audio objects that will are currently playing.
 			 * 
 			 */
 			size_t GetAOCountToMix() const;
 
+			/**
+			 * decides which of the playing audio objects are mixed in the current period, fills \link NativeAudio::voices voices \endlink.
+			 * 
+			 * @return number of objects that became virtual to stay within the real voice limit.
+			 */
+			size_t SelectVoices();
+
 			/**
 			 * calculates the volume of the audio object.
 			 * 
 			 */
 			virtual double GetFinalAOVolume(AudioObject* pAudioObject) const;
+
+			/**
+			 * reads the file into the audio object, the audio objects do not need to be locked.
+			 * 
+			 * @param audioObject object that will hold the audio data.
+			 * @param filePath path of the file which will be read.
+			 * @param decoder decoder that's used only by the caller.
+			 * @param pAssetCache cache that stores the decoded files, nullptr to decode the file.
+			 * @param compressedResidencyThreshold_frame see \link NativeAudio::SetCompressedResidencyThreshold SetCompressedResidencyThreshold \endlink.
+			 */
+			static void ReadFile(AudioObject& audioObject, const std::filesystem::path& filePath, IAudioDecoder& decoder,
+				const std::shared_ptr<AudioAssetCache>& pAssetCache, size_t compressedResidencyThreshold_frame);
+
+			/**
+			 * reads the file on a worker thread, then adds the audio object.
+			 * 
+			 * @param filePath path of the file which will be read.
+			 * @param playCount number of times the file will be played.
+			 * @param isPaused whether the audio object is paused after it's added.
+			 * @param onLoaded called on the worker thread with the added audio object, or with the exception if the file could not be read.
+			 */
+			void SubmitLoad(const std::filesystem::path& filePath, uint32_t playCount, bool isPaused, std::function<void(AudioObject*, std::exception_ptr)> onLoaded);
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+			friend class AudioObjectAwaitable;
+#endif
+		};
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+		/**
+		 * @brief awaitable returned by \link HephAudio::Native::NativeAudio::AwaitPlay NativeAudio::AwaitPlay \endlink
+		 * and \link HephAudio::Native::NativeAudio::AwaitLoad NativeAudio::AwaitLoad \endlink.
+		 * The load starts when the awaitable is awaited. If the native audio instance is destroyed before the file is read, the coroutine is never resumed.
+		 * 
+		 */
+		class AudioObjectAwaitable final
+		{
+		private:
+			NativeAudio* pNativeAudio;
+			std::filesystem::path filePath;
+			uint32_t playCount;
+			bool isPaused;
+			AudioObject* pAudioObject;
+			std::exception_ptr pException;
+
+		public:
+			/**
+			 * @copydoc constructor
+			 * 
+			 * @param pNativeAudio instance that will own the audio object.
+			 * @param filePath path of the file which will be read.
+			 * @param playCount number of times the file will be played.
+			 * @param isPaused whether the audio object is paused after it's added.
+			 */
+			AudioObjectAwaitable(NativeAudio* pNativeAudio, const std::filesystem::path& filePath, uint32_t playCount, bool isPaused)
+				: pNativeAudio(pNativeAudio), filePath(filePath), playCount(playCount), isPaused(isPaused), pAudioObject(nullptr), pException(nullptr) {}
+
+			bool await_ready() const noexcept
+			{
+				return false;
+			}
+
+			void await_suspend(std::coroutine_handle<> handle)
+			{
+				// the awaitable lives in the suspended coroutine's frame until it's resumed.
+				this->pNativeAudio->SubmitLoad(this->filePath, this->playCount, this->isPaused,
+					[this, handle](AudioObject* pAudioObject, std::exception_ptr pException)
+					{
+						this->pAudioObject = pAudioObject;
+						this->pException = pException;
+						handle.resume();
+					});
+			}
+
+			/**
+			 * gets the pointer to the audio object instance, rethrows the exception if the file could not be read.
+			 * 
+			 */
+			AudioObject* await_resume() const
+			{
+				if (this->pException != nullptr)
+				{
+					std::rethrow_exception(this->pException);
+				}
+				return this->pAudioObject;
+			}
 		};
+#endif
 	}
 }
\ No newline at end of file
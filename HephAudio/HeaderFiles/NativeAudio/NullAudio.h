@@ -0,0 +1,85 @@
+#pragma once
+#include "HephAudioShared.h"
+#include "NativeAudio.h"
+#include "Params/NullAudioParams.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+/** @file */
+
+namespace HephAudio
+{
+	namespace Native
+	{
+		/**
+		 * @brief uses no audio hardware, available on all platforms.
+		 * The render and capture threads are driven by a \link HephAudio::Native::NullAudioClock virtual clock \endlink,
+		 * the rendered audio can be written to a WAV file and the captured audio can be read from a file.
+		 *
+		 */
+		class HEPH_API NullAudio final : public NativeAudio
+		{
+		public:
+			using NativeAudio::InitializeRender;
+			using NativeAudio::InitializeCapture;
+
+		private:
+			NullAudioParams params;
+			double masterVolume;
+			uint32_t renderPeriodSize_frame;
+			uint32_t capturePeriodSize_frame;
+			std::atomic<uint64_t> renderedFrameCount;
+			std::atomic<uint64_t> capturedFrameCount;
+			std::vector<uint8_t> renderTransferBuffer;
+			std::vector<uint8_t> captureTransferBuffer;
+			std::vector<uint8_t> captureFileData;
+			std::vector<uint8_t> captureSilence;
+			size_t captureFilePosition_frame;
+			FILE* pRenderFile;
+			uint64_t renderFileDataSize;
+
+		public:
+			/** @copydoc default_constructor */
+			NullAudio();
+
+			NullAudio(const NullAudio&) = delete;
+			NullAudio& operator=(const NullAudio&) = delete;
+
+			/** @copydoc destructor */
+			~NullAudio();
+
+			void SetMasterVolume(double volume) override;
+			double GetMasterVolume() const override;
+			void InitializeRender(AudioDevice* device, AudioFormatInfo format) override;
+			void StopRendering() override;
+			void InitializeCapture(AudioDevice* device, AudioFormatInfo format) override;
+			void StopCapturing() override;
+			void GetNativeParams(NativeAudioParams& nativeParams) const override;
+			void SetNativeParams(const NativeAudioParams& nativeParams) override;
+
+			/**
+			 * gets the number of frames rendered since the render was initialized.
+			 *
+			 */
+			uint64_t GetRenderedFrameCount() const;
+
+			/**
+			 * gets the number of frames captured since the capture was initialized.
+			 *
+			 */
+			uint64_t GetCapturedFrameCount() const;
+
+		private:
+			bool EnumerateAudioDevices() override;
+			double GetFinalAOVolume(AudioObject* pAudioObject) const override;
+			void RenderData();
+			void CaptureData();
+			void WaitForNextPeriod(std::chrono::steady_clock::time_point& startTime, uint64_t& elapsedFrameCount, uint32_t periodSize_frame, uint32_t sampleRate, bool isRender);
+			void EncodeCaptureData(const AudioBuffer& buffer, std::vector<uint8_t>& data);
+			void OpenRenderFile();
+			void CloseRenderFile();
+		};
+	}
+}
\ No newline at end of file
@@ -16,20 +16,73 @@ namespace HephAudio
         struct HEPH_API AlsaParams final : public NativeAudioParams
         {
             /**
-             * duration of the render buffer in milliseconds.
+             * duration of a render period in milliseconds.
+             * Used when \a renderPeriodSize_frame is 0.
              * 
              */
             double renderBufferDuration_ms;
 
             /**
-             * duration of the capture buffer in milliseconds.
+             * duration of a capture period in milliseconds.
+             * Used when \a capturePeriodSize_frame is 0.
              * 
              */
             double captureBufferDuration_ms;
 
+            /**
+             * number of frames the render thread mixes each time the device wakes it up, 0 to calculate from \a renderBufferDuration_ms.
+             * Updated with the value the device accepted after the render is initialized.
+             * 
+             */
+            uint32_t renderPeriodSize_frame;
+
+            /**
+             * number of frames the capture thread reads each time the device wakes it up, 0 to calculate from \a captureBufferDuration_ms.
+             * Updated with the value the device accepted after the capture is initialized.
+             * 
+             */
+            uint32_t capturePeriodSize_frame;
+
+            /**
+             * number of periods in the render ring buffer.
+             * Updated with the value the device accepted after the render is initialized.
+             * 
+             */
+            uint32_t renderPeriodCount;
+
+            /**
+             * number of periods in the capture ring buffer.
+             * Updated with the value the device accepted after the capture is initialized.
+             * 
+             */
+            uint32_t capturePeriodCount;
+
+            /**
+             * size of the render ring buffer in frames, set after the render is initialized.
+             * 
+             */
+            uint32_t renderBufferSize_frame;
+
+            /**
+             * size of the capture ring buffer in frames, set after the capture is initialized.
+             * 
+             */
+            uint32_t captureBufferSize_frame;
+
+            /**
+             * indicates whether to transfer the data by directly accessing the device ring buffer (mmap).
+             * Falls back to read/write transfers if the device does not support it.
+             * 
+             */
+            bool enableMmap;
+
             /** @copydoc default_constructor */
             AlsaParams()
-                : renderBufferDuration_ms(10), captureBufferDuration_ms(10) {}
+                : renderBufferDuration_ms(10), captureBufferDuration_ms(10),
+                renderPeriodSize_frame(0), capturePeriodSize_frame(0),
+                renderPeriodCount(2), capturePeriodCount(2),
+                renderBufferSize_frame(0), captureBufferSize_frame(0),
+                enableMmap(true) {}
         };
     }
 }
@@ -0,0 +1,79 @@
+#pragma once
+#include "HephAudioShared.h"
+#include "NativeAudioParams.h"
+#include <filesystem>
+
+/** @file */
+
+namespace HephAudio
+{
+	namespace Native
+	{
+		/**
+		 * @brief clocks that can drive the \link HephAudio::Native::NullAudio NullAudio \endlink render and capture threads.
+		 *
+		 */
+		enum NullAudioClock
+		{
+			/**
+			 * periods are processed back to back as fast as possible, for measuring the throughput.
+			 *
+			 */
+			FreeRunning = 0,
+
+			/**
+			 * each period is processed when a real device would request it.
+			 * Periods that are not ready in time are recorded as xruns in the \link HephAudio::Native::RenderMetrics render metrics \endlink.
+			 *
+			 */
+			RealTime = 1
+		};
+
+		/**
+		 * @brief struct for storing the \link HephAudio::Native::NullAudio NullAudio \endlink specific parameters.
+		 *
+		 */
+		struct HEPH_API NullAudioParams final : public NativeAudioParams
+		{
+			/**
+			 * clock that drives the render and capture threads.
+			 *
+			 */
+			NullAudioClock clock;
+
+			/**
+			 * duration of a render period in milliseconds.
+			 *
+			 */
+			double renderBufferDuration_ms;
+
+			/**
+			 * duration of a capture period in milliseconds.
+			 *
+			 */
+			double captureBufferDuration_ms;
+
+			/**
+			 * path of the WAV file the rendered audio is written to, empty to discard it.
+			 *
+			 */
+			std::filesystem::path renderFilePath;
+
+			/**
+			 * path of the audio file that's captured, empty to capture silence.
+			 *
+			 */
+			std::filesystem::path captureFilePath;
+
+			/**
+			 * indicates whether to start over when the end of the capture file is reached, otherwise silence is captured.
+			 *
+			 */
+			bool loopCaptureFile;
+
+			/** @copydoc default_constructor */
+			NullAudioParams()
+				: clock(NullAudioClock::RealTime), renderBufferDuration_ms(10), captureBufferDuration_ms(10), loopCaptureFile(true) {}
+		};
+	}
+}
\ No newline at end of file
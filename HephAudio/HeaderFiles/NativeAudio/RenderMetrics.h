@@ -0,0 +1,258 @@
+#pragma once
+#include "HephAudioShared.h"
+#include "TimingStatistics.h"
+#include "Guid.h"
+#include <atomic>
+#include <cstdint>
+
+/** @file */
+
+namespace HephAudio
+{
+	namespace Native
+	{
+		/**
+		 * @brief describes a render period that took longer than its duration.
+		 *
+		 */
+		struct HEPH_API DeadlineMissInfo
+		{
+			/**
+			 * zero-based index of the period.
+			 *
+			 */
+			uint64_t periodIndex;
+
+			/**
+			 * duration of the rendered audio in nanoseconds.
+			 *
+			 */
+			uint64_t period_ns;
+
+			/**
+			 * time spent mixing the period, including the encoding, in nanoseconds.
+			 *
+			 */
+			uint64_t mix_ns;
+
+			/**
+			 * time spent encoding the mixed audio in nanoseconds.
+			 *
+			 */
+			uint64_t encode_ns;
+
+			/**
+			 * unique identifier of the audio object whose render event took the longest during the period.
+			 *
+			 */
+			Heph::Guid slowestAudioObjectId;
+
+			/**
+			 * time spent in the render event of the slowest audio object in nanoseconds.
+			 *
+			 */
+			uint64_t slowestAudioObjectRender_ns;
+
+			/** @copydoc default_constructor */
+			DeadlineMissInfo();
+		};
+
+		/**
+		 * @brief collects the timings and the error counters of the render and capture threads.
+		 * The render thread records its measurements without locking or allocating,
+		 * the values can be read from any thread at any time.
+		 *
+		 */
+		class HEPH_API RenderMetrics final
+		{
+		private:
+			Heph::TimingStatistics mixStatistics;
+			Heph::TimingStatistics audioObjectRenderStatistics;
+			Heph::TimingStatistics encodeStatistics;
+			std::atomic<uint64_t> periodCount;
+			std::atomic<uint64_t> deadlineMissCount;
+			std::atomic<uint64_t> underrunCount;
+			std::atomic<uint64_t> overrunCount;
+			std::atomic<uint64_t> lastPeriod_ns;
+			std::atomic<int64_t> lastHeadroom_ns;
+			std::atomic<int64_t> minHeadroom_ns;
+			std::atomic<uint64_t> realVoiceCount;
+			std::atomic<uint64_t> virtualVoiceCount;
+			std::atomic<uint64_t> stolenVoiceCount;
+
+			// last deadline miss, guarded by a sequence lock so the fields are read consistently.
+			std::atomic<uint64_t> deadlineMissSequence;
+			std::atomic<uint64_t> dmPeriodIndex;
+			std::atomic<uint64_t> dmPeriod_ns;
+			std::atomic<uint64_t> dmMix_ns;
+			std::atomic<uint64_t> dmEncode_ns;
+			std::atomic<uint64_t> dmSlowestAudioObjectId[2];
+			std::atomic<uint64_t> dmSlowestAudioObjectRender_ns;
+
+			// state of the period that's being rendered, only accessed by the render thread.
+			Heph::Guid currentSlowestAudioObjectId;
+			uint64_t currentSlowestAudioObjectRender_ns;
+			uint64_t currentEncode_ns;
+
+		public:
+			/** @copydoc default_constructor */
+			RenderMetrics();
+
+			RenderMetrics(const RenderMetrics&) = delete;
+			RenderMetrics& operator=(const RenderMetrics&) = delete;
+
+			/**
+			 * marks the beginning of a render period, must be called from the render thread.
+			 *
+			 */
+			void BeginPeriod();
+
+			/**
+			 * records the time spent in the render event of an audio object, must be called from the render thread.
+			 *
+			 * @param audioObjectId unique identifier of the audio object.
+			 * @param duration_ns duration in nanoseconds.
+			 */
+			void RecordAudioObjectRender(const Heph::Guid& audioObjectId, uint64_t duration_ns);
+
+			/**
+			 * records the time spent encoding the mixed audio, must be called from the render thread.
+			 *
+			 * @param duration_ns duration in nanoseconds.
+			 */
+			void RecordEncode(uint64_t duration_ns);
+
+			/**
+			 * marks the end of a render period, must be called from the render thread.
+			 *
+			 * @param frameCount number of frames rendered in the period.
+			 * @param sampleRate sample rate of the rendered audio.
+			 * @param mix_ns time spent mixing the period in nanoseconds.
+			 */
+			void EndPeriod(size_t frameCount, uint32_t sampleRate, uint64_t mix_ns);
+
+			/**
+			 * records the result of the voice management of the period, must be called from the render thread.
+			 *
+			 * @param realVoiceCount number of audio objects that are mixed.
+			 * @param virtualVoiceCount number of audio objects that only advanced their position.
+			 * @param stolenVoiceCount number of audio objects that became virtual to stay within the real voice limit.
+			 */
+			void RecordVoices(size_t realVoiceCount, size_t virtualVoiceCount, size_t stolenVoiceCount);
+
+			/**
+			 * increments the number of render buffer underruns.
+			 *
+			 * @param count number of underruns that occurred.
+			 */
+			void RecordUnderrun(uint64_t count = 1);
+
+			/**
+			 * increments the number of capture buffer overruns.
+			 *
+			 * @param count number of overruns that occurred.
+			 */
+			void RecordOverrun(uint64_t count = 1);
+
+			/**
+			 * gets the time spent mixing each period, including the render events and the encoding.
+			 *
+			 */
+			Heph::TimingStatisticsSnapshot GetMixStatistics() const;
+
+			/**
+			 * gets the time spent in the render events of the audio objects, each event is recorded separately.
+			 *
+			 */
+			Heph::TimingStatisticsSnapshot GetAudioObjectRenderStatistics() const;
+
+			/**
+			 * gets the time spent encoding the mixed audio.
+			 *
+			 */
+			Heph::TimingStatisticsSnapshot GetEncodeStatistics() const;
+
+			/**
+			 * gets the number of rendered periods.
+			 *
+			 */
+			uint64_t GetPeriodCount() const;
+
+			/**
+			 * gets the number of periods that took longer to mix than their duration.
+			 *
+			 */
+			uint64_t GetDeadlineMissCount() const;
+
+			/**
+			 * gets the number of audio objects that were mixed in the last period.
+			 *
+			 */
+			uint64_t GetRealVoiceCount() const;
+
+			/**
+			 * gets the number of audio objects that were virtual in the last period.
+			 *
+			 */
+			uint64_t GetVirtualVoiceCount() const;
+
+			/**
+			 * gets the number of times a real audio object became virtual to stay within the real voice limit.
+			 *
+			 */
+			uint64_t GetStolenVoiceCount() const;
+
+			/**
+			 * gets the number of render buffer underruns reported by the native API.
+			 *
+			 */
+			uint64_t GetUnderrunCount() const;
+
+			/**
+			 * gets the number of capture buffer overruns reported by the native API.
+			 *
+			 */
+			uint64_t GetOverrunCount() const;
+
+			/**
+			 * gets the duration of the last rendered period in nanoseconds.
+			 *
+			 */
+			uint64_t GetLastPeriod_ns() const;
+
+			/**
+			 * gets the time that was left until the deadline after mixing the last period, in nanoseconds.
+			 * Negative values indicate a deadline miss.
+			 *
+			 */
+			int64_t GetLastHeadroom_ns() const;
+
+			/**
+			 * gets the smallest headroom recorded so far in nanoseconds, or 0 if no period is rendered yet.
+			 *
+			 */
+			int64_t GetMinHeadroom_ns() const;
+
+			/**
+			 * calculates the ratio of the mixing time to the period duration for the last period.
+			 *
+			 */
+			double GetLastLoad() const;
+
+			/**
+			 * gets the details of the most recent deadline miss.
+			 *
+			 * @param deadlineMissInfo receives the details.
+			 * @return true if a deadline miss occurred, otherwise false.
+			 */
+			bool GetLastDeadlineMiss(DeadlineMissInfo& deadlineMissInfo) const;
+
+			/**
+			 * clears the collected metrics.
+			 * The details of the last deadline miss are kept since they can only be written by the render thread.
+			 *
+			 */
+			void Reset();
+		};
+	}
+}
\ No newline at end of file
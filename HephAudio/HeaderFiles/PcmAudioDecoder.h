@@ -0,0 +1,128 @@
+#pragma once
+#include "HephAudioShared.h"
+#include "IAudioDecoder.h"
+#include "MemoryMappedFile.h"
+#include <memory>
+#include <vector>
+
+/** @file */
+
+namespace HephAudio
+{
+	/**
+	 * @brief decodes uncompressed WAV, RF64, W64, AIFF, AIFF-C and raw files without FFmpeg.
+	 * The file is memory mapped and the samples are converted straight from the mapping.
+	 * Files that are not in one of these formats (or whose samples can't be converted natively) are handed over to the fallback decoder.
+	 *
+	 */
+	class HEPH_API PcmAudioDecoder final : public IAudioDecoder
+	{
+	private:
+		std::shared_ptr<IAudioDecoder> pFallbackDecoder;
+		bool isFallbackActive;
+		Heph::MemoryMappedFile mappedFile;
+		AudioFormatInfo fileFormatInfo;
+		AudioFormatInfo rawFormatInfo;
+		bool isSigned8Bit;
+		size_t dataOffset;
+		size_t frameCount;
+		size_t currentFrame;
+		std::vector<uint8_t> scratchBuffer;
+
+	public:
+		/**
+		 * @copydoc default_constructor
+		 * Uses an FFmpegAudioDecoder as the fallback decoder.
+		 *
+		 */
+		PcmAudioDecoder();
+
+		/**
+		 * @copydoc constructor
+		 *
+		 * @param pFallbackDecoder decoder used for the files that can't be decoded natively, nullptr to reject them.
+		 */
+		explicit PcmAudioDecoder(std::shared_ptr<IAudioDecoder> pFallbackDecoder);
+
+		/**
+		 * @copydoc constructor
+		 *
+		 * @param filePath path of the file that will be decoded.
+		 */
+		explicit PcmAudioDecoder(const std::filesystem::path& filePath);
+
+		PcmAudioDecoder(const PcmAudioDecoder&) = delete;
+		PcmAudioDecoder& operator=(const PcmAudioDecoder&) = delete;
+
+		/** @copydoc destructor */
+		~PcmAudioDecoder();
+
+		void ChangeFile(const std::filesystem::path& newFilePath) override;
+		void CloseFile() override;
+		bool IsFileOpen() const override;
+		AudioFormatInfo GetOutputFormatInfo() const override;
+		size_t GetFrameCount() const override;
+		bool Seek(size_t frameIndex) override;
+		AudioBuffer Decode() override;
+		AudioBuffer Decode(size_t frameCount) override;
+		AudioBuffer Decode(size_t frameIndex, size_t frameCount) override;
+		AudioBuffer Decode(const EncodedAudioBuffer& encodedBuffer) override;
+		size_t DecodeInto(heph_audio_sample_t* pOutput, size_t frameCount) override;
+		using IAudioDecoder::DecodeInto;
+
+		/**
+		 * gets the decoder used for the files that can't be decoded natively.
+		 *
+		 */
+		std::shared_ptr<IAudioDecoder> GetFallbackDecoder() const;
+
+		/**
+		 * sets the decoder used for the files that can't be decoded natively.
+		 *
+		 * @param pFallbackDecoder fallback decoder, nullptr to reject these files.
+		 */
+		void SetFallbackDecoder(std::shared_ptr<IAudioDecoder> pFallbackDecoder);
+
+		/**
+		 * checks whether the open file is decoded by the fallback decoder.
+		 *
+		 */
+		bool IsFallbackActive() const;
+
+		/**
+		 * gets the format of the samples stored in the open file.
+		 *
+		 */
+		const AudioFormatInfo& GetFileFormatInfo() const;
+
+		/**
+		 * gets the format the files with the <b>.raw</b> or <b>.pcm</b> extension are interpreted in.
+		 *
+		 */
+		const AudioFormatInfo& GetRawFormatInfo() const;
+
+		/**
+		 * sets the format the files with the <b>.raw</b> or <b>.pcm</b> extension are interpreted in.
+		 * Takes effect the next time a file is opened.
+		 *
+		 */
+		void SetRawFormatInfo(const AudioFormatInfo& rawFormatInfo);
+
+		/**
+		 * gets the samples of the open file directly from the mapping, without copying.
+		 *
+		 * @return pointer to the first sample, nullptr if the samples are not stored in the internal format.
+		 * The pointer is valid until the file is closed and there are \link PcmAudioDecoder::GetFrameCount GetFrameCount \endlink frames.
+		 */
+		const heph_audio_sample_t* GetInternalFormatView() const;
+
+	private:
+		void OpenFile(const std::filesystem::path& filePath);
+		bool ParseWav(const uint8_t* pFile, size_t fileSize);
+		bool ParseW64(const uint8_t* pFile, size_t fileSize);
+		bool ParseAiff(const uint8_t* pFile, size_t fileSize);
+		bool ParseRaw(size_t fileSize);
+		bool ParseWavFormat(const uint8_t* pFmt, size_t fmtSize);
+		void ConvertFrames(size_t frameIndex, size_t frameCount, heph_audio_sample_t* pOutput);
+	};
+}
\ No newline at end of file
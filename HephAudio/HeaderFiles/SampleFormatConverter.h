@@ -0,0 +1,201 @@
+#pragma once
+#include "HephAudioShared.h"
+#include "AudioFormatInfo.h"
+#include "AudioBuffer.h"
+#include <cstdint>
+#include <vector>
+
+/** @file */
+
+namespace HephAudio
+{
+	enum DitherMode
+	{
+		/**
+		 * samples are rounded to the nearest integer.
+		 *
+		 */
+		Disabled = 0,
+
+		/**
+		 * triangular probability density function dither with 2 LSB peak to peak amplitude is added before rounding.
+		 * Decorrelates the quantization error from the signal at the cost of a slightly higher noise floor.
+		 *
+		 */
+		Tpdf = 1,
+
+		/**
+		 * TPDF dither with first order error feedback.
+		 * Moves the quantization noise towards the high frequencies where the ear is less sensitive.
+		 *
+		 */
+		TpdfNoiseShaped = 2
+	};
+
+	/**
+	 * @brief state of the dither that's carried between consecutive conversions of the same stream.
+	 *
+	 */
+	struct HEPH_API DitherState
+	{
+		/**
+		 * dither that's applied when converting to integer formats.
+		 *
+		 */
+		DitherMode mode;
+
+		/**
+		 * state of the random number generator.
+		 *
+		 */
+		uint32_t randomState;
+
+		/**
+		 * quantization error of the previous sample of each channel, used for noise shaping.
+		 *
+		 */
+		std::vector<double> error;
+
+		/** @copydoc default_constructor */
+		DitherState();
+
+		/**
+		 * @copydoc constructor
+		 *
+		 * @param mode @copydetails mode
+		 * @param channelCount number of channels of the stream.
+		 */
+		DitherState(DitherMode mode, uint16_t channelCount);
+
+		/**
+		 * clears the error history.
+		 *
+		 */
+		void Reset();
+	};
+
+	/**
+	 * @brief converts between the internal sample format and the plain PCM formats without FFmpeg and without allocating.
+	 * Supports unsigned 8 bit, signed 16, 24 (packed) and 32 bit integer, 32 and 64 bit IEEE float, A-law and mu-law.
+	 * The common float <-> 16/32 bit integer and float <-> double conversions use SSE2 on x86_64 and NEON on arm64.
+	 * @note this class cannot be instantiated.
+	 *
+	 */
+	class HEPH_API SampleFormatConverter final
+	{
+	public:
+		SampleFormatConverter() = delete;
+		SampleFormatConverter(const SampleFormatConverter&) = delete;
+		SampleFormatConverter& operator=(const SampleFormatConverter&) = delete;
+
+	public:
+		/**
+		 * checks whether the format can be converted.
+		 * Multi-byte formats must be in the system endianness.
+		 *
+		 */
+		static bool IsSupported(const AudioFormatInfo& format);
+
+		/**
+		 * converts interleaved samples in internal format to the provided format.
+		 * Integer results are rounded to the nearest value and clamped.
+		 *
+		 * @param pInput interleaved samples in internal format.
+		 * @param pOutput memory that will receive the converted samples, must be at least <b>frameCount * outputFormat.FrameSize()</b> bytes.
+		 * @param frameCount number of frames to convert.
+		 * @param outputFormat format of the output, must be supported.
+		 * @param pDitherState dither applied to the integer formats, nullptr to disable. A-law and mu-law are not dithered.
+		 */
+		static void FromInternal(const heph_audio_sample_t* pInput, void* pOutput, size_t frameCount, const AudioFormatInfo& outputFormat, DitherState* pDitherState = nullptr);
+
+		/**
+		 * converts the audio buffer to the provided format.
+		 *
+		 * @param inputBuffer audio data, must have the same channel count as the output format.
+		 * @param pOutput memory that will receive the converted samples, must be at least <b>inputBuffer.FrameCount() * outputFormat.FrameSize()</b> bytes.
+		 * @param outputFormat format of the output, must be supported.
+		 * @param pDitherState dither applied to the integer formats, nullptr to disable.
+		 */
+		static void FromInternal(const AudioBuffer& inputBuffer, void* pOutput, const AudioFormatInfo& outputFormat, DitherState* pDitherState = nullptr);
+
+		/**
+		 * converts interleaved samples in the provided format to the internal format.
+		 *
+		 * @param pInput interleaved samples.
+		 * @param pOutput memory that will receive the samples in internal format.
+		 * @param frameCount number of frames to convert.
+		 * @param inputFormat format of the input, must be supported.
+		 */
+		static void ToInternal(const void* pInput, heph_audio_sample_t* pOutput, size_t frameCount, const AudioFormatInfo& inputFormat);
+
+		/**
+		 * converts interleaved samples in the provided format to the internal format.
+		 *
+		 * @param pInput interleaved samples.
+		 * @param inputFormat format of the input, must be supported and have the same channel count as the output buffer.
+		 * @param frameCount number of frames to convert.
+		 * @param outputBuffer buffer that will receive the samples, must have at least \a frameCount frames.
+		 */
+		static void ToInternal(const void* pInput, const AudioFormatInfo& inputFormat, size_t frameCount, AudioBuffer& outputBuffer);
+
+		/**
+		 * converts interleaved samples between two formats without allocating.
+		 * When neither format is the internal format, the samples are converted through double precision floats a block at a time.
+		 *
+		 * @param pInput interleaved samples.
+		 * @param inputFormat format of the input, must be supported or the internal format.
+		 * @param pOutput memory that will receive the converted samples, must be at least <b>frameCount * outputFormat.FrameSize()</b> bytes.
+		 * @param outputFormat format of the output, must be supported or the internal format, and have the same channel count as the input format.
+		 * @param frameCount number of frames to convert.
+		 * @param pDitherState dither applied to the integer formats, nullptr to disable.
+		 */
+		static void Convert(const void* pInput, const AudioFormatInfo& inputFormat, void* pOutput, const AudioFormatInfo& outputFormat, size_t frameCount, DitherState* pDitherState = nullptr);
+
+		/**
+		 * converts the samples of an audio buffer to another sample type.
+		 *
+		 * @tparam Tout type of the output samples.
+		 * @tparam Tin type of the input samples.
+		 * @param inputBuffer audio data.
+		 * @param pDitherState dither applied if \a Tout is an integer type, nullptr to disable.
+		 * @return the converted audio data with the same channel layout and sample rate.
+		 */
+		template<typename Tout, typename Tin>
+		static BasicAudioBuffer<Tout> Convert(const BasicAudioBuffer<Tin>& inputBuffer, DitherState* pDitherState = nullptr)
+		{
+			if (inputBuffer.IsEmpty())
+			{
+				return BasicAudioBuffer<Tout>();
+			}
+
+			const AudioFormatInfo& inputFormat = inputBuffer.FormatInfo();
+			BasicAudioBuffer<Tout> outputBuffer(inputBuffer.FrameCount(), inputFormat.channelLayout, inputFormat.sampleRate, Heph::BufferFlags::AllocUninitialized);
+			SampleFormatConverter::Convert(inputBuffer.begin(), inputFormat, outputBuffer.begin(), outputBuffer.FormatInfo(), inputBuffer.FrameCount(), pDitherState);
+			return outputBuffer;
+		}
+
+		/**
+		 * encodes a 16 bit linear sample with the ITU-T G.711 A-law.
+		 *
+		 */
+		static uint8_t LinearToALaw(int16_t sample);
+
+		/**
+		 * decodes an ITU-T G.711 A-law sample to 16 bit linear.
+		 *
+		 */
+		static int16_t ALawToLinear(uint8_t sample);
+
+		/**
+		 * encodes a 16 bit linear sample with the ITU-T G.711 mu-law.
+		 *
+		 */
+		static uint8_t LinearToMuLaw(int16_t sample);
+
+		/**
+		 * decodes an ITU-T G.711 mu-law sample to 16 bit linear.
+		 *
+		 */
+		static int16_t MuLawToLinear(uint8_t sample);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,106 @@
+#pragma once
+#include "HephAudioShared.h"
+#include <vector>
+
+/** @file */
+
+namespace HephAudio
+{
+	/**
+	 * @brief perceptual frequency scales the filters of a \link HephAudio::SpectralFilterbank SpectralFilterbank \endlink are spaced on.
+	 *
+	 */
+	enum class FrequencyScale
+	{
+		/** mel scale, <b>2595 * log10(1 + f / 700)</b>. */
+		Mel,
+		/** Bark scale, <b>26.81 * f / (1960 + f) - 0.53</b>. */
+		Bark
+	};
+
+	/**
+	 * @brief triangular filters that are evenly spaced on a perceptual frequency scale, applied to the bins of a spectrum.
+	 * Each filter only stores the weights of the bins it covers, the weights of all filters are stored in a single array.
+	 *
+	 */
+	class HEPH_API SpectralFilterbank final
+	{
+	private:
+		/**
+		 * number of bins of the spectra the filters are applied to.
+		 *
+		 */
+		size_t binCount;
+
+		/** index of the first bin each filter covers. */
+		std::vector<size_t> startBins;
+		/** index of the first weight of each filter, followed by the total number of weights. */
+		std::vector<size_t> weightOffsets;
+		std::vector<double> weights;
+
+	public:
+		/** @copydoc default_constructor */
+		SpectralFilterbank();
+
+		/**
+		 * @copydoc constructor
+		 *
+		 * @param scale scale the filters are evenly spaced on.
+		 * @param filterCount number of filters.
+		 * @param fftSize size of the FFT the spectra are calculated with, the spectra must have <b>fftSize / 2 + 1</b> bins.
+		 * @param sampleRate sample rate of the analyzed audio.
+		 * @param minFrequency lower edge of the first filter in Hz.
+		 * @param maxFrequency upper edge of the last filter in Hz, must not be greater than the Nyquist frequency.
+		 */
+		SpectralFilterbank(FrequencyScale scale, size_t filterCount, size_t fftSize, uint32_t sampleRate, double minFrequency, double maxFrequency);
+
+		/**
+		 * gets the number of filters.
+		 *
+		 */
+		size_t GetFilterCount() const;
+
+		/**
+		 * gets the number of bins of the spectra the filters are applied to.
+		 *
+		 */
+		size_t GetBinCount() const;
+
+		/**
+		 * gets the weight of a bin for a filter.
+		 *
+		 * @param filterIndex index of the filter.
+		 * @param binIndex index of the bin.
+		 */
+		double GetWeight(size_t filterIndex, size_t binIndex) const;
+
+		/**
+		 * applies the filters to a spectrum.
+		 *
+		 * @param pSpectrum the spectrum, usually the power or the magnitude of each bin.
+		 * @param pOutput memory that will receive the output of each filter, must have space for at least \link HephAudio::SpectralFilterbank::GetFilterCount GetFilterCount \endlink elements.
+		 */
+		void Apply(const double* pSpectrum, double* pOutput) const;
+
+		/**
+		 * applies the filters to consecutive spectra, i.e. the output of \link HephAudio::StftAnalyzer StftAnalyzer \endlink.
+		 *
+		 * @param pSpectra the spectra, each has \link HephAudio::SpectralFilterbank::GetBinCount GetBinCount \endlink bins.
+		 * @param frameCount number of spectra.
+		 * @param pOutput memory that will receive the outputs of the filters, must have space for at least <b>frameCount * GetFilterCount()</b> elements.
+		 */
+		void Apply(const double* pSpectra, size_t frameCount, double* pOutput) const;
+
+		/**
+		 * converts frequency in Hz to the provided scale.
+		 *
+		 */
+		static double ToScale(FrequencyScale scale, double frequency);
+
+		/**
+		 * converts a value in the provided scale to frequency in Hz.
+		 *
+		 */
+		static double FromScale(FrequencyScale scale, double value);
+	};
+}
\ No newline at end of file
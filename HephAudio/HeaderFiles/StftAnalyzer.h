@@ -0,0 +1,205 @@
+#pragma once
+#include "HephAudioShared.h"
+#include "AudioBuffer.h"
+#include "Windows/Window.h"
+#include "Buffers/DoubleBuffer.h"
+#include "Buffers/SplitComplexBuffer.h"
+#include <vector>
+
+/** @file */
+
+namespace HephAudio
+{
+	/**
+	 * @brief value calculated for each bin by \link HephAudio::StftAnalyzer StftAnalyzer \endlink.
+	 *
+	 */
+	enum class StftOutputType
+	{
+		/** magnitude of the bin. */
+		Magnitude,
+		/** squared magnitude of the bin. */
+		Power,
+		/** magnitude of the bin in decibels, see \link HephAudio::GainToDecibel GainToDecibel \endlink. */
+		Decibel
+	};
+
+	/**
+	 * @brief calculates the short-time Fourier transform (STFT) of a single channel, and the inverse STFT.
+	 * Frames start every \link HephAudio::StftAnalyzer::hopSize hopSize \endlink samples,
+	 * each frame is multiplied with the window, zero padded to \link HephAudio::StftAnalyzer::fftSize fftSize \endlink and transformed.
+	 * Only the bins in the range [0, fftSize / 2] are stored since the input is real, hence each frame has \link HephAudio::StftAnalyzer::GetBinCount GetBinCount \endlink bins.
+	 * Results are stored frame by frame, the bin k of the frame f is at the index <b>f * GetBinCount() + k</b>.
+	 *
+	 * The whole buffer methods are const and can be called from multiple threads at once, the streaming methods are not thread safe.
+	 *
+	 */
+	class HEPH_API StftAnalyzer final
+	{
+	private:
+		/**
+		 * window that's applied to each frame.
+		 *
+		 */
+		Heph::DoubleBuffer wnd;
+
+		/**
+		 * number of samples between the starts of the consecutive frames.
+		 *
+		 */
+		size_t hopSize;
+
+		/**
+		 * size of the FFT, a power of 2 that's not less than the window size.
+		 *
+		 */
+		size_t fftSize;
+
+		/**
+		 * number of threads used by the whole buffer methods.
+		 *
+		 */
+		size_t threadCount;
+
+		/** samples pushed but not consumed by a frame yet. */
+		std::vector<double> pendingSamples;
+		/** samples that will be discarded when pushed since no frame contains them, only when the hop size is greater than the window size. */
+		size_t skipCount;
+
+	public:
+		/**
+		 * @copydoc constructor
+		 *
+		 * @param wnd @copydetails wnd
+		 * @param hopSize @copydetails hopSize
+		 */
+		StftAnalyzer(const Window& wnd, size_t hopSize);
+
+		/**
+		 * @copydoc constructor
+		 *
+		 * @param wnd @copydetails wnd
+		 * @param hopSize @copydetails hopSize
+		 * @param fftSize @copydetails fftSize If not a power of 2, the closest power of 2 will be used.
+		 */
+		StftAnalyzer(const Window& wnd, size_t hopSize, size_t fftSize);
+
+		/**
+		 * gets the size of the window.
+		 *
+		 */
+		size_t GetWindowSize() const;
+
+		/**
+		 * gets the hop size.
+		 *
+		 */
+		size_t GetHopSize() const;
+
+		/**
+		 * gets the size of the FFT.
+		 *
+		 */
+		size_t GetFFTSize() const;
+
+		/**
+		 * gets the number of bins each frame has.
+		 *
+		 */
+		size_t GetBinCount() const;
+
+		/**
+		 * gets the number of threads used by the whole buffer methods.
+		 *
+		 */
+		size_t GetThreadCount() const;
+
+		/**
+		 * sets the number of threads used by the whole buffer methods.
+		 *
+		 * @param threadCount @copydetails threadCount 0 to use the number of hardware threads.
+		 */
+		void SetThreadCount(size_t threadCount);
+
+		/**
+		 * calculates the number of frames the whole buffer methods produce for the provided number of samples.
+		 * The last frame is zero padded if the samples do not fill it.
+		 *
+		 */
+		size_t CalculateFrameCount(size_t sampleCount) const;
+
+		/**
+		 * calculates the number of samples the provided number of frames cover.
+		 *
+		 */
+		size_t CalculateSampleCount(size_t frameCount) const;
+
+		/**
+		 * calculates the STFT of a channel of the whole buffer.
+		 *
+		 * @param buffer the audio data.
+		 * @param channelIndex index of the channel that will be analyzed.
+		 * @param outputType value calculated for each bin.
+		 * @param pOutput memory that will receive the results,
+		 * must have space for at least <b>CalculateFrameCount(buffer.FrameCount()) * GetBinCount()</b> elements.
+		 */
+		void Analyze(const AudioBuffer& buffer, size_t channelIndex, StftOutputType outputType, double* pOutput) const;
+
+		/**
+		 * calculates the complex STFT of a channel of the whole buffer.
+		 *
+		 * @param buffer the audio data.
+		 * @param channelIndex index of the channel that will be analyzed.
+		 * @param output buffer that will receive the results, resized if it has less than <b>CalculateFrameCount(buffer.FrameCount()) * GetBinCount()</b> elements.
+		 */
+		void Analyze(const AudioBuffer& buffer, size_t channelIndex, Heph::SplitComplexBuffer& output) const;
+
+		/**
+		 * calculates the inverse STFT via weighted overlap-add.
+		 * The samples that are not covered by the window (i.e. the first sample of a Hann window) are set to zero.
+		 *
+		 * @param frames complex frames, i.e. the output of \link HephAudio::StftAnalyzer::Analyze(const AudioBuffer&, size_t, Heph::SplitComplexBuffer&) const Analyze \endlink.
+		 * @param frameCount number of frames.
+		 * @param buffer buffer that will receive the samples, samples past the end are discarded.
+		 * @param channelIndex index of the channel that will be overwritten.
+		 */
+		void Synthesize(const Heph::SplitComplexBuffer& frames, size_t frameCount, AudioBuffer& buffer, size_t channelIndex) const;
+
+		/**
+		 * appends a channel of the buffer to the stream.
+		 *
+		 * @param buffer the audio data.
+		 * @param channelIndex index of the channel that will be analyzed.
+		 */
+		void Push(const AudioBuffer& buffer, size_t channelIndex);
+
+		/**
+		 * gets the number of frames that can be read from the stream.
+		 *
+		 */
+		size_t GetAvailableFrameCount() const;
+
+		/**
+		 * calculates the STFT of the available frames of the stream and removes them.
+		 * Unlike the whole buffer methods, a frame is produced only after all of its samples are pushed.
+		 *
+		 * @param outputType value calculated for each bin.
+		 * @param pOutput memory that will receive the results, must have space for at least <b>maxFrameCount * GetBinCount()</b> elements.
+		 * @param maxFrameCount maximum number of frames to read.
+		 * @return number of frames read.
+		 */
+		size_t Pop(StftOutputType outputType, double* pOutput, size_t maxFrameCount);
+
+		/**
+		 * removes the pushed samples.
+		 *
+		 */
+		void Reset();
+
+	private:
+		template<typename Tsample>
+		void AnalyzeST(const Tsample* pSamples, size_t stride, size_t sampleCount, size_t firstFrameIndex, size_t frameCount, StftOutputType outputType, double* pOutput, double* pImag) const;
+		void AnalyzeMT(const AudioBuffer& buffer, size_t channelIndex, StftOutputType outputType, double* pOutput, double* pImag) const;
+		static void StoreBin(double re, double im, StftOutputType outputType, double* pOutput, double* pImag);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+#pragma once
+#include "HephAudioShared.h"
+#include "IAudioEncoder.h"
+#include "SampleFormatConverter.h"
+#include <cstdio>
+#include <vector>
+
+/** @file */
+
+namespace HephAudio
+{
+	/**
+	 * @brief writes PCM, IEEE float, A-law and mu-law WAV files without FFmpeg.
+	 * The samples are converted and appended to the file as they are encoded, the header is completed when the file is closed.
+	 * Files that exceed 4GB are written as RF64.
+	 *
+	 */
+	class HEPH_API WavAudioEncoder final : public IAudioEncoder
+	{
+	private:
+		AudioFormatInfo outputFormatInfo;
+		FILE* pFile;
+		uint64_t dataSize;
+		DitherState ditherState;
+		std::vector<uint8_t> scratchBuffer;
+
+	public:
+		/** @copydoc default_constructor */
+		WavAudioEncoder();
+
+		/**
+		 * @copydoc constructor
+		 *
+		 * @param filePath path of the file that will be written.
+		 * @param outputFormatInfo describes the output format, the samples are always written in little endian.
+		 * @param overwrite indicates whether to write over the file if already exists.
+		 */
+		WavAudioEncoder(const std::filesystem::path& filePath, const AudioFormatInfo& outputFormatInfo, bool overwrite);
+
+		WavAudioEncoder(const WavAudioEncoder&) = delete;
+		WavAudioEncoder& operator=(const WavAudioEncoder&) = delete;
+
+		/** @copydoc destructor */
+		~WavAudioEncoder();
+
+		void ChangeFile(const std::filesystem::path& newAudioFilePath, const AudioFormatInfo& outputFormatInfo, bool overwrite) override;
+		void CloseFile() override;
+		bool IsFileOpen() const override;
+		void Encode(const AudioBuffer& bufferToEncode) override;
+		void Encode(const AudioBuffer& inputBuffer, EncodedAudioBuffer& outputBuffer) override;
+		void Transcode(const EncodedAudioBuffer& inputBuffer, EncodedAudioBuffer& outputBuffer) override;
+
+		/**
+		 * gets the dither applied when the samples are written as integers.
+		 *
+		 */
+		DitherMode GetDitherMode() const;
+
+		/**
+		 * sets the dither applied when the samples are written as integers.
+		 *
+		 */
+		void SetDitherMode(DitherMode ditherMode);
+
+		/**
+		 * gets the number of sample bytes written to the open file.
+		 *
+		 */
+		uint64_t GetDataSize() const;
+
+		/**
+		 * creates the header of a WAV file, the samples follow it.
+		 * Formats with more than 2 channels or integer samples of more than 16 bits use WAVE_FORMAT_EXTENSIBLE with the channel mask of the layout.
+		 * The size of the header only depends on the format, so a placeholder can be written first and overwritten once the data size is known.
+		 *
+		 * @param formatInfo format of the samples.
+		 * @param dataSize number of sample bytes, excluding the padding byte of the data chunk.
+		 * @param isFinal indicates whether the data size is final, files that exceed 4GB are promoted to RF64 only then.
+		 */
+		static std::vector<uint8_t> CreateHeader(const AudioFormatInfo& formatInfo, uint64_t dataSize, bool isFinal);
+
+	private:
+		void OpenFile(const std::filesystem::path& filePath, const AudioFormatInfo& outputFormatInfo, bool overwrite);
+		bool WriteHeader(bool isFinal);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,262 @@
+#include "AsyncAudioEncoder.h"
+#include "HephMath.h"
+#include "Exceptions/InvalidArgumentException.h"
+#include "Exceptions/InvalidOperationException.h"
+#include <chrono>
+
+using namespace Heph;
+
+namespace HephAudio
+{
+	// upper bound of a wait, so a notification that's sent without holding the signal mutex is never lost for long.
+	static constexpr std::chrono::milliseconds ASYNC_ENCODER_WAIT_TIMEOUT(5);
+
+	AsyncAudioEncoder::AsyncAudioEncoder(std::shared_ptr<IAudioEncoder> pEncoder, size_t blockFrameCount, size_t blockCount, EncoderOverrunPolicy overrunPolicy)
+		: pEncoder(pEncoder), blockFrameCount(blockFrameCount), blockCount(blockCount), overrunPolicy(overrunPolicy)
+		, isClosing(false), isFailed(false), pException(nullptr)
+	{
+		if (this->pEncoder == nullptr)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "Encoder cannot be null."));
+		}
+
+		if (blockFrameCount == 0 || blockCount == 0)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "Block frame count and block count must be greater than 0."));
+		}
+	}
+
+	AsyncAudioEncoder::~AsyncAudioEncoder()
+	{
+		this->StopEncodeThread();
+
+		std::lock_guard<std::mutex> lockGuard(this->encoderMutex);
+		this->pEncoder->CloseFile();
+	}
+
+	void AsyncAudioEncoder::ChangeFile(const std::filesystem::path& newAudioFilePath, const AudioFormatInfo& outputFormatInfo, bool overwrite)
+	{
+		if (this->filePath != newAudioFilePath)
+		{
+			this->CloseFile();
+			{
+				std::lock_guard<std::mutex> lockGuard(this->encoderMutex);
+				this->pEncoder->ChangeFile(newAudioFilePath, outputFormatInfo, overwrite);
+			}
+			this->filePath = newAudioFilePath;
+		}
+	}
+
+	void AsyncAudioEncoder::CloseFile()
+	{
+		this->StopEncodeThread();
+		{
+			std::lock_guard<std::mutex> lockGuard(this->encoderMutex);
+			this->pEncoder->CloseFile();
+		}
+		this->filePath = "";
+
+		// the encode thread is stopped, report its failure once and start the next file clean.
+		std::exception_ptr pException = this->pException;
+		this->pException = nullptr;
+		this->isFailed.store(false, std::memory_order_relaxed);
+		if (pException != nullptr)
+		{
+			std::rethrow_exception(pException);
+		}
+	}
+
+	bool AsyncAudioEncoder::IsFileOpen() const
+	{
+		std::lock_guard<std::mutex> lockGuard(this->encoderMutex);
+		return this->pEncoder->IsFileOpen();
+	}
+
+	void AsyncAudioEncoder::Encode(const AudioBuffer& bufferToEncode)
+	{
+		this->ThrowIfFailed();
+
+		if (bufferToEncode.IsEmpty())
+		{
+			HEPH_RAISE_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "Trying to encode empty buffer."));
+			return;
+		}
+
+		const AudioFormatInfo& inputFormatInfo = bufferToEncode.FormatInfo();
+		if (!this->encodeThread.joinable())
+		{
+			// checked only before the thread starts, the wrapped encoder is locked while encoding.
+			if (!this->IsFileOpen())
+			{
+				HEPH_RAISE_EXCEPTION(this, InvalidOperationException(HEPH_FUNC, "No open file to encode."));
+				return;
+			}
+
+			this->queue.Reset(this->blockFrameCount * this->blockCount, inputFormatInfo.channelLayout, inputFormatInfo.sampleRate);
+			this->isClosing.store(false, std::memory_order_relaxed);
+			this->encodeThread = std::thread(&AsyncAudioEncoder::EncodeThread, this);
+		}
+		else if (inputFormatInfo.channelLayout != this->queue.FormatInfo().channelLayout || inputFormatInfo.sampleRate != this->queue.FormatInfo().sampleRate)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "Channel layout and sample rate must match the previously encoded buffers."));
+		}
+
+		const size_t channelCount = inputFormatInfo.channelLayout.count;
+		const heph_audio_sample_t* pFrames = bufferToEncode.begin();
+		size_t frameCount = bufferToEncode.FrameCount();
+
+		if (this->overrunPolicy.load(std::memory_order_relaxed) == DropNewest)
+		{
+			(void)this->queue.Write(pFrames, frameCount);
+			this->dataCondition.notify_one();
+			return;
+		}
+
+		while (true)
+		{
+			// only the encode thread frees space, so the frames always fit and are never counted as an overrun.
+			const size_t writableFrameCount = this->queue.GetWritableFrameCount();
+			const size_t framesToWrite = HEPH_MATH_MIN(frameCount, writableFrameCount);
+			if (framesToWrite > 0)
+			{
+				(void)this->queue.Write(pFrames, framesToWrite);
+				pFrames += framesToWrite * channelCount;
+				frameCount -= framesToWrite;
+				this->dataCondition.notify_one();
+			}
+
+			if (frameCount == 0)
+			{
+				break;
+			}
+
+			// nothing frees space after the encode thread fails.
+			this->ThrowIfFailed();
+
+			std::unique_lock<std::mutex> lock(this->signalMutex);
+			this->spaceCondition.wait_for(lock, ASYNC_ENCODER_WAIT_TIMEOUT, [this]()
+				{
+					return this->queue.GetWritableFrameCount() > 0 || this->isFailed.load(std::memory_order_acquire);
+				});
+		}
+	}
+
+	void AsyncAudioEncoder::Encode(const AudioBuffer& inputBuffer, EncodedAudioBuffer& outputBuffer)
+	{
+		std::lock_guard<std::mutex> lockGuard(this->encoderMutex);
+		this->pEncoder->Encode(inputBuffer, outputBuffer);
+	}
+
+	void AsyncAudioEncoder::Transcode(const EncodedAudioBuffer& inputBuffer, EncodedAudioBuffer& outputBuffer)
+	{
+		std::lock_guard<std::mutex> lockGuard(this->encoderMutex);
+		this->pEncoder->Transcode(inputBuffer, outputBuffer);
+	}
+
+	std::shared_ptr<IAudioEncoder> AsyncAudioEncoder::GetEncoder() const
+	{
+		return this->pEncoder;
+	}
+
+	EncoderOverrunPolicy AsyncAudioEncoder::GetOverrunPolicy() const
+	{
+		return this->overrunPolicy.load(std::memory_order_relaxed);
+	}
+
+	void AsyncAudioEncoder::SetOverrunPolicy(EncoderOverrunPolicy overrunPolicy)
+	{
+		this->overrunPolicy.store(overrunPolicy, std::memory_order_relaxed);
+	}
+
+	size_t AsyncAudioEncoder::GetQueueCapacity() const
+	{
+		return this->blockFrameCount * this->blockCount;
+	}
+
+	size_t AsyncAudioEncoder::GetQueuedFrameCount() const
+	{
+		return this->queue.GetReadableFrameCount();
+	}
+
+	uint64_t AsyncAudioEncoder::GetOverrunCount() const
+	{
+		return this->queue.GetOverrunCount();
+	}
+
+	uint64_t AsyncAudioEncoder::GetDroppedFrameCount() const
+	{
+		return this->queue.GetDroppedFrameCount();
+	}
+
+	void AsyncAudioEncoder::StopEncodeThread()
+	{
+		if (this->encodeThread.joinable())
+		{
+			{
+				std::lock_guard<std::mutex> lockGuard(this->signalMutex);
+				this->isClosing.store(true, std::memory_order_release);
+			}
+			this->dataCondition.notify_one();
+			this->encodeThread.join();
+		}
+	}
+
+	void AsyncAudioEncoder::EncodeThread()
+	{
+		const AudioFormatInfo& formatInfo = this->queue.FormatInfo();
+		AudioBuffer block(this->blockFrameCount, formatInfo.channelLayout, formatInfo.sampleRate, BufferFlags::AllocUninitialized);
+
+		try
+		{
+			while (true)
+			{
+				// read the flag first, the frames written before the file is closed are then guaranteed to be visible.
+				const bool isClosing = this->isClosing.load(std::memory_order_acquire);
+				const size_t readableFrameCount = this->queue.GetReadableFrameCount();
+
+				if (readableFrameCount >= this->blockFrameCount)
+				{
+					(void)this->queue.Read(block);
+					this->spaceCondition.notify_one();
+
+					std::lock_guard<std::mutex> lockGuard(this->encoderMutex);
+					this->pEncoder->Encode(block);
+					continue;
+				}
+
+				if (isClosing)
+				{
+					if (readableFrameCount > 0)
+					{
+						AudioBuffer lastBlock(readableFrameCount, formatInfo.channelLayout, formatInfo.sampleRate, BufferFlags::AllocUninitialized);
+						(void)this->queue.Read(lastBlock);
+
+						std::lock_guard<std::mutex> lockGuard(this->encoderMutex);
+						this->pEncoder->Encode(lastBlock);
+					}
+					break;
+				}
+
+				std::unique_lock<std::mutex> lock(this->signalMutex);
+				this->dataCondition.wait_for(lock, ASYNC_ENCODER_WAIT_TIMEOUT, [this]()
+					{
+						return this->queue.GetReadableFrameCount() >= this->blockFrameCount || this->isClosing.load(std::memory_order_acquire);
+					});
+			}
+		}
+		catch (...)
+		{
+			this->pException = std::current_exception();
+			this->isFailed.store(true, std::memory_order_release);
+			this->spaceCondition.notify_all();
+		}
+	}
+
+	void AsyncAudioEncoder::ThrowIfFailed()
+	{
+		if (this->isFailed.load(std::memory_order_acquire))
+		{
+			std::rethrow_exception(this->pException);
+		}
+	}
+}
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "NativeAudio/AndroidAudioSLES.h"
 #include "NativeAudio/LinuxAudio.h"
 #include "NativeAudio/AppleAudio.h"
+#include "NativeAudio/NullAudio.h"
 #include "StringHelpers.h"
 #if defined(_WIN32)
 #include <VersionHelpers.h>
@@ -41,6 +42,16 @@ namespace HephAudio
 		this->pNativeAudio->SetAudioDecoder(pNewDecoder);
 	}
 
+	AudioDecoderFactory Audio::GetAudioDecoderFactory() const
+	{
+		return this->pNativeAudio->GetAudioDecoderFactory();
+	}
+
+	void Audio::SetAudioDecoderFactory(AudioDecoderFactory newDecoderFactory)
+	{
+		this->pNativeAudio->SetAudioDecoderFactory(newDecoderFactory);
+	}
+
 	std::shared_ptr<IAudioEncoder> Audio::GetAudioEncoder() const
 	{
 		return this->pNativeAudio->GetAudioEncoder();
@@ -51,6 +62,91 @@ namespace HephAudio
 		this->pNativeAudio->SetAudioEncoder(pNewEncoder);
 	}
 
+	std::shared_ptr<AudioAssetCache> Audio::GetAssetCache() const
+	{
+		return this->pNativeAudio->GetAssetCache();
+	}
+
+	void Audio::SetAssetCache(std::shared_ptr<AudioAssetCache> pNewAssetCache)
+	{
+		this->pNativeAudio->SetAssetCache(pNewAssetCache);
+	}
+
+	size_t Audio::GetCompressedResidencyThreshold() const
+	{
+		return this->pNativeAudio->GetCompressedResidencyThreshold();
+	}
+
+	void Audio::SetCompressedResidencyThreshold(size_t threshold_frame)
+	{
+		this->pNativeAudio->SetCompressedResidencyThreshold(threshold_frame);
+	}
+
+	size_t Audio::GetMaxRealVoiceCount() const
+	{
+		return this->pNativeAudio->GetMaxRealVoiceCount();
+	}
+
+	void Audio::SetMaxRealVoiceCount(size_t maxRealVoiceCount)
+	{
+		this->pNativeAudio->SetMaxRealVoiceCount(maxRealVoiceCount);
+	}
+
+	VoiceStealingPolicy Audio::GetVoiceStealingPolicy() const
+	{
+		return this->pNativeAudio->GetVoiceStealingPolicy();
+	}
+
+	void Audio::SetVoiceStealingPolicy(VoiceStealingPolicy voiceStealingPolicy)
+	{
+		this->pNativeAudio->SetVoiceStealingPolicy(voiceStealingPolicy);
+	}
+
+	double Audio::GetVirtualVolumeThreshold() const
+	{
+		return this->pNativeAudio->GetVirtualVolumeThreshold();
+	}
+
+	void Audio::SetVirtualVolumeThreshold(double virtualVolumeThreshold)
+	{
+		this->pNativeAudio->SetVirtualVolumeThreshold(virtualVolumeThreshold);
+	}
+
+	AudioBus* Audio::CreateBus(const std::string& name, const std::string& outputBusName)
+	{
+		return this->pNativeAudio->CreateBus(name, outputBusName);
+	}
+
+	bool Audio::DestroyBus(const std::string& name)
+	{
+		return this->pNativeAudio->DestroyBus(name);
+	}
+
+	AudioBus* Audio::GetBus(const std::string& name)
+	{
+		return this->pNativeAudio->GetBus(name);
+	}
+
+	AudioBus* Audio::GetMasterBus()
+	{
+		return this->pNativeAudio->GetMasterBus();
+	}
+
+	size_t Audio::GetBusCount() const
+	{
+		return this->pNativeAudio->GetBusCount();
+	}
+
+	size_t Audio::GetBusThreadCount() const
+	{
+		return this->pNativeAudio->GetBusThreadCount();
+	}
+
+	void Audio::SetBusThreadCount(size_t threadCount)
+	{
+		this->pNativeAudio->SetBusThreadCount(threadCount);
+	}
+
 	AudioObject* Audio::Play(const std::filesystem::path& filePath)
 	{
 		return this->pNativeAudio->Play(filePath);
@@ -71,6 +167,38 @@ namespace HephAudio
 		return this->pNativeAudio->Load(filePath, playCount);
 	}
 
+	std::future<AudioObject*> Audio::PlayAsync(const std::filesystem::path& filePath)
+	{
+		return this->pNativeAudio->PlayAsync(filePath);
+	}
+
+	std::future<AudioObject*> Audio::PlayAsync(const std::filesystem::path& filePath, uint32_t playCount)
+	{
+		return this->pNativeAudio->PlayAsync(filePath, playCount);
+	}
+
+	std::future<AudioObject*> Audio::LoadAsync(const std::filesystem::path& filePath)
+	{
+		return this->pNativeAudio->LoadAsync(filePath);
+	}
+
+	std::future<AudioObject*> Audio::LoadAsync(const std::filesystem::path& filePath, uint32_t playCount)
+	{
+		return this->pNativeAudio->LoadAsync(filePath, playCount);
+	}
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+	AudioObjectAwaitable Audio::AwaitPlay(const std::filesystem::path& filePath, uint32_t playCount)
+	{
+		return this->pNativeAudio->AwaitPlay(filePath, playCount);
+	}
+
+	AudioObjectAwaitable Audio::AwaitLoad(const std::filesystem::path& filePath, uint32_t playCount)
+	{
+		return this->pNativeAudio->AwaitLoad(filePath, playCount);
+	}
+#endif
+
 	AudioObject* Audio::CreateAudioObject(const std::string& name, size_t bufferFrameCount, AudioChannelLayout channelLayout, uint32_t sampleRate)
 	{
 		return this->pNativeAudio->CreateAudioObject(name, bufferFrameCount, channelLayout, sampleRate);
@@ -141,6 +269,41 @@ namespace HephAudio
 		this->pNativeAudio->SetDeviceEnumerationPeriod(deviceEnumerationPeriod_ms);
 	}
 
+	RenderMetrics& Audio::GetRenderMetrics()
+	{
+		return this->pNativeAudio->GetRenderMetrics();
+	}
+
+	const RenderMetrics& Audio::GetRenderMetrics() const
+	{
+		return this->pNativeAudio->GetRenderMetrics();
+	}
+
+	AudioRingBuffer& Audio::GetCaptureRingBuffer()
+	{
+		return this->pNativeAudio->GetCaptureRingBuffer();
+	}
+
+	uint32_t Audio::GetCaptureRingBufferDuration() const
+	{
+		return this->pNativeAudio->GetCaptureRingBufferDuration();
+	}
+
+	void Audio::SetCaptureRingBufferDuration(uint32_t captureRingBufferDuration_ms)
+	{
+		this->pNativeAudio->SetCaptureRingBufferDuration(captureRingBufferDuration_ms);
+	}
+
+	DitherMode Audio::GetRenderDitherMode() const
+	{
+		return this->pNativeAudio->GetRenderDitherMode();
+	}
+
+	void Audio::SetRenderDitherMode(DitherMode ditherMode)
+	{
+		this->pNativeAudio->SetRenderDitherMode(ditherMode);
+	}
+
 	void Audio::SetMasterVolume(double volume)
 	{
 		this->pNativeAudio->SetMasterVolume(volume);
@@ -248,6 +411,11 @@ namespace HephAudio
 
 	std::shared_ptr<Native::NativeAudio> Audio::CreateNativeAudio(AudioAPI api)
 	{
+		if (api == AudioAPI::Headless)
+		{
+			return std::shared_ptr<NativeAudio>(new NullAudio());
+		}
+
 #if defined(_WIN32)
 
 		switch (api)
@@ -0,0 +1,241 @@
+#include "AudioAssetCache.h"
+#include "ConsoleLogger.h"
+
+using namespace Heph;
+
+namespace HephAudio
+{
+	AudioAssetCache::AudioAssetCache() : AudioAssetCache(HEPHAUDIO_ASSET_CACHE_DEFAULT_BUDGET) {}
+
+	AudioAssetCache::AudioAssetCache(size_t memoryBudget_byte)
+		: memoryBudget_byte(memoryBudget_byte), memoryUsage_byte(0), hitCount(0), missCount(0) {}
+
+	// compressed entries are stored next to the decoded ones under a different key.
+	static constexpr const char* COMPRESSED_KEY_SUFFIX = "|adpcm";
+
+	std::shared_ptr<const AudioBuffer> AudioAssetCache::Get(const std::filesystem::path& filePath, IAudioDecoder& decoder)
+	{
+		const std::string key = AudioAssetCache::GetKey(filePath);
+		std::error_code ec;
+		const std::filesystem::file_time_type lastWriteTime = std::filesystem::last_write_time(filePath, ec);
+
+		std::unique_lock<std::mutex> lock(this->mutex);
+
+		const Entry* pEntry = this->FindEntry(key, lastWriteTime);
+		if (pEntry != nullptr)
+		{
+			return pEntry->pBuffer;
+		}
+
+		// decode without holding the lock, so the files loaded on different threads are decoded in parallel.
+		lock.unlock();
+
+		// reopen the file in case the decoder still has the old version of it open.
+		decoder.CloseFile();
+		decoder.ChangeFile(filePath);
+		std::shared_ptr<const AudioBuffer> pBuffer = std::make_shared<const AudioBuffer>(decoder.Decode());
+		decoder.CloseFile();
+
+		lock.lock();
+
+		// another thread may have cached the same file meanwhile.
+		pEntry = this->FindEntry(key, lastWriteTime);
+		if (pEntry != nullptr)
+		{
+			return pEntry->pBuffer;
+		}
+
+		Entry entry;
+		entry.key = key;
+		entry.lastWriteTime = lastWriteTime;
+		entry.pBuffer = pBuffer;
+		entry.size_byte = pBuffer->FrameCount() * pBuffer->FormatInfo().channelLayout.count * sizeof(heph_audio_sample_t);
+		this->InsertEntry(std::move(entry));
+
+		return pBuffer;
+	}
+
+	std::shared_ptr<const CompressedAudioBuffer> AudioAssetCache::GetCompressed(const std::filesystem::path& filePath, IAudioDecoder& decoder)
+	{
+		const std::string key = AudioAssetCache::GetKey(filePath) + COMPRESSED_KEY_SUFFIX;
+		std::error_code ec;
+		const std::filesystem::file_time_type lastWriteTime = std::filesystem::last_write_time(filePath, ec);
+
+		std::unique_lock<std::mutex> lock(this->mutex);
+
+		const Entry* pEntry = this->FindEntry(key, lastWriteTime);
+		if (pEntry != nullptr)
+		{
+			return pEntry->pCompressedBuffer;
+		}
+
+		lock.unlock();
+
+		decoder.CloseFile();
+		decoder.ChangeFile(filePath);
+		std::shared_ptr<const CompressedAudioBuffer> pCompressedBuffer = std::make_shared<const CompressedAudioBuffer>(decoder);
+		decoder.CloseFile();
+
+		lock.lock();
+
+		pEntry = this->FindEntry(key, lastWriteTime);
+		if (pEntry != nullptr)
+		{
+			return pEntry->pCompressedBuffer;
+		}
+
+		Entry entry;
+		entry.key = key;
+		entry.lastWriteTime = lastWriteTime;
+		entry.pCompressedBuffer = pCompressedBuffer;
+		entry.size_byte = pCompressedBuffer->Size();
+		this->InsertEntry(std::move(entry));
+
+		return pCompressedBuffer;
+	}
+
+	bool AudioAssetCache::Contains(const std::filesystem::path& filePath) const
+	{
+		const std::string key = AudioAssetCache::GetKey(filePath);
+		std::lock_guard<std::mutex> lockGuard(this->mutex);
+		return this->entryMap.find(key) != this->entryMap.end();
+	}
+
+	bool AudioAssetCache::Remove(const std::filesystem::path& filePath)
+	{
+		const std::string key = AudioAssetCache::GetKey(filePath);
+		std::lock_guard<std::mutex> lockGuard(this->mutex);
+
+		const bool isDecodedRemoved = this->EraseKey(key);
+		const bool isCompressedRemoved = this->EraseKey(key + COMPRESSED_KEY_SUFFIX);
+		return isDecodedRemoved || isCompressedRemoved;
+	}
+
+	void AudioAssetCache::Clear()
+	{
+		std::lock_guard<std::mutex> lockGuard(this->mutex);
+		this->entries.clear();
+		this->entryMap.clear();
+		this->memoryUsage_byte = 0;
+	}
+
+	void AudioAssetCache::Trim()
+	{
+		std::lock_guard<std::mutex> lockGuard(this->mutex);
+		this->TrimInternal();
+	}
+
+	size_t AudioAssetCache::GetMemoryBudget() const
+	{
+		std::lock_guard<std::mutex> lockGuard(this->mutex);
+		return this->memoryBudget_byte;
+	}
+
+	void AudioAssetCache::SetMemoryBudget(size_t memoryBudget_byte)
+	{
+		std::lock_guard<std::mutex> lockGuard(this->mutex);
+		this->memoryBudget_byte = memoryBudget_byte;
+		this->TrimInternal();
+	}
+
+	size_t AudioAssetCache::GetMemoryUsage() const
+	{
+		std::lock_guard<std::mutex> lockGuard(this->mutex);
+		return this->memoryUsage_byte;
+	}
+
+	size_t AudioAssetCache::GetEntryCount() const
+	{
+		std::lock_guard<std::mutex> lockGuard(this->mutex);
+		return this->entries.size();
+	}
+
+	size_t AudioAssetCache::GetHitCount() const
+	{
+		std::lock_guard<std::mutex> lockGuard(this->mutex);
+		return this->hitCount;
+	}
+
+	size_t AudioAssetCache::GetMissCount() const
+	{
+		std::lock_guard<std::mutex> lockGuard(this->mutex);
+		return this->missCount;
+	}
+
+	std::string AudioAssetCache::GetKey(const std::filesystem::path& filePath)
+	{
+		// different spellings of the same path must map to the same entry.
+		std::error_code ec;
+		const std::filesystem::path canonicalPath = std::filesystem::weakly_canonical(filePath, ec);
+		return ec ? filePath.lexically_normal().string() : canonicalPath.string();
+	}
+
+	AudioAssetCache::Entry* AudioAssetCache::FindEntry(const std::string& key, std::filesystem::file_time_type lastWriteTime)
+	{
+		auto mapIt = this->entryMap.find(key);
+		if (mapIt == this->entryMap.end())
+		{
+			return nullptr;
+		}
+
+		if (mapIt->second->lastWriteTime == lastWriteTime)
+		{
+			this->entries.splice(this->entries.begin(), this->entries, mapIt->second);
+			this->hitCount++;
+			return &this->entries.front();
+		}
+
+		HEPHAUDIO_LOG("\"" + filePath.filename().string() + "\" is modified, decoding it again.", HEPH_CL_INFO);
+		this->EraseEntry(mapIt->second);
+		return nullptr;
+	}
+
+	void AudioAssetCache::InsertEntry(Entry&& entry)
+	{
+		const std::string key = entry.key;
+		this->memoryUsage_byte += entry.size_byte;
+		this->entries.push_front(std::move(entry));
+		this->entryMap[key] = this->entries.begin();
+		this->missCount++;
+
+		this->TrimInternal();
+	}
+
+	bool AudioAssetCache::EraseKey(const std::string& key)
+	{
+		auto mapIt = this->entryMap.find(key);
+		if (mapIt == this->entryMap.end())
+		{
+			return false;
+		}
+
+		this->EraseEntry(mapIt->second);
+		return true;
+	}
+
+	void AudioAssetCache::EraseEntry(std::list<Entry>::iterator it)
+	{
+		this->memoryUsage_byte -= it->size_byte;
+		this->entryMap.erase(it->key);
+		this->entries.erase(it);
+	}
+
+	void AudioAssetCache::TrimInternal()
+	{
+		// walk from the least recently used entry, erasing an entry does not invalidate the others.
+		auto it = this->entries.end();
+		while (this->memoryUsage_byte > this->memoryBudget_byte && it != this->entries.begin())
+		{
+			auto candidateIt = std::prev(it);
+
+			// the data is still used by an audio object.
+			if (candidateIt->pBuffer.use_count() > 1 || candidateIt->pCompressedBuffer.use_count() > 1)
+			{
+				it = candidateIt;
+				continue;
+			}
+
+			this->EraseEntry(candidateIt);
+		}
+	}
+}
\ No newline at end of file
@@ -1,55 +1,64 @@
 #include "AudioBuffer.h"
 #include "HephMath.h"
 #include "Exceptions/InvalidArgumentException.h"
+#include <cstring>
+#include <type_traits>
 
 using namespace Heph;
 
 namespace HephAudio
 {
-	AudioBuffer::AudioBuffer() : SignedArithmeticBuffer<AudioBuffer, heph_audio_sample_t>(), frameCount(0) { AudioBuffer::AddEventHandlers(); }
+	template<typename Tdata>
+	BasicAudioBuffer<Tdata>::BasicAudioBuffer() : SignedArithmeticBuffer<BasicAudioBuffer, Tdata>(), frameCount(0) { BasicAudioBuffer::AddEventHandlers(); }
 
-	AudioBuffer::AudioBuffer(size_t frameCount, const AudioChannelLayout& channelLayout, uint32_t sampleRate)
-		: SignedArithmeticBuffer<AudioBuffer, heph_audio_sample_t>(frameCount* channelLayout.count),
-		frameCount(frameCount), formatInfo(HEPHAUDIO_INTERNAL_FORMAT(channelLayout, sampleRate))
+	template<typename Tdata>
+	BasicAudioBuffer<Tdata>::BasicAudioBuffer(size_t frameCount, const AudioChannelLayout& channelLayout, uint32_t sampleRate)
+		: SignedArithmeticBuffer<BasicAudioBuffer, Tdata>(frameCount* channelLayout.count),
+		frameCount(frameCount), formatInfo(BasicAudioBuffer::CreateFormatInfo(channelLayout, sampleRate))
 	{
-		AudioBuffer::AddEventHandlers();
+		BasicAudioBuffer::AddEventHandlers();
 	}
 
-	AudioBuffer::AudioBuffer(size_t frameCount, const AudioChannelLayout& channelLayout, uint32_t sampleRate, BufferFlags flags)
-		: SignedArithmeticBuffer<AudioBuffer, heph_audio_sample_t>(frameCount* channelLayout.count, flags),
-		frameCount(frameCount), formatInfo(HEPHAUDIO_INTERNAL_FORMAT(channelLayout, sampleRate))
+	template<typename Tdata>
+	BasicAudioBuffer<Tdata>::BasicAudioBuffer(size_t frameCount, const AudioChannelLayout& channelLayout, uint32_t sampleRate, BufferFlags flags)
+		: SignedArithmeticBuffer<BasicAudioBuffer, Tdata>(frameCount* channelLayout.count, flags),
+		frameCount(frameCount), formatInfo(BasicAudioBuffer::CreateFormatInfo(channelLayout, sampleRate))
 	{
-		AudioBuffer::AddEventHandlers();
+		BasicAudioBuffer::AddEventHandlers();
 	}
 
-	AudioBuffer::AudioBuffer(const AudioBuffer& rhs)
-		: SignedArithmeticBuffer<AudioBuffer, heph_audio_sample_t>(rhs), frameCount(rhs.frameCount), formatInfo(rhs.formatInfo)
+	template<typename Tdata>
+	BasicAudioBuffer<Tdata>::BasicAudioBuffer(const BasicAudioBuffer& rhs)
+		: SignedArithmeticBuffer<BasicAudioBuffer, Tdata>(rhs), frameCount(rhs.frameCount), formatInfo(rhs.formatInfo)
 	{
-		AudioBuffer::AddEventHandlers();
+		BasicAudioBuffer::AddEventHandlers();
 	}
 
-	AudioBuffer::AudioBuffer(AudioBuffer&& rhs) noexcept
-		: SignedArithmeticBuffer<AudioBuffer, heph_audio_sample_t>(std::move(rhs)), frameCount(rhs.frameCount), formatInfo(rhs.formatInfo)
+	template<typename Tdata>
+	BasicAudioBuffer<Tdata>::BasicAudioBuffer(BasicAudioBuffer&& rhs) noexcept
+		: SignedArithmeticBuffer<BasicAudioBuffer, Tdata>(std::move(rhs)), frameCount(rhs.frameCount), formatInfo(rhs.formatInfo)
 	{
 		rhs.frameCount = 0;
 		rhs.formatInfo = AudioFormatInfo();
 
-		AudioBuffer::AddEventHandlers();
+		BasicAudioBuffer::AddEventHandlers();
 	}
 
-	AudioBuffer::~AudioBuffer()
+	template<typename Tdata>
+	BasicAudioBuffer<Tdata>::~BasicAudioBuffer()
 	{
 		this->frameCount = 0;
 		this->formatInfo = AudioFormatInfo();
 	}
 
-	AudioBuffer& AudioBuffer::operator=(const AudioBuffer& rhs)
+	template<typename Tdata>
+	BasicAudioBuffer<Tdata>& BasicAudioBuffer<Tdata>::operator=(const BasicAudioBuffer& rhs)
 	{
 		if (this != &rhs)
 		{
 			this->Release();
 
-			BufferBase::operator=(rhs);
+			BufferBase<BasicAudioBuffer, Tdata>::operator=(rhs);
 
 			this->frameCount = rhs.frameCount;
 			this->formatInfo = rhs.formatInfo;
@@ -57,13 +66,14 @@ namespace HephAudio
 		return *this;
 	}
 
-	AudioBuffer& AudioBuffer::operator=(AudioBuffer&& rhs) noexcept
+	template<typename Tdata>
+	BasicAudioBuffer<Tdata>& BasicAudioBuffer<Tdata>::operator=(BasicAudioBuffer&& rhs) noexcept
 	{
 		if (this != &rhs)
 		{
 			this->Release();
 
-			BufferBase::operator=(std::move(rhs));
+			BufferBase<BasicAudioBuffer, Tdata>::operator=(std::move(rhs));
 
 			this->frameCount = rhs.frameCount;
 			this->formatInfo = rhs.formatInfo;
@@ -75,66 +85,75 @@ namespace HephAudio
 		return *this;
 	}
 
-	AudioBuffer AudioBuffer::operator<<(size_t rhs) const
+	template<typename Tdata>
+	BasicAudioBuffer<Tdata> BasicAudioBuffer<Tdata>::operator<<(size_t rhs) const
 	{
-		AudioBuffer result = SignedArithmeticBuffer::operator<<(rhs * this->formatInfo.channelLayout.count);
+		BasicAudioBuffer result = SignedArithmeticBuffer<BasicAudioBuffer, Tdata>::operator<<(rhs * this->formatInfo.channelLayout.count);
 		result.frameCount = this->frameCount;
 		result.formatInfo = this->formatInfo;
 		return result;
 	}
 
-	AudioBuffer& AudioBuffer::operator<<=(size_t rhs)
+	template<typename Tdata>
+	BasicAudioBuffer<Tdata>& BasicAudioBuffer<Tdata>::operator<<=(size_t rhs)
 	{
-		return SignedArithmeticBuffer::operator<<=(rhs * this->formatInfo.channelLayout.count);
+		return SignedArithmeticBuffer<BasicAudioBuffer, Tdata>::operator<<=(rhs * this->formatInfo.channelLayout.count);
 	}
 
-	AudioBuffer AudioBuffer::operator>>(size_t rhs) const
+	template<typename Tdata>
+	BasicAudioBuffer<Tdata> BasicAudioBuffer<Tdata>::operator>>(size_t rhs) const
 	{
-		AudioBuffer result = SignedArithmeticBuffer::operator>>(rhs * this->formatInfo.channelLayout.count);
+		BasicAudioBuffer result = SignedArithmeticBuffer<BasicAudioBuffer, Tdata>::operator>>(rhs * this->formatInfo.channelLayout.count);
 		result.frameCount = this->frameCount;
 		result.formatInfo = this->formatInfo;
 		return result;
 	}
 
-	AudioBuffer& AudioBuffer::operator>>=(size_t rhs)
+	template<typename Tdata>
+	BasicAudioBuffer<Tdata>& BasicAudioBuffer<Tdata>::operator>>=(size_t rhs)
 	{
-		return SignedArithmeticBuffer::operator>>=(rhs * this->formatInfo.channelLayout.count);
+		return SignedArithmeticBuffer<BasicAudioBuffer, Tdata>::operator>>=(rhs * this->formatInfo.channelLayout.count);
 	}
 
-	bool AudioBuffer::operator==(const AudioBuffer& rhs) const
+	template<typename Tdata>
+	bool BasicAudioBuffer<Tdata>::operator==(const BasicAudioBuffer& rhs) const
 	{
 		return (this->IsEmpty() && rhs.IsEmpty()) ||
 			(this->size == rhs.size && this->formatInfo == rhs.formatInfo && std::memcmp(this->pData, rhs.pData, this->SizeAsByte()) == 0);
 	}
 
-	heph_audio_sample_t* AudioBuffer::operator[](size_t frameIndex) const
+	template<typename Tdata>
+	Tdata* BasicAudioBuffer<Tdata>::operator[](size_t frameIndex) const
 	{
-		return (heph_audio_sample_t*)(((uint8_t*)this->pData) + this->formatInfo.FrameSize() * frameIndex);
+		return (Tdata*)(((uint8_t*)this->pData) + this->formatInfo.FrameSize() * frameIndex);
 	}
 
-	void AudioBuffer::Release()
+	template<typename Tdata>
+	void BasicAudioBuffer<Tdata>::Release()
 	{
-		SignedArithmeticBuffer::Release();
+		SignedArithmeticBuffer<BasicAudioBuffer, Tdata>::Release();
 		this->frameCount = 0;
 		this->formatInfo = AudioFormatInfo();
 	}
 
-	AudioBuffer AudioBuffer::SubBuffer(size_t frameIndex, size_t frameCount) const
+	template<typename Tdata>
+	BasicAudioBuffer<Tdata> BasicAudioBuffer<Tdata>::SubBuffer(size_t frameIndex, size_t frameCount) const
 	{
-		AudioBuffer subBuffer = SignedArithmeticBuffer::SubBuffer(frameIndex * this->formatInfo.channelLayout.count, frameCount * this->formatInfo.channelLayout.count);
+		BasicAudioBuffer subBuffer = SignedArithmeticBuffer<BasicAudioBuffer, Tdata>::SubBuffer(frameIndex * this->formatInfo.channelLayout.count, frameCount * this->formatInfo.channelLayout.count);
 		subBuffer.frameCount = frameCount;
 		subBuffer.formatInfo = this->formatInfo;
 		return subBuffer;
 	}
 
-	void AudioBuffer::Prepend(const AudioBuffer& rhs)
+	template<typename Tdata>
+	void BasicAudioBuffer<Tdata>::Prepend(const BasicAudioBuffer& rhs)
 	{
 		if (this->formatInfo != rhs.formatInfo)
 		{
 			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "Both buffers must have the same audio format"));
 		}
 
-		SignedArithmeticBuffer::Prepend(rhs);
+		SignedArithmeticBuffer<BasicAudioBuffer, Tdata>::Prepend(rhs);
 
 		if (this->formatInfo.channelLayout.count > 0)
 		{
@@ -142,14 +161,15 @@ namespace HephAudio
 		}
 	}
 
-	void AudioBuffer::Append(const AudioBuffer& rhs)
+	template<typename Tdata>
+	void BasicAudioBuffer<Tdata>::Append(const BasicAudioBuffer& rhs)
 	{
 		if (this->formatInfo != rhs.formatInfo)
 		{
 			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "Both buffers must have the same audio format"));
 		}
 
-		SignedArithmeticBuffer::Append(rhs);
+		SignedArithmeticBuffer<BasicAudioBuffer, Tdata>::Append(rhs);
 
 		if (this->formatInfo.channelLayout.count > 0)
 		{
@@ -157,14 +177,15 @@ namespace HephAudio
 		}
 	}
 
-	void AudioBuffer::Insert(const AudioBuffer& rhs, size_t frameIndex)
+	template<typename Tdata>
+	void BasicAudioBuffer<Tdata>::Insert(const BasicAudioBuffer& rhs, size_t frameIndex)
 	{
 		if (this->formatInfo != rhs.formatInfo)
 		{
 			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "Both buffers must have the same audio format"));
 		}
 
-		SignedArithmeticBuffer::Insert(rhs, frameIndex * this->formatInfo.channelLayout.count);
+		SignedArithmeticBuffer<BasicAudioBuffer, Tdata>::Insert(rhs, frameIndex * this->formatInfo.channelLayout.count);
 
 		if (this->formatInfo.channelLayout.count > 0)
 		{
@@ -172,9 +193,10 @@ namespace HephAudio
 		}
 	}
 
-	void AudioBuffer::Cut(size_t frameIndex, size_t frameCount)
+	template<typename Tdata>
+	void BasicAudioBuffer<Tdata>::Cut(size_t frameIndex, size_t frameCount)
 	{
-		SignedArithmeticBuffer::Cut(frameIndex * this->formatInfo.channelLayout.count, frameCount * this->formatInfo.channelLayout.count);
+		SignedArithmeticBuffer<BasicAudioBuffer, Tdata>::Cut(frameIndex * this->formatInfo.channelLayout.count, frameCount * this->formatInfo.channelLayout.count);
 
 		if (this->formatInfo.channelLayout.count > 0)
 		{
@@ -182,26 +204,29 @@ namespace HephAudio
 		}
 	}
 
-	void AudioBuffer::Replace(const AudioBuffer& rhs, size_t frameIndex, size_t frameCount)
+	template<typename Tdata>
+	void BasicAudioBuffer<Tdata>::Replace(const BasicAudioBuffer& rhs, size_t frameIndex, size_t frameCount)
 	{
 		if (this->formatInfo != rhs.formatInfo)
 		{
 			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "Both buffers must have the same audio format"));
 		}
 
-		SignedArithmeticBuffer::Replace(rhs, frameIndex * this->formatInfo.channelLayout.count, frameCount * this->formatInfo.channelLayout.count);
+		SignedArithmeticBuffer<BasicAudioBuffer, Tdata>::Replace(rhs, frameIndex * this->formatInfo.channelLayout.count, frameCount * this->formatInfo.channelLayout.count);
 	}
 
-	void AudioBuffer::Resize(size_t newFrameCount)
+	template<typename Tdata>
+	void BasicAudioBuffer<Tdata>::Resize(size_t newFrameCount)
 	{
-		SignedArithmeticBuffer::Resize(newFrameCount * this->formatInfo.channelLayout.count);
+		SignedArithmeticBuffer<BasicAudioBuffer, Tdata>::Resize(newFrameCount * this->formatInfo.channelLayout.count);
 		if (this->formatInfo.channelLayout.count > 0)
 		{
 			this->frameCount = this->size / this->formatInfo.channelLayout.count;
 		}
 	}
 
-	void AudioBuffer::Reverse()
+	template<typename Tdata>
+	void BasicAudioBuffer<Tdata>::Reverse()
 	{
 		const size_t halfFrameCount = this->frameCount / 2;
 		for (size_t i = 0; i < halfFrameCount; ++i)
@@ -213,17 +238,20 @@ namespace HephAudio
 		}
 	}
 
-	size_t AudioBuffer::FrameCount() const
+	template<typename Tdata>
+	size_t BasicAudioBuffer<Tdata>::FrameCount() const
 	{
 		return this->frameCount;
 	}
 
-	const AudioFormatInfo& AudioBuffer::FormatInfo() const
+	template<typename Tdata>
+	const AudioFormatInfo& BasicAudioBuffer<Tdata>::FormatInfo() const
 	{
 		return this->formatInfo;
 	}
 
-	void AudioBuffer::SetChannelLayout(const AudioChannelLayout& channelLayout)
+	template<typename Tdata>
+	void BasicAudioBuffer<Tdata>::SetChannelLayout(const AudioChannelLayout& channelLayout)
 	{
 		const size_t frameCount = this->frameCount;
 		const uint32_t sampleRate = this->formatInfo.sampleRate;
@@ -232,36 +260,46 @@ namespace HephAudio
 
 		this->size = frameCount * channelLayout.count;
 		this->frameCount = frameCount;
-		this->formatInfo = HEPHAUDIO_INTERNAL_FORMAT(channelLayout, sampleRate);
-		this->pData = SignedArithmeticBuffer::Allocate(this->SizeAsByte());
+		this->formatInfo = BasicAudioBuffer::CreateFormatInfo(channelLayout, sampleRate);
+		this->pData = SignedArithmeticBuffer<BasicAudioBuffer, Tdata>::Allocate(this->SizeAsByte());
 	}
 
-	void AudioBuffer::SetSampleRate(uint32_t sampleRate)
+	template<typename Tdata>
+	void BasicAudioBuffer<Tdata>::SetSampleRate(uint32_t sampleRate)
 	{
 		this->formatInfo.sampleRate = sampleRate;
 	}
 
-	void AudioBuffer::AddEventHandlers()
+	template<typename Tdata>
+	AudioFormatInfo BasicAudioBuffer<Tdata>::CreateFormatInfo(const AudioChannelLayout& channelLayout, uint32_t sampleRate)
 	{
-		if (!AudioBuffer::ADD_EVENT_HANDLERS)
+		return AudioFormatInfo(std::is_floating_point<Tdata>::value ? HEPHAUDIO_FORMAT_TAG_IEEE_FLOAT : HEPHAUDIO_FORMAT_TAG_PCM, sizeof(Tdata) * 8, channelLayout, sampleRate, HEPH_SYSTEM_ENDIAN);
+	}
+
+	template<typename Tdata>
+	void BasicAudioBuffer<Tdata>::AddEventHandlers()
+	{
+		if (!BasicAudioBuffer::ADD_EVENT_HANDLERS)
 		{
-			BufferOperatorEvents<AudioBuffer, heph_audio_sample_t>::OnResultCreated += AudioBuffer::ResultCreatedEventHandler;
-			BufferOperatorEvents<AudioBuffer, AudioBuffer>::OnResultCreated += AudioBuffer::ResultCreatedEventHandlerBuffer;
-			AudioBuffer::ADD_EVENT_HANDLERS = true;
+			BufferOperatorEvents<BasicAudioBuffer, Tdata>::OnResultCreated += BasicAudioBuffer::ResultCreatedEventHandler;
+			BufferOperatorEvents<BasicAudioBuffer, BasicAudioBuffer>::OnResultCreated += BasicAudioBuffer::ResultCreatedEventHandlerBuffer;
+			BasicAudioBuffer::ADD_EVENT_HANDLERS = true;
 		}
 	}
 
-	void AudioBuffer::ResultCreatedEventHandler(const EventParams& params)
+	template<typename Tdata>
+	void BasicAudioBuffer<Tdata>::ResultCreatedEventHandler(const EventParams& params)
 	{
-		BufferOperatorResultCreatedEventArgs<AudioBuffer, heph_audio_sample_t>* pArgs = (BufferOperatorResultCreatedEventArgs<AudioBuffer, heph_audio_sample_t>*)params.pArgs;
+		BufferOperatorResultCreatedEventArgs<BasicAudioBuffer, Tdata>* pArgs = (BufferOperatorResultCreatedEventArgs<BasicAudioBuffer, Tdata>*)params.pArgs;
 
 		pArgs->result.frameCount = pArgs->lhs.frameCount;
 		pArgs->result.formatInfo = pArgs->lhs.formatInfo;
 	}
 
-	void AudioBuffer::ResultCreatedEventHandlerBuffer(const EventParams& params)
+	template<typename Tdata>
+	void BasicAudioBuffer<Tdata>::ResultCreatedEventHandlerBuffer(const EventParams& params)
 	{
-		BufferOperatorResultCreatedEventArgs<AudioBuffer, AudioBuffer>* pArgs = (BufferOperatorResultCreatedEventArgs<AudioBuffer, AudioBuffer>*)params.pArgs;
+		BufferOperatorResultCreatedEventArgs<BasicAudioBuffer, BasicAudioBuffer>* pArgs = (BufferOperatorResultCreatedEventArgs<BasicAudioBuffer, BasicAudioBuffer>*)params.pArgs;
 
 		if (pArgs->lhs.formatInfo != pArgs->rhs.formatInfo)
 		{
@@ -271,30 +309,45 @@ namespace HephAudio
 		pArgs->result.frameCount = pArgs->lhs.frameCount;
 		pArgs->result.formatInfo = pArgs->lhs.formatInfo;
 	}
+
+	template class HEPH_API BasicAudioBuffer<int16_t>;
+	template class HEPH_API BasicAudioBuffer<int32_t>;
+	template class HEPH_API BasicAudioBuffer<int64_t>;
+	template class HEPH_API BasicAudioBuffer<float>;
+	template class HEPH_API BasicAudioBuffer<double>;
 }
 
 namespace Heph
 {
 	// explicit instantiate for building shared libraries.
-	template class HEPH_API BufferBase<HephAudio::AudioBuffer, heph_audio_sample_t>;
-	template class HEPH_API ArithmeticBuffer<HephAudio::AudioBuffer, heph_audio_sample_t>;
-	template class HEPH_API SignedArithmeticBuffer<HephAudio::AudioBuffer, heph_audio_sample_t>;
-
-	template class HEPH_API BufferAdditionOperator<HephAudio::AudioBuffer, heph_audio_sample_t>;
-	template class HEPH_API BufferSubtractionOperator<HephAudio::AudioBuffer, heph_audio_sample_t>;
-	template class HEPH_API BufferDivisionOperator<HephAudio::AudioBuffer, heph_audio_sample_t>;
-	template class HEPH_API BufferMultiplicationOperator<HephAudio::AudioBuffer, heph_audio_sample_t>;
-	template class HEPH_API BufferArithmeticOperators<HephAudio::AudioBuffer, heph_audio_sample_t>;
-	template struct HEPH_API BufferOperatorResultCreatedEventArgs<HephAudio::AudioBuffer, heph_audio_sample_t>;
-	template struct HEPH_API BufferOperatorEvents<HephAudio::AudioBuffer, heph_audio_sample_t>;
-
-	template class HEPH_API BufferAdditionOperator<HephAudio::AudioBuffer, heph_audio_sample_t, HephAudio::AudioBuffer, heph_audio_sample_t>;
-	template class HEPH_API BufferSubtractionOperator<HephAudio::AudioBuffer, heph_audio_sample_t, HephAudio::AudioBuffer, heph_audio_sample_t>;
-	template class HEPH_API BufferDivisionOperator<HephAudio::AudioBuffer, heph_audio_sample_t, HephAudio::AudioBuffer, heph_audio_sample_t>;
-	template class HEPH_API BufferMultiplicationOperator<HephAudio::AudioBuffer, heph_audio_sample_t, HephAudio::AudioBuffer, heph_audio_sample_t>;
-	template class HEPH_API BufferArithmeticOperators<HephAudio::AudioBuffer, heph_audio_sample_t, HephAudio::AudioBuffer, heph_audio_sample_t>;
-	template struct HEPH_API BufferOperatorResultCreatedEventArgs<HephAudio::AudioBuffer, HephAudio::AudioBuffer>;
-	template struct HEPH_API BufferOperatorEvents<HephAudio::AudioBuffer, HephAudio::AudioBuffer>;
-
-	template class HEPH_API BufferUnaryMinusOperator<HephAudio::AudioBuffer, heph_audio_sample_t>;
+#define HEPHAUDIO_INSTANTIATE_AUDIO_BUFFER_BASE(Tdata) \
+	template class HEPH_API BufferBase<HephAudio::BasicAudioBuffer<Tdata>, Tdata>; \
+	template class HEPH_API ArithmeticBuffer<HephAudio::BasicAudioBuffer<Tdata>, Tdata>; \
+	template class HEPH_API SignedArithmeticBuffer<HephAudio::BasicAudioBuffer<Tdata>, Tdata>; \
+	\
+	template class HEPH_API BufferAdditionOperator<HephAudio::BasicAudioBuffer<Tdata>, Tdata>; \
+	template class HEPH_API BufferSubtractionOperator<HephAudio::BasicAudioBuffer<Tdata>, Tdata>; \
+	template class HEPH_API BufferDivisionOperator<HephAudio::BasicAudioBuffer<Tdata>, Tdata>; \
+	template class HEPH_API BufferMultiplicationOperator<HephAudio::BasicAudioBuffer<Tdata>, Tdata>; \
+	template class HEPH_API BufferArithmeticOperators<HephAudio::BasicAudioBuffer<Tdata>, Tdata>; \
+	template struct HEPH_API BufferOperatorResultCreatedEventArgs<HephAudio::BasicAudioBuffer<Tdata>, Tdata>; \
+	template struct HEPH_API BufferOperatorEvents<HephAudio::BasicAudioBuffer<Tdata>, Tdata>; \
+	\
+	template class HEPH_API BufferAdditionOperator<HephAudio::BasicAudioBuffer<Tdata>, Tdata, HephAudio::BasicAudioBuffer<Tdata>, Tdata>; \
+	template class HEPH_API BufferSubtractionOperator<HephAudio::BasicAudioBuffer<Tdata>, Tdata, HephAudio::BasicAudioBuffer<Tdata>, Tdata>; \
+	template class HEPH_API BufferDivisionOperator<HephAudio::BasicAudioBuffer<Tdata>, Tdata, HephAudio::BasicAudioBuffer<Tdata>, Tdata>; \
+	template class HEPH_API BufferMultiplicationOperator<HephAudio::BasicAudioBuffer<Tdata>, Tdata, HephAudio::BasicAudioBuffer<Tdata>, Tdata>; \
+	template class HEPH_API BufferArithmeticOperators<HephAudio::BasicAudioBuffer<Tdata>, Tdata, HephAudio::BasicAudioBuffer<Tdata>, Tdata>; \
+	template struct HEPH_API BufferOperatorResultCreatedEventArgs<HephAudio::BasicAudioBuffer<Tdata>, HephAudio::BasicAudioBuffer<Tdata>>; \
+	template struct HEPH_API BufferOperatorEvents<HephAudio::BasicAudioBuffer<Tdata>, HephAudio::BasicAudioBuffer<Tdata>>; \
+	\
+	template class HEPH_API BufferUnaryMinusOperator<HephAudio::BasicAudioBuffer<Tdata>, Tdata>;
+
+	HEPHAUDIO_INSTANTIATE_AUDIO_BUFFER_BASE(int16_t)
+	HEPHAUDIO_INSTANTIATE_AUDIO_BUFFER_BASE(int32_t)
+	HEPHAUDIO_INSTANTIATE_AUDIO_BUFFER_BASE(int64_t)
+	HEPHAUDIO_INSTANTIATE_AUDIO_BUFFER_BASE(float)
+	HEPHAUDIO_INSTANTIATE_AUDIO_BUFFER_BASE(double)
+
+#undef HEPHAUDIO_INSTANTIATE_AUDIO_BUFFER_BASE
 }
\ No newline at end of file
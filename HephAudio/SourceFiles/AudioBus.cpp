@@ -0,0 +1,15 @@
+#include "AudioBus.h"
+
+using namespace Heph;
+
+namespace HephAudio
+{
+	AudioBusSend::AudioBusSend() : AudioBusSend("", 1.0) {}
+
+	AudioBusSend::AudioBusSend(const std::string& busName, double level) : busName(busName), level(level) {}
+
+	AudioBus::AudioBus() : AudioBus("", "") {}
+
+	AudioBus::AudioBus(const std::string& name, const std::string& outputBusName)
+		: name(name), outputBusName(outputBusName), volume(1.0), pBuffer(nullptr), pOutputBus(nullptr), height(0), visitState(0) {}
+}
\ No newline at end of file
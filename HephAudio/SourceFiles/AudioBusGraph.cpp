@@ -0,0 +1,370 @@
+#include "AudioBusGraph.h"
+#include "HephMath.h"
+#include "Exceptions/InvalidArgumentException.h"
+#include <algorithm>
+#include <thread>
+
+using namespace Heph;
+
+namespace HephAudio
+{
+	AudioBusGraph::AudioBusGraph()
+		: threadCount(1), pLevelBuses(nullptr), levelBusCount(0), levelGeneration(0), stopWorkers(false), levelTask(0), levelRemainingCount(0)
+	{
+		this->buses.emplace_back(HEPHAUDIO_MASTER_BUS_NAME, "");
+		this->busMap[HEPHAUDIO_MASTER_BUS_NAME] = &this->buses.front();
+	}
+
+	AudioBusGraph::~AudioBusGraph()
+	{
+		// join the workers before the state they use is destroyed.
+		this->JoinWorkers();
+	}
+
+	AudioBus* AudioBusGraph::CreateBus(const std::string& name, const std::string& outputBusName)
+	{
+		if (name.empty())
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "Bus name cannot be empty."));
+		}
+		if (this->busMap.find(name) != this->busMap.end())
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "A bus with the same name already exists."));
+		}
+
+		AudioBus& bus = this->buses.emplace_back(name, outputBusName);
+		this->busMap[name] = &bus;
+		return &bus;
+	}
+
+	bool AudioBusGraph::DestroyBus(const std::string& name)
+	{
+		std::unordered_map<std::string, AudioBus*>::iterator it = this->busMap.find(name);
+		if (it == this->busMap.end() || it->second == &this->buses.front())
+		{
+			return false;
+		}
+
+		const AudioBus* pBus = it->second;
+		this->busMap.erase(it);
+		this->buses.remove_if([pBus](const AudioBus& bus) { return &bus == pBus; });
+		return true;
+	}
+
+	AudioBus* AudioBusGraph::GetBus(const std::string& name)
+	{
+		std::unordered_map<std::string, AudioBus*>::iterator it = this->busMap.find(name);
+		return it != this->busMap.end() ? it->second : nullptr;
+	}
+
+	AudioBus& AudioBusGraph::GetMasterBus()
+	{
+		return this->buses.front();
+	}
+
+	size_t AudioBusGraph::GetBusCount() const
+	{
+		return this->buses.size();
+	}
+
+	size_t AudioBusGraph::GetThreadCount() const
+	{
+		return this->threadCount;
+	}
+
+	void AudioBusGraph::SetThreadCount(size_t threadCount)
+	{
+		if (threadCount == 0)
+		{
+			threadCount = HEPH_MATH_MAX(std::thread::hardware_concurrency(), 1u);
+		}
+
+		if (threadCount != this->threadCount)
+		{
+			this->JoinWorkers();
+			this->threadCount = threadCount;
+
+			// the render thread is one of the threads.
+			this->workers.reserve(threadCount - 1);
+			for (size_t i = 1; i < threadCount; ++i)
+			{
+				this->workers.push_back(std::thread(&AudioBusGraph::RunWorker, this));
+			}
+		}
+	}
+
+	void AudioBusGraph::BeginPeriod(AudioBuffer& outputBuffer)
+	{
+		const AudioFormatInfo& formatInfo = outputBuffer.FormatInfo();
+		const size_t frameCount = outputBuffer.FrameCount();
+
+		std::list<AudioBus>::iterator it = this->buses.begin();
+		it->pBuffer = &outputBuffer;
+		for (++it; it != this->buses.end(); ++it)
+		{
+			AudioBuffer& buffer = it->buffer;
+			if (buffer.FrameCount() != frameCount || buffer.FormatInfo().channelLayout != formatInfo.channelLayout || buffer.FormatInfo().sampleRate != formatInfo.sampleRate)
+			{
+				buffer = AudioBuffer(frameCount, formatInfo.channelLayout, formatInfo.sampleRate);
+			}
+			else
+			{
+				buffer.Reset();
+			}
+			it->pBuffer = &buffer;
+		}
+	}
+
+	AudioBuffer* AudioBusGraph::GetInputBuffer(const std::string& busName)
+	{
+		if (busName.empty())
+		{
+			return this->buses.front().pBuffer;
+		}
+
+		AudioBus* pBus = this->GetBus(busName);
+		return pBus != nullptr ? pBus->pBuffer : nullptr;
+	}
+
+	void AudioBusGraph::Process()
+	{
+		AudioBus& masterBus = this->buses.front();
+
+		if (this->buses.size() > 1)
+		{
+			for (std::vector<AudioBus*>& level : this->levels)
+			{
+				level.clear();
+			}
+			for (AudioBus& bus : this->buses)
+			{
+				bus.visitState = 0;
+			}
+			for (AudioBus& bus : this->buses)
+			{
+				this->Visit(bus);
+			}
+
+			// a bus only outputs to buses closer to the master, so each level is complete once the previous ones are mixed.
+			for (size_t height = this->levels.size() - 1; height > 0; --height)
+			{
+				const std::vector<AudioBus*>& level = this->levels[height];
+				if (level.empty())
+				{
+					continue;
+				}
+
+				this->ProcessLevel(level);
+
+				for (AudioBus* pBus : level)
+				{
+					AudioBusGraph::MixInto(*pBus->pOutputBus->pBuffer, *pBus->pBuffer, pBus->volume);
+					for (size_t i = 0; i < pBus->resolvedSendBuses.size(); ++i)
+					{
+						AudioBusGraph::MixInto(*pBus->resolvedSendBuses[i]->pBuffer, *pBus->pBuffer, pBus->volume * pBus->resolvedSendLevels[i]);
+					}
+				}
+			}
+		}
+
+		AudioBusGraph::ApplyEffects(masterBus);
+		if (masterBus.volume != 1.0)
+		{
+			AudioBuffer& buffer = *masterBus.pBuffer;
+			for (size_t i = 0; i < buffer.Size(); ++i)
+			{
+				buffer.begin()[i] *= masterBus.volume;
+			}
+		}
+	}
+
+	size_t AudioBusGraph::Visit(AudioBus& bus)
+	{
+		if (bus.visitState == 2)
+		{
+			return bus.height;
+		}
+
+		AudioBus& masterBus = this->buses.front();
+		size_t height = 0;
+
+		bus.visitState = 1;
+		bus.resolvedSendBuses.clear();
+		bus.resolvedSendLevels.clear();
+		if (&bus != &masterBus)
+		{
+			// targets that are still being visited would close a cycle.
+			AudioBus* pOutputBus = this->GetBus(bus.outputBusName);
+			if (pOutputBus == nullptr || pOutputBus->visitState == 1)
+			{
+				pOutputBus = &masterBus;
+			}
+			bus.pOutputBus = pOutputBus;
+			height = this->Visit(*pOutputBus) + 1;
+
+			for (const AudioBusSend& send : bus.sends)
+			{
+				AudioBus* pSendBus = this->GetBus(send.busName);
+				if (pSendBus != nullptr && pSendBus->visitState != 1)
+				{
+					height = HEPH_MATH_MAX(height, this->Visit(*pSendBus) + 1);
+					bus.resolvedSendBuses.push_back(pSendBus);
+					bus.resolvedSendLevels.push_back(send.level);
+				}
+			}
+		}
+		bus.visitState = 2;
+		bus.height = height;
+
+		if (this->levels.size() <= height)
+		{
+			this->levels.resize(height + 1);
+		}
+		this->levels[height].push_back(&bus);
+
+		return height;
+	}
+
+	void AudioBusGraph::ProcessLevel(const std::vector<AudioBus*>& levelBuses)
+	{
+		const size_t levelThreadCount = HEPH_MATH_MIN(levelBuses.size(), this->threadCount);
+		if (levelThreadCount <= 1)
+		{
+			for (AudioBus* pBus : levelBuses)
+			{
+				AudioBusGraph::ApplyEffects(*pBus);
+			}
+			return;
+		}
+
+		const size_t busCount = levelBuses.size();
+		uint32_t generation;
+		{
+			std::lock_guard<std::mutex> lockGuard(this->levelMutex);
+			generation = ++this->levelGeneration;
+			this->pLevelBuses = levelBuses.data();
+			this->levelBusCount = busCount;
+			this->levelRemainingCount.store(busCount, std::memory_order_relaxed);
+			this->levelTask.store((uint64_t)generation << 32, std::memory_order_release);
+		}
+
+		// the render thread takes part, workers that wake up after the level is done go back to sleep.
+		this->workerCondition.notify_all();
+		this->RunLevelTasks(generation, busCount);
+
+		std::exception_ptr levelException = nullptr;
+		{
+			std::unique_lock<std::mutex> lock(this->levelMutex);
+			this->levelCondition.wait(lock, [this]() { return this->levelRemainingCount.load(std::memory_order_acquire) == 0; });
+			std::swap(levelException, this->levelException);
+		}
+
+		// the workers are done with the level, so the exception can be rethrown as if the effects were applied serially.
+		if (levelException != nullptr)
+		{
+			std::rethrow_exception(levelException);
+		}
+	}
+
+	void AudioBusGraph::JoinWorkers()
+	{
+		{
+			std::lock_guard<std::mutex> lockGuard(this->levelMutex);
+			this->stopWorkers = true;
+		}
+		this->workerCondition.notify_all();
+
+		for (std::thread& t : this->workers)
+		{
+			if (t.joinable())
+			{
+				t.join();
+			}
+		}
+		this->workers.clear();
+		this->stopWorkers = false;
+	}
+
+	void AudioBusGraph::RunWorker()
+	{
+		std::unique_lock<std::mutex> lock(this->levelMutex);
+		uint32_t generation = this->levelGeneration;
+		while (true)
+		{
+			this->workerCondition.wait(lock, [this, generation]() { return this->stopWorkers || this->levelGeneration != generation; });
+			if (this->stopWorkers)
+			{
+				return;
+			}
+
+			generation = this->levelGeneration;
+			const size_t busCount = this->levelBusCount;
+			lock.unlock();
+			this->RunLevelTasks(generation, busCount);
+			lock.lock();
+		}
+	}
+
+	void AudioBusGraph::RunLevelTasks(uint32_t generation, size_t busCount)
+	{
+		uint64_t task = this->levelTask.load(std::memory_order_acquire);
+		while ((uint32_t)(task >> 32) == generation && (task & 0xFFFFFFFF) < busCount)
+		{
+			if (!this->levelTask.compare_exchange_weak(task, task + 1, std::memory_order_acq_rel, std::memory_order_acquire))
+			{
+				continue;
+			}
+
+			// claiming a bus of this generation guarantees the level is still being processed.
+			try
+			{
+				AudioBusGraph::ApplyEffects(*this->pLevelBuses[task & 0xFFFFFFFF]);
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lockGuard(this->levelMutex);
+				if (this->levelException == nullptr)
+				{
+					this->levelException = std::current_exception();
+				}
+			}
+
+			if (this->levelRemainingCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				std::lock_guard<std::mutex> lockGuard(this->levelMutex);
+				this->levelCondition.notify_all();
+			}
+			task = this->levelTask.load(std::memory_order_acquire);
+		}
+	}
+
+	void AudioBusGraph::ApplyEffects(AudioBus& bus)
+	{
+		AudioBuffer& buffer = *bus.pBuffer;
+		const size_t frameCount = buffer.FrameCount();
+
+		for (const std::shared_ptr<AudioEffect>& pEffect : bus.effects)
+		{
+			if (pEffect != nullptr)
+			{
+				pEffect->Process(buffer);
+			}
+		}
+
+		if (buffer.FrameCount() != frameCount)
+		{
+			buffer.Resize(frameCount);
+		}
+	}
+
+	void AudioBusGraph::MixInto(AudioBuffer& target, const AudioBuffer& source, double gain)
+	{
+		const size_t sampleCount = HEPH_MATH_MIN(target.Size(), source.Size());
+		heph_audio_sample_t* pTarget = target.begin();
+		const heph_audio_sample_t* pSource = source.begin();
+		for (size_t i = 0; i < sampleCount; ++i)
+		{
+			pTarget[i] += pSource[i] * gain;
+		}
+	}
+}
\ No newline at end of file
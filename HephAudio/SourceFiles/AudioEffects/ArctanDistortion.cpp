@@ -1,5 +1,6 @@
 #include "AudioEffects/ArctanDistortion.h"
 #include "Exceptions/InvalidArgumentException.h"
+#include "FastMath.h"
 #include "HephMath.h"
 
 using namespace Heph;
@@ -8,7 +9,7 @@ namespace HephAudio
 {
 	ArctanDistortion::ArctanDistortion() : ArctanDistortion(1.0) {}
 
-	ArctanDistortion::ArctanDistortion(double factor) : AudioEffect()
+	ArctanDistortion::ArctanDistortion(double factor) : WaveshaperEffect()
 	{
 		this->SetFactor(factor);
 	}
@@ -31,22 +32,16 @@ namespace HephAudio
 		}
 
 		this->factor = factor + 1;
+		this->UpdateLookupTable();
 	}
 
-	void ArctanDistortion::ProcessST(const AudioBuffer& inputBuffer, AudioBuffer& outputBuffer, size_t startIndex, size_t frameCount)
+	void ArctanDistortion::TransferFunction(float* pSamples, size_t sampleCount) const
 	{
-		const size_t endIndex = startIndex + frameCount;
-		const AudioFormatInfo& formatInfo = outputBuffer.FormatInfo();
-
-		for (size_t i = startIndex; i < endIndex; ++i)
+		const float factor = this->factor;
+		for (size_t i = 0; i < sampleCount; ++i)
 		{
-			for (size_t j = 0; j < formatInfo.channelLayout.count; ++j)
-			{
-				double fltSample = HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(outputBuffer[i][j]);
-				fltSample = atan(this->factor * fltSample) * (2.0 / HEPH_MATH_PI);
-
-				outputBuffer[i][j] = HEPH_AUDIO_SAMPLE_FROM_IEEE_FLT(HEPH_MATH_MIN(HEPH_MATH_MAX(fltSample, -1.0), 1.0));
-			}
+			const float fltSample = FastMath::Atan(factor * pSamples[i]) * (float)(2.0 / HEPH_MATH_PI);
+			pSamples[i] = HEPH_MATH_MIN(HEPH_MATH_MAX(fltSample, -1.0f), 1.0f);
 		}
 	}
 }
\ No newline at end of file
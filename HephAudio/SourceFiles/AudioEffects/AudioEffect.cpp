@@ -8,7 +8,7 @@ using namespace Heph;
 
 namespace HephAudio
 {
-	AudioEffect::AudioEffect() : threadCount(1) {}
+	AudioEffect::AudioEffect() : threadCount(1), processDepth(0) {}
 
 	bool AudioEffect::HasMTSupport() const
 	{
@@ -37,6 +37,16 @@ namespace HephAudio
 		}
 	}
 
+	TimingStatisticsSnapshot AudioEffect::GetProcessStatistics() const
+	{
+		return this->processStatistics.GetSnapshot();
+	}
+
+	void AudioEffect::ResetProcessStatistics()
+	{
+		this->processStatistics.Reset();
+	}
+
 	size_t AudioEffect::CalculateRequiredFrameCount(size_t outputFrameCount, const AudioFormatInfo& formatInfo) const
 	{
 		return outputFrameCount;
@@ -59,11 +69,14 @@ namespace HephAudio
 
 	void AudioEffect::Process(AudioBuffer& buffer)
 	{
+		ProcessTimer processTimer(*this);
 		this->Process(buffer, 0, buffer.FrameCount());
 	}
 
 	void AudioEffect::Process(AudioBuffer& buffer, size_t startIndex)
 	{
+		ProcessTimer processTimer(*this);
+
 		if (startIndex > buffer.FrameCount())
 		{
 			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "startIndex out of bounds."));
@@ -74,6 +87,8 @@ namespace HephAudio
 
 	void AudioEffect::Process(AudioBuffer& buffer, size_t startIndex, size_t frameCount)
 	{
+		ProcessTimer processTimer(*this);
+
 		if (startIndex > buffer.FrameCount())
 		{
 			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "startIndex out of bounds."));
@@ -70,6 +70,13 @@ namespace HephAudio
 		}
 	}
 
+	bool ChannelMapper::CanReuseOutputBuffer(const AudioBuffer& inputBuffer, size_t startIndex, size_t frameCount) const
+	{
+		// partial ranges take the other path so InitializeOutputBuffer can reject them.
+		return inputBuffer.FormatInfo().channelLayout == this->targetLayout && startIndex == 0 && frameCount == inputBuffer.FrameCount()
+			&& DoubleBufferedAudioEffect::CanReuseOutputBuffer(inputBuffer, startIndex, frameCount);
+	}
+
 	AudioBuffer ChannelMapper::CreateOutputBuffer(const AudioBuffer& inputBuffer, size_t startIndex, size_t frameCount) const
 	{
 		const AudioFormatInfo& formatInfo = inputBuffer.FormatInfo();
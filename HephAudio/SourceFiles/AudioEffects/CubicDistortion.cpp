@@ -1,5 +1,6 @@
 #include "AudioEffects/CubicDistortion.h"
 #include "Exceptions/InvalidArgumentException.h"
+#include "HephMath.h"
 
 using namespace Heph;
 
@@ -7,7 +8,7 @@ namespace HephAudio
 {
 	CubicDistortion::CubicDistortion() : CubicDistortion(1.0) {}
 
-	CubicDistortion::CubicDistortion(double factor) : AudioEffect()
+	CubicDistortion::CubicDistortion(double factor) : WaveshaperEffect()
 	{
 		this->SetFactor(factor);
 	}
@@ -30,22 +31,17 @@ namespace HephAudio
 		}
 
 		this->factor = factor + 1;
+		this->UpdateLookupTable();
 	}
 
-	void CubicDistortion::ProcessST(const AudioBuffer& inputBuffer, AudioBuffer& outputBuffer, size_t startIndex, size_t frameCount)
+	void CubicDistortion::TransferFunction(float* pSamples, size_t sampleCount) const
 	{
-		const size_t endIndex = startIndex + frameCount;
-		const AudioFormatInfo& formatInfo = outputBuffer.FormatInfo();
-
-		for (size_t i = startIndex; i < endIndex; ++i)
+		const float factor = this->factor;
+		for (size_t i = 0; i < sampleCount; ++i)
 		{
-			for (size_t j = 0; j < formatInfo.channelLayout.count; ++j)
-			{
-				double fltSample = this->factor * HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(outputBuffer[i][j]);
-				fltSample -= fltSample * fltSample * fltSample / 3.0;
-
-				outputBuffer[i][j] = HEPH_AUDIO_SAMPLE_FROM_IEEE_FLT(HEPH_MATH_MIN(HEPH_MATH_MAX(fltSample, -1.0), 1.0));
-			}
+			float fltSample = factor * pSamples[i];
+			fltSample -= fltSample * fltSample * fltSample * (1.0f / 3.0f);
+			pSamples[i] = HEPH_MATH_MIN(HEPH_MATH_MAX(fltSample, -1.0f), 1.0f);
 		}
 	}
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "AudioEffects/DoubleBufferedAudioEffect.h"
 #include "Exceptions/InvalidArgumentException.h"
+#include <cstring>
+#include <utility>
 
 using namespace Heph;
 
@@ -9,6 +11,8 @@ namespace HephAudio
 
 	void DoubleBufferedAudioEffect::Process(AudioBuffer& buffer, size_t startIndex, size_t frameCount)
 	{
+		ProcessTimer processTimer(*this);
+
 		if (startIndex > buffer.FrameCount())
 		{
 			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "startIndex out of bounds."));
@@ -19,16 +23,55 @@ namespace HephAudio
 			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "endIndex exceeds the buffer's frame count."));
 		}
 
+		if (!this->CanReuseOutputBuffer(buffer, startIndex, frameCount))
+		{
+			AudioBuffer outputBuffer = this->CreateOutputBuffer(buffer, startIndex, frameCount);
+			this->InitializeOutputBuffer(buffer, outputBuffer, startIndex, frameCount);
+
+			if (this->threadCount == 1)
+				this->ProcessST(buffer, outputBuffer, startIndex, frameCount);
+			else
+				this->ProcessMT(buffer, outputBuffer, startIndex, frameCount);
+
+			buffer = std::move(outputBuffer);
+			return;
+		}
+
+		if (frameCount == 0)
+		{
+			return;
+		}
+
+		// the frames before startIndex are allocated so the effects can use the same indices as the input buffer,
+		// but only the processed range is initialized and copied back.
 		const AudioFormatInfo& formatInfo = buffer.FormatInfo();
-		AudioBuffer outputBuffer = this->CreateOutputBuffer(buffer, startIndex, frameCount);
-		this->InitializeOutputBuffer(buffer, outputBuffer, startIndex, frameCount);
+		const size_t endIndex = startIndex + frameCount;
+		const size_t channelCount = formatInfo.channelLayout.count;
+		if (this->outputBuffer.FrameCount() != endIndex || this->outputBuffer.FormatInfo() != formatInfo)
+		{
+			this->outputBuffer = AudioBuffer(endIndex, formatInfo.channelLayout, formatInfo.sampleRate, BufferFlags::AllocUninitialized);
+		}
+
+		heph_audio_sample_t* const pRange = this->outputBuffer.begin() + startIndex * channelCount;
+		const size_t rangeSize = frameCount * channelCount * sizeof(heph_audio_sample_t);
+		memset(pRange, 0, rangeSize);
 
 		if (this->threadCount == 1)
-			this->ProcessST(buffer, outputBuffer, startIndex, frameCount);
+			this->ProcessST(buffer, this->outputBuffer, startIndex, frameCount);
 		else
-			this->ProcessMT(buffer, outputBuffer, startIndex, frameCount);
+			this->ProcessMT(buffer, this->outputBuffer, startIndex, frameCount);
+
+		memcpy(buffer.begin() + startIndex * channelCount, pRange, rangeSize);
+	}
+
+	void DoubleBufferedAudioEffect::ResetInternalState()
+	{
+		this->outputBuffer.Release();
+	}
 
-		buffer = std::move(outputBuffer);
+	bool DoubleBufferedAudioEffect::CanReuseOutputBuffer(const AudioBuffer& inputBuffer, size_t, size_t frameCount) const
+	{
+		return this->CalculateOutputFrameCount(frameCount, inputBuffer.FormatInfo()) == frameCount;
 	}
 
 	AudioBuffer DoubleBufferedAudioEffect::CreateOutputBuffer(const AudioBuffer& inputBuffer, size_t startIndex, size_t frameCount) const
@@ -44,20 +87,28 @@ namespace HephAudio
 	{
 		const size_t iFrameCount = inputBuffer.FrameCount();
 		const size_t endIndex = startIndex + frameCount;
-		const AudioFormatInfo& iFormatInfo = inputBuffer.FormatInfo();
+		const size_t channelCount = inputBuffer.FormatInfo().channelLayout.count;
+		const size_t resultPadding = startIndex + this->CalculateOutputFrameCount(frameCount, inputBuffer.FormatInfo());
 
-		outputBuffer.Reset();
+		if (outputBuffer.FormatInfo().channelLayout.count != channelCount || outputBuffer.FrameCount() != resultPadding + (iFrameCount - endIndex))
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "output buffer does not match the input buffer."));
+		}
 
 		if (startIndex > 0)
 		{
-			outputBuffer.Replace(inputBuffer, 0, startIndex);
+			memcpy(outputBuffer.begin(), inputBuffer.begin(), startIndex * channelCount * sizeof(heph_audio_sample_t));
+		}
+
+		// the processed range is cleared for the effects that accumulate their output.
+		if (resultPadding > startIndex)
+		{
+			memset(outputBuffer.begin() + startIndex * channelCount, 0, (resultPadding - startIndex) * channelCount * sizeof(heph_audio_sample_t));
 		}
 
 		if (endIndex < iFrameCount)
 		{
-			const size_t resultPadding = startIndex + this->CalculateOutputFrameCount(frameCount, iFormatInfo);
-			const AudioBuffer temp = inputBuffer.SubBuffer(endIndex, iFrameCount - endIndex);
-			outputBuffer.Replace(temp, resultPadding, temp.FrameCount());
+			memcpy(outputBuffer.begin() + resultPadding * channelCount, inputBuffer.begin() + endIndex * channelCount, (iFrameCount - endIndex) * channelCount * sizeof(heph_audio_sample_t));
 		}
 	}
 }
\ No newline at end of file
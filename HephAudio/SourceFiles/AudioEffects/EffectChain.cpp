@@ -0,0 +1,311 @@
+#include "AudioEffects/EffectChain.h"
+#include "Exceptions/InvalidArgumentException.h"
+#include "HephMath.h"
+#include <cstring>
+
+using namespace Heph;
+
+namespace HephAudio
+{
+	EffectChain::EffectChain() : AudioEffect(), blockFrameCount(HEPHAUDIO_EFFECT_CHAIN_DEFAULT_BLOCK_FRAME_COUNT) {}
+
+	EffectChain::EffectChain(const std::initializer_list<std::shared_ptr<AudioEffect>>& effects) : EffectChain()
+	{
+		for (const std::shared_ptr<AudioEffect>& pEffect : effects)
+		{
+			this->AddEffect(pEffect);
+		}
+	}
+
+	EffectChain::EffectChain(const std::vector<std::shared_ptr<AudioEffect>>& effects) : EffectChain()
+	{
+		for (const std::shared_ptr<AudioEffect>& pEffect : effects)
+		{
+			this->AddEffect(pEffect);
+		}
+	}
+
+	std::string EffectChain::Name() const
+	{
+		return "Effect Chain";
+	}
+
+	bool EffectChain::HasMTSupport() const
+	{
+		return false;
+	}
+
+	bool EffectChain::HasRTSupport() const
+	{
+		for (const std::shared_ptr<AudioEffect>& pEffect : this->effects)
+		{
+			if (!pEffect->HasRTSupport())
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	size_t EffectChain::CalculateRequiredFrameCount(size_t outputFrameCount, const AudioFormatInfo& formatInfo) const
+	{
+		for (size_t i = this->effects.size(); i > 0; --i)
+		{
+			outputFrameCount = this->effects[i - 1]->CalculateRequiredFrameCount(outputFrameCount, formatInfo);
+		}
+		return outputFrameCount;
+	}
+
+	size_t EffectChain::CalculateOutputFrameCount(size_t inputFrameCount, const AudioFormatInfo& formatInfo) const
+	{
+		for (const std::shared_ptr<AudioEffect>& pEffect : this->effects)
+		{
+			inputFrameCount = pEffect->CalculateOutputFrameCount(inputFrameCount, formatInfo);
+		}
+		return inputFrameCount;
+	}
+
+	size_t EffectChain::CalculateAdvanceSize(size_t renderFrameCount, const AudioFormatInfo& formatInfo) const
+	{
+		for (size_t i = this->effects.size(); i > 0; --i)
+		{
+			renderFrameCount = this->effects[i - 1]->CalculateAdvanceSize(renderFrameCount, formatInfo);
+		}
+		return renderFrameCount;
+	}
+
+	void EffectChain::ResetInternalState()
+	{
+		for (const std::shared_ptr<AudioEffect>& pEffect : this->effects)
+		{
+			pEffect->ResetInternalState();
+		}
+		this->blockBuffer.Release();
+	}
+
+	void EffectChain::Process(AudioBuffer& buffer, size_t startIndex, size_t frameCount)
+	{
+		ProcessTimer processTimer(*this);
+
+		if (startIndex > buffer.FrameCount())
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "startIndex out of bounds."));
+		}
+
+		if (startIndex + frameCount > buffer.FrameCount())
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "endIndex exceeds the buffer's frame count."));
+		}
+
+		size_t firstIndex = 0;
+		while (firstIndex < this->effects.size())
+		{
+			const std::shared_ptr<AudioEffect>& pEffect = this->effects[firstIndex];
+			if (!pEffect->HasRTSupport())
+			{
+				const AudioFormatInfo formatInfo = buffer.FormatInfo();
+				pEffect->Process(buffer, startIndex, frameCount);
+				frameCount = pEffect->CalculateOutputFrameCount(frameCount, formatInfo);
+				frameCount = HEPH_MATH_MIN(frameCount, buffer.FrameCount() - startIndex);
+				firstIndex++;
+				continue;
+			}
+
+			size_t endIndex = firstIndex + 1;
+			while (endIndex < this->effects.size() && this->effects[endIndex]->HasRTSupport())
+			{
+				endIndex++;
+			}
+
+			frameCount = this->ProcessBlocks(buffer, startIndex, frameCount, firstIndex, endIndex);
+			firstIndex = endIndex;
+		}
+	}
+
+	const std::vector<std::shared_ptr<AudioEffect>>& EffectChain::GetEffects() const
+	{
+		return this->effects;
+	}
+
+	void EffectChain::AddEffect(std::shared_ptr<AudioEffect> pEffect)
+	{
+		this->InsertEffect(this->effects.size(), std::move(pEffect));
+	}
+
+	void EffectChain::InsertEffect(size_t index, std::shared_ptr<AudioEffect> pEffect)
+	{
+		if (pEffect == nullptr)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "Effect cannot be null."));
+		}
+
+		if (pEffect.get() == this)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "Chain cannot contain itself."));
+		}
+
+		if (index > this->effects.size())
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "index out of bounds."));
+		}
+
+		this->effects.insert(this->effects.begin() + index, std::move(pEffect));
+	}
+
+	void EffectChain::RemoveEffect(size_t index)
+	{
+		if (index >= this->effects.size())
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "index out of bounds."));
+		}
+
+		this->effects.erase(this->effects.begin() + index);
+	}
+
+	size_t EffectChain::GetBlockFrameCount() const
+	{
+		return this->blockFrameCount;
+	}
+
+	void EffectChain::SetBlockFrameCount(size_t blockFrameCount)
+	{
+		if (blockFrameCount == 0)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "blockFrameCount must be greater than zero."));
+		}
+
+		this->blockFrameCount = blockFrameCount;
+	}
+
+	void EffectChain::ProcessST(const AudioBuffer& inputBuffer, AudioBuffer& outputBuffer, size_t startIndex, size_t frameCount)
+	{
+		if (&inputBuffer != &outputBuffer)
+		{
+			outputBuffer = inputBuffer;
+		}
+		this->Process(outputBuffer, startIndex, frameCount);
+	}
+
+	size_t EffectChain::ProcessBlocks(AudioBuffer& buffer, size_t startIndex, size_t frameCount, size_t firstIndex, size_t endIndex)
+	{
+		const AudioFormatInfo formatInfo = buffer.FormatInfo();
+		const size_t channelCount = formatInfo.channelLayout.count;
+		const size_t inputEndIndex = startIndex + frameCount;
+		const bool isInPlace = this->KeepsFrameCount(firstIndex, endIndex, formatInfo);
+
+		size_t outputFrameCount = frameCount;
+		for (size_t i = firstIndex; i < endIndex; ++i)
+		{
+			outputFrameCount = this->effects[i]->CalculateOutputFrameCount(outputFrameCount, formatInfo);
+		}
+
+		// created once a block can not be written back to where it was read from.
+		AudioBuffer outputBuffer;
+		size_t readIndex = startIndex;
+		size_t writtenFrameCount = 0;
+		while (writtenFrameCount < outputFrameCount)
+		{
+			const size_t desiredFrameCount = HEPH_MATH_MIN(this->blockFrameCount, outputFrameCount - writtenFrameCount);
+			size_t requiredFrameCount = desiredFrameCount;
+			size_t advanceSize = desiredFrameCount;
+			for (size_t i = endIndex; i > firstIndex; --i)
+			{
+				requiredFrameCount = this->effects[i - 1]->CalculateRequiredFrameCount(requiredFrameCount, formatInfo);
+				advanceSize = this->effects[i - 1]->CalculateAdvanceSize(advanceSize, formatInfo);
+			}
+
+			if (this->blockBuffer.FrameCount() != requiredFrameCount || this->blockBuffer.FormatInfo() != formatInfo)
+			{
+				this->blockBuffer = AudioBuffer(requiredFrameCount, formatInfo.channelLayout, formatInfo.sampleRate, BufferFlags::AllocUninitialized);
+			}
+
+			// frames past the end of the range are silent.
+			const size_t availableFrameCount = (readIndex < inputEndIndex) ? HEPH_MATH_MIN(requiredFrameCount, inputEndIndex - readIndex) : 0;
+			if (availableFrameCount > 0)
+			{
+				memcpy(this->blockBuffer.begin(), buffer.begin() + readIndex * channelCount, availableFrameCount * channelCount * sizeof(heph_audio_sample_t));
+			}
+			if (availableFrameCount < requiredFrameCount)
+			{
+				memset(this->blockBuffer.begin() + availableFrameCount * channelCount, 0, (requiredFrameCount - availableFrameCount) * channelCount * sizeof(heph_audio_sample_t));
+			}
+
+			for (size_t i = firstIndex; i < endIndex; ++i)
+			{
+				this->effects[i]->Process(this->blockBuffer);
+			}
+
+			const AudioFormatInfo& blockFormatInfo = this->blockBuffer.FormatInfo();
+			const size_t producedFrameCount = HEPH_MATH_MIN(desiredFrameCount, this->blockBuffer.FrameCount());
+			if (producedFrameCount == 0)
+			{
+				break;
+			}
+
+			if (isInPlace && outputBuffer.FrameCount() == 0 && producedFrameCount == desiredFrameCount && blockFormatInfo == formatInfo)
+			{
+				memcpy(buffer.begin() + (startIndex + writtenFrameCount) * channelCount, this->blockBuffer.begin(), producedFrameCount * channelCount * sizeof(heph_audio_sample_t));
+			}
+			else
+			{
+				if (outputBuffer.FrameCount() == 0)
+				{
+					outputBuffer = AudioBuffer(outputFrameCount, blockFormatInfo.channelLayout, blockFormatInfo.sampleRate);
+					if (writtenFrameCount > 0)
+					{
+						memcpy(outputBuffer.begin(), buffer.begin() + startIndex * channelCount, writtenFrameCount * channelCount * sizeof(heph_audio_sample_t));
+					}
+				}
+
+				if (blockFormatInfo.channelLayout.count != outputBuffer.FormatInfo().channelLayout.count)
+				{
+					HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "effects changed the channel layout between the blocks."));
+				}
+				memcpy(outputBuffer.begin() + writtenFrameCount * blockFormatInfo.channelLayout.count, this->blockBuffer.begin(), producedFrameCount * blockFormatInfo.channelLayout.count * sizeof(heph_audio_sample_t));
+			}
+
+			writtenFrameCount += producedFrameCount;
+			readIndex += advanceSize;
+		}
+
+		if (outputBuffer.FrameCount() > 0)
+		{
+			if (startIndex == 0 && inputEndIndex == buffer.FrameCount())
+			{
+				buffer = std::move(outputBuffer);
+			}
+			else
+			{
+				const AudioFormatInfo& outputFormatInfo = outputBuffer.FormatInfo();
+				if (outputFormatInfo.channelLayout.count != channelCount)
+				{
+					HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "effects that change the channel layout must be applied to the whole buffer."));
+				}
+
+				const size_t remainingFrameCount = buffer.FrameCount() - inputEndIndex;
+				AudioBuffer resultBuffer(startIndex + outputFrameCount + remainingFrameCount, outputFormatInfo.channelLayout, outputFormatInfo.sampleRate, BufferFlags::AllocUninitialized);
+				memcpy(resultBuffer.begin(), buffer.begin(), startIndex * channelCount * sizeof(heph_audio_sample_t));
+				memcpy(resultBuffer.begin() + startIndex * channelCount, outputBuffer.begin(), outputFrameCount * channelCount * sizeof(heph_audio_sample_t));
+				memcpy(resultBuffer.begin() + (startIndex + outputFrameCount) * channelCount, buffer.begin() + inputEndIndex * channelCount, remainingFrameCount * channelCount * sizeof(heph_audio_sample_t));
+				buffer = std::move(resultBuffer);
+			}
+		}
+
+		return outputFrameCount;
+	}
+
+	bool EffectChain::KeepsFrameCount(size_t firstIndex, size_t endIndex, const AudioFormatInfo& formatInfo) const
+	{
+		for (size_t i = firstIndex; i < endIndex; ++i)
+		{
+			const AudioEffect& effect = *this->effects[i];
+			if (effect.CalculateRequiredFrameCount(this->blockFrameCount, formatInfo) != this->blockFrameCount ||
+				effect.CalculateAdvanceSize(this->blockFrameCount, formatInfo) != this->blockFrameCount ||
+				effect.CalculateOutputFrameCount(this->blockFrameCount, formatInfo) != this->blockFrameCount)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
\ No newline at end of file
@@ -95,11 +95,15 @@ namespace HephAudio
 		const size_t nyquistBin = fftSize / 2;
 		const double overflowFactor = 1.0 / this->CalculateMaxNumberOfOverlaps();
 
+		SplitComplexBuffer channel(fftSize);
+		double* const pReal = channel.Real();
+		double* const pImag = channel.Imag();
+
 		for (int64_t i = firstWindowStartIndex; i < endIndex; i += this->hopSize)
 		{
 			for (size_t j = 0; j < formatInfo.channelLayout.count; ++j)
 			{
-				ComplexBuffer channel(fftSize);
+				channel.Reset();
 				for (int64_t k = 0, l = i;
 					(k < (int64_t)fftSize) && (l < (int64_t)inputBuffer.FrameCount());
 					++k, ++l)
@@ -108,12 +112,12 @@ namespace HephAudio
 					{
 						if ((-l) <= (int64_t)this->pastSamples.FrameCount())
 						{
-							channel[k].real = this->pastSamples[this->pastSamples.FrameCount() + l][j] * this->wnd[k];
+							pReal[k] = this->pastSamples[this->pastSamples.FrameCount() + l][j] * this->wnd[k];
 						}
 					}
 					else
 					{
-						channel[k].real = inputBuffer[l][j] * this->wnd[k];
+						pReal[k] = inputBuffer[l][j] * this->wnd[k];
 					}
 				}
 
@@ -135,8 +139,10 @@ namespace HephAudio
 
 					for (size_t k = startBin; k < endBin; ++k)
 					{
-						channel[k] *= range.volume;
-						channel[fftSize - k - 1] = channel[k].Conjugate();
+						pReal[k] *= range.volume;
+						pImag[k] *= range.volume;
+						pReal[fftSize - k - 1] = pReal[k];
+						pImag[fftSize - k - 1] = -pImag[k];
 					}
 				}
 				Fourier::IFFT(channel, false);
@@ -147,7 +153,7 @@ namespace HephAudio
 				{
 					if (l >= (int64_t)startIndex)
 					{
-						outputBuffer[l][j] += channel[k].real * overflowFactor * this->wnd[k] / fftSize;
+						outputBuffer[l][j] += pReal[k] * overflowFactor * this->wnd[k] / fftSize;
 					}
 				}
 			}
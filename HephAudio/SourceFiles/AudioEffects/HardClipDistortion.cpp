@@ -1,5 +1,6 @@
 #include "AudioEffects/HardClipDistortion.h"
 #include "Exceptions/InvalidArgumentException.h"
+#include "HephMath.h"
 
 using namespace Heph;
 
@@ -7,7 +8,7 @@ namespace HephAudio
 {
 	HardClipDistortion::HardClipDistortion() : HardClipDistortion(0) {}
 
-	HardClipDistortion::HardClipDistortion(double clippingLevel) : AudioEffect()
+	HardClipDistortion::HardClipDistortion(double clippingLevel) : WaveshaperEffect()
 	{
 		this->SetClippingLevel(clippingLevel);
 	}
@@ -30,27 +31,15 @@ namespace HephAudio
 		}
 
 		this->clippingLevel = HephAudio::DecibelToGain(clippingLevel) * HEPH_AUDIO_SAMPLE_MAX;
+		this->UpdateLookupTable();
 	}
 
-	void HardClipDistortion::ProcessST(const AudioBuffer& inputBuffer, AudioBuffer& outputBuffer, size_t startIndex, size_t frameCount)
+	void HardClipDistortion::TransferFunction(float* pSamples, size_t sampleCount) const
 	{
-		const size_t endIndex = startIndex + frameCount;
-		const AudioFormatInfo& formatInfo = outputBuffer.FormatInfo();
-
-		for (size_t i = startIndex; i < endIndex; ++i)
+		const float clippingLevel = HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(this->clippingLevel);
+		for (size_t i = 0; i < sampleCount; ++i)
 		{
-			for (size_t j = 0; j < formatInfo.channelLayout.count; ++j)
-			{
-				heph_audio_sample_t& sample = outputBuffer[i][j];
-				if (sample > this->clippingLevel)
-				{
-					sample = this->clippingLevel;
-				}
-				else if (sample < -this->clippingLevel)
-				{
-					sample = -this->clippingLevel;
-				}
-			}
+			pSamples[i] = HEPH_MATH_MIN(HEPH_MATH_MAX(pSamples[i], -clippingLevel), clippingLevel);
 		}
 	}
 }
\ No newline at end of file
@@ -15,6 +15,7 @@ namespace HephAudio
 
 	void ModulationEffect::ResetInternalState()
 	{
+		DoubleBufferedAudioEffect::ResetInternalState();
 		this->lfoIndex = 0;
 	}
 
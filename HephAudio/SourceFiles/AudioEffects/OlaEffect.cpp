@@ -25,6 +25,7 @@ namespace HephAudio
 
 	void OlaEffect::ResetInternalState()
 	{
+		DoubleBufferedAudioEffect::ResetInternalState();
 		this->currentIndex = 0;
 		this->pastSamples.Release();
 	}
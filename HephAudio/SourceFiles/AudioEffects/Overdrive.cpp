@@ -1,6 +1,6 @@
 #include "AudioEffects/Overdrive.h"
 #include "Exceptions/InvalidArgumentException.h"
-#include <cmath>
+#include "FastMath.h"
 
 using namespace Heph;
 
@@ -8,7 +8,7 @@ namespace HephAudio
 {
 	Overdrive::Overdrive() : Overdrive(0) {}
 
-	Overdrive::Overdrive(double drive) : AudioEffect()
+	Overdrive::Overdrive(double drive) : WaveshaperEffect()
 	{
 		this->SetDrive(drive);
 	}
@@ -31,20 +31,16 @@ namespace HephAudio
 		}
 
 		this->drive = drive + 1;
+		this->UpdateLookupTable();
 	}
 
-	void Overdrive::ProcessST(const AudioBuffer& inputBuffer, AudioBuffer& outputBuffer, size_t startIndex, size_t frameCount)
+	void Overdrive::TransferFunction(float* pSamples, size_t sampleCount) const
 	{
-		const size_t endIndex = startIndex + frameCount;
-		const AudioFormatInfo& formatInfo = outputBuffer.FormatInfo();
-
-		for (size_t i = startIndex; i < endIndex; ++i)
+		const float drive = this->drive;
+		for (size_t i = 0; i < sampleCount; ++i)
 		{
-			for (size_t j = 0; j < formatInfo.channelLayout.count; ++j)
-			{
-				const double fltSample = tanh(this->drive * sin(HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(outputBuffer[i][j])));
-				outputBuffer[i][j] = HEPH_AUDIO_SAMPLE_FROM_IEEE_FLT(HEPH_MATH_MIN(HEPH_MATH_MAX(fltSample, -1.0), 1.0));
-			}
+			const float fltSample = FastMath::Tanh(drive * FastMath::Sin(pSamples[i]));
+			pSamples[i] = HEPH_MATH_MIN(HEPH_MATH_MAX(fltSample, -1.0f), 1.0f);
 		}
 	}
 }
\ No newline at end of file
@@ -36,7 +36,8 @@ namespace HephAudio
 		const size_t endIndex = startIndex + frameCount;
 		const AudioFormatInfo& formatInfo = inputBuffer.FormatInfo();
 		const int64_t wndSize = this->wnd.Size();
-		const int64_t ioFrameCount = outputBuffer.FrameCount() + this->currentIndex;
+		const int64_t inputFrameCount = inputBuffer.FrameCount() + this->currentIndex;
+		const int64_t outputFrameCount = outputBuffer.FrameCount() + this->currentIndex;
 		const size_t maxNumberOfOverlaps = this->CalculateMaxNumberOfOverlaps();
 		const double overflowFactor = 1.0 / maxNumberOfOverlaps;
 
@@ -54,7 +55,7 @@ namespace HephAudio
 			{
 				double m = i;
 				for (size_t k = 0, l = i;
-					(k < wndSize) && (l < ioFrameCount) && (m < ioFrameCount);
+					(k < wndSize) && (l < outputFrameCount) && (m < inputFrameCount);
 					++k, ++l, m += this->pitchFactor
 					)
 				{
@@ -79,6 +79,11 @@ namespace HephAudio
 		}
 	}
 
+	bool Resampler::CanReuseOutputBuffer(const AudioBuffer& inputBuffer, size_t startIndex, size_t frameCount) const
+	{
+		return inputBuffer.FormatInfo().sampleRate == this->outputSampleRate && DoubleBufferedAudioEffect::CanReuseOutputBuffer(inputBuffer, startIndex, frameCount);
+	}
+
 	AudioBuffer Resampler::CreateOutputBuffer(const AudioBuffer& inputBuffer, size_t startIndex, size_t frameCount) const
 	{
 		const AudioFormatInfo& formatInfo = inputBuffer.FormatInfo();
@@ -67,6 +67,8 @@ namespace HephAudio
 			const size_t wndSize = this->GetWindowSize();
 			this->transferFunctions[0].Resize(wndSize);
 			this->transferFunctions[1].Resize(wndSize);
+			this->transferFunctions[0].Reset();
+			this->transferFunctions[1].Reset();
 
 			float cartesian[3] = { -this->azimuth, this->elevation, this->pEasy->lookup->radius_min };
 			mysofa_s2c(cartesian);
@@ -80,8 +82,8 @@ namespace HephAudio
 			{
 				for (size_t i = 0; i < this->hrtfSize; ++i)
 				{
-					this->transferFunctions[0][i] = Complex(leftIR[i], 0);
-					this->transferFunctions[1][i] = Complex(rightIR[i], 0);
+					this->transferFunctions[0].Real()[i] = leftIR[i];
+					this->transferFunctions[1].Real()[i] = rightIR[i];
 				}
 			}
 			else
@@ -90,8 +92,8 @@ namespace HephAudio
 				double j = 0;
 				for (size_t i = 0; i < wndSize; ++i, j += ratio)
 				{
-					this->transferFunctions[0][i] = Complex(leftIR[j] * (1.0 - ratio) + leftIR[j + 1] * ratio, 0);
-					this->transferFunctions[1][i] = Complex(rightIR[j] * (1.0 - ratio) + rightIR[j + 1] * ratio, 0);
+					this->transferFunctions[0].Real()[i] = leftIR[j] * (1.0 - ratio) + leftIR[j + 1] * ratio;
+					this->transferFunctions[1].Real()[i] = rightIR[j] * (1.0 - ratio) + rightIR[j + 1] * ratio;
 				}
 			}
 
@@ -221,11 +223,14 @@ namespace HephAudio
 		const size_t nyquistBin = fftSize / 2;
 		const double overflowFactor = 1.0 / this->CalculateMaxNumberOfOverlaps();
 
+		SplitComplexBuffer channel(fftSize);
+		double* const pReal = channel.Real();
+
 		for (int64_t i = firstWindowStartIndex; i < endIndex; i += this->hopSize)
 		{
 			for (size_t j = 0; j < formatInfo.channelLayout.count; ++j)
 			{
-				ComplexBuffer channel(fftSize);
+				channel.Reset();
 				for (int64_t k = 0, l = i;
 					(k < (int64_t)fftSize) && (l < (int64_t)inputBuffer.FrameCount());
 					++k, ++l)
@@ -234,17 +239,17 @@ namespace HephAudio
 					{
 						if ((-l) <= (int64_t)this->pastSamples.FrameCount())
 						{
-							channel[k].real = this->pastSamples[this->pastSamples.FrameCount() + l][j] * this->wnd[k];
+							pReal[k] = this->pastSamples[this->pastSamples.FrameCount() + l][j] * this->wnd[k];
 						}
 					}
 					else
 					{
-						channel[k].real = inputBuffer[l][j] * this->wnd[k];
+						pReal[k] = inputBuffer[l][j] * this->wnd[k];
 					}
 				}
 
 				Fourier::FFT(channel);
-				channel *= this->transferFunctions[j];
+				channel.Multiply(this->transferFunctions[j]);
 				Fourier::IFFT(channel, false);
 
 				for (int64_t k = 0, l = i;
@@ -253,7 +258,7 @@ namespace HephAudio
 				{
 					if (l >= (int64_t)startIndex)
 					{
-						outputBuffer[l][j] += channel[k].real * overflowFactor * this->wnd[k] / fftSize;
+						outputBuffer[l][j] += pReal[k] * overflowFactor * this->wnd[k] / fftSize;
 					}
 				}
 			}
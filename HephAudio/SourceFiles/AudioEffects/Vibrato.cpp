@@ -29,6 +29,7 @@ namespace HephAudio
 
 	void Vibrato::ResetInternalState()
 	{
+		ModulationEffect::ResetInternalState();
 		this->pastSamples.Release();
 	}
 
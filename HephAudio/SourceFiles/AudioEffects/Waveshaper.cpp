@@ -0,0 +1,46 @@
+#include "AudioEffects/Waveshaper.h"
+#include "Exceptions/InvalidArgumentException.h"
+
+using namespace Heph;
+
+namespace HephAudio
+{
+	Waveshaper::Waveshaper() : Waveshaper([](double x) { return x; }) {}
+
+	Waveshaper::Waveshaper(const TransferFunctionType& transferFunction) : Waveshaper(transferFunction, HEPHAUDIO_WAVESHAPER_DEFAULT_TABLE_SIZE) {}
+
+	Waveshaper::Waveshaper(const TransferFunctionType& transferFunction, size_t tableSize) : WaveshaperEffect()
+	{
+		this->SetTransferFunction(transferFunction);
+		this->EnableLookupTable(tableSize);
+	}
+
+	std::string Waveshaper::Name() const
+	{
+		return "Waveshaper";
+	}
+
+	const Waveshaper::TransferFunctionType& Waveshaper::GetTransferFunction() const
+	{
+		return this->transferFunction;
+	}
+
+	void Waveshaper::SetTransferFunction(const TransferFunctionType& transferFunction)
+	{
+		if (!transferFunction)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "transferFunction must not be empty."));
+		}
+
+		this->transferFunction = transferFunction;
+		this->UpdateLookupTable();
+	}
+
+	void Waveshaper::TransferFunction(float* pSamples, size_t sampleCount) const
+	{
+		for (size_t i = 0; i < sampleCount; ++i)
+		{
+			pSamples[i] = this->transferFunction(pSamples[i]);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,279 @@
+#include "AudioEffects/WaveshaperEffect.h"
+#include "Exceptions/InvalidArgumentException.h"
+#include "HephMath.h"
+#include <cstring>
+#include <thread>
+
+#define WAVESHAPER_BLOCK_SIZE 64
+
+using namespace Heph;
+
+namespace HephAudio
+{
+	// allpass coefficients of the polyphase halfband stages, designed with the elliptic method.
+	// each stage only has to reject the images of the previous stage's passband, so the later stages are cheaper.
+	// 1x <-> 2x: 8 coefficients, transition band 0.04, ~99 dB rejection.
+	static const float STAGE0_COEFS[] = { 0.04063346092419326f, 0.1505051290226746f, 0.30075705599187408f, 0.46077450496145061f, 0.6095243148961883f, 0.73850384111885725f, 0.84922381039206607f, 0.9497427837050002f };
+	// 2x <-> 4x: 4 coefficients, transition band 0.255, ~118 dB rejection.
+	static const float STAGE1_COEFS[] = { 0.041893991997656171f, 0.16890348243995201f, 0.39056077292116592f, 0.74389574826847815f };
+	// 4x <-> 8x: 3 coefficients, transition band 0.38, ~136 dB rejection.
+	static const float STAGE2_COEFS[] = { 0.055593858748359169f, 0.24258395914834877f, 0.64625521634572047f };
+
+	static const float* const STAGE_COEFS[] = { STAGE0_COEFS, STAGE1_COEFS, STAGE2_COEFS };
+	static const size_t STAGE_COEF_COUNTS[] = { 8, 4, 3 };
+
+	static inline void HalfbandProcessPair(const float* pCoefs, size_t coefCount, float* x, float* y, float& spl0, float& spl1)
+	{
+		for (size_t i = 0; i < coefCount; i += 2)
+		{
+			const float tmp0 = (spl0 - y[i]) * pCoefs[i] + x[i];
+			x[i] = spl0;
+			y[i] = tmp0;
+			spl0 = tmp0;
+
+			if (i + 1 < coefCount)
+			{
+				const float tmp1 = (spl1 - y[i + 1]) * pCoefs[i + 1] + x[i + 1];
+				x[i + 1] = spl1;
+				y[i + 1] = tmp1;
+				spl1 = tmp1;
+			}
+		}
+	}
+
+	// pOutput must have room for 2 * sampleCount samples, pInput and pOutput must not overlap.
+	static void HalfbandUpsample(size_t stageIndex, float* x, float* y, const float* pInput, float* pOutput, size_t sampleCount)
+	{
+		const float* pCoefs = STAGE_COEFS[stageIndex];
+		const size_t coefCount = STAGE_COEF_COUNTS[stageIndex];
+
+		for (size_t i = 0; i < sampleCount; ++i)
+		{
+			float even = pInput[i];
+			float odd = pInput[i];
+			HalfbandProcessPair(pCoefs, coefCount, x, y, even, odd);
+			pOutput[2 * i] = even;
+			pOutput[2 * i + 1] = odd;
+		}
+	}
+
+	// decimates 2 * sampleCount samples to sampleCount samples, can be done in-place.
+	static void HalfbandDownsample(size_t stageIndex, float* x, float* y, const float* pInput, float* pOutput, size_t sampleCount)
+	{
+		const float* pCoefs = STAGE_COEFS[stageIndex];
+		const size_t coefCount = STAGE_COEF_COUNTS[stageIndex];
+
+		for (size_t i = 0; i < sampleCount; ++i)
+		{
+			float spl0 = pInput[2 * i + 1];
+			float spl1 = pInput[2 * i];
+			HalfbandProcessPair(pCoefs, coefCount, x, y, spl0, spl1);
+			pOutput[i] = 0.5f * (spl0 + spl1);
+		}
+	}
+
+	WaveshaperEffect::WaveshaperEffect() : AudioEffect(), oversamplingFactor(1) {}
+
+	void WaveshaperEffect::ResetInternalState()
+	{
+		this->channelStates.clear();
+	}
+
+	size_t WaveshaperEffect::GetOversamplingFactor() const
+	{
+		return this->oversamplingFactor;
+	}
+
+	void WaveshaperEffect::SetOversamplingFactor(size_t oversamplingFactor)
+	{
+		if (oversamplingFactor != 1 && oversamplingFactor != 2 && oversamplingFactor != 4 && oversamplingFactor != HEPHAUDIO_WAVESHAPER_MAX_OVERSAMPLING_FACTOR)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "oversamplingFactor must be 1, 2, 4 or 8."));
+		}
+
+		if (this->oversamplingFactor != oversamplingFactor)
+		{
+			this->oversamplingFactor = oversamplingFactor;
+			this->ResetInternalState();
+		}
+	}
+
+	double WaveshaperEffect::GetLatency() const
+	{
+		const size_t stageCount = this->oversamplingFactor == 8 ? 3 : (this->oversamplingFactor == 4 ? 2 : (this->oversamplingFactor == 2 ? 1 : 0));
+		double latency = 0;
+
+		// each allpass section (a + z^-1) / (1 + a * z^-1) delays the low frequencies by (1 - a) / (1 + a) samples at the rate of its branch.
+		// upsampling and downsampling together delay by the sum of the sections of both branches, at the lower rate of the stage.
+		for (size_t s = 0; s < stageCount; ++s)
+		{
+			double stageLatency = 0;
+			for (size_t i = 0; i < STAGE_COEF_COUNTS[s]; ++i)
+			{
+				stageLatency += (1.0 - STAGE_COEFS[s][i]) / (1.0 + STAGE_COEFS[s][i]);
+			}
+			latency += stageLatency / (1 << s);
+		}
+
+		return latency;
+	}
+
+	bool WaveshaperEffect::IsLookupTableEnabled() const
+	{
+		return !this->lookupTable.empty();
+	}
+
+	void WaveshaperEffect::EnableLookupTable(size_t tableSize)
+	{
+		if (tableSize < 2)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "tableSize must be at least 2."));
+		}
+
+		this->lookupTable.resize(tableSize);
+		this->UpdateLookupTable();
+	}
+
+	void WaveshaperEffect::DisableLookupTable()
+	{
+		this->lookupTable.clear();
+		this->lookupTable.shrink_to_fit();
+	}
+
+	void WaveshaperEffect::UpdateLookupTable()
+	{
+		if (!this->lookupTable.empty())
+		{
+			const size_t tableSize = this->lookupTable.size();
+			for (size_t i = 0; i < tableSize; ++i)
+			{
+				this->lookupTable[i] = -1.0f + 2.0f * i / (tableSize - 1);
+			}
+			this->TransferFunction(this->lookupTable.data(), tableSize);
+		}
+	}
+
+	void WaveshaperEffect::ProcessChannel(AudioBuffer& buffer, size_t channelIndex, size_t startIndex, size_t frameCount)
+	{
+		float block[WAVESHAPER_BLOCK_SIZE * HEPHAUDIO_WAVESHAPER_MAX_OVERSAMPLING_FACTOR];
+		float tempBlock[WAVESHAPER_BLOCK_SIZE * HEPHAUDIO_WAVESHAPER_MAX_OVERSAMPLING_FACTOR / 2];
+		ChannelState& state = this->channelStates[channelIndex];
+		const size_t stageCount = this->oversamplingFactor == 8 ? 3 : (this->oversamplingFactor == 4 ? 2 : (this->oversamplingFactor == 2 ? 1 : 0));
+		const size_t endIndex = startIndex + frameCount;
+
+		for (size_t i = startIndex; i < endIndex; i += WAVESHAPER_BLOCK_SIZE)
+		{
+			const size_t blockFrameCount = HEPH_MATH_MIN(endIndex - i, (size_t)WAVESHAPER_BLOCK_SIZE);
+
+			for (size_t j = 0; j < blockFrameCount; ++j)
+			{
+				block[j] = HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(buffer[i + j][channelIndex]);
+			}
+
+			size_t sampleCount = blockFrameCount;
+			for (size_t s = 0; s < stageCount; ++s)
+			{
+				memcpy(tempBlock, block, sampleCount * sizeof(float));
+				HalfbandUpsample(s, state.upsampler[s].x, state.upsampler[s].y, tempBlock, block, sampleCount);
+				sampleCount *= 2;
+			}
+
+			this->ApplyTransferFunction(block, sampleCount);
+
+			for (size_t s = stageCount; s > 0; --s)
+			{
+				sampleCount /= 2;
+				HalfbandDownsample(s - 1, state.downsampler[s - 1].x, state.downsampler[s - 1].y, block, block, sampleCount);
+			}
+
+			for (size_t j = 0; j < blockFrameCount; ++j)
+			{
+				const float fltSample = HEPH_MATH_MIN(HEPH_MATH_MAX(block[j], -1.0f), 1.0f);
+				buffer[i + j][channelIndex] = HEPH_AUDIO_SAMPLE_FROM_IEEE_FLT(fltSample);
+			}
+		}
+	}
+
+	void WaveshaperEffect::ProcessST(const AudioBuffer&, AudioBuffer& outputBuffer, size_t startIndex, size_t frameCount)
+	{
+		const size_t channelCount = outputBuffer.FormatInfo().channelLayout.count;
+		this->UpdateChannelStates(channelCount);
+
+		for (size_t i = 0; i < channelCount; ++i)
+		{
+			this->ProcessChannel(outputBuffer, i, startIndex, frameCount);
+		}
+	}
+
+	void WaveshaperEffect::ProcessMT(const AudioBuffer& inputBuffer, AudioBuffer& outputBuffer, size_t startIndex, size_t frameCount)
+	{
+		const size_t channelCount = outputBuffer.FormatInfo().channelLayout.count;
+		this->UpdateChannelStates(channelCount);
+
+		if (this->oversamplingFactor == 1)
+		{
+			// transfer function is memoryless, split the frames.
+			AudioEffect::ProcessMT(inputBuffer, outputBuffer, startIndex, frameCount);
+			return;
+		}
+
+		// filters carry state between the frames, split the channels.
+		const size_t threadCount = HEPH_MATH_MIN(this->threadCount, channelCount);
+		std::vector<std::thread> threads(threadCount > 0 ? threadCount - 1 : 0);
+
+		for (size_t t = 0; t < threads.size(); ++t)
+		{
+			threads[t] = std::thread([this, &outputBuffer, t, threadCount, channelCount, startIndex, frameCount]()
+				{
+					for (size_t i = t; i < channelCount; i += threadCount)
+					{
+						this->ProcessChannel(outputBuffer, i, startIndex, frameCount);
+					}
+				});
+		}
+
+		for (size_t i = threads.size(); i < channelCount; i += threadCount)
+		{
+			this->ProcessChannel(outputBuffer, i, startIndex, frameCount);
+		}
+
+		for (std::thread& t : threads)
+		{
+			if (t.joinable())
+			{
+				t.join();
+			}
+		}
+	}
+
+	void WaveshaperEffect::ApplyTransferFunction(float* pSamples, size_t sampleCount) const
+	{
+		if (this->lookupTable.empty())
+		{
+			this->TransferFunction(pSamples, sampleCount);
+			return;
+		}
+
+		const float* pTable = this->lookupTable.data();
+		const size_t lastIndex = this->lookupTable.size() - 1;
+		const float scale = 0.5f * lastIndex;
+
+		for (size_t i = 0; i < sampleCount; ++i)
+		{
+			const float x = HEPH_MATH_MIN(HEPH_MATH_MAX(pSamples[i], -1.0f), 1.0f);
+			const float position = (x + 1.0f) * scale;
+			const size_t index = HEPH_MATH_MIN((size_t)position, lastIndex - 1);
+			const float fraction = position - index;
+			pSamples[i] = pTable[index] + (pTable[index + 1] - pTable[index]) * fraction;
+		}
+	}
+
+	void WaveshaperEffect::UpdateChannelStates(size_t channelCount)
+	{
+		if (this->channelStates.size() != channelCount)
+		{
+			this->channelStates.clear();
+			this->channelStates.resize(channelCount); // value initialization zeroes the filter states
+		}
+	}
+}
\ No newline at end of file
@@ -3,5 +3,5 @@
 namespace HephAudio
 {
 	AudioRenderEventArgs::AudioRenderEventArgs(Native::NativeAudio* pNativeAudio, AudioObject* pAudioObject, size_t renderFrameCount)
-		: AudioEventArgs(pNativeAudio), pAudioObject(pAudioObject), renderFrameCount(renderFrameCount) {}
+		: AudioEventArgs(pNativeAudio), pAudioObject(pAudioObject), renderFrameCount(renderFrameCount), isVirtual(false) {}
 }
\ No newline at end of file
@@ -14,7 +14,7 @@ namespace HephAudio
 {
 	AudioObject::AudioObject()
 		: id(Guid::GenerateNew()), filePath(""), name(""), 
-		isPaused(true), playCount(1), volume(1.0), frameIndex(0) 
+		isPaused(true), playCount(1), volume(1.0), priority(0), distance(0.0), maxDistance(std::numeric_limits<double>::infinity()), isVirtual(false), busName(""), frameIndex(0) 
 	{
 		this->OnRender = HEPHAUDIO_RENDER_HANDLER_DEFAULT;
 		this->OnFinishedPlaying = HEPHAUDIO_FINISHED_PLAYING_HANDLER_DEFAULT;
@@ -22,8 +22,9 @@ namespace HephAudio
 
 	AudioObject::AudioObject(AudioObject&& rhs) noexcept
 		: id(rhs.id), filePath(std::move(rhs.filePath)), name(std::move(rhs.name)), isPaused(rhs.isPaused),
-		playCount(rhs.playCount), volume(rhs.volume), buffer(std::move(rhs.buffer)), frameIndex(rhs.frameIndex),
-		OnRender(rhs.OnRender), OnFinishedPlaying(rhs.OnFinishedPlaying)
+		playCount(rhs.playCount), volume(rhs.volume), priority(rhs.priority), distance(rhs.distance), maxDistance(rhs.maxDistance), isVirtual(rhs.isVirtual), busName(std::move(rhs.busName)), sends(std::move(rhs.sends)), pEffectChain(std::move(rhs.pEffectChain)), buffer(std::move(rhs.buffer)), pSharedBuffer(std::move(rhs.pSharedBuffer)),
+		pCompressedBuffer(std::move(rhs.pCompressedBuffer)), pDecoderState(std::move(rhs.pDecoderState)), frameIndex(rhs.frameIndex),
+		OnRender(rhs.OnRender), OnFinishedPlaying(rhs.OnFinishedPlaying), renderStatistics(rhs.renderStatistics)
 	{
 		rhs.OnRender.ClearAll();
 		rhs.OnFinishedPlaying.ClearAll();
@@ -39,10 +40,21 @@ namespace HephAudio
 			this->isPaused = rhs.isPaused;
 			this->playCount = rhs.playCount;
 			this->volume = rhs.volume;
+			this->priority = rhs.priority;
+			this->distance = rhs.distance;
+			this->maxDistance = rhs.maxDistance;
+			this->isVirtual = rhs.isVirtual;
+			this->busName = std::move(rhs.busName);
+			this->sends = std::move(rhs.sends);
+			this->pEffectChain = std::move(rhs.pEffectChain);
 			this->buffer = std::move(rhs.buffer);
+			this->pSharedBuffer = std::move(rhs.pSharedBuffer);
+			this->pCompressedBuffer = std::move(rhs.pCompressedBuffer);
+			this->pDecoderState = std::move(rhs.pDecoderState);
 			this->frameIndex = rhs.frameIndex;
 			this->OnRender = rhs.OnRender;
 			this->OnFinishedPlaying = rhs.OnFinishedPlaying;
+			this->renderStatistics = rhs.renderStatistics;
 
 			rhs.OnRender.ClearAll();
 			rhs.OnFinishedPlaying.ClearAll();
@@ -51,9 +63,59 @@ namespace HephAudio
 		return *this;
 	}
 
+	const AudioBuffer& AudioObject::GetBuffer() const
+	{
+		return this->pSharedBuffer != nullptr ? *this->pSharedBuffer : this->buffer;
+	}
+
+	size_t AudioObject::GetFrameCount() const
+	{
+		return this->pCompressedBuffer != nullptr ? this->pCompressedBuffer->FrameCount() : this->GetBuffer().FrameCount();
+	}
+
+	AudioFormatInfo AudioObject::GetFormatInfo() const
+	{
+		return this->pCompressedBuffer != nullptr ? this->pCompressedBuffer->FormatInfo() : this->GetBuffer().FormatInfo();
+	}
+
+	AudioBuffer AudioObject::GetFrames(size_t frameIndex, size_t frameCount)
+	{
+		if (this->pCompressedBuffer == nullptr)
+		{
+			return this->GetBuffer().SubBuffer(frameIndex, frameCount);
+		}
+
+		if (this->pDecoderState == nullptr)
+		{
+			this->pDecoderState = this->pCompressedBuffer->AcquireDecoderState();
+		}
+
+		const AudioFormatInfo& formatInfo = this->pCompressedBuffer->FormatInfo();
+		AudioBuffer resultBuffer(frameCount, formatInfo.channelLayout, formatInfo.sampleRate, BufferFlags::AllocUninitialized);
+		this->pCompressedBuffer->Decode(frameIndex, frameCount, resultBuffer.begin(), *this->pDecoderState);
+		return resultBuffer;
+	}
+
+	AudioBuffer& AudioObject::DetachSharedBuffer()
+	{
+		if (this->pCompressedBuffer != nullptr)
+		{
+			this->buffer = this->pCompressedBuffer->Decode();
+			this->pCompressedBuffer = nullptr;
+			this->pDecoderState = nullptr;
+			this->pSharedBuffer = nullptr;
+		}
+		else if (this->pSharedBuffer != nullptr)
+		{
+			this->buffer = *this->pSharedBuffer;
+			this->pSharedBuffer = nullptr;
+		}
+		return this->buffer;
+	}
+
 	double AudioObject::GetPosition() const
 	{
-		const double position = ((double)this->frameIndex) / this->buffer.FrameCount();
+		const double position = ((double)this->frameIndex) / this->GetFrameCount();
 		return HEPH_MATH_MIN(position, 1.0);
 	}
 
@@ -63,7 +125,7 @@ namespace HephAudio
 		{
 			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "position must be in the range of [0, 1]"));
 		}
-		this->frameIndex = position * this->buffer.FrameCount();
+		this->frameIndex = position * this->GetFrameCount();
 	}
 
 	void AudioObject::Pause() 
@@ -81,9 +143,26 @@ namespace HephAudio
 		AudioRenderEventArgs* pArgs = (AudioRenderEventArgs*)eventParams.pArgs;
 		AudioRenderEventResult* pResult = (AudioRenderEventResult*)eventParams.pResult;
 
-		pResult->renderBuffer = pArgs->pAudioObject->buffer.SubBuffer(pArgs->pAudioObject->frameIndex, pArgs->renderFrameCount);
-		pArgs->pAudioObject->frameIndex += pArgs->renderFrameCount;
-		pResult->isFinishedPlaying = pArgs->pAudioObject->frameIndex >= pArgs->pAudioObject->buffer.FrameCount();
+		AudioObject* pAudioObject = pArgs->pAudioObject;
+		size_t requiredFrameCount = pArgs->renderFrameCount;
+		size_t advanceSize = pArgs->renderFrameCount;
+		if (pAudioObject->pEffectChain != nullptr)
+		{
+			const AudioFormatInfo inputFormat = pAudioObject->GetFormatInfo();
+			requiredFrameCount = pAudioObject->pEffectChain->CalculateRequiredFrameCount(pArgs->renderFrameCount, inputFormat);
+			advanceSize = pAudioObject->pEffectChain->CalculateAdvanceSize(pArgs->renderFrameCount, inputFormat);
+		}
+
+		if (!pArgs->isVirtual)
+		{
+			pResult->renderBuffer = pAudioObject->GetFrames(pAudioObject->frameIndex, requiredFrameCount);
+			if (pAudioObject->pEffectChain != nullptr)
+			{
+				pAudioObject->pEffectChain->Process(pResult->renderBuffer);
+			}
+		}
+		pAudioObject->frameIndex += advanceSize;
+		pResult->isFinishedPlaying = pArgs->pAudioObject->frameIndex >= pArgs->pAudioObject->GetFrameCount();
 	}
 
 	void AudioObject::MatchFormatRenderHandler(const Heph::EventParams& eventParams)
@@ -94,22 +173,37 @@ namespace HephAudio
 		AudioRenderEventArgs* pArgs = (AudioRenderEventArgs*)eventParams.pArgs;
 		AudioRenderEventResult* pResult = (AudioRenderEventResult*)eventParams.pResult;
 
-		const AudioFormatInfo& inputFormat = pArgs->pAudioObject->buffer.FormatInfo();
+		const AudioFormatInfo inputFormat = pArgs->pAudioObject->GetFormatInfo();
 		const AudioFormatInfo& renderFormat = pArgs->pNativeAudio->GetRenderFormat();
 
 		resampler.SetOutputSampleRate(renderFormat.sampleRate);
 		channelMapper.SetTargetLayout(renderFormat.channelLayout);
 
-		const size_t requiredFrameCount = resampler.CalculateRequiredFrameCount(pArgs->renderFrameCount, inputFormat);
-		const size_t advanceSize = resampler.CalculateAdvanceSize(pArgs->renderFrameCount, inputFormat);
+		size_t requiredFrameCount = resampler.CalculateRequiredFrameCount(pArgs->renderFrameCount, inputFormat);
+		size_t advanceSize = resampler.CalculateAdvanceSize(pArgs->renderFrameCount, inputFormat);
+
+		// the chain runs before the resampler, so it must output what the resampler requires.
+		EffectChain* pEffectChain = pArgs->pAudioObject->pEffectChain.get();
+		if (pEffectChain != nullptr)
+		{
+			requiredFrameCount = pEffectChain->CalculateRequiredFrameCount(requiredFrameCount, inputFormat);
+			advanceSize = pEffectChain->CalculateAdvanceSize(advanceSize, inputFormat);
+		}
 
-		pResult->renderBuffer = pArgs->pAudioObject->buffer.SubBuffer(pArgs->pAudioObject->frameIndex, requiredFrameCount);
-		
-		resampler.Process(pResult->renderBuffer);
-		channelMapper.Process(pResult->renderBuffer);
+		if (!pArgs->isVirtual)
+		{
+			pResult->renderBuffer = pArgs->pAudioObject->GetFrames(pArgs->pAudioObject->frameIndex, requiredFrameCount);
+
+			if (pEffectChain != nullptr)
+			{
+				pEffectChain->Process(pResult->renderBuffer);
+			}
+			resampler.Process(pResult->renderBuffer);
+			channelMapper.Process(pResult->renderBuffer);
+		}
 
 		pArgs->pAudioObject->frameIndex += advanceSize;
-		pResult->isFinishedPlaying = pArgs->pAudioObject->frameIndex >= pArgs->pAudioObject->buffer.FrameCount();
+		pResult->isFinishedPlaying = pArgs->pAudioObject->frameIndex >= pArgs->pAudioObject->GetFrameCount();
 	}
 
 	void AudioObject::DefaultFinishedPlayingHandler(const Heph::EventParams& eventParams)
@@ -85,6 +85,10 @@ namespace HephAudio
 		{
 			this->ChangeFile();
 		}
+		else
+		{
+			this->QueueNextFile();
+		}
 	}
 
 	void AudioPlaylist::Add(const std::vector<std::filesystem::path>& files)
@@ -96,6 +100,10 @@ namespace HephAudio
 			{
 				this->ChangeFile();
 			}
+			else
+			{
+				this->QueueNextFile();
+			}
 		}
 	}
 
@@ -112,6 +120,10 @@ namespace HephAudio
 		{
 			this->ChangeFile();
 		}
+		else
+		{
+			this->QueueNextFile();
+		}
 	}
 
 	void AudioPlaylist::Insert(const std::vector<std::filesystem::path>& files, size_t index)
@@ -129,6 +141,10 @@ namespace HephAudio
 			{
 				this->ChangeFile();
 			}
+			else
+			{
+				this->QueueNextFile();
+			}
 		}
 	}
 
@@ -144,6 +160,10 @@ namespace HephAudio
 		{
 			this->ChangeFile();
 		}
+		else
+		{
+			this->QueueNextFile();
+		}
 	}
 
 	void AudioPlaylist::Remove(size_t index, size_t count)
@@ -165,6 +185,10 @@ namespace HephAudio
 			{
 				this->ChangeFile();
 			}
+			else
+			{
+				this->QueueNextFile();
+			}
 		}
 	}
 
@@ -204,6 +228,17 @@ namespace HephAudio
 	{
 		this->files.clear();
 		this->stream.CloseFile();
+		this->stream.QueueNextFile("");
+	}
+
+	uint32_t AudioPlaylist::GetCrossfadeDuration() const
+	{
+		return this->stream.GetCrossfadeDuration();
+	}
+
+	void AudioPlaylist::SetCrossfadeDuration(uint32_t crossfadeDuration_ms)
+	{
+		this->stream.SetCrossfadeDuration(crossfadeDuration_ms);
 	}
 
 	void AudioPlaylist::ChangeFile()
@@ -211,6 +246,7 @@ namespace HephAudio
 		if (this->files.size() == 0)
 		{
 			this->stream.CloseFile();
+			this->stream.QueueNextFile("");
 			return;
 		}
 
@@ -227,7 +263,11 @@ namespace HephAudio
 				pAudioObject->OnFinishedPlaying = &AudioPlaylist::OnFinishedPlaying;
 				pAudioObject->OnRender.userEventArgs.Add(HEPHAUDIO_PLAYLIST_EVENT_USER_ARG_KEY, this);
 				pAudioObject->OnFinishedPlaying.userEventArgs.Add(HEPHAUDIO_PLAYLIST_EVENT_USER_ARG_KEY, this);
+				this->stream.OnNextFileStarted = &AudioPlaylist::OnNextFileStarted;
+				this->stream.OnNextFileStarted.userEventArgs.Add(HEPHAUDIO_PLAYLIST_EVENT_USER_ARG_KEY, this);
 			}
+
+			this->QueueNextFile();
 		}
 		catch (const Exception&)
 		{
@@ -242,9 +282,15 @@ namespace HephAudio
 
 			HEPHAUDIO_LOG("Could not play \"" + filePath.string() + "\", playlist finished.", HEPH_CL_WARNING);
 			this->stream.CloseFile();
+			this->stream.QueueNextFile("");
 		}
 	}
 
+	void AudioPlaylist::QueueNextFile()
+	{
+		this->stream.QueueNextFile(this->files.size() > 1 ? this->files[1] : "");
+	}
+
 	void AudioPlaylist::OnFinishedPlaying(const EventParams& eventParams)
 	{
 		AudioPlaylist* pPlaylist = (AudioPlaylist*)eventParams.userEventArgs[HEPHAUDIO_PLAYLIST_EVENT_USER_ARG_KEY];
@@ -254,4 +300,16 @@ namespace HephAudio
 			eventParams.pResult->isHandled = true;
 		}
 	}
+
+	void AudioPlaylist::OnNextFileStarted(const EventParams& eventParams)
+	{
+		// the stream already plays the next file, only the list is updated.
+		AudioPlaylist* pPlaylist = (AudioPlaylist*)eventParams.userEventArgs[HEPHAUDIO_PLAYLIST_EVENT_USER_ARG_KEY];
+		if (pPlaylist != nullptr && pPlaylist->files.size() > 0)
+		{
+			pPlaylist->files.erase(pPlaylist->files.begin());
+			pPlaylist->QueueNextFile();
+			eventParams.pResult->isHandled = true;
+		}
+	}
 }
\ No newline at end of file
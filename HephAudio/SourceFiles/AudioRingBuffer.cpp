@@ -0,0 +1,172 @@
+#include "AudioRingBuffer.h"
+#include "Exceptions/InvalidArgumentException.h"
+#include <cstring>
+
+using namespace Heph;
+
+namespace HephAudio
+{
+	AudioRingBuffer::AudioRingBuffer()
+		: buffer(), writeIndex(0), readIndex(0), overrunCount(0), droppedFrameCount(0) {}
+
+	AudioRingBuffer::AudioRingBuffer(size_t capacity_frame, const AudioChannelLayout& channelLayout, uint32_t sampleRate)
+		: buffer(capacity_frame, channelLayout, sampleRate), writeIndex(0), readIndex(0), overrunCount(0), droppedFrameCount(0) {}
+
+	void AudioRingBuffer::Reset(size_t capacity_frame, const AudioChannelLayout& channelLayout, uint32_t sampleRate)
+	{
+		if (this->buffer.FrameCount() != capacity_frame || this->buffer.FormatInfo().channelLayout != channelLayout)
+		{
+			this->buffer = AudioBuffer(capacity_frame, channelLayout, sampleRate);
+		}
+		else
+		{
+			this->buffer.SetSampleRate(sampleRate);
+		}
+
+		this->writeIndex.store(0, std::memory_order_relaxed);
+		this->readIndex.store(0, std::memory_order_relaxed);
+		this->overrunCount.store(0, std::memory_order_relaxed);
+		this->droppedFrameCount.store(0, std::memory_order_relaxed);
+	}
+
+	size_t AudioRingBuffer::Write(const heph_audio_sample_t* pFrames, size_t frameCount)
+	{
+		const size_t capacity = this->buffer.FrameCount();
+		const size_t channelCount = this->buffer.FormatInfo().channelLayout.count;
+		const uint64_t currentWriteIndex = this->writeIndex.load(std::memory_order_relaxed);
+		const uint64_t currentReadIndex = this->readIndex.load(std::memory_order_acquire);
+		const size_t writableFrameCount = capacity - (size_t)(currentWriteIndex - currentReadIndex);
+		const size_t framesToWrite = HEPH_MATH_MIN(frameCount, writableFrameCount);
+
+		if (framesToWrite < frameCount)
+		{
+			this->overrunCount.fetch_add(1, std::memory_order_relaxed);
+			this->droppedFrameCount.fetch_add(frameCount - framesToWrite, std::memory_order_relaxed);
+		}
+
+		if (framesToWrite > 0)
+		{
+			const size_t startFrame = currentWriteIndex % capacity;
+			const size_t firstPartFrameCount = HEPH_MATH_MIN(framesToWrite, capacity - startFrame);
+
+			(void)memcpy(this->buffer[startFrame], pFrames, firstPartFrameCount * channelCount * sizeof(heph_audio_sample_t));
+			if (firstPartFrameCount < framesToWrite)
+			{
+				(void)memcpy(this->buffer.begin(), pFrames + firstPartFrameCount * channelCount, (framesToWrite - firstPartFrameCount) * channelCount * sizeof(heph_audio_sample_t));
+			}
+
+			this->writeIndex.store(currentWriteIndex + framesToWrite, std::memory_order_release);
+		}
+
+		return framesToWrite;
+	}
+
+	size_t AudioRingBuffer::Write(const AudioBuffer& buffer)
+	{
+		if (buffer.FormatInfo().channelLayout.count != this->buffer.FormatInfo().channelLayout.count)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "Channel counts must be the same."));
+		}
+		return this->Write(buffer.begin(), buffer.FrameCount());
+	}
+
+	size_t AudioRingBuffer::Read(heph_audio_sample_t* pFrames, size_t frameCount)
+	{
+		const size_t capacity = this->buffer.FrameCount();
+		const size_t channelCount = this->buffer.FormatInfo().channelLayout.count;
+		const uint64_t currentReadIndex = this->readIndex.load(std::memory_order_relaxed);
+		const uint64_t currentWriteIndex = this->writeIndex.load(std::memory_order_acquire);
+		const size_t framesToRead = HEPH_MATH_MIN(frameCount, (size_t)(currentWriteIndex - currentReadIndex));
+
+		if (framesToRead > 0)
+		{
+			const size_t startFrame = currentReadIndex % capacity;
+			const size_t firstPartFrameCount = HEPH_MATH_MIN(framesToRead, capacity - startFrame);
+
+			(void)memcpy(pFrames, this->buffer[startFrame], firstPartFrameCount * channelCount * sizeof(heph_audio_sample_t));
+			if (firstPartFrameCount < framesToRead)
+			{
+				(void)memcpy(pFrames + firstPartFrameCount * channelCount, this->buffer.begin(), (framesToRead - firstPartFrameCount) * channelCount * sizeof(heph_audio_sample_t));
+			}
+
+			this->readIndex.store(currentReadIndex + framesToRead, std::memory_order_release);
+		}
+
+		return framesToRead;
+	}
+
+	size_t AudioRingBuffer::Read(AudioBuffer& buffer)
+	{
+		if (buffer.FormatInfo().channelLayout.count != this->buffer.FormatInfo().channelLayout.count)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "Channel counts must be the same."));
+		}
+		return this->Read(buffer.begin(), buffer.FrameCount());
+	}
+
+	size_t AudioRingBuffer::Skip(size_t frameCount)
+	{
+		const uint64_t currentReadIndex = this->readIndex.load(std::memory_order_relaxed);
+		const uint64_t currentWriteIndex = this->writeIndex.load(std::memory_order_acquire);
+		const size_t framesToSkip = HEPH_MATH_MIN(frameCount, (size_t)(currentWriteIndex - currentReadIndex));
+
+		this->readIndex.store(currentReadIndex + framesToSkip, std::memory_order_release);
+		return framesToSkip;
+	}
+
+	size_t AudioRingBuffer::GetWriteRegion(heph_audio_sample_t** ppFrames)
+	{
+		const size_t capacity = this->buffer.FrameCount();
+		const uint64_t currentWriteIndex = this->writeIndex.load(std::memory_order_relaxed);
+		const uint64_t currentReadIndex = this->readIndex.load(std::memory_order_acquire);
+		const size_t writableFrameCount = capacity - (size_t)(currentWriteIndex - currentReadIndex);
+
+		if (writableFrameCount == 0)
+		{
+			*ppFrames = nullptr;
+			return 0;
+		}
+
+		const size_t startFrame = currentWriteIndex % capacity;
+		*ppFrames = this->buffer[startFrame];
+		return HEPH_MATH_MIN(writableFrameCount, capacity - startFrame);
+	}
+
+	void AudioRingBuffer::CommitWrite(size_t frameCount)
+	{
+		const uint64_t currentWriteIndex = this->writeIndex.load(std::memory_order_relaxed);
+		this->writeIndex.store(currentWriteIndex + frameCount, std::memory_order_release);
+	}
+
+	size_t AudioRingBuffer::GetReadableFrameCount() const
+	{
+		const uint64_t currentReadIndex = this->readIndex.load(std::memory_order_acquire);
+		const uint64_t currentWriteIndex = this->writeIndex.load(std::memory_order_acquire);
+		return (size_t)(currentWriteIndex - currentReadIndex);
+	}
+
+	size_t AudioRingBuffer::GetWritableFrameCount() const
+	{
+		return this->buffer.FrameCount() - this->GetReadableFrameCount();
+	}
+
+	size_t AudioRingBuffer::GetCapacity() const
+	{
+		return this->buffer.FrameCount();
+	}
+
+	const AudioFormatInfo& AudioRingBuffer::FormatInfo() const
+	{
+		return this->buffer.FormatInfo();
+	}
+
+	uint64_t AudioRingBuffer::GetOverrunCount() const
+	{
+		return this->overrunCount.load(std::memory_order_relaxed);
+	}
+
+	uint64_t AudioRingBuffer::GetDroppedFrameCount() const
+	{
+		return this->droppedFrameCount.load(std::memory_order_relaxed);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include "AudioSeekIndex.h"
+#include "ConsoleLogger.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+using namespace Heph;
+
+namespace HephAudio
+{
+	// the persisted index is a cache, it's written in the native byte order and rebuilt if anything does not match.
+	static constexpr char SEEK_INDEX_MAGIC[8] = { 'H', 'E', 'P', 'H', 'S', 'E', 'E', 'K' };
+	static constexpr uint32_t SEEK_INDEX_VERSION = 1;
+
+	std::filesystem::path AudioSeekIndex::GetIndexFilePath(const std::filesystem::path& audioFilePath)
+	{
+		return audioFilePath.string() + HEPHAUDIO_SEEK_INDEX_EXTENSION;
+	}
+
+	bool AudioSeekIndex::Load(const std::filesystem::path& audioFilePath, std::vector<SeekPoint>& seekIndex)
+	{
+		seekIndex.clear();
+
+		const std::filesystem::path indexFilePath = AudioSeekIndex::GetIndexFilePath(audioFilePath);
+		if (!std::filesystem::exists(indexFilePath))
+		{
+			return false;
+		}
+
+		std::error_code ec;
+		const uint64_t fileSize = std::filesystem::file_size(audioFilePath, ec);
+		const int64_t lastWriteTime = std::filesystem::last_write_time(audioFilePath, ec).time_since_epoch().count();
+		if (ec)
+		{
+			return false;
+		}
+
+		FILE* pFile = fopen(indexFilePath.string().c_str(), "rb");
+		if (pFile == nullptr)
+		{
+			return false;
+		}
+
+		char magic[sizeof(SEEK_INDEX_MAGIC)]{};
+		uint32_t version = 0;
+		uint64_t indexFileSize = 0;
+		int64_t indexLastWriteTime = 0;
+		uint64_t entryCount = 0;
+		bool isValid = fread(magic, sizeof(magic), 1, pFile) == 1 && memcmp(magic, SEEK_INDEX_MAGIC, sizeof(magic)) == 0
+			&& fread(&version, sizeof(version), 1, pFile) == 1 && version == SEEK_INDEX_VERSION
+			&& fread(&indexFileSize, sizeof(indexFileSize), 1, pFile) == 1 && indexFileSize == fileSize
+			&& fread(&indexLastWriteTime, sizeof(indexLastWriteTime), 1, pFile) == 1 && indexLastWriteTime == lastWriteTime
+			&& fread(&entryCount, sizeof(entryCount), 1, pFile) == 1 && entryCount > 0 && entryCount <= fileSize;
+
+		if (isValid)
+		{
+			seekIndex.resize(entryCount);
+			for (SeekPoint& seekPoint : seekIndex)
+			{
+				int64_t pos = 0;
+				uint64_t frameIndex = 0;
+				if (fread(&pos, sizeof(pos), 1, pFile) != 1 || fread(&frameIndex, sizeof(frameIndex), 1, pFile) != 1)
+				{
+					isValid = false;
+					break;
+				}
+				seekPoint.pos = pos;
+				seekPoint.frameIndex = frameIndex;
+			}
+		}
+		(void)fclose(pFile);
+
+		if (!isValid)
+		{
+			HEPHAUDIO_LOG("The saved seek index of \"" + audioFilePath.filename().string() + "\" is outdated, it will be rebuilt.", HEPH_CL_INFO);
+			seekIndex.clear();
+		}
+		return isValid;
+	}
+
+	bool AudioSeekIndex::Save(const std::filesystem::path& audioFilePath, const std::vector<SeekPoint>& seekIndex)
+	{
+		std::error_code ec;
+		const uint64_t fileSize = std::filesystem::file_size(audioFilePath, ec);
+		const int64_t lastWriteTime = std::filesystem::last_write_time(audioFilePath, ec).time_since_epoch().count();
+		if (ec)
+		{
+			return false;
+		}
+
+		const std::filesystem::path indexFilePath = AudioSeekIndex::GetIndexFilePath(audioFilePath);
+		FILE* pFile = fopen(indexFilePath.string().c_str(), "wb");
+		if (pFile == nullptr)
+		{
+			HEPHAUDIO_LOG("Failed to create the seek index file, " + std::string(strerror(errno)), HEPH_CL_WARNING);
+			return false;
+		}
+
+		const uint64_t entryCount = seekIndex.size();
+		bool isWritten = fwrite(SEEK_INDEX_MAGIC, sizeof(SEEK_INDEX_MAGIC), 1, pFile) == 1
+			&& fwrite(&SEEK_INDEX_VERSION, sizeof(SEEK_INDEX_VERSION), 1, pFile) == 1
+			&& fwrite(&fileSize, sizeof(fileSize), 1, pFile) == 1
+			&& fwrite(&lastWriteTime, sizeof(lastWriteTime), 1, pFile) == 1
+			&& fwrite(&entryCount, sizeof(entryCount), 1, pFile) == 1;
+
+		for (size_t i = 0; isWritten && i < seekIndex.size(); i++)
+		{
+			const int64_t pos = seekIndex[i].pos;
+			const uint64_t frameIndex = seekIndex[i].frameIndex;
+			isWritten = fwrite(&pos, sizeof(pos), 1, pFile) == 1 && fwrite(&frameIndex, sizeof(frameIndex), 1, pFile) == 1;
+		}
+		isWritten = fclose(pFile) == 0 && isWritten;
+
+		if (!isWritten)
+		{
+			HEPHAUDIO_LOG("Failed to write the seek index file.", HEPH_CL_WARNING);
+			std::filesystem::remove(indexFilePath, ec);
+		}
+		return isWritten;
+	}
+}
\ No newline at end of file
@@ -7,19 +7,29 @@
 #include "AudioEvents/AudioRenderEventResult.h"
 #include "AudioEvents/AudioFinishedPlayingEventArgs.h"
 #include "HephMath.h"
+#include "ConsoleLogger.h"
+#include "EventResult.h"
 #include "Exceptions/InvalidArgumentException.h"
+#include "Exceptions/InvalidOperationException.h"
 #include "Exceptions/NotFoundException.h"
+#include <cmath>
+#include <cstring>
 
 using namespace Heph;
 
 namespace HephAudio
 {
+	AudioStream::NextFile::NextFile()
+		: pDecoder(new FFmpegAudioDecoder()), headFrameIndex(0), frameCount(0), isReady(false) {}
+
 	AudioStream::AudioStream(std::shared_ptr<Native::NativeAudio> pNativeAudio) : AudioStream(pNativeAudio, "") {}
 
 	AudioStream::AudioStream(Audio& audio) : AudioStream(audio.GetNativeAudio()) {}
 
 	AudioStream::AudioStream(std::shared_ptr<Native::NativeAudio> pNativeAudio, const std::filesystem::path& filePath)
 		: pNativeAudio(pNativeAudio), pAudioDecoder(new FFmpegAudioDecoder()), frameCount(0), pAudioObject(nullptr)
+		, pNextFile(new NextFile()), crossfadeDuration_ms(0), decodedFrameCount(0)
+		, isCrossfading(false), isSplicePending(false), spliceFrameIndex(0), splicedFrameCount(0), headFrameIndex(0)
 	{
 		if (this->pNativeAudio == nullptr)
 		{
@@ -35,9 +45,13 @@ namespace HephAudio
 	AudioStream::AudioStream(Audio& audio, const std::filesystem::path& filePath) : AudioStream(audio.GetNativeAudio(), filePath) {}
 
 	AudioStream::AudioStream(AudioStream&& rhs) noexcept
-		: pNativeAudio(rhs.pNativeAudio), pAudioDecoder(rhs.pAudioDecoder),
+		: OnNextFileStarted(rhs.OnNextFileStarted), pNativeAudio(rhs.pNativeAudio), pAudioDecoder(rhs.pAudioDecoder),
 		formatInfo(rhs.formatInfo), frameCount(rhs.frameCount),
-		pAudioObject(rhs.pAudioObject), decodedBuffer(std::move(rhs.decodedBuffer))
+		pAudioObject(rhs.pAudioObject), decodedBuffer(std::move(rhs.decodedBuffer)),
+		pNextFile(std::move(rhs.pNextFile)), crossfadeDuration_ms(rhs.crossfadeDuration_ms), decodedFrameCount(rhs.decodedFrameCount),
+		isCrossfading(rhs.isCrossfading), isSplicePending(rhs.isSplicePending), spliceFrameIndex(rhs.spliceFrameIndex),
+		splicedFrameCount(rhs.splicedFrameCount), splicedFilePath(std::move(rhs.splicedFilePath)),
+		headBuffer(std::move(rhs.headBuffer)), headFrameIndex(rhs.headFrameIndex)
 	{
 		if (this->pAudioObject != nullptr)
 		{
@@ -68,6 +82,17 @@ namespace HephAudio
 			this->frameCount = rhs.frameCount;
 			this->pAudioObject = rhs.pAudioObject;
 			this->decodedBuffer = std::move(rhs.decodedBuffer);
+			this->OnNextFileStarted = rhs.OnNextFileStarted;
+			this->pNextFile = std::move(rhs.pNextFile);
+			this->crossfadeDuration_ms = rhs.crossfadeDuration_ms;
+			this->decodedFrameCount = rhs.decodedFrameCount;
+			this->isCrossfading = rhs.isCrossfading;
+			this->isSplicePending = rhs.isSplicePending;
+			this->spliceFrameIndex = rhs.spliceFrameIndex;
+			this->splicedFrameCount = rhs.splicedFrameCount;
+			this->splicedFilePath = std::move(rhs.splicedFilePath);
+			this->headBuffer = std::move(rhs.headBuffer);
+			this->headFrameIndex = rhs.headFrameIndex;
 			if (this->pAudioObject != nullptr)
 			{
 				this->pAudioObject->OnRender.userEventArgs.Add(HEPHAUDIO_STREAM_EVENT_USER_ARG_KEY, this);
@@ -124,6 +149,30 @@ namespace HephAudio
 		const bool isPaused = (this->pAudioObject != nullptr) ? (this->pAudioObject->isPaused) : (true);
 
 		this->Stop();
+		this->ResetSplice();
+
+		// the file is already open in the prefetched decoder, take it over instead of opening the file again.
+		if (newFilePath != "" && this->pNextFile != nullptr && this->pNativeAudio->AudioObjectExists(this->pAudioObject))
+		{
+			std::lock_guard<std::mutex> lockGuard(this->pNextFile->mutex);
+			if (this->pNextFile->isReady.load(std::memory_order_acquire) && this->pNextFile->filePath == newFilePath)
+			{
+				this->decodedBuffer = std::move(this->pNextFile->headBuffer);
+				this->decodedFrameCount = this->decodedBuffer.FrameCount();
+				this->frameCount = this->pNextFile->frameCount;
+				this->SwapToNextFile();
+				this->formatInfo = this->pAudioDecoder->GetOutputFormatInfo();
+
+				this->pAudioObject->buffer.Release();
+				this->pAudioObject->name = "(stream)" + newFilePath.filename().string();
+				this->pAudioObject->filePath = newFilePath;
+				this->pAudioObject->frameIndex = 0;
+				this->pAudioObject->playCount = 1;
+				this->pAudioObject->isPaused = isPaused;
+				return;
+			}
+		}
+
 		this->CloseFile();
 
 		if (newFilePath != "")
@@ -182,6 +231,75 @@ namespace HephAudio
 		{
 			this->pAudioDecoder->CloseFile();
 		}
+
+		this->ResetSplice();
+	}
+
+	void AudioStream::QueueNextFile(const std::filesystem::path& filePath)
+	{
+		if (this->pNextFile == nullptr)
+		{
+			return;
+		}
+
+		NextFile* pNextFile = this->pNextFile.get();
+		std::lock_guard<std::mutex> lockGuard(pNextFile->mutex);
+
+		if (this->isCrossfading)
+		{
+			HEPH_RAISE_EXCEPTION(this, InvalidOperationException(HEPH_FUNC, "The current file is crossfading into the queued file."));
+			return;
+		}
+
+		if (filePath == pNextFile->filePath)
+		{
+			return;
+		}
+
+		if (pNextFile->prefetchThread.joinable())
+		{
+			pNextFile->prefetchThread.join();
+		}
+
+		pNextFile->isReady.store(false, std::memory_order_relaxed);
+		pNextFile->filePath = filePath;
+		pNextFile->headFrameIndex = 0;
+
+		if (filePath.empty())
+		{
+			pNextFile->pDecoder->CloseFile();
+			pNextFile->headBuffer.Release();
+			return;
+		}
+
+		const uint32_t headDuration_ms = HEPH_MATH_MAX(this->crossfadeDuration_ms, (uint32_t)HEPHAUDIO_STREAM_PREFETCH_DURATION_MS);
+		pNextFile->prefetchThread = std::thread(&AudioStream::PrefetchNextFile, pNextFile, headDuration_ms);
+	}
+
+	std::filesystem::path AudioStream::GetNextFile() const
+	{
+		if (this->pNextFile == nullptr)
+		{
+			return "";
+		}
+
+		std::lock_guard<std::mutex> lockGuard(this->pNextFile->mutex);
+		return this->pNextFile->filePath;
+	}
+
+	bool AudioStream::IsNextFileReady() const
+	{
+		return this->pNextFile != nullptr && this->pNextFile->isReady.load(std::memory_order_acquire);
+	}
+
+	uint32_t AudioStream::GetCrossfadeDuration() const
+	{
+		return this->crossfadeDuration_ms;
+	}
+
+	void AudioStream::SetCrossfadeDuration(uint32_t crossfadeDuration_ms)
+	{
+		this->crossfadeDuration_ms = crossfadeDuration_ms;
 	}
 
 	void AudioStream::Start()
@@ -215,9 +333,13 @@ namespace HephAudio
 				HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "position must be in the range of [0, 1]"));
 			}
 
+			this->CompleteSplice();
+
 			this->pAudioObject->frameIndex = position * this->frameCount;
 			this->pAudioDecoder->Seek(this->pAudioObject->frameIndex);
+			this->decodedFrameCount = this->pAudioObject->frameIndex;
 			this->decodedBuffer.Release();
+			this->headFrameIndex = this->headBuffer.FrameCount();
 		}
 	}
 
@@ -229,13 +351,241 @@ namespace HephAudio
 			this->pNativeAudio->DestroyAudioObject(this->pAudioObject);
 		}
 
+		if (this->pNextFile != nullptr)
+		{
+			if (this->pNextFile->prefetchThread.joinable())
+			{
+				this->pNextFile->prefetchThread.join();
+			}
+			this->pNextFile->pDecoder->CloseFile();
+			this->pNextFile = nullptr;
+		}
+
 		this->decodedBuffer.Release();
+		this->headBuffer.Release();
+		this->headFrameIndex = 0;
 
 		this->pAudioObject = nullptr;
 		this->pNativeAudio = nullptr;
 		this->pAudioDecoder = nullptr;
 		this->formatInfo = AudioFormatInfo();
 		this->frameCount = 0;
+		this->decodedFrameCount = 0;
+		this->isCrossfading = false;
+		this->isSplicePending = false;
+	}
+
+	void AudioStream::ResetSplice()
+	{
+		if (this->pNextFile != nullptr)
+		{
+			// the head of the queued file is kept, so it can be played from the start later.
+			std::lock_guard<std::mutex> lockGuard(this->pNextFile->mutex);
+			this->pNextFile->headFrameIndex = 0;
+			this->isCrossfading = false;
+		}
+
+		this->decodedFrameCount = 0;
+		this->isSplicePending = false;
+		this->spliceFrameIndex = 0;
+		this->headFrameIndex = this->headBuffer.FrameCount();
+	}
+
+	size_t AudioStream::DecodeFrames(size_t frameIndex, size_t frameCount)
+	{
+		const size_t firstFrameIndex = this->decodedFrameCount;
+		const size_t channelCount = this->formatInfo.channelLayout.count;
+
+		// the decoder of a spliced file is positioned after its head, so the rest of the head comes first.
+		size_t decodedFrameCount = HEPH_MATH_MIN(frameCount, this->headBuffer.FrameCount() - this->headFrameIndex);
+		if (decodedFrameCount > 0)
+		{
+			(void)memcpy(this->decodedBuffer[frameIndex], this->headBuffer[this->headFrameIndex], decodedFrameCount * channelCount * sizeof(heph_audio_sample_t));
+			this->headFrameIndex += decodedFrameCount;
+		}
+		if (decodedFrameCount < frameCount)
+		{
+			decodedFrameCount += this->pAudioDecoder->DecodeInto(this->decodedBuffer, frameIndex + decodedFrameCount, frameCount - decodedFrameCount);
+		}
+		this->decodedFrameCount += decodedFrameCount;
+
+		if (this->pNextFile == nullptr || this->pAudioObject->playCount != 1)
+		{
+			return decodedFrameCount;
+		}
+
+		// never wait on the render thread, the file is spliced on a later call if the lock is taken.
+		NextFile* pNextFile = this->pNextFile.get();
+		std::unique_lock<std::mutex> lock(pNextFile->mutex, std::try_to_lock);
+		if (!lock.owns_lock() || !pNextFile->isReady.load(std::memory_order_acquire))
+		{
+			return decodedFrameCount;
+		}
+
+		const AudioFormatInfo nextFormatInfo = pNextFile->pDecoder->GetOutputFormatInfo();
+		if (nextFormatInfo.channelLayout != this->formatInfo.channelLayout || nextFormatInfo.sampleRate != this->formatInfo.sampleRate)
+		{
+			return decodedFrameCount;
+		}
+
+		const AudioBuffer& headBuffer = pNextFile->headBuffer;
+		const size_t headFrameCount = headBuffer.FrameCount();
+
+		// equal power crossfade over the last frames of the current file.
+		const size_t fileFrameCount = this->pAudioDecoder->GetFrameCount();
+		const size_t requestedCrossfadeFrameCount = (size_t)this->crossfadeDuration_ms * this->formatInfo.sampleRate / 1000;
+		const size_t crossfadeFrameCount = HEPH_MATH_MIN(requestedCrossfadeFrameCount, headFrameCount);
+		if (crossfadeFrameCount > 0 && fileFrameCount > crossfadeFrameCount)
+		{
+			const size_t crossfadeStart = fileFrameCount - crossfadeFrameCount;
+			for (size_t i = (firstFrameIndex < crossfadeStart) ? (crossfadeStart - firstFrameIndex) : (0); i < decodedFrameCount && pNextFile->headFrameIndex < crossfadeFrameCount; ++i)
+			{
+				if (!this->isCrossfading)
+				{
+					this->isCrossfading = true;
+					this->isSplicePending = true;
+					this->spliceFrameIndex = frameIndex + i;
+					this->splicedFrameCount = pNextFile->frameCount;
+					this->splicedFilePath = pNextFile->filePath;
+				}
+
+				const double x = (pNextFile->headFrameIndex + 0.5) / crossfadeFrameCount;
+				const double currentFactor = cos(x * HEPH_MATH_PI / 2);
+				const double nextFactor = sin(x * HEPH_MATH_PI / 2);
+				heph_audio_sample_t* pFrame = this->decodedBuffer[frameIndex + i];
+				const heph_audio_sample_t* pNextFrame = headBuffer[pNextFile->headFrameIndex];
+				for (size_t j = 0; j < channelCount; ++j)
+				{
+					pFrame[j] = pFrame[j] * currentFactor + pNextFrame[j] * nextFactor;
+				}
+				pNextFile->headFrameIndex++;
+			}
+		}
+
+		if (decodedFrameCount == frameCount)
+		{
+			return decodedFrameCount;
+		}
+
+		// the current file ended, continue with the next file from the first frame that's not played yet.
+		if (!this->isCrossfading)
+		{
+			this->isSplicePending = true;
+			this->spliceFrameIndex = frameIndex + decodedFrameCount;
+			this->splicedFrameCount = pNextFile->frameCount;
+			this->splicedFilePath = pNextFile->filePath;
+		}
+
+		size_t outputFrameIndex = frameIndex + decodedFrameCount;
+		size_t remainingFrameCount = frameCount - decodedFrameCount;
+		const size_t headLeftFrameCount = headFrameCount - pNextFile->headFrameIndex;
+		const size_t headCopyFrameCount = HEPH_MATH_MIN(remainingFrameCount, headLeftFrameCount);
+
+		if (headCopyFrameCount > 0)
+		{
+			(void)memcpy(this->decodedBuffer[outputFrameIndex], headBuffer[pNextFile->headFrameIndex], headCopyFrameCount * channelCount * sizeof(heph_audio_sample_t));
+			pNextFile->headFrameIndex += headCopyFrameCount;
+			outputFrameIndex += headCopyFrameCount;
+			remainingFrameCount -= headCopyFrameCount;
+		}
+
+		// the rest of the head, if any, is rendered by the next calls.
+		this->decodedFrameCount = pNextFile->headFrameIndex;
+		this->SwapToNextFile();
+		if (remainingFrameCount > 0)
+		{
+			const size_t nextFrameCount = this->pAudioDecoder->DecodeInto(this->decodedBuffer, outputFrameIndex, remainingFrameCount);
+			this->decodedFrameCount += nextFrameCount;
+			remainingFrameCount -= nextFrameCount;
+		}
+
+		lock.unlock();
+		this->RaiseNextFileStarted();
+
+		return frameCount - remainingFrameCount;
+	}
+
+	void AudioStream::SwapToNextFile()
+	{
+		// the previous decoder and head are released by the next prefetch, so the render thread does not wait for them.
+		std::swap(this->pAudioDecoder, this->pNextFile->pDecoder);
+		std::swap(this->headBuffer, this->pNextFile->headBuffer);
+		this->headFrameIndex = this->pNextFile->headFrameIndex;
+		this->pNextFile->filePath.clear();
+		this->pNextFile->headFrameIndex = 0;
+		this->pNextFile->isReady.store(false, std::memory_order_relaxed);
+		this->isCrossfading = false;
+	}
+
+	void AudioStream::ApplySplice(size_t frameIndex)
+	{
+		this->pAudioObject->frameIndex = frameIndex;
+		this->pAudioObject->name = "(stream)" + this->splicedFilePath.filename().string();
+		this->pAudioObject->filePath = this->splicedFilePath;
+		this->frameCount = this->splicedFrameCount;
+		this->isSplicePending = false;
+	}
+
+	void AudioStream::CompleteSplice()
+	{
+		bool isSwapped = false;
+		if (this->pNextFile != nullptr)
+		{
+			std::lock_guard<std::mutex> lockGuard(this->pNextFile->mutex);
+			if (this->isCrossfading)
+			{
+				this->SwapToNextFile();
+				isSwapped = true;
+			}
+		}
+
+		if (this->isSplicePending)
+		{
+			this->ApplySplice(0);
+		}
+
+		if (isSwapped)
+		{
+			this->RaiseNextFileStarted();
+		}
+	}
+
+	void AudioStream::RaiseNextFileStarted()
+	{
+		if (this->OnNextFileStarted)
+		{
+			AudioFinishedPlayingEventArgs args(this->pNativeAudio.get(), this->pAudioObject);
+			EventResult result;
+			this->OnNextFileStarted(&args, &result);
+		}
+	}
+
+	void AudioStream::PrefetchNextFile(NextFile* pNextFile, uint32_t headDuration_ms)
+	{
+		try
+		{
+			pNextFile->pDecoder->CloseFile();
+			pNextFile->pDecoder->ChangeFile(pNextFile->filePath);
+
+			const AudioFormatInfo formatInfo = pNextFile->pDecoder->GetOutputFormatInfo();
+			const size_t headFrameCount = (size_t)formatInfo.sampleRate * headDuration_ms / 1000;
+
+			pNextFile->frameCount = pNextFile->pDecoder->GetFrameCount();
+			pNextFile->headBuffer = AudioBuffer(headFrameCount, formatInfo.channelLayout, formatInfo.sampleRate, BufferFlags::AllocUninitialized);
+
+			const size_t decodedFrameCount = pNextFile->pDecoder->DecodeInto(pNextFile->headBuffer, 0, headFrameCount);
+			if (decodedFrameCount < headFrameCount)
+			{
+				pNextFile->headBuffer.Resize(decodedFrameCount);
+			}
+
+			pNextFile->headFrameIndex = 0;
+			pNextFile->isReady.store(true, std::memory_order_release);
+		}
+		catch (const std::exception&)
+		{
+			HEPHAUDIO_LOG("Could not prefetch \"" + pNextFile->filePath.string() + "\", it will be opened when the current file ends.", HEPH_CL_WARNING);
+		}
 	}
 
 	void AudioStream::OnRender(const EventParams& eventParams)
@@ -247,7 +597,8 @@ namespace HephAudio
 		AudioRenderEventResult* pResult = (AudioRenderEventResult*)eventParams.pResult;
 
 		AudioStream* pStream = (AudioStream*)eventParams.userEventArgs[HEPHAUDIO_STREAM_EVENT_USER_ARG_KEY];
-		if (pStream != nullptr && pStream->pAudioDecoder != nullptr)
+		// the file is closed after it finished playing, nothing is rendered until a new file is opened.
+		if (pStream != nullptr && pStream->pAudioDecoder != nullptr && pStream->pAudioDecoder->IsFileOpen())
 		{
 			const AudioFormatInfo inputFormat = pStream->pAudioDecoder->GetOutputFormatInfo();
 			const AudioFormatInfo& renderFormat = pArgs->pNativeAudio->GetRenderFormat();
@@ -261,19 +612,35 @@ namespace HephAudio
 			const size_t advanceSize = resampler.CalculateAdvanceSize(pArgs->renderFrameCount, inputFormat);
 			const size_t minRequiredFrameCount = FFMAX(requiredFrameCount, pArgs->renderFrameCount);
 
-			size_t remainingFrameCount{ 0 };
-			if (decodedBufferFrameCount > 0)
+			// a virtual stream skips the frames instead of decoding them, except near the end where the queued file is spliced.
+			const size_t crossfadeFrameCount = (size_t)pStream->crossfadeDuration_ms * pStream->formatInfo.sampleRate / 1000;
+			if (pArgs->isVirtual && !pStream->isSplicePending && pArgs->pAudioObject->frameIndex + advanceSize + crossfadeFrameCount < pStream->frameCount)
 			{
-				if (minRequiredFrameCount > decodedBufferFrameCount)
+				if (decodedBufferFrameCount > advanceSize)
 				{
-					remainingFrameCount = minRequiredFrameCount - decodedBufferFrameCount;
-					pStream->decodedBuffer.Append(pStream->pAudioDecoder->Decode(remainingFrameCount));
+					pStream->decodedBuffer.Cut(0, advanceSize);
 				}
+				else
+				{
+					pStream->decodedFrameCount += advanceSize - decodedBufferFrameCount;
+					pStream->pAudioDecoder->Seek(pStream->decodedFrameCount);
+					pStream->decodedBuffer.Release();
+					pStream->headFrameIndex = pStream->headBuffer.FrameCount();
+				}
+				pArgs->pAudioObject->frameIndex += advanceSize;
+				return;
 			}
-			else
+
+			// decode straight into the end of the buffer, the frames past the end of the file are left silent.
+			if (decodedBufferFrameCount == 0)
+			{
+				pStream->decodedBuffer = AudioBuffer(minRequiredFrameCount, inputFormat.channelLayout, inputFormat.sampleRate);
+				(void)pStream->DecodeFrames(0, minRequiredFrameCount);
+			}
+			else if (minRequiredFrameCount > decodedBufferFrameCount)
 			{
-				remainingFrameCount = minRequiredFrameCount;
-				pStream->decodedBuffer = pStream->pAudioDecoder->Decode(remainingFrameCount);
+				pStream->decodedBuffer.Resize(minRequiredFrameCount);
+				(void)pStream->DecodeFrames(decodedBufferFrameCount, minRequiredFrameCount - decodedBufferFrameCount);
 			}
 
 			if (renderSampleRate != pStream->formatInfo.sampleRate)
@@ -297,7 +664,19 @@ namespace HephAudio
 			channelMapper.Process(pResult->renderBuffer);
 
 			pArgs->pAudioObject->frameIndex += advanceSize;
-			pResult->isFinishedPlaying = pArgs->pAudioObject->frameIndex >= pStream->frameCount;
+			if (pStream->isSplicePending)
+			{
+				// the first frame of the next file is rendered, the position is relative to it from now on.
+				if (advanceSize >= pStream->spliceFrameIndex)
+				{
+					pStream->ApplySplice(advanceSize - pStream->spliceFrameIndex);
+				}
+				else
+				{
+					pStream->spliceFrameIndex -= advanceSize;
+				}
+			}
+			pResult->isFinishedPlaying = !pStream->isSplicePending && pArgs->pAudioObject->frameIndex >= pStream->frameCount;
 		}
 	}
 
@@ -315,6 +694,8 @@ namespace HephAudio
 			else if (pStream->pAudioDecoder != nullptr)
 			{
 				pStream->pAudioDecoder->Seek(0);
+				pStream->decodedFrameCount = 0;
+				pStream->headFrameIndex = pStream->headBuffer.FrameCount();
 			}
 		}
 	}
@@ -0,0 +1,315 @@
+#include "CompressedAudioBuffer.h"
+#include "HephMath.h"
+#include "Exceptions/InvalidArgumentException.h"
+#include <cmath>
+#include <cstring>
+
+using namespace Heph;
+
+namespace HephAudio
+{
+	// each channel of a block starts with the first sample as 16 bit PCM, the step index and a reserved byte.
+	static constexpr size_t ADPCM_CHANNEL_HEADER_SIZE = 4;
+
+	static constexpr size_t INVALID_BLOCK_INDEX = SIZE_MAX;
+
+	static constexpr int32_t IMA_ADPCM_STEP_TABLE[89] =
+	{
+		7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+		50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+		337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+		2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+		15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+	};
+
+	static constexpr int32_t IMA_ADPCM_INDEX_TABLE[8] = { -1, -1, -1, -1, 2, 4, 6, 8 };
+
+	static int16_t ToPcm16(heph_audio_sample_t sample)
+	{
+		const long value = std::lround(HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(sample) * 32768.0);
+		return (int16_t)HEPH_MATH_MAX(HEPH_MATH_MIN(value, 32767L), -32768L);
+	}
+
+	static heph_audio_sample_t FromPcm16(int32_t sample)
+	{
+		return HEPH_AUDIO_SAMPLE_FROM_IEEE_FLT(sample / 32768.0);
+	}
+
+	// reconstructs the next sample from the nibble, shared by the encoder and the decoder so they never drift apart.
+	static void ImaAdpcmStep(uint8_t nibble, int32_t& predictor, int32_t& stepIndex)
+	{
+		const int32_t step = IMA_ADPCM_STEP_TABLE[stepIndex];
+		int32_t delta = step >> 3;
+		if (nibble & 4) delta += step;
+		if (nibble & 2) delta += step >> 1;
+		if (nibble & 1) delta += step >> 2;
+
+		predictor += (nibble & 8) ? -delta : delta;
+		predictor = HEPH_MATH_MAX(HEPH_MATH_MIN(predictor, 32767), -32768);
+
+		stepIndex += IMA_ADPCM_INDEX_TABLE[nibble & 7];
+		stepIndex = HEPH_MATH_MAX(HEPH_MATH_MIN(stepIndex, 88), 0);
+	}
+
+	static uint8_t ImaAdpcmEncodeSample(int32_t sample, int32_t& predictor, int32_t& stepIndex)
+	{
+		int32_t step = IMA_ADPCM_STEP_TABLE[stepIndex];
+		int32_t diff = sample - predictor;
+		uint8_t nibble = 0;
+
+		if (diff < 0)
+		{
+			nibble = 8;
+			diff = -diff;
+		}
+		if (diff >= step)
+		{
+			nibble |= 4;
+			diff -= step;
+		}
+		step >>= 1;
+		if (diff >= step)
+		{
+			nibble |= 2;
+			diff -= step;
+		}
+		step >>= 1;
+		if (diff >= step)
+		{
+			nibble |= 1;
+		}
+
+		ImaAdpcmStep(nibble, predictor, stepIndex);
+		return nibble;
+	}
+
+	CompressedAudioBuffer::DecoderState::DecoderState() : blockIndex(INVALID_BLOCK_INDEX) {}
+
+	CompressedAudioBuffer::CompressedAudioBuffer(const AudioBuffer& buffer, size_t blockFrameCount)
+	{
+		this->Initialize(buffer.FormatInfo(), buffer.FrameCount(), blockFrameCount);
+
+		const size_t channelCount = this->formatInfo.channelLayout.count;
+		std::vector<int32_t> encoderIndices(channelCount, 0);
+		for (size_t i = 0, blockIndex = 0; i < this->frameCount; i += this->blockFrameCount, blockIndex++)
+		{
+			this->EncodeBlock(buffer.begin() + i * channelCount, HEPH_MATH_MIN(this->blockFrameCount, this->frameCount - i), blockIndex, encoderIndices);
+		}
+	}
+
+	CompressedAudioBuffer::CompressedAudioBuffer(IAudioDecoder& decoder, size_t blockFrameCount)
+	{
+		this->Initialize(decoder.GetOutputFormatInfo(), decoder.GetFrameCount(), blockFrameCount);
+
+		const size_t blockCount = this->data.size() / this->blockSize_byte;
+		std::vector<int32_t> encoderIndices(this->formatInfo.channelLayout.count, 0);
+		AudioBuffer pendingBuffer(0, this->formatInfo.channelLayout, this->formatInfo.sampleRate);
+		size_t decodedFrameCount = 0;
+
+		for (size_t blockIndex = 0; blockIndex < blockCount; blockIndex++)
+		{
+			// decoders may return more frames than requested, the surplus is kept for the next block.
+			while (pendingBuffer.FrameCount() < this->blockFrameCount && decodedFrameCount < this->frameCount)
+			{
+				const AudioBuffer decodedBuffer = decoder.Decode(HEPH_MATH_MIN(this->blockFrameCount, this->frameCount - decodedFrameCount));
+				if (decodedBuffer.FrameCount() == 0)
+				{
+					decodedFrameCount = this->frameCount;
+					break;
+				}
+
+				decodedFrameCount += decodedBuffer.FrameCount();
+				pendingBuffer.Append(decodedBuffer);
+			}
+
+			const size_t blockFrameCount = HEPH_MATH_MIN(this->blockFrameCount, pendingBuffer.FrameCount());
+			this->EncodeBlock(pendingBuffer.begin(), blockFrameCount, blockIndex, encoderIndices);
+			pendingBuffer.Cut(0, blockFrameCount);
+		}
+	}
+
+	const AudioFormatInfo& CompressedAudioBuffer::FormatInfo() const
+	{
+		return this->formatInfo;
+	}
+
+	size_t CompressedAudioBuffer::FrameCount() const
+	{
+		return this->frameCount;
+	}
+
+	size_t CompressedAudioBuffer::BlockFrameCount() const
+	{
+		return this->blockFrameCount;
+	}
+
+	size_t CompressedAudioBuffer::Size() const
+	{
+		return this->data.size();
+	}
+
+	void CompressedAudioBuffer::Decode(size_t frameIndex, size_t frameCount, heph_audio_sample_t* pOutput, DecoderState& state) const
+	{
+		const size_t channelCount = this->formatInfo.channelLayout.count;
+		if (state.decodedBlock.size() != this->blockFrameCount * channelCount)
+		{
+			state.decodedBlock.resize(this->blockFrameCount * channelCount);
+			state.blockIndex = INVALID_BLOCK_INDEX;
+		}
+
+		size_t outputFrameIndex = 0;
+		while (outputFrameIndex < frameCount && frameIndex < this->frameCount)
+		{
+			const size_t blockIndex = frameIndex / this->blockFrameCount;
+			const size_t blockFrameIndex = frameIndex % this->blockFrameCount;
+			if (state.blockIndex != blockIndex)
+			{
+				this->DecodeBlock(blockIndex, state.decodedBlock.data());
+				state.blockIndex = blockIndex;
+			}
+
+			const size_t availableFrameCount = HEPH_MATH_MIN(this->blockFrameCount - blockFrameIndex, this->frameCount - frameIndex);
+			const size_t copyFrameCount = HEPH_MATH_MIN(availableFrameCount, frameCount - outputFrameIndex);
+			(void)memcpy(pOutput + outputFrameIndex * channelCount, state.decodedBlock.data() + blockFrameIndex * channelCount, copyFrameCount * channelCount * sizeof(heph_audio_sample_t));
+
+			outputFrameIndex += copyFrameCount;
+			frameIndex += copyFrameCount;
+		}
+
+		if (outputFrameIndex < frameCount)
+		{
+			(void)memset(pOutput + outputFrameIndex * channelCount, 0, (frameCount - outputFrameIndex) * channelCount * sizeof(heph_audio_sample_t));
+		}
+	}
+
+	AudioBuffer CompressedAudioBuffer::Decode() const
+	{
+		AudioBuffer buffer(this->frameCount, this->formatInfo.channelLayout, this->formatInfo.sampleRate, BufferFlags::AllocUninitialized);
+		DecoderState state;
+		this->Decode(0, this->frameCount, buffer.begin(), state);
+		return buffer;
+	}
+
+	std::shared_ptr<CompressedAudioBuffer::DecoderState> CompressedAudioBuffer::AcquireDecoderState() const
+	{
+		std::shared_ptr<DecoderStatePool> pPool = this->pDecoderStatePool;
+		std::unique_ptr<DecoderState> pState;
+		{
+			std::lock_guard<std::mutex> lockGuard(pPool->mutex);
+			if (!pPool->freeStates.empty())
+			{
+				pState = std::move(pPool->freeStates.back());
+				pPool->freeStates.pop_back();
+			}
+		}
+
+		if (pState == nullptr)
+		{
+			pState = std::make_unique<DecoderState>();
+			pState->decodedBlock.resize(this->blockFrameCount * this->formatInfo.channelLayout.count);
+		}
+		pState->blockIndex = INVALID_BLOCK_INDEX;
+
+		return std::shared_ptr<DecoderState>(pState.release(), [pPool](DecoderState* pState)
+			{
+				std::lock_guard<std::mutex> lockGuard(pPool->mutex);
+				pPool->freeStates.emplace_back(pState);
+			});
+	}
+
+	size_t CompressedAudioBuffer::GetIdleDecoderStateCount() const
+	{
+		std::lock_guard<std::mutex> lockGuard(this->pDecoderStatePool->mutex);
+		return this->pDecoderStatePool->freeStates.size();
+	}
+
+	void CompressedAudioBuffer::Initialize(const AudioFormatInfo& formatInfo, size_t frameCount, size_t blockFrameCount)
+	{
+		if (blockFrameCount < 3 || (blockFrameCount % 2) == 0)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "blockFrameCount must be an odd number greater than 1."));
+		}
+
+		if (formatInfo.channelLayout.count == 0)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "Invalid channel layout."));
+		}
+
+		this->formatInfo = HEPHAUDIO_INTERNAL_FORMAT(formatInfo.channelLayout, formatInfo.sampleRate);
+		this->frameCount = frameCount;
+		this->blockFrameCount = blockFrameCount;
+		// the first sample of each block is stored in the header, the rest as 4 bit nibbles.
+		this->blockSize_byte = formatInfo.channelLayout.count * (ADPCM_CHANNEL_HEADER_SIZE + (blockFrameCount - 1) / 2);
+		this->data.resize(((frameCount + blockFrameCount - 1) / blockFrameCount) * this->blockSize_byte);
+		this->pDecoderStatePool = std::make_shared<DecoderStatePool>();
+	}
+
+	void CompressedAudioBuffer::EncodeBlock(const heph_audio_sample_t* pInput, size_t frameCount, size_t blockIndex, std::vector<int32_t>& encoderIndices)
+	{
+		const size_t channelCount = this->formatInfo.channelLayout.count;
+		const size_t channelDataSize = (this->blockFrameCount - 1) / 2;
+		uint8_t* pBlock = this->data.data() + blockIndex * this->blockSize_byte;
+		uint8_t* pBlockData = pBlock + channelCount * ADPCM_CHANNEL_HEADER_SIZE;
+
+		for (size_t ch = 0; ch < channelCount; ch++)
+		{
+			int32_t predictor = frameCount > 0 ? ToPcm16(pInput[ch]) : 0;
+			int32_t& stepIndex = encoderIndices[ch];
+
+			// start with a step that fits the first difference instead of adapting up from the smallest step.
+			if (blockIndex == 0 && frameCount > 1)
+			{
+				const int32_t diff = std::abs(ToPcm16(pInput[channelCount + ch]) - predictor);
+				while (stepIndex < 88 && IMA_ADPCM_STEP_TABLE[stepIndex] < diff)
+				{
+					stepIndex++;
+				}
+			}
+
+			uint8_t* pHeader = pBlock + ch * ADPCM_CHANNEL_HEADER_SIZE;
+			pHeader[0] = (uint8_t)(predictor & 0xFF);
+			pHeader[1] = (uint8_t)((predictor >> 8) & 0xFF);
+			pHeader[2] = (uint8_t)stepIndex;
+			pHeader[3] = 0;
+
+			// frames past the end of the data are encoded as silence.
+			uint8_t* pChannelData = pBlockData + ch * channelDataSize;
+			for (size_t i = 1; i < this->blockFrameCount; i += 2)
+			{
+				const int32_t s0 = i < frameCount ? ToPcm16(pInput[i * channelCount + ch]) : 0;
+				const int32_t s1 = (i + 1) < frameCount ? ToPcm16(pInput[(i + 1) * channelCount + ch]) : 0;
+				const uint8_t n0 = ImaAdpcmEncodeSample(s0, predictor, stepIndex);
+				const uint8_t n1 = ImaAdpcmEncodeSample(s1, predictor, stepIndex);
+				pChannelData[(i - 1) / 2] = (uint8_t)(n0 | (n1 << 4));
+			}
+		}
+	}
+
+	void CompressedAudioBuffer::DecodeBlock(size_t blockIndex, heph_audio_sample_t* pOutput) const
+	{
+		const size_t channelCount = this->formatInfo.channelLayout.count;
+		const size_t channelDataSize = (this->blockFrameCount - 1) / 2;
+		const uint8_t* pBlock = this->data.data() + blockIndex * this->blockSize_byte;
+		const uint8_t* pBlockData = pBlock + channelCount * ADPCM_CHANNEL_HEADER_SIZE;
+
+		for (size_t ch = 0; ch < channelCount; ch++)
+		{
+			const uint8_t* pHeader = pBlock + ch * ADPCM_CHANNEL_HEADER_SIZE;
+			int32_t predictor = (int16_t)(pHeader[0] | (pHeader[1] << 8));
+			int32_t stepIndex = HEPH_MATH_MIN((int32_t)pHeader[2], 88);
+			pOutput[ch] = FromPcm16(predictor);
+
+			const uint8_t* pChannelData = pBlockData + ch * channelDataSize;
+			for (size_t i = 1; i < this->blockFrameCount; i += 2)
+			{
+				const uint8_t nibbles = pChannelData[(i - 1) / 2];
+
+				ImaAdpcmStep(nibbles & 0x0F, predictor, stepIndex);
+				pOutput[i * channelCount + ch] = FromPcm16(predictor);
+
+				ImaAdpcmStep(nibbles >> 4, predictor, stepIndex);
+				pOutput[(i + 1) * channelCount + ch] = FromPcm16(predictor);
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,255 @@
+#include "ConstantQTransform.h"
+#include "Windows/HannWindow.h"
+#include "Windows/RectangularWindow.h"
+#include "Fourier.h"
+#include "HephMath.h"
+#include "Exceptions/InvalidArgumentException.h"
+#include <cmath>
+#include <thread>
+
+using namespace Heph;
+
+namespace HephAudio
+{
+	// number of frames transformed at a time by each thread.
+	static constexpr size_t FRAME_BLOCK_SIZE = 32;
+
+	// kernel elements whose magnitude is less than this ratio of the peak are discarded.
+	static constexpr double KERNEL_THRESHOLD = 0.005;
+
+	static size_t CalculateKernelSize(uint32_t sampleRate, double frequency, size_t binsPerOctave)
+	{
+		const double q = 1.0 / (pow(2.0, 1.0 / binsPerOctave) - 1.0);
+		return (size_t)ceil(q * sampleRate / frequency);
+	}
+
+	static size_t CalculateFrameSize(uint32_t sampleRate, double minFrequency, double maxFrequency, size_t binsPerOctave)
+	{
+		if (sampleRate == 0)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(nullptr, InvalidArgumentException(HEPH_FUNC, "sampleRate must be greater than zero."));
+		}
+		if (binsPerOctave == 0)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(nullptr, InvalidArgumentException(HEPH_FUNC, "binsPerOctave must be greater than zero."));
+		}
+		if (minFrequency <= 0 || minFrequency > maxFrequency || maxFrequency >= sampleRate * 0.5)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(nullptr, InvalidArgumentException(HEPH_FUNC, "frequencies must satisfy 0 < minFrequency <= maxFrequency < sampleRate / 2."));
+		}
+		return Fourier::CalculateFFTSize(CalculateKernelSize(sampleRate, minFrequency, binsPerOctave));
+	}
+
+	ConstantQTransform::ConstantQTransform(uint32_t sampleRate, double minFrequency, double maxFrequency, size_t binsPerOctave, size_t hopSize)
+		: sampleRate(sampleRate), minFrequency(minFrequency), binsPerOctave(binsPerOctave),
+		stft(RectangularWindow(CalculateFrameSize(sampleRate, minFrequency, maxFrequency, binsPerOctave)), hopSize)
+	{
+		const size_t fftSize = this->stft.GetFFTSize();
+		const size_t nyquistBin = fftSize / 2;
+		const size_t binCount = (size_t)floor(binsPerOctave * log2(maxFrequency / minFrequency) + 1e-9) + 1;
+
+		SplitComplexBuffer kernel(fftSize);
+		double* const pReal = kernel.Real();
+		double* const pImag = kernel.Imag();
+
+		this->kernelStartBins.resize(binCount);
+		this->kernelOffsets.reserve(binCount + 1);
+
+		for (size_t i = 0; i < binCount; ++i)
+		{
+			const double frequency = this->GetBinFrequency(i);
+			const size_t kernelSize = HEPH_MATH_MIN(CalculateKernelSize(sampleRate, frequency, binsPerOctave), fftSize);
+			const size_t kernelStart = (fftSize - kernelSize) / 2;
+			const HannWindow wnd(kernelSize);
+
+			// temporal kernel, centered in the frame.
+			// the forward FFT uses the positive exponent, hence the negative exponent moves the kernel to the bins below the Nyquist bin.
+			kernel.Reset();
+			for (size_t j = 0; j < kernelSize; ++j)
+			{
+				const double weight = wnd[j] / kernelSize;
+				const double phase = 2.0 * HEPH_MATH_PI * frequency * j / sampleRate;
+				pReal[kernelStart + j] = weight * cos(phase);
+				pImag[kernelStart + j] = -weight * sin(phase);
+			}
+			Fourier::FFT(kernel);
+
+			double peak = 0.0;
+			for (size_t j = 0; j <= nyquistBin; ++j)
+			{
+				peak = HEPH_MATH_MAX(peak, pReal[j] * pReal[j] + pImag[j] * pImag[j]);
+			}
+
+			const double threshold = peak * KERNEL_THRESHOLD * KERNEL_THRESHOLD;
+			size_t startBin = 0, endBin = nyquistBin;
+			while (startBin < endBin && (pReal[startBin] * pReal[startBin] + pImag[startBin] * pImag[startBin]) < threshold)
+			{
+				startBin++;
+			}
+			while (endBin > startBin && (pReal[endBin] * pReal[endBin] + pImag[endBin] * pImag[endBin]) < threshold)
+			{
+				endBin--;
+			}
+
+			this->kernelStartBins[i] = startBin;
+			this->kernelOffsets.push_back(this->kernelReal.size());
+			for (size_t j = startBin; j <= endBin; ++j)
+			{
+				this->kernelReal.push_back(pReal[j] / fftSize);
+				this->kernelImag.push_back(-pImag[j] / fftSize);
+			}
+		}
+		this->kernelOffsets.push_back(this->kernelReal.size());
+	}
+
+	size_t ConstantQTransform::GetBinCount() const
+	{
+		return this->kernelStartBins.size();
+	}
+
+	size_t ConstantQTransform::GetBinsPerOctave() const
+	{
+		return this->binsPerOctave;
+	}
+
+	double ConstantQTransform::GetBinFrequency(size_t binIndex) const
+	{
+		return this->minFrequency * pow(2.0, ((double)binIndex) / this->binsPerOctave);
+	}
+
+	size_t ConstantQTransform::GetFFTSize() const
+	{
+		return this->stft.GetFFTSize();
+	}
+
+	size_t ConstantQTransform::GetHopSize() const
+	{
+		return this->stft.GetHopSize();
+	}
+
+	size_t ConstantQTransform::GetThreadCount() const
+	{
+		return this->stft.GetThreadCount();
+	}
+
+	void ConstantQTransform::SetThreadCount(size_t threadCount)
+	{
+		this->stft.SetThreadCount(threadCount);
+	}
+
+	size_t ConstantQTransform::CalculateFrameCount(size_t sampleCount) const
+	{
+		return this->stft.CalculateFrameCount(sampleCount);
+	}
+
+	void ConstantQTransform::Analyze(const AudioBuffer& buffer, size_t channelIndex, StftOutputType outputType, double* pOutput) const
+	{
+		if (pOutput == nullptr)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "pOutput must not be nullptr."));
+		}
+
+		const size_t frameCount = this->CalculateFrameCount(buffer.FrameCount());
+		if (frameCount == 0)
+		{
+			return;
+		}
+		if (channelIndex >= buffer.FormatInfo().channelLayout.count)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "channelIndex out of bounds."));
+		}
+
+		const size_t threadCount = HEPH_MATH_MIN(this->stft.GetThreadCount(), frameCount);
+		const size_t framesPerThread = frameCount / threadCount;
+		const size_t remainingFrameCount = frameCount % threadCount;
+		std::vector<std::thread> threads(threadCount - 1);
+		size_t firstFrameIndex = 0;
+
+		for (std::thread& t : threads)
+		{
+			t = std::thread(
+				&ConstantQTransform::AnalyzeST,
+				this,
+				std::cref(buffer),
+				channelIndex,
+				firstFrameIndex,
+				framesPerThread,
+				outputType,
+				pOutput + firstFrameIndex * this->GetBinCount()
+			);
+			firstFrameIndex += framesPerThread;
+		}
+		this->AnalyzeST(buffer, channelIndex, firstFrameIndex, framesPerThread + remainingFrameCount, outputType, pOutput + firstFrameIndex * this->GetBinCount());
+
+		for (std::thread& t : threads)
+		{
+			if (t.joinable())
+			{
+				t.join();
+			}
+		}
+	}
+
+	void ConstantQTransform::AnalyzeST(const AudioBuffer& buffer, size_t channelIndex, size_t firstFrameIndex, size_t frameCount, StftOutputType outputType, double* pOutput) const
+	{
+		const size_t binCount = this->GetBinCount();
+		const size_t fftBinCount = this->stft.GetBinCount();
+		const size_t hopSize = this->stft.GetHopSize();
+		const AudioFormatInfo& formatInfo = buffer.FormatInfo();
+
+		StftAnalyzer blockStft(this->stft);
+		blockStft.SetThreadCount(1);
+		SplitComplexBuffer spectra;
+
+		for (size_t i = 0; i < frameCount; i += FRAME_BLOCK_SIZE)
+		{
+			const size_t blockFrameCount = HEPH_MATH_MIN(FRAME_BLOCK_SIZE, frameCount - i);
+			const size_t blockStart = (firstFrameIndex + i) * hopSize;
+			const size_t blockSize = this->stft.CalculateSampleCount(blockFrameCount);
+
+			// frames past the end of the buffer are zero padded.
+			const AudioBuffer block = (blockStart < buffer.FrameCount())
+				? (buffer.SubBuffer(blockStart, blockSize))
+				: (AudioBuffer(blockSize, formatInfo.channelLayout, formatInfo.sampleRate));
+			blockStft.Analyze(block, channelIndex, spectra);
+
+			for (size_t j = 0; j < blockFrameCount; ++j)
+			{
+				const double* const pSpectrumReal = spectra.Real() + j * fftBinCount;
+				const double* const pSpectrumImag = spectra.Imag() + j * fftBinCount;
+				double* const pFrameOutput = pOutput + (i + j) * binCount;
+
+				for (size_t k = 0; k < binCount; ++k)
+				{
+					const size_t kernelSize = this->kernelOffsets[k + 1] - this->kernelOffsets[k];
+					const double* const pKernelReal = this->kernelReal.data() + this->kernelOffsets[k];
+					const double* const pKernelImag = this->kernelImag.data() + this->kernelOffsets[k];
+					const double* const pBinReal = pSpectrumReal + this->kernelStartBins[k];
+					const double* const pBinImag = pSpectrumImag + this->kernelStartBins[k];
+
+					double re = 0.0, im = 0.0;
+					for (size_t l = 0; l < kernelSize; ++l)
+					{
+						re += pBinReal[l] * pKernelReal[l] - pBinImag[l] * pKernelImag[l];
+						im += pBinReal[l] * pKernelImag[l] + pBinImag[l] * pKernelReal[l];
+					}
+
+					const double power = re * re + im * im;
+					switch (outputType)
+					{
+					case StftOutputType::Power:
+						pFrameOutput[k] = power;
+						break;
+					case StftOutputType::Decibel:
+						pFrameOutput[k] = GainToDecibel(sqrt(power));
+						break;
+					case StftOutputType::Magnitude:
+					default:
+						pFrameOutput[k] = sqrt(power);
+						break;
+					}
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
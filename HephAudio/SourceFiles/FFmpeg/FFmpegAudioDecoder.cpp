@@ -1,19 +1,29 @@
 #include "FFmpeg/FFmpegAudioDecoder.h"
+#include "SampleFormatConverter.h"
+#include "HephMath.h"
 #include "ConsoleLogger.h"
 #include "Exceptions/ExternalException.h"
 #include "Exceptions/InsufficientMemoryException.h"
 #include "Exceptions/InvalidArgumentException.h"
 #include "Exceptions/InvalidOperationException.h"
 #include "Exceptions/NotFoundException.h"
+#include <algorithm>
+#include <exception>
+#include <thread>
 
 using namespace Heph;
 
 namespace HephAudio
 {
+	// shorter segments are not worth opening another decoder for.
+	static constexpr size_t PARALLEL_DECODE_MIN_SEGMENT_FRAME_COUNT = 1 << 20;
+
 	FFmpegAudioDecoder::FFmpegAudioDecoder()
 		: fileDuration_frame(0), audioStreamIndex(FFmpegAudioDecoder::AUDIO_STREAM_INDEX_NOT_FOUND)
 		, firstPacketPts(0), avFormatContext(nullptr), avCodecContext(nullptr)
-		, swrContext(nullptr), avFrame(nullptr), avPacket(nullptr) {}
+		, swrContext(nullptr), avFrame(nullptr), avPacket(nullptr)
+		, isSeekIndexBuilt(false), isSeekIndexPersistent(false), pendingSkipFrameCount(0)
+		, primingFrameCount(0), threadCount(1) {}
 
 	FFmpegAudioDecoder::FFmpegAudioDecoder(const std::filesystem::path& filePath) : FFmpegAudioDecoder()
 	{
@@ -24,6 +34,9 @@ namespace HephAudio
 		: fileDuration_frame(rhs.fileDuration_frame), audioStreamIndex(rhs.audioStreamIndex)
 		, firstPacketPts(rhs.firstPacketPts), avFormatContext(rhs.avFormatContext), avCodecContext(rhs.avCodecContext)
 		, swrContext(rhs.swrContext), avFrame(rhs.avFrame), avPacket(rhs.avPacket)
+		, seekIndex(std::move(rhs.seekIndex)), isSeekIndexBuilt(rhs.isSeekIndexBuilt)
+		, isSeekIndexPersistent(rhs.isSeekIndexPersistent), pendingSkipFrameCount(rhs.pendingSkipFrameCount)
+		, primingFrameCount(rhs.primingFrameCount), threadCount(rhs.threadCount)
 	{
 		this->filePath = std::move(rhs.filePath);
 
@@ -54,6 +67,12 @@ namespace HephAudio
 			this->swrContext = rhs.swrContext;
 			this->avFrame = rhs.avFrame;
 			this->avPacket = rhs.avPacket;
+			this->seekIndex = std::move(rhs.seekIndex);
+			this->isSeekIndexBuilt = rhs.isSeekIndexBuilt;
+			this->isSeekIndexPersistent = rhs.isSeekIndexPersistent;
+			this->pendingSkipFrameCount = rhs.pendingSkipFrameCount;
+			this->primingFrameCount = rhs.primingFrameCount;
+			this->threadCount = rhs.threadCount;
 
 			rhs.avFormatContext = nullptr;
 			rhs.avCodecContext = nullptr;
@@ -110,6 +129,10 @@ namespace HephAudio
 		this->fileDuration_frame = 0;
 		this->audioStreamIndex = FFmpegAudioDecoder::AUDIO_STREAM_INDEX_NOT_FOUND;
 		this->firstPacketPts = 0;
+		this->seekIndex.clear();
+		this->isSeekIndexBuilt = false;
+		this->pendingSkipFrameCount = 0;
+		this->primingFrameCount = 0;
 	}
 
 	bool FFmpegAudioDecoder::IsFileOpen() const
@@ -144,11 +167,30 @@ namespace HephAudio
 			HEPH_RAISE_EXCEPTION(this, ExternalException(HEPH_FUNC, "Failed to seek frame.", "FFmpeg", HEPHAUDIO_FFMPEG_GET_ERROR_MESSAGE(ret)));
 			return false;
 		}
+
+		// the next decode starts from the requested frame instead of the beginning of the packet.
+		this->pendingSkipFrameCount = frameIndex;
 		return true;
 	}
 
 	AudioBuffer FFmpegAudioDecoder::Decode()
 	{
+		const size_t threadCount = this->threadCount == 0 ? std::thread::hardware_concurrency() : this->threadCount;
+		const size_t segmentCount = HEPH_MATH_MIN(threadCount, this->fileDuration_frame / PARALLEL_DECODE_MIN_SEGMENT_FRAME_COUNT);
+		if (segmentCount > 1 && this->IsFileOpen())
+		{
+			if (!this->isSeekIndexBuilt)
+			{
+				this->ScanSeekIndex();
+			}
+
+			// segments start at the indexed packets, so they can only be decoded separately if the file can be seeked exactly.
+			if (this->seekIndex.size() >= segmentCount)
+			{
+				return this->DecodeParallel(segmentCount);
+			}
+		}
+
 		return this->Decode(0, this->fileDuration_frame);
 	}
 
@@ -160,100 +202,10 @@ namespace HephAudio
 			return AudioBuffer(frameCount, this->GetOutputFormatInfo().channelLayout, this->GetOutputFormatInfo().sampleRate);
 		}
 
-		int ret = 0;
-		AudioFormatInfo outputFormatInfo = this->GetOutputFormatInfo();
-		size_t readFrameCount = 0;
+		// frames past the end of the file are left silent.
+		const AudioFormatInfo outputFormatInfo = this->GetOutputFormatInfo();
 		AudioBuffer decodedBuffer(frameCount, outputFormatInfo.channelLayout, outputFormatInfo.sampleRate);
-		AVStream* avStream = this->avFormatContext->streams[this->audioStreamIndex];
-
-		// convert the decoded data to inner format
-		(void)av_opt_set_chlayout(this->swrContext, "in_chlayout", &avStream->codecpar->ch_layout, 0);
-		(void)av_opt_set_int(this->swrContext, "in_sample_rate", avStream->codecpar->sample_rate, 0);
-		(void)av_opt_set_sample_fmt(this->swrContext, "in_sample_fmt", (AVSampleFormat)avStream->codecpar->format, 0);
-
-		ret = swr_init(this->swrContext);
-		if (ret < 0)
-		{
-			HEPH_RAISE_AND_THROW_EXCEPTION(this, ExternalException(HEPH_FUNC, "Failed to initialize SwrContext.", "FFmpeg", HEPHAUDIO_FFMPEG_GET_ERROR_MESSAGE(ret)));
-		}
-
-		while (readFrameCount < frameCount)
-		{
-			// get the next frame from file
-			ret = av_read_frame(this->avFormatContext, this->avPacket);
-			if (ret == AVERROR_EOF)
-			{
-				HEPHAUDIO_LOG("EOF, no more frames to read.", HEPH_CL_INFO);
-				return decodedBuffer;
-			}
-			else if (ret < 0)
-			{
-				HEPHAUDIO_LOG("Failed to read the frame, skipping it...", HEPH_CL_WARNING);
-				continue;
-			}
-
-			if (this->avPacket->stream_index == this->audioStreamIndex)
-			{
-				// send the packet to the decoder
-				ret = avcodec_send_packet(this->avCodecContext, this->avPacket);
-				if (ret == AVERROR_EOF)
-				{
-					av_packet_unref(this->avPacket);
-					HEPHAUDIO_LOG("EOF, no more frames to read.", HEPH_CL_INFO);
-					return decodedBuffer;
-				}
-				else if (ret < 0)
-				{
-					av_packet_unref(this->avPacket);
-					HEPHAUDIO_LOG("Failed to decode the packet, skipping it...", HEPH_CL_WARNING);
-					continue;
-				}
-
-				while (avcodec_receive_frame(this->avCodecContext, this->avFrame) >= 0)
-				{
-					const size_t currentFrameCount = this->avFrame->nb_samples;
-					if (currentFrameCount > 0)
-					{
-						if (readFrameCount + currentFrameCount > frameCount)
-						{
-							decodedBuffer.Resize(readFrameCount + currentFrameCount);
-						}
-
-						AudioBuffer tempBuffer(currentFrameCount, outputFormatInfo.channelLayout, outputFormatInfo.sampleRate, BufferFlags::AllocUninitialized);
-						uint8_t* targetOutputFrame = (uint8_t*)tempBuffer.begin();
-						ret = swr_convert(this->swrContext, &targetOutputFrame, currentFrameCount, (const uint8_t**)this->avFrame->data, currentFrameCount);
-						if (ret < 0)
-						{
-							av_packet_unref(this->avPacket);
-							av_frame_unref(this->avFrame);
-							HEPH_RAISE_AND_THROW_EXCEPTION(this, ExternalException(HEPH_FUNC, "Failed to decode samples.", "FFmpeg", HEPHAUDIO_FFMPEG_GET_ERROR_MESSAGE(ret)));
-						}
-						else if (ret < currentFrameCount)
-						{
-							ret = swr_convert(this->swrContext, &targetOutputFrame, currentFrameCount, nullptr, 0);
-							if (ret < 0)
-							{
-								av_packet_unref(this->avPacket);
-								av_frame_unref(this->avFrame);
-								HEPH_RAISE_AND_THROW_EXCEPTION(this, ExternalException(HEPH_FUNC, "Failed to decode samples.", "FFmpeg", HEPHAUDIO_FFMPEG_GET_ERROR_MESSAGE(ret)));
-							}
-						}
-
-						for (size_t i = 0; i < currentFrameCount; i++)
-						{
-							for (size_t j = 0; j < outputFormatInfo.channelLayout.count; j++)
-							{
-								decodedBuffer[i + readFrameCount][j] = tempBuffer[i][j];
-							}
-						}
-
-						readFrameCount += currentFrameCount;
-					}
-					av_frame_unref(this->avFrame);
-				}
-			}
-			av_packet_unref(this->avPacket);
-		}
+		(void)this->DecodeInto(decodedBuffer.begin(), frameCount);
 
 		return decodedBuffer;
 	}
@@ -279,36 +231,45 @@ namespace HephAudio
 			frameCount = this->fileDuration_frame - frameIndex;
 		}
 
-		int ret = this->SeekFrame(frameIndex);
-		if (ret < 0)
+		AudioBuffer decodedBuffer(frameCount, outputFormatInfo.channelLayout, outputFormatInfo.sampleRate);
+		if (this->Seek(frameIndex))
 		{
-			HEPH_RAISE_EXCEPTION(this, ExternalException(HEPH_FUNC, "Failed to seek frame.", "FFmpeg", HEPHAUDIO_FFMPEG_GET_ERROR_MESSAGE(ret)));
-			return AudioBuffer(frameCount, outputFormatInfo.channelLayout, outputFormatInfo.sampleRate);
+			(void)this->DecodeInto(decodedBuffer.begin(), frameCount);
 		}
 
-		size_t readFrameCount = 0;
-		AudioBuffer decodedBuffer(frameCount, outputFormatInfo.channelLayout, outputFormatInfo.sampleRate);
-		AVStream* avStream = this->avFormatContext->streams[this->audioStreamIndex];
-
-		// convert the decoded data to inner format
-		(void)av_opt_set_chlayout(this->swrContext, "in_chlayout", &avStream->codecpar->ch_layout, 0);
-		(void)av_opt_set_int(this->swrContext, "in_sample_rate", avStream->codecpar->sample_rate, 0);
-		(void)av_opt_set_sample_fmt(this->swrContext, "in_sample_fmt", (AVSampleFormat)avStream->codecpar->format, 0);
+		return decodedBuffer;
+	}
 
-		ret = swr_init(this->swrContext);
-		if (ret < 0)
+	size_t FFmpegAudioDecoder::DecodeInto(heph_audio_sample_t* pOutput, size_t frameCount)
+	{
+		if (!this->IsFileOpen())
 		{
-			HEPH_RAISE_AND_THROW_EXCEPTION(this, ExternalException(HEPH_FUNC, "Failed to initialize SwrContext.", "FFmpeg", HEPHAUDIO_FFMPEG_GET_ERROR_MESSAGE(ret)));
+			HEPH_RAISE_EXCEPTION(this, InvalidOperationException(HEPH_FUNC, "No open file to decode."));
+			return 0;
 		}
 
+		const size_t channelCount = this->GetOutputFormatInfo().channelLayout.count;
+
+		// the samples that did not fit into the output of the previous call are written first.
+		size_t readFrameCount = this->ConvertFrame(nullptr, pOutput, frameCount);
+
+		int ret = 0;
+		bool isEndOfFile = false;
 		while (readFrameCount < frameCount)
 		{
 			// get the next frame from file
 			ret = av_read_frame(this->avFormatContext, this->avPacket);
 			if (ret == AVERROR_EOF)
 			{
-				HEPHAUDIO_LOG("EOF, no more frames to read.", HEPH_CL_INFO);
-				return decodedBuffer;
+				if (isEndOfFile)
+				{
+					HEPHAUDIO_LOG("EOF, no more frames to read.", HEPH_CL_INFO);
+					break;
+				}
+
+				// the blank packet flushes the frames the codec still holds, e.g. when it decodes on multiple threads.
+				isEndOfFile = true;
+				this->avPacket->stream_index = this->audioStreamIndex;
 			}
 			else if (ret < 0)
 			{
@@ -324,7 +285,7 @@ namespace HephAudio
 				{
 					av_packet_unref(this->avPacket);
 					HEPHAUDIO_LOG("EOF, no more frames to read.", HEPH_CL_INFO);
-					return decodedBuffer;
+					break;
 				}
 				else if (ret < 0)
 				{
@@ -333,75 +294,33 @@ namespace HephAudio
 					continue;
 				}
 
-				while (readFrameCount < frameCount && avcodec_receive_frame(this->avCodecContext, this->avFrame) >= 0)
+				// every frame of the packet must be received before sending the next one.
+				while (avcodec_receive_frame(this->avCodecContext, this->avFrame) >= 0)
 				{
-					size_t currentFrameCount = this->avFrame->nb_samples;
-					size_t currentFramesToRead = currentFrameCount;
-					if (currentFrameCount > 0)
-					{
-						// prevent overflow
-						if (frameIndex > 0)
-						{
-							if (frameIndex >= currentFrameCount)
-							{
-								currentFrameCount = av_rescale(this->avFrame->duration * this->avFrame->sample_rate, avStream->time_base.num, avStream->time_base.den);
-								if (frameIndex >= currentFrameCount)
-								{
-									frameIndex -= currentFrameCount;
-									av_frame_unref(this->avFrame);
-									continue;
-								}
-							}
-
-							if (frameIndex + frameCount > currentFrameCount)
-							{
-								currentFramesToRead = currentFrameCount - frameIndex;
-							}
-						}
-
-						if (readFrameCount + currentFramesToRead > frameCount)
-						{
-							currentFramesToRead = frameCount - readFrameCount;
-						}
-
-						AudioBuffer tempBuffer(currentFrameCount, outputFormatInfo.channelLayout, outputFormatInfo.sampleRate, BufferFlags::AllocUninitialized);
-						uint8_t* targetOutputFrame = (uint8_t*)tempBuffer.begin();
-						ret = swr_convert(this->swrContext, &targetOutputFrame, currentFrameCount, (const uint8_t**)this->avFrame->data, currentFrameCount);
-						if (ret < 0)
-						{
-							av_packet_unref(this->avPacket);
-							av_frame_unref(this->avFrame);
-							HEPH_RAISE_AND_THROW_EXCEPTION(this, ExternalException(HEPH_FUNC, "Failed to decode samples.", "FFmpeg", HEPHAUDIO_FFMPEG_GET_ERROR_MESSAGE(ret)));
-						}
-						else if (ret < currentFrameCount)
-						{
-							ret = swr_convert(this->swrContext, &targetOutputFrame, currentFrameCount, nullptr, 0);
-							if (ret < 0)
-							{
-								av_packet_unref(this->avPacket);
-								av_frame_unref(this->avFrame);
-								HEPH_RAISE_AND_THROW_EXCEPTION(this, ExternalException(HEPH_FUNC, "Failed to decode samples.", "FFmpeg", HEPHAUDIO_FFMPEG_GET_ERROR_MESSAGE(ret)));
-							}
-						}
+					const size_t currentFrameCount = this->avFrame->nb_samples;
 
-						for (size_t i = 0; i < currentFramesToRead; i++)
-						{
-							for (size_t j = 0; j < outputFormatInfo.channelLayout.count; j++)
-							{
-								decodedBuffer[i + readFrameCount][j] = tempBuffer[i + frameIndex][j];
-							}
-						}
+					// discard the frames before the position of the last seek.
+					if (this->pendingSkipFrameCount >= currentFrameCount)
+					{
+						this->pendingSkipFrameCount -= currentFrameCount;
+						av_frame_unref(this->avFrame);
+						continue;
+					}
 
-						readFrameCount += currentFramesToRead;
-						frameIndex = 0;
+					if (this->pendingSkipFrameCount > 0)
+					{
+						(void)swr_drop_output(this->swrContext, (int)this->pendingSkipFrameCount);
+						this->pendingSkipFrameCount = 0;
 					}
+
+					readFrameCount += this->ConvertFrame(this->avFrame, pOutput + readFrameCount * channelCount, frameCount - readFrameCount);
 					av_frame_unref(this->avFrame);
 				}
 			}
 			av_packet_unref(this->avPacket);
 		}
 
-		return decodedBuffer;
+		return readFrameCount;
 	}
 
 	AudioBuffer FFmpegAudioDecoder::Decode(const EncodedAudioBuffer& encodedBuffer)
@@ -410,6 +329,15 @@ namespace HephAudio
 		const AudioFormatInfo& inputFormatInfo = encodedBuffer.GetAudioFormatInfo();
 		AudioFormatInfo outputFormatInfo = HEPHAUDIO_INTERNAL_FORMAT(inputFormatInfo.channelLayout, inputFormatInfo.sampleRate);
 
+		// raw PCM only needs a sample format conversion, skip creating a SwrContext.
+		if (dynamic_cast<const FFmpegEncodedAudioBuffer*>(&encodedBuffer) == nullptr && SampleFormatConverter::IsSupported(inputFormatInfo))
+		{
+			const size_t frameCount = encodedBuffer.Size() / inputFormatInfo.FrameSize();
+			AudioBuffer resultBuffer(frameCount, outputFormatInfo.channelLayout, outputFormatInfo.sampleRate, BufferFlags::AllocUninitialized);
+			SampleFormatConverter::ToInternal(encodedBuffer.begin(), inputFormatInfo, frameCount, resultBuffer);
+			return resultBuffer;
+		}
+
 		SwrContext* swrContext = swr_alloc();
 		if (swrContext == nullptr)
 		{
@@ -577,6 +505,54 @@ namespace HephAudio
 		return resultBuffer;
 	}
 
+	void FFmpegAudioDecoder::BuildSeekIndex()
+	{
+		if (!this->IsFileOpen())
+		{
+			HEPH_RAISE_EXCEPTION(this, InvalidOperationException(HEPH_FUNC, "No open file."));
+			return;
+		}
+
+		if (!this->isSeekIndexBuilt)
+		{
+			this->ScanSeekIndex();
+
+			size_t frameIndex = 0;
+			const int ret = this->SeekFrame(frameIndex);
+			if (ret < 0)
+			{
+				HEPH_RAISE_EXCEPTION(this, ExternalException(HEPH_FUNC, "Failed to seek frame.", "FFmpeg", HEPHAUDIO_FFMPEG_GET_ERROR_MESSAGE(ret)));
+				return;
+			}
+			this->pendingSkipFrameCount = frameIndex;
+		}
+	}
+
+	bool FFmpegAudioDecoder::HasSeekIndex() const
+	{
+		return !this->seekIndex.empty();
+	}
+
+	bool FFmpegAudioDecoder::IsSeekIndexPersistent() const
+	{
+		return this->isSeekIndexPersistent;
+	}
+
+	void FFmpegAudioDecoder::SetSeekIndexPersistent(bool isSeekIndexPersistent)
+	{
+		this->isSeekIndexPersistent = isSeekIndexPersistent;
+	}
+
+	size_t FFmpegAudioDecoder::GetThreadCount() const
+	{
+		return this->threadCount;
+	}
+
+	void FFmpegAudioDecoder::SetThreadCount(size_t threadCount)
+	{
+		this->threadCount = threadCount;
+	}
+
 	void FFmpegAudioDecoder::OpenFile(const std::filesystem::path& filePath)
 	{
 		if (!std::filesystem::exists(filePath))
@@ -631,6 +607,18 @@ namespace HephAudio
 		(void)av_opt_set_int(this->swrContext, "out_sample_rate", avStream->codecpar->sample_rate, 0);
 		(void)av_opt_set_sample_fmt(this->swrContext, "out_sample_fmt", HEPHAUDIO_FFMPEG_INTERNAL_SAMPLE_FMT, 0);
 
+		// the input format is fixed for the file, so the context is initialized once instead of on each decode call.
+		(void)av_opt_set_chlayout(this->swrContext, "in_chlayout", &avStream->codecpar->ch_layout, 0);
+		(void)av_opt_set_int(this->swrContext, "in_sample_rate", avStream->codecpar->sample_rate, 0);
+		(void)av_opt_set_sample_fmt(this->swrContext, "in_sample_fmt", (AVSampleFormat)avStream->codecpar->format, 0);
+
+		ret = swr_init(this->swrContext);
+		if (ret < 0)
+		{
+			this->CloseFile();
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, ExternalException(HEPH_FUNC, "Failed to initialize SwrContext.", "FFmpeg", HEPHAUDIO_FFMPEG_GET_ERROR_MESSAGE(ret)));
+		}
+
 		// Initialize codec for decoding
 		const AVCodec* avCodec = avcodec_find_decoder(this->avFormatContext->streams[audioStreamIndex]->codecpar->codec_id);
 		if (avCodec == nullptr)
@@ -654,6 +642,12 @@ namespace HephAudio
 			HEPH_RAISE_AND_THROW_EXCEPTION(this, ExternalException(HEPH_FUNC, "Failed to create codec context from the codec parameters.", "FFmpeg", HEPHAUDIO_FFMPEG_GET_ERROR_MESSAGE(ret)));
 		}
 
+		if (this->threadCount != 1 && (avCodec->capabilities & (AV_CODEC_CAP_FRAME_THREADS | AV_CODEC_CAP_SLICE_THREADS)) != 0)
+		{
+			this->avCodecContext->thread_count = (int)this->threadCount;
+			this->avCodecContext->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+		}
+
 		ret = avcodec_open2(this->avCodecContext, avCodec, nullptr);
 		if (ret < 0)
 		{
@@ -683,13 +677,66 @@ namespace HephAudio
 			HEPH_RAISE_AND_THROW_EXCEPTION(this, ExternalException(HEPH_FUNC, "Failed to get pts of the first packet.", "FFmpeg", HEPHAUDIO_FFMPEG_GET_ERROR_MESSAGE(ret)));
 		}
 		this->firstPacketPts = this->avPacket->pts;
+
+		// the codec discards the encoder delay at the beginning of the stream, but not after seeking into the middle of it.
+		size_t skipSamplesSize = 0;
+		const uint8_t* pSkipSamples = av_packet_get_side_data(this->avPacket, AV_PKT_DATA_SKIP_SAMPLES, &skipSamplesSize);
+		if (pSkipSamples != nullptr && skipSamplesSize >= 4)
+		{
+			this->primingFrameCount = (size_t)pSkipSamples[0] | ((size_t)pSkipSamples[1] << 8) | ((size_t)pSkipSamples[2] << 16) | ((size_t)pSkipSamples[3] << 24);
+		}
 		av_packet_unref(this->avPacket);
+
+		if (this->isSeekIndexPersistent)
+		{
+			this->isSeekIndexBuilt = AudioSeekIndex::Load(this->filePath, this->seekIndex);
+		}
+	}
+
+	size_t FFmpegAudioDecoder::ConvertFrame(const AVFrame* pFrame, heph_audio_sample_t* pOutput, size_t frameCount)
+	{
+		uint8_t* pOutputBytes = (uint8_t*)pOutput;
+		int ret = 0;
+
+		// the samples that don't fit into the output are kept by the SwrContext.
+		if (pFrame != nullptr)
+		{
+			ret = swr_convert(this->swrContext, &pOutputBytes, (int)frameCount, (const uint8_t**)pFrame->data, pFrame->nb_samples);
+		}
+		else if (frameCount > 0 && swr_get_out_samples(this->swrContext, 0) > 0)
+		{
+			ret = swr_convert(this->swrContext, &pOutputBytes, (int)frameCount, nullptr, 0);
+		}
+
+		if (ret < 0)
+		{
+			av_packet_unref(this->avPacket);
+			av_frame_unref(this->avFrame);
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, ExternalException(HEPH_FUNC, "Failed to decode samples.", "FFmpeg", HEPHAUDIO_FFMPEG_GET_ERROR_MESSAGE(ret)));
+		}
+
+		return ret;
 	}
 
 	int FFmpegAudioDecoder::SeekFrame(size_t& frameIndex)
 	{
 		constexpr int seekFlags = AVSEEK_FLAG_BACKWARD | AVSEEK_FLAG_FRAME;
 
+		// drop the converted samples of the old position.
+		(void)swr_init(this->swrContext);
+		this->pendingSkipFrameCount = 0;
+
+		// seeking to the beginning does not need the index, which keeps looping streams from scanning the file.
+		if (frameIndex > 0 && !this->isSeekIndexBuilt)
+		{
+			this->ScanSeekIndex();
+		}
+
+		if (!this->seekIndex.empty())
+		{
+			return this->SeekFrameIndexed(frameIndex);
+		}
+
 		int ret = 0;
 		bool endSeek = false;
 		AVStream* avStream = this->avFormatContext->streams[this->audioStreamIndex];
@@ -759,4 +806,173 @@ namespace HephAudio
 
 		return 0;
 	}
+
+	AudioBuffer FFmpegAudioDecoder::DecodeParallel(size_t segmentCount)
+	{
+		const AudioFormatInfo outputFormatInfo = this->GetOutputFormatInfo();
+		const size_t segmentFrameCount = (this->fileDuration_frame + segmentCount - 1) / segmentCount;
+		AudioBuffer resultBuffer(this->fileDuration_frame, outputFormatInfo.channelLayout, outputFormatInfo.sampleRate);
+
+		auto decodeSegment = [this, &resultBuffer, segmentFrameCount](FFmpegAudioDecoder& decoder, size_t segmentIndex)
+			{
+				const size_t frameIndex = segmentIndex * segmentFrameCount;
+				const size_t frameCount = HEPH_MATH_MIN(segmentFrameCount, this->fileDuration_frame - frameIndex);
+				return decoder.Seek(frameIndex) && decoder.DecodeInto(resultBuffer[frameIndex], frameCount) == frameCount;
+			};
+
+		// each segment is decoded by its own decoder instance that shares the seek index, the first one by this instance.
+		std::vector<std::exception_ptr> exceptions(segmentCount);
+		std::vector<uint8_t> isDecoded(segmentCount, 0);
+		std::vector<std::thread> threads;
+		threads.reserve(segmentCount - 1);
+		for (size_t i = 1; i < segmentCount; i++)
+		{
+			threads.emplace_back([this, i, &exceptions, &isDecoded, &decodeSegment]()
+				{
+					try
+					{
+						FFmpegAudioDecoder decoder;
+						decoder.OpenFile(this->filePath);
+						decoder.seekIndex = this->seekIndex;
+						decoder.isSeekIndexBuilt = true;
+						isDecoded[i] = decodeSegment(decoder, i);
+					}
+					catch (...)
+					{
+						exceptions[i] = std::current_exception();
+					}
+				});
+		}
+
+		try
+		{
+			isDecoded[0] = decodeSegment(*this, 0);
+		}
+		catch (...)
+		{
+			exceptions[0] = std::current_exception();
+		}
+
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+
+		for (const std::exception_ptr& exception : exceptions)
+		{
+			if (exception != nullptr)
+			{
+				std::rethrow_exception(exception);
+			}
+		}
+
+		// a segment that could not be seeked to or ended early would be left silent.
+		if (std::find(isDecoded.begin(), isDecoded.end(), 0) != isDecoded.end())
+		{
+			HEPHAUDIO_LOG("Failed to decode \"" + this->filePath.filename().string() + "\" in parallel, decoding it serially.", HEPH_CL_WARNING);
+			return this->Decode(0, this->fileDuration_frame);
+		}
+
+		return resultBuffer;
+	}
+
+	int FFmpegAudioDecoder::SeekFrameIndexed(size_t& frameIndex)
+	{
+		AVStream* avStream = this->avFormatContext->streams[this->audioStreamIndex];
+
+		// start decoding a bit earlier so the decoders that depend on the previous packets (bit reservoir, overlapping windows) are primed.
+		const size_t prerollFrameCount = HEPH_MATH_MAX((size_t)avStream->codecpar->seek_preroll, (size_t)avStream->codecpar->frame_size * 2);
+		const size_t targetFrameIndex = frameIndex > prerollFrameCount ? frameIndex - prerollFrameCount : 0;
+
+		auto it = std::upper_bound(this->seekIndex.begin(), this->seekIndex.end(), targetFrameIndex,
+			[](size_t frameIndex, const SeekPoint& seekPoint) { return frameIndex < seekPoint.frameIndex; });
+		if (it != this->seekIndex.begin())
+		{
+			--it;
+		}
+		if (frameIndex > 0 && it != this->seekIndex.begin())
+		{
+			--it;
+		}
+
+		// seek to the beginning by timestamp so the encoder delay is discarded the same way as when decoding the whole file.
+		if (it == this->seekIndex.begin())
+		{
+			const int ret = avformat_seek_file(this->avFormatContext, this->audioStreamIndex, INT64_MIN, this->firstPacketPts, this->firstPacketPts, AVSEEK_FLAG_BACKWARD);
+			if (ret < 0)
+			{
+				return ret;
+			}
+			avcodec_flush_buffers(this->avCodecContext);
+			return 0;
+		}
+
+		const int ret = avformat_seek_file(this->avFormatContext, -1, INT64_MIN, it->pos, INT64_MAX, AVSEEK_FLAG_BYTE);
+		if (ret < 0)
+		{
+			return ret;
+		}
+		avcodec_flush_buffers(this->avCodecContext);
+
+		frameIndex += this->primingFrameCount;
+		frameIndex = frameIndex > it->frameIndex ? frameIndex - it->frameIndex : 0;
+		return 0;
+	}
+
+	void FFmpegAudioDecoder::ScanSeekIndex()
+	{
+		this->isSeekIndexBuilt = true;
+		this->seekIndex.clear();
+
+		if ((this->avFormatContext->iformat->flags & AVFMT_NO_BYTE_SEEK) != 0)
+		{
+			HEPHAUDIO_LOG("The container does not support seeking by byte offset, seeking without the index.", HEPH_CL_INFO);
+			return;
+		}
+
+		AVStream* avStream = this->avFormatContext->streams[this->audioStreamIndex];
+		int ret = avformat_seek_file(this->avFormatContext, this->audioStreamIndex, INT64_MIN, this->firstPacketPts, this->firstPacketPts, AVSEEK_FLAG_BACKWARD);
+		if (ret < 0)
+		{
+			HEPHAUDIO_LOG("Failed to seek to the first packet, seeking without the index.", HEPH_CL_WARNING);
+			return;
+		}
+
+		// only the packets are read, nothing is decoded.
+		size_t frameIndex = 0;
+		while ((ret = av_read_frame(this->avFormatContext, this->avPacket)) >= 0)
+		{
+			if (this->avPacket->stream_index == this->audioStreamIndex)
+			{
+				if (this->avPacket->pts != AV_NOPTS_VALUE && this->avPacket->pts >= this->firstPacketPts)
+				{
+					frameIndex = av_rescale((this->avPacket->pts - this->firstPacketPts) * avStream->codecpar->sample_rate, avStream->time_base.num, avStream->time_base.den);
+				}
+
+				// packets that share the byte offset of the previous one (e.g. in the same ogg page) are reached by decoding forward.
+				if (this->avPacket->pos >= 0 && (this->seekIndex.empty() ||
+					(this->seekIndex.back().pos < this->avPacket->pos && this->seekIndex.back().frameIndex <= frameIndex)))
+				{
+					this->seekIndex.push_back({ this->avPacket->pos, frameIndex });
+				}
+
+				frameIndex += av_rescale(this->avPacket->duration * avStream->codecpar->sample_rate, avStream->time_base.num, avStream->time_base.den);
+			}
+			av_packet_unref(this->avPacket);
+		}
+
+		if (ret != AVERROR_EOF)
+		{
+			HEPHAUDIO_LOG("Failed to read the packets, seeking without the index.", HEPH_CL_WARNING);
+			this->seekIndex.clear();
+			return;
+		}
+
+		HEPHAUDIO_LOG("Built the seek index of \"" + this->filePath.filename().string() + "\" with " + std::to_string(this->seekIndex.size()) + " entries.", HEPH_CL_INFO);
+
+		if (this->isSeekIndexPersistent)
+		{
+			(void)AudioSeekIndex::Save(this->filePath, this->seekIndex);
+		}
+	}
 }
\ No newline at end of file
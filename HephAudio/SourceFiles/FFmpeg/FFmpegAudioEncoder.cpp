@@ -1,6 +1,7 @@
 #include "FFmpeg/FFmpegAudioEncoder.h"
 #include "FFmpeg/FFmpegAudioDecoder.h"
 #include "AudioEffects/Resampler.h"
+#include "SampleFormatConverter.h"
 #include "HephMath.h"
 #include "ConsoleLogger.h"
 #include "Exceptions/Exception.h"
@@ -258,6 +259,17 @@ namespace HephAudio
 		const AudioFormatInfo& inputFormatInfo = inputBuffer.FormatInfo();
 		const AudioFormatInfo& outputFormatInfo = outputBuffer.GetAudioFormatInfo();
 
+		// raw PCM with the same layout and sample rate only needs a sample format conversion, skip creating a SwrContext.
+		if (dynamic_cast<FFmpegEncodedAudioBuffer*>(&outputBuffer) == nullptr &&
+			inputFormatInfo.channelLayout == outputFormatInfo.channelLayout &&
+			inputFormatInfo.sampleRate == outputFormatInfo.sampleRate &&
+			SampleFormatConverter::IsSupported(outputFormatInfo))
+		{
+			outputBuffer.Resize(inputBuffer.FrameCount() * outputFormatInfo.FrameSize());
+			SampleFormatConverter::FromInternal(inputBuffer, outputBuffer.begin(), outputFormatInfo);
+			return;
+		}
+
 		SwrContext* swrContext = swr_alloc();
 		if (swrContext == nullptr)
 		{
@@ -0,0 +1,55 @@
+#include "IAudioDecoder.h"
+#include "HephMath.h"
+#include "Exceptions/InvalidArgumentException.h"
+
+using namespace Heph;
+
+namespace HephAudio
+{
+	size_t IAudioDecoder::DecodeInto(AudioBuffer& buffer, size_t frameIndex, size_t frameCount)
+	{
+		if (buffer.FormatInfo().channelLayout.count != this->GetOutputFormatInfo().channelLayout.count)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "Channel count of the buffer must match the output format."));
+		}
+
+		if (frameIndex > buffer.FrameCount() || frameCount > buffer.FrameCount() - frameIndex)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "Frames out of the bounds of the buffer."));
+		}
+
+		return frameCount > 0 ? this->DecodeInto(buffer[frameIndex], frameCount) : 0;
+	}
+
+	size_t IAudioDecoder::DecodeInto(AudioRingBuffer& ringBuffer, size_t frameCount)
+	{
+		if (ringBuffer.FormatInfo().channelLayout.count != this->GetOutputFormatInfo().channelLayout.count)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "Channel count of the ring buffer must match the output format."));
+		}
+
+		// the writable space wraps around at most once.
+		size_t writtenFrameCount = 0;
+		while (writtenFrameCount < frameCount)
+		{
+			heph_audio_sample_t* pRegion = nullptr;
+			const size_t writableFrameCount = ringBuffer.GetWriteRegion(&pRegion);
+			const size_t regionFrameCount = HEPH_MATH_MIN(writableFrameCount, frameCount - writtenFrameCount);
+			if (regionFrameCount == 0)
+			{
+				break;
+			}
+
+			const size_t decodedFrameCount = this->DecodeInto(pRegion, regionFrameCount);
+			ringBuffer.CommitWrite(decodedFrameCount);
+			writtenFrameCount += decodedFrameCount;
+
+			if (decodedFrameCount < regionFrameCount)
+			{
+				break;
+			}
+		}
+
+		return writtenFrameCount;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,260 @@
+#include "MfccExtractor.h"
+#include "Fourier.h"
+#include "HephMath.h"
+#include "Exceptions/InvalidArgumentException.h"
+#include <cmath>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <exception>
+
+using namespace Heph;
+
+namespace HephAudio
+{
+	// number of frames decoded at a time while extracting the features of a file.
+	static constexpr size_t DECODE_BLOCK_FRAME_COUNT = 16384;
+
+	// filter outputs are clamped to this value before taking the logarithm.
+	static constexpr double MIN_ENERGY = 1e-10;
+
+	MfccExtractor::MfccExtractor(const Window& wnd, size_t hopSize, uint32_t sampleRate, size_t filterCount, size_t coefficientCount)
+		: MfccExtractor(StftAnalyzer(wnd, hopSize), SpectralFilterbank(FrequencyScale::Mel, filterCount, Fourier::CalculateFFTSize(wnd.GetSize()), sampleRate, 0, sampleRate * 0.5), coefficientCount) {}
+
+	MfccExtractor::MfccExtractor(const StftAnalyzer& stft, const SpectralFilterbank& filterbank, size_t coefficientCount)
+		: stft(stft), filterbank(filterbank), coefficientCount(coefficientCount)
+	{
+		const size_t filterCount = this->filterbank.GetFilterCount();
+
+		if (this->filterbank.GetBinCount() != this->stft.GetBinCount())
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "the filterbank and the STFT must have the same number of bins."));
+		}
+		if (coefficientCount == 0 || coefficientCount > filterCount)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "coefficientCount must be in the range of [1, filterCount]."));
+		}
+
+		// orthonormal DCT-II
+		this->dctMatrix.resize(coefficientCount * filterCount);
+		for (size_t i = 0; i < coefficientCount; ++i)
+		{
+			const double scale = sqrt(((i == 0) ? (1.0) : (2.0)) / filterCount);
+			for (size_t j = 0; j < filterCount; ++j)
+			{
+				this->dctMatrix[i * filterCount + j] = scale * cos(HEPH_MATH_PI * i * (j + 0.5) / filterCount);
+			}
+		}
+	}
+
+	const StftAnalyzer& MfccExtractor::GetStftAnalyzer() const
+	{
+		return this->stft;
+	}
+
+	const SpectralFilterbank& MfccExtractor::GetFilterbank() const
+	{
+		return this->filterbank;
+	}
+
+	size_t MfccExtractor::GetCoefficientCount() const
+	{
+		return this->coefficientCount;
+	}
+
+	size_t MfccExtractor::GetThreadCount() const
+	{
+		return this->stft.GetThreadCount();
+	}
+
+	void MfccExtractor::SetThreadCount(size_t threadCount)
+	{
+		this->stft.SetThreadCount(threadCount);
+	}
+
+	size_t MfccExtractor::CalculateFrameCount(size_t sampleCount) const
+	{
+		return this->stft.CalculateFrameCount(sampleCount);
+	}
+
+	void MfccExtractor::ExtractLogEnergies(const AudioBuffer& buffer, size_t channelIndex, double* pOutput) const
+	{
+		if (pOutput == nullptr)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "pOutput must not be nullptr."));
+		}
+
+		const size_t frameCount = this->CalculateFrameCount(buffer.FrameCount());
+		if (frameCount == 0)
+		{
+			return;
+		}
+
+		std::vector<double> powerSpectra(frameCount * this->stft.GetBinCount());
+		this->stft.Analyze(buffer, channelIndex, StftOutputType::Power, powerSpectra.data());
+		this->ProcessFrames(powerSpectra.data(), frameCount, pOutput, nullptr);
+	}
+
+	void MfccExtractor::Extract(const AudioBuffer& buffer, size_t channelIndex, double* pOutput) const
+	{
+		if (pOutput == nullptr)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "pOutput must not be nullptr."));
+		}
+
+		const size_t frameCount = this->CalculateFrameCount(buffer.FrameCount());
+		if (frameCount == 0)
+		{
+			return;
+		}
+
+		std::vector<double> powerSpectra(frameCount * this->stft.GetBinCount());
+		std::vector<double> energies(frameCount * this->filterbank.GetFilterCount());
+		this->stft.Analyze(buffer, channelIndex, StftOutputType::Power, powerSpectra.data());
+		this->ProcessFrames(powerSpectra.data(), frameCount, energies.data(), pOutput);
+	}
+
+	std::vector<double> MfccExtractor::Extract(IAudioDecoder& decoder, size_t channelIndex) const
+	{
+		const AudioFormatInfo formatInfo = decoder.GetOutputFormatInfo();
+		if (channelIndex >= formatInfo.channelLayout.count)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "channelIndex out of bounds."));
+		}
+
+		StftAnalyzer streamAnalyzer(this->stft);
+		streamAnalyzer.Reset();
+
+		AudioBuffer block(DECODE_BLOCK_FRAME_COUNT, formatInfo.channelLayout, formatInfo.sampleRate, BufferFlags::AllocUninitialized);
+		std::vector<double> powerSpectra;
+		std::vector<double> energies;
+		std::vector<double> result;
+		size_t sampleCount = 0;
+		size_t frameCount = 0;
+
+		const auto processAvailableFrames = [&]()
+			{
+				const size_t availableFrameCount = streamAnalyzer.GetAvailableFrameCount();
+				if (availableFrameCount > 0)
+				{
+					powerSpectra.resize(availableFrameCount * this->stft.GetBinCount());
+					energies.resize(availableFrameCount * this->filterbank.GetFilterCount());
+					result.resize((frameCount + availableFrameCount) * this->coefficientCount);
+
+					(void)streamAnalyzer.Pop(StftOutputType::Power, powerSpectra.data(), availableFrameCount);
+					this->ProcessFrames(powerSpectra.data(), availableFrameCount, energies.data(), result.data() + frameCount * this->coefficientCount);
+					frameCount += availableFrameCount;
+				}
+			};
+
+		size_t decodedFrameCount;
+		do
+		{
+			decodedFrameCount = decoder.DecodeInto(block, 0, DECODE_BLOCK_FRAME_COUNT);
+			if (decodedFrameCount > 0)
+			{
+				streamAnalyzer.Push((decodedFrameCount == DECODE_BLOCK_FRAME_COUNT) ? (block) : (block.SubBuffer(0, decodedFrameCount)), channelIndex);
+				sampleCount += decodedFrameCount;
+				processAvailableFrames();
+			}
+		} while (decodedFrameCount == DECODE_BLOCK_FRAME_COUNT);
+
+		// zero pad the last frame like the whole buffer analysis does.
+		const size_t totalFrameCount = this->CalculateFrameCount(sampleCount);
+		if (frameCount < totalFrameCount)
+		{
+			streamAnalyzer.Push(AudioBuffer(this->stft.CalculateSampleCount(totalFrameCount) - sampleCount, formatInfo.channelLayout, formatInfo.sampleRate), channelIndex);
+			processAvailableFrames();
+		}
+
+		return result;
+	}
+
+	std::vector<std::vector<double>> MfccExtractor::Extract(const std::vector<std::filesystem::path>& filePaths, size_t channelIndex, const DecoderFactory& decoderFactory) const
+	{
+		if (!decoderFactory)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "decoderFactory must not be empty."));
+		}
+
+		std::vector<std::vector<double>> results(filePaths.size());
+		std::atomic<size_t> nextFileIndex = 0;
+		std::exception_ptr pException = nullptr;
+		std::mutex exceptionMutex;
+
+		// each thread takes the next file until all are processed or a file fails.
+		const auto worker = [&]()
+			{
+				try
+				{
+					std::shared_ptr<IAudioDecoder> pDecoder = decoderFactory();
+					for (size_t i = nextFileIndex++; i < filePaths.size(); i = nextFileIndex++)
+					{
+						pDecoder->ChangeFile(filePaths[i]);
+						results[i] = this->Extract(*pDecoder, channelIndex);
+						pDecoder->CloseFile();
+					}
+				}
+				catch (...)
+				{
+					std::lock_guard<std::mutex> lockGuard(exceptionMutex);
+					if (pException == nullptr)
+					{
+						pException = std::current_exception();
+					}
+					nextFileIndex = filePaths.size();
+				}
+			};
+
+		const size_t threadCount = HEPH_MATH_MIN(this->stft.GetThreadCount(), filePaths.size());
+		std::vector<std::thread> threads;
+		for (size_t i = 1; i < threadCount; ++i)
+		{
+			threads.push_back(std::thread(worker));
+		}
+		worker();
+
+		for (std::thread& t : threads)
+		{
+			if (t.joinable())
+			{
+				t.join();
+			}
+		}
+
+		if (pException != nullptr)
+		{
+			std::rethrow_exception(pException);
+		}
+		return results;
+	}
+
+	void MfccExtractor::ProcessFrames(const double* pPowerSpectra, size_t frameCount, double* pEnergies, double* pOutput) const
+	{
+		const size_t filterCount = this->filterbank.GetFilterCount();
+
+		this->filterbank.Apply(pPowerSpectra, frameCount, pEnergies);
+		for (size_t i = 0; i < frameCount * filterCount; ++i)
+		{
+			pEnergies[i] = log(HEPH_MATH_MAX(pEnergies[i], MIN_ENERGY));
+		}
+
+		if (pOutput != nullptr)
+		{
+			for (size_t i = 0; i < frameCount; ++i)
+			{
+				const double* const pFrameEnergies = pEnergies + i * filterCount;
+				for (size_t j = 0; j < this->coefficientCount; ++j)
+				{
+					const double* const pBasis = this->dctMatrix.data() + j * filterCount;
+					double sum = 0.0;
+					for (size_t k = 0; k < filterCount; ++k)
+					{
+						sum += pFrameEnergies[k] * pBasis[k];
+					}
+					pOutput[i * this->coefficientCount + j] = sum;
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
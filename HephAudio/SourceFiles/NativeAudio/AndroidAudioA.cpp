@@ -17,7 +17,7 @@ namespace HephAudio
 	{
 		AndroidAudioA::AndroidAudioA() : AndroidAudioBase()
 			, pRenderStream(nullptr), pCaptureStream(nullptr)
-			, renderBufferFrameCount(0), captureBufferFrameCount(0), masterVolume(1.0)
+			, renderBufferFrameCount(0), captureBufferFrameCount(0), renderXRunCount(0), captureXRunCount(0), masterVolume(1.0)
 		{
 			if (deviceApiLevel < HEPHAUDIO_ANDROID_AAUDIO_MIN_API_LEVEL)
 			{
@@ -143,6 +143,7 @@ namespace HephAudio
 			}
 
 			isRenderInitialized = true;
+			renderXRunCount = 0;
 			ANDROIDAUDIO_EXCPT(AAudioStream_requestStart(pRenderStream), this, HEPH_FUNC, "Failed to start the render stream.");
 
 			HEPHAUDIO_LOG("Render initialized in " + StringHelpers::ToString(HEPH_SW_DT_MS, 4) + " ms.", HEPH_CL_INFO);
@@ -250,7 +251,11 @@ namespace HephAudio
 				captureDeviceId = StringHelpers::ToString(AAudioStream_getDeviceId(pCaptureStream));
 			}
 
+			// the data callback always provides captureBufferFrameCount frames.
+			this->PrepareCaptureBuffers(captureBufferFrameCount);
+
 			isCaptureInitialized = true;
+			captureXRunCount = 0;
 			ANDROIDAUDIO_EXCPT(AAudioStream_requestStart(pCaptureStream), this, HEPH_FUNC, "Failed to start the capture stream.");
 
 			HEPHAUDIO_LOG("Capture initialized in " + StringHelpers::ToString(HEPH_SW_DT_MS, 4) + " ms.", HEPH_CL_INFO);
@@ -300,8 +305,14 @@ namespace HephAudio
 			{
 				if (!pAudio->disposing && pAudio->isRenderInitialized)
 				{
-					EncodedAudioBuffer mixedBuffer = pAudio->Mix(numFrames);
-					memcpy(audioData, mixedBuffer.begin(), numFrames * pAudio->renderFormat.FrameSize());
+					const int32_t xRunCount = AAudioStream_getXRunCount(stream);
+					if (xRunCount > pAudio->renderXRunCount)
+					{
+						pAudio->renderMetrics.RecordUnderrun(xRunCount - pAudio->renderXRunCount);
+						pAudio->renderXRunCount = xRunCount;
+					}
+
+					pAudio->Mix(numFrames, audioData);
 					return AAUDIO_CALLBACK_RESULT_CONTINUE;
 				}
 			}
@@ -314,13 +325,16 @@ namespace HephAudio
 			{
 				if (!pAudio->disposing && pAudio->isCaptureInitialized)
 				{
-					if (!pAudio->isCapturePaused && pAudio->OnCapture)
+					const int32_t xRunCount = AAudioStream_getXRunCount(stream);
+					if (xRunCount > pAudio->captureXRunCount)
+					{
+						pAudio->renderMetrics.RecordOverrun(xRunCount - pAudio->captureXRunCount);
+						pAudio->captureXRunCount = xRunCount;
+					}
+
+					if (!pAudio->isCapturePaused)
 					{
-						EncodedAudioBuffer encodedBuffer((const uint8_t*)audioData, numFrames * pAudio->captureFormat.FrameSize(), pAudio->captureFormat);
-						AudioBuffer buffer = pAudio->pAudioDecoder->Decode(encodedBuffer);
-						
-						AudioCaptureEventArgs captureEventArgs(pAudio, buffer);
-						pAudio->OnCapture(&captureEventArgs, nullptr);
+						pAudio->DeliverCapturedData(audioData, numFrames);
 					}
 					return AAUDIO_CALLBACK_RESULT_CONTINUE;
 				}
@@ -193,6 +193,7 @@ namespace HephAudio
 				return;
 			}
 			(void)memset(captureCallbackContext.pData, 0, captureCallbackContext.bufferSize_byte);
+			this->PrepareCaptureBuffers(captureCallbackContext.bufferSize_frame / 2);
 
 			ANDROIDAUDIO_EXCPT((*simpleBufferQueue)->RegisterCallback(simpleBufferQueue, &AndroidAudioSLES::RecordEventCallback, &captureCallbackContext), this, HEPH_FUNC, "An error occurred while initializing capture.");
 			ANDROIDAUDIO_EXCPT((*simpleBufferQueue)->Enqueue(simpleBufferQueue, captureCallbackContext.pData, captureCallbackContext.bufferSize_byte), this, HEPH_FUNC, "An error occurred while capturing data.");
@@ -271,8 +272,7 @@ namespace HephAudio
 				const size_t frameCount = pCallbackContext->bufferSize_frame / 2;
 				const size_t bufferSize = frameCount * pCallbackContext->pAndroidAudio->renderFormat.FrameSize();
 
-				EncodedAudioBuffer mixedBuffer = pCallbackContext->pAndroidAudio->Mix(frameCount);
-				(void)memcpy(pCallbackContext->pData + pCallbackContext->index, mixedBuffer.begin(), bufferSize);
+				pCallbackContext->pAndroidAudio->Mix(frameCount, pCallbackContext->pData + pCallbackContext->index);
 				pCallbackContext->index = (pCallbackContext->index + bufferSize) % pCallbackContext->bufferSize_byte;
 
 				SLresult slres = (*bufferQueue)->Enqueue(bufferQueue, pCallbackContext->pData + pCallbackContext->index, bufferSize);
@@ -286,19 +286,16 @@ namespace HephAudio
 		void AndroidAudioSLES::RecordEventCallback(SLAndroidSimpleBufferQueueItf simpleBufferQueue, void* pContext)
 		{
 			CallbackContext* pCallbackContext = (CallbackContext*)pContext;
-			if (pCallbackContext != nullptr && pCallbackContext->pAndroidAudio->isCaptureInitialized && pCallbackContext->pAndroidAudio->OnCapture)
+			if (pCallbackContext != nullptr && pCallbackContext->pAndroidAudio->isCaptureInitialized)
 			{
 				const size_t frameCount = pCallbackContext->bufferSize_frame / 2;
 				const size_t bufferSize = frameCount * pCallbackContext->pAndroidAudio->captureFormat.FrameSize();
-				EncodedAudioBuffer encodedBuffer(
-					(const uint8_t*)pCallbackContext->pData + pCallbackContext->index, 
-					bufferSize, 
-					pCallbackContext->pAndroidAudio->captureFormat
-				);
-
-				AudioBuffer buffer = pCallbackContext->pAndroidAudio->pAudioDecoder->Decode(encodedBuffer);
-				AudioCaptureEventArgs captureEventArgs(pCallbackContext->pAndroidAudio, buffer);
-				pCallbackContext->pAndroidAudio->OnCapture(&captureEventArgs, nullptr);
+
+				// the buffer is enqueued again even when the capture is paused, otherwise the recorder would stop delivering data.
+				if (!pCallbackContext->pAndroidAudio->isCapturePaused)
+				{
+					pCallbackContext->pAndroidAudio->DeliverCapturedData(pCallbackContext->pData + pCallbackContext->index, frameCount);
+				}
 
 				pCallbackContext->index = (pCallbackContext->index + bufferSize) % pCallbackContext->bufferSize_byte;
 
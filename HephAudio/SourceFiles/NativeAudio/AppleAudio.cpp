@@ -3,6 +3,7 @@
 #include "ConsoleLogger.h"
 #include "Stopwatch.h"
 #include "StringHelpers.h"
+#include "HephMath.h"
 #include "Exceptions/ExternalException.h"
 #include "Exceptions/InsufficientMemoryException.h"
 #include "Exceptions/InvalidArgumentException.h"
@@ -190,6 +191,12 @@ namespace HephAudio
 			propertyList.mSelector = kAudioDevicePropertyStreamFormat;
 			APPLE_EXCPT(AudioObjectSetPropertyData(deviceID, &propertyList, 0, nullptr, size, &streamDesc), this, HEPH_FUNC, "An error occurred while setting the stream description.");
 
+			UInt32 bufferFrameCount;
+			size = sizeof(bufferFrameCount);
+			propertyList.mSelector = kAudioDevicePropertyBufferFrameSize;
+			APPLE_EXCPT(AudioObjectGetPropertyData(deviceID, &propertyList, 0, nullptr, &size, &bufferFrameCount), this, HEPH_FUNC, "An error occurred while getting the buffer frame size.");
+			this->PrepareCaptureBuffers(bufferFrameCount);
+
 			APPLE_EXCPT(AudioDeviceCreateIOProcID(deviceID, &AppleAudio::CaptureCallback, this, &captureProcID), this, HEPH_FUNC, "An error occurred while creating the IO proc.");
 			APPLE_EXCPT(AudioDeviceStart(deviceID, captureProcID), this, HEPH_FUNC, "An error occurred while starting the audio device.");
 
@@ -461,8 +468,7 @@ namespace HephAudio
 			{
 				for (size_t i = 0; i < outdata->mNumberBuffers; i++)
 				{
-					EncodedAudioBuffer mixedBuffer = appleAudio->Mix(outdata->mBuffers[i].mDataByteSize / appleAudio->renderFormat.FrameSize());
-					memcpy(outdata->mBuffers[i].mData, mixedBuffer.begin(), outdata->mBuffers[i].mDataByteSize);
+					appleAudio->Mix(outdata->mBuffers[i].mDataByteSize / appleAudio->renderFormat.FrameSize(), outdata->mBuffers[i].mData);
 				}
 			}
 			return kAudioHardwareNoError;
@@ -471,25 +477,23 @@ namespace HephAudio
 			const AudioTimeStamp* intime, AudioBufferList* outdata, const AudioTimeStamp* outtime, void* udata)
 		{
 			AppleAudio* appleAudio = (AppleAudio*)udata;
-			if (!appleAudio->disposing && appleAudio->isCaptureInitialized && !appleAudio->isCapturePaused && appleAudio->OnCapture)
+			if (!appleAudio->disposing && appleAudio->isCaptureInitialized && !appleAudio->isCapturePaused)
 			{
-				size_t frameCount = 0;
-				for (size_t i = 0; i < indata->mNumberBuffers; i++)
-				{
-					frameCount += indata->mBuffers[i].mDataByteSize / appleAudio->captureFormat.FrameSize();
-				}
-
-				size_t offset = 0;
-				EncodedAudioBuffer encodedBuffer(frameCount * appleAudio->captureFormat.FrameSize(), appleAudio->captureFormat);
+				// the buffer frame size of the device can be changed by other processes, so the data is delivered in slices of at most one period.
+				const size_t frameSize = appleAudio->captureFormat.FrameSize();
+				const size_t periodSize_frame = appleAudio->capturePeriodBuffer.FrameCount();
 				for (size_t i = 0; i < indata->mNumberBuffers; i++)
 				{
-					memcpy(encodedBuffer.begin() + offset, indata->mBuffers[i].mData, indata->mBuffers[i].mDataByteSize);
-					offset += indata->mBuffers[i].mDataByteSize;
+					const uint8_t* pData = (const uint8_t*)indata->mBuffers[i].mData;
+					size_t frameCount = indata->mBuffers[i].mDataByteSize / frameSize;
+					while (frameCount > 0)
+					{
+						const size_t sliceFrameCount = HEPH_MATH_MIN(frameCount, periodSize_frame);
+						appleAudio->DeliverCapturedData(pData, sliceFrameCount);
+						pData += sliceFrameCount * frameSize;
+						frameCount -= sliceFrameCount;
+					}
 				}
-
-				AudioBuffer buffer = appleAudio->pAudioDecoder->Decode(encodedBuffer);
-				AudioCaptureEventArgs captureEventArgs(appleAudio, buffer);
-				appleAudio->OnCapture(&captureEventArgs, nullptr);
 			}
 			return kAudioHardwareNoError;
 		}
@@ -6,9 +6,10 @@
 #include "Exceptions/ExternalException.h"
 #include "Exceptions/InvalidArgumentException.h"
 #include "Exceptions/NotFoundException.h"
-#include <unistd.h>
+#include <cerrno>
 
 #define SND_OK 0
+#define LINUX_PCM_WAIT_TIMEOUT_MS 100
 #define LINUX_ENUMERATE_DEVICE_EXCPT(r, linuxAudio, method, message)                                            \
 	result = r;                                                                                                 \
 	if (result != SND_OK)                                                                                       \
@@ -36,7 +37,7 @@ namespace HephAudio
 {
 	namespace Native
 	{
-		LinuxAudio::LinuxAudio() : NativeAudio(), renderPcm(nullptr), capturePcm(nullptr)
+		LinuxAudio::LinuxAudio() : NativeAudio(), renderPcm(nullptr), capturePcm(nullptr), isRenderMmap(false), isCaptureMmap(false)
 		{
 			this->EnumerateAudioDevices();
 			this->deviceThread = std::thread(&LinuxAudio::CheckAudioDevices, this);
@@ -140,24 +141,16 @@ namespace HephAudio
 
 			LINUX_EXCPT(snd_pcm_open(&renderPcm, renderDeviceId.c_str(), SND_PCM_STREAM_PLAYBACK, 0), this, HEPH_FUNC, "An error occurred while opening pcm.");
 
-			const useconds_t bufferDuration = this->params.renderBufferDuration_ms * 1000;
-			const useconds_t latency = bufferDuration * 2;
-
-			LINUX_EXCPT(snd_pcm_set_params(renderPcm,
-				ToPcmFormat(renderFormat),
-				SND_PCM_ACCESS_RW_INTERLEAVED,
-				renderFormat.channelLayout.count,
-				renderFormat.sampleRate,
-				1,
-				latency),
-				this, HEPH_FUNC, "An error occurred while setting the snd_pcm params");
+			ConfigurePcm(renderPcm, renderFormat, this->params.renderBufferDuration_ms,
+				this->params.renderPeriodSize_frame, this->params.renderPeriodCount, this->params.renderBufferSize_frame, isRenderMmap);
+			renderTransferBuffer.resize(isRenderMmap ? 0 : (this->params.renderPeriodSize_frame * renderFormat.FrameSize()));
 
 			snd_pcm_chmap* pcm_chmap = ToPcmChmap(renderFormat);
 			LINUX_EXCPT(snd_pcm_set_chmap(renderPcm, pcm_chmap), this, HEPH_FUNC, "An error occurred while setting the channel mapping");
 			free(pcm_chmap);
 
 			isRenderInitialized = true;
-			renderThread = std::thread(&LinuxAudio::RenderData, this, bufferDuration);
+			renderThread = std::thread(&LinuxAudio::RenderData, this);
 
 			HEPHAUDIO_LOG("Render initialized in " + StringHelpers::ToString(HEPH_SW_DT_MS, 4) + " ms.", HEPH_CL_INFO);
 		}
@@ -190,24 +183,17 @@ namespace HephAudio
 
 			LINUX_EXCPT(snd_pcm_open(&capturePcm, captureDeviceId.c_str(), SND_PCM_STREAM_CAPTURE, 0), this, HEPH_FUNC, "An error occurred while opening pcm.");
 
-			const useconds_t bufferDuration = this->params.captureBufferDuration_ms * 1000;
-			const useconds_t latency = bufferDuration * 2;
-
-			LINUX_EXCPT(snd_pcm_set_params(capturePcm,
-				ToPcmFormat(captureFormat),
-				SND_PCM_ACCESS_RW_INTERLEAVED,
-				captureFormat.channelLayout.count,
-				captureFormat.sampleRate,
-				1,
-				latency),
-				this, HEPH_FUNC, "An error occurred while setting the snd_pcm params");
+			ConfigurePcm(capturePcm, captureFormat, this->params.captureBufferDuration_ms,
+				this->params.capturePeriodSize_frame, this->params.capturePeriodCount, this->params.captureBufferSize_frame, isCaptureMmap);
+			captureTransferBuffer.resize(isCaptureMmap ? 0 : (this->params.capturePeriodSize_frame * captureFormat.FrameSize()));
+			PrepareCaptureBuffers(this->params.capturePeriodSize_frame);
 
 			snd_pcm_chmap* pcm_chmap = ToPcmChmap(captureFormat);
 			LINUX_EXCPT(snd_pcm_set_chmap(capturePcm, pcm_chmap), this, HEPH_FUNC, "An error occurred while setting the channel mapping");
 			free(pcm_chmap);
 
 			isCaptureInitialized = true;
-			captureThread = std::thread(&LinuxAudio::CaptureData, this, bufferDuration);
+			captureThread = std::thread(&LinuxAudio::CaptureData, this);
 
 			HEPHAUDIO_LOG("Capture initialized in " + StringHelpers::ToString(HEPH_SW_DT_MS, 4) + " ms.", HEPH_CL_INFO);
 		}
@@ -299,81 +285,242 @@ namespace HephAudio
 
 			return NativeAudio::DEVICE_ENUMERATION_SUCCESS;
 		}
-		void LinuxAudio::RenderData(useconds_t bufferDuration_us)
+		void LinuxAudio::RenderData()
 		{
-			const snd_pcm_sframes_t bufferDuration_frame = renderFormat.sampleRate * (bufferDuration_us / 1e6f);
+			const snd_pcm_uframes_t periodSize_frame = this->params.renderPeriodSize_frame;
 			snd_pcm_sframes_t availableFrameCount;
-			snd_pcm_sframes_t writtenFrameCount;
 			int result;
 
-			LINUX_RENDER_CAPTURE_EXCPT(snd_pcm_start(renderPcm), this, HEPH_FUNC, "Failed to start rendering.");
-			while (snd_pcm_state(renderPcm) != SND_PCM_STATE_RUNNING);
+			// the stream starts by itself once the ring buffer is filled, see the start threshold in ConfigurePcm.
 			while (!disposing && isRenderInitialized)
 			{
 				availableFrameCount = snd_pcm_avail_update(renderPcm);
-				if (availableFrameCount >= bufferDuration_frame)
+				if (availableFrameCount < 0)
 				{
-					const EncodedAudioBuffer mixedBuffer = Mix(bufferDuration_frame);
-					writtenFrameCount = snd_pcm_writei(renderPcm, mixedBuffer.begin(), bufferDuration_frame);
-					if (writtenFrameCount < 0)
+					if (!RecoverPcm(renderPcm, availableFrameCount))
 					{
-						HEPHAUDIO_LOG("An error occurred while rendering, attempting to recover.", HEPH_CL_WARNING);
-						result = snd_pcm_recover(renderPcm, writtenFrameCount, 1);
-						if (result < 0)
+						return;
+					}
+					continue;
+				}
+
+				if ((snd_pcm_uframes_t)availableFrameCount < periodSize_frame)
+				{
+					result = snd_pcm_wait(renderPcm, LINUX_PCM_WAIT_TIMEOUT_MS);
+					if (result < 0 && !RecoverPcm(renderPcm, result))
+					{
+						return;
+					}
+					continue;
+				}
+
+				if (isRenderMmap)
+				{
+					const snd_pcm_channel_area_t* pAreas;
+					snd_pcm_uframes_t offset;
+					snd_pcm_uframes_t frameCount = periodSize_frame;
+
+					result = snd_pcm_mmap_begin(renderPcm, &pAreas, &offset, &frameCount);
+					if (result < 0)
+					{
+						if (!RecoverPcm(renderPcm, result))
 						{
-							LINUX_RENDER_CAPTURE_EXCPT(result, this, HEPH_FUNC, "Failed to recover from the render error.");
+							return;
 						}
+						continue;
+					}
+
+					// interleaved access, all channels share the first area.
+					Mix(frameCount, (uint8_t*)pAreas[0].addr + ((pAreas[0].first + offset * pAreas[0].step) / 8));
+
+					const snd_pcm_sframes_t committedFrameCount = snd_pcm_mmap_commit(renderPcm, offset, frameCount);
+					if ((committedFrameCount < 0 || (snd_pcm_uframes_t)committedFrameCount != frameCount) &&
+						!RecoverPcm(renderPcm, committedFrameCount < 0 ? committedFrameCount : -EPIPE))
+					{
+						return;
+					}
+				}
+				else
+				{
+					Mix(periodSize_frame, renderTransferBuffer.data());
+
+					const snd_pcm_sframes_t writtenFrameCount = snd_pcm_writei(renderPcm, renderTransferBuffer.data(), periodSize_frame);
+					if (writtenFrameCount < 0 && !RecoverPcm(renderPcm, writtenFrameCount))
+					{
+						return;
 					}
 				}
-				usleep(bufferDuration_us / 2);
 			}
 		}
-		void LinuxAudio::CaptureData(useconds_t bufferDuration_us)
+		void LinuxAudio::CaptureData()
 		{
-			const snd_pcm_sframes_t bufferDuration_frame = captureFormat.sampleRate * (bufferDuration_us / 1e6f);
+			const snd_pcm_uframes_t periodSize_frame = this->params.capturePeriodSize_frame;
 			snd_pcm_sframes_t availableFrameCount;
-			snd_pcm_sframes_t readFrameCount;
 			int result;
 
 			LINUX_RENDER_CAPTURE_EXCPT(snd_pcm_start(capturePcm), this, HEPH_FUNC, "Failed to start capturing.");
-			while (snd_pcm_state(capturePcm) != SND_PCM_STATE_RUNNING);
 			while (!disposing && isCaptureInitialized)
 			{
-				if (!isCapturePaused)
+				availableFrameCount = snd_pcm_avail_update(capturePcm);
+				if (availableFrameCount < 0)
+				{
+					if (!RecoverPcm(capturePcm, availableFrameCount))
+					{
+						return;
+					}
+					continue;
+				}
+
+				if ((snd_pcm_uframes_t)availableFrameCount < periodSize_frame)
+				{
+					result = snd_pcm_wait(capturePcm, LINUX_PCM_WAIT_TIMEOUT_MS);
+					if (result < 0 && !RecoverPcm(capturePcm, result))
+					{
+						return;
+					}
+					continue;
+				}
+
+				// the data is consumed even when the capture is paused so the device does not overrun.
+				if (isCaptureMmap)
 				{
-					availableFrameCount = snd_pcm_avail_update(capturePcm);
-					if (availableFrameCount >= bufferDuration_frame)
+					const snd_pcm_channel_area_t* pAreas;
+					snd_pcm_uframes_t offset;
+					snd_pcm_uframes_t frameCount = periodSize_frame;
+
+					result = snd_pcm_mmap_begin(capturePcm, &pAreas, &offset, &frameCount);
+					if (result < 0)
 					{
-						EncodedAudioBuffer encodedBuffer(bufferDuration_frame * this->captureFormat.FrameSize(), this->captureFormat);
-						readFrameCount = snd_pcm_readi(capturePcm, encodedBuffer.begin(), bufferDuration_frame);
-						if (readFrameCount < 0)
+						if (!RecoverPcm(capturePcm, result))
 						{
-							HEPHAUDIO_LOG("An error occurred while capturing, attempting to recover.", HEPH_CL_WARNING);
-							result = snd_pcm_recover(capturePcm, readFrameCount, 1);
-							if (result < 0)
-							{
-								LINUX_RENDER_CAPTURE_EXCPT(result, this, HEPH_FUNC, "Failed to recover from the capture error.");
-							}
+							return;
 						}
-						else
+						continue;
+					}
+
+					// convert straight from the device ring buffer before handing the area back.
+					if (!isCapturePaused)
+					{
+						DeliverCapturedData((const uint8_t*)pAreas[0].addr + ((pAreas[0].first + offset * pAreas[0].step) / 8), frameCount);
+					}
+
+					const snd_pcm_sframes_t committedFrameCount = snd_pcm_mmap_commit(capturePcm, offset, frameCount);
+					if ((committedFrameCount < 0 || (snd_pcm_uframes_t)committedFrameCount != frameCount) &&
+						!RecoverPcm(capturePcm, committedFrameCount < 0 ? committedFrameCount : -EPIPE))
+					{
+						return;
+					}
+				}
+				else
+				{
+					const snd_pcm_sframes_t readFrameCount = snd_pcm_readi(capturePcm, captureTransferBuffer.data(), periodSize_frame);
+					if (readFrameCount < 0)
+					{
+						if (!RecoverPcm(capturePcm, readFrameCount))
 						{
-							if (OnCapture)
-							{
-								AudioBuffer buffer = this->pAudioDecoder->Decode(encodedBuffer);
-								AudioCaptureEventArgs captureEventArgs(this, buffer);
-								OnCapture(&captureEventArgs, nullptr);
-							}
+							return;
 						}
+						continue;
 					}
-					usleep(bufferDuration_us / 2);
+
+					if (!isCapturePaused)
+					{
+						DeliverCapturedData(captureTransferBuffer.data(), readFrameCount);
+					}
+				}
+			}
+		}
+		void LinuxAudio::ConfigurePcm(snd_pcm_t* pcm, AudioFormatInfo& format, double periodDuration_ms, uint32_t& periodSize_frame, uint32_t& periodCount, uint32_t& bufferSize_frame, bool& isMmap)
+		{
+			snd_pcm_hw_params_t* hwParams;
+			snd_pcm_sw_params_t* swParams;
+			snd_pcm_uframes_t periodSize = periodSize_frame > 0 ? periodSize_frame : (snd_pcm_uframes_t)(format.sampleRate * periodDuration_ms / 1000.0);
+			snd_pcm_uframes_t bufferSize;
+			unsigned int periods = periodCount > 0 ? periodCount : 2;
+			unsigned int sampleRate = format.sampleRate;
+			int dir = 0;
+			int result;
+
+			snd_pcm_hw_params_alloca(&hwParams);
+			snd_pcm_sw_params_alloca(&swParams);
+
+			LINUX_EXCPT(snd_pcm_hw_params_any(pcm, hwParams), this, HEPH_FUNC, "An error occurred while getting the hardware params.");
+
+			isMmap = this->params.enableMmap && snd_pcm_hw_params_set_access(pcm, hwParams, SND_PCM_ACCESS_MMAP_INTERLEAVED) == SND_OK;
+			if (!isMmap)
+			{
+				LINUX_EXCPT(snd_pcm_hw_params_set_access(pcm, hwParams, SND_PCM_ACCESS_RW_INTERLEAVED), this, HEPH_FUNC, "An error occurred while setting the access type.");
+			}
+
+			LINUX_EXCPT(snd_pcm_hw_params_set_format(pcm, hwParams, ToPcmFormat(format)), this, HEPH_FUNC, "Format is not supported by the device.");
+			LINUX_EXCPT(snd_pcm_hw_params_set_channels(pcm, hwParams, format.channelLayout.count), this, HEPH_FUNC, "Channel count is not supported by the device.");
+			LINUX_EXCPT(snd_pcm_hw_params_set_rate_resample(pcm, hwParams, 1), this, HEPH_FUNC, "An error occurred while enabling resampling.");
+			LINUX_EXCPT(snd_pcm_hw_params_set_rate_near(pcm, hwParams, &sampleRate, &dir), this, HEPH_FUNC, "Sample rate is not supported by the device.");
+			LINUX_EXCPT(snd_pcm_hw_params_set_period_size_near(pcm, hwParams, &periodSize, &dir), this, HEPH_FUNC, "An error occurred while setting the period size.");
+			LINUX_EXCPT(snd_pcm_hw_params_set_periods_near(pcm, hwParams, &periods, &dir), this, HEPH_FUNC, "An error occurred while setting the period count.");
+			LINUX_EXCPT(snd_pcm_hw_params(pcm, hwParams), this, HEPH_FUNC, "An error occurred while setting the hardware params.");
+
+			LINUX_EXCPT(snd_pcm_hw_params_get_period_size(hwParams, &periodSize, &dir), this, HEPH_FUNC, "An error occurred while getting the period size.");
+			LINUX_EXCPT(snd_pcm_hw_params_get_periods(hwParams, &periods, &dir), this, HEPH_FUNC, "An error occurred while getting the period count.");
+			LINUX_EXCPT(snd_pcm_hw_params_get_buffer_size(hwParams, &bufferSize), this, HEPH_FUNC, "An error occurred while getting the buffer size.");
+
+			// wake up once a full period can be transferred, start rendering once the ring buffer is filled with whole periods.
+			LINUX_EXCPT(snd_pcm_sw_params_current(pcm, swParams), this, HEPH_FUNC, "An error occurred while getting the software params.");
+			LINUX_EXCPT(snd_pcm_sw_params_set_avail_min(pcm, swParams, periodSize), this, HEPH_FUNC, "An error occurred while setting the minimum available frame count.");
+			if (snd_pcm_stream(pcm) == SND_PCM_STREAM_PLAYBACK)
+			{
+				LINUX_EXCPT(snd_pcm_sw_params_set_start_threshold(pcm, swParams, bufferSize - (bufferSize % periodSize)), this, HEPH_FUNC, "An error occurred while setting the start threshold.");
+			}
+			LINUX_EXCPT(snd_pcm_sw_params(pcm, swParams), this, HEPH_FUNC, "An error occurred while setting the software params.");
+
+			format.sampleRate = sampleRate;
+			periodSize_frame = periodSize;
+			periodCount = periods;
+			bufferSize_frame = bufferSize;
+		}
+		bool LinuxAudio::RecoverPcm(snd_pcm_t* pcm, int error)
+		{
+			const bool isRender = pcm == renderPcm;
+			int result;
+
+			if (error == -EPIPE)
+			{
+				if (isRender)
+				{
+					this->renderMetrics.RecordUnderrun();
+				}
+				else
+				{
+					this->renderMetrics.RecordOverrun();
+				}
+			}
+
+			HEPHAUDIO_LOG(isRender ? "An error occurred while rendering, attempting to recover." : "An error occurred while capturing, attempting to recover.", HEPH_CL_WARNING);
+			result = snd_pcm_recover(pcm, error, 1);
+			if (result < SND_OK)
+			{
+				HEPH_RAISE_EXCEPTION(this, ExternalException(HEPH_FUNC, isRender ? "Failed to recover from the render error." : "Failed to recover from the capture error.", "ALSA", snd_strerror(result)));
+				return false;
+			}
+
+			// capture streams are not started automatically after being prepared.
+			if (!isRender)
+			{
+				result = snd_pcm_start(pcm);
+				if (result < SND_OK)
+				{
+					HEPH_RAISE_EXCEPTION(this, ExternalException(HEPH_FUNC, "Failed to start capturing.", "ALSA", snd_strerror(result)));
+					return false;
 				}
 			}
+
+			return true;
 		}
 		snd_pcm_format_t LinuxAudio::ToPcmFormat(const AudioFormatInfo& format) const
 		{
 			if (format.formatTag == HEPHAUDIO_FORMAT_TAG_IEEE_FLOAT)
 			{
-				return format.bitsPerSample == sizeof(double) ? snd_pcm_format_t::SND_PCM_FORMAT_FLOAT64 : snd_pcm_format_t::SND_PCM_FORMAT_FLOAT;
+				return format.bitsPerSample == 64 ? snd_pcm_format_t::SND_PCM_FORMAT_FLOAT64 : snd_pcm_format_t::SND_PCM_FORMAT_FLOAT;
 			}
 			else
 			{
@@ -384,7 +531,7 @@ namespace HephAudio
 				case 16:
 					return snd_pcm_format_t::SND_PCM_FORMAT_S16;
 				case 24:
-					return snd_pcm_format_t::SND_PCM_FORMAT_S24;
+					return snd_pcm_format_t::SND_PCM_FORMAT_S24_3LE;
 				case 32:
 					return snd_pcm_format_t::SND_PCM_FORMAT_S32;
 				default:
@@ -1,5 +1,5 @@
 #include "NativeAudio/NativeAudio.h"
-#include "FFmpeg/FFmpegAudioDecoder.h"
+#include "PcmAudioDecoder.h"
 #include "FFmpeg/FFmpegAudioEncoder.h"
 #include "AudioEffects/ChannelMapper.h"
 #include "AudioEffects/Resampler.h"
@@ -13,6 +13,9 @@
 #include "HephMath.h"
 #include "Exceptions/InvalidArgumentException.h"
 #include "Exceptions/NotFoundException.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 
 using namespace Heph;
 
@@ -21,10 +24,12 @@ namespace HephAudio
 	namespace Native
 	{
 		NativeAudio::NativeAudio()
-			: pAudioDecoder(new FFmpegAudioDecoder()), pAudioEncoder(new FFmpegAudioEncoder()),
+			: pAudioDecoder(new PcmAudioDecoder()), audioDecoderFactory([]() { return std::make_shared<PcmAudioDecoder>(); }), pAudioEncoder(new FFmpegAudioEncoder()), pAssetCache(nullptr), compressedResidencyThreshold_frame(0),
+			maxRealVoiceCount(0), voiceStealingPolicy(StealQuietest), virtualVolumeThreshold(0.0), audioObjectsGeneration(0),
 			mainThreadId(std::this_thread::get_id()), renderDeviceId(""), captureDeviceId(""),
 			renderFormat(AudioFormatInfo(1, 16, HEPHAUDIO_CH_LAYOUT_STEREO, 48000)), captureFormat(AudioFormatInfo(1, 16, HEPHAUDIO_CH_LAYOUT_STEREO, 48000)),
-			disposing(false), isRenderInitialized(false), isCaptureInitialized(false), isCapturePaused(false), deviceEnumerationPeriod_ms(100)
+			disposing(false), isRenderInitialized(false), isCaptureInitialized(false), isCapturePaused(false), deviceEnumerationPeriod_ms(100), captureRingBufferDuration_ms(1000),
+			loadThreadPool(HEPHAUDIO_LOAD_THREAD_COUNT)
 		{
 			HEPH_SW_RESET;
 		}
@@ -43,6 +48,23 @@ namespace HephAudio
 			this->pAudioDecoder = pNewDecoder;
 		}
 
+		AudioDecoderFactory NativeAudio::GetAudioDecoderFactory() const
+		{
+			std::lock_guard<std::recursive_mutex> lockGuard(this->audioObjectsMutex);
+			return this->audioDecoderFactory;
+		}
+
+		void NativeAudio::SetAudioDecoderFactory(AudioDecoderFactory newDecoderFactory)
+		{
+			if (newDecoderFactory == nullptr)
+			{
+				HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "Decoder factory cannot be null"));
+			}
+
+			std::lock_guard<std::recursive_mutex> lockGuard(this->audioObjectsMutex);
+			this->audioDecoderFactory = newDecoderFactory;
+		}
+
 		std::shared_ptr<IAudioEncoder> NativeAudio::GetAudioEncoder() const
 		{
 			return this->pAudioEncoder;
@@ -57,6 +79,101 @@ namespace HephAudio
 			this->pAudioEncoder = pNewEncoder;
 		}
 
+		std::shared_ptr<AudioAssetCache> NativeAudio::GetAssetCache() const
+		{
+			return this->pAssetCache;
+		}
+
+		void NativeAudio::SetAssetCache(std::shared_ptr<AudioAssetCache> pNewAssetCache)
+		{
+			std::lock_guard<std::recursive_mutex> lockGuard(this->audioObjectsMutex);
+			this->pAssetCache = pNewAssetCache;
+		}
+
+		size_t NativeAudio::GetCompressedResidencyThreshold() const
+		{
+			return this->compressedResidencyThreshold_frame;
+		}
+
+		void NativeAudio::SetCompressedResidencyThreshold(size_t threshold_frame)
+		{
+			std::lock_guard<std::recursive_mutex> lockGuard(this->audioObjectsMutex);
+			this->compressedResidencyThreshold_frame = threshold_frame;
+		}
+
+		size_t NativeAudio::GetMaxRealVoiceCount() const
+		{
+			return this->maxRealVoiceCount;
+		}
+
+		void NativeAudio::SetMaxRealVoiceCount(size_t maxRealVoiceCount)
+		{
+			std::lock_guard<std::recursive_mutex> lockGuard(this->audioObjectsMutex);
+			this->maxRealVoiceCount = maxRealVoiceCount;
+		}
+
+		VoiceStealingPolicy NativeAudio::GetVoiceStealingPolicy() const
+		{
+			return this->voiceStealingPolicy;
+		}
+
+		void NativeAudio::SetVoiceStealingPolicy(VoiceStealingPolicy voiceStealingPolicy)
+		{
+			std::lock_guard<std::recursive_mutex> lockGuard(this->audioObjectsMutex);
+			this->voiceStealingPolicy = voiceStealingPolicy;
+		}
+
+		double NativeAudio::GetVirtualVolumeThreshold() const
+		{
+			return this->virtualVolumeThreshold;
+		}
+
+		void NativeAudio::SetVirtualVolumeThreshold(double virtualVolumeThreshold)
+		{
+			std::lock_guard<std::recursive_mutex> lockGuard(this->audioObjectsMutex);
+			this->virtualVolumeThreshold = virtualVolumeThreshold;
+		}
+
+		AudioBus* NativeAudio::CreateBus(const std::string& name, const std::string& outputBusName)
+		{
+			std::lock_guard<std::recursive_mutex> lockGuard(this->audioObjectsMutex);
+			return this->busGraph.CreateBus(name, outputBusName);
+		}
+
+		bool NativeAudio::DestroyBus(const std::string& name)
+		{
+			std::lock_guard<std::recursive_mutex> lockGuard(this->audioObjectsMutex);
+			return this->busGraph.DestroyBus(name);
+		}
+
+		AudioBus* NativeAudio::GetBus(const std::string& name)
+		{
+			std::lock_guard<std::recursive_mutex> lockGuard(this->audioObjectsMutex);
+			return this->busGraph.GetBus(name);
+		}
+
+		AudioBus* NativeAudio::GetMasterBus()
+		{
+			return &this->busGraph.GetMasterBus();
+		}
+
+		size_t NativeAudio::GetBusCount() const
+		{
+			std::lock_guard<std::recursive_mutex> lockGuard(this->audioObjectsMutex);
+			return this->busGraph.GetBusCount();
+		}
+
+		size_t NativeAudio::GetBusThreadCount() const
+		{
+			return this->busGraph.GetThreadCount();
+		}
+
+		void NativeAudio::SetBusThreadCount(size_t threadCount)
+		{
+			std::lock_guard<std::recursive_mutex> lockGuard(this->audioObjectsMutex);
+			this->busGraph.SetThreadCount(threadCount);
+		}
+
 		AudioObject* NativeAudio::Play(const std::filesystem::path& filePath)
 		{
 			return this->Play(filePath, 1);
@@ -74,12 +191,8 @@ namespace HephAudio
 			std::lock_guard<std::recursive_mutex> lockGuard(this->audioObjectsMutex);
 
 			AudioObject& audioObject = this->audioObjects.emplace_back();
-
-			audioObject.filePath = filePath;
-			audioObject.name = filePath.filename().string();
-
-			this->pAudioDecoder->ChangeFile(filePath);
-			audioObject.buffer = this->pAudioDecoder->Decode();
+			this->audioObjectsGeneration++;
+			NativeAudio::ReadFile(audioObject, filePath, *this->pAudioDecoder, this->pAssetCache, this->compressedResidencyThreshold_frame);
 
 			audioObject.playCount = playCount;
 			audioObject.isPaused = false;
@@ -100,11 +213,70 @@ namespace HephAudio
 			return pAudioObject;
 		}
 
+		std::future<AudioObject*> NativeAudio::PlayAsync(const std::filesystem::path& filePath)
+		{
+			return this->PlayAsync(filePath, 1);
+		}
+
+		std::future<AudioObject*> NativeAudio::PlayAsync(const std::filesystem::path& filePath, uint32_t playCount)
+		{
+			std::shared_ptr<std::promise<AudioObject*>> pPromise = std::make_shared<std::promise<AudioObject*>>();
+			std::future<AudioObject*> future = pPromise->get_future();
+			this->SubmitLoad(filePath, playCount, false, [pPromise](AudioObject* pAudioObject, std::exception_ptr pException)
+				{
+					if (pException != nullptr)
+					{
+						pPromise->set_exception(pException);
+					}
+					else
+					{
+						pPromise->set_value(pAudioObject);
+					}
+				});
+			return future;
+		}
+
+		std::future<AudioObject*> NativeAudio::LoadAsync(const std::filesystem::path& filePath)
+		{
+			return this->LoadAsync(filePath, 1);
+		}
+
+		std::future<AudioObject*> NativeAudio::LoadAsync(const std::filesystem::path& filePath, uint32_t playCount)
+		{
+			std::shared_ptr<std::promise<AudioObject*>> pPromise = std::make_shared<std::promise<AudioObject*>>();
+			std::future<AudioObject*> future = pPromise->get_future();
+			this->SubmitLoad(filePath, playCount, true, [pPromise](AudioObject* pAudioObject, std::exception_ptr pException)
+				{
+					if (pException != nullptr)
+					{
+						pPromise->set_exception(pException);
+					}
+					else
+					{
+						pPromise->set_value(pAudioObject);
+					}
+				});
+			return future;
+		}
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+		AudioObjectAwaitable NativeAudio::AwaitPlay(const std::filesystem::path& filePath, uint32_t playCount)
+		{
+			return AudioObjectAwaitable(this, filePath, playCount, false);
+		}
+
+		AudioObjectAwaitable NativeAudio::AwaitLoad(const std::filesystem::path& filePath, uint32_t playCount)
+		{
+			return AudioObjectAwaitable(this, filePath, playCount, true);
+		}
+#endif
+
 		AudioObject* NativeAudio::CreateAudioObject(const std::string& name, size_t bufferFrameCount, AudioChannelLayout channelLayout, uint32_t sampleRate)
 		{
 			std::lock_guard<std::recursive_mutex> lockGuard(this->audioObjectsMutex);
 
 			AudioObject& audioObject = this->audioObjects.emplace_back();
+			this->audioObjectsGeneration++;
 			audioObject.name = name;
 			audioObject.buffer = AudioBuffer(bufferFrameCount, channelLayout, sampleRate);
 			audioObject.isPaused = true;
@@ -120,6 +292,7 @@ namespace HephAudio
 				if (pAudioObject == &(*it))
 				{
 					this->audioObjects.erase(it);
+					this->audioObjectsGeneration++;
 					return true;
 				}
 			}
@@ -134,6 +307,7 @@ namespace HephAudio
 				if (it->id == audioObjectId)
 				{
 					this->audioObjects.erase(it);
+					this->audioObjectsGeneration++;
 					return true;
 				}
 			}
@@ -240,6 +414,43 @@ namespace HephAudio
 			this->deviceEnumerationPeriod_ms = deviceEnumerationPeriod_ms;
 		}
 
+		RenderMetrics& NativeAudio::GetRenderMetrics()
+		{
+			return this->renderMetrics;
+		}
+
+		const RenderMetrics& NativeAudio::GetRenderMetrics() const
+		{
+			return this->renderMetrics;
+		}
+
+		AudioRingBuffer& NativeAudio::GetCaptureRingBuffer()
+		{
+			return this->captureRingBuffer;
+		}
+
+		uint32_t NativeAudio::GetCaptureRingBufferDuration() const
+		{
+			return this->captureRingBufferDuration_ms;
+		}
+
+		void NativeAudio::SetCaptureRingBufferDuration(uint32_t captureRingBufferDuration_ms)
+		{
+			this->captureRingBufferDuration_ms = captureRingBufferDuration_ms;
+		}
+
+		DitherMode NativeAudio::GetRenderDitherMode() const
+		{
+			return this->renderDitherState.mode;
+		}
+
+		void NativeAudio::SetRenderDitherMode(DitherMode ditherMode)
+		{
+			std::lock_guard<std::recursive_mutex> lockGuard(this->audioObjectsMutex);
+			this->renderDitherState.mode = ditherMode;
+			this->renderDitherState.Reset();
+		}
+
 		const AudioFormatInfo& NativeAudio::GetRenderFormat() const
 		{
 			return this->renderFormat;
@@ -440,55 +651,246 @@ namespace HephAudio
 
 		EncodedAudioBuffer NativeAudio::Mix(uint32_t frameCount)
 		{
+			const std::chrono::steady_clock::time_point mixStart = std::chrono::steady_clock::now();
 			std::lock_guard<std::recursive_mutex> lockGuard(this->audioObjectsMutex);
+			this->renderMetrics.BeginPeriod();
 
-			const size_t mixedAOCount = GetAOCountToMix();
 			AudioBuffer mixBuffer(frameCount, this->renderFormat.channelLayout, this->renderFormat.sampleRate);
+			this->MixAudioObjects(mixBuffer, frameCount);
+
+			EncodedAudioBuffer encodedBuffer(this->renderFormat);
+			const std::chrono::steady_clock::time_point encodeStart = std::chrono::steady_clock::now();
+			if (SampleFormatConverter::IsSupported(this->renderFormat))
+			{
+				encodedBuffer.Resize((size_t)frameCount * this->renderFormat.FrameSize());
+				SampleFormatConverter::FromInternal(mixBuffer, encodedBuffer.begin(), this->renderFormat, &this->renderDitherState);
+			}
+			else
+			{
+				this->pAudioEncoder->Encode(mixBuffer, encodedBuffer);
+			}
+			const std::chrono::steady_clock::time_point mixEnd = std::chrono::steady_clock::now();
+
+			this->renderMetrics.RecordEncode(std::chrono::duration_cast<std::chrono::nanoseconds>(mixEnd - encodeStart).count());
+			this->renderMetrics.EndPeriod(frameCount, this->renderFormat.sampleRate, std::chrono::duration_cast<std::chrono::nanoseconds>(mixEnd - mixStart).count());
+
+			return encodedBuffer;
+		}
+
+		void NativeAudio::Mix(uint32_t frameCount, void* pOutput)
+		{
+			const std::chrono::steady_clock::time_point mixStart = std::chrono::steady_clock::now();
+			std::lock_guard<std::recursive_mutex> lockGuard(this->audioObjectsMutex);
+			this->renderMetrics.BeginPeriod();
+
+			if (this->renderMixBuffer.FrameCount() != frameCount || this->renderMixBuffer.FormatInfo().channelLayout != this->renderFormat.channelLayout || this->renderMixBuffer.FormatInfo().sampleRate != this->renderFormat.sampleRate)
+			{
+				this->renderMixBuffer = AudioBuffer(frameCount, this->renderFormat.channelLayout, this->renderFormat.sampleRate);
+			}
+			else
+			{
+				this->renderMixBuffer.Reset();
+			}
+			this->MixAudioObjects(this->renderMixBuffer, frameCount);
+
+			const std::chrono::steady_clock::time_point encodeStart = std::chrono::steady_clock::now();
+			if (SampleFormatConverter::IsSupported(this->renderFormat))
+			{
+				SampleFormatConverter::FromInternal(this->renderMixBuffer, pOutput, this->renderFormat, &this->renderDitherState);
+			}
+			else
+			{
+				EncodedAudioBuffer encodedBuffer(this->renderFormat);
+				this->pAudioEncoder->Encode(this->renderMixBuffer, encodedBuffer);
+				memcpy(pOutput, encodedBuffer.begin(), HEPH_MATH_MIN(encodedBuffer.Size(), (size_t)frameCount * this->renderFormat.FrameSize()));
+			}
+			const std::chrono::steady_clock::time_point mixEnd = std::chrono::steady_clock::now();
+
+			this->renderMetrics.RecordEncode(std::chrono::duration_cast<std::chrono::nanoseconds>(mixEnd - encodeStart).count());
+			this->renderMetrics.EndPeriod(frameCount, this->renderFormat.sampleRate, std::chrono::duration_cast<std::chrono::nanoseconds>(mixEnd - mixStart).count());
+		}
+
+		void NativeAudio::MixAudioObjects(AudioBuffer& mixBuffer, uint32_t frameCount)
+		{
+			const size_t stolenVoiceCount = this->SelectVoices();
+			this->busGraph.BeginPeriod(mixBuffer);
 
-			size_t audioObjectCount = this->audioObjects.size();
-			for (int32_t i = 0; i < audioObjectCount; ++i)
+			size_t mixedVoiceCount = 0;
+			for (const Voice& voice : this->voices)
 			{
-				auto it = this->audioObjects.begin();
-				std::advance(it, i);
+				if (voice.isReal || voice.isFadingOut)
+				{
+					mixedVoiceCount++;
+				}
+			}
 
-				AudioObject* pAudioObject = &(*it);
-				if (!pAudioObject->isPaused)
+			// the voices point to the objects, an event handler that destroyed or created objects may have invalidated them.
+			const uint64_t audioObjectsGeneration = this->audioObjectsGeneration;
+			for (const Voice& voice : this->voices)
+			{
+				if (this->audioObjectsGeneration != audioObjectsGeneration && !this->AudioObjectExists(voice.id))
 				{
-					const double volume = this->GetFinalAOVolume(pAudioObject) / mixedAOCount;
-					const Guid audioObjectId = pAudioObject->id;
+					continue;
+				}
 
-					AudioRenderEventArgs rArgs(this, pAudioObject, frameCount);
-					AudioRenderEventResult rResult;
+				AudioObject* pAudioObject = voice.pAudioObject;
+				if (pAudioObject->isPaused)
+				{
+					continue;
+				}
+
+				const bool isMixed = voice.isReal || voice.isFadingOut;
+				AudioRenderEventArgs rArgs(this, pAudioObject, frameCount);
+				AudioRenderEventResult rResult;
+				rArgs.isVirtual = !isMixed;
+
+				if (isMixed)
+				{
+					const std::chrono::steady_clock::time_point renderStart = std::chrono::steady_clock::now();
 					pAudioObject->OnRender(&rArgs, &rResult);
+					const uint64_t render_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - renderStart).count();
 
-					for (size_t j = 0; j < frameCount && j < rResult.renderBuffer.FrameCount(); j++)
+					this->renderMetrics.RecordAudioObjectRender(voice.id, render_ns);
+					const bool exists = this->audioObjectsGeneration == audioObjectsGeneration || this->AudioObjectExists(voice.id);
+					if (exists)
 					{
-						for (size_t k = 0; k < this->renderFormat.channelLayout.count; k++)
-						{
-							mixBuffer[j][k] += rResult.renderBuffer[j][k] * volume;
-						}
+						pAudioObject->renderStatistics.Record(render_ns);
 					}
 
-					if (rResult.isFinishedPlaying && this->AudioObjectExists(audioObjectId))
+					// the routing of a destroyed object is unknown, its last period goes to the master bus.
+					AudioBuffer* pBusBuffer = exists ? this->busGraph.GetInputBuffer(pAudioObject->busName) : nullptr;
+					const double volume = voice.volume / mixedVoiceCount;
+					NativeAudio::MixVoice(pBusBuffer != nullptr ? *pBusBuffer : mixBuffer, rResult.renderBuffer, frameCount, volume, voice);
+
+					if (exists)
 					{
-						AudioFinishedPlayingEventArgs ofpArgs(this, pAudioObject);
-						pAudioObject->OnFinishedPlaying(&ofpArgs, nullptr);
+						for (const AudioBusSend& send : pAudioObject->sends)
+						{
+							AudioBuffer* pSendBuffer = this->busGraph.GetInputBuffer(send.busName);
+							if (pSendBuffer != nullptr)
+							{
+								NativeAudio::MixVoice(*pSendBuffer, rResult.renderBuffer, frameCount, volume * send.level, voice);
+							}
+						}
 					}
+				}
+				else
+				{
+					pAudioObject->OnRender(&rArgs, &rResult);
+				}
+
+				if (rResult.isFinishedPlaying && this->AudioObjectExists(voice.id))
+				{
+					AudioFinishedPlayingEventArgs ofpArgs(this, pAudioObject);
+					pAudioObject->OnFinishedPlaying(&ofpArgs, nullptr);
+				}
+			}
 
-					// audio object is destroyed during event handling
-					// adjust the loop variables
-					const size_t currentCount = this->audioObjects.size();
-					if (audioObjectCount > currentCount)
+			this->busGraph.Process();
+			this->renderMetrics.RecordVoices(mixedVoiceCount, this->voices.size() - mixedVoiceCount, stolenVoiceCount);
+		}
+
+		void NativeAudio::MixVoice(AudioBuffer& targetBuffer, const AudioBuffer& renderBuffer, uint32_t frameCount, double volume, const Voice& voice)
+		{
+			const size_t channelCount = targetBuffer.FormatInfo().channelLayout.count;
+			const size_t renderedFrameCount = HEPH_MATH_MIN(HEPH_MATH_MIN((size_t)frameCount, renderBuffer.FrameCount()), targetBuffer.FrameCount());
+			for (size_t j = 0; j < renderedFrameCount; j++)
+			{
+				// linear ramp so switching between real and virtual does not click.
+				double gain = volume;
+				if (voice.isFadingIn)
+				{
+					gain *= (j + 1.0) / frameCount;
+				}
+				else if (voice.isFadingOut)
+				{
+					gain *= ((double)frameCount - j - 1.0) / frameCount;
+				}
+
+				for (size_t k = 0; k < channelCount; k++)
+				{
+					targetBuffer[j][k] += renderBuffer[j][k] * gain;
+				}
+			}
+		}
+
+		void NativeAudio::PrepareCaptureBuffers(size_t periodSize_frame)
+		{
+			const size_t ringBufferSize_frame = HEPH_MATH_MAX((size_t)this->captureFormat.sampleRate * this->captureRingBufferDuration_ms / 1000, periodSize_frame * 2);
+
+			this->captureRingBuffer.Reset(ringBufferSize_frame, this->captureFormat.channelLayout, this->captureFormat.sampleRate);
+			if (this->capturePeriodBuffer.FrameCount() != periodSize_frame || this->capturePeriodBuffer.FormatInfo().channelLayout != this->captureFormat.channelLayout)
+			{
+				this->capturePeriodBuffer = AudioBuffer(periodSize_frame, this->captureFormat.channelLayout, this->captureFormat.sampleRate);
+			}
+			else
+			{
+				this->capturePeriodBuffer.SetSampleRate(this->captureFormat.sampleRate);
+			}
+
+			AudioFormatInfo systemEndianFormat = this->captureFormat;
+			systemEndianFormat.endian = HEPH_SYSTEM_ENDIAN;
+			const bool swapEndian = this->captureFormat.bitsPerSample > 8 && !SampleFormatConverter::IsSupported(this->captureFormat) && SampleFormatConverter::IsSupported(systemEndianFormat);
+			this->captureSwapBuffer.resize(swapEndian ? (periodSize_frame * this->captureFormat.FrameSize()) : 0);
+		}
+
+		void NativeAudio::DeliverCapturedData(const void* pCapturedData, size_t frameCount)
+		{
+			if (frameCount > this->capturePeriodBuffer.FrameCount())
+			{
+				HEPH_RAISE_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "frameCount exceeds the capture period size, data is dropped."));
+				return;
+			}
+
+			if (SampleFormatConverter::IsSupported(this->captureFormat))
+			{
+				SampleFormatConverter::ToInternal(pCapturedData, this->captureFormat, frameCount, this->capturePeriodBuffer);
+			}
+			else if (!this->captureSwapBuffer.empty())
+			{
+				const size_t bytesPerSample = this->captureFormat.bitsPerSample / 8;
+				const size_t dataSize = frameCount * this->captureFormat.FrameSize();
+				uint8_t* pSwapBuffer = this->captureSwapBuffer.data();
+
+				(void)memcpy(pSwapBuffer, pCapturedData, dataSize);
+				for (size_t i = 0; i < dataSize; i += bytesPerSample)
+				{
+					HEPH_CHANGE_ENDIAN(pSwapBuffer + i, (uint8_t)bytesPerSample);
+				}
+
+				AudioFormatInfo systemEndianFormat = this->captureFormat;
+				systemEndianFormat.endian = HEPH_SYSTEM_ENDIAN;
+				SampleFormatConverter::ToInternal(pSwapBuffer, systemEndianFormat, frameCount, this->capturePeriodBuffer);
+			}
+			else
+			{
+				// the converter cannot read the format, the decoder allocates each period.
+				const EncodedAudioBuffer encodedBuffer((const uint8_t*)pCapturedData, frameCount * this->captureFormat.FrameSize(), this->captureFormat);
+				const AudioBuffer decodedBuffer = this->pAudioDecoder->Decode(encodedBuffer);
+				frameCount = HEPH_MATH_MIN(decodedBuffer.FrameCount(), frameCount);
+				(void)memcpy(this->capturePeriodBuffer.begin(), decodedBuffer.begin(), frameCount * this->captureFormat.channelLayout.count * sizeof(heph_audio_sample_t));
+			}
+
+			this->captureRingBuffer.Write(this->capturePeriodBuffer.begin(), frameCount);
+
+			if (this->OnCapture)
+			{
+				// lend the period buffer to the handlers, only the partial periods are copied.
+				const bool isFullPeriod = frameCount == this->capturePeriodBuffer.FrameCount();
+				AudioBuffer buffer = isFullPeriod ? std::move(this->capturePeriodBuffer) : this->capturePeriodBuffer.SubBuffer(0, frameCount);
+				AudioCaptureEventArgs captureEventArgs(this, buffer);
+				this->OnCapture(&captureEventArgs, nullptr);
+
+				if (isFullPeriod)
+				{
+					this->capturePeriodBuffer = std::move(captureEventArgs.captureBuffer);
+					if (this->capturePeriodBuffer.FrameCount() != frameCount || this->capturePeriodBuffer.FormatInfo().channelLayout != this->captureFormat.channelLayout)
 					{
-						audioObjectCount = currentCount;
-						i--;
+						// a handler took the buffer.
+						this->capturePeriodBuffer = AudioBuffer(frameCount, this->captureFormat.channelLayout, this->captureFormat.sampleRate);
 					}
 				}
 			}
-
-			EncodedAudioBuffer encodedBuffer(this->renderFormat);
-			this->pAudioEncoder->Encode(mixBuffer, encodedBuffer);
-			return encodedBuffer;
 		}
 
 		size_t NativeAudio::GetAOCountToMix() const
@@ -509,5 +911,165 @@ namespace HephAudio
 		{
 			return pAudioObject->volume;
 		}
+
+		size_t NativeAudio::SelectVoices()
+		{
+			this->voices.clear();
+			this->audibleVoiceIndices.clear();
+
+			for (AudioObject& audioObject : this->audioObjects)
+			{
+				if (!audioObject.isPaused)
+				{
+					Voice voice;
+					voice.pAudioObject = &audioObject;
+					voice.id = audioObject.id;
+					voice.volume = this->GetFinalAOVolume(&audioObject);
+					voice.isReal = voice.volume > this->virtualVolumeThreshold && audioObject.distance <= audioObject.maxDistance;
+					voice.isFadingIn = false;
+					voice.isFadingOut = false;
+
+					if (voice.isReal)
+					{
+						this->audibleVoiceIndices.push_back(this->voices.size());
+					}
+					this->voices.push_back(voice);
+				}
+			}
+
+			// keep the most important audible objects real, the objects are in the order they are created.
+			size_t stolenVoiceCount = 0;
+			if (this->maxRealVoiceCount > 0 && this->audibleVoiceIndices.size() > this->maxRealVoiceCount)
+			{
+				const std::vector<Voice>& voices = this->voices;
+				const VoiceStealingPolicy policy = this->voiceStealingPolicy;
+				auto isKeptBefore = [&voices, policy](size_t lhs, size_t rhs)
+					{
+						const Voice& lhsVoice = voices[lhs];
+						const Voice& rhsVoice = voices[rhs];
+						if (lhsVoice.pAudioObject->priority != rhsVoice.pAudioObject->priority)
+						{
+							return lhsVoice.pAudioObject->priority > rhsVoice.pAudioObject->priority;
+						}
+						if (policy == StealQuietest && lhsVoice.volume != rhsVoice.volume)
+						{
+							return lhsVoice.volume > rhsVoice.volume;
+						}
+						return policy == StealNewest ? (lhs < rhs) : (lhs > rhs);
+					};
+
+				std::nth_element(this->audibleVoiceIndices.begin(), this->audibleVoiceIndices.begin() + this->maxRealVoiceCount, this->audibleVoiceIndices.end(), isKeptBefore);
+				for (size_t i = this->maxRealVoiceCount; i < this->audibleVoiceIndices.size(); ++i)
+				{
+					Voice& voice = this->voices[this->audibleVoiceIndices[i]];
+					voice.isReal = false;
+
+					// objects that did not start playing yet are not faded.
+					if (!voice.pAudioObject->isVirtual && voice.pAudioObject->frameIndex > 0)
+					{
+						voice.isFadingOut = true;
+						stolenVoiceCount++;
+					}
+				}
+			}
+
+			// the playing objects that became silent or went out of range are faded out like the stolen ones.
+			for (Voice& voice : this->voices)
+			{
+				AudioObject* pAudioObject = voice.pAudioObject;
+				voice.isFadingIn = voice.isReal && pAudioObject->isVirtual && pAudioObject->frameIndex > 0;
+				voice.isFadingOut = voice.isFadingOut || (!voice.isReal && !pAudioObject->isVirtual && pAudioObject->frameIndex > 0);
+				pAudioObject->isVirtual = !voice.isReal;
+			}
+
+			return stolenVoiceCount;
+		}
+
+		void NativeAudio::ReadFile(AudioObject& audioObject, const std::filesystem::path& filePath, IAudioDecoder& decoder,
+			const std::shared_ptr<AudioAssetCache>& pAssetCache, size_t compressedResidencyThreshold_frame)
+		{
+			audioObject.filePath = filePath;
+			audioObject.name = filePath.filename().string();
+
+			bool isCompressed = false;
+			if (compressedResidencyThreshold_frame > 0)
+			{
+				decoder.CloseFile();
+				decoder.ChangeFile(filePath);
+				isCompressed = decoder.GetFrameCount() > compressedResidencyThreshold_frame;
+			}
+
+			if (isCompressed)
+			{
+				if (pAssetCache != nullptr)
+				{
+					audioObject.pCompressedBuffer = pAssetCache->GetCompressed(filePath, decoder);
+				}
+				else
+				{
+					audioObject.pCompressedBuffer = std::make_shared<const CompressedAudioBuffer>(decoder);
+				}
+			}
+			else if (pAssetCache != nullptr)
+			{
+				audioObject.pSharedBuffer = pAssetCache->Get(filePath, decoder);
+			}
+			else
+			{
+				decoder.ChangeFile(filePath);
+				audioObject.buffer = decoder.Decode();
+			}
+		}
+
+		void NativeAudio::SubmitLoad(const std::filesystem::path& filePath, uint32_t playCount, bool isPaused, std::function<void(AudioObject*, std::exception_ptr)> onLoaded)
+		{
+			HEPHAUDIO_LOG("Loading \"" + filePath.filename().string() + "\" asynchronously", HEPH_CL_INFO);
+
+			std::shared_ptr<AudioAssetCache> pAssetCache;
+			size_t compressedResidencyThreshold_frame;
+			AudioDecoderFactory decoderFactory;
+			{
+				std::lock_guard<std::recursive_mutex> lockGuard(this->audioObjectsMutex);
+				pAssetCache = this->pAssetCache;
+				compressedResidencyThreshold_frame = this->compressedResidencyThreshold_frame;
+				decoderFactory = this->audioDecoderFactory;
+			}
+
+			this->loadThreadPool.Submit([this, filePath, playCount, isPaused, pAssetCache, compressedResidencyThreshold_frame, decoderFactory, onLoaded]()
+				{
+					AudioObject* pAudioObject = nullptr;
+					std::exception_ptr pException = nullptr;
+					try
+					{
+						if (!std::filesystem::exists(filePath))
+						{
+							HEPH_RAISE_AND_THROW_EXCEPTION(this, NotFoundException(HEPH_FUNC, "file not found."));
+						}
+
+						// the object is built in its own list and spliced, so the audio objects are locked only to link the node.
+						std::list<AudioObject> loadedObjects;
+						AudioObject& audioObject = loadedObjects.emplace_back();
+
+						std::shared_ptr<IAudioDecoder> pDecoder = decoderFactory();
+						NativeAudio::ReadFile(audioObject, filePath, *pDecoder, pAssetCache, compressedResidencyThreshold_frame);
+						pDecoder->CloseFile();
+
+						audioObject.playCount = playCount;
+						audioObject.isPaused = isPaused;
+						{
+							std::lock_guard<std::recursive_mutex> lockGuard(this->audioObjectsMutex);
+							this->audioObjects.splice(this->audioObjects.end(), loadedObjects);
+							this->audioObjectsGeneration++;
+						}
+						pAudioObject = &audioObject;
+					}
+					catch (...)
+					{
+						pException = std::current_exception();
+					}
+
+					onLoaded(pAudioObject, pException);
+				});
+		}
 	}
 }
\ No newline at end of file
@@ -0,0 +1,366 @@
+#include "NativeAudio/NullAudio.h"
+#include "AudioEffects/ChannelMapper.h"
+#include "AudioEffects/Resampler.h"
+#include "SampleFormatConverter.h"
+#include "WavAudioEncoder.h"
+#include "ConsoleLogger.h"
+#include "Stopwatch.h"
+#include "StringHelpers.h"
+#include "HephMath.h"
+#include "Exceptions/ExternalException.h"
+#include "Exceptions/InvalidArgumentException.h"
+#include "Exceptions/NotFoundException.h"
+#include <cerrno>
+#include <cstring>
+#include <thread>
+
+#define NULLAUDIO_RENDER_DEVICE_ID "null:render"
+#define NULLAUDIO_CAPTURE_DEVICE_ID "null:capture"
+
+using namespace Heph;
+
+namespace HephAudio
+{
+	namespace Native
+	{
+		NullAudio::NullAudio()
+			: NativeAudio(), masterVolume(1.0), renderPeriodSize_frame(0), capturePeriodSize_frame(0), renderedFrameCount(0), capturedFrameCount(0),
+			captureFilePosition_frame(0), pRenderFile(nullptr), renderFileDataSize(0)
+		{
+			// the devices never change, no need for the device thread.
+			this->EnumerateAudioDevices();
+		}
+		NullAudio::~NullAudio()
+		{
+			HEPH_SW_RESET;
+			HEPHAUDIO_LOG("Destructing NullAudio...", HEPH_CL_INFO);
+
+			disposing = true;
+
+			JoinRenderThread();
+			JoinCaptureThread();
+
+			CloseRenderFile();
+
+			HEPHAUDIO_LOG("NullAudio destructed in " + StringHelpers::ToString(HEPH_SW_DT_MS, 4) + " ms.", HEPH_CL_INFO);
+		}
+		void NullAudio::SetMasterVolume(double volume)
+		{
+			if (volume < 0)
+			{
+				volume = -volume;
+			}
+			masterVolume = HEPH_MATH_MIN(volume, 1);
+		}
+		double NullAudio::GetMasterVolume() const
+		{
+			return masterVolume;
+		}
+		void NullAudio::InitializeRender(AudioDevice* device, AudioFormatInfo format)
+		{
+			HEPH_SW_RESET;
+			HEPHAUDIO_LOG(device == nullptr ? "Initializing render with the default device..." : ("Initializing render (" + device->name + ")..."), HEPH_CL_INFO);
+
+			StopRendering();
+
+			renderDeviceId = device != nullptr ? device->id : NULLAUDIO_RENDER_DEVICE_ID;
+			renderFormat = format;
+			renderPeriodSize_frame = HEPH_MATH_MAX((uint32_t)(renderFormat.sampleRate * this->params.renderBufferDuration_ms / 1000.0), (uint32_t)1);
+			renderTransferBuffer.resize(renderPeriodSize_frame * renderFormat.FrameSize());
+			renderedFrameCount = 0;
+
+			if (!this->params.renderFilePath.empty())
+			{
+				// WAV files are little endian.
+				renderFormat.endian = Endian::Little;
+				OpenRenderFile();
+			}
+
+			isRenderInitialized = true;
+			renderThread = std::thread(&NullAudio::RenderData, this);
+
+			HEPHAUDIO_LOG("Render initialized in " + StringHelpers::ToString(HEPH_SW_DT_MS, 4) + " ms.", HEPH_CL_INFO);
+		}
+		void NullAudio::StopRendering()
+		{
+			if (isRenderInitialized)
+			{
+				isRenderInitialized = false;
+				renderDeviceId = "";
+				JoinRenderThread();
+				CloseRenderFile();
+				HEPHAUDIO_LOG("Stopped rendering.", HEPH_CL_INFO);
+			}
+		}
+		void NullAudio::InitializeCapture(AudioDevice* device, AudioFormatInfo format)
+		{
+			HEPH_SW_RESET;
+			HEPHAUDIO_LOG(device == nullptr ? "Initializing capture with the default device..." : ("Initializing capture (" + device->name + ")..."), HEPH_CL_INFO);
+
+			StopCapturing();
+
+			captureDeviceId = device != nullptr ? device->id : NULLAUDIO_CAPTURE_DEVICE_ID;
+			captureFormat = format;
+			capturePeriodSize_frame = HEPH_MATH_MAX((uint32_t)(captureFormat.sampleRate * this->params.captureBufferDuration_ms / 1000.0), (uint32_t)1);
+			captureTransferBuffer.resize(capturePeriodSize_frame * captureFormat.FrameSize());
+			captureFilePosition_frame = 0;
+			capturedFrameCount = 0;
+
+			captureFileData.clear();
+			if (!this->params.captureFilePath.empty())
+			{
+				if (!std::filesystem::exists(this->params.captureFilePath))
+				{
+					HEPH_RAISE_AND_THROW_EXCEPTION(this, NotFoundException(HEPH_FUNC, "capture file not found."));
+				}
+
+				AudioBuffer fileBuffer;
+				{
+					// the decoder is shared with Play.
+					std::lock_guard<std::recursive_mutex> lockGuard(this->audioObjectsMutex);
+					this->pAudioDecoder->ChangeFile(this->params.captureFilePath);
+					fileBuffer = this->pAudioDecoder->Decode();
+					this->pAudioDecoder->CloseFile();
+				}
+
+				if (fileBuffer.FormatInfo().channelLayout != captureFormat.channelLayout)
+				{
+					ChannelMapper(captureFormat.channelLayout).Process(fileBuffer);
+				}
+				if (fileBuffer.FormatInfo().sampleRate != captureFormat.sampleRate)
+				{
+					Resampler(captureFormat.sampleRate).Process(fileBuffer);
+				}
+
+				// store the file in capture format so the capture thread exercises the same conversion path as a real device.
+				EncodeCaptureData(fileBuffer, captureFileData);
+			}
+			EncodeCaptureData(AudioBuffer(capturePeriodSize_frame, captureFormat.channelLayout, captureFormat.sampleRate), captureSilence);
+			PrepareCaptureBuffers(capturePeriodSize_frame);
+
+			isCaptureInitialized = true;
+			captureThread = std::thread(&NullAudio::CaptureData, this);
+
+			HEPHAUDIO_LOG("Capture initialized in " + StringHelpers::ToString(HEPH_SW_DT_MS, 4) + " ms.", HEPH_CL_INFO);
+		}
+		void NullAudio::StopCapturing()
+		{
+			if (isCaptureInitialized)
+			{
+				isCaptureInitialized = false;
+				captureDeviceId = "";
+				JoinCaptureThread();
+				HEPHAUDIO_LOG("Stopped capturing.", HEPH_CL_INFO);
+			}
+		}
+		void NullAudio::GetNativeParams(NativeAudioParams& nativeParams) const
+		{
+			NullAudioParams* pNullAudioParams = dynamic_cast<NullAudioParams*>(&nativeParams);
+			if (pNullAudioParams == nullptr)
+			{
+				HEPH_RAISE_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "nativeParams must be a NullAudioParams instance."));
+				return;
+			}
+			(*pNullAudioParams) = this->params;
+		}
+		void NullAudio::SetNativeParams(const NativeAudioParams& nativeParams)
+		{
+			const NullAudioParams* pNullAudioParams = dynamic_cast<const NullAudioParams*>(&nativeParams);
+			if (pNullAudioParams == nullptr)
+			{
+				HEPH_RAISE_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "nativeParams must be a NullAudioParams instance."));
+				return;
+			}
+			this->params = *pNullAudioParams;
+		}
+		uint64_t NullAudio::GetRenderedFrameCount() const
+		{
+			return renderedFrameCount.load(std::memory_order_relaxed);
+		}
+		uint64_t NullAudio::GetCapturedFrameCount() const
+		{
+			return capturedFrameCount.load(std::memory_order_relaxed);
+		}
+		bool NullAudio::EnumerateAudioDevices()
+		{
+			AudioDevice renderDevice;
+			renderDevice.id = NULLAUDIO_RENDER_DEVICE_ID;
+			renderDevice.name = "Null Render Device";
+			renderDevice.type = AudioDeviceType::Render;
+			renderDevice.isDefault = true;
+			this->audioDevices.push_back(renderDevice);
+
+			AudioDevice captureDevice;
+			captureDevice.id = NULLAUDIO_CAPTURE_DEVICE_ID;
+			captureDevice.name = "Null Capture Device";
+			captureDevice.type = AudioDeviceType::Capture;
+			captureDevice.isDefault = true;
+			this->audioDevices.push_back(captureDevice);
+
+			return NativeAudio::DEVICE_ENUMERATION_SUCCESS;
+		}
+		double NullAudio::GetFinalAOVolume(AudioObject* pAudioObject) const
+		{
+			return NativeAudio::GetFinalAOVolume(pAudioObject) * masterVolume;
+		}
+		void NullAudio::RenderData()
+		{
+			std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+			uint64_t elapsedFrameCount = 0;
+
+			while (!disposing && isRenderInitialized)
+			{
+				Mix(renderPeriodSize_frame, renderTransferBuffer.data());
+
+				if (pRenderFile != nullptr)
+				{
+					if (fwrite(renderTransferBuffer.data(), 1, renderTransferBuffer.size(), pRenderFile) != renderTransferBuffer.size())
+					{
+						HEPHAUDIO_LOG("Failed to write to the render file, closing it.", HEPH_CL_ERROR);
+						CloseRenderFile();
+					}
+					else
+					{
+						renderFileDataSize += renderTransferBuffer.size();
+					}
+				}
+
+				renderedFrameCount.fetch_add(renderPeriodSize_frame, std::memory_order_relaxed);
+				WaitForNextPeriod(startTime, elapsedFrameCount, renderPeriodSize_frame, renderFormat.sampleRate, true);
+			}
+		}
+		void NullAudio::CaptureData()
+		{
+			const size_t frameSize = captureFormat.FrameSize();
+			const size_t fileFrameCount = captureFileData.size() / frameSize;
+			std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+			uint64_t elapsedFrameCount = 0;
+
+			while (!disposing && isCaptureInitialized)
+			{
+				size_t frameIndex = 0;
+				while (frameIndex < capturePeriodSize_frame)
+				{
+					if (captureFilePosition_frame >= fileFrameCount)
+					{
+						if (this->params.loopCaptureFile && fileFrameCount > 0)
+						{
+							captureFilePosition_frame = 0;
+							continue;
+						}
+
+						memcpy(captureTransferBuffer.data() + frameIndex * frameSize, captureSilence.data() + frameIndex * frameSize, (capturePeriodSize_frame - frameIndex) * frameSize);
+						break;
+					}
+
+					const size_t frameCount = HEPH_MATH_MIN((size_t)capturePeriodSize_frame - frameIndex, fileFrameCount - captureFilePosition_frame);
+					memcpy(captureTransferBuffer.data() + frameIndex * frameSize, captureFileData.data() + captureFilePosition_frame * frameSize, frameCount * frameSize);
+					frameIndex += frameCount;
+					captureFilePosition_frame += frameCount;
+				}
+
+				if (!isCapturePaused)
+				{
+					DeliverCapturedData(captureTransferBuffer.data(), capturePeriodSize_frame);
+				}
+
+				capturedFrameCount.fetch_add(capturePeriodSize_frame, std::memory_order_relaxed);
+				WaitForNextPeriod(startTime, elapsedFrameCount, capturePeriodSize_frame, captureFormat.sampleRate, false);
+			}
+		}
+		void NullAudio::WaitForNextPeriod(std::chrono::steady_clock::time_point& startTime, uint64_t& elapsedFrameCount, uint32_t periodSize_frame, uint32_t sampleRate, bool isRender)
+		{
+			if (this->params.clock == NullAudioClock::FreeRunning)
+			{
+				return;
+			}
+
+			// deadlines are calculated from the start time to avoid accumulating rounding errors.
+			elapsedFrameCount += periodSize_frame;
+			const std::chrono::steady_clock::time_point deadline = startTime + std::chrono::nanoseconds(elapsedFrameCount * 1000000000ull / sampleRate);
+			const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+			if (now > deadline)
+			{
+				if (isRender)
+				{
+					this->renderMetrics.RecordUnderrun();
+				}
+				else
+				{
+					this->renderMetrics.RecordOverrun();
+				}
+
+				// a real device would have dropped the late period, restart the clock.
+				startTime = now;
+				elapsedFrameCount = 0;
+			}
+			else
+			{
+				std::this_thread::sleep_until(deadline);
+			}
+		}
+		void NullAudio::EncodeCaptureData(const AudioBuffer& buffer, std::vector<uint8_t>& data)
+		{
+			AudioFormatInfo systemEndianFormat = captureFormat;
+			systemEndianFormat.endian = HEPH_SYSTEM_ENDIAN;
+
+			data.resize(buffer.FrameCount() * captureFormat.FrameSize());
+			if (SampleFormatConverter::IsSupported(captureFormat))
+			{
+				SampleFormatConverter::FromInternal(buffer, data.data(), captureFormat);
+			}
+			else if (captureFormat.bitsPerSample > 8 && SampleFormatConverter::IsSupported(systemEndianFormat))
+			{
+				const size_t bytesPerSample = captureFormat.bitsPerSample / 8;
+				SampleFormatConverter::FromInternal(buffer, data.data(), systemEndianFormat);
+				for (size_t i = 0; i < data.size(); i += bytesPerSample)
+				{
+					HEPH_CHANGE_ENDIAN(data.data() + i, (uint8_t)bytesPerSample);
+				}
+			}
+			else
+			{
+				EncodedAudioBuffer encodedBuffer(captureFormat);
+				this->pAudioEncoder->Encode(buffer, encodedBuffer);
+				memcpy(data.data(), encodedBuffer.begin(), HEPH_MATH_MIN(encodedBuffer.Size(), data.size()));
+			}
+		}
+		void NullAudio::OpenRenderFile()
+		{
+			pRenderFile = fopen(this->params.renderFilePath.string().c_str(), "wb");
+			if (pRenderFile == nullptr)
+			{
+				HEPH_RAISE_AND_THROW_EXCEPTION(this, ExternalException(HEPH_FUNC, "Failed to open the render file.", "C Runtime", strerror(errno)));
+			}
+
+			// sizes are filled in when the file is closed.
+			const std::vector<uint8_t> header = WavAudioEncoder::CreateHeader(renderFormat, 0, false);
+			fwrite(header.data(), 1, header.size(), pRenderFile);
+			renderFileDataSize = 0;
+		}
+		void NullAudio::CloseRenderFile()
+		{
+			if (pRenderFile == nullptr)
+			{
+				return;
+			}
+
+			// chunks are padded to even sizes.
+			const uint8_t padding = 0;
+			if ((renderFileDataSize & 1) != 0 && fwrite(&padding, 1, 1, pRenderFile) != 1)
+			{
+				HEPHAUDIO_LOG("Failed to write the render file padding.", HEPH_CL_ERROR);
+			}
+
+			const std::vector<uint8_t> header = WavAudioEncoder::CreateHeader(renderFormat, renderFileDataSize, true);
+			if (fseek(pRenderFile, 0, SEEK_SET) != 0 || fwrite(header.data(), 1, header.size(), pRenderFile) != header.size())
+			{
+				HEPHAUDIO_LOG("Failed to write the render file header.", HEPH_CL_ERROR);
+			}
+
+			fclose(pRenderFile);
+			pRenderFile = nullptr;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,223 @@
+#include "NativeAudio/RenderMetrics.h"
+#include <cstring>
+
+using namespace Heph;
+
+namespace HephAudio
+{
+	namespace Native
+	{
+		static_assert(sizeof(Guid) == 2 * sizeof(uint64_t), "Guid must fit in two 64 bit words");
+
+		DeadlineMissInfo::DeadlineMissInfo()
+			: periodIndex(0), period_ns(0), mix_ns(0), encode_ns(0), slowestAudioObjectId(), slowestAudioObjectRender_ns(0) {}
+
+		RenderMetrics::RenderMetrics()
+			: periodCount(0), deadlineMissCount(0), underrunCount(0), overrunCount(0),
+			lastPeriod_ns(0), lastHeadroom_ns(0), minHeadroom_ns(INT64_MAX),
+			realVoiceCount(0), virtualVoiceCount(0), stolenVoiceCount(0),
+			deadlineMissSequence(0), dmPeriodIndex(0), dmPeriod_ns(0), dmMix_ns(0), dmEncode_ns(0),
+			dmSlowestAudioObjectId{ 0, 0 }, dmSlowestAudioObjectRender_ns(0),
+			currentSlowestAudioObjectId(), currentSlowestAudioObjectRender_ns(0), currentEncode_ns(0) {}
+
+		void RenderMetrics::BeginPeriod()
+		{
+			this->currentSlowestAudioObjectId = Guid();
+			this->currentSlowestAudioObjectRender_ns = 0;
+			this->currentEncode_ns = 0;
+		}
+
+		void RenderMetrics::RecordAudioObjectRender(const Guid& audioObjectId, uint64_t duration_ns)
+		{
+			this->audioObjectRenderStatistics.Record(duration_ns);
+			if (duration_ns >= this->currentSlowestAudioObjectRender_ns)
+			{
+				this->currentSlowestAudioObjectId = audioObjectId;
+				this->currentSlowestAudioObjectRender_ns = duration_ns;
+			}
+		}
+
+		void RenderMetrics::RecordEncode(uint64_t duration_ns)
+		{
+			this->encodeStatistics.Record(duration_ns);
+			this->currentEncode_ns = duration_ns;
+		}
+
+		void RenderMetrics::EndPeriod(size_t frameCount, uint32_t sampleRate, uint64_t mix_ns)
+		{
+			const uint64_t period_ns = sampleRate > 0 ? (uint64_t)(frameCount * 1e9 / sampleRate) : 0;
+			const int64_t headroom_ns = (int64_t)period_ns - (int64_t)mix_ns;
+			const uint64_t periodIndex = this->periodCount.load(std::memory_order_relaxed);
+
+			this->mixStatistics.Record(mix_ns);
+			this->lastPeriod_ns.store(period_ns, std::memory_order_relaxed);
+			this->lastHeadroom_ns.store(headroom_ns, std::memory_order_relaxed);
+			if (headroom_ns < this->minHeadroom_ns.load(std::memory_order_relaxed))
+			{
+				this->minHeadroom_ns.store(headroom_ns, std::memory_order_relaxed);
+			}
+
+			if (headroom_ns < 0)
+			{
+				uint64_t guidWords[2];
+				memcpy(guidWords, &this->currentSlowestAudioObjectId, sizeof(Guid));
+
+				const uint64_t sequence = this->deadlineMissSequence.load(std::memory_order_relaxed);
+				this->deadlineMissSequence.store(sequence + 1, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_release);
+
+				this->dmPeriodIndex.store(periodIndex, std::memory_order_relaxed);
+				this->dmPeriod_ns.store(period_ns, std::memory_order_relaxed);
+				this->dmMix_ns.store(mix_ns, std::memory_order_relaxed);
+				this->dmEncode_ns.store(this->currentEncode_ns, std::memory_order_relaxed);
+				this->dmSlowestAudioObjectId[0].store(guidWords[0], std::memory_order_relaxed);
+				this->dmSlowestAudioObjectId[1].store(guidWords[1], std::memory_order_relaxed);
+				this->dmSlowestAudioObjectRender_ns.store(this->currentSlowestAudioObjectRender_ns, std::memory_order_relaxed);
+
+				this->deadlineMissSequence.store(sequence + 2, std::memory_order_release);
+				this->deadlineMissCount.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			this->periodCount.fetch_add(1, std::memory_order_release);
+		}
+
+		void RenderMetrics::RecordVoices(size_t realVoiceCount, size_t virtualVoiceCount, size_t stolenVoiceCount)
+		{
+			this->realVoiceCount.store(realVoiceCount, std::memory_order_relaxed);
+			this->virtualVoiceCount.store(virtualVoiceCount, std::memory_order_relaxed);
+			this->stolenVoiceCount.fetch_add(stolenVoiceCount, std::memory_order_relaxed);
+		}
+
+		void RenderMetrics::RecordUnderrun(uint64_t count)
+		{
+			this->underrunCount.fetch_add(count, std::memory_order_relaxed);
+		}
+
+		void RenderMetrics::RecordOverrun(uint64_t count)
+		{
+			this->overrunCount.fetch_add(count, std::memory_order_relaxed);
+		}
+
+		TimingStatisticsSnapshot RenderMetrics::GetMixStatistics() const
+		{
+			return this->mixStatistics.GetSnapshot();
+		}
+
+		TimingStatisticsSnapshot RenderMetrics::GetAudioObjectRenderStatistics() const
+		{
+			return this->audioObjectRenderStatistics.GetSnapshot();
+		}
+
+		TimingStatisticsSnapshot RenderMetrics::GetEncodeStatistics() const
+		{
+			return this->encodeStatistics.GetSnapshot();
+		}
+
+		uint64_t RenderMetrics::GetPeriodCount() const
+		{
+			return this->periodCount.load(std::memory_order_acquire);
+		}
+
+		uint64_t RenderMetrics::GetDeadlineMissCount() const
+		{
+			return this->deadlineMissCount.load(std::memory_order_relaxed);
+		}
+
+		uint64_t RenderMetrics::GetRealVoiceCount() const
+		{
+			return this->realVoiceCount.load(std::memory_order_relaxed);
+		}
+
+		uint64_t RenderMetrics::GetVirtualVoiceCount() const
+		{
+			return this->virtualVoiceCount.load(std::memory_order_relaxed);
+		}
+
+		uint64_t RenderMetrics::GetStolenVoiceCount() const
+		{
+			return this->stolenVoiceCount.load(std::memory_order_relaxed);
+		}
+
+		uint64_t RenderMetrics::GetUnderrunCount() const
+		{
+			return this->underrunCount.load(std::memory_order_relaxed);
+		}
+
+		uint64_t RenderMetrics::GetOverrunCount() const
+		{
+			return this->overrunCount.load(std::memory_order_relaxed);
+		}
+
+		uint64_t RenderMetrics::GetLastPeriod_ns() const
+		{
+			return this->lastPeriod_ns.load(std::memory_order_relaxed);
+		}
+
+		int64_t RenderMetrics::GetLastHeadroom_ns() const
+		{
+			return this->lastHeadroom_ns.load(std::memory_order_relaxed);
+		}
+
+		int64_t RenderMetrics::GetMinHeadroom_ns() const
+		{
+			const int64_t minHeadroom_ns = this->minHeadroom_ns.load(std::memory_order_relaxed);
+			return minHeadroom_ns == INT64_MAX ? 0 : minHeadroom_ns;
+		}
+
+		double RenderMetrics::GetLastLoad() const
+		{
+			const uint64_t period_ns = this->lastPeriod_ns.load(std::memory_order_relaxed);
+			if (period_ns == 0)
+			{
+				return 0.0;
+			}
+			return (double)this->mixStatistics.GetSnapshot().last_ns / period_ns;
+		}
+
+		bool RenderMetrics::GetLastDeadlineMiss(DeadlineMissInfo& deadlineMissInfo) const
+		{
+			uint64_t sequence1, sequence2;
+			uint64_t guidWords[2];
+
+			do
+			{
+				sequence1 = this->deadlineMissSequence.load(std::memory_order_acquire);
+				if (sequence1 == 0)
+				{
+					return false;
+				}
+
+				deadlineMissInfo.periodIndex = this->dmPeriodIndex.load(std::memory_order_relaxed);
+				deadlineMissInfo.period_ns = this->dmPeriod_ns.load(std::memory_order_relaxed);
+				deadlineMissInfo.mix_ns = this->dmMix_ns.load(std::memory_order_relaxed);
+				deadlineMissInfo.encode_ns = this->dmEncode_ns.load(std::memory_order_relaxed);
+				guidWords[0] = this->dmSlowestAudioObjectId[0].load(std::memory_order_relaxed);
+				guidWords[1] = this->dmSlowestAudioObjectId[1].load(std::memory_order_relaxed);
+				deadlineMissInfo.slowestAudioObjectRender_ns = this->dmSlowestAudioObjectRender_ns.load(std::memory_order_relaxed);
+
+				std::atomic_thread_fence(std::memory_order_acquire);
+				sequence2 = this->deadlineMissSequence.load(std::memory_order_relaxed);
+			} while ((sequence1 & 1) != 0 || sequence1 != sequence2);
+
+			memcpy(&deadlineMissInfo.slowestAudioObjectId, guidWords, sizeof(Guid));
+			return true;
+		}
+
+		void RenderMetrics::Reset()
+		{
+			this->mixStatistics.Reset();
+			this->audioObjectRenderStatistics.Reset();
+			this->encodeStatistics.Reset();
+			this->periodCount.store(0, std::memory_order_relaxed);
+			this->deadlineMissCount.store(0, std::memory_order_relaxed);
+			this->underrunCount.store(0, std::memory_order_relaxed);
+			this->overrunCount.store(0, std::memory_order_relaxed);
+			this->lastPeriod_ns.store(0, std::memory_order_relaxed);
+			this->lastHeadroom_ns.store(0, std::memory_order_relaxed);
+			this->minHeadroom_ns.store(INT64_MAX, std::memory_order_relaxed);
+			this->realVoiceCount.store(0, std::memory_order_relaxed);
+			this->virtualVoiceCount.store(0, std::memory_order_relaxed);
+			this->stolenVoiceCount.store(0, std::memory_order_relaxed);
+		}
+	}
+}
\ No newline at end of file
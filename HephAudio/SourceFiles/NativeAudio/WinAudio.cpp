@@ -299,7 +299,6 @@ namespace HephAudio
 			WAVEFORMATEXTENSIBLE wfx = WinAudioBase::AFI2WFX(format);
 			HANDLE hEvent = nullptr;
 			UINT32 padding, nFramesAvailable, bufferSize;
-			EncodedAudioBuffer mixedBuffer;
 			void* renderBuffer = nullptr;
 			HRESULT hres;
 
@@ -381,10 +380,8 @@ namespace HephAudio
 
 				if (nFramesAvailable > 0)
 				{
-					mixedBuffer = this->Mix(nFramesAvailable);
-
 					WINAUDIO_RENDER_THREAD_EXCPT(pRenderClient->GetBuffer(nFramesAvailable, (BYTE**)&renderBuffer), HEPH_FUNC, "An error occurred while rendering the samples.");
-					(void)memcpy(renderBuffer, mixedBuffer.begin(), (size_t)nFramesAvailable * this->renderFormat.FrameSize());
+					this->Mix(nFramesAvailable, renderBuffer);
 					WINAUDIO_RENDER_THREAD_EXCPT(pRenderClient->ReleaseBuffer(nFramesAvailable, 0), HEPH_FUNC, "An error occurred while rendering the samples.");
 				}
 			}
@@ -465,6 +462,7 @@ namespace HephAudio
 
 			WINAUDIO_CAPTURE_THREAD_EXCPT(pAudioClient->GetBufferSize(&bufferSize), HEPH_FUNC, "An error occurred while capturing the samples.");
 			halfActualBufferDuration_ms = 500.0 * bufferSize / this->captureFormat.sampleRate;
+			this->PrepareCaptureBuffers(bufferSize);
 
 			WINAUDIO_CAPTURE_THREAD_EXCPT(pAudioClient->GetService(__uuidof(IAudioCaptureClient), &pCaptureClient), HEPH_FUNC, "An error occurred while capturing the samples.");
 			WINAUDIO_CAPTURE_THREAD_EXCPT(pAudioClient->Start(), HEPH_FUNC, "An error occurred while capturing the samples.");
@@ -473,25 +471,19 @@ namespace HephAudio
 
 			while (!this->disposing && this->isCaptureInitialized)
 			{
-				if (!this->isCapturePaused && this->OnCapture)
+				// the packets are consumed even when the capture is paused so the ring buffer does not receive stale data on resume.
+				WINAUDIO_CAPTURE_THREAD_EXCPT(pCaptureClient->GetNextPacketSize(&packetLength), HEPH_FUNC, "An error occurred while capturing the samples.");
+				while (packetLength != 0)
 				{
-					WINAUDIO_CAPTURE_THREAD_EXCPT(pCaptureClient->GetNextPacketSize(&packetLength), HEPH_FUNC, "An error occurred while capturing the samples.");
-					while (packetLength != 0)
-					{
-						WINAUDIO_CAPTURE_THREAD_EXCPT(pCaptureClient->GetBuffer(&captureBuffer, &nFramesAvailable, &flags, nullptr, nullptr), HEPH_FUNC, "An error occurred while capturing the samples.");
-
-						if (nFramesAvailable > 0)
-						{
-							EncodedAudioBuffer encodedBuffer((const uint8_t*)captureBuffer, nFramesAvailable * this->captureFormat.FrameSize(), this->captureFormat);
-							AudioBuffer buffer = this->pAudioDecoder->Decode(encodedBuffer);
+					WINAUDIO_CAPTURE_THREAD_EXCPT(pCaptureClient->GetBuffer(&captureBuffer, &nFramesAvailable, &flags, nullptr, nullptr), HEPH_FUNC, "An error occurred while capturing the samples.");
 
-							AudioCaptureEventArgs captureEventArgs(this, buffer);
-							this->OnCapture(&captureEventArgs, nullptr);
-						}
-
-						WINAUDIO_CAPTURE_THREAD_EXCPT(pCaptureClient->ReleaseBuffer(nFramesAvailable), HEPH_FUNC, "An error occurred while capturing the samples.");
-						WINAUDIO_CAPTURE_THREAD_EXCPT(pCaptureClient->GetNextPacketSize(&packetLength), HEPH_FUNC, "An error occurred while capturing the samples.");
+					if (nFramesAvailable > 0 && !this->isCapturePaused)
+					{
+						this->DeliverCapturedData(captureBuffer, nFramesAvailable);
 					}
+
+					WINAUDIO_CAPTURE_THREAD_EXCPT(pCaptureClient->ReleaseBuffer(nFramesAvailable), HEPH_FUNC, "An error occurred while capturing the samples.");
+					WINAUDIO_CAPTURE_THREAD_EXCPT(pCaptureClient->GetNextPacketSize(&packetLength), HEPH_FUNC, "An error occurred while capturing the samples.");
 				}
 				std::this_thread::sleep_for(std::chrono::milliseconds(halfActualBufferDuration_ms));
 			}
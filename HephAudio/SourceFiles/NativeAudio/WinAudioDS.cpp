@@ -205,7 +205,7 @@ namespace HephAudio
 			void* audioPtr1 = nullptr;
 			void* audioPtr2 = nullptr;
 			DWORD audioBytes1 = 0, audioBytes2 = 0;
-			EncodedAudioBuffer mixedBuffer;
+			std::vector<uint8_t> mixedBuffer;
 			size_t mixedBufferSize_byte = 0;
 			size_t nFramesToRead;
 			HANDLE hEvents[notificationCount]{ nullptr };
@@ -221,6 +221,7 @@ namespace HephAudio
 			WinAudioDS::RestrictAudioFormatInfo(this->renderFormat, dsCaps);
 			nFramesToRead = this->renderFormat.ByteRate() / 100; // 10ms
 			mixedBufferSize_byte = nFramesToRead * this->renderFormat.FrameSize();
+			mixedBuffer.resize(mixedBufferSize_byte);
 
 			wfx = WinAudioBase::AFI2WFX(this->renderFormat);
 			bufferDesc.dwSize = sizeof(DSBUFFERDESC);
@@ -267,13 +268,14 @@ namespace HephAudio
 					WINAUDIODS_RENDER_THREAD_EXCPT(E_FAIL, HEPH_FUNC, "Render time-out.");
 				}
 
-				mixedBuffer = this->Mix(nFramesToRead);
+				// the locked region may wrap around the end of the buffer, hence the period is mixed into the preallocated buffer first.
+				this->Mix(nFramesToRead, mixedBuffer.data());
 
 				WINAUDIODS_RENDER_THREAD_EXCPT(pDirectSoundBuffer->Lock(0, mixedBufferSize_byte, &audioPtr1, &audioBytes1, &audioPtr2, &audioBytes2, DSBLOCK_FROMWRITECURSOR), HEPH_FUNC, "An error occurred while rendering the samples.");
-				(void)memcpy(audioPtr1, mixedBuffer.begin(), audioBytes1);
+				(void)memcpy(audioPtr1, mixedBuffer.data(), audioBytes1);
 				if (audioPtr2 != nullptr)
 				{
-					(void)memcpy(audioPtr2, mixedBuffer.begin() + audioBytes1, audioBytes2);
+					(void)memcpy(audioPtr2, mixedBuffer.data() + audioBytes1, audioBytes2);
 				}
 				WINAUDIODS_RENDER_THREAD_EXCPT(pDirectSoundBuffer->Unlock(audioPtr1, audioBytes1, audioPtr2, audioBytes2), HEPH_FUNC, "An error occurred while rendering the samples.");
 			}
@@ -346,6 +348,7 @@ namespace HephAudio
 
 			nFramesToRead = this->captureFormat.sampleRate * bufferDuration_s;
 			nBytesToRead = nFramesToRead * this->captureFormat.FrameSize();
+			this->PrepareCaptureBuffers(nFramesToRead);
 
 			for (size_t i = 0; i < notificationCount; i++)
 			{
@@ -367,7 +370,7 @@ namespace HephAudio
 
 			while (!this->disposing && this->isCaptureInitialized)
 			{
-				if (!this->isCapturePaused && this->OnCapture)
+				if (!this->isCapturePaused)
 				{
 					bool waitSuccessfull = false;
 					const DWORD waitForNotificationResult = WaitForMultipleObjects(notificationCount, hEvents, FALSE, 2000);
@@ -386,16 +389,12 @@ namespace HephAudio
 
 					WINAUDIODS_CAPTURE_THREAD_EXCPT(pDirectSoundCaptureBuffer->GetCurrentPosition(&captureCursor, &readCursor), HEPH_FUNC, "An error occurred while capturing the samples.");
 					WINAUDIODS_CAPTURE_THREAD_EXCPT(pDirectSoundCaptureBuffer->Lock(readCursor, nBytesToRead, &audioPtr1, &audioBytes1, &audioPtr2, &audioBytes2, 0), HEPH_FUNC, "An error occurred while capturing the samples.");
-					EncodedAudioBuffer encodedBuffer((const uint8_t*)audioPtr1, nFramesToRead * this->captureFormat.FrameSize(), this->captureFormat);
+					this->DeliverCapturedData(audioPtr1, audioBytes1 / this->captureFormat.FrameSize());
 					if (audioPtr2 != nullptr)
 					{
-						memcpy(encodedBuffer.begin() + audioBytes1, audioPtr2, audioBytes2);
+						this->DeliverCapturedData(audioPtr2, audioBytes2 / this->captureFormat.FrameSize());
 					}
 					WINAUDIODS_CAPTURE_THREAD_EXCPT(pDirectSoundCaptureBuffer->Unlock(audioPtr1, audioBytes1, audioPtr2, audioBytes2), HEPH_FUNC, "An error occurred while capturing the samples.");
-
-					AudioBuffer buffer = this->pAudioDecoder->Decode(encodedBuffer);
-					AudioCaptureEventArgs captureEventArgs(this, buffer);
-					this->OnCapture(&captureEventArgs, nullptr);
 				}
 				else
 				{
@@ -177,6 +177,7 @@ namespace HephAudio
 			WINAUDIOMME_EXCPT(waveInOpen(&this->hwi, deviceID, (WAVEFORMATEX*)&wfx, (DWORD_PTR)&WinAudioMME::CaptureCallback, (DWORD_PTR)this, CALLBACK_FUNCTION), this, HEPH_FUNC, "An error occurred while starting capture.");
 
 			const size_t bufferSize_byte = WinAudioMME::CalculateBufferSize(this->captureFormat.ByteRate(), this->captureFormat.sampleRate);
+			this->PrepareCaptureBuffers(bufferSize_byte / this->captureFormat.FrameSize());
 
 			for (size_t i = 0; i < WinAudioMME::HDR_COUNT; i++)
 			{
@@ -447,8 +448,7 @@ namespace HephAudio
 				{
 					WAVEHDR* pwhd = (WAVEHDR*)dwParam1;
 
-					EncodedAudioBuffer mixedBuffer = pAudio->Mix(pwhd->dwBufferLength / pAudio->renderFormat.FrameSize());
-					memcpy(pwhd->lpData, mixedBuffer.begin(), pwhd->dwBufferLength);
+					pAudio->Mix(pwhd->dwBufferLength / pAudio->renderFormat.FrameSize(), pwhd->lpData);
 
 					pwhd->dwFlags = WHDR_PREPARED;
 					const MMRESULT mmres = waveOutWrite(hwo, pwhd, sizeof(WAVEHDR));
@@ -473,13 +473,9 @@ namespace HephAudio
 				{
 					WAVEHDR* pwhd = (WAVEHDR*)dwParam1;
 
-					if (!pAudio->isCapturePaused && pAudio->OnCapture)
+					if (!pAudio->isCapturePaused)
 					{
-						EncodedAudioBuffer encodedBuffer((const uint8_t*)pwhd->lpData, pwhd->dwBufferLength, pAudio->captureFormat);
-						AudioBuffer buffer = pAudio->pAudioDecoder->Decode(encodedBuffer);
-						
-						AudioCaptureEventArgs captureEventArgs(pAudio, buffer);
-						pAudio->OnCapture(&captureEventArgs, nullptr);
+						pAudio->DeliverCapturedData(pwhd->lpData, pwhd->dwBytesRecorded / pAudio->captureFormat.FrameSize());
 					}
 
 					pwhd->dwFlags = WHDR_PREPARED;
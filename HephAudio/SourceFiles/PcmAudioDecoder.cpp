@@ -0,0 +1,671 @@
+#include "PcmAudioDecoder.h"
+#include "SampleFormatConverter.h"
+#include "FFmpeg/FFmpegAudioDecoder.h"
+#include "FFmpeg/FFmpegEncodedAudioBuffer.h"
+#include "Exceptions/InvalidArgumentException.h"
+#include "Exceptions/InvalidOperationException.h"
+#include "Exceptions/NotSupportedException.h"
+#include "HephMath.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace Heph;
+
+namespace HephAudio
+{
+	// number of frames converted per pass when the samples need to be byte swapped or sign converted first.
+	static constexpr size_t CONVERSION_CHUNK_FRAME_COUNT = 4096;
+
+	static constexpr uint8_t W64_RIFF_GUID[16] = { 0x72, 0x69, 0x66, 0x66, 0x2E, 0x91, 0xCF, 0x11, 0xA5, 0xD6, 0x28, 0xDB, 0x04, 0xC1, 0x00, 0x00 };
+	static constexpr uint8_t W64_WAVE_GUID[16] = { 0x77, 0x61, 0x76, 0x65, 0xF3, 0xAC, 0xD3, 0x11, 0x8C, 0xD1, 0x00, 0xC0, 0x4F, 0x8E, 0xDB, 0x8A };
+	static constexpr uint8_t W64_FMT_GUID[16] = { 0x66, 0x6D, 0x74, 0x20, 0xF3, 0xAC, 0xD3, 0x11, 0x8C, 0xD1, 0x00, 0xC0, 0x4F, 0x8E, 0xDB, 0x8A };
+	static constexpr uint8_t W64_DATA_GUID[16] = { 0x64, 0x61, 0x74, 0x61, 0xF3, 0xAC, 0xD3, 0x11, 0x8C, 0xD1, 0x00, 0xC0, 0x4F, 0x8E, 0xDB, 0x8A };
+
+	static uint16_t ReadU16LE(const uint8_t* p)
+	{
+		return (uint16_t)(p[0] | (p[1] << 8));
+	}
+
+	static uint32_t ReadU32LE(const uint8_t* p)
+	{
+		return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+	}
+
+	static uint64_t ReadU64LE(const uint8_t* p)
+	{
+		return (uint64_t)ReadU32LE(p) | ((uint64_t)ReadU32LE(p + 4) << 32);
+	}
+
+	static uint16_t ReadU16BE(const uint8_t* p)
+	{
+		return (uint16_t)((p[0] << 8) | p[1]);
+	}
+
+	static uint32_t ReadU32BE(const uint8_t* p)
+	{
+		return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+	}
+
+	static double ReadExtendedBE(const uint8_t* p)
+	{
+		const int exponent = ((p[0] & 0x7F) << 8) | p[1];
+		const uint64_t mantissa = ((uint64_t)ReadU32BE(p + 2) << 32) | ReadU32BE(p + 6);
+		if (exponent == 0 && mantissa == 0)
+		{
+			return 0.0;
+		}
+		const double value = std::ldexp((double)mantissa, exponent - 16383 - 63);
+		return (p[0] & 0x80) ? -value : value;
+	}
+
+	static bool IsNativelyDecodable(const AudioFormatInfo& formatInfo)
+	{
+		// the byte order is fixed while converting.
+		AudioFormatInfo systemEndianFormatInfo = formatInfo;
+		systemEndianFormatInfo.endian = HEPH_SYSTEM_ENDIAN;
+		return SampleFormatConverter::IsSupported(systemEndianFormatInfo);
+	}
+
+	PcmAudioDecoder::PcmAudioDecoder() : PcmAudioDecoder(std::make_shared<FFmpegAudioDecoder>()) {}
+
+	PcmAudioDecoder::PcmAudioDecoder(std::shared_ptr<IAudioDecoder> pFallbackDecoder)
+		: pFallbackDecoder(pFallbackDecoder), isFallbackActive(false)
+		, rawFormatInfo(HEPHAUDIO_FORMAT_TAG_PCM, 16, HEPHAUDIO_CH_LAYOUT_STEREO, 48000, HEPH_SYSTEM_ENDIAN)
+		, isSigned8Bit(false), dataOffset(0), frameCount(0), currentFrame(0) {}
+
+	PcmAudioDecoder::PcmAudioDecoder(const std::filesystem::path& filePath) : PcmAudioDecoder()
+	{
+		this->OpenFile(filePath);
+	}
+
+	PcmAudioDecoder::~PcmAudioDecoder()
+	{
+		this->CloseFile();
+	}
+
+	void PcmAudioDecoder::ChangeFile(const std::filesystem::path& newFilePath)
+	{
+		if (this->filePath != newFilePath)
+		{
+			this->CloseFile();
+			this->OpenFile(newFilePath);
+		}
+	}
+
+	void PcmAudioDecoder::CloseFile()
+	{
+		if (this->isFallbackActive)
+		{
+			this->pFallbackDecoder->CloseFile();
+			this->isFallbackActive = false;
+		}
+
+		this->mappedFile.Close();
+		this->filePath = "";
+		this->fileFormatInfo = AudioFormatInfo();
+		this->isSigned8Bit = false;
+		this->dataOffset = 0;
+		this->frameCount = 0;
+		this->currentFrame = 0;
+	}
+
+	bool PcmAudioDecoder::IsFileOpen() const
+	{
+		if (this->isFallbackActive)
+		{
+			return this->pFallbackDecoder->IsFileOpen();
+		}
+		return this->filePath != "" && this->mappedFile.IsOpen();
+	}
+
+	AudioFormatInfo PcmAudioDecoder::GetOutputFormatInfo() const
+	{
+		if (this->isFallbackActive)
+		{
+			return this->pFallbackDecoder->GetOutputFormatInfo();
+		}
+		return HEPHAUDIO_INTERNAL_FORMAT(this->fileFormatInfo.channelLayout, this->fileFormatInfo.sampleRate);
+	}
+
+	size_t PcmAudioDecoder::GetFrameCount() const
+	{
+		if (this->isFallbackActive)
+		{
+			return this->pFallbackDecoder->GetFrameCount();
+		}
+		return this->frameCount;
+	}
+
+	bool PcmAudioDecoder::Seek(size_t frameIndex)
+	{
+		if (this->isFallbackActive)
+		{
+			return this->pFallbackDecoder->Seek(frameIndex);
+		}
+
+		if (frameIndex >= this->frameCount)
+		{
+			HEPH_RAISE_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "frameIndex out of bounds."));
+			return false;
+		}
+
+		this->currentFrame = frameIndex;
+		return true;
+	}
+
+	AudioBuffer PcmAudioDecoder::Decode()
+	{
+		if (this->isFallbackActive)
+		{
+			return this->pFallbackDecoder->Decode();
+		}
+		return this->Decode(0, this->frameCount);
+	}
+
+	AudioBuffer PcmAudioDecoder::Decode(size_t frameCount)
+	{
+		if (this->isFallbackActive)
+		{
+			return this->pFallbackDecoder->Decode(frameCount);
+		}
+
+		const AudioFormatInfo outputFormatInfo = this->GetOutputFormatInfo();
+		if (!this->IsFileOpen())
+		{
+			HEPH_RAISE_EXCEPTION(this, InvalidOperationException(HEPH_FUNC, "No open file to decode."));
+			return AudioBuffer(frameCount, outputFormatInfo.channelLayout, outputFormatInfo.sampleRate);
+		}
+
+		// frames past the end of the file are left silent.
+		const size_t readFrameCount = HEPH_MATH_MIN(frameCount, this->frameCount - this->currentFrame);
+		AudioBuffer decodedBuffer(frameCount, outputFormatInfo.channelLayout, outputFormatInfo.sampleRate,
+			readFrameCount == frameCount ? BufferFlags::AllocUninitialized : BufferFlags::None);
+		(void)this->DecodeInto(decodedBuffer.begin(), frameCount);
+
+		return decodedBuffer;
+	}
+
+	AudioBuffer PcmAudioDecoder::Decode(size_t frameIndex, size_t frameCount)
+	{
+		if (this->isFallbackActive)
+		{
+			return this->pFallbackDecoder->Decode(frameIndex, frameCount);
+		}
+
+		const AudioFormatInfo outputFormatInfo = this->GetOutputFormatInfo();
+		if (!this->IsFileOpen())
+		{
+			HEPH_RAISE_EXCEPTION(this, InvalidOperationException(HEPH_FUNC, "No open file to decode."));
+			return AudioBuffer(frameCount, outputFormatInfo.channelLayout, outputFormatInfo.sampleRate);
+		}
+
+		if (frameIndex >= this->frameCount)
+		{
+			HEPH_RAISE_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "frameIndex out of bounds."));
+			return AudioBuffer(frameCount, outputFormatInfo.channelLayout, outputFormatInfo.sampleRate);
+		}
+
+		if (frameIndex + frameCount > this->frameCount)
+		{
+			frameCount = this->frameCount - frameIndex;
+		}
+
+		AudioBuffer decodedBuffer(frameCount, outputFormatInfo.channelLayout, outputFormatInfo.sampleRate, BufferFlags::AllocUninitialized);
+		this->ConvertFrames(frameIndex, frameCount, decodedBuffer.begin());
+		this->currentFrame = frameIndex + frameCount;
+
+		return decodedBuffer;
+	}
+
+	AudioBuffer PcmAudioDecoder::Decode(const EncodedAudioBuffer& encodedBuffer)
+	{
+		const AudioFormatInfo& inputFormatInfo = encodedBuffer.GetAudioFormatInfo();
+		if (dynamic_cast<const FFmpegEncodedAudioBuffer*>(&encodedBuffer) == nullptr && SampleFormatConverter::IsSupported(inputFormatInfo))
+		{
+			const size_t frameCount = encodedBuffer.Size() / inputFormatInfo.FrameSize();
+			AudioBuffer resultBuffer(frameCount, inputFormatInfo.channelLayout, inputFormatInfo.sampleRate, BufferFlags::AllocUninitialized);
+			SampleFormatConverter::ToInternal(encodedBuffer.begin(), inputFormatInfo, frameCount, resultBuffer);
+			return resultBuffer;
+		}
+
+		if (this->pFallbackDecoder == nullptr)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, NotSupportedException(HEPH_FUNC, "Unsupported encoded buffer format."));
+		}
+		return this->pFallbackDecoder->Decode(encodedBuffer);
+	}
+
+	size_t PcmAudioDecoder::DecodeInto(heph_audio_sample_t* pOutput, size_t frameCount)
+	{
+		if (this->isFallbackActive)
+		{
+			return this->pFallbackDecoder->DecodeInto(pOutput, frameCount);
+		}
+
+		if (!this->IsFileOpen())
+		{
+			HEPH_RAISE_EXCEPTION(this, InvalidOperationException(HEPH_FUNC, "No open file to decode."));
+			return 0;
+		}
+
+		const size_t readFrameCount = HEPH_MATH_MIN(frameCount, this->frameCount - this->currentFrame);
+		this->ConvertFrames(this->currentFrame, readFrameCount, pOutput);
+		this->currentFrame += readFrameCount;
+
+		return readFrameCount;
+	}
+
+	std::shared_ptr<IAudioDecoder> PcmAudioDecoder::GetFallbackDecoder() const
+	{
+		return this->pFallbackDecoder;
+	}
+
+	void PcmAudioDecoder::SetFallbackDecoder(std::shared_ptr<IAudioDecoder> pFallbackDecoder)
+	{
+		if (this->isFallbackActive)
+		{
+			this->CloseFile();
+		}
+		this->pFallbackDecoder = pFallbackDecoder;
+	}
+
+	bool PcmAudioDecoder::IsFallbackActive() const
+	{
+		return this->isFallbackActive;
+	}
+
+	const AudioFormatInfo& PcmAudioDecoder::GetFileFormatInfo() const
+	{
+		return this->fileFormatInfo;
+	}
+
+	const AudioFormatInfo& PcmAudioDecoder::GetRawFormatInfo() const
+	{
+		return this->rawFormatInfo;
+	}
+
+	void PcmAudioDecoder::SetRawFormatInfo(const AudioFormatInfo& rawFormatInfo)
+	{
+		this->rawFormatInfo = rawFormatInfo;
+	}
+
+	const heph_audio_sample_t* PcmAudioDecoder::GetInternalFormatView() const
+	{
+		if (this->isFallbackActive || this->mappedFile.Data() == nullptr || this->frameCount == 0)
+		{
+			return nullptr;
+		}
+
+		const AudioFormatInfo internalFormatInfo = HEPHAUDIO_INTERNAL_FORMAT(this->fileFormatInfo.channelLayout, this->fileFormatInfo.sampleRate);
+		if (this->fileFormatInfo.formatTag != internalFormatInfo.formatTag ||
+			this->fileFormatInfo.bitsPerSample != internalFormatInfo.bitsPerSample ||
+			this->fileFormatInfo.endian != internalFormatInfo.endian)
+		{
+			return nullptr;
+		}
+
+		const uint8_t* pSamples = this->mappedFile.Data() + this->dataOffset;
+		if (((uintptr_t)pSamples % alignof(heph_audio_sample_t)) != 0)
+		{
+			return nullptr;
+		}
+
+		return (const heph_audio_sample_t*)pSamples;
+	}
+
+	void PcmAudioDecoder::OpenFile(const std::filesystem::path& filePath)
+	{
+		this->mappedFile.Open(filePath);
+
+		const uint8_t* pFile = this->mappedFile.Data();
+		const size_t fileSize = this->mappedFile.Size();
+		bool isParsed = false;
+
+		if (fileSize >= 12 && (memcmp(pFile, "RIFF", 4) == 0 || memcmp(pFile, "RF64", 4) == 0 || memcmp(pFile, "BW64", 4) == 0)
+			&& memcmp(pFile + 8, "WAVE", 4) == 0)
+		{
+			isParsed = this->ParseWav(pFile, fileSize);
+		}
+		else if (fileSize >= 40 && memcmp(pFile, W64_RIFF_GUID, 16) == 0 && memcmp(pFile + 24, W64_WAVE_GUID, 16) == 0)
+		{
+			isParsed = this->ParseW64(pFile, fileSize);
+		}
+		else if (fileSize >= 12 && memcmp(pFile, "FORM", 4) == 0 && (memcmp(pFile + 8, "AIFF", 4) == 0 || memcmp(pFile + 8, "AIFC", 4) == 0))
+		{
+			isParsed = this->ParseAiff(pFile, fileSize);
+		}
+		else
+		{
+			std::string extension = filePath.extension().string();
+			std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+			if (extension == ".raw" || extension == ".pcm")
+			{
+				isParsed = this->ParseRaw(fileSize);
+			}
+		}
+
+		if (isParsed)
+		{
+			this->filePath = filePath;
+			return;
+		}
+
+		this->mappedFile.Close();
+		this->fileFormatInfo = AudioFormatInfo();
+		this->isSigned8Bit = false;
+		this->dataOffset = 0;
+		this->frameCount = 0;
+
+		if (this->pFallbackDecoder == nullptr)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, NotSupportedException(HEPH_FUNC, "Unsupported file format."));
+		}
+
+		this->pFallbackDecoder->ChangeFile(filePath);
+		this->isFallbackActive = true;
+		this->filePath = filePath;
+	}
+
+	bool PcmAudioDecoder::ParseWav(const uint8_t* pFile, size_t fileSize)
+	{
+		const bool isRf64 = memcmp(pFile, "RIFF", 4) != 0;
+		uint64_t ds64DataSize = 0;
+		bool isFormatParsed = false;
+		uint64_t position = 12;
+
+		while (position + 8 <= fileSize)
+		{
+			const uint8_t* pChunk = pFile + position;
+			const uint64_t bodyOffset = position + 8;
+			const uint64_t remainingSize = fileSize - bodyOffset;
+			uint64_t chunkSize = ReadU32LE(pChunk + 4);
+
+			if (memcmp(pChunk, "ds64", 4) == 0 && chunkSize >= 24 && remainingSize >= 24)
+			{
+				ds64DataSize = ReadU64LE(pChunk + 16);
+			}
+			else if (memcmp(pChunk, "fmt ", 4) == 0)
+			{
+				if (!this->ParseWavFormat(pChunk + 8, (size_t)HEPH_MATH_MIN(chunkSize, remainingSize)))
+				{
+					return false;
+				}
+				isFormatParsed = true;
+			}
+			else if (memcmp(pChunk, "data", 4) == 0)
+			{
+				if (!isFormatParsed)
+				{
+					return false;
+				}
+
+				if (isRf64 && chunkSize == UINT32_MAX)
+				{
+					chunkSize = ds64DataSize;
+				}
+
+				// files that were not finalized may have a zero or an oversized data chunk, use whatever is on the disk.
+				if (chunkSize == 0 || chunkSize > remainingSize)
+				{
+					chunkSize = remainingSize;
+				}
+
+				this->dataOffset = (size_t)bodyOffset;
+				this->frameCount = (size_t)(chunkSize / this->fileFormatInfo.FrameSize());
+				return true;
+			}
+
+			position = bodyOffset + chunkSize + (chunkSize & 1);
+		}
+
+		return false;
+	}
+
+	bool PcmAudioDecoder::ParseW64(const uint8_t* pFile, size_t fileSize)
+	{
+		bool isFormatParsed = false;
+		uint64_t position = 40;
+
+		while (position + 24 <= fileSize)
+		{
+			const uint8_t* pChunk = pFile + position;
+			const uint64_t bodyOffset = position + 24;
+			const uint64_t remainingSize = fileSize - bodyOffset;
+			const uint64_t chunkSize = ReadU64LE(pChunk + 16);
+			if (chunkSize < 24)
+			{
+				return false;
+			}
+			const uint64_t bodySize = HEPH_MATH_MIN(chunkSize - 24, remainingSize);
+
+			if (memcmp(pChunk, W64_FMT_GUID, 16) == 0)
+			{
+				if (!this->ParseWavFormat(pChunk + 24, (size_t)bodySize))
+				{
+					return false;
+				}
+				isFormatParsed = true;
+			}
+			else if (memcmp(pChunk, W64_DATA_GUID, 16) == 0)
+			{
+				if (!isFormatParsed)
+				{
+					return false;
+				}
+
+				this->dataOffset = (size_t)bodyOffset;
+				this->frameCount = (size_t)(bodySize / this->fileFormatInfo.FrameSize());
+				return true;
+			}
+
+			// W64 chunks are aligned to 8 bytes.
+			position += (chunkSize + 7) & ~(uint64_t)7;
+		}
+
+		return false;
+	}
+
+	bool PcmAudioDecoder::ParseAiff(const uint8_t* pFile, size_t fileSize)
+	{
+		const bool isAifc = memcmp(pFile + 8, "AIFC", 4) == 0;
+		bool isFormatParsed = false;
+		uint32_t commFrameCount = 0;
+		uint64_t position = 12;
+
+		while (position + 8 <= fileSize)
+		{
+			const uint8_t* pChunk = pFile + position;
+			const uint64_t bodyOffset = position + 8;
+			const uint64_t remainingSize = fileSize - bodyOffset;
+			const uint64_t chunkSize = ReadU32BE(pChunk + 4);
+
+			if (memcmp(pChunk, "COMM", 4) == 0)
+			{
+				if (chunkSize < 18 || remainingSize < 18 || (isAifc && (chunkSize < 22 || remainingSize < 22)))
+				{
+					return false;
+				}
+
+				const uint8_t* pBody = pChunk + 8;
+				const uint16_t channelCount = ReadU16BE(pBody);
+				const uint16_t sampleSize = ReadU16BE(pBody + 6);
+				const uint32_t sampleRate = (uint32_t)std::lround(ReadExtendedBE(pBody + 8));
+				commFrameCount = ReadU32BE(pBody + 2);
+
+				uint16_t formatTag = HEPHAUDIO_FORMAT_TAG_PCM;
+				uint16_t bitsPerSample = (uint16_t)((sampleSize + 7) / 8 * 8);
+				Endian endian = Endian::Big;
+				if (isAifc)
+				{
+					const uint8_t* pCompressionType = pBody + 18;
+					if (memcmp(pCompressionType, "sowt", 4) == 0)
+					{
+						endian = Endian::Little;
+					}
+					else if (memcmp(pCompressionType, "fl32", 4) == 0 || memcmp(pCompressionType, "FL32", 4) == 0)
+					{
+						formatTag = HEPHAUDIO_FORMAT_TAG_IEEE_FLOAT;
+						bitsPerSample = 32;
+					}
+					else if (memcmp(pCompressionType, "fl64", 4) == 0 || memcmp(pCompressionType, "FL64", 4) == 0)
+					{
+						formatTag = HEPHAUDIO_FORMAT_TAG_IEEE_FLOAT;
+						bitsPerSample = 64;
+					}
+					else if (memcmp(pCompressionType, "alaw", 4) == 0 || memcmp(pCompressionType, "ALAW", 4) == 0)
+					{
+						formatTag = HEPHAUDIO_FORMAT_TAG_ALAW;
+						bitsPerSample = 8;
+					}
+					else if (memcmp(pCompressionType, "ulaw", 4) == 0 || memcmp(pCompressionType, "ULAW", 4) == 0)
+					{
+						formatTag = HEPHAUDIO_FORMAT_TAG_MULAW;
+						bitsPerSample = 8;
+					}
+					else if (memcmp(pCompressionType, "NONE", 4) != 0 && memcmp(pCompressionType, "twos", 4) != 0)
+					{
+						return false;
+					}
+				}
+
+				this->fileFormatInfo = AudioFormatInfo(formatTag, bitsPerSample, AudioChannelLayout::DefaultChannelLayout(channelCount), sampleRate, endian);
+				// AIFF stores 8 bit samples as signed, WAV as unsigned.
+				this->isSigned8Bit = formatTag == HEPHAUDIO_FORMAT_TAG_PCM && bitsPerSample == 8;
+				if (!IsNativelyDecodable(this->fileFormatInfo))
+				{
+					return false;
+				}
+				isFormatParsed = true;
+			}
+			else if (memcmp(pChunk, "SSND", 4) == 0)
+			{
+				if (!isFormatParsed || chunkSize < 8 || remainingSize < 8)
+				{
+					return false;
+				}
+
+				const uint64_t sampleOffset = 8 + (uint64_t)ReadU32BE(pChunk + 8);
+				const uint64_t dataSize = HEPH_MATH_MIN(chunkSize, remainingSize);
+				if (sampleOffset > dataSize)
+				{
+					return false;
+				}
+
+				this->dataOffset = (size_t)(bodyOffset + sampleOffset);
+				this->frameCount = HEPH_MATH_MIN((size_t)commFrameCount, (size_t)((dataSize - sampleOffset) / this->fileFormatInfo.FrameSize()));
+				return true;
+			}
+
+			position = bodyOffset + chunkSize + (chunkSize & 1);
+		}
+
+		return false;
+	}
+
+	bool PcmAudioDecoder::ParseRaw(size_t fileSize)
+	{
+		if (!IsNativelyDecodable(this->rawFormatInfo))
+		{
+			return false;
+		}
+
+		this->fileFormatInfo = this->rawFormatInfo;
+		this->dataOffset = 0;
+		this->frameCount = fileSize / this->fileFormatInfo.FrameSize();
+		return true;
+	}
+
+	bool PcmAudioDecoder::ParseWavFormat(const uint8_t* pFmt, size_t fmtSize)
+	{
+		if (fmtSize < 16)
+		{
+			return false;
+		}
+
+		uint16_t formatTag = ReadU16LE(pFmt);
+		const uint16_t channelCount = ReadU16LE(pFmt + 2);
+		const uint32_t sampleRate = ReadU32LE(pFmt + 4);
+		const uint16_t blockAlign = ReadU16LE(pFmt + 12);
+		AudioChannelLayout channelLayout = AudioChannelLayout::DefaultChannelLayout(channelCount);
+
+		if (channelCount == 0)
+		{
+			return false;
+		}
+
+		if (formatTag == HEPHAUDIO_FORMAT_TAG_EXTENSIBLE)
+		{
+			if (fmtSize < 40)
+			{
+				return false;
+			}
+
+			const uint32_t channelMask = ReadU32LE(pFmt + 20);
+			uint16_t maskChannelCount = 0;
+			for (uint32_t m = channelMask; m != 0; m &= m - 1)
+			{
+				maskChannelCount++;
+			}
+
+			if (channelMask != 0 && maskChannelCount == channelCount)
+			{
+				channelLayout = AudioChannelLayout(channelCount, (AudioChannelMask)channelMask);
+			}
+
+			// the first 2 bytes of the sub format GUID is the format tag.
+			formatTag = ReadU16LE(pFmt + 24);
+		}
+
+		// the container size is used, the valid bits are padded with zeros.
+		const uint16_t bitsPerSample = (uint16_t)(blockAlign * 8 / channelCount);
+
+		this->fileFormatInfo = AudioFormatInfo(formatTag, bitsPerSample, channelLayout, sampleRate, Endian::Little);
+		this->isSigned8Bit = false;
+		return IsNativelyDecodable(this->fileFormatInfo);
+	}
+
+	void PcmAudioDecoder::ConvertFrames(size_t frameIndex, size_t frameCount, heph_audio_sample_t* pOutput)
+	{
+		const size_t frameSize = this->fileFormatInfo.FrameSize();
+		const size_t channelCount = this->fileFormatInfo.channelLayout.count;
+		const size_t bytesPerSample = this->fileFormatInfo.bitsPerSample / 8;
+		const uint8_t* pInput = this->mappedFile.Data() + this->dataOffset + frameIndex * frameSize;
+		const bool swapEndian = bytesPerSample > 1 && this->fileFormatInfo.endian != HEPH_SYSTEM_ENDIAN;
+
+		if (!swapEndian && !this->isSigned8Bit)
+		{
+			SampleFormatConverter::ToInternal(pInput, pOutput, frameCount, this->fileFormatInfo);
+			return;
+		}
+
+		AudioFormatInfo systemEndianFormatInfo = this->fileFormatInfo;
+		systemEndianFormatInfo.endian = HEPH_SYSTEM_ENDIAN;
+		this->scratchBuffer.resize(CONVERSION_CHUNK_FRAME_COUNT * frameSize);
+
+		for (size_t i = 0; i < frameCount; i += CONVERSION_CHUNK_FRAME_COUNT)
+		{
+			const size_t chunkFrameCount = HEPH_MATH_MIN(CONVERSION_CHUNK_FRAME_COUNT, frameCount - i);
+			const size_t chunkSize = chunkFrameCount * frameSize;
+			uint8_t* pScratch = this->scratchBuffer.data();
+
+			(void)memcpy(pScratch, pInput + i * frameSize, chunkSize);
+			if (swapEndian)
+			{
+				for (size_t j = 0; j < chunkSize; j += bytesPerSample)
+				{
+					HEPH_CHANGE_ENDIAN(pScratch + j, (uint8_t)bytesPerSample);
+				}
+			}
+			else
+			{
+				for (size_t j = 0; j < chunkSize; j++)
+				{
+					pScratch[j] ^= 0x80;
+				}
+			}
+
+			SampleFormatConverter::ToInternal(pScratch, pOutput + i * channelCount, chunkFrameCount, systemEndianFormatInfo);
+		}
+	}
+}
\ No newline at end of file
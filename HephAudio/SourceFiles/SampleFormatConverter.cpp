@@ -0,0 +1,727 @@
+#include "SampleFormatConverter.h"
+#include "Exceptions/InvalidArgumentException.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define HEPH_SFC_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define HEPH_SFC_NEON
+#endif
+
+using namespace Heph;
+
+namespace HephAudio
+{
+	// full scale of the signed integer formats, samples are scaled by 2^(bits - 1) in both directions so the round trip is lossless.
+	static constexpr double S8_SCALE = 128.0;
+	static constexpr double S16_SCALE = 32768.0;
+	static constexpr double S24_SCALE = 8388608.0;
+	static constexpr double S32_SCALE = 2147483648.0;
+
+	static constexpr int16_t ALAW_SEGMENT_END[8] = { 0x1F, 0x3F, 0x7F, 0xFF, 0x1FF, 0x3FF, 0x7FF, 0xFFF };
+	static constexpr int16_t MULAW_SEGMENT_END[8] = { 0x3F, 0x7F, 0xFF, 0x1FF, 0x3FF, 0x7FF, 0xFFF, 0x1FFF };
+	static constexpr int16_t MULAW_BIAS = 0x84;
+	static constexpr int16_t MULAW_CLIP = 8159;
+
+	// number of samples converted at a time when neither format is the internal format.
+	static constexpr size_t CONVERT_BLOCK_SAMPLE_COUNT = 1024;
+
+	static inline int16_t FindSegment(int16_t value, const int16_t* pSegmentEnd)
+	{
+		int16_t i = 0;
+		while (i < 8 && value > pSegmentEnd[i])
+		{
+			i++;
+		}
+		return i;
+	}
+
+	static inline double NextTpdf(uint32_t& state)
+	{
+		// xorshift32, two uniform values in [0, 1) summed to a triangular distribution in (-1, 1).
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		const double r1 = state * (1.0 / 4294967296.0);
+
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		const double r2 = state * (1.0 / 4294967296.0);
+
+		return r1 + r2 - 1.0;
+	}
+
+	static inline int64_t Quantize(double sample, double scale, double minValue, double maxValue, DitherState* pDitherState, size_t channel)
+	{
+		double value = sample * scale;
+
+		if (pDitherState != nullptr)
+		{
+			double* pError = pDitherState->error.data() + channel;
+			if (pDitherState->mode == DitherMode::TpdfNoiseShaped)
+			{
+				value -= *pError;
+			}
+
+			const double target = value;
+			value = std::nearbyint(HEPH_MATH_MIN(HEPH_MATH_MAX(value + NextTpdf(pDitherState->randomState), minValue), maxValue));
+
+			if (pDitherState->mode == DitherMode::TpdfNoiseShaped)
+			{
+				// limit the feedback so clipping cannot make the loop unstable.
+				*pError = HEPH_MATH_MIN(HEPH_MATH_MAX(value - target, -1.0), 1.0);
+			}
+			return (int64_t)value;
+		}
+
+		return (int64_t)std::nearbyint(HEPH_MATH_MIN(HEPH_MATH_MAX(value, minValue), maxValue));
+	}
+
+	// the samples are either the internal samples or the double precision IEEE float samples used between two external formats.
+	template<typename T>
+	static inline double ToDouble(T sample)
+	{
+		if constexpr (std::is_same<T, heph_audio_sample_t>::value)
+		{
+			return (double)HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(sample);
+		}
+		else
+		{
+			return (double)sample;
+		}
+	}
+
+	template<typename T>
+	static inline T FromDouble(double sample)
+	{
+		if constexpr (std::is_same<T, heph_audio_sample_t>::value)
+		{
+			return (heph_audio_sample_t)HEPH_AUDIO_SAMPLE_FROM_IEEE_FLT(sample);
+		}
+		else
+		{
+			return (T)sample;
+		}
+	}
+
+	// vectorized kernels, process as many samples as possible and return the number of samples processed.
+	// the kernels are no-ops for the other internal sample types.
+	template<typename Tin, typename Tout>
+	static size_t FloatToS16(const Tin* pInput, Tout* pOutput, size_t sampleCount)
+	{
+		size_t i = 0;
+		if constexpr (std::is_same<Tin, float>::value && std::is_same<Tout, int16_t>::value)
+		{
+#if defined(HEPH_SFC_SSE2)
+			const __m128 scale = _mm_set1_ps((float)S16_SCALE);
+			const __m128 minValue = _mm_set1_ps(INT16_MIN);
+			const __m128 maxValue = _mm_set1_ps(INT16_MAX);
+			for (; i + 8 <= sampleCount; i += 8)
+			{
+				const __m128 a = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(pInput + i), scale), minValue), maxValue);
+				const __m128 b = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(pInput + i + 4), scale), minValue), maxValue);
+				_mm_storeu_si128((__m128i*)(pOutput + i), _mm_packs_epi32(_mm_cvtps_epi32(a), _mm_cvtps_epi32(b)));
+			}
+#elif defined(HEPH_SFC_NEON)
+			const float32x4_t minValue = vdupq_n_f32(INT16_MIN);
+			const float32x4_t maxValue = vdupq_n_f32(INT16_MAX);
+			for (; i + 8 <= sampleCount; i += 8)
+			{
+				const float32x4_t a = vminq_f32(vmaxq_f32(vmulq_n_f32(vld1q_f32(pInput + i), (float)S16_SCALE), minValue), maxValue);
+				const float32x4_t b = vminq_f32(vmaxq_f32(vmulq_n_f32(vld1q_f32(pInput + i + 4), (float)S16_SCALE), minValue), maxValue);
+				vst1q_s16(pOutput + i, vcombine_s16(vqmovn_s32(vcvtnq_s32_f32(a)), vqmovn_s32(vcvtnq_s32_f32(b))));
+			}
+#endif
+		}
+		return i;
+	}
+
+	template<typename Tin, typename Tout>
+	static size_t S16ToFloat(const Tin* pInput, Tout* pOutput, size_t sampleCount)
+	{
+		size_t i = 0;
+		if constexpr (std::is_same<Tin, int16_t>::value && std::is_same<Tout, float>::value)
+		{
+#if defined(HEPH_SFC_SSE2)
+			const __m128 scale = _mm_set1_ps((float)(1.0 / S16_SCALE));
+			for (; i + 8 <= sampleCount; i += 8)
+			{
+				const __m128i s16 = _mm_loadu_si128((const __m128i*)(pInput + i));
+				// interleave with itself and shift right to sign extend to 32 bits.
+				const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(s16, s16), 16);
+				const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(s16, s16), 16);
+				_mm_storeu_ps(pOutput + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+				_mm_storeu_ps(pOutput + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+			}
+#elif defined(HEPH_SFC_NEON)
+			for (; i + 8 <= sampleCount; i += 8)
+			{
+				const int16x8_t s16 = vld1q_s16(pInput + i);
+				vst1q_f32(pOutput + i, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(s16))), (float)(1.0 / S16_SCALE)));
+				vst1q_f32(pOutput + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(s16))), (float)(1.0 / S16_SCALE)));
+			}
+#endif
+		}
+		return i;
+	}
+
+	template<typename Tin, typename Tout>
+	static size_t FloatToS32(const Tin* pInput, Tout* pOutput, size_t sampleCount)
+	{
+		// computed in double precision since INT32_MAX is not representable as float.
+		size_t i = 0;
+		if constexpr (std::is_same<Tin, float>::value && std::is_same<Tout, int32_t>::value)
+		{
+#if defined(HEPH_SFC_SSE2)
+			const __m128d scale = _mm_set1_pd(S32_SCALE);
+			const __m128d minValue = _mm_set1_pd(INT32_MIN);
+			const __m128d maxValue = _mm_set1_pd(INT32_MAX);
+			for (; i + 4 <= sampleCount; i += 4)
+			{
+				const __m128 f = _mm_loadu_ps(pInput + i);
+				const __m128d lo = _mm_min_pd(_mm_max_pd(_mm_mul_pd(_mm_cvtps_pd(f), scale), minValue), maxValue);
+				const __m128d hi = _mm_min_pd(_mm_max_pd(_mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(f, f)), scale), minValue), maxValue);
+				_mm_storeu_si128((__m128i*)(pOutput + i), _mm_unpacklo_epi64(_mm_cvtpd_epi32(lo), _mm_cvtpd_epi32(hi)));
+			}
+#elif defined(HEPH_SFC_NEON)
+			const float64x2_t minValue = vdupq_n_f64(INT32_MIN);
+			const float64x2_t maxValue = vdupq_n_f64(INT32_MAX);
+			for (; i + 4 <= sampleCount; i += 4)
+			{
+				const float32x4_t f = vld1q_f32(pInput + i);
+				const float64x2_t lo = vminq_f64(vmaxq_f64(vmulq_n_f64(vcvt_f64_f32(vget_low_f32(f)), S32_SCALE), minValue), maxValue);
+				const float64x2_t hi = vminq_f64(vmaxq_f64(vmulq_n_f64(vcvt_high_f64_f32(f), S32_SCALE), minValue), maxValue);
+				vst1q_s32(pOutput + i, vcombine_s32(vmovn_s64(vcvtnq_s64_f64(lo)), vmovn_s64(vcvtnq_s64_f64(hi))));
+			}
+#endif
+		}
+		return i;
+	}
+
+	template<typename Tin, typename Tout>
+	static size_t S32ToFloat(const Tin* pInput, Tout* pOutput, size_t sampleCount)
+	{
+		size_t i = 0;
+		if constexpr (std::is_same<Tin, int32_t>::value && std::is_same<Tout, float>::value)
+		{
+#if defined(HEPH_SFC_SSE2)
+			const __m128 scale = _mm_set1_ps((float)(1.0 / S32_SCALE));
+			for (; i + 4 <= sampleCount; i += 4)
+			{
+				_mm_storeu_ps(pOutput + i, _mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)(pInput + i))), scale));
+			}
+#elif defined(HEPH_SFC_NEON)
+			for (; i + 4 <= sampleCount; i += 4)
+			{
+				vst1q_f32(pOutput + i, vmulq_n_f32(vcvtq_f32_s32(vld1q_s32(pInput + i)), (float)(1.0 / S32_SCALE)));
+			}
+#endif
+		}
+		return i;
+	}
+
+	template<typename Tin, typename Tout>
+	static size_t FloatToDouble(const Tin* pInput, Tout* pOutput, size_t sampleCount)
+	{
+		size_t i = 0;
+		if constexpr (std::is_same<Tin, float>::value && std::is_same<Tout, double>::value)
+		{
+#if defined(HEPH_SFC_SSE2)
+			for (; i + 4 <= sampleCount; i += 4)
+			{
+				const __m128 f = _mm_loadu_ps(pInput + i);
+				_mm_storeu_pd(pOutput + i, _mm_cvtps_pd(f));
+				_mm_storeu_pd(pOutput + i + 2, _mm_cvtps_pd(_mm_movehl_ps(f, f)));
+			}
+#elif defined(HEPH_SFC_NEON)
+			for (; i + 4 <= sampleCount; i += 4)
+			{
+				const float32x4_t f = vld1q_f32(pInput + i);
+				vst1q_f64(pOutput + i, vcvt_f64_f32(vget_low_f32(f)));
+				vst1q_f64(pOutput + i + 2, vcvt_high_f64_f32(f));
+			}
+#endif
+		}
+		return i;
+	}
+
+	template<typename Tin, typename Tout>
+	static size_t DoubleToFloat(const Tin* pInput, Tout* pOutput, size_t sampleCount)
+	{
+		size_t i = 0;
+		if constexpr (std::is_same<Tin, double>::value && std::is_same<Tout, float>::value)
+		{
+#if defined(HEPH_SFC_SSE2)
+			for (; i + 4 <= sampleCount; i += 4)
+			{
+				const __m128 lo = _mm_cvtpd_ps(_mm_loadu_pd(pInput + i));
+				const __m128 hi = _mm_cvtpd_ps(_mm_loadu_pd(pInput + i + 2));
+				_mm_storeu_ps(pOutput + i, _mm_movelh_ps(lo, hi));
+			}
+#elif defined(HEPH_SFC_NEON)
+			for (; i + 4 <= sampleCount; i += 4)
+			{
+				vst1q_f32(pOutput + i, vcvt_high_f32_f64(vcvt_f32_f64(vld1q_f64(pInput + i)), vld1q_f64(pInput + i + 2)));
+			}
+#endif
+		}
+		return i;
+	}
+
+	template<typename T>
+	static void FromSamples(const T* pInput, void* pOutput, size_t frameCount, const AudioFormatInfo& outputFormat, DitherState* pDitherState)
+	{
+		if (!SampleFormatConverter::IsSupported(outputFormat))
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(nullptr, InvalidArgumentException(HEPH_FUNC, "Unsupported output format."));
+		}
+
+		const size_t channelCount = outputFormat.channelLayout.count;
+		const size_t sampleCount = frameCount * channelCount;
+
+		if (pDitherState != nullptr)
+		{
+			if (pDitherState->mode == DitherMode::Disabled || outputFormat.formatTag != HEPHAUDIO_FORMAT_TAG_PCM)
+			{
+				pDitherState = nullptr;
+			}
+			else if (pDitherState->error.size() != channelCount)
+			{
+				pDitherState->error.assign(channelCount, 0.0);
+			}
+		}
+
+		size_t i = 0;
+		if (outputFormat.formatTag == HEPHAUDIO_FORMAT_TAG_IEEE_FLOAT)
+		{
+			if (outputFormat.bitsPerSample == 32)
+			{
+				float* pFloat = (float*)pOutput;
+				if constexpr (std::is_same<T, float>::value)
+				{
+					(void)memcpy(pFloat, pInput, sampleCount * sizeof(float));
+					return;
+				}
+
+				i = DoubleToFloat(pInput, pFloat, sampleCount);
+
+				for (; i < sampleCount; ++i)
+				{
+					pFloat[i] = (float)ToDouble(pInput[i]);
+				}
+			}
+			else
+			{
+				double* pDouble = (double*)pOutput;
+				if constexpr (std::is_same<T, double>::value)
+				{
+					(void)memcpy(pDouble, pInput, sampleCount * sizeof(double));
+					return;
+				}
+
+				i = FloatToDouble(pInput, pDouble, sampleCount);
+
+				for (; i < sampleCount; ++i)
+				{
+					pDouble[i] = ToDouble(pInput[i]);
+				}
+			}
+			return;
+		}
+
+		switch (outputFormat.formatTag == HEPHAUDIO_FORMAT_TAG_PCM ? outputFormat.bitsPerSample : 0)
+		{
+		case 8:
+		{
+			uint8_t* pU8 = (uint8_t*)pOutput;
+			for (; i < sampleCount; ++i)
+			{
+				pU8[i] = (uint8_t)(Quantize(ToDouble(pInput[i]), S8_SCALE, INT8_MIN, INT8_MAX, pDitherState, i % channelCount) + 128);
+			}
+			break;
+		}
+		case 16:
+		{
+			int16_t* pS16 = (int16_t*)pOutput;
+			if (pDitherState == nullptr)
+			{
+				i = FloatToS16(pInput, pS16, sampleCount);
+			}
+
+			for (; i < sampleCount; ++i)
+			{
+				pS16[i] = (int16_t)Quantize(ToDouble(pInput[i]), S16_SCALE, INT16_MIN, INT16_MAX, pDitherState, i % channelCount);
+			}
+			break;
+		}
+		case 24:
+		{
+			uint8_t* pS24 = (uint8_t*)pOutput;
+			for (; i < sampleCount; ++i, pS24 += 3)
+			{
+				const int32_t s24 = (int32_t)Quantize(ToDouble(pInput[i]), S24_SCALE, INT24_MIN, INT24_MAX, pDitherState, i % channelCount);
+				if (HEPH_SYSTEM_ENDIAN == Endian::Little)
+				{
+					pS24[0] = (uint8_t)s24;
+					pS24[1] = (uint8_t)(s24 >> 8);
+					pS24[2] = (uint8_t)(s24 >> 16);
+				}
+				else
+				{
+					pS24[0] = (uint8_t)(s24 >> 16);
+					pS24[1] = (uint8_t)(s24 >> 8);
+					pS24[2] = (uint8_t)s24;
+				}
+			}
+			break;
+		}
+		case 32:
+		{
+			int32_t* pS32 = (int32_t*)pOutput;
+			if (pDitherState == nullptr)
+			{
+				i = FloatToS32(pInput, pS32, sampleCount);
+			}
+
+			for (; i < sampleCount; ++i)
+			{
+				pS32[i] = (int32_t)Quantize(ToDouble(pInput[i]), S32_SCALE, INT32_MIN, INT32_MAX, pDitherState, i % channelCount);
+			}
+			break;
+		}
+		default:
+		{
+			uint8_t* pCompanded = (uint8_t*)pOutput;
+			const bool isALaw = outputFormat.formatTag == HEPHAUDIO_FORMAT_TAG_ALAW;
+			for (; i < sampleCount; ++i)
+			{
+				const int16_t s16 = (int16_t)Quantize(ToDouble(pInput[i]), S16_SCALE, INT16_MIN, INT16_MAX, nullptr, 0);
+				pCompanded[i] = isALaw ? SampleFormatConverter::LinearToALaw(s16) : SampleFormatConverter::LinearToMuLaw(s16);
+			}
+			break;
+		}
+		}
+	}
+
+	template<typename T>
+	static void ToSamples(const void* pInput, T* pOutput, size_t frameCount, const AudioFormatInfo& inputFormat)
+	{
+		if (!SampleFormatConverter::IsSupported(inputFormat))
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(nullptr, InvalidArgumentException(HEPH_FUNC, "Unsupported input format."));
+		}
+
+		const size_t sampleCount = frameCount * inputFormat.channelLayout.count;
+		size_t i = 0;
+
+		if (inputFormat.formatTag == HEPHAUDIO_FORMAT_TAG_IEEE_FLOAT)
+		{
+			if (inputFormat.bitsPerSample == 32)
+			{
+				const float* pFloat = (const float*)pInput;
+				if constexpr (std::is_same<T, float>::value)
+				{
+					(void)memcpy(pOutput, pFloat, sampleCount * sizeof(float));
+					return;
+				}
+
+				i = FloatToDouble(pFloat, pOutput, sampleCount);
+
+				for (; i < sampleCount; ++i)
+				{
+					pOutput[i] = FromDouble<T>(pFloat[i]);
+				}
+			}
+			else
+			{
+				const double* pDouble = (const double*)pInput;
+				if constexpr (std::is_same<T, double>::value)
+				{
+					(void)memcpy(pOutput, pDouble, sampleCount * sizeof(double));
+					return;
+				}
+
+				i = DoubleToFloat(pDouble, pOutput, sampleCount);
+
+				for (; i < sampleCount; ++i)
+				{
+					pOutput[i] = FromDouble<T>(pDouble[i]);
+				}
+			}
+			return;
+		}
+
+		switch (inputFormat.formatTag == HEPHAUDIO_FORMAT_TAG_PCM ? inputFormat.bitsPerSample : 0)
+		{
+		case 8:
+		{
+			const uint8_t* pU8 = (const uint8_t*)pInput;
+			for (; i < sampleCount; ++i)
+			{
+				pOutput[i] = FromDouble<T>(((int32_t)pU8[i] - 128) / S8_SCALE);
+			}
+			break;
+		}
+		case 16:
+		{
+			const int16_t* pS16 = (const int16_t*)pInput;
+			i = S16ToFloat(pS16, pOutput, sampleCount);
+
+			for (; i < sampleCount; ++i)
+			{
+				pOutput[i] = FromDouble<T>(pS16[i] / S16_SCALE);
+			}
+			break;
+		}
+		case 24:
+		{
+			const uint8_t* pS24 = (const uint8_t*)pInput;
+			for (; i < sampleCount; ++i, pS24 += 3)
+			{
+				const uint32_t u24 = HEPH_SYSTEM_ENDIAN == Endian::Little
+					? (((uint32_t)pS24[0] << 8) | ((uint32_t)pS24[1] << 16) | ((uint32_t)pS24[2] << 24))
+					: (((uint32_t)pS24[2] << 8) | ((uint32_t)pS24[1] << 16) | ((uint32_t)pS24[0] << 24));
+				// the sample is in the upper 3 bytes, arithmetic shift to sign extend.
+				pOutput[i] = FromDouble<T>(((int32_t)u24 >> 8) / S24_SCALE);
+			}
+			break;
+		}
+		case 32:
+		{
+			const int32_t* pS32 = (const int32_t*)pInput;
+			i = S32ToFloat(pS32, pOutput, sampleCount);
+
+			for (; i < sampleCount; ++i)
+			{
+				pOutput[i] = FromDouble<T>(pS32[i] / S32_SCALE);
+			}
+			break;
+		}
+		default:
+		{
+			const uint8_t* pCompanded = (const uint8_t*)pInput;
+			const bool isALaw = inputFormat.formatTag == HEPHAUDIO_FORMAT_TAG_ALAW;
+			for (; i < sampleCount; ++i)
+			{
+				const int16_t s16 = isALaw ? SampleFormatConverter::ALawToLinear(pCompanded[i]) : SampleFormatConverter::MuLawToLinear(pCompanded[i]);
+				pOutput[i] = FromDouble<T>(s16 / S16_SCALE);
+			}
+			break;
+		}
+		}
+	}
+
+	DitherState::DitherState() : DitherState(DitherMode::Disabled, 0) {}
+
+	DitherState::DitherState(DitherMode mode, uint16_t channelCount)
+		: mode(mode), randomState(0x9E3779B9), error(channelCount, 0.0) {}
+
+	void DitherState::Reset()
+	{
+		std::fill(this->error.begin(), this->error.end(), 0.0);
+	}
+
+	bool SampleFormatConverter::IsSupported(const AudioFormatInfo& format)
+	{
+		if (format.channelLayout.count == 0)
+		{
+			return false;
+		}
+
+		switch (format.formatTag)
+		{
+		case HEPHAUDIO_FORMAT_TAG_PCM:
+			return format.bitsPerSample == 8 ||
+				((format.bitsPerSample == 16 || format.bitsPerSample == 24 || format.bitsPerSample == 32) && format.endian == HEPH_SYSTEM_ENDIAN);
+		case HEPHAUDIO_FORMAT_TAG_IEEE_FLOAT:
+			return (format.bitsPerSample == 32 || format.bitsPerSample == 64) && format.endian == HEPH_SYSTEM_ENDIAN;
+		case HEPHAUDIO_FORMAT_TAG_ALAW:
+		case HEPHAUDIO_FORMAT_TAG_MULAW:
+			return format.bitsPerSample == 8;
+		default:
+			return false;
+		}
+	}
+
+	void SampleFormatConverter::FromInternal(const heph_audio_sample_t* pInput, void* pOutput, size_t frameCount, const AudioFormatInfo& outputFormat, DitherState* pDitherState)
+	{
+		FromSamples(pInput, pOutput, frameCount, outputFormat, pDitherState);
+	}
+
+	void SampleFormatConverter::FromInternal(const AudioBuffer& inputBuffer, void* pOutput, const AudioFormatInfo& outputFormat, DitherState* pDitherState)
+	{
+		if (inputBuffer.FormatInfo().channelLayout.count != outputFormat.channelLayout.count)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(nullptr, InvalidArgumentException(HEPH_FUNC, "Channel counts must be the same."));
+		}
+		SampleFormatConverter::FromInternal(inputBuffer.begin(), pOutput, inputBuffer.FrameCount(), outputFormat, pDitherState);
+	}
+
+	void SampleFormatConverter::ToInternal(const void* pInput, heph_audio_sample_t* pOutput, size_t frameCount, const AudioFormatInfo& inputFormat)
+	{
+		ToSamples(pInput, pOutput, frameCount, inputFormat);
+	}
+
+	void SampleFormatConverter::ToInternal(const void* pInput, const AudioFormatInfo& inputFormat, size_t frameCount, AudioBuffer& outputBuffer)
+	{
+		if (inputFormat.channelLayout.count != outputBuffer.FormatInfo().channelLayout.count)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(nullptr, InvalidArgumentException(HEPH_FUNC, "Channel counts must be the same."));
+		}
+
+		if (frameCount > outputBuffer.FrameCount())
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(nullptr, InvalidArgumentException(HEPH_FUNC, "frameCount exceeds the size of the output buffer."));
+		}
+
+		SampleFormatConverter::ToInternal(pInput, outputBuffer.begin(), frameCount, inputFormat);
+	}
+
+	void SampleFormatConverter::Convert(const void* pInput, const AudioFormatInfo& inputFormat, void* pOutput, const AudioFormatInfo& outputFormat, size_t frameCount, DitherState* pDitherState)
+	{
+		const size_t channelCount = inputFormat.channelLayout.count;
+		if (channelCount == 0 || channelCount != outputFormat.channelLayout.count)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(nullptr, InvalidArgumentException(HEPH_FUNC, "Channel counts must be the same."));
+		}
+
+		const AudioFormatInfo internalFormat = HEPHAUDIO_INTERNAL_FORMAT(inputFormat.channelLayout, inputFormat.sampleRate);
+		const bool isInputInternal = inputFormat.formatTag == internalFormat.formatTag && inputFormat.bitsPerSample == internalFormat.bitsPerSample && inputFormat.endian == internalFormat.endian;
+		const bool isOutputInternal = outputFormat.formatTag == internalFormat.formatTag && outputFormat.bitsPerSample == internalFormat.bitsPerSample && outputFormat.endian == internalFormat.endian;
+
+		if (isInputInternal && isOutputInternal)
+		{
+			(void)memcpy(pOutput, pInput, frameCount * channelCount * sizeof(heph_audio_sample_t));
+			return;
+		}
+		if (isInputInternal)
+		{
+			SampleFormatConverter::FromInternal((const heph_audio_sample_t*)pInput, pOutput, frameCount, outputFormat, pDitherState);
+			return;
+		}
+		if (isOutputInternal)
+		{
+			SampleFormatConverter::ToInternal(pInput, (heph_audio_sample_t*)pOutput, frameCount, inputFormat);
+			return;
+		}
+
+		if (!SampleFormatConverter::IsSupported(inputFormat))
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(nullptr, InvalidArgumentException(HEPH_FUNC, "Unsupported input format."));
+		}
+		if (!SampleFormatConverter::IsSupported(outputFormat))
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(nullptr, InvalidArgumentException(HEPH_FUNC, "Unsupported output format."));
+		}
+
+		if (channelCount > CONVERT_BLOCK_SAMPLE_COUNT)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(nullptr, InvalidArgumentException(HEPH_FUNC, "Too many channels."));
+		}
+
+		// converted via double instead of the internal format so the samples that float cannot represent are preserved.
+		double block[CONVERT_BLOCK_SAMPLE_COUNT];
+		const size_t blockFrameCount = CONVERT_BLOCK_SAMPLE_COUNT / channelCount;
+		const size_t inputFrameSize = inputFormat.FrameSize();
+		const size_t outputFrameSize = outputFormat.FrameSize();
+
+		for (size_t i = 0; i < frameCount; i += blockFrameCount)
+		{
+			const size_t currentFrameCount = HEPH_MATH_MIN(blockFrameCount, frameCount - i);
+			ToSamples(((const uint8_t*)pInput) + i * inputFrameSize, block, currentFrameCount, inputFormat);
+			FromSamples(block, ((uint8_t*)pOutput) + i * outputFrameSize, currentFrameCount, outputFormat, pDitherState);
+		}
+	}
+
+	uint8_t SampleFormatConverter::LinearToALaw(int16_t sample)
+	{
+		int16_t value = sample >> 3;
+		uint8_t mask;
+
+		if (value >= 0)
+		{
+			mask = 0xD5;
+		}
+		else
+		{
+			mask = 0x55;
+			value = -value - 1;
+		}
+
+		const int16_t segment = FindSegment(value, ALAW_SEGMENT_END);
+		if (segment >= 8)
+		{
+			return 0x7F ^ mask;
+		}
+
+		uint8_t result = (uint8_t)(segment << 4);
+		result |= segment < 2 ? ((value >> 1) & 0x0F) : ((value >> segment) & 0x0F);
+		return result ^ mask;
+	}
+
+	int16_t SampleFormatConverter::ALawToLinear(uint8_t sample)
+	{
+		sample ^= 0x55;
+
+		int16_t result = (sample & 0x0F) << 4;
+		const int16_t segment = (sample & 0x70) >> 4;
+		switch (segment)
+		{
+		case 0:
+			result += 8;
+			break;
+		case 1:
+			result += 0x108;
+			break;
+		default:
+			result += 0x108;
+			result <<= segment - 1;
+			break;
+		}
+
+		return (sample & 0x80) ? result : -result;
+	}
+
+	uint8_t SampleFormatConverter::LinearToMuLaw(int16_t sample)
+	{
+		int16_t value = sample >> 2;
+		uint8_t mask;
+
+		if (value < 0)
+		{
+			value = -value;
+			mask = 0x7F;
+		}
+		else
+		{
+			mask = 0xFF;
+		}
+
+		value = HEPH_MATH_MIN(value, MULAW_CLIP) + (MULAW_BIAS >> 2);
+
+		const int16_t segment = FindSegment(value, MULAW_SEGMENT_END);
+		if (segment >= 8)
+		{
+			return 0x7F ^ mask;
+		}
+
+		const uint8_t result = (uint8_t)((segment << 4) | ((value >> (segment + 1)) & 0x0F));
+		return result ^ mask;
+	}
+
+	int16_t SampleFormatConverter::MuLawToLinear(uint8_t sample)
+	{
+		sample = ~sample;
+
+		int16_t result = ((sample & 0x0F) << 3) + MULAW_BIAS;
+		result <<= (sample & 0x70) >> 4;
+
+		return (sample & 0x80) ? (MULAW_BIAS - result) : (result - MULAW_BIAS);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,146 @@
+#include "SpectralFilterbank.h"
+#include "Exceptions/InvalidArgumentException.h"
+#include <cmath>
+
+using namespace Heph;
+
+namespace HephAudio
+{
+	SpectralFilterbank::SpectralFilterbank() : binCount(0), weightOffsets(1, 0) {}
+
+	SpectralFilterbank::SpectralFilterbank(FrequencyScale scale, size_t filterCount, size_t fftSize, uint32_t sampleRate, double minFrequency, double maxFrequency)
+		: binCount(fftSize / 2 + 1)
+	{
+		if (filterCount == 0)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "filterCount must be greater than zero."));
+		}
+		if (fftSize < 2)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "fftSize must be at least 2."));
+		}
+		if (sampleRate == 0)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "sampleRate must be greater than zero."));
+		}
+		if (minFrequency < 0 || minFrequency >= maxFrequency || maxFrequency > sampleRate * 0.5)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "frequencies must satisfy 0 <= minFrequency < maxFrequency <= sampleRate / 2."));
+		}
+
+		// edges of the filters, the filter i rises from edges[i] to edges[i + 1] and falls to edges[i + 2].
+		const double minValue = SpectralFilterbank::ToScale(scale, minFrequency);
+		const double maxValue = SpectralFilterbank::ToScale(scale, maxFrequency);
+		std::vector<double> edges(filterCount + 2);
+		for (size_t i = 0; i < edges.size(); ++i)
+		{
+			edges[i] = SpectralFilterbank::FromScale(scale, minValue + (maxValue - minValue) * i / (filterCount + 1));
+		}
+
+		const double binWidth = ((double)sampleRate) / fftSize;
+		this->startBins.resize(filterCount, 0);
+		this->weightOffsets.reserve(filterCount + 1);
+
+		for (size_t i = 0; i < filterCount; ++i)
+		{
+			const double left = edges[i];
+			const double center = edges[i + 1];
+			const double right = edges[i + 2];
+
+			this->weightOffsets.push_back(this->weights.size());
+			for (size_t k = (size_t)ceil(left / binWidth); k < this->binCount; ++k)
+			{
+				const double frequency = k * binWidth;
+				if (frequency >= right)
+				{
+					break;
+				}
+				if (frequency <= left)
+				{
+					continue;
+				}
+
+				if (this->weights.size() == this->weightOffsets.back())
+				{
+					this->startBins[i] = k;
+				}
+				this->weights.push_back((frequency <= center) ? ((frequency - left) / (center - left)) : ((right - frequency) / (right - center)));
+			}
+		}
+		this->weightOffsets.push_back(this->weights.size());
+	}
+
+	size_t SpectralFilterbank::GetFilterCount() const
+	{
+		return this->startBins.size();
+	}
+
+	size_t SpectralFilterbank::GetBinCount() const
+	{
+		return this->binCount;
+	}
+
+	double SpectralFilterbank::GetWeight(size_t filterIndex, size_t binIndex) const
+	{
+		if (filterIndex >= this->startBins.size())
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "filterIndex out of bounds."));
+		}
+
+		const size_t weightCount = this->weightOffsets[filterIndex + 1] - this->weightOffsets[filterIndex];
+		if (binIndex < this->startBins[filterIndex] || binIndex >= this->startBins[filterIndex] + weightCount)
+		{
+			return 0.0;
+		}
+		return this->weights[this->weightOffsets[filterIndex] + binIndex - this->startBins[filterIndex]];
+	}
+
+	void SpectralFilterbank::Apply(const double* pSpectrum, double* pOutput) const
+	{
+		for (size_t i = 0; i < this->startBins.size(); ++i)
+		{
+			const double* const pWeights = this->weights.data() + this->weightOffsets[i];
+			const double* const pBins = pSpectrum + this->startBins[i];
+			const size_t weightCount = this->weightOffsets[i + 1] - this->weightOffsets[i];
+
+			double sum = 0.0;
+			for (size_t k = 0; k < weightCount; ++k)
+			{
+				sum += pBins[k] * pWeights[k];
+			}
+			pOutput[i] = sum;
+		}
+	}
+
+	void SpectralFilterbank::Apply(const double* pSpectra, size_t frameCount, double* pOutput) const
+	{
+		for (size_t i = 0; i < frameCount; ++i)
+		{
+			this->Apply(pSpectra + i * this->binCount, pOutput + i * this->startBins.size());
+		}
+	}
+
+	double SpectralFilterbank::ToScale(FrequencyScale scale, double frequency)
+	{
+		switch (scale)
+		{
+		case FrequencyScale::Bark:
+			return 26.81 * frequency / (1960.0 + frequency) - 0.53;
+		case FrequencyScale::Mel:
+		default:
+			return 2595.0 * log10(1.0 + frequency / 700.0);
+		}
+	}
+
+	double SpectralFilterbank::FromScale(FrequencyScale scale, double value)
+	{
+		switch (scale)
+		{
+		case FrequencyScale::Bark:
+			return 1960.0 * (value + 0.53) / (26.28 - value);
+		case FrequencyScale::Mel:
+		default:
+			return 700.0 * (pow(10.0, value / 2595.0) - 1.0);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,368 @@
+#include "StftAnalyzer.h"
+#include "Fourier.h"
+#include "HephMath.h"
+#include "Exceptions/InvalidArgumentException.h"
+#include <thread>
+#include <type_traits>
+
+using namespace Heph;
+
+namespace HephAudio
+{
+	StftAnalyzer::StftAnalyzer(const Window& wnd, size_t hopSize) : StftAnalyzer(wnd, hopSize, wnd.GetSize()) {}
+
+	StftAnalyzer::StftAnalyzer(const Window& wnd, size_t hopSize, size_t fftSize)
+		: wnd(wnd.GenerateBuffer()), hopSize(hopSize), fftSize(Fourier::CalculateFFTSize(fftSize)), threadCount(1), skipCount(0)
+	{
+		if (this->wnd.IsEmpty())
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "window size must be greater than zero."));
+		}
+		if (this->hopSize == 0)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "hopSize must be greater than zero."));
+		}
+		if (this->fftSize < this->wnd.Size())
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "fftSize must not be less than the window size."));
+		}
+	}
+
+	size_t StftAnalyzer::GetWindowSize() const
+	{
+		return this->wnd.Size();
+	}
+
+	size_t StftAnalyzer::GetHopSize() const
+	{
+		return this->hopSize;
+	}
+
+	size_t StftAnalyzer::GetFFTSize() const
+	{
+		return this->fftSize;
+	}
+
+	size_t StftAnalyzer::GetBinCount() const
+	{
+		return this->fftSize / 2 + 1;
+	}
+
+	size_t StftAnalyzer::GetThreadCount() const
+	{
+		return this->threadCount;
+	}
+
+	void StftAnalyzer::SetThreadCount(size_t threadCount)
+	{
+		this->threadCount = (threadCount == 0) ? (std::thread::hardware_concurrency()) : (threadCount);
+		if (this->threadCount == 0)
+		{
+			this->threadCount = 1;
+		}
+	}
+
+	size_t StftAnalyzer::CalculateFrameCount(size_t sampleCount) const
+	{
+		if (sampleCount == 0)
+		{
+			return 0;
+		}
+		if (sampleCount <= this->wnd.Size())
+		{
+			return 1;
+		}
+		return 1 + (sampleCount - this->wnd.Size() + this->hopSize - 1) / this->hopSize;
+	}
+
+	size_t StftAnalyzer::CalculateSampleCount(size_t frameCount) const
+	{
+		return (frameCount == 0) ? (0) : ((frameCount - 1) * this->hopSize + this->wnd.Size());
+	}
+
+	void StftAnalyzer::Analyze(const AudioBuffer& buffer, size_t channelIndex, StftOutputType outputType, double* pOutput) const
+	{
+		if (pOutput == nullptr)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "pOutput must not be nullptr."));
+		}
+		this->AnalyzeMT(buffer, channelIndex, outputType, pOutput, nullptr);
+	}
+
+	void StftAnalyzer::Analyze(const AudioBuffer& buffer, size_t channelIndex, SplitComplexBuffer& output) const
+	{
+		const size_t outputSize = this->CalculateFrameCount(buffer.FrameCount()) * this->GetBinCount();
+		if (output.Size() < outputSize)
+		{
+			output.Resize(outputSize);
+		}
+		this->AnalyzeMT(buffer, channelIndex, StftOutputType::Magnitude, output.Real(), output.Imag());
+	}
+
+	void StftAnalyzer::Synthesize(const SplitComplexBuffer& frames, size_t frameCount, AudioBuffer& buffer, size_t channelIndex) const
+	{
+		const size_t channelCount = buffer.FormatInfo().channelLayout.count;
+		const size_t binCount = this->GetBinCount();
+		const size_t wndSize = this->wnd.Size();
+		const size_t nyquistBin = this->fftSize / 2;
+
+		if (channelIndex >= channelCount)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "channelIndex out of bounds."));
+		}
+		if (frames.Size() < frameCount * binCount)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "frames must have at least frameCount * GetBinCount() elements."));
+		}
+
+		const size_t sampleCount = this->CalculateSampleCount(frameCount);
+		std::vector<double> samples(sampleCount, 0.0);
+		std::vector<double> weights(sampleCount, 0.0);
+
+		SplitComplexBuffer channel(this->fftSize);
+		double* const pReal = channel.Real();
+		double* const pImag = channel.Imag();
+
+		// the frames are real, hence two of them are transformed at once as the real and imaginary parts.
+		for (size_t i = 0; i < frameCount; i += 2)
+		{
+			const double* const pReal1 = frames.Real() + i * binCount;
+			const double* const pImag1 = frames.Imag() + i * binCount;
+			const bool hasSecondFrame = (i + 1) < frameCount;
+
+			for (size_t k = 0; k < binCount; ++k)
+			{
+				const double re1 = pReal1[k];
+				const double im1 = (k == 0 || k == nyquistBin) ? (0.0) : (pImag1[k]);
+				double re2 = 0.0, im2 = 0.0;
+				if (hasSecondFrame)
+				{
+					re2 = pReal1[binCount + k];
+					im2 = (k == 0 || k == nyquistBin) ? (0.0) : (pImag1[binCount + k]);
+				}
+
+				pReal[k] = re1 - im2;
+				pImag[k] = im1 + re2;
+				if (k != 0 && k != nyquistBin)
+				{
+					pReal[this->fftSize - k] = re1 + im2;
+					pImag[this->fftSize - k] = re2 - im1;
+				}
+			}
+
+			Fourier::IFFT(channel, true);
+
+			for (size_t j = 0; j < (hasSecondFrame ? 2 : 1); ++j)
+			{
+				const double* const pFrame = (j == 0) ? (pReal) : (pImag);
+				const size_t frameStart = (i + j) * this->hopSize;
+				for (size_t k = 0; k < wndSize; ++k)
+				{
+					samples[frameStart + k] += pFrame[k] * this->wnd[k];
+					weights[frameStart + k] += this->wnd[k] * this->wnd[k];
+				}
+			}
+		}
+
+		heph_audio_sample_t* const pSamples = buffer.begin() + channelIndex;
+		for (size_t i = 0; i < buffer.FrameCount(); ++i)
+		{
+			const double sample = (i < sampleCount && weights[i] > 1e-10) ? (samples[i] / weights[i]) : (0.0);
+			pSamples[i * channelCount] = HEPH_AUDIO_SAMPLE_FROM_IEEE_FLT(sample);
+		}
+	}
+
+	void StftAnalyzer::Push(const AudioBuffer& buffer, size_t channelIndex)
+	{
+		const size_t channelCount = buffer.FormatInfo().channelLayout.count;
+		if (buffer.FrameCount() > 0 && channelIndex >= channelCount)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "channelIndex out of bounds."));
+		}
+
+		const heph_audio_sample_t* const pSamples = buffer.begin() + channelIndex;
+		const size_t skippedFrameCount = HEPH_MATH_MIN(this->skipCount, buffer.FrameCount());
+		this->skipCount -= skippedFrameCount;
+
+		this->pendingSamples.reserve(this->pendingSamples.size() + buffer.FrameCount() - skippedFrameCount);
+		for (size_t i = skippedFrameCount; i < buffer.FrameCount(); ++i)
+		{
+			this->pendingSamples.push_back(HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(pSamples[i * channelCount]));
+		}
+	}
+
+	size_t StftAnalyzer::GetAvailableFrameCount() const
+	{
+		if (this->pendingSamples.size() < this->wnd.Size())
+		{
+			return 0;
+		}
+		return 1 + (this->pendingSamples.size() - this->wnd.Size()) / this->hopSize;
+	}
+
+	size_t StftAnalyzer::Pop(StftOutputType outputType, double* pOutput, size_t maxFrameCount)
+	{
+		const size_t frameCount = HEPH_MATH_MIN(this->GetAvailableFrameCount(), maxFrameCount);
+		if (frameCount == 0)
+		{
+			return 0;
+		}
+		if (pOutput == nullptr)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "pOutput must not be nullptr."));
+		}
+
+		this->AnalyzeST(this->pendingSamples.data(), 1, this->pendingSamples.size(), 0, frameCount, outputType, pOutput, nullptr);
+
+		// the next frame may start after the pushed samples if the hop size is greater than the window size.
+		const size_t consumedSampleCount = frameCount * this->hopSize;
+		if (consumedSampleCount > this->pendingSamples.size())
+		{
+			this->skipCount = consumedSampleCount - this->pendingSamples.size();
+			this->pendingSamples.clear();
+		}
+		else
+		{
+			this->pendingSamples.erase(this->pendingSamples.begin(), this->pendingSamples.begin() + consumedSampleCount);
+		}
+
+		return frameCount;
+	}
+
+	void StftAnalyzer::Reset()
+	{
+		this->pendingSamples.clear();
+		this->skipCount = 0;
+	}
+
+	template<typename Tsample>
+	void StftAnalyzer::AnalyzeST(const Tsample* pSamples, size_t stride, size_t sampleCount, size_t firstFrameIndex, size_t frameCount, StftOutputType outputType, double* pOutput, double* pImag) const
+	{
+		const size_t binCount = this->GetBinCount();
+		const size_t wndSize = this->wnd.Size();
+		const size_t endFrameIndex = firstFrameIndex + frameCount;
+
+		SplitComplexBuffer channel(this->fftSize);
+		double* const pReal = channel.Real();
+		double* const pChannelImag = channel.Imag();
+
+		// the frames are real, hence two of them are transformed at once as the real and imaginary parts,
+		// then separated using the symmetry of the spectrum of real signals.
+		for (size_t i = firstFrameIndex; i < endFrameIndex; i += 2)
+		{
+			const bool hasSecondFrame = (i + 1) < endFrameIndex;
+
+			channel.Reset();
+			for (size_t j = 0; j < (hasSecondFrame ? 2 : 1); ++j)
+			{
+				double* const pFrame = (j == 0) ? (pReal) : (pChannelImag);
+				const size_t frameStart = (i + j) * this->hopSize;
+				const size_t frameSize = (frameStart < sampleCount) ? (HEPH_MATH_MIN(wndSize, sampleCount - frameStart)) : (0);
+				for (size_t k = 0; k < frameSize; ++k)
+				{
+					if constexpr (std::is_same<Tsample, double>::value)
+					{
+						pFrame[k] = pSamples[(frameStart + k) * stride] * this->wnd[k];
+					}
+					else
+					{
+						pFrame[k] = HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(pSamples[(frameStart + k) * stride]) * this->wnd[k];
+					}
+				}
+			}
+
+			Fourier::FFT(channel);
+
+			const size_t outputIndex = (i - firstFrameIndex) * binCount;
+			for (size_t k = 0; k < binCount; ++k)
+			{
+				const size_t mirroredBin = (this->fftSize - k) & (this->fftSize - 1);
+				const double a = pReal[k], b = pChannelImag[k];
+				const double c = pReal[mirroredBin], d = pChannelImag[mirroredBin];
+
+				StftAnalyzer::StoreBin((a + c) * 0.5, (b - d) * 0.5, outputType,
+					pOutput + outputIndex + k, (pImag != nullptr) ? (pImag + outputIndex + k) : (nullptr));
+				if (hasSecondFrame)
+				{
+					StftAnalyzer::StoreBin((b + d) * 0.5, (c - a) * 0.5, outputType,
+						pOutput + outputIndex + binCount + k, (pImag != nullptr) ? (pImag + outputIndex + binCount + k) : (nullptr));
+				}
+			}
+		}
+	}
+
+	void StftAnalyzer::AnalyzeMT(const AudioBuffer& buffer, size_t channelIndex, StftOutputType outputType, double* pOutput, double* pImag) const
+	{
+		const size_t channelCount = buffer.FormatInfo().channelLayout.count;
+		const size_t frameCount = this->CalculateFrameCount(buffer.FrameCount());
+		if (frameCount == 0)
+		{
+			return;
+		}
+		if (channelIndex >= channelCount)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "channelIndex out of bounds."));
+		}
+
+		const heph_audio_sample_t* const pSamples = buffer.begin() + channelIndex;
+		const size_t threadCount = HEPH_MATH_MIN(this->threadCount, frameCount);
+		const size_t binCount = this->GetBinCount();
+
+		// each thread processes an even number of frames so the pairs are not split.
+		const size_t framesPerThread = ((frameCount / threadCount) + 1) & ~((size_t)1);
+		std::vector<std::thread> threads;
+		size_t firstFrameIndex = 0;
+
+		for (size_t i = 0; i < threadCount - 1 && (firstFrameIndex + framesPerThread) < frameCount; ++i)
+		{
+			threads.push_back(std::thread(
+				&StftAnalyzer::AnalyzeST<heph_audio_sample_t>,
+				this,
+				pSamples,
+				channelCount,
+				buffer.FrameCount(),
+				firstFrameIndex,
+				framesPerThread,
+				outputType,
+				pOutput + firstFrameIndex * binCount,
+				(pImag != nullptr) ? (pImag + firstFrameIndex * binCount) : (nullptr)
+			));
+			firstFrameIndex += framesPerThread;
+		}
+		this->AnalyzeST(pSamples, channelCount, buffer.FrameCount(), firstFrameIndex, frameCount - firstFrameIndex, outputType,
+			pOutput + firstFrameIndex * binCount, (pImag != nullptr) ? (pImag + firstFrameIndex * binCount) : (nullptr));
+
+		for (std::thread& t : threads)
+		{
+			if (t.joinable())
+			{
+				t.join();
+			}
+		}
+	}
+
+	void StftAnalyzer::StoreBin(double re, double im, StftOutputType outputType, double* pOutput, double* pImag)
+	{
+		if (pImag != nullptr)
+		{
+			*pOutput = re;
+			*pImag = im;
+			return;
+		}
+
+		const double power = re * re + im * im;
+		switch (outputType)
+		{
+		case StftOutputType::Power:
+			*pOutput = power;
+			break;
+		case StftOutputType::Decibel:
+			*pOutput = GainToDecibel(sqrt(power));
+			break;
+		case StftOutputType::Magnitude:
+		default:
+			*pOutput = sqrt(power);
+			break;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,250 @@
+#include "WavAudioEncoder.h"
+#include "PcmAudioDecoder.h"
+#include "HephMath.h"
+#include "ConsoleLogger.h"
+#include "Exceptions/ExternalException.h"
+#include "Exceptions/InvalidArgumentException.h"
+#include "Exceptions/InvalidOperationException.h"
+#include <cerrno>
+#include <cstring>
+
+using namespace Heph;
+
+namespace HephAudio
+{
+	// number of frames converted per fwrite call.
+	static constexpr size_t WAV_ENCODER_CHUNK_FRAME_COUNT = 4096;
+
+	// the JUNK chunk reserves the space of the ds64 chunk so the file can be promoted to RF64 without moving the samples.
+	static constexpr uint32_t WAV_DS64_CHUNK_SIZE = 28;
+
+	static constexpr uint8_t WAV_SUBFORMAT_GUID_SUFFIX[14] = { 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71 };
+
+	WavAudioEncoder::WavAudioEncoder() : pFile(nullptr), dataSize(0) {}
+
+	WavAudioEncoder::WavAudioEncoder(const std::filesystem::path& filePath, const AudioFormatInfo& outputFormatInfo, bool overwrite) : WavAudioEncoder()
+	{
+		this->OpenFile(filePath, outputFormatInfo, overwrite);
+	}
+
+	WavAudioEncoder::~WavAudioEncoder()
+	{
+		this->CloseFile();
+	}
+
+	void WavAudioEncoder::ChangeFile(const std::filesystem::path& newAudioFilePath, const AudioFormatInfo& outputFormatInfo, bool overwrite)
+	{
+		if (this->filePath != newAudioFilePath)
+		{
+			this->CloseFile();
+			this->OpenFile(newAudioFilePath, outputFormatInfo, overwrite);
+		}
+	}
+
+	void WavAudioEncoder::CloseFile()
+	{
+		if (this->pFile != nullptr)
+		{
+			// chunks are padded to even sizes.
+			const uint8_t padding = 0;
+			if ((this->dataSize & 1) != 0 && fwrite(&padding, 1, 1, this->pFile) != 1)
+			{
+				HEPHAUDIO_LOG("Failed to write the data chunk padding.", HEPH_CL_ERROR);
+			}
+
+			if (!this->WriteHeader(true))
+			{
+				HEPHAUDIO_LOG("Failed to write the WAV header.", HEPH_CL_ERROR);
+			}
+
+			(void)fclose(this->pFile);
+			this->pFile = nullptr;
+		}
+
+		this->filePath = "";
+		this->dataSize = 0;
+		this->ditherState.Reset();
+	}
+
+	bool WavAudioEncoder::IsFileOpen() const
+	{
+		return this->pFile != nullptr;
+	}
+
+	void WavAudioEncoder::Encode(const AudioBuffer& bufferToEncode)
+	{
+		if (!this->IsFileOpen())
+		{
+			HEPH_RAISE_EXCEPTION(this, InvalidOperationException(HEPH_FUNC, "No open file to encode."));
+			return;
+		}
+
+		if (bufferToEncode.IsEmpty())
+		{
+			HEPH_RAISE_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "Trying to encode empty buffer."));
+			return;
+		}
+
+		const AudioFormatInfo& inputFormatInfo = bufferToEncode.FormatInfo();
+		if (inputFormatInfo.channelLayout.count != this->outputFormatInfo.channelLayout.count || inputFormatInfo.sampleRate != this->outputFormatInfo.sampleRate)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "Channel count and sample rate of the buffer must match the output format."));
+		}
+
+		const size_t frameSize = this->outputFormatInfo.FrameSize();
+		const size_t channelCount = this->outputFormatInfo.channelLayout.count;
+		const size_t frameCount = bufferToEncode.FrameCount();
+		const heph_audio_sample_t* pInput = bufferToEncode.begin();
+		this->scratchBuffer.resize(WAV_ENCODER_CHUNK_FRAME_COUNT * frameSize);
+
+		for (size_t i = 0; i < frameCount; i += WAV_ENCODER_CHUNK_FRAME_COUNT)
+		{
+			const size_t chunkFrameCount = HEPH_MATH_MIN(WAV_ENCODER_CHUNK_FRAME_COUNT, frameCount - i);
+			const size_t chunkSize = chunkFrameCount * frameSize;
+
+			SampleFormatConverter::FromInternal(pInput + i * channelCount, this->scratchBuffer.data(), chunkFrameCount, this->outputFormatInfo, &this->ditherState);
+			if (fwrite(this->scratchBuffer.data(), 1, chunkSize, this->pFile) != chunkSize)
+			{
+				HEPH_RAISE_AND_THROW_EXCEPTION(this, ExternalException(HEPH_FUNC, "Failed to write the samples.", "C Runtime", strerror(errno)));
+			}
+			this->dataSize += chunkSize;
+		}
+	}
+
+	void WavAudioEncoder::Encode(const AudioBuffer& inputBuffer, EncodedAudioBuffer& outputBuffer)
+	{
+		const AudioFormatInfo& inputFormatInfo = inputBuffer.FormatInfo();
+		const AudioFormatInfo& outputFormatInfo = outputBuffer.GetAudioFormatInfo();
+
+		if (inputFormatInfo.channelLayout.count != outputFormatInfo.channelLayout.count || inputFormatInfo.sampleRate != outputFormatInfo.sampleRate)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "Channel count and sample rate of the buffers must match."));
+		}
+
+		if (!SampleFormatConverter::IsSupported(outputFormatInfo))
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "Unsupported format"));
+		}
+
+		outputBuffer.Resize(inputBuffer.FrameCount() * outputFormatInfo.FrameSize());
+		SampleFormatConverter::FromInternal(inputBuffer, outputBuffer.begin(), outputFormatInfo);
+	}
+
+	void WavAudioEncoder::Transcode(const EncodedAudioBuffer& inputBuffer, EncodedAudioBuffer& outputBuffer)
+	{
+		PcmAudioDecoder decoder(nullptr);
+		const AudioBuffer decodedBuffer = decoder.Decode(inputBuffer);
+		this->Encode(decodedBuffer, outputBuffer);
+	}
+
+	DitherMode WavAudioEncoder::GetDitherMode() const
+	{
+		return this->ditherState.mode;
+	}
+
+	void WavAudioEncoder::SetDitherMode(DitherMode ditherMode)
+	{
+		this->ditherState.mode = ditherMode;
+		this->ditherState.Reset();
+	}
+
+	uint64_t WavAudioEncoder::GetDataSize() const
+	{
+		return this->dataSize;
+	}
+
+	void WavAudioEncoder::OpenFile(const std::filesystem::path& filePath, const AudioFormatInfo& outputFormatInfo, bool overwrite)
+	{
+		if (!overwrite && std::filesystem::exists(filePath))
+		{
+			HEPH_RAISE_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "File already exists."));
+			return;
+		}
+
+		AudioFormatInfo wavFormatInfo = outputFormatInfo;
+		wavFormatInfo.endian = Endian::Little;
+		if (!SampleFormatConverter::IsSupported(wavFormatInfo))
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "Unsupported format"));
+		}
+
+		this->pFile = fopen(filePath.string().c_str(), "wb");
+		if (this->pFile == nullptr)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, ExternalException(HEPH_FUNC, "Failed to open the file.", "C Runtime", strerror(errno)));
+		}
+
+		this->filePath = filePath;
+		this->outputFormatInfo = wavFormatInfo;
+		this->dataSize = 0;
+		this->ditherState.Reset();
+
+		// sizes are filled in when the file is closed.
+		if (!this->WriteHeader(false))
+		{
+			const int error = errno;
+			this->CloseFile();
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, ExternalException(HEPH_FUNC, "Failed to write the WAV header.", "C Runtime", strerror(error)));
+		}
+	}
+
+	std::vector<uint8_t> WavAudioEncoder::CreateHeader(const AudioFormatInfo& formatInfo, uint64_t dataSize, bool isFinal)
+	{
+		const bool isExtensible = formatInfo.channelLayout.count > 2 || (formatInfo.formatTag == HEPHAUDIO_FORMAT_TAG_PCM && formatInfo.bitsPerSample > 16);
+		const uint32_t fmtChunkSize = isExtensible ? 40 : (formatInfo.formatTag == HEPHAUDIO_FORMAT_TAG_PCM ? 16 : 18);
+		const uint64_t riffSize = 4 + (8 + WAV_DS64_CHUNK_SIZE) + (8 + fmtChunkSize) + 8 + dataSize + (dataSize & 1);
+		const bool isRf64 = isFinal && riffSize > UINT32_MAX;
+
+		std::vector<uint8_t> header;
+		auto writeTag = [&header](const char* tag) { header.insert(header.end(), tag, tag + 4); };
+		auto writeUInt = [&header](uint64_t value, size_t size)
+			{
+				for (size_t i = 0; i < size; i++)
+				{
+					header.push_back((uint8_t)(value >> (i * 8)));
+				}
+			};
+
+		writeTag(isRf64 ? "RF64" : "RIFF");
+		writeUInt(isRf64 ? UINT32_MAX : riffSize, 4);
+		writeTag("WAVE");
+
+		writeTag(isRf64 ? "ds64" : "JUNK");
+		writeUInt(WAV_DS64_CHUNK_SIZE, 4);
+		writeUInt(isRf64 ? riffSize : 0, 8);
+		writeUInt(isRf64 ? dataSize : 0, 8);
+		writeUInt(isRf64 ? dataSize / formatInfo.FrameSize() : 0, 8);
+		writeUInt(0, 4);
+
+		writeTag("fmt ");
+		writeUInt(fmtChunkSize, 4);
+		writeUInt(isExtensible ? HEPHAUDIO_FORMAT_TAG_EXTENSIBLE : formatInfo.formatTag, 2);
+		writeUInt(formatInfo.channelLayout.count, 2);
+		writeUInt(formatInfo.sampleRate, 4);
+		writeUInt(formatInfo.ByteRate(), 4);
+		writeUInt(formatInfo.FrameSize(), 2);
+		writeUInt(formatInfo.bitsPerSample, 2);
+		if (fmtChunkSize > 16)
+		{
+			writeUInt(isExtensible ? 22 : 0, 2);
+		}
+		if (isExtensible)
+		{
+			writeUInt(formatInfo.bitsPerSample, 2);
+			writeUInt((uint32_t)formatInfo.channelLayout.mask, 4);
+			writeUInt(formatInfo.formatTag, 2);
+			header.insert(header.end(), WAV_SUBFORMAT_GUID_SUFFIX, WAV_SUBFORMAT_GUID_SUFFIX + sizeof(WAV_SUBFORMAT_GUID_SUFFIX));
+		}
+
+		writeTag("data");
+		writeUInt(isRf64 ? UINT32_MAX : dataSize, 4);
+
+		return header;
+	}
+
+	bool WavAudioEncoder::WriteHeader(bool isFinal)
+	{
+		const std::vector<uint8_t> header = WavAudioEncoder::CreateHeader(this->outputFormatInfo, this->dataSize, isFinal);
+		return fseek(this->pFile, 0, SEEK_SET) == 0 && fwrite(header.data(), 1, header.size(), this->pFile) == header.size();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,183 @@
+#pragma once
+#include "HephShared.h"
+#include "Complex.h"
+#include "Buffers/BufferBase.h"
+#include "Buffers/ComplexBuffer.h"
+
+/** @file */
+
+namespace Heph
+{
+	/**
+	 * @brief buffer for storing complex numbers with the real and imaginary parts in separate arrays (split complex).
+	 * Unlike \link Heph::ComplexBuffer ComplexBuffer \endlink, the element-wise operations process multiple elements at once
+	 * with SSE2 on x86_64 and NEON on arm64.
+	 * Instantiated for <b>float</b> and <b>double</b>.
+	 *
+	 * @tparam Tdata type of the real and imaginary parts.
+	 */
+	template <typename Tdata>
+	class HEPH_API BasicSplitComplexBuffer final
+	{
+	private:
+		/** real parts followed by the imaginary parts, allocated at once. */
+		Tdata* pData;
+		size_t size;
+
+	public:
+		/** @copydoc default_constructor */
+		BasicSplitComplexBuffer();
+
+		/**
+		 * @copydoc constructor
+		 *
+		 * @param size number of complex numbers the buffer stores, initialized to zero.
+		 */
+		explicit BasicSplitComplexBuffer(size_t size);
+
+		/**
+		 * @copydoc BasicSplitComplexBuffer(size_t)
+		 *
+		 * @param flags flags.
+		 */
+		BasicSplitComplexBuffer(size_t size, BufferFlags flags);
+
+		/**
+		 * @copydoc constructor
+		 *
+		 * @param rhs complex numbers that will be copied.
+		 */
+		explicit BasicSplitComplexBuffer(const ComplexBuffer& rhs);
+
+		/** @copydoc copy_constructor */
+		BasicSplitComplexBuffer(const BasicSplitComplexBuffer& rhs);
+
+		/** @copydoc move_constructor */
+		BasicSplitComplexBuffer(BasicSplitComplexBuffer&& rhs) noexcept;
+
+		/** @copydoc destructor */
+		~BasicSplitComplexBuffer();
+
+		BasicSplitComplexBuffer& operator=(const BasicSplitComplexBuffer& rhs);
+		BasicSplitComplexBuffer& operator=(BasicSplitComplexBuffer&& rhs) noexcept;
+		bool operator==(const BasicSplitComplexBuffer& rhs) const;
+		bool operator!=(const BasicSplitComplexBuffer& rhs) const;
+
+		/**
+		 * gets the number of complex numbers the buffer stores.
+		 *
+		 */
+		size_t Size() const;
+
+		/**
+		 * checks whether the buffer is empty.
+		 *
+		 */
+		bool IsEmpty() const;
+
+		/**
+		 * gets the pointer to the first real part.
+		 *
+		 */
+		Tdata* Real() const;
+
+		/**
+		 * gets the pointer to the first imaginary part.
+		 *
+		 */
+		Tdata* Imag() const;
+
+		/**
+		 * gets the complex number at the provided index.
+		 *
+		 */
+		Complex Get(size_t index) const;
+
+		/**
+		 * sets the complex number at the provided index.
+		 *
+		 */
+		void Set(size_t index, const Complex& value);
+
+		/**
+		 * sets all elements to zero.
+		 *
+		 */
+		void Reset();
+
+		/**
+		 * releases the resources.
+		 *
+		 */
+		void Release();
+
+		/**
+		 * changes the size of the buffer, the new elements are set to zero.
+		 *
+		 * @param newSize new number of complex numbers.
+		 */
+		void Resize(size_t newSize);
+
+		/**
+		 * copies the elements to a \link Heph::ComplexBuffer ComplexBuffer \endlink.
+		 *
+		 */
+		ComplexBuffer ToComplexBuffer() const;
+
+		/**
+		 * multiplies each element with the corresponding element of another buffer.
+		 *
+		 * @param rhs buffer with the same size.
+		 */
+		void Multiply(const BasicSplitComplexBuffer& rhs);
+
+		/**
+		 * multiplies the corresponding elements of two buffers and adds the results to this buffer.
+		 *
+		 * @param lhs buffer with the same size.
+		 * @param rhs buffer with the same size.
+		 */
+		void MultiplyAccumulate(const BasicSplitComplexBuffer& lhs, const BasicSplitComplexBuffer& rhs);
+
+		/**
+		 * multiplies each element with a real number.
+		 *
+		 */
+		void Scale(Tdata factor);
+
+		/**
+		 * replaces each element with its complex conjugate.
+		 *
+		 */
+		void Conjugate();
+
+		/**
+		 * calculates the magnitude of each element.
+		 *
+		 * @param pOutput memory that will receive the magnitudes, must have space for at least \link BasicSplitComplexBuffer::Size Size \endlink elements.
+		 */
+		void Magnitude(Tdata* pOutput) const;
+
+		/**
+		 * calculates the phase of each element in radians.
+		 *
+		 * @param pOutput memory that will receive the phases, must have space for at least \link BasicSplitComplexBuffer::Size Size \endlink elements.
+		 */
+		void Phase(Tdata* pOutput) const;
+
+	private:
+		static Tdata* Allocate(size_t size);
+	};
+
+	/**
+	 * @brief split complex buffer with double precision.
+	 *
+	 */
+	using SplitComplexBuffer = BasicSplitComplexBuffer<double>;
+
+	/**
+	 * @brief split complex buffer with single precision, twice as many elements are processed at once.
+	 *
+	 */
+	using SplitComplexFloatBuffer = BasicSplitComplexBuffer<float>;
+}
\ No newline at end of file
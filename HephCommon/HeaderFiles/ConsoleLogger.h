@@ -1,6 +1,8 @@
 #pragma once
 #include "HephShared.h"
 #include <string>
+#include <filesystem>
+#include <ctime>
 
 /** @file */
 
@@ -10,10 +12,35 @@
 #define HEPH_CL_SUCCESS "32"
 #define HEPH_CL_DEBUG 	"35"
 
+/** @def HEPH_CL_MAX_MESSAGE_LENGTH
+ * maximum number of characters a message can have in asynchronous mode, longer messages are truncated.
+ *
+ */
+
+/** @def HEPH_CL_MAX_LIB_NAME_LENGTH
+ * maximum number of characters a library name can have in asynchronous mode, longer names are truncated.
+ *
+ */
+
+/** @def HEPH_CL_DEFAULT_QUEUE_CAPACITY
+ * default number of messages that can be waiting to be written in asynchronous mode.
+ *
+ */
+
+#define HEPH_CL_MAX_MESSAGE_LENGTH 1024
+#define HEPH_CL_MAX_LIB_NAME_LENGTH 32
+#define HEPH_CL_DEFAULT_QUEUE_CAPACITY 256
+
 namespace Heph
 {
 	/**
 	 * @brief class for printing formatted messages to the console.
+	 * 
+	 * By default the messages are written synchronously by the calling thread.
+	 * In asynchronous mode the messages are copied into preallocated fixed-size records and pushed into a lock-free queue,
+	 * a background thread formats and writes them. Logging then neither allocates nor blocks, hence it can be done from the real-time threads.
+	 * When the queue is full the messages are dropped and the number of dropped messages is reported later.
+	 * 
 	 * @note this is a static class and cannot be instantiated.
 	 */
 	class HEPH_API ConsoleLogger final
@@ -50,6 +77,25 @@ namespace Heph
 		 */
 		static void Log(const std::string& message, const char* logLevel, const std::string& libName);
 
+		/**
+		 * prints the provided message to the console.
+		 * 
+		 * @param message null terminated message that will be printed.
+		 * @param logLevel one of the <b>HEPH_CL_*</b> macros. 
+		 * 
+		 */
+		static void Log(const char* message, const char* logLevel);
+
+		/**
+		 * prints the provided message to the console.
+		 * 
+		 * @param message null terminated message that will be printed.
+		 * @param logLevel one of the <b>HEPH_CL_*</b> macros.
+		 * @param libName name of the library thats printing.
+		 * 
+		 */
+		static void Log(const char* message, const char* logLevel, const char* libName);
+
 		/**
 		 * prints the provided message to the console as INFO.
 		 *
@@ -147,8 +193,80 @@ namespace Heph
 		 */
 		static void DisableColoredOutput();
 
+		/**
+		 * starts the background thread and writes the messages asynchronously.
+		 * 
+		 */
+		static void EnableAsyncLogging();
+
+		/**
+		 * starts the background thread and writes the messages asynchronously.
+		 * 
+		 * @param queueCapacity maximum number of messages that can be waiting to be written, rounded up to a power of 2.
+		 * 
+		 */
+		static void EnableAsyncLogging(size_t queueCapacity);
+
+		/**
+		 * writes the pending messages, stops the background thread and switches back to synchronous mode.
+		 * 
+		 */
+		static void DisableAsyncLogging();
+
+		/**
+		 * checks whether the messages are written asynchronously.
+		 * 
+		 */
+		static bool IsAsyncLoggingEnabled();
+
+		/**
+		 * waits until the messages logged so far are written.
+		 * 
+		 */
+		static void Flush();
+
+		/**
+		 * gets the number of messages that are dropped because the queue was full.
+		 * 
+		 */
+		static uint64_t GetDroppedMessageCount();
+
+		/**
+		 * gets the repeat suppression interval in milliseconds.
+		 * 
+		 */
+		static uint32_t GetRepeatSuppressionInterval();
+
+		/**
+		 * sets the repeat suppression interval.
+		 * In asynchronous mode a message that's identical to the previous one is only written once per interval,
+		 * the number of suppressed repetitions is written afterwards.
+		 * 
+		 * @param interval_ms interval in milliseconds, 0 disables the suppression.
+		 * 
+		 */
+		static void SetRepeatSuppressionInterval(uint32_t interval_ms);
+
+		/**
+		 * writes the messages to the provided file as well, without the color codes.
+		 * The messages are appended if the file already exists.
+		 * 
+		 * @param filePath path of the log file.
+		 * 
+		 */
+		static void SetLogFile(const std::filesystem::path& filePath);
+
+		/**
+		 * stops writing the messages to the log file.
+		 * 
+		 */
+		static void CloseLogFile();
+
 	private:
+		static void Write(const char* message, const char* logLevel, const char* libName, time_t logTime);
+		static void WriterThreadProc();
 		static std::string CurrentTimeToString();
+		static std::string TimeToString(time_t t);
 		static std::string GetLogLevelName(const char* logLevel);
 	};
 }
\ No newline at end of file
@@ -0,0 +1,120 @@
+#pragma once
+#include "HephShared.h"
+#include "HephMath.h"
+#include <type_traits>
+
+/** @file */
+
+namespace Heph
+{
+	/**
+	 * @brief provides branch-free polynomial and rational approximations of the transcendental functions.
+	 * The methods only use arithmetic and selects so loops calling them can be auto-vectorized by the compiler.
+	 * Error bounds are measured against the standard library functions.
+	 * @note this class cannot be instantiated.
+	 *
+	 */
+	class FastMath final
+	{
+	public:
+		FastMath() = delete;
+		FastMath(const FastMath&) = delete;
+		FastMath& operator=(const FastMath&) = delete;
+
+	public:
+		/**
+		 * approximates ``tanh(x)`` with a 13/6 odd/even rational function, input is clamped to ±7.9.
+		 * Maximum absolute error is less than 3e-7 for all inputs.
+		 *
+		 * @tparam T ``float`` or ``double``.
+		 */
+		template<typename T>
+		static inline T Tanh(T x)
+		{
+			static_assert(std::is_floating_point<T>::value, "T must be a floating point type");
+
+			constexpr T clampValue = T(7.90531110763549805);
+			x = x > clampValue ? clampValue : (x < -clampValue ? -clampValue : x);
+
+			const T x2 = x * x;
+
+			T p = T(-2.76076847742355e-16);
+			p = p * x2 + T(2.00018790482477e-13);
+			p = p * x2 + T(-8.60467152213735e-11);
+			p = p * x2 + T(5.12229709037114e-08);
+			p = p * x2 + T(1.48572235717979e-05);
+			p = p * x2 + T(6.37261928875436e-04);
+			p = p * x2 + T(4.89352455891786e-03);
+			p *= x;
+
+			T q = T(1.19825839466702e-06);
+			q = q * x2 + T(1.18534705686654e-04);
+			q = q * x2 + T(2.26843463243900e-03);
+			q = q * x2 + T(4.89352518554385e-03);
+
+			return p / q;
+		}
+
+		/**
+		 * approximates ``atan(x)`` with an 11th order minimax polynomial on [-1, 1] and the identity ``atan(x) = ±pi/2 - atan(1/x)`` outside of it.
+		 * Maximum absolute error is less than 2e-6 rad for all inputs.
+		 *
+		 * @tparam T ``float`` or ``double``.
+		 */
+		template<typename T>
+		static inline T Atan(T x)
+		{
+			static_assert(std::is_floating_point<T>::value, "T must be a floating point type");
+
+			const T absX = x < 0 ? -x : x;
+			const bool invert = absX > T(1);
+			const T r = invert ? (T(1) / x) : x;
+			const T r2 = r * r;
+
+			T p = T(-0.01172120);
+			p = p * r2 + T(0.05265332);
+			p = p * r2 + T(-0.11643287);
+			p = p * r2 + T(0.19354346);
+			p = p * r2 + T(-0.33262347);
+			p = p * r2 + T(0.99997726);
+			p *= r;
+
+			const T halfPi = x < 0 ? T(-HEPH_MATH_PI / 2.0) : T(HEPH_MATH_PI / 2.0);
+			return invert ? (halfPi - p) : p;
+		}
+
+		/**
+		 * approximates ``sin(x)`` with an 11th order odd polynomial after reducing the input to [-pi/2, pi/2].
+		 * Maximum absolute error is less than 1e-7 for |x| < 1e4 in double precision and less than 1e-5 for |x| < 100 in single precision,
+		 * the range reduction loses precision proportional to |x| beyond that.
+		 *
+		 * @tparam T ``float`` or ``double``.
+		 */
+		template<typename T>
+		static inline T Sin(T x)
+		{
+			static_assert(std::is_floating_point<T>::value, "T must be a floating point type");
+
+			constexpr T pi = T(HEPH_MATH_PI);
+			constexpr T halfPi = T(HEPH_MATH_PI / 2.0);
+			constexpr T inv2Pi = T(1.0 / (2.0 * HEPH_MATH_PI));
+
+			// reduce to [-pi, pi]
+			T k = x * inv2Pi;
+			k = k >= 0 ? T((int64_t)(k + T(0.5))) : T((int64_t)(k - T(0.5)));
+			x -= k * T(2.0 * HEPH_MATH_PI);
+
+			// fold into [-pi/2, pi/2]
+			x = x > halfPi ? (pi - x) : (x < -halfPi ? (-pi - x) : x);
+
+			const T x2 = x * x;
+			T p = T(-1.0 / 39916800.0);
+			p = p * x2 + T(1.0 / 362880.0);
+			p = p * x2 + T(-1.0 / 5040.0);
+			p = p * x2 + T(1.0 / 120.0);
+			p = p * x2 + T(-1.0 / 6.0);
+			p = p * x2 + T(1.0);
+			return p * x;
+		}
+	};
+}
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "HephShared.h"
 #include "Complex.h"
 #include "Buffers/ComplexBuffer.h"
+#include "Buffers/SplitComplexBuffer.h"
 #include "Buffers/DoubleBuffer.h"
 
 /** @file */
@@ -72,6 +73,38 @@ namespace Heph
 		 */
 		static void IFFT(ComplexBuffer& complexBuffer, bool scale);
 
+		/**
+		 * computes the forward Fast Fourier Transform.
+		 * 
+		 * @param splitComplexBuffer contains the time domain data in input, and frequency domain data in output.
+		 */
+		static void FFT(SplitComplexBuffer& splitComplexBuffer);
+
+		/**
+		 * computes the forward Fast Fourier Transform.
+		 * 
+		 * @param splitComplexBuffer contains the time domain data in input, and frequency domain data in output.
+		 * @param fftSize size of the FFT. Must be a power of 2, if not the closest power of 2 will be used.
+		 */
+		static void FFT(SplitComplexBuffer& splitComplexBuffer, size_t fftSize);
+
+		/** @copydoc FFT(SplitComplexBuffer&) */
+		static void FFT(SplitComplexFloatBuffer& splitComplexBuffer);
+
+		/** @copydoc FFT(SplitComplexBuffer&,size_t) */
+		static void FFT(SplitComplexFloatBuffer& splitComplexBuffer, size_t fftSize);
+
+		/**
+		 * computes the inverse Fast Fourier Transform.
+		 * 
+		 * @param splitComplexBuffer contains the frequency domain data in input, and time domain data in output.
+		 * @param scale indicates whether to divide the output by fftSize.
+		 */
+		static void IFFT(SplitComplexBuffer& splitComplexBuffer, bool scale);
+
+		/** @copydoc IFFT(SplitComplexBuffer&,bool) */
+		static void IFFT(SplitComplexFloatBuffer& splitComplexBuffer, bool scale);
+
 		/**
 		 * computes the corresponding bin index to the provided frequency.
 		 * 
@@ -109,5 +142,7 @@ namespace Heph
 	private:
 		static void ReverseBits(ComplexBuffer& complexBuffer, size_t fftSize);
 		static void FFT_Internal(ComplexBuffer& complexBuffer, size_t fftSize, bool direction);
+		template<typename Tdata>
+		static void FFT_Internal(BasicSplitComplexBuffer<Tdata>& splitComplexBuffer, size_t fftSize, bool direction);
 	};
 }
\ No newline at end of file
@@ -117,11 +117,12 @@ namespace Heph
 	struct has_unary_plus_operator<T,
 		typename std::enable_if<std::is_same<T, decltype(+std::declval<T>())>::value>::type> : std::true_type {};
 
+	// the integers smaller than int are promoted, hence the result only needs to be convertible back.
 	template<class T, typename = void>
 	struct has_unary_minus_operator : std::false_type {};
 	template<class T>
 	struct has_unary_minus_operator<T,
-		typename std::enable_if<std::is_same<T, decltype(-std::declval<T>())>::value && !std::is_unsigned<T>::value>::type> : std::true_type {};
+		typename std::enable_if<std::is_convertible<decltype(-std::declval<T>()), T>::value && !std::is_unsigned<T>::value>::type> : std::true_type {};
 
 	template<class T, typename = void>
 	struct has_logical_not_operator : std::false_type {};
@@ -0,0 +1,79 @@
+#pragma once
+#include "HephShared.h"
+#include <filesystem>
+#include <cstdint>
+
+/** @file */
+
+namespace Heph
+{
+	/**
+	 * @brief maps a file to the memory for reading.
+	 * Pages are loaded by the OS on first access, so opening a file is cheap regardless of its size.
+	 *
+	 */
+	class HEPH_API MemoryMappedFile final
+	{
+	private:
+		const uint8_t* pData;
+		size_t size;
+		bool isOpen;
+#if defined(_WIN32)
+		void* hFile;
+		void* hMapping;
+#endif
+
+	public:
+		/** @copydoc default_constructor */
+		MemoryMappedFile();
+
+		/**
+		 * @copydoc constructor
+		 *
+		 * @param filePath path of the file that will be mapped.
+		 */
+		explicit MemoryMappedFile(const std::filesystem::path& filePath);
+
+		/** @copydoc move_constructor */
+		MemoryMappedFile(MemoryMappedFile&& rhs) noexcept;
+
+		MemoryMappedFile(const MemoryMappedFile&) = delete;
+
+		/** @copydoc destructor */
+		~MemoryMappedFile();
+
+		MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+		MemoryMappedFile& operator=(MemoryMappedFile&& rhs) noexcept;
+
+		/**
+		 * maps the provided file, the currently mapped file is closed first.
+		 *
+		 * @param filePath path of the file that will be mapped.
+		 */
+		void Open(const std::filesystem::path& filePath);
+
+		/**
+		 * unmaps the file.
+		 *
+		 */
+		void Close();
+
+		/**
+		 * checks whether a file is mapped.
+		 *
+		 */
+		bool IsOpen() const;
+
+		/**
+		 * gets the pointer to the first byte of the file, nullptr if no file is mapped or the file is empty.
+		 *
+		 */
+		const uint8_t* Data() const;
+
+		/**
+		 * gets the size of the file in bytes.
+		 *
+		 */
+		size_t Size() const;
+	};
+}
\ No newline at end of file
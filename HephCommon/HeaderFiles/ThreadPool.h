@@ -0,0 +1,77 @@
+#pragma once
+#include "HephShared.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/** @file */
+
+namespace Heph
+{
+	/**
+	 * @brief runs the submitted tasks on a fixed maximum number of worker threads.
+	 * The workers are started on demand, hence a pool that's never used does not create any threads.
+	 *
+	 */
+	class HEPH_API ThreadPool final
+	{
+	private:
+		std::vector<std::thread> threads;
+		std::deque<std::function<void()>> tasks;
+		mutable std::mutex mutex;
+		std::condition_variable taskCondition;
+		size_t maxThreadCount;
+		size_t idleThreadCount;
+		bool isStopping;
+
+	public:
+		/**
+		 * @copydoc constructor
+		 *
+		 * @param maxThreadCount maximum number of worker threads, 0 to use the number of hardware threads.
+		 */
+		explicit ThreadPool(size_t maxThreadCount);
+
+		ThreadPool(const ThreadPool&) = delete;
+
+		/**
+		 * @copydoc destructor
+		 * Waits for the running tasks to finish, the tasks that are not started yet are discarded.
+		 *
+		 */
+		~ThreadPool();
+
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		/**
+		 * queues a task, starts a new worker if none is idle and the limit is not reached.
+		 * Exceptions thrown by the task are not propagated, the task must report its own errors.
+		 *
+		 */
+		void Submit(std::function<void()> task);
+
+		/**
+		 * gets the maximum number of worker threads.
+		 *
+		 */
+		size_t GetMaxThreadCount() const;
+
+		/**
+		 * gets the number of worker threads started so far.
+		 *
+		 */
+		size_t GetThreadCount() const;
+
+		/**
+		 * gets the number of tasks waiting for a worker.
+		 *
+		 */
+		size_t GetPendingTaskCount() const;
+
+	private:
+		void WorkerThread();
+	};
+}
\ No newline at end of file
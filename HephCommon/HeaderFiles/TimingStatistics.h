@@ -0,0 +1,148 @@
+#pragma once
+#include "HephShared.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/** @file */
+
+/** @def HEPH_TIMING_STATISTICS_BUCKET_COUNT
+ * number of buckets of the duration histogram.
+ * Bucket 0 counts the durations shorter than 1 microsecond, bucket i counts the durations in [2^(i-1), 2^i) microseconds,
+ * and the last bucket also counts everything longer than that.
+ *
+ */
+#define HEPH_TIMING_STATISTICS_BUCKET_COUNT 24
+
+namespace Heph
+{
+	/**
+	 * @brief plain copy of the values of a \link Heph::TimingStatistics TimingStatistics \endlink instance.
+	 *
+	 */
+	struct HEPH_API TimingStatisticsSnapshot
+	{
+		/**
+		 * number of recorded durations.
+		 *
+		 */
+		uint64_t count;
+
+		/**
+		 * sum of the recorded durations in nanoseconds.
+		 *
+		 */
+		uint64_t total_ns;
+
+		/**
+		 * shortest recorded duration in nanoseconds, 0 if nothing is recorded.
+		 *
+		 */
+		uint64_t min_ns;
+
+		/**
+		 * longest recorded duration in nanoseconds.
+		 *
+		 */
+		uint64_t max_ns;
+
+		/**
+		 * most recently recorded duration in nanoseconds.
+		 *
+		 */
+		uint64_t last_ns;
+
+		/**
+		 * log2 scaled histogram of the recorded durations, see #HEPH_TIMING_STATISTICS_BUCKET_COUNT.
+		 *
+		 */
+		uint64_t histogram[HEPH_TIMING_STATISTICS_BUCKET_COUNT];
+
+		/** @copydoc default_constructor */
+		TimingStatisticsSnapshot();
+
+		/**
+		 * calculates the mean duration in nanoseconds.
+		 *
+		 */
+		double GetMean_ns() const;
+
+		/**
+		 * estimates the duration below which the provided percentage of the recorded durations fall.
+		 * The result is the upper bound of the histogram bucket that contains the percentile, clamped to the longest recorded duration.
+		 *
+		 * @param percentile between 0 and 100.
+		 * @return the estimated duration in nanoseconds.
+		 */
+		uint64_t GetPercentile_ns(double percentile) const;
+	};
+
+	/**
+	 * @brief accumulates durations (count, sum, min, max and a histogram) without locking.
+	 * Recording is wait-free apart from the min/max updates and can be done from a real-time thread,
+	 * the values can be read from any thread at any time.
+	 *
+	 * @note the fields are updated independently, hence a snapshot taken while a duration is being recorded
+	 * may contain the new value in some of the fields but not in the others.
+	 *
+	 */
+	class HEPH_API TimingStatistics final
+	{
+	private:
+		std::atomic<uint64_t> count;
+		std::atomic<uint64_t> total_ns;
+		std::atomic<uint64_t> min_ns;
+		std::atomic<uint64_t> max_ns;
+		std::atomic<uint64_t> last_ns;
+		std::atomic<uint64_t> histogram[HEPH_TIMING_STATISTICS_BUCKET_COUNT];
+
+	public:
+		/** @copydoc default_constructor */
+		TimingStatistics();
+
+		/** @copydoc copy_constructor */
+		TimingStatistics(const TimingStatistics& rhs);
+
+		TimingStatistics& operator=(const TimingStatistics& rhs);
+
+		/**
+		 * adds a duration to the statistics.
+		 *
+		 * @param duration_ns duration in nanoseconds.
+		 */
+		void Record(uint64_t duration_ns);
+
+		/**
+		 * adds a duration to the statistics.
+		 *
+		 */
+		void Record(std::chrono::steady_clock::duration duration);
+
+		/**
+		 * copies the current values.
+		 *
+		 */
+		TimingStatisticsSnapshot GetSnapshot() const;
+
+		/**
+		 * clears the recorded durations.
+		 *
+		 */
+		void Reset();
+
+		/**
+		 * gets the index of the histogram bucket that counts the provided duration.
+		 *
+		 * @param duration_ns duration in nanoseconds.
+		 */
+		static size_t GetBucketIndex(uint64_t duration_ns);
+
+		/**
+		 * gets the exclusive upper bound of a histogram bucket in nanoseconds.
+		 *
+		 * @param bucketIndex index of the bucket.
+		 * @return the upper bound, or UINT64_MAX for the last bucket.
+		 */
+		static uint64_t GetBucketUpperBound_ns(size_t bucketIndex);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,472 @@
+#include "Buffers/SplitComplexBuffer.h"
+#include "HephMath.h"
+#include "Exceptions/InsufficientMemoryException.h"
+#include "Exceptions/InvalidArgumentException.h"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define HEPH_SCB_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define HEPH_SCB_NEON
+#endif
+
+namespace Heph
+{
+	// vectorized kernels, process as many elements as possible and return the number of elements processed.
+	template<typename Tdata>
+	static size_t MultiplyKernel(Tdata* pReal, Tdata* pImag, const Tdata* pRhsReal, const Tdata* pRhsImag, size_t size)
+	{
+		size_t i = 0;
+#if defined(HEPH_SCB_SSE2)
+		if constexpr (std::is_same<Tdata, double>::value)
+		{
+			for (; i + 2 <= size; i += 2)
+			{
+				const __m128d ar = _mm_loadu_pd(pReal + i), ai = _mm_loadu_pd(pImag + i);
+				const __m128d br = _mm_loadu_pd(pRhsReal + i), bi = _mm_loadu_pd(pRhsImag + i);
+				_mm_storeu_pd(pReal + i, _mm_sub_pd(_mm_mul_pd(ar, br), _mm_mul_pd(ai, bi)));
+				_mm_storeu_pd(pImag + i, _mm_add_pd(_mm_mul_pd(ar, bi), _mm_mul_pd(ai, br)));
+			}
+		}
+		else
+		{
+			for (; i + 4 <= size; i += 4)
+			{
+				const __m128 ar = _mm_loadu_ps(pReal + i), ai = _mm_loadu_ps(pImag + i);
+				const __m128 br = _mm_loadu_ps(pRhsReal + i), bi = _mm_loadu_ps(pRhsImag + i);
+				_mm_storeu_ps(pReal + i, _mm_sub_ps(_mm_mul_ps(ar, br), _mm_mul_ps(ai, bi)));
+				_mm_storeu_ps(pImag + i, _mm_add_ps(_mm_mul_ps(ar, bi), _mm_mul_ps(ai, br)));
+			}
+		}
+#elif defined(HEPH_SCB_NEON)
+		if constexpr (std::is_same<Tdata, double>::value)
+		{
+			for (; i + 2 <= size; i += 2)
+			{
+				const float64x2_t ar = vld1q_f64(pReal + i), ai = vld1q_f64(pImag + i);
+				const float64x2_t br = vld1q_f64(pRhsReal + i), bi = vld1q_f64(pRhsImag + i);
+				vst1q_f64(pReal + i, vsubq_f64(vmulq_f64(ar, br), vmulq_f64(ai, bi)));
+				vst1q_f64(pImag + i, vaddq_f64(vmulq_f64(ar, bi), vmulq_f64(ai, br)));
+			}
+		}
+		else
+		{
+			for (; i + 4 <= size; i += 4)
+			{
+				const float32x4_t ar = vld1q_f32(pReal + i), ai = vld1q_f32(pImag + i);
+				const float32x4_t br = vld1q_f32(pRhsReal + i), bi = vld1q_f32(pRhsImag + i);
+				vst1q_f32(pReal + i, vsubq_f32(vmulq_f32(ar, br), vmulq_f32(ai, bi)));
+				vst1q_f32(pImag + i, vaddq_f32(vmulq_f32(ar, bi), vmulq_f32(ai, br)));
+			}
+		}
+#endif
+		return i;
+	}
+
+	template<typename Tdata>
+	static size_t MultiplyAccumulateKernel(Tdata* pReal, Tdata* pImag, const Tdata* pLhsReal, const Tdata* pLhsImag, const Tdata* pRhsReal, const Tdata* pRhsImag, size_t size)
+	{
+		size_t i = 0;
+#if defined(HEPH_SCB_SSE2)
+		if constexpr (std::is_same<Tdata, double>::value)
+		{
+			for (; i + 2 <= size; i += 2)
+			{
+				const __m128d ar = _mm_loadu_pd(pLhsReal + i), ai = _mm_loadu_pd(pLhsImag + i);
+				const __m128d br = _mm_loadu_pd(pRhsReal + i), bi = _mm_loadu_pd(pRhsImag + i);
+				_mm_storeu_pd(pReal + i, _mm_add_pd(_mm_loadu_pd(pReal + i), _mm_sub_pd(_mm_mul_pd(ar, br), _mm_mul_pd(ai, bi))));
+				_mm_storeu_pd(pImag + i, _mm_add_pd(_mm_loadu_pd(pImag + i), _mm_add_pd(_mm_mul_pd(ar, bi), _mm_mul_pd(ai, br))));
+			}
+		}
+		else
+		{
+			for (; i + 4 <= size; i += 4)
+			{
+				const __m128 ar = _mm_loadu_ps(pLhsReal + i), ai = _mm_loadu_ps(pLhsImag + i);
+				const __m128 br = _mm_loadu_ps(pRhsReal + i), bi = _mm_loadu_ps(pRhsImag + i);
+				_mm_storeu_ps(pReal + i, _mm_add_ps(_mm_loadu_ps(pReal + i), _mm_sub_ps(_mm_mul_ps(ar, br), _mm_mul_ps(ai, bi))));
+				_mm_storeu_ps(pImag + i, _mm_add_ps(_mm_loadu_ps(pImag + i), _mm_add_ps(_mm_mul_ps(ar, bi), _mm_mul_ps(ai, br))));
+			}
+		}
+#elif defined(HEPH_SCB_NEON)
+		if constexpr (std::is_same<Tdata, double>::value)
+		{
+			for (; i + 2 <= size; i += 2)
+			{
+				const float64x2_t ar = vld1q_f64(pLhsReal + i), ai = vld1q_f64(pLhsImag + i);
+				const float64x2_t br = vld1q_f64(pRhsReal + i), bi = vld1q_f64(pRhsImag + i);
+				vst1q_f64(pReal + i, vaddq_f64(vld1q_f64(pReal + i), vsubq_f64(vmulq_f64(ar, br), vmulq_f64(ai, bi))));
+				vst1q_f64(pImag + i, vaddq_f64(vld1q_f64(pImag + i), vaddq_f64(vmulq_f64(ar, bi), vmulq_f64(ai, br))));
+			}
+		}
+		else
+		{
+			for (; i + 4 <= size; i += 4)
+			{
+				const float32x4_t ar = vld1q_f32(pLhsReal + i), ai = vld1q_f32(pLhsImag + i);
+				const float32x4_t br = vld1q_f32(pRhsReal + i), bi = vld1q_f32(pRhsImag + i);
+				vst1q_f32(pReal + i, vaddq_f32(vld1q_f32(pReal + i), vsubq_f32(vmulq_f32(ar, br), vmulq_f32(ai, bi))));
+				vst1q_f32(pImag + i, vaddq_f32(vld1q_f32(pImag + i), vaddq_f32(vmulq_f32(ar, bi), vmulq_f32(ai, br))));
+			}
+		}
+#endif
+		return i;
+	}
+
+	template<typename Tdata>
+	static size_t MagnitudeKernel(const Tdata* pReal, const Tdata* pImag, Tdata* pOutput, size_t size)
+	{
+		size_t i = 0;
+#if defined(HEPH_SCB_SSE2)
+		if constexpr (std::is_same<Tdata, double>::value)
+		{
+			for (; i + 2 <= size; i += 2)
+			{
+				const __m128d r = _mm_loadu_pd(pReal + i), im = _mm_loadu_pd(pImag + i);
+				_mm_storeu_pd(pOutput + i, _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(r, r), _mm_mul_pd(im, im))));
+			}
+		}
+		else
+		{
+			for (; i + 4 <= size; i += 4)
+			{
+				const __m128 r = _mm_loadu_ps(pReal + i), im = _mm_loadu_ps(pImag + i);
+				_mm_storeu_ps(pOutput + i, _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(r, r), _mm_mul_ps(im, im))));
+			}
+		}
+#elif defined(HEPH_SCB_NEON)
+		if constexpr (std::is_same<Tdata, double>::value)
+		{
+			for (; i + 2 <= size; i += 2)
+			{
+				const float64x2_t r = vld1q_f64(pReal + i), im = vld1q_f64(pImag + i);
+				vst1q_f64(pOutput + i, vsqrtq_f64(vaddq_f64(vmulq_f64(r, r), vmulq_f64(im, im))));
+			}
+		}
+		else
+		{
+			for (; i + 4 <= size; i += 4)
+			{
+				const float32x4_t r = vld1q_f32(pReal + i), im = vld1q_f32(pImag + i);
+				vst1q_f32(pOutput + i, vsqrtq_f32(vaddq_f32(vmulq_f32(r, r), vmulq_f32(im, im))));
+			}
+		}
+#endif
+		return i;
+	}
+
+	template<typename Tdata>
+	BasicSplitComplexBuffer<Tdata>::BasicSplitComplexBuffer() : pData(nullptr), size(0) {}
+
+	template<typename Tdata>
+	BasicSplitComplexBuffer<Tdata>::BasicSplitComplexBuffer(size_t size) : BasicSplitComplexBuffer(size, BufferFlags::None) {}
+
+	template<typename Tdata>
+	BasicSplitComplexBuffer<Tdata>::BasicSplitComplexBuffer(size_t size, BufferFlags flags) : pData(nullptr), size(size)
+	{
+		if (this->size > 0)
+		{
+			this->pData = BasicSplitComplexBuffer::Allocate(this->size);
+			if (!(flags & BufferFlags::AllocUninitialized))
+			{
+				this->Reset();
+			}
+		}
+	}
+
+	template<typename Tdata>
+	BasicSplitComplexBuffer<Tdata>::BasicSplitComplexBuffer(const ComplexBuffer& rhs) : BasicSplitComplexBuffer(rhs.Size(), BufferFlags::AllocUninitialized)
+	{
+		Tdata* pReal = this->Real();
+		Tdata* pImag = this->Imag();
+		for (size_t i = 0; i < this->size; ++i)
+		{
+			pReal[i] = rhs[i].real;
+			pImag[i] = rhs[i].imag;
+		}
+	}
+
+	template<typename Tdata>
+	BasicSplitComplexBuffer<Tdata>::BasicSplitComplexBuffer(const BasicSplitComplexBuffer& rhs) : BasicSplitComplexBuffer(rhs.size, BufferFlags::AllocUninitialized)
+	{
+		if (this->size > 0)
+		{
+			(void)std::memcpy(this->pData, rhs.pData, this->size * 2 * sizeof(Tdata));
+		}
+	}
+
+	template<typename Tdata>
+	BasicSplitComplexBuffer<Tdata>::BasicSplitComplexBuffer(BasicSplitComplexBuffer&& rhs) noexcept : pData(rhs.pData), size(rhs.size)
+	{
+		rhs.pData = nullptr;
+		rhs.size = 0;
+	}
+
+	template<typename Tdata>
+	BasicSplitComplexBuffer<Tdata>::~BasicSplitComplexBuffer()
+	{
+		this->Release();
+	}
+
+	template<typename Tdata>
+	BasicSplitComplexBuffer<Tdata>& BasicSplitComplexBuffer<Tdata>::operator=(const BasicSplitComplexBuffer& rhs)
+	{
+		if (this != &rhs)
+		{
+			if (this->size != rhs.size)
+			{
+				this->Release();
+				if (rhs.size > 0)
+				{
+					this->pData = BasicSplitComplexBuffer::Allocate(rhs.size);
+					this->size = rhs.size;
+				}
+			}
+
+			if (this->size > 0)
+			{
+				(void)std::memcpy(this->pData, rhs.pData, this->size * 2 * sizeof(Tdata));
+			}
+		}
+		return *this;
+	}
+
+	template<typename Tdata>
+	BasicSplitComplexBuffer<Tdata>& BasicSplitComplexBuffer<Tdata>::operator=(BasicSplitComplexBuffer&& rhs) noexcept
+	{
+		if (this != &rhs)
+		{
+			this->Release();
+
+			this->pData = rhs.pData;
+			this->size = rhs.size;
+
+			rhs.pData = nullptr;
+			rhs.size = 0;
+		}
+		return *this;
+	}
+
+	template<typename Tdata>
+	bool BasicSplitComplexBuffer<Tdata>::operator==(const BasicSplitComplexBuffer& rhs) const
+	{
+		return this->size == rhs.size && (this->size == 0 || std::memcmp(this->pData, rhs.pData, this->size * 2 * sizeof(Tdata)) == 0);
+	}
+
+	template<typename Tdata>
+	bool BasicSplitComplexBuffer<Tdata>::operator!=(const BasicSplitComplexBuffer& rhs) const
+	{
+		return !((*this) == rhs);
+	}
+
+	template<typename Tdata>
+	size_t BasicSplitComplexBuffer<Tdata>::Size() const
+	{
+		return this->size;
+	}
+
+	template<typename Tdata>
+	bool BasicSplitComplexBuffer<Tdata>::IsEmpty() const
+	{
+		return this->size == 0;
+	}
+
+	template<typename Tdata>
+	Tdata* BasicSplitComplexBuffer<Tdata>::Real() const
+	{
+		return this->pData;
+	}
+
+	template<typename Tdata>
+	Tdata* BasicSplitComplexBuffer<Tdata>::Imag() const
+	{
+		return this->pData + this->size;
+	}
+
+	template<typename Tdata>
+	Complex BasicSplitComplexBuffer<Tdata>::Get(size_t index) const
+	{
+		if (index >= this->size)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "index out of bounds."));
+		}
+		return Complex(this->Real()[index], this->Imag()[index]);
+	}
+
+	template<typename Tdata>
+	void BasicSplitComplexBuffer<Tdata>::Set(size_t index, const Complex& value)
+	{
+		if (index >= this->size)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "index out of bounds."));
+		}
+		this->Real()[index] = (Tdata)value.real;
+		this->Imag()[index] = (Tdata)value.imag;
+	}
+
+	template<typename Tdata>
+	void BasicSplitComplexBuffer<Tdata>::Reset()
+	{
+		if (this->size > 0)
+		{
+			(void)std::memset(this->pData, 0, this->size * 2 * sizeof(Tdata));
+		}
+	}
+
+	template<typename Tdata>
+	void BasicSplitComplexBuffer<Tdata>::Release()
+	{
+		if (this->pData != nullptr)
+		{
+			std::free(this->pData);
+			this->pData = nullptr;
+		}
+		this->size = 0;
+	}
+
+	template<typename Tdata>
+	void BasicSplitComplexBuffer<Tdata>::Resize(size_t newSize)
+	{
+		if (newSize == this->size)
+		{
+			return;
+		}
+
+		if (newSize == 0)
+		{
+			this->Release();
+			return;
+		}
+
+		BasicSplitComplexBuffer resized(newSize);
+		const size_t copySize = HEPH_MATH_MIN(newSize, this->size);
+		if (copySize > 0)
+		{
+			(void)std::memcpy(resized.Real(), this->Real(), copySize * sizeof(Tdata));
+			(void)std::memcpy(resized.Imag(), this->Imag(), copySize * sizeof(Tdata));
+		}
+		(*this) = std::move(resized);
+	}
+
+	template<typename Tdata>
+	ComplexBuffer BasicSplitComplexBuffer<Tdata>::ToComplexBuffer() const
+	{
+		ComplexBuffer result(this->size, BufferFlags::AllocUninitialized);
+		const Tdata* pReal = this->Real();
+		const Tdata* pImag = this->Imag();
+		for (size_t i = 0; i < this->size; ++i)
+		{
+			result[i] = Complex(pReal[i], pImag[i]);
+		}
+		return result;
+	}
+
+	template<typename Tdata>
+	void BasicSplitComplexBuffer<Tdata>::Multiply(const BasicSplitComplexBuffer& rhs)
+	{
+		if (rhs.size != this->size)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "buffers must have the same size."));
+		}
+
+		Tdata* pReal = this->Real();
+		Tdata* pImag = this->Imag();
+		const Tdata* pRhsReal = rhs.Real();
+		const Tdata* pRhsImag = rhs.Imag();
+
+		size_t i = MultiplyKernel(pReal, pImag, pRhsReal, pRhsImag, this->size);
+		for (; i < this->size; ++i)
+		{
+			const Tdata real = pReal[i] * pRhsReal[i] - pImag[i] * pRhsImag[i];
+			pImag[i] = pReal[i] * pRhsImag[i] + pImag[i] * pRhsReal[i];
+			pReal[i] = real;
+		}
+	}
+
+	template<typename Tdata>
+	void BasicSplitComplexBuffer<Tdata>::MultiplyAccumulate(const BasicSplitComplexBuffer& lhs, const BasicSplitComplexBuffer& rhs)
+	{
+		if (lhs.size != this->size || rhs.size != this->size)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, InvalidArgumentException(HEPH_FUNC, "buffers must have the same size."));
+		}
+
+		Tdata* pReal = this->Real();
+		Tdata* pImag = this->Imag();
+		const Tdata* pLhsReal = lhs.Real();
+		const Tdata* pLhsImag = lhs.Imag();
+		const Tdata* pRhsReal = rhs.Real();
+		const Tdata* pRhsImag = rhs.Imag();
+
+		size_t i = MultiplyAccumulateKernel(pReal, pImag, pLhsReal, pLhsImag, pRhsReal, pRhsImag, this->size);
+		for (; i < this->size; ++i)
+		{
+			pReal[i] += pLhsReal[i] * pRhsReal[i] - pLhsImag[i] * pRhsImag[i];
+			pImag[i] += pLhsReal[i] * pRhsImag[i] + pLhsImag[i] * pRhsReal[i];
+		}
+	}
+
+	template<typename Tdata>
+	void BasicSplitComplexBuffer<Tdata>::Scale(Tdata factor)
+	{
+		// both arrays are contiguous, so a single loop that the compiler can vectorize.
+		const size_t size = this->size * 2;
+		for (size_t i = 0; i < size; ++i)
+		{
+			this->pData[i] *= factor;
+		}
+	}
+
+	template<typename Tdata>
+	void BasicSplitComplexBuffer<Tdata>::Conjugate()
+	{
+		Tdata* pImag = this->Imag();
+		for (size_t i = 0; i < this->size; ++i)
+		{
+			pImag[i] = -pImag[i];
+		}
+	}
+
+	template<typename Tdata>
+	void BasicSplitComplexBuffer<Tdata>::Magnitude(Tdata* pOutput) const
+	{
+		const Tdata* pReal = this->Real();
+		const Tdata* pImag = this->Imag();
+
+		size_t i = MagnitudeKernel(pReal, pImag, pOutput, this->size);
+		for (; i < this->size; ++i)
+		{
+			pOutput[i] = std::sqrt(pReal[i] * pReal[i] + pImag[i] * pImag[i]);
+		}
+	}
+
+	template<typename Tdata>
+	void BasicSplitComplexBuffer<Tdata>::Phase(Tdata* pOutput) const
+	{
+		const Tdata* pReal = this->Real();
+		const Tdata* pImag = this->Imag();
+		for (size_t i = 0; i < this->size; ++i)
+		{
+			pOutput[i] = std::atan2(pImag[i], pReal[i]);
+		}
+	}
+
+	template<typename Tdata>
+	Tdata* BasicSplitComplexBuffer<Tdata>::Allocate(size_t size)
+	{
+		Tdata* pData = (Tdata*)std::malloc(size * 2 * sizeof(Tdata));
+		if (pData == nullptr)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(nullptr, InsufficientMemoryException(HEPH_FUNC, "Insufficient memory"));
+		}
+		return pData;
+	}
+
+	template class HEPH_API BasicSplitComplexBuffer<float>;
+	template class HEPH_API BasicSplitComplexBuffer<double>;
+}
\ No newline at end of file
@@ -1,57 +1,167 @@
 #include "ConsoleLogger.h"
+#include "Exceptions/ExternalException.h"
 #include <stdio.h>
+#include <cstring>
+#include <cerrno>
 #include <chrono>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
 #if defined(__ANDROID__)
 #include <android/log.h>
 #endif
 
+#define HEPH_CL_WRITER_POLL_PERIOD_MS 5
+
 namespace Heph
 {
-	void ConsoleLogger::Log(const std::string& message, const char* logLevel)
+	struct LogRecord
 	{
-		ConsoleLogger::Log(message, logLevel, "HephLibs");
-	}
-	void ConsoleLogger::Log(const std::string& message, const char* logLevel, const std::string& libName)
+		time_t logTime;
+		char logLevel[8];
+		char libName[HEPH_CL_MAX_LIB_NAME_LENGTH + 1];
+		char message[HEPH_CL_MAX_MESSAGE_LENGTH + 1];
+	};
+
+	struct LogCell
 	{
-#if defined(__ANDROID__)
+		std::atomic<size_t> sequence;
+		LogRecord record;
+	};
 
-		if (strcmp(logLevel, HEPH_CL_INFO) == 0)
-		{
-			__android_log_print(ANDROID_LOG_INFO, libName.c_str(), "%s", message.c_str());
-		}
-		else if (strcmp(logLevel, HEPH_CL_WARNING) == 0)
-		{
-			__android_log_print(ANDROID_LOG_WARN, libName.c_str(), "%s", message.c_str());
-		}
-		else if (strcmp(logLevel, HEPH_CL_ERROR) == 0)
+	// bounded multi-producer queue, each cell's sequence tells whether it's free for the producers or ready for the writer.
+	static std::unique_ptr<LogCell[]> pQueue;
+	static size_t queueMask = 0;
+	static std::atomic<size_t> enqueuePosition(0);
+	static std::atomic<size_t> dequeuePosition(0);
+
+	static std::atomic<bool> asyncLoggingEnabled(false);
+	static std::atomic<bool> writerRunning(false);
+	static std::atomic<size_t> activeProducerCount(0);
+	static std::atomic<uint64_t> droppedMessageCount(0);
+	static std::atomic<uint32_t> repeatSuppressionInterval_ms(1000);
+	static std::thread writerThread;
+	static std::mutex controlMutex;
+	static std::mutex outputMutex;
+	static FILE* logFile = nullptr;
+
+	static void CopyString(char* pDestination, const char* pSource, size_t maxLength)
+	{
+		size_t i = 0;
+		for (; i < maxLength && pSource[i] != '\0'; ++i)
 		{
-			__android_log_print(ANDROID_LOG_ERROR, libName.c_str(), "%s", message.c_str());
+			pDestination[i] = pSource[i];
 		}
-		else if (strcmp(logLevel, HEPH_CL_SUCCESS) == 0)
+		pDestination[i] = '\0';
+
+		if (pSource[i] != '\0' && maxLength >= 3)
 		{
-			__android_log_print(ANDROID_LOG_VERBOSE, libName.c_str(), "%s", message.c_str());
+			pDestination[maxLength - 1] = '.';
+			pDestination[maxLength - 2] = '.';
+			pDestination[maxLength - 3] = '.';
 		}
-		else if (strcmp(logLevel, HEPH_CL_DEBUG) == 0)
+	}
+
+	static bool TryEnqueue(const char* message, const char* logLevel, const char* libName)
+	{
+		size_t position = enqueuePosition.load(std::memory_order_relaxed);
+		LogCell* pCell;
+
+		while (true)
 		{
-			__android_log_print(ANDROID_LOG_DEBUG, libName.c_str(), "%s", message.c_str());
+			pCell = &pQueue[position & queueMask];
+			const size_t sequence = pCell->sequence.load(std::memory_order_acquire);
+			const intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+
+			if (difference == 0)
+			{
+				if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else if (difference < 0)
+			{
+				return false; // full
+			}
+			else
+			{
+				position = enqueuePosition.load(std::memory_order_relaxed);
+			}
 		}
-		else
+
+		pCell->record.logTime = time(nullptr);
+		CopyString(pCell->record.logLevel, logLevel, sizeof(pCell->record.logLevel) - 1);
+		CopyString(pCell->record.libName, libName, HEPH_CL_MAX_LIB_NAME_LENGTH);
+		CopyString(pCell->record.message, message, HEPH_CL_MAX_MESSAGE_LENGTH);
+		pCell->sequence.store(position + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	// only called by the writer thread. Advancing the dequeue position is left to the caller so Flush can tell when the record is written.
+	static bool TryDequeue(LogRecord& record)
+	{
+		const size_t position = dequeuePosition.load(std::memory_order_relaxed);
+		LogCell* pCell = &pQueue[position & queueMask];
+
+		if (pCell->sequence.load(std::memory_order_acquire) != position + 1)
 		{
-			__android_log_print(ANDROID_LOG_DEFAULT, libName.c_str(), "%s", message.c_str());
+			return false;
 		}
 
-#else
+		record = pCell->record;
+		pCell->sequence.store(position + queueMask + 1, std::memory_order_release);
+		return true;
+	}
 
-		if (ConsoleLogger::coloredOutput)
+	static bool IsSameRecord(const LogRecord& lhs, const LogRecord& rhs)
+	{
+		return strcmp(lhs.message, rhs.message) == 0 && strcmp(lhs.logLevel, rhs.logLevel) == 0 && strcmp(lhs.libName, rhs.libName) == 0;
+	}
+
+	// stops the writer thread before the statics above are destroyed.
+	static struct AsyncLoggingGuard
+	{
+		~AsyncLoggingGuard()
 		{
-			printf("\x1b[%sm%s[%s]: \x1b[0m%s\n", logLevel, libName.c_str(), ConsoleLogger::CurrentTimeToString().c_str(), message.c_str());
+			ConsoleLogger::DisableAsyncLogging();
+			ConsoleLogger::CloseLogFile();
 		}
-		else
+	} asyncLoggingGuard;
+
+	void ConsoleLogger::Log(const std::string& message, const char* logLevel)
+	{
+		ConsoleLogger::Log(message, logLevel, "HephLibs");
+	}
+	void ConsoleLogger::Log(const std::string& message, const char* logLevel, const std::string& libName)
+	{
+		ConsoleLogger::Log(message.c_str(), logLevel, libName.c_str());
+	}
+	void ConsoleLogger::Log(const char* message, const char* logLevel)
+	{
+		ConsoleLogger::Log(message, logLevel, "HephLibs");
+	}
+	void ConsoleLogger::Log(const char* message, const char* logLevel, const char* libName)
+	{
+		if (asyncLoggingEnabled.load(std::memory_order_acquire))
 		{
-			printf("%s[%s][%s]: %s\n", libName.c_str(), ConsoleLogger::CurrentTimeToString().c_str(), ConsoleLogger::GetLogLevelName(logLevel).c_str(), message.c_str());
+			activeProducerCount.fetch_add(1, std::memory_order_acq_rel);
+			if (asyncLoggingEnabled.load(std::memory_order_acquire))
+			{
+				if (!TryEnqueue(message, logLevel, libName))
+				{
+					droppedMessageCount.fetch_add(1, std::memory_order_relaxed);
+				}
+				activeProducerCount.fetch_sub(1, std::memory_order_release);
+				return;
+			}
+			activeProducerCount.fetch_sub(1, std::memory_order_release);
 		}
 
-#endif
+		std::lock_guard<std::mutex> lockGuard(outputMutex);
+		ConsoleLogger::Write(message, logLevel, libName, time(nullptr));
 	}
 	void ConsoleLogger::LogInfo(const std::string& message)
 	{
@@ -101,14 +211,267 @@ namespace Heph
 	{
 		ConsoleLogger::coloredOutput = false;
 	}
+	void ConsoleLogger::EnableAsyncLogging()
+	{
+		ConsoleLogger::EnableAsyncLogging(HEPH_CL_DEFAULT_QUEUE_CAPACITY);
+	}
+	void ConsoleLogger::EnableAsyncLogging(size_t queueCapacity)
+	{
+		std::lock_guard<std::mutex> lockGuard(controlMutex);
+		if (asyncLoggingEnabled.load(std::memory_order_relaxed))
+		{
+			return;
+		}
+
+		size_t capacity = 2;
+		while (capacity < queueCapacity)
+		{
+			capacity <<= 1;
+		}
+
+		if (capacity != queueMask + 1 || pQueue == nullptr)
+		{
+			pQueue.reset(new LogCell[capacity]);
+			queueMask = capacity - 1;
+		}
+
+		for (size_t i = 0; i < capacity; ++i)
+		{
+			pQueue[i].sequence.store(i, std::memory_order_relaxed);
+		}
+		enqueuePosition.store(0, std::memory_order_relaxed);
+		dequeuePosition.store(0, std::memory_order_relaxed);
+
+		writerRunning.store(true, std::memory_order_relaxed);
+		writerThread = std::thread(&ConsoleLogger::WriterThreadProc);
+		asyncLoggingEnabled.store(true, std::memory_order_release);
+	}
+	void ConsoleLogger::DisableAsyncLogging()
+	{
+		std::lock_guard<std::mutex> lockGuard(controlMutex);
+		if (!asyncLoggingEnabled.load(std::memory_order_relaxed))
+		{
+			return;
+		}
+
+		asyncLoggingEnabled.store(false, std::memory_order_release);
+		while (activeProducerCount.load(std::memory_order_acquire) > 0)
+		{
+			std::this_thread::yield();
+		}
+
+		// the writer drains the queue before exiting.
+		writerRunning.store(false, std::memory_order_release);
+		if (writerThread.joinable())
+		{
+			writerThread.join();
+		}
+	}
+	bool ConsoleLogger::IsAsyncLoggingEnabled()
+	{
+		return asyncLoggingEnabled.load(std::memory_order_acquire);
+	}
+	void ConsoleLogger::Flush()
+	{
+		if (asyncLoggingEnabled.load(std::memory_order_acquire))
+		{
+			const size_t targetPosition = enqueuePosition.load(std::memory_order_acquire);
+			while (asyncLoggingEnabled.load(std::memory_order_acquire) && (intptr_t)(dequeuePosition.load(std::memory_order_acquire) - targetPosition) < 0)
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+		}
+
+		std::lock_guard<std::mutex> lockGuard(outputMutex);
+		fflush(stdout);
+		if (logFile != nullptr)
+		{
+			fflush(logFile);
+		}
+	}
+	uint64_t ConsoleLogger::GetDroppedMessageCount()
+	{
+		return droppedMessageCount.load(std::memory_order_relaxed);
+	}
+	uint32_t ConsoleLogger::GetRepeatSuppressionInterval()
+	{
+		return repeatSuppressionInterval_ms.load(std::memory_order_relaxed);
+	}
+	void ConsoleLogger::SetRepeatSuppressionInterval(uint32_t interval_ms)
+	{
+		repeatSuppressionInterval_ms.store(interval_ms, std::memory_order_relaxed);
+	}
+	void ConsoleLogger::SetLogFile(const std::filesystem::path& filePath)
+	{
+		FILE* pFile = fopen(filePath.string().c_str(), "a");
+		if (pFile == nullptr)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(nullptr, ExternalException(HEPH_FUNC, "Failed to open the log file.", "C Runtime", strerror(errno)));
+		}
+
+		std::lock_guard<std::mutex> lockGuard(outputMutex);
+		if (logFile != nullptr)
+		{
+			fclose(logFile);
+		}
+		logFile = pFile;
+	}
+	void ConsoleLogger::CloseLogFile()
+	{
+		std::lock_guard<std::mutex> lockGuard(outputMutex);
+		if (logFile != nullptr)
+		{
+			fclose(logFile);
+			logFile = nullptr;
+		}
+	}
+	void ConsoleLogger::Write(const char* message, const char* logLevel, const char* libName, time_t logTime)
+	{
+#if defined(__ANDROID__)
+
+		if (strcmp(logLevel, HEPH_CL_INFO) == 0)
+		{
+			__android_log_print(ANDROID_LOG_INFO, libName, "%s", message);
+		}
+		else if (strcmp(logLevel, HEPH_CL_WARNING) == 0)
+		{
+			__android_log_print(ANDROID_LOG_WARN, libName, "%s", message);
+		}
+		else if (strcmp(logLevel, HEPH_CL_ERROR) == 0)
+		{
+			__android_log_print(ANDROID_LOG_ERROR, libName, "%s", message);
+		}
+		else if (strcmp(logLevel, HEPH_CL_SUCCESS) == 0)
+		{
+			__android_log_print(ANDROID_LOG_VERBOSE, libName, "%s", message);
+		}
+		else if (strcmp(logLevel, HEPH_CL_DEBUG) == 0)
+		{
+			__android_log_print(ANDROID_LOG_DEBUG, libName, "%s", message);
+		}
+		else
+		{
+			__android_log_print(ANDROID_LOG_DEFAULT, libName, "%s", message);
+		}
+
+#else
+
+		const std::string timeString = ConsoleLogger::TimeToString(logTime);
+		if (ConsoleLogger::coloredOutput)
+		{
+			printf("\x1b[%sm%s[%s]: \x1b[0m%s\n", logLevel, libName, timeString.c_str(), message);
+		}
+		else
+		{
+			printf("%s[%s][%s]: %s\n", libName, timeString.c_str(), ConsoleLogger::GetLogLevelName(logLevel).c_str(), message);
+		}
+
+#endif
+
+		if (logFile != nullptr)
+		{
+			fprintf(logFile, "%s[%s][%s]: %s\n", libName, ConsoleLogger::TimeToString(logTime).c_str(), ConsoleLogger::GetLogLevelName(logLevel).c_str(), message);
+		}
+	}
+	void ConsoleLogger::WriterThreadProc()
+	{
+		LogRecord record;
+		LogRecord lastRecord;
+		uint64_t repeatCount = 0;
+		uint64_t reportedDropCount = droppedMessageCount.load(std::memory_order_relaxed);
+		bool hasLastRecord = false;
+		std::chrono::steady_clock::time_point lastWriteTime;
+
+		auto writeRepeatCount = [&]()
+			{
+				if (repeatCount > 0)
+				{
+					char repeatMessage[64];
+					snprintf(repeatMessage, sizeof(repeatMessage), "last message repeated %llu times.", (unsigned long long)repeatCount);
+					ConsoleLogger::Write(repeatMessage, lastRecord.logLevel, lastRecord.libName, time(nullptr));
+					repeatCount = 0;
+				}
+			};
+
+		while (true)
+		{
+			// read the flag before draining so no message pushed before the stop request is lost.
+			const bool running = writerRunning.load(std::memory_order_acquire);
+			bool wroteRecord = false;
+
+			while (TryDequeue(record))
+			{
+				const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+				const std::chrono::milliseconds interval(repeatSuppressionInterval_ms.load(std::memory_order_relaxed));
+				const bool isRepeat = hasLastRecord && interval.count() > 0 && IsSameRecord(record, lastRecord);
+
+				std::lock_guard<std::mutex> lockGuard(outputMutex);
+				if (isRepeat && (now - lastWriteTime) < interval)
+				{
+					repeatCount++;
+				}
+				else
+				{
+					writeRepeatCount();
+					ConsoleLogger::Write(record.message, record.logLevel, record.libName, record.logTime);
+					lastRecord = record;
+					hasLastRecord = true;
+					lastWriteTime = now;
+				}
+
+				dequeuePosition.fetch_add(1, std::memory_order_release);
+				wroteRecord = true;
+			}
+
+			{
+				std::lock_guard<std::mutex> lockGuard(outputMutex);
+
+				const uint64_t dropCount = droppedMessageCount.load(std::memory_order_relaxed);
+				if (dropCount != reportedDropCount)
+				{
+					char dropMessage[64];
+					snprintf(dropMessage, sizeof(dropMessage), "%llu messages were dropped, the log queue was full.", (unsigned long long)(dropCount - reportedDropCount));
+					ConsoleLogger::Write(dropMessage, HEPH_CL_WARNING, "HephLibs", time(nullptr));
+					reportedDropCount = dropCount;
+				}
+
+				const std::chrono::milliseconds interval(repeatSuppressionInterval_ms.load(std::memory_order_relaxed));
+				if (repeatCount > 0 && (!running || (std::chrono::steady_clock::now() - lastWriteTime) >= interval))
+				{
+					writeRepeatCount();
+					lastWriteTime = std::chrono::steady_clock::now();
+				}
+
+				if (wroteRecord)
+				{
+					fflush(stdout);
+					if (logFile != nullptr)
+					{
+						fflush(logFile);
+					}
+				}
+			}
+
+			if (!running)
+			{
+				break;
+			}
+
+			if (!wroteRecord)
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(HEPH_CL_WRITER_POLL_PERIOD_MS));
+			}
+		}
+	}
 	std::string ConsoleLogger::CurrentTimeToString()
+	{
+		return ConsoleLogger::TimeToString(time(nullptr));
+	}
+	std::string ConsoleLogger::TimeToString(time_t t)
 	{
 		constexpr uint8_t timeStringSize = 10;
 
-		time_t currentTime = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
-		time(&currentTime);
-
-		tm* localTime = localtime(&currentTime);
+		tm* localTime = localtime(&t);
 
 		char timeString[timeStringSize];
 		strftime(timeString, timeStringSize, "%T", localTime);
@@ -1,5 +1,6 @@
 #include "Fourier.h"
 #include "HephMath.h"
+#include <cstring>
 
 namespace Heph
 {
@@ -62,6 +63,48 @@ namespace Heph
 		}
 	}
 
+	void Fourier::FFT(SplitComplexBuffer& splitComplexBuffer)
+	{
+		Fourier::FFT(splitComplexBuffer, splitComplexBuffer.Size());
+	}
+
+	void Fourier::FFT(SplitComplexBuffer& splitComplexBuffer, size_t fftSize)
+	{
+		fftSize = Fourier::CalculateFFTSize(fftSize);
+		splitComplexBuffer.Resize(fftSize);
+		Fourier::FFT_Internal(splitComplexBuffer, fftSize, Fourier::DIRECTION_FORWARD);
+	}
+
+	void Fourier::FFT(SplitComplexFloatBuffer& splitComplexBuffer)
+	{
+		Fourier::FFT(splitComplexBuffer, splitComplexBuffer.Size());
+	}
+
+	void Fourier::FFT(SplitComplexFloatBuffer& splitComplexBuffer, size_t fftSize)
+	{
+		fftSize = Fourier::CalculateFFTSize(fftSize);
+		splitComplexBuffer.Resize(fftSize);
+		Fourier::FFT_Internal(splitComplexBuffer, fftSize, Fourier::DIRECTION_FORWARD);
+	}
+
+	void Fourier::IFFT(SplitComplexBuffer& splitComplexBuffer, bool scale)
+	{
+		Fourier::FFT_Internal(splitComplexBuffer, splitComplexBuffer.Size(), Fourier::DIRECTION_BACKWARD);
+		if (scale)
+		{
+			splitComplexBuffer.Scale(1.0 / splitComplexBuffer.Size());
+		}
+	}
+
+	void Fourier::IFFT(SplitComplexFloatBuffer& splitComplexBuffer, bool scale)
+	{
+		Fourier::FFT_Internal(splitComplexBuffer, splitComplexBuffer.Size(), Fourier::DIRECTION_BACKWARD);
+		if (scale)
+		{
+			splitComplexBuffer.Scale(1.0f / splitComplexBuffer.Size());
+		}
+	}
+
 	double Fourier::BinFrequencyToIndex(size_t sampleRate, size_t fftSize, double frequency)
 	{
 		return round(frequency * fftSize / sampleRate);
@@ -101,24 +144,17 @@ namespace Heph
 		size_t ySize = source.Size() + kernel.Size() - 1;
 		const size_t fftSize = Fourier::CalculateFFTSize(ySize);
 
-		ComplexBuffer tf(fftSize);
+		SplitComplexBuffer tf(fftSize);
 		{
-			ComplexBuffer tfKernel(fftSize);
+			SplitComplexBuffer tfKernel(fftSize);
 
-			for (size_t i = 0; i < source.Size(); i++)
-			{
-				tf[i].real = source[i];
-			}
-
-			for (size_t i = 0; i < kernel.Size(); i++)
-			{
-				tfKernel[i].real = kernel[i];
-			}
+			(void)std::memcpy(tf.Real(), source.begin(), source.Size() * sizeof(double));
+			(void)std::memcpy(tfKernel.Real(), kernel.begin(), kernel.Size() * sizeof(double));
 
 			Fourier::FFT(tf);
 			Fourier::FFT(tfKernel);
 
-			tf *= tfKernel;
+			tf.Multiply(tfKernel);
 		}
 
 		Fourier::IFFT(tf, false);
@@ -148,7 +184,7 @@ namespace Heph
 		DoubleBuffer result(ySize);
 		for (size_t i = iStart; i < iEnd; i++)
 		{
-			result[i - iStart] = tf[i].real / fftSize;
+			result[i - iStart] = tf.Real()[i] / fftSize;
 		}
 		return result;
 	}
@@ -193,6 +229,56 @@ namespace Heph
 				b *= a;
 			}
 
+			a.imag = sign * sqrt((1.0 - a.real) * 0.5);
+			a.real = sqrt((1.0 + a.real) * 0.5);
+		}
+	}
+	template<typename Tdata>
+	void Fourier::FFT_Internal(BasicSplitComplexBuffer<Tdata>& splitComplexBuffer, size_t fftSize, bool direction)
+	{
+		Tdata* pReal = splitComplexBuffer.Real();
+		Tdata* pImag = splitComplexBuffer.Imag();
+
+		size_t j = 0;
+		for (size_t i = 0; i < fftSize; ++i)
+		{
+			if (i < j)
+			{
+				std::swap(pReal[i], pReal[j]);
+				std::swap(pImag[i], pImag[j]);
+			}
+			j ^= fftSize - fftSize / ((i ^ (i + 1)) + 1);
+		}
+
+		// the twiddle factors are calculated in double precision regardless of Tdata.
+		Complex a, b;
+		size_t p, s1, s2, i;
+		int sign = (direction == Fourier::DIRECTION_FORWARD) ? (1) : (-1);
+
+		a.real = -1;
+
+		for (p = fftSize, s1 = 1, s2 = 2;
+			p > 1;
+			p >>= 1, s1 <<= 1, s2 <<= 1)
+		{
+			b = Complex(1, 0);
+
+			for (i = 0; i < s1; ++i)
+			{
+				const Tdata br = (Tdata)b.real;
+				const Tdata bi = (Tdata)b.imag;
+				for (j = i; j < fftSize; j += s2)
+				{
+					const Tdata tempReal = br * pReal[j + s1] - bi * pImag[j + s1];
+					const Tdata tempImag = br * pImag[j + s1] + bi * pReal[j + s1];
+					pReal[j + s1] = pReal[j] - tempReal;
+					pImag[j + s1] = pImag[j] - tempImag;
+					pReal[j] += tempReal;
+					pImag[j] += tempImag;
+				}
+				b *= a;
+			}
+
 			a.imag = sign * sqrt((1.0 - a.real) * 0.5);
 			a.real = sqrt((1.0 + a.real) * 0.5);
 		}
@@ -0,0 +1,192 @@
+#include "MemoryMappedFile.h"
+#include "Exceptions/ExternalException.h"
+#include "Exceptions/NotFoundException.h"
+#include <cerrno>
+#include <cstring>
+#if defined(_WIN32)
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Heph
+{
+#if defined(_WIN32)
+	MemoryMappedFile::MemoryMappedFile() : pData(nullptr), size(0), isOpen(false), hFile(INVALID_HANDLE_VALUE), hMapping(nullptr) {}
+#else
+	MemoryMappedFile::MemoryMappedFile() : pData(nullptr), size(0), isOpen(false) {}
+#endif
+
+	MemoryMappedFile::MemoryMappedFile(const std::filesystem::path& filePath) : MemoryMappedFile()
+	{
+		this->Open(filePath);
+	}
+
+	MemoryMappedFile::MemoryMappedFile(MemoryMappedFile&& rhs) noexcept : MemoryMappedFile()
+	{
+		*this = std::move(rhs);
+	}
+
+	MemoryMappedFile::~MemoryMappedFile()
+	{
+		this->Close();
+	}
+
+	MemoryMappedFile& MemoryMappedFile::operator=(MemoryMappedFile&& rhs) noexcept
+	{
+		if (this != &rhs)
+		{
+			this->Close();
+
+			this->pData = rhs.pData;
+			this->size = rhs.size;
+			this->isOpen = rhs.isOpen;
+			rhs.pData = nullptr;
+			rhs.size = 0;
+			rhs.isOpen = false;
+
+#if defined(_WIN32)
+			this->hFile = rhs.hFile;
+			this->hMapping = rhs.hMapping;
+			rhs.hFile = INVALID_HANDLE_VALUE;
+			rhs.hMapping = nullptr;
+#endif
+		}
+
+		return *this;
+	}
+
+	void MemoryMappedFile::Open(const std::filesystem::path& filePath)
+	{
+		this->Close();
+
+		if (!std::filesystem::exists(filePath))
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, NotFoundException(HEPH_FUNC, "File not found."));
+		}
+
+#if defined(_WIN32)
+
+		this->hFile = CreateFileW(filePath.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (this->hFile == INVALID_HANDLE_VALUE)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, ExternalException(HEPH_FUNC, "Failed to open the file.", "Win32", std::to_string(GetLastError())));
+		}
+
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(this->hFile, &fileSize))
+		{
+			const DWORD error = GetLastError();
+			this->Close();
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, ExternalException(HEPH_FUNC, "Failed to get the file size.", "Win32", std::to_string(error)));
+		}
+
+		this->size = (size_t)fileSize.QuadPart;
+		if (this->size > 0)
+		{
+			this->hMapping = CreateFileMappingW(this->hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (this->hMapping == nullptr)
+			{
+				const DWORD error = GetLastError();
+				this->Close();
+				HEPH_RAISE_AND_THROW_EXCEPTION(this, ExternalException(HEPH_FUNC, "Failed to create the file mapping.", "Win32", std::to_string(error)));
+			}
+
+			this->pData = (const uint8_t*)MapViewOfFile(this->hMapping, FILE_MAP_READ, 0, 0, 0);
+			if (this->pData == nullptr)
+			{
+				const DWORD error = GetLastError();
+				this->Close();
+				HEPH_RAISE_AND_THROW_EXCEPTION(this, ExternalException(HEPH_FUNC, "Failed to map the file.", "Win32", std::to_string(error)));
+			}
+		}
+
+#else
+
+		const int fd = open(filePath.string().c_str(), O_RDONLY);
+		if (fd < 0)
+		{
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, ExternalException(HEPH_FUNC, "Failed to open the file.", "C Runtime", strerror(errno)));
+		}
+
+		struct stat fileStat;
+		if (fstat(fd, &fileStat) != 0)
+		{
+			const int error = errno;
+			close(fd);
+			HEPH_RAISE_AND_THROW_EXCEPTION(this, ExternalException(HEPH_FUNC, "Failed to get the file size.", "C Runtime", strerror(error)));
+		}
+
+		this->size = (size_t)fileStat.st_size;
+		if (this->size > 0)
+		{
+			void* pMapping = mmap(nullptr, this->size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (pMapping == MAP_FAILED)
+			{
+				const int error = errno;
+				close(fd);
+				this->size = 0;
+				HEPH_RAISE_AND_THROW_EXCEPTION(this, ExternalException(HEPH_FUNC, "Failed to map the file.", "C Runtime", strerror(error)));
+			}
+			this->pData = (const uint8_t*)pMapping;
+		}
+
+		// the mapping keeps the file referenced.
+		close(fd);
+
+#endif
+
+		this->isOpen = true;
+	}
+
+	void MemoryMappedFile::Close()
+	{
+#if defined(_WIN32)
+
+		if (this->pData != nullptr)
+		{
+			UnmapViewOfFile(this->pData);
+		}
+		if (this->hMapping != nullptr)
+		{
+			CloseHandle(this->hMapping);
+			this->hMapping = nullptr;
+		}
+		if (this->hFile != INVALID_HANDLE_VALUE)
+		{
+			CloseHandle(this->hFile);
+			this->hFile = INVALID_HANDLE_VALUE;
+		}
+
+#else
+
+		if (this->pData != nullptr)
+		{
+			munmap((void*)this->pData, this->size);
+		}
+
+#endif
+
+		this->pData = nullptr;
+		this->size = 0;
+		this->isOpen = false;
+	}
+
+	bool MemoryMappedFile::IsOpen() const
+	{
+		return this->isOpen;
+	}
+
+	const uint8_t* MemoryMappedFile::Data() const
+	{
+		return this->pData;
+	}
+
+	size_t MemoryMappedFile::Size() const
+	{
+		return this->size;
+	}
+}
\ No newline at end of file
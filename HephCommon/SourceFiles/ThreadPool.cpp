@@ -0,0 +1,94 @@
+#include "ThreadPool.h"
+
+namespace Heph
+{
+	ThreadPool::ThreadPool(size_t maxThreadCount)
+		: maxThreadCount(maxThreadCount), idleThreadCount(0), isStopping(false)
+	{
+		if (this->maxThreadCount == 0)
+		{
+			this->maxThreadCount = std::thread::hardware_concurrency();
+			if (this->maxThreadCount == 0)
+			{
+				this->maxThreadCount = 1;
+			}
+		}
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		std::deque<std::function<void()>> discardedTasks;
+		{
+			std::lock_guard<std::mutex> lockGuard(this->mutex);
+			this->isStopping = true;
+			discardedTasks.swap(this->tasks);
+		}
+		this->taskCondition.notify_all();
+
+		for (std::thread& thread : this->threads)
+		{
+			thread.join();
+		}
+	}
+
+	void ThreadPool::Submit(std::function<void()> task)
+	{
+		{
+			std::lock_guard<std::mutex> lockGuard(this->mutex);
+			this->tasks.push_back(std::move(task));
+
+			if (this->idleThreadCount < this->tasks.size() && this->threads.size() < this->maxThreadCount)
+			{
+				this->threads.emplace_back(&ThreadPool::WorkerThread, this);
+			}
+		}
+		this->taskCondition.notify_one();
+	}
+
+	size_t ThreadPool::GetMaxThreadCount() const
+	{
+		return this->maxThreadCount;
+	}
+
+	size_t ThreadPool::GetThreadCount() const
+	{
+		std::lock_guard<std::mutex> lockGuard(this->mutex);
+		return this->threads.size();
+	}
+
+	size_t ThreadPool::GetPendingTaskCount() const
+	{
+		std::lock_guard<std::mutex> lockGuard(this->mutex);
+		return this->tasks.size();
+	}
+
+	void ThreadPool::WorkerThread()
+	{
+		std::unique_lock<std::mutex> lock(this->mutex);
+		while (true)
+		{
+			this->idleThreadCount++;
+			this->taskCondition.wait(lock, [this]() { return this->isStopping || !this->tasks.empty(); });
+			this->idleThreadCount--;
+
+			if (this->isStopping)
+			{
+				break;
+			}
+
+			std::function<void()> task = std::move(this->tasks.front());
+			this->tasks.pop_front();
+
+			lock.unlock();
+			try
+			{
+				task();
+			}
+			catch (...) {}
+
+			// destroy the captured state before taking the lock, it may run arbitrary code.
+			task = nullptr;
+			lock.lock();
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,144 @@
+#include "TimingStatistics.h"
+
+namespace Heph
+{
+	TimingStatisticsSnapshot::TimingStatisticsSnapshot()
+		: count(0), total_ns(0), min_ns(0), max_ns(0), last_ns(0), histogram{} {}
+
+	double TimingStatisticsSnapshot::GetMean_ns() const
+	{
+		return this->count > 0 ? ((double)this->total_ns / this->count) : 0.0;
+	}
+
+	uint64_t TimingStatisticsSnapshot::GetPercentile_ns(double percentile) const
+	{
+		uint64_t histogramCount = 0;
+		for (size_t i = 0; i < HEPH_TIMING_STATISTICS_BUCKET_COUNT; ++i)
+		{
+			histogramCount += this->histogram[i];
+		}
+
+		if (histogramCount == 0)
+		{
+			return 0;
+		}
+
+		const double target = histogramCount * (percentile < 0.0 ? 0.0 : (percentile > 100.0 ? 100.0 : percentile)) / 100.0;
+		uint64_t cumulativeCount = 0;
+		for (size_t i = 0; i < HEPH_TIMING_STATISTICS_BUCKET_COUNT; ++i)
+		{
+			cumulativeCount += this->histogram[i];
+			if (cumulativeCount > 0 && cumulativeCount >= target)
+			{
+				const uint64_t upperBound = TimingStatistics::GetBucketUpperBound_ns(i);
+				return upperBound < this->max_ns ? upperBound : this->max_ns;
+			}
+		}
+
+		return this->max_ns;
+	}
+
+	TimingStatistics::TimingStatistics()
+	{
+		this->Reset();
+	}
+
+	TimingStatistics::TimingStatistics(const TimingStatistics& rhs)
+	{
+		*this = rhs;
+	}
+
+	TimingStatistics& TimingStatistics::operator=(const TimingStatistics& rhs)
+	{
+		if (this != &rhs)
+		{
+			this->count.store(rhs.count.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			this->total_ns.store(rhs.total_ns.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			this->min_ns.store(rhs.min_ns.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			this->max_ns.store(rhs.max_ns.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			this->last_ns.store(rhs.last_ns.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			for (size_t i = 0; i < HEPH_TIMING_STATISTICS_BUCKET_COUNT; ++i)
+			{
+				this->histogram[i].store(rhs.histogram[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+			}
+		}
+
+		return *this;
+	}
+
+	void TimingStatistics::Record(uint64_t duration_ns)
+	{
+		this->total_ns.fetch_add(duration_ns, std::memory_order_relaxed);
+		this->last_ns.store(duration_ns, std::memory_order_relaxed);
+		this->histogram[TimingStatistics::GetBucketIndex(duration_ns)].fetch_add(1, std::memory_order_relaxed);
+
+		uint64_t currentMin = this->min_ns.load(std::memory_order_relaxed);
+		while (duration_ns < currentMin && !this->min_ns.compare_exchange_weak(currentMin, duration_ns, std::memory_order_relaxed));
+
+		uint64_t currentMax = this->max_ns.load(std::memory_order_relaxed);
+		while (duration_ns > currentMax && !this->max_ns.compare_exchange_weak(currentMax, duration_ns, std::memory_order_relaxed));
+
+		// release so a reader that sees the new count also sees the rest of the fields.
+		this->count.fetch_add(1, std::memory_order_release);
+	}
+
+	void TimingStatistics::Record(std::chrono::steady_clock::duration duration)
+	{
+		const int64_t duration_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+		this->Record(duration_ns > 0 ? (uint64_t)duration_ns : 0);
+	}
+
+	TimingStatisticsSnapshot TimingStatistics::GetSnapshot() const
+	{
+		TimingStatisticsSnapshot snapshot;
+
+		snapshot.count = this->count.load(std::memory_order_acquire);
+		snapshot.total_ns = this->total_ns.load(std::memory_order_relaxed);
+		snapshot.max_ns = this->max_ns.load(std::memory_order_relaxed);
+		snapshot.last_ns = this->last_ns.load(std::memory_order_relaxed);
+
+		const uint64_t minValue = this->min_ns.load(std::memory_order_relaxed);
+		snapshot.min_ns = minValue == UINT64_MAX ? 0 : minValue;
+
+		for (size_t i = 0; i < HEPH_TIMING_STATISTICS_BUCKET_COUNT; ++i)
+		{
+			snapshot.histogram[i] = this->histogram[i].load(std::memory_order_relaxed);
+		}
+
+		return snapshot;
+	}
+
+	void TimingStatistics::Reset()
+	{
+		this->count.store(0, std::memory_order_relaxed);
+		this->total_ns.store(0, std::memory_order_relaxed);
+		this->min_ns.store(UINT64_MAX, std::memory_order_relaxed);
+		this->max_ns.store(0, std::memory_order_relaxed);
+		this->last_ns.store(0, std::memory_order_relaxed);
+		for (size_t i = 0; i < HEPH_TIMING_STATISTICS_BUCKET_COUNT; ++i)
+		{
+			this->histogram[i].store(0, std::memory_order_relaxed);
+		}
+	}
+
+	size_t TimingStatistics::GetBucketIndex(uint64_t duration_ns)
+	{
+		uint64_t duration_us = duration_ns / 1000;
+		size_t bucketIndex = 0;
+		while (duration_us > 0 && bucketIndex < (HEPH_TIMING_STATISTICS_BUCKET_COUNT - 1))
+		{
+			duration_us >>= 1;
+			bucketIndex++;
+		}
+		return bucketIndex;
+	}
+
+	uint64_t TimingStatistics::GetBucketUpperBound_ns(size_t bucketIndex)
+	{
+		if (bucketIndex >= (HEPH_TIMING_STATISTICS_BUCKET_COUNT - 1))
+		{
+			return UINT64_MAX;
+		}
+		return (1ull << bucketIndex) * 1000;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,189 @@
+#include "benchmark/benchmark.h"
+#include "BenchmarkHelpers.h"
+#include "AudioBuffer.h"
+#include "AudioEffects/ArctanDistortion.h"
+#include "AudioEffects/BandCutFilter.h"
+#include "AudioEffects/BandPassFilter.h"
+#include "AudioEffects/Chorus.h"
+#include "AudioEffects/CubicDistortion.h"
+#include "AudioEffects/Echo.h"
+#include "AudioEffects/Equalizer.h"
+#include "AudioEffects/Flanger.h"
+#include "AudioEffects/HardClipDistortion.h"
+#include "AudioEffects/HighPassFilter.h"
+#include "AudioEffects/LinearFadeIn.h"
+#include "AudioEffects/LinearFadeOut.h"
+#include "AudioEffects/LinearPanning.h"
+#include "AudioEffects/LowPassFilter.h"
+#include "AudioEffects/Normalizer.h"
+#include "AudioEffects/Overdrive.h"
+#include "AudioEffects/PitchShifter.h"
+#include "AudioEffects/Resampler.h"
+#include "AudioEffects/RmsNormalizer.h"
+#include "AudioEffects/SineLawPanning.h"
+#include "AudioEffects/Spatializer.h"
+#include "AudioEffects/SquareLawPanning.h"
+#include "AudioEffects/TimeStretcher.h"
+#include "AudioEffects/Tremolo.h"
+#include "AudioEffects/Vibrato.h"
+#include "AudioEffects/Waveshaper.h"
+#include "Oscillators/SineWaveOscillator.h"
+#include "Windows/HannWindow.h"
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace Heph;
+using namespace HephAudio;
+
+#define BENCHMARK_SAMPLE_RATE 48000
+#define BENCHMARK_HOP_SIZE 256
+#define BENCHMARK_WINDOW_SIZE 1024
+
+typedef std::function<std::unique_ptr<AudioEffect>()> AudioEffectFactory;
+
+static AudioChannelLayout ChannelLayoutFromCount(size_t channelCount)
+{
+	switch (channelCount)
+	{
+	case 1:
+		return HEPHAUDIO_CH_LAYOUT_MONO;
+	case 6:
+		return HEPHAUDIO_CH_LAYOUT_5_POINT_1;
+	case 8:
+		return HEPHAUDIO_CH_LAYOUT_7_POINT_1;
+	default:
+		return HEPHAUDIO_CH_LAYOUT_STEREO;
+	}
+}
+
+static void BM_AudioEffect(benchmark::State& state, const AudioEffectFactory& factory)
+{
+	const size_t blockSize = state.range(0);
+	const size_t channelCount = state.range(1);
+	const size_t threadCount = state.range(2);
+
+	std::unique_ptr<AudioEffect> pEffect;
+	try
+	{
+		pEffect = factory();
+	}
+	catch (const std::exception& ex)
+	{
+		state.SkipWithError(ex.what());
+		return;
+	}
+	if (threadCount > 1)
+	{
+		pEffect->SetThreadCount(threadCount);
+	}
+
+	AudioBuffer input(blockSize, ChannelLayoutFromCount(channelCount), BENCHMARK_SAMPLE_RATE);
+	BenchmarkHelpers::FillNoise(input.begin(), input.end(), 0.5);
+	AudioBuffer buffer = input;
+
+	try
+	{
+		// warm-up, also rejects the unsupported formats (e.g. panning effects require stereo).
+		pEffect->Process(buffer);
+	}
+	catch (const std::exception& ex)
+	{
+		state.SkipWithError(ex.what());
+		return;
+	}
+
+	for (auto _ : state)
+	{
+		// some effects change the frame/channel count or replace the buffer, start from the same input every time.
+		// timed manually since pausing and resuming the timer each iteration costs more than processing the small blocks.
+		buffer = input;
+
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		pEffect->Process(buffer);
+		benchmark::DoNotOptimize(buffer.begin());
+		state.SetIterationTime(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+	}
+
+	BenchmarkHelpers::SetFrameCounters(state, blockSize);
+}
+
+static std::vector<std::pair<std::string, AudioEffectFactory>> GetAudioEffectFactories()
+{
+	const HannWindow wnd(BENCHMARK_WINDOW_SIZE);
+	const SineWaveOscillator lfo(1, 5, BENCHMARK_SAMPLE_RATE, 0);
+
+	return
+	{
+		{ "ArctanDistortion", []() { return std::make_unique<ArctanDistortion>(5.0); } },
+		{ "BandCutFilter", [wnd]() { return std::make_unique<BandCutFilter>(500.0, 2000.0, BENCHMARK_HOP_SIZE, wnd); } },
+		{ "BandPassFilter", [wnd]() { return std::make_unique<BandPassFilter>(500.0, 2000.0, BENCHMARK_HOP_SIZE, wnd); } },
+		{ "Chorus", [lfo]() { return std::make_unique<Chorus>(0.75, 5.0, 10.0, 1.0, lfo); } },
+		{ "CubicDistortion", []() { return std::make_unique<CubicDistortion>(2.0); } },
+		{ "Echo", []() { return std::make_unique<Echo>(3, 0.1, 0.5, 0.0, 0.5); } },
+		{ "Equalizer", [wnd]() { return std::make_unique<Equalizer>(BENCHMARK_HOP_SIZE, wnd, std::initializer_list<Equalizer::FrequencyRange>{ { 0.0, 200.0, 1.5 }, { 2000.0, 8000.0, 0.5 } }); } },
+		{ "Flanger", [lfo]() { return std::make_unique<Flanger>(0.75, 0.5, 2.0, lfo); } },
+		{ "HardClipDistortion", []() { return std::make_unique<HardClipDistortion>(-6.0); } },
+		{ "HighPassFilter", [wnd]() { return std::make_unique<HighPassFilter>(1000.0, BENCHMARK_HOP_SIZE, wnd); } },
+		{ "LinearFadeIn", []() { return std::make_unique<LinearFadeIn>(1.0); } },
+		{ "LinearFadeOut", []() { return std::make_unique<LinearFadeOut>(1.0); } },
+		{ "LinearPanning", []() { return std::make_unique<LinearPanning>(0.5); } },
+		{ "LowPassFilter", [wnd]() { return std::make_unique<LowPassFilter>(1000.0, BENCHMARK_HOP_SIZE, wnd); } },
+		{ "Normalizer", []() { return std::make_unique<Normalizer>(HEPH_AUDIO_SAMPLE_MAX, 0.5); } },
+		{ "Overdrive", []() { return std::make_unique<Overdrive>(10.0); } },
+		{ "Overdrive4x", []() { auto p = std::make_unique<Overdrive>(10.0); p->SetOversamplingFactor(4); return p; } },
+		{ "PitchShifter", [wnd]() { return std::make_unique<PitchShifter>(3.0, BENCHMARK_HOP_SIZE, wnd); } },
+		{ "Resampler", []() { return std::make_unique<Resampler>(44100); } },
+		{ "RmsNormalizer", []() { return std::make_unique<RmsNormalizer>(HEPH_AUDIO_SAMPLE_MAX / 4, 0.5); } },
+		{ "SineLawPanning", []() { return std::make_unique<SineLawPanning>(0.5); } },
+		{ "Spatializer", [wnd]()
+			{
+				auto p = std::make_unique<Spatializer>(45.0f, 0.0f, BENCHMARK_HOP_SIZE, wnd);
+				if (p->GetHrtfSize() == 0)
+				{
+					throw std::runtime_error("default SOFA file not found, run from the repository root.");
+				}
+				return p;
+			}
+		},
+		{ "SquareLawPanning", []() { return std::make_unique<SquareLawPanning>(0.5); } },
+		{ "TimeStretcher", [wnd]() { return std::make_unique<TimeStretcher>(1.25, BENCHMARK_HOP_SIZE, wnd); } },
+		{ "Tremolo", [lfo]() { return std::make_unique<Tremolo>(0.75, lfo); } },
+		{ "Vibrato", [lfo]() { return std::make_unique<Vibrato>(0.75, 0.5, lfo); } },
+		{ "Waveshaper", []() { return std::make_unique<Waveshaper>([](double x) { return x * (1.5 - 0.5 * x * x); }); } }
+	};
+}
+
+static bool RegisterAudioEffectBenchmarks()
+{
+	const int64_t maxThreadCount = std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() : 1;
+	std::vector<int64_t> threadCounts = { 1 };
+	for (int64_t t = 2; t <= maxThreadCount; t *= 2)
+	{
+		threadCounts.push_back(t);
+	}
+
+	for (const auto& [name, factory] : GetAudioEffectFactories())
+	{
+		bool hasMTSupport = false;
+		try
+		{
+			hasMTSupport = factory()->HasMTSupport();
+		}
+		catch (...) {}
+
+		benchmark::RegisterBenchmark(("BM_AudioEffect/" + name).c_str(), BM_AudioEffect, factory)
+			->ArgNames({ "block", "channels", "threads" })
+			->ArgsProduct({ { 256, 512, 1024, 4096 }, { 1, 2, 8 }, hasMTSupport ? threadCounts : std::vector<int64_t>{ 1 } })
+			->UseManualTime();
+	}
+
+	return true;
+}
+
+static const bool audioEffectBenchmarksRegistered = RegisterAudioEffectBenchmarks();
\ No newline at end of file
@@ -0,0 +1,37 @@
+#include "benchmark/benchmark.h"
+#include "BenchmarkHelpers.h"
+#include "AudioBuffer.h"
+#include "AudioEffects/ChannelMapper.h"
+#include <chrono>
+
+using namespace HephAudio;
+
+#define BENCHMARK_BLOCK_SIZE 1024
+
+static void BM_ChannelMapper(benchmark::State& state, AudioChannelLayout inputLayout, AudioChannelLayout targetLayout)
+{
+	ChannelMapper channelMapper(targetLayout);
+	AudioBuffer input(BENCHMARK_BLOCK_SIZE, inputLayout, 48000);
+	BenchmarkHelpers::FillNoise(input.begin(), input.end(), 0.5);
+	AudioBuffer buffer = input;
+
+	for (auto _ : state)
+	{
+		// the copy is not timed, pausing the timer instead would cost more than the mapping.
+		buffer = input;
+
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		channelMapper.Process(buffer);
+		benchmark::DoNotOptimize(buffer.begin());
+		state.SetIterationTime(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+	}
+
+	BenchmarkHelpers::SetFrameCounters(state, BENCHMARK_BLOCK_SIZE);
+}
+BENCHMARK_CAPTURE(BM_ChannelMapper, mono_to_stereo, HEPHAUDIO_CH_LAYOUT_MONO, HEPHAUDIO_CH_LAYOUT_STEREO)->UseManualTime();
+BENCHMARK_CAPTURE(BM_ChannelMapper, stereo_to_mono, HEPHAUDIO_CH_LAYOUT_STEREO, HEPHAUDIO_CH_LAYOUT_MONO)->UseManualTime();
+BENCHMARK_CAPTURE(BM_ChannelMapper, stereo_to_5_1, HEPHAUDIO_CH_LAYOUT_STEREO, HEPHAUDIO_CH_LAYOUT_5_POINT_1)->UseManualTime();
+BENCHMARK_CAPTURE(BM_ChannelMapper, 5_1_to_stereo, HEPHAUDIO_CH_LAYOUT_5_POINT_1, HEPHAUDIO_CH_LAYOUT_STEREO)->UseManualTime();
+BENCHMARK_CAPTURE(BM_ChannelMapper, 5_1_to_7_1, HEPHAUDIO_CH_LAYOUT_5_POINT_1, HEPHAUDIO_CH_LAYOUT_7_POINT_1)->UseManualTime();
+BENCHMARK_CAPTURE(BM_ChannelMapper, 7_1_to_stereo, HEPHAUDIO_CH_LAYOUT_7_POINT_1, HEPHAUDIO_CH_LAYOUT_STEREO)->UseManualTime();
+BENCHMARK_CAPTURE(BM_ChannelMapper, 7_1_to_5_1, HEPHAUDIO_CH_LAYOUT_7_POINT_1, HEPHAUDIO_CH_LAYOUT_5_POINT_1)->UseManualTime();
\ No newline at end of file
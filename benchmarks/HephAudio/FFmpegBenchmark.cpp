@@ -0,0 +1,153 @@
+#include "benchmark/benchmark.h"
+#include "BenchmarkHelpers.h"
+#include "FFmpeg/FFmpegAudioDecoder.h"
+#include "FFmpeg/FFmpegAudioEncoder.h"
+#include <filesystem>
+#include <string>
+
+using namespace HephAudio;
+
+#define BENCHMARK_FILE_DURATION_S 10
+#define BENCHMARK_SAMPLE_RATE 48000
+#define BENCHMARK_FRAME_COUNT (BENCHMARK_FILE_DURATION_S * BENCHMARK_SAMPLE_RATE)
+
+static AudioBuffer CreateSourceBuffer()
+{
+	AudioBuffer buffer(BENCHMARK_FRAME_COUNT, HEPHAUDIO_CH_LAYOUT_STEREO, BENCHMARK_SAMPLE_RATE);
+	BenchmarkHelpers::FillNoise(buffer.begin(), buffer.end(), 0.5);
+	return buffer;
+}
+
+static AudioFormatInfo GetFileFormat(const std::string& extension)
+{
+	if (extension == ".flac")
+	{
+		return AudioFormatInfo(HEPHAUDIO_FORMAT_TAG_FLAC, 16, HEPHAUDIO_CH_LAYOUT_STEREO, BENCHMARK_SAMPLE_RATE);
+	}
+	if (extension == ".mp3")
+	{
+		return AudioFormatInfo(HEPHAUDIO_FORMAT_TAG_MP3, 16, HEPHAUDIO_CH_LAYOUT_STEREO, BENCHMARK_SAMPLE_RATE, 320000);
+	}
+	return AudioFormatInfo(HEPHAUDIO_FORMAT_TAG_PCM, 16, HEPHAUDIO_CH_LAYOUT_STEREO, BENCHMARK_SAMPLE_RATE);
+}
+
+static std::filesystem::path GetFilePath(const std::string& extension)
+{
+	return std::filesystem::temp_directory_path() / ("hephaudio_benchmark" + extension);
+}
+
+// generates the file once per format so the decoder benchmarks do not depend on the test files.
+static std::filesystem::path GenerateFile(const std::string& extension)
+{
+	const std::filesystem::path filePath = GetFilePath(extension);
+	if (!std::filesystem::exists(filePath))
+	{
+		FFmpegAudioEncoder encoder(filePath, GetFileFormat(extension), true);
+		encoder.Encode(CreateSourceBuffer());
+	}
+	return filePath;
+}
+
+static void BM_FFmpegAudioDecoder_DecodeAll(benchmark::State& state, const std::string& extension)
+{
+	const std::filesystem::path filePath = GenerateFile(extension);
+	FFmpegAudioDecoder decoder(filePath);
+	const size_t frameCount = decoder.GetFrameCount();
+
+	for (auto _ : state)
+	{
+		decoder.Seek(0);
+		AudioBuffer buffer = decoder.Decode();
+		benchmark::DoNotOptimize(buffer.begin());
+	}
+
+	BenchmarkHelpers::SetFrameCounters(state, frameCount);
+}
+BENCHMARK_CAPTURE(BM_FFmpegAudioDecoder_DecodeAll, wav, std::string(".wav"))->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_FFmpegAudioDecoder_DecodeAll, flac, std::string(".flac"))->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_FFmpegAudioDecoder_DecodeAll, mp3, std::string(".mp3"))->Unit(benchmark::kMillisecond);
+
+static void BM_FFmpegAudioDecoder_DecodeBlocks(benchmark::State& state, const std::string& extension)
+{
+	const std::filesystem::path filePath = GenerateFile(extension);
+	const size_t blockSize = state.range(0);
+	FFmpegAudioDecoder decoder(filePath);
+	const size_t frameCount = decoder.GetFrameCount();
+	size_t frameIndex = 0;
+
+	// streaming access pattern, sequential reads of a block at a time.
+	for (auto _ : state)
+	{
+		if (frameIndex + blockSize > frameCount)
+		{
+			frameIndex = 0;
+		}
+
+		AudioBuffer buffer = decoder.Decode(frameIndex, blockSize);
+		benchmark::DoNotOptimize(buffer.begin());
+		frameIndex += blockSize;
+	}
+
+	BenchmarkHelpers::SetFrameCounters(state, blockSize);
+}
+BENCHMARK_CAPTURE(BM_FFmpegAudioDecoder_DecodeBlocks, wav, std::string(".wav"))->Arg(512)->Arg(4096)->Arg(48000);
+BENCHMARK_CAPTURE(BM_FFmpegAudioDecoder_DecodeBlocks, flac, std::string(".flac"))->Arg(512)->Arg(4096)->Arg(48000);
+BENCHMARK_CAPTURE(BM_FFmpegAudioDecoder_DecodeBlocks, mp3, std::string(".mp3"))->Arg(512)->Arg(4096)->Arg(48000);
+
+static void BM_FFmpegAudioEncoder_Encode(benchmark::State& state, const std::string& extension)
+{
+	const AudioBuffer buffer = CreateSourceBuffer();
+	const std::filesystem::path filePath = std::filesystem::temp_directory_path() / ("hephaudio_benchmark_encode" + extension);
+
+	for (auto _ : state)
+	{
+		FFmpegAudioEncoder encoder(filePath, GetFileFormat(extension), true);
+		encoder.Encode(buffer);
+		encoder.CloseFile();
+	}
+
+	std::filesystem::remove(filePath);
+	BenchmarkHelpers::SetFrameCounters(state, buffer.FrameCount());
+}
+BENCHMARK_CAPTURE(BM_FFmpegAudioEncoder_Encode, wav, std::string(".wav"))->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_FFmpegAudioEncoder_Encode, flac, std::string(".flac"))->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_FFmpegAudioEncoder_Encode, mp3, std::string(".mp3"))->Unit(benchmark::kMillisecond);
+
+static void BM_FFmpegAudioEncoder_EncodeToBuffer(benchmark::State& state)
+{
+	// device render path: internal format to interleaved PCM without a file.
+	const size_t blockSize = state.range(0);
+	AudioBuffer buffer(blockSize, HEPHAUDIO_CH_LAYOUT_STEREO, BENCHMARK_SAMPLE_RATE);
+	BenchmarkHelpers::FillNoise(buffer.begin(), buffer.end(), 0.5);
+	FFmpegAudioEncoder encoder;
+
+	for (auto _ : state)
+	{
+		EncodedAudioBuffer encodedBuffer(AudioFormatInfo(HEPHAUDIO_FORMAT_TAG_PCM, 16, HEPHAUDIO_CH_LAYOUT_STEREO, BENCHMARK_SAMPLE_RATE));
+		encoder.Encode(buffer, encodedBuffer);
+		benchmark::DoNotOptimize(encodedBuffer.begin());
+	}
+
+	BenchmarkHelpers::SetFrameCounters(state, blockSize);
+}
+BENCHMARK(BM_FFmpegAudioEncoder_EncodeToBuffer)->Arg(256)->Arg(512)->Arg(1024);
+
+static void BM_FFmpegAudioDecoder_DecodeFromBuffer(benchmark::State& state)
+{
+	// device capture path: interleaved PCM to internal format without a file.
+	const size_t blockSize = state.range(0);
+	AudioBuffer buffer(blockSize, HEPHAUDIO_CH_LAYOUT_STEREO, BENCHMARK_SAMPLE_RATE);
+	BenchmarkHelpers::FillNoise(buffer.begin(), buffer.end(), 0.5);
+	EncodedAudioBuffer encodedBuffer(AudioFormatInfo(HEPHAUDIO_FORMAT_TAG_PCM, 16, HEPHAUDIO_CH_LAYOUT_STEREO, BENCHMARK_SAMPLE_RATE));
+	FFmpegAudioEncoder().Encode(buffer, encodedBuffer);
+	FFmpegAudioDecoder decoder;
+
+	for (auto _ : state)
+	{
+		AudioBuffer decodedBuffer = decoder.Decode(encodedBuffer);
+		benchmark::DoNotOptimize(decodedBuffer.begin());
+	}
+
+	BenchmarkHelpers::SetFrameCounters(state, blockSize);
+}
+BENCHMARK(BM_FFmpegAudioDecoder_DecodeFromBuffer)->Arg(256)->Arg(512)->Arg(1024);
\ No newline at end of file
@@ -0,0 +1,56 @@
+#include "benchmark/benchmark.h"
+#include "BenchmarkHelpers.h"
+#include "NativeAudio/NativeAudio.h"
+#include <string>
+
+using namespace HephAudio;
+using namespace HephAudio::Native;
+
+/**
+ * device-less NativeAudio, exposes Mix so the render path can be measured without an audio device.
+ *
+ */
+class BenchmarkNativeAudio final : public NativeAudio
+{
+public:
+	using NativeAudio::Mix;
+
+	void SetMasterVolume(double volume) override {}
+	double GetMasterVolume() const override { return 1.0; }
+	void InitializeRender(AudioDevice* device, AudioFormatInfo format) override { this->renderFormat = format; this->isRenderInitialized = true; }
+	void StopRendering() override { this->isRenderInitialized = false; }
+	void InitializeCapture(AudioDevice* device, AudioFormatInfo format) override {}
+	void StopCapturing() override {}
+	void GetNativeParams(NativeAudioParams& nativeParams) const override {}
+	void SetNativeParams(const NativeAudioParams& nativeParams) override {}
+
+protected:
+	bool EnumerateAudioDevices() override { return NativeAudio::DEVICE_ENUMERATION_SUCCESS; }
+};
+
+static void BM_NativeAudio_Mix(benchmark::State& state)
+{
+	const uint32_t frameCount = state.range(0);
+	const size_t voiceCount = state.range(1);
+
+	BenchmarkNativeAudio nativeAudio;
+	nativeAudio.InitializeRender(nullptr, AudioFormatInfo(HEPHAUDIO_FORMAT_TAG_PCM, 16, HEPHAUDIO_CH_LAYOUT_STEREO, 48000));
+
+	for (size_t i = 0; i < voiceCount; ++i)
+	{
+		AudioObject* pAudioObject = nativeAudio.CreateAudioObject("voice " + std::to_string(i), 48000, HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+		BenchmarkHelpers::FillNoise(pAudioObject->buffer.begin(), pAudioObject->buffer.end(), 0.5);
+		pAudioObject->playCount = 0; // loop forever
+		pAudioObject->isPaused = false;
+	}
+
+	for (auto _ : state)
+	{
+		EncodedAudioBuffer encodedBuffer = nativeAudio.Mix(frameCount);
+		benchmark::DoNotOptimize(encodedBuffer.begin());
+	}
+
+	BenchmarkHelpers::SetFrameCounters(state, frameCount);
+	state.counters["voices"] = voiceCount;
+}
+BENCHMARK(BM_NativeAudio_Mix)->ArgNames({ "frames", "voices" })->ArgsProduct({ { 256, 512, 1024 }, { 1, 8, 32, 128 } });
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include "benchmark/benchmark.h"
+#include "BenchmarkHelpers.h"
+#include "PcmAudioDecoder.h"
+#include "WavAudioEncoder.h"
+#include <filesystem>
+
+using namespace HephAudio;
+
+#define BENCHMARK_FILE_DURATION_S 10
+#define BENCHMARK_SAMPLE_RATE 48000
+#define BENCHMARK_FRAME_COUNT (BENCHMARK_FILE_DURATION_S * BENCHMARK_SAMPLE_RATE)
+
+static AudioBuffer CreateSourceBuffer()
+{
+	AudioBuffer buffer(BENCHMARK_FRAME_COUNT, HEPHAUDIO_CH_LAYOUT_STEREO, BENCHMARK_SAMPLE_RATE);
+	BenchmarkHelpers::FillNoise(buffer.begin(), buffer.end(), 0.5);
+	return buffer;
+}
+
+// generates the file once per format, same content as the FFmpeg benchmark files so the results can be compared.
+static std::filesystem::path GenerateFile(uint16_t formatTag, uint16_t bitsPerSample)
+{
+	const std::filesystem::path filePath = std::filesystem::temp_directory_path() /
+		("hephaudio_benchmark_pcm_" + std::to_string(formatTag) + "_" + std::to_string(bitsPerSample) + ".wav");
+	if (!std::filesystem::exists(filePath))
+	{
+		WavAudioEncoder encoder(filePath, AudioFormatInfo(formatTag, bitsPerSample, HEPHAUDIO_CH_LAYOUT_STEREO, BENCHMARK_SAMPLE_RATE), true);
+		encoder.Encode(CreateSourceBuffer());
+	}
+	return filePath;
+}
+
+static void BM_PcmAudioDecoder_DecodeAll(benchmark::State& state, uint16_t formatTag, uint16_t bitsPerSample)
+{
+	PcmAudioDecoder decoder(nullptr);
+	decoder.ChangeFile(GenerateFile(formatTag, bitsPerSample));
+	const size_t frameCount = decoder.GetFrameCount();
+
+	for (auto _ : state)
+	{
+		AudioBuffer buffer = decoder.Decode();
+		benchmark::DoNotOptimize(buffer.begin());
+	}
+
+	BenchmarkHelpers::SetFrameCounters(state, frameCount);
+}
+BENCHMARK_CAPTURE(BM_PcmAudioDecoder_DecodeAll, s16, (uint16_t)HEPHAUDIO_FORMAT_TAG_PCM, (uint16_t)16)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_PcmAudioDecoder_DecodeAll, s24, (uint16_t)HEPHAUDIO_FORMAT_TAG_PCM, (uint16_t)24)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_PcmAudioDecoder_DecodeAll, f32, (uint16_t)HEPHAUDIO_FORMAT_TAG_IEEE_FLOAT, (uint16_t)32)->Unit(benchmark::kMillisecond);
+
+static void BM_PcmAudioDecoder_DecodeBlocks(benchmark::State& state)
+{
+	const size_t blockSize = state.range(0);
+	PcmAudioDecoder decoder(nullptr);
+	decoder.ChangeFile(GenerateFile(HEPHAUDIO_FORMAT_TAG_PCM, 16));
+	const size_t frameCount = decoder.GetFrameCount();
+	size_t frameIndex = 0;
+
+	// streaming access pattern, sequential reads of a block at a time.
+	for (auto _ : state)
+	{
+		if (frameIndex + blockSize > frameCount)
+		{
+			frameIndex = 0;
+		}
+
+		AudioBuffer buffer = decoder.Decode(frameIndex, blockSize);
+		benchmark::DoNotOptimize(buffer.begin());
+		frameIndex += blockSize;
+	}
+
+	BenchmarkHelpers::SetFrameCounters(state, blockSize);
+}
+BENCHMARK(BM_PcmAudioDecoder_DecodeBlocks)->Arg(512)->Arg(4096)->Arg(48000);
+
+static void BM_WavAudioEncoder_Encode(benchmark::State& state)
+{
+	const AudioBuffer buffer = CreateSourceBuffer();
+	const std::filesystem::path filePath = std::filesystem::temp_directory_path() / "hephaudio_benchmark_encode_pcm.wav";
+
+	for (auto _ : state)
+	{
+		WavAudioEncoder encoder(filePath, AudioFormatInfo(HEPHAUDIO_FORMAT_TAG_PCM, 16, HEPHAUDIO_CH_LAYOUT_STEREO, BENCHMARK_SAMPLE_RATE), true);
+		encoder.Encode(buffer);
+		encoder.CloseFile();
+	}
+
+	std::filesystem::remove(filePath);
+	BenchmarkHelpers::SetFrameCounters(state, buffer.FrameCount());
+}
+BENCHMARK(BM_WavAudioEncoder_Encode)->Unit(benchmark::kMillisecond);
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+#include "benchmark/benchmark.h"
+#include <cstdint>
+#include <random>
+
+namespace BenchmarkHelpers
+{
+	/**
+	 * reports the throughput as frames/second and the cost as time/frame (printed in seconds, i.e. "12n" is 12 ns/frame).
+	 *
+	 */
+	inline void SetFrameCounters(benchmark::State& state, size_t framesPerIteration)
+	{
+		const double frameCount = (double)state.iterations() * framesPerIteration;
+		state.counters["frames/s"] = benchmark::Counter(frameCount, benchmark::Counter::kIsRate);
+		state.counters["time/frame"] = benchmark::Counter(frameCount, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+	}
+
+	/**
+	 * deterministic white noise in the range of [-amplitude, amplitude] so runs are comparable.
+	 *
+	 */
+	template<typename TIterator>
+	inline void FillNoise(TIterator begin, TIterator end, double amplitude)
+	{
+		std::mt19937 generator(5489u);
+		std::uniform_real_distribution<double> distribution(-amplitude, amplitude);
+		for (; begin != end; ++begin)
+		{
+			*begin = distribution(generator);
+		}
+	}
+}
\ No newline at end of file
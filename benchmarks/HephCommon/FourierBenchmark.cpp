@@ -0,0 +1,78 @@
+#include "benchmark/benchmark.h"
+#include "BenchmarkHelpers.h"
+#include "Fourier.h"
+#include <algorithm>
+
+using namespace Heph;
+
+static void BM_Fourier_FFT_Real(benchmark::State& state)
+{
+	const size_t fftSize = state.range(0);
+	DoubleBuffer signal(fftSize);
+	BenchmarkHelpers::FillNoise(signal.begin(), signal.end(), 1.0);
+
+	for (auto _ : state)
+	{
+		ComplexBuffer spectrum = Fourier::FFT(signal);
+		benchmark::DoNotOptimize(spectrum.begin());
+	}
+
+	BenchmarkHelpers::SetFrameCounters(state, fftSize);
+}
+BENCHMARK(BM_Fourier_FFT_Real)->RangeMultiplier(4)->Range(64, 1 << 16);
+
+static void BM_Fourier_FFT_Complex(benchmark::State& state)
+{
+	const size_t fftSize = state.range(0);
+	DoubleBuffer signal(fftSize);
+	BenchmarkHelpers::FillNoise(signal.begin(), signal.end(), 1.0);
+	const ComplexBuffer input = Fourier::FFT(signal);
+	ComplexBuffer spectrum = input;
+
+	for (auto _ : state)
+	{
+		// transforming the output repeatedly scales it by fftSize each time until it overflows, start from the same input.
+		std::copy(input.begin(), input.end(), spectrum.begin());
+		Fourier::FFT(spectrum);
+		benchmark::DoNotOptimize(spectrum.begin());
+		benchmark::ClobberMemory();
+	}
+
+	BenchmarkHelpers::SetFrameCounters(state, fftSize);
+}
+BENCHMARK(BM_Fourier_FFT_Complex)->RangeMultiplier(4)->Range(64, 1 << 16);
+
+static void BM_Fourier_IFFT(benchmark::State& state)
+{
+	const size_t fftSize = state.range(0);
+	DoubleBuffer signal(fftSize);
+	BenchmarkHelpers::FillNoise(signal.begin(), signal.end(), 1.0);
+	const ComplexBuffer spectrum = Fourier::FFT(signal);
+
+	for (auto _ : state)
+	{
+		ComplexBuffer temp = spectrum;
+		Fourier::IFFT(signal, temp);
+		benchmark::DoNotOptimize(signal.begin());
+	}
+
+	BenchmarkHelpers::SetFrameCounters(state, fftSize);
+}
+BENCHMARK(BM_Fourier_IFFT)->RangeMultiplier(4)->Range(64, 1 << 16);
+
+static void BM_Fourier_Convolve(benchmark::State& state)
+{
+	DoubleBuffer source(state.range(0));
+	DoubleBuffer kernel(state.range(1));
+	BenchmarkHelpers::FillNoise(source.begin(), source.end(), 1.0);
+	BenchmarkHelpers::FillNoise(kernel.begin(), kernel.end(), 0.1);
+
+	for (auto _ : state)
+	{
+		DoubleBuffer result = Fourier::Convolve(source, kernel);
+		benchmark::DoNotOptimize(result.begin());
+	}
+
+	BenchmarkHelpers::SetFrameCounters(state, source.Size());
+}
+BENCHMARK(BM_Fourier_Convolve)->ArgsProduct({ { 1024, 16384, 131072 }, { 64, 512, 4096 } });
\ No newline at end of file
@@ -0,0 +1,125 @@
+#include "gtest/gtest.h"
+#include "AsyncAudioEncoder.h"
+#include "WavAudioEncoder.h"
+#include "PcmAudioDecoder.h"
+#include "TestSignals.h"
+#include "Exceptions/InvalidOperationException.h"
+#include <memory>
+
+using namespace Heph;
+using namespace HephAudio;
+
+namespace
+{
+	class FailingAudioEncoder final : public IAudioEncoder
+	{
+	private:
+		bool isFileOpen = false;
+
+	public:
+		void ChangeFile(const std::filesystem::path& newAudioFilePath, const AudioFormatInfo& outputFormatInfo, bool overwrite) override { this->isFileOpen = true; }
+		void CloseFile() override { this->isFileOpen = false; }
+		bool IsFileOpen() const override { return this->isFileOpen; }
+		void Encode(const AudioBuffer& bufferToEncode) override { throw InvalidOperationException(HEPH_FUNC, "Disk is full."); }
+		void Encode(const AudioBuffer& inputBuffer, EncodedAudioBuffer& outputBuffer) override {}
+		void Transcode(const EncodedAudioBuffer& inputBuffer, EncodedAudioBuffer& outputBuffer) override {}
+	};
+}
+
+TEST(AsyncAudioEncoderTest, BlockProducer)
+{
+	const std::filesystem::path filePath = std::filesystem::temp_directory_path() / "HephAudioAsyncEncoderTest.wav";
+	const AudioFormatInfo formatInfo(HEPHAUDIO_FORMAT_TAG_IEEE_FLOAT, 32, HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+	constexpr size_t chunkFrameCount = 1000;
+	constexpr size_t chunkCount = 50;
+
+	{
+		// the queue is much smaller than the data, so the producer has to wait for the encode thread.
+		AsyncAudioEncoder encoder(std::make_shared<WavAudioEncoder>(), 256, 4, BlockProducer);
+		EXPECT_EQ(encoder.GetQueueCapacity(), 1024);
+
+		encoder.ChangeFile(filePath, formatInfo, true);
+		ASSERT_TRUE(encoder.IsFileOpen());
+		for (size_t i = 0; i < chunkCount; ++i)
+		{
+			encoder.Encode(TestSignals::CreateStereoBuffer(chunkFrameCount, 0.01, 0.02, 0.9, 0.5, i * chunkFrameCount));
+		}
+		encoder.CloseFile();
+
+		EXPECT_FALSE(encoder.IsFileOpen());
+		EXPECT_EQ(encoder.GetQueuedFrameCount(), 0);
+		EXPECT_EQ(encoder.GetOverrunCount(), 0);
+		EXPECT_EQ(encoder.GetDroppedFrameCount(), 0);
+	}
+
+	PcmAudioDecoder decoder(nullptr);
+	decoder.ChangeFile(filePath);
+	ASSERT_TRUE(decoder.IsFileOpen());
+	ASSERT_EQ(decoder.GetFrameCount(), chunkFrameCount * chunkCount);
+
+	const AudioBuffer expected = TestSignals::CreateStereoBuffer(chunkFrameCount * chunkCount, 0.01, 0.02);
+	const AudioBuffer actual = decoder.Decode();
+	for (size_t i = 0; i < expected.FrameCount(); ++i)
+	{
+		ASSERT_EQ(expected[i][0], actual[i][0]);
+		ASSERT_EQ(expected[i][1], actual[i][1]);
+	}
+
+	decoder.CloseFile();
+	std::filesystem::remove(filePath);
+}
+
+TEST(AsyncAudioEncoderTest, DropNewest)
+{
+	const std::filesystem::path filePath = std::filesystem::temp_directory_path() / "HephAudioAsyncEncoderTest.wav";
+	const AudioFormatInfo formatInfo(HEPHAUDIO_FORMAT_TAG_PCM, 16, HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+	constexpr size_t frameCount = 5000;
+	uint64_t droppedFrameCount;
+
+	{
+		AsyncAudioEncoder encoder(std::make_shared<WavAudioEncoder>(), 256, 4, DropNewest);
+		EXPECT_EQ(encoder.GetOverrunPolicy(), DropNewest);
+
+		encoder.ChangeFile(filePath, formatInfo, true);
+		encoder.Encode(TestSignals::CreateStereoBuffer(frameCount, 0.01, 0.02));
+		encoder.CloseFile();
+
+		// a single write can not queue more than the capacity.
+		droppedFrameCount = encoder.GetDroppedFrameCount();
+		EXPECT_EQ(encoder.GetOverrunCount(), 1);
+		EXPECT_EQ(droppedFrameCount, frameCount - encoder.GetQueueCapacity());
+	}
+
+	PcmAudioDecoder decoder(nullptr);
+	decoder.ChangeFile(filePath);
+	EXPECT_EQ(decoder.GetFrameCount(), frameCount - droppedFrameCount);
+
+	decoder.CloseFile();
+	std::filesystem::remove(filePath);
+}
+
+TEST(AsyncAudioEncoderTest, Failure)
+{
+	AsyncAudioEncoder encoder(std::make_shared<FailingAudioEncoder>(), 64, 2, BlockProducer);
+	encoder.ChangeFile("failing", AudioFormatInfo(), true);
+
+	// the producer waits for space that's never freed, so the error is reported by Encode.
+	bool isThrown = false;
+	try
+	{
+		for (size_t i = 0; i < 100; ++i)
+		{
+			encoder.Encode(TestSignals::CreateStereoBuffer(64, 0.01, 0.02));
+		}
+	}
+	catch (const InvalidOperationException&)
+	{
+		isThrown = true;
+	}
+	EXPECT_TRUE(isThrown);
+
+	// the error is reported once more when the file is closed, then the encoder can be reused.
+	EXPECT_THROW(encoder.CloseFile(), InvalidOperationException);
+	EXPECT_FALSE(encoder.IsFileOpen());
+	EXPECT_NO_THROW(encoder.CloseFile());
+}
\ No newline at end of file
@@ -0,0 +1,151 @@
+#include "gtest/gtest.h"
+#include "AudioAssetCache.h"
+#include <cstdio>
+
+using namespace Heph;
+using namespace HephAudio;
+
+// decodes every file to a silent buffer and counts the decode calls.
+class CountingDecoder final : public IAudioDecoder
+{
+public:
+	size_t decodeCount = 0;
+	size_t frameCount = 1000;
+
+	void ChangeFile(const std::filesystem::path& newFilePath) override { this->filePath = newFilePath; }
+	void CloseFile() override { this->filePath = ""; }
+	bool IsFileOpen() const override { return !this->filePath.empty(); }
+	AudioFormatInfo GetOutputFormatInfo() const override { return HEPHAUDIO_INTERNAL_FORMAT(HEPHAUDIO_CH_LAYOUT_STEREO, 48000); }
+	size_t GetFrameCount() const override { return this->frameCount; }
+	bool Seek(size_t frameIndex) override { return true; }
+	AudioBuffer Decode() override { this->decodeCount++; return AudioBuffer(this->frameCount, HEPHAUDIO_CH_LAYOUT_STEREO, 48000); }
+	AudioBuffer Decode(size_t frameCount) override { return this->Decode(); }
+	AudioBuffer Decode(size_t frameIndex, size_t frameCount) override { return this->Decode(); }
+	AudioBuffer Decode(const EncodedAudioBuffer& encodedBuffer) override { return this->Decode(); }
+	size_t DecodeInto(heph_audio_sample_t* pOutput, size_t frameCount) override { return 0; }
+	using IAudioDecoder::DecodeInto;
+};
+
+static std::filesystem::path CreateFile(const std::string& name)
+{
+	const std::filesystem::path filePath = std::filesystem::temp_directory_path() / name;
+	FILE* pFile = fopen(filePath.string().c_str(), "wb");
+	if (pFile != nullptr)
+	{
+		fputc(0, pFile);
+		fclose(pFile);
+	}
+	return filePath;
+}
+
+static constexpr size_t ENTRY_SIZE = 1000 * 2 * sizeof(heph_audio_sample_t);
+
+TEST(AudioAssetCacheTest, Get)
+{
+	const std::filesystem::path filePath = CreateFile("HephAudioAssetCacheTest_a.bin");
+	AudioAssetCache cache;
+	CountingDecoder decoder;
+
+	std::shared_ptr<const AudioBuffer> p1 = cache.Get(filePath, decoder);
+	std::shared_ptr<const AudioBuffer> p2 = cache.Get(filePath, decoder);
+	std::shared_ptr<const AudioBuffer> p3 = cache.Get(filePath.parent_path() / "." / filePath.filename(), decoder);
+
+	EXPECT_EQ(decoder.decodeCount, 1);
+	EXPECT_FALSE(decoder.IsFileOpen());
+	EXPECT_EQ(p1, p2);
+	EXPECT_EQ(p1, p3);
+	EXPECT_EQ(p1->FrameCount(), 1000);
+	EXPECT_EQ(cache.GetHitCount(), 2);
+	EXPECT_EQ(cache.GetMissCount(), 1);
+	EXPECT_EQ(cache.GetEntryCount(), 1);
+	EXPECT_EQ(cache.GetMemoryUsage(), ENTRY_SIZE);
+	EXPECT_TRUE(cache.Contains(filePath));
+
+	// a modified file is decoded again, the objects that use the old data keep it.
+	std::filesystem::last_write_time(filePath, std::filesystem::last_write_time(filePath) + std::chrono::seconds(10));
+	std::shared_ptr<const AudioBuffer> p4 = cache.Get(filePath, decoder);
+	EXPECT_EQ(decoder.decodeCount, 2);
+	EXPECT_NE(p1, p4);
+	EXPECT_EQ(p1->FrameCount(), 1000);
+	EXPECT_EQ(cache.GetEntryCount(), 1);
+	EXPECT_EQ(cache.GetMemoryUsage(), ENTRY_SIZE);
+
+	EXPECT_TRUE(cache.Remove(filePath));
+	EXPECT_FALSE(cache.Remove(filePath));
+	EXPECT_EQ(cache.GetMemoryUsage(), 0);
+
+	std::filesystem::remove(filePath);
+}
+
+TEST(AudioAssetCacheTest, Eviction)
+{
+	const std::filesystem::path pathA = CreateFile("HephAudioAssetCacheTest_a.bin");
+	const std::filesystem::path pathB = CreateFile("HephAudioAssetCacheTest_b.bin");
+	const std::filesystem::path pathC = CreateFile("HephAudioAssetCacheTest_c.bin");
+	AudioAssetCache cache(ENTRY_SIZE * 2);
+	CountingDecoder decoder;
+
+	// referenced entries are kept even when they exceed the budget.
+	std::shared_ptr<const AudioBuffer> pA = cache.Get(pathA, decoder);
+	std::shared_ptr<const AudioBuffer> pB = cache.Get(pathB, decoder);
+	std::shared_ptr<const AudioBuffer> pC = cache.Get(pathC, decoder);
+	EXPECT_EQ(cache.GetEntryCount(), 3);
+	EXPECT_EQ(cache.GetMemoryUsage(), ENTRY_SIZE * 3);
+
+	// A is used most recently, so B is the least recently used unreferenced entry.
+	(void)cache.Get(pathA, decoder);
+	pA = nullptr;
+	pB = nullptr;
+	cache.Trim();
+	EXPECT_EQ(cache.GetEntryCount(), 2);
+	EXPECT_TRUE(cache.Contains(pathA));
+	EXPECT_FALSE(cache.Contains(pathB));
+	EXPECT_TRUE(cache.Contains(pathC));
+
+	cache.SetMemoryBudget(0);
+	EXPECT_EQ(cache.GetEntryCount(), 1);
+	EXPECT_TRUE(cache.Contains(pathC));
+
+	pC = nullptr;
+	cache.Trim();
+	EXPECT_EQ(cache.GetEntryCount(), 0);
+	EXPECT_EQ(cache.GetMemoryUsage(), 0);
+
+	cache.SetMemoryBudget(ENTRY_SIZE * 2);
+	(void)cache.Get(pathA, decoder);
+	cache.Clear();
+	EXPECT_EQ(cache.GetEntryCount(), 0);
+	EXPECT_EQ(cache.GetMemoryUsage(), 0);
+
+	std::filesystem::remove(pathA);
+	std::filesystem::remove(pathB);
+	std::filesystem::remove(pathC);
+}
+
+TEST(AudioAssetCacheTest, GetCompressed)
+{
+	const std::filesystem::path filePath = CreateFile("HephAudioAssetCacheTest_a.bin");
+	AudioAssetCache cache;
+	CountingDecoder decoder;
+
+	std::shared_ptr<const CompressedAudioBuffer> p1 = cache.GetCompressed(filePath, decoder);
+	std::shared_ptr<const CompressedAudioBuffer> p2 = cache.GetCompressed(filePath, decoder);
+
+	EXPECT_EQ(decoder.decodeCount, 1);
+	EXPECT_FALSE(decoder.IsFileOpen());
+	EXPECT_EQ(p1, p2);
+	EXPECT_EQ(p1->FrameCount(), 1000);
+	EXPECT_EQ(cache.GetMemoryUsage(), p1->Size());
+	EXPECT_LT(p1->Size(), ENTRY_SIZE);
+
+	// the decoded and the compressed data are separate entries.
+	EXPECT_FALSE(cache.Contains(filePath));
+	(void)cache.Get(filePath, decoder);
+	EXPECT_EQ(cache.GetEntryCount(), 2);
+
+	EXPECT_TRUE(cache.Remove(filePath));
+	EXPECT_EQ(cache.GetEntryCount(), 0);
+	EXPECT_EQ(cache.GetMemoryUsage(), 0);
+
+	std::filesystem::remove(filePath);
+}
\ No newline at end of file
@@ -399,4 +399,25 @@ TEST(AudioBufferTest, SetFormat)
 	EXPECT_EQ(b.FrameCount(), 512);
 	EXPECT_EQ(b.FormatInfo().channelLayout, HEPHAUDIO_CH_LAYOUT_7_POINT_1);
 	EXPECT_EQ(b.FormatInfo().sampleRate, 96000);
+}
+
+TEST(AudioBufferTest, SampleTypes)
+{
+	AudioBufferS16 s16(256, HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+	EXPECT_EQ(s16.FormatInfo(), AudioFormatInfo(HEPHAUDIO_FORMAT_TAG_PCM, 16, HEPHAUDIO_CH_LAYOUT_STEREO, 48000));
+	EXPECT_EQ(s16.SizeAsByte(), 256 * 2 * sizeof(int16_t));
+	s16[10][1] = INT16_MIN;
+	EXPECT_EQ(s16.begin()[21], INT16_MIN);
+
+	AudioBufferF64 f64(256, HEPHAUDIO_CH_LAYOUT_MONO, 44100);
+	EXPECT_EQ(f64.FormatInfo(), AudioFormatInfo(HEPHAUDIO_FORMAT_TAG_IEEE_FLOAT, 64, HEPHAUDIO_CH_LAYOUT_MONO, 44100));
+	f64[0][0] = 0.5;
+	f64 *= 0.5;
+	EXPECT_EQ(f64[0][0], 0.25);
+
+	f64.Append(AudioBufferF64(10, HEPHAUDIO_CH_LAYOUT_MONO, 44100));
+	EXPECT_EQ(f64.FrameCount(), 266);
+	EXPECT_EQ(f64.SubBuffer(0, 5).FormatInfo(), f64.FormatInfo());
+
+	EXPECT_EQ(AudioBuffer::CreateFormatInfo(HEPHAUDIO_CH_LAYOUT_STEREO, 48000), HEPHAUDIO_INTERNAL_FORMAT(HEPHAUDIO_CH_LAYOUT_STEREO, 48000));
 }
\ No newline at end of file
@@ -0,0 +1,268 @@
+#include "gtest/gtest.h"
+#include "AudioBusGraph.h"
+#include "Exceptions/InvalidArgumentException.h"
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+using namespace Heph;
+using namespace HephAudio;
+
+// multiplies the samples, optionally waits until another instance runs at the same time.
+class TestGainEffect : public AudioEffect
+{
+public:
+	double gain;
+	std::atomic<size_t>* pRunningCount;
+	std::atomic<bool>* pOverlapped;
+
+	explicit TestGainEffect(double gain) : gain(gain), pRunningCount(nullptr), pOverlapped(nullptr) {}
+
+	std::string Name() const override
+	{
+		return "Test Gain";
+	}
+
+protected:
+	void ProcessST(const AudioBuffer& inputBuffer, AudioBuffer& outputBuffer, size_t startIndex, size_t frameCount) override
+	{
+		if (this->pRunningCount != nullptr)
+		{
+			(*this->pRunningCount)++;
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			while (*this->pRunningCount < 2 && std::chrono::steady_clock::now() - start < std::chrono::seconds(1))
+			{
+				std::this_thread::yield();
+			}
+			if (*this->pRunningCount >= 2)
+			{
+				*this->pOverlapped = true;
+			}
+		}
+
+		const size_t channelCount = outputBuffer.FormatInfo().channelLayout.count;
+		for (size_t i = startIndex; i < startIndex + frameCount; ++i)
+		{
+			for (size_t j = 0; j < channelCount; ++j)
+			{
+				outputBuffer[i][j] = inputBuffer[i][j] * this->gain;
+			}
+		}
+	}
+};
+
+// throws on the first period only, leaves the samples unchanged afterwards.
+class TestThrowEffect : public AudioEffect
+{
+public:
+	bool hasThrown;
+
+	TestThrowEffect() : hasThrown(false) {}
+
+	std::string Name() const override
+	{
+		return "Test Throw";
+	}
+
+protected:
+	void ProcessST(const AudioBuffer& inputBuffer, AudioBuffer& outputBuffer, size_t startIndex, size_t frameCount) override
+	{
+		if (!this->hasThrown)
+		{
+			this->hasThrown = true;
+			throw std::runtime_error("test");
+		}
+	}
+};
+
+static void Fill(AudioBuffer* pBuffer, double value)
+{
+	ASSERT_NE(pBuffer, nullptr);
+	for (size_t i = 0; i < pBuffer->Size(); ++i)
+	{
+		pBuffer->begin()[i] = HEPH_AUDIO_SAMPLE_FROM_IEEE_FLT(value);
+	}
+}
+
+static void ExpectValue(const AudioBuffer& buffer, double value)
+{
+	for (size_t i = 0; i < buffer.Size(); ++i)
+	{
+		ASSERT_NEAR(HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(buffer.begin()[i]), value, 1e-4);
+	}
+}
+
+TEST(AudioBusGraphTest, Buses)
+{
+	AudioBusGraph graph;
+	EXPECT_EQ(graph.GetBusCount(), 1);
+	EXPECT_EQ(graph.GetBus(HEPHAUDIO_MASTER_BUS_NAME), &graph.GetMasterBus());
+	EXPECT_FALSE(graph.DestroyBus(HEPHAUDIO_MASTER_BUS_NAME));
+
+	AudioBus* pBus = graph.CreateBus("music", "");
+	ASSERT_NE(pBus, nullptr);
+	EXPECT_EQ(pBus->name, "music");
+	EXPECT_EQ(pBus->volume, 1.0);
+	EXPECT_EQ(graph.GetBus("music"), pBus);
+	EXPECT_EQ(graph.GetBusCount(), 2);
+
+	EXPECT_THROW(graph.CreateBus("music", ""), InvalidArgumentException);
+	EXPECT_THROW(graph.CreateBus("", ""), InvalidArgumentException);
+
+	EXPECT_TRUE(graph.DestroyBus("music"));
+	EXPECT_FALSE(graph.DestroyBus("music"));
+	EXPECT_EQ(graph.GetBus("music"), nullptr);
+	EXPECT_EQ(graph.GetBusCount(), 1);
+
+	EXPECT_EQ(graph.GetThreadCount(), 1);
+	graph.SetThreadCount(3);
+	EXPECT_EQ(graph.GetThreadCount(), 3);
+	graph.SetThreadCount(0);
+	EXPECT_GE(graph.GetThreadCount(), 1);
+}
+
+TEST(AudioBusGraphTest, Routing)
+{
+	AudioBusGraph graph;
+	AudioBus* pMusic = graph.CreateBus("music", "");
+	AudioBus* pFx = graph.CreateBus("fx", "music");
+	pMusic->effects.push_back(std::make_shared<TestGainEffect>(2.0));
+	pFx->volume = 0.5;
+	graph.GetMasterBus().volume = 0.5;
+
+	AudioBuffer output(64, HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+	graph.BeginPeriod(output);
+	EXPECT_EQ(graph.GetInputBuffer(""), &output);
+	EXPECT_EQ(graph.GetInputBuffer("unknown"), nullptr);
+	Fill(graph.GetInputBuffer("fx"), 0.2);
+	Fill(graph.GetInputBuffer("music"), 0.1);
+	graph.Process();
+
+	// ((0.2 * 0.5 + 0.1) * 2) * 0.5
+	ExpectValue(output, 0.2);
+
+	// buses are cleared each period.
+	output.Reset();
+	graph.BeginPeriod(output);
+	ExpectValue(*graph.GetInputBuffer("fx"), 0.0);
+	graph.Process();
+	ExpectValue(output, 0.0);
+}
+
+TEST(AudioBusGraphTest, Sends)
+{
+	AudioBusGraph graph;
+	AudioBus* pDry = graph.CreateBus("dry", "");
+	AudioBus* pReverb = graph.CreateBus("reverb", "");
+	pDry->sends.push_back(AudioBusSend("reverb", 0.5));
+	pDry->sends.push_back(AudioBusSend("unknown", 1.0));
+	pReverb->effects.push_back(std::make_shared<TestGainEffect>(3.0));
+
+	AudioBuffer output(64, HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+	graph.BeginPeriod(output);
+	Fill(graph.GetInputBuffer("dry"), 0.1);
+	graph.Process();
+
+	// 0.1 + 0.1 * 0.5 * 3
+	ExpectValue(output, 0.25);
+}
+
+TEST(AudioBusGraphTest, Cycles)
+{
+	AudioBusGraph graph;
+	graph.CreateBus("a", "b");
+	AudioBus* pB = graph.CreateBus("b", "a");
+	AudioBus* pC = graph.CreateBus("c", "c");
+	pB->sends.push_back(AudioBusSend("c", 1.0));
+	pC->sends.push_back(AudioBusSend("b", 1.0));
+
+	AudioBuffer output(64, HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+	graph.BeginPeriod(output);
+	Fill(graph.GetInputBuffer("a"), 0.1);
+	graph.Process();
+
+	// a -> b -> master, b -> c -> master, the routes closing a cycle are ignored.
+	ExpectValue(output, 0.2);
+}
+
+TEST(AudioBusGraphTest, Parallel)
+{
+	constexpr size_t busCount = 8;
+	std::atomic<size_t> runningCount(0);
+	std::atomic<bool> overlapped(false);
+
+	AudioBusGraph graph;
+	graph.SetThreadCount(4);
+	for (size_t i = 0; i < busCount; ++i)
+	{
+		std::shared_ptr<TestGainEffect> pEffect = std::make_shared<TestGainEffect>(2.0);
+		pEffect->pRunningCount = &runningCount;
+		pEffect->pOverlapped = &overlapped;
+		graph.CreateBus("bus" + std::to_string(i), "")->effects.push_back(pEffect);
+	}
+
+	// the workers are reused for every level, and restarted when the thread count changes.
+	AudioBuffer output(64, HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+	for (size_t period = 0; period < 100; ++period)
+	{
+		if (period == 50)
+		{
+			graph.SetThreadCount(3);
+		}
+
+		output.Reset();
+		graph.BeginPeriod(output);
+		for (size_t i = 0; i < busCount; ++i)
+		{
+			Fill(graph.GetInputBuffer("bus" + std::to_string(i)), 0.01);
+		}
+		graph.Process();
+
+		ExpectValue(output, 0.01 * 2.0 * busCount);
+	}
+
+	EXPECT_TRUE(overlapped);
+}
+
+TEST(AudioBusGraphTest, ParallelException)
+{
+	constexpr size_t busCount = 8;
+
+	AudioBusGraph graph;
+	graph.SetThreadCount(4);
+	for (size_t i = 0; i < busCount; ++i)
+	{
+		AudioBus* pBus = graph.CreateBus("bus" + std::to_string(i), "");
+		if (i == busCount - 1)
+		{
+			pBus->effects.push_back(std::make_shared<TestThrowEffect>());
+		}
+		else
+		{
+			pBus->effects.push_back(std::make_shared<TestGainEffect>(2.0));
+		}
+	}
+
+	// the exception thrown by a worker is rethrown on the calling thread, and does not leak into the next period.
+	AudioBuffer output(64, HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+	for (size_t period = 0; period < 2; ++period)
+	{
+		output.Reset();
+		graph.BeginPeriod(output);
+		for (size_t i = 0; i < busCount; ++i)
+		{
+			Fill(graph.GetInputBuffer("bus" + std::to_string(i)), 0.01);
+		}
+
+		if (period == 0)
+		{
+			EXPECT_THROW(graph.Process(), std::runtime_error);
+		}
+		else
+		{
+			graph.Process();
+			ExpectValue(output, 0.01 * 2.0 * (busCount - 1) + 0.01);
+		}
+	}
+}
\ No newline at end of file
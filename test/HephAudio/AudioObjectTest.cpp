@@ -23,4 +23,45 @@ TEST(AudioObjectTest, MemberMethods)
 	EXPECT_EQ(ao.isPaused, false);
 	ao.Pause();
 	EXPECT_EQ(ao.isPaused, true);
+}
+
+TEST(AudioObjectTest, SharedBuffer)
+{
+	std::shared_ptr<const AudioBuffer> pShared = std::make_shared<const AudioBuffer>(256, HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+
+	AudioObject ao;
+	ao.pSharedBuffer = pShared;
+	EXPECT_EQ(&ao.GetBuffer(), pShared.get());
+	EXPECT_TRUE(ao.buffer.IsEmpty());
+
+	ao.SetPosition(0.5);
+	EXPECT_EQ(ao.frameIndex, 128);
+
+	AudioBuffer& buffer = ao.DetachSharedBuffer();
+	EXPECT_EQ(&buffer, &ao.buffer);
+	EXPECT_EQ(ao.pSharedBuffer, nullptr);
+	EXPECT_EQ(pShared.use_count(), 1);
+	EXPECT_EQ(buffer.FrameCount(), 256);
+	EXPECT_EQ(&ao.GetBuffer(), &ao.buffer);
+}
+
+TEST(AudioObjectTest, CompressedBuffer)
+{
+	AudioBuffer sourceBuffer(3000, HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+	std::shared_ptr<const CompressedAudioBuffer> pCompressed = std::make_shared<const CompressedAudioBuffer>(sourceBuffer);
+
+	AudioObject ao;
+	ao.pCompressedBuffer = pCompressed;
+	EXPECT_EQ(ao.GetFrameCount(), 3000);
+	EXPECT_EQ(ao.GetFormatInfo(), sourceBuffer.FormatInfo());
+
+	const AudioBuffer frames = ao.GetFrames(2900, 200);
+	EXPECT_EQ(frames.FrameCount(), 200);
+	EXPECT_NE(ao.pDecoderState, nullptr);
+
+	AudioBuffer& buffer = ao.DetachSharedBuffer();
+	EXPECT_EQ(ao.pCompressedBuffer, nullptr);
+	EXPECT_EQ(ao.pDecoderState, nullptr);
+	EXPECT_EQ(buffer.FrameCount(), 3000);
+	EXPECT_EQ(pCompressed->GetIdleDecoderStateCount(), 1);
 }
\ No newline at end of file
@@ -0,0 +1,166 @@
+#include "gtest/gtest.h"
+#include "AudioRingBuffer.h"
+#include <thread>
+
+using namespace Heph;
+using namespace HephAudio;
+
+TEST(AudioRingBufferTest, Constructors)
+{
+	{
+		AudioRingBuffer rb;
+		EXPECT_EQ(rb.GetCapacity(), 0);
+		EXPECT_EQ(rb.GetReadableFrameCount(), 0);
+		EXPECT_EQ(rb.GetWritableFrameCount(), 0);
+	}
+
+	{
+		AudioRingBuffer rb(256, HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+		EXPECT_EQ(rb.GetCapacity(), 256);
+		EXPECT_EQ(rb.GetReadableFrameCount(), 0);
+		EXPECT_EQ(rb.GetWritableFrameCount(), 256);
+		EXPECT_EQ(rb.FormatInfo(), HEPHAUDIO_INTERNAL_FORMAT(HEPHAUDIO_CH_LAYOUT_STEREO, 48000));
+	}
+}
+
+TEST(AudioRingBufferTest, WriteRead)
+{
+	AudioRingBuffer rb(8, HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+	AudioBuffer input(6, HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+	AudioBuffer output(4, HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+
+	for (size_t i = 0; i < input.Size(); ++i)
+	{
+		input.begin()[i] = i;
+	}
+
+	EXPECT_EQ(rb.Write(input), 6);
+	EXPECT_EQ(rb.GetReadableFrameCount(), 6);
+	EXPECT_EQ(rb.Read(output), 4);
+	for (size_t i = 0; i < output.Size(); ++i)
+	{
+		EXPECT_EQ(output.begin()[i], (heph_audio_sample_t)i);
+	}
+
+	// wraps around the end of the buffer.
+	EXPECT_EQ(rb.Write(input), 6);
+	EXPECT_EQ(rb.GetReadableFrameCount(), 8);
+	EXPECT_EQ(rb.Read(output), 4);
+	EXPECT_EQ(output[0][0], input[4][0]);
+	EXPECT_EQ(output[1][1], input[5][1]);
+	EXPECT_EQ(output[2][0], input[0][0]);
+	EXPECT_EQ(output[3][1], input[1][1]);
+
+	EXPECT_EQ(rb.Skip(3), 3);
+	EXPECT_EQ(rb.Read(output), 1);
+	EXPECT_EQ(output[0][0], input[5][0]);
+	EXPECT_EQ(rb.GetReadableFrameCount(), 0);
+
+	EXPECT_EQ(rb.GetOverrunCount(), 0);
+	EXPECT_EQ(rb.GetDroppedFrameCount(), 0);
+
+	EXPECT_THROW(rb.Write(AudioBuffer(4, HEPHAUDIO_CH_LAYOUT_MONO, 48000)), InvalidArgumentException);
+}
+
+TEST(AudioRingBufferTest, Overrun)
+{
+	AudioRingBuffer rb(8, HEPHAUDIO_CH_LAYOUT_MONO, 48000);
+	AudioBuffer input(6, HEPHAUDIO_CH_LAYOUT_MONO, 48000);
+
+	EXPECT_EQ(rb.Write(input), 6);
+	EXPECT_EQ(rb.Write(input), 2);
+	EXPECT_EQ(rb.Write(input), 0);
+	EXPECT_EQ(rb.GetOverrunCount(), 2);
+	EXPECT_EQ(rb.GetDroppedFrameCount(), 10);
+
+	rb.Reset(16, HEPHAUDIO_CH_LAYOUT_MONO, 44100);
+	EXPECT_EQ(rb.GetCapacity(), 16);
+	EXPECT_EQ(rb.GetReadableFrameCount(), 0);
+	EXPECT_EQ(rb.GetOverrunCount(), 0);
+	EXPECT_EQ(rb.GetDroppedFrameCount(), 0);
+	EXPECT_EQ(rb.FormatInfo().sampleRate, 44100);
+}
+
+TEST(AudioRingBufferTest, WriteRegion)
+{
+	AudioRingBuffer rb(8, HEPHAUDIO_CH_LAYOUT_MONO, 48000);
+	AudioBuffer output(8, HEPHAUDIO_CH_LAYOUT_MONO, 48000);
+	heph_audio_sample_t* pRegion = nullptr;
+
+	EXPECT_EQ(rb.GetWriteRegion(&pRegion), 8);
+	pRegion[0] = 1;
+	pRegion[1] = 2;
+	pRegion[2] = 3;
+	pRegion[3] = 4;
+	pRegion[4] = 5;
+	pRegion[5] = 6;
+	rb.CommitWrite(6);
+	EXPECT_EQ(rb.GetReadableFrameCount(), 6);
+	EXPECT_EQ(rb.Skip(4), 4);
+
+	// the region ends at the end of the memory, the rest is at the beginning.
+	EXPECT_EQ(rb.GetWriteRegion(&pRegion), 2);
+	pRegion[0] = 7;
+	pRegion[1] = 8;
+	rb.CommitWrite(2);
+	EXPECT_EQ(rb.GetWriteRegion(&pRegion), 4);
+	pRegion[0] = 9;
+	rb.CommitWrite(1);
+
+	EXPECT_EQ(rb.Read(output.begin(), 8), 5);
+	for (size_t i = 0; i < 5; ++i)
+	{
+		EXPECT_EQ(output[i][0], 5 + i);
+	}
+
+	rb.Write(output.begin(), 8);
+	EXPECT_EQ(rb.GetWriteRegion(&pRegion), 0);
+	EXPECT_EQ(pRegion, nullptr);
+}
+
+TEST(AudioRingBufferTest, Concurrent)
+{
+	constexpr size_t frameCount = 100000;
+	AudioRingBuffer rb(64, HEPHAUDIO_CH_LAYOUT_MONO, 48000);
+
+	std::thread producer([&rb]()
+		{
+			heph_audio_sample_t frames[16];
+			size_t writtenFrameCount = 0;
+			while (writtenFrameCount < frameCount)
+			{
+				const size_t writableFrameCount = rb.GetWritableFrameCount();
+				const size_t count = HEPH_MATH_MIN(HEPH_MATH_MIN((size_t)16, frameCount - writtenFrameCount), writableFrameCount);
+				for (size_t i = 0; i < count; ++i)
+				{
+					frames[i] = (writtenFrameCount + i) % 1000;
+				}
+				writtenFrameCount += rb.Write(frames, count);
+				if (count == 0)
+				{
+					std::this_thread::yield();
+				}
+			}
+		});
+
+	heph_audio_sample_t frames[16];
+	size_t readFrameCount = 0;
+	bool isInOrder = true;
+	while (readFrameCount < frameCount)
+	{
+		const size_t count = rb.Read(frames, 16);
+		for (size_t i = 0; i < count; ++i)
+		{
+			isInOrder &= frames[i] == (heph_audio_sample_t)((readFrameCount + i) % 1000);
+		}
+		readFrameCount += count;
+		if (count == 0)
+		{
+			std::this_thread::yield();
+		}
+	}
+	producer.join();
+
+	EXPECT_TRUE(isInOrder);
+	EXPECT_EQ(rb.GetOverrunCount(), 0);
+}
\ No newline at end of file
@@ -0,0 +1,146 @@
+#include "gtest/gtest.h"
+#include "AudioSeekIndex.h"
+#include <chrono>
+#include <fstream>
+
+using namespace HephAudio;
+
+class AudioSeekIndexTest : public testing::Test
+{
+protected:
+	std::filesystem::path audioFilePath;
+	std::filesystem::path indexFilePath;
+	std::vector<AudioSeekIndex::SeekPoint> seekIndex;
+
+protected:
+	AudioSeekIndexTest()
+		: audioFilePath(std::filesystem::temp_directory_path() / "HephAudioSeekIndexTest.mp3"),
+		indexFilePath(AudioSeekIndex::GetIndexFilePath(audioFilePath)),
+		seekIndex({ { 0, 0 }, { 417, 1152 }, { 835, 2304 }, { 1253, 3456 } })
+	{
+	}
+
+	void SetUp() override
+	{
+		// the contents of the audio file do not matter, only its size and modification time are checked.
+		this->WriteAudioFile(4096);
+		std::filesystem::remove(this->indexFilePath);
+	}
+
+	void TearDown() override
+	{
+		std::filesystem::remove(this->audioFilePath);
+		std::filesystem::remove(this->indexFilePath);
+	}
+
+	void WriteAudioFile(size_t size)
+	{
+		std::ofstream file(this->audioFilePath, std::ios::binary | std::ios::trunc);
+		file << std::string(size, '\x55');
+	}
+
+	void ExpectLoaded(bool isLoaded)
+	{
+		std::vector<AudioSeekIndex::SeekPoint> loadedIndex = { { 1, 1 } };
+		ASSERT_EQ(AudioSeekIndex::Load(this->audioFilePath, loadedIndex), isLoaded);
+		if (isLoaded)
+		{
+			ASSERT_EQ(loadedIndex.size(), this->seekIndex.size());
+			for (size_t i = 0; i < loadedIndex.size(); ++i)
+			{
+				EXPECT_EQ(loadedIndex[i].pos, this->seekIndex[i].pos);
+				EXPECT_EQ(loadedIndex[i].frameIndex, this->seekIndex[i].frameIndex);
+			}
+		}
+		else
+		{
+			EXPECT_TRUE(loadedIndex.empty());
+		}
+	}
+};
+
+TEST_F(AudioSeekIndexTest, IndexFilePath)
+{
+	EXPECT_EQ(this->indexFilePath.filename().string(), "HephAudioSeekIndexTest.mp3" HEPHAUDIO_SEEK_INDEX_EXTENSION);
+	EXPECT_EQ(this->indexFilePath.parent_path(), this->audioFilePath.parent_path());
+}
+
+TEST_F(AudioSeekIndexTest, RoundTrip)
+{
+	this->ExpectLoaded(false);
+
+	EXPECT_TRUE(AudioSeekIndex::Save(this->audioFilePath, this->seekIndex));
+	EXPECT_TRUE(std::filesystem::exists(this->indexFilePath));
+	this->ExpectLoaded(true);
+
+	// saving again overwrites the index.
+	this->seekIndex.push_back({ 1671, 4608 });
+	EXPECT_TRUE(AudioSeekIndex::Save(this->audioFilePath, this->seekIndex));
+	this->ExpectLoaded(true);
+
+	std::filesystem::remove(this->audioFilePath);
+	EXPECT_FALSE(AudioSeekIndex::Save(this->audioFilePath, this->seekIndex));
+	this->ExpectLoaded(false);
+}
+
+TEST_F(AudioSeekIndexTest, Stale)
+{
+	const std::filesystem::file_time_type lastWriteTime = std::filesystem::last_write_time(this->audioFilePath);
+
+	// size changed.
+	ASSERT_TRUE(AudioSeekIndex::Save(this->audioFilePath, this->seekIndex));
+	this->WriteAudioFile(4097);
+	std::filesystem::last_write_time(this->audioFilePath, lastWriteTime);
+	this->ExpectLoaded(false);
+
+	// modification time changed.
+	this->WriteAudioFile(4096);
+	std::filesystem::last_write_time(this->audioFilePath, lastWriteTime);
+	ASSERT_TRUE(AudioSeekIndex::Save(this->audioFilePath, this->seekIndex));
+	this->ExpectLoaded(true);
+	std::filesystem::last_write_time(this->audioFilePath, lastWriteTime + std::chrono::seconds(10));
+	this->ExpectLoaded(false);
+
+	// rebuilt index is valid again.
+	ASSERT_TRUE(AudioSeekIndex::Save(this->audioFilePath, this->seekIndex));
+	this->ExpectLoaded(true);
+}
+
+TEST_F(AudioSeekIndexTest, Corrupt)
+{
+	ASSERT_TRUE(AudioSeekIndex::Save(this->audioFilePath, this->seekIndex));
+	const uintmax_t indexFileSize = std::filesystem::file_size(this->indexFilePath);
+
+	// truncated entries.
+	std::filesystem::resize_file(this->indexFilePath, indexFileSize - 4);
+	this->ExpectLoaded(false);
+
+	// truncated header.
+	std::filesystem::resize_file(this->indexFilePath, 10);
+	this->ExpectLoaded(false);
+
+	// wrong magic.
+	ASSERT_TRUE(AudioSeekIndex::Save(this->audioFilePath, this->seekIndex));
+	{
+		std::fstream file(this->indexFilePath, std::ios::binary | std::ios::in | std::ios::out);
+		file.seekp(0);
+		file.put('X');
+	}
+	this->ExpectLoaded(false);
+
+	// entry count larger than the audio file.
+	ASSERT_TRUE(AudioSeekIndex::Save(this->audioFilePath, this->seekIndex));
+	{
+		const uint64_t entryCount = UINT64_MAX;
+		std::fstream file(this->indexFilePath, std::ios::binary | std::ios::in | std::ios::out);
+		file.seekp(8 + sizeof(uint32_t) + sizeof(uint64_t) + sizeof(int64_t));
+		file.write((const char*)&entryCount, sizeof(entryCount));
+	}
+	this->ExpectLoaded(false);
+
+	// empty file.
+	{
+		std::ofstream file(this->indexFilePath, std::ios::binary | std::ios::trunc);
+	}
+	this->ExpectLoaded(false);
+}
\ No newline at end of file
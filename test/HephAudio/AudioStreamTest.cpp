@@ -0,0 +1,142 @@
+#include "gtest/gtest.h"
+#include "AudioStream.h"
+#include "PcmAudioDecoder.h"
+#include "WavAudioEncoder.h"
+#include "NativeAudio/NullAudio.h"
+#include "TestSignals.h"
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+using namespace Heph;
+using namespace HephAudio;
+using namespace HephAudio::Native;
+
+static const AudioFormatInfo TEST_FORMAT(HEPHAUDIO_FORMAT_TAG_IEEE_FLOAT, 32, HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+
+static void WriteTestFile(const std::filesystem::path& filePath, const AudioBuffer& buffer)
+{
+	WavAudioEncoder encoder(filePath, TEST_FORMAT, true);
+	encoder.Encode(buffer);
+}
+
+static void OnNextFileStarted(const EventParams& eventParams)
+{
+	std::atomic<size_t>* pCounter = (std::atomic<size_t>*)eventParams.userEventArgs["counter"];
+	(*pCounter)++;
+}
+
+// plays the first file followed by the queued one, returns the rendered frames.
+static AudioBuffer RenderSplice(const std::filesystem::path& firstFilePath, const std::filesystem::path& nextFilePath, size_t renderFrameCount, uint32_t crossfadeDuration_ms, size_t& eventCount)
+{
+	const std::filesystem::path renderFilePath = std::filesystem::temp_directory_path() / "HephAudioStreamTestRender.wav";
+	std::shared_ptr<NullAudio> pNullAudio = std::make_shared<NullAudio>();
+	std::atomic<size_t> counter(0);
+
+	NullAudioParams params;
+	params.clock = NullAudioClock::FreeRunning;
+	params.renderFilePath = renderFilePath;
+	pNullAudio->SetNativeParams(params);
+
+	{
+		AudioStream stream(pNullAudio, firstFilePath);
+		stream.SetCrossfadeDuration(crossfadeDuration_ms);
+		stream.OnNextFileStarted = &OnNextFileStarted;
+		stream.OnNextFileStarted.userEventArgs.Add("counter", &counter);
+
+		stream.QueueNextFile(nextFilePath);
+		EXPECT_EQ(stream.GetNextFile(), nextFilePath);
+		while (!stream.IsNextFileReady())
+		{
+			std::this_thread::yield();
+		}
+
+		stream.Start();
+		pNullAudio->InitializeRender(nullptr, TEST_FORMAT);
+		while (pNullAudio->GetRenderedFrameCount() < renderFrameCount)
+		{
+			std::this_thread::yield();
+		}
+		pNullAudio->StopRendering();
+
+		EXPECT_TRUE(stream.GetNextFile().empty());
+	}
+
+	eventCount = counter;
+
+	PcmAudioDecoder decoder(nullptr);
+	decoder.ChangeFile(renderFilePath);
+	AudioBuffer result = decoder.Decode();
+	decoder.CloseFile();
+	std::filesystem::remove(renderFilePath);
+
+	return result;
+}
+
+TEST(AudioStreamTest, Gapless)
+{
+	const std::filesystem::path firstFilePath = std::filesystem::temp_directory_path() / "HephAudioStreamTest1.wav";
+	const std::filesystem::path nextFilePath = std::filesystem::temp_directory_path() / "HephAudioStreamTest2.wav";
+	const AudioBuffer firstBuffer = TestSignals::CreateStereoBuffer(12345, 0.01, 0.01, 0.5, 0.5);
+	const AudioBuffer nextBuffer = TestSignals::CreateStereoBuffer(30000, 0.03, 0.03, 0.5, 0.5);
+	WriteTestFile(firstFilePath, firstBuffer);
+	WriteTestFile(nextFilePath, nextBuffer);
+
+	size_t eventCount = 0;
+	const AudioBuffer rendered = RenderSplice(firstFilePath, nextFilePath, firstBuffer.FrameCount() + nextBuffer.FrameCount(), 0, eventCount);
+	ASSERT_GE(rendered.FrameCount(), firstBuffer.FrameCount() + nextBuffer.FrameCount());
+	EXPECT_EQ(eventCount, 1);
+
+	// the first frame of the next file directly follows the last frame of the first one.
+	for (size_t i = 0; i < firstBuffer.FrameCount(); ++i)
+	{
+		ASSERT_EQ(rendered[i][0], firstBuffer[i][0]);
+		ASSERT_EQ(rendered[i][1], firstBuffer[i][1]);
+	}
+	for (size_t i = 0; i < nextBuffer.FrameCount(); ++i)
+	{
+		ASSERT_EQ(rendered[firstBuffer.FrameCount() + i][0], nextBuffer[i][0]);
+		ASSERT_EQ(rendered[firstBuffer.FrameCount() + i][1], nextBuffer[i][1]);
+	}
+
+	std::filesystem::remove(firstFilePath);
+	std::filesystem::remove(nextFilePath);
+}
+
+TEST(AudioStreamTest, Crossfade)
+{
+	const std::filesystem::path firstFilePath = std::filesystem::temp_directory_path() / "HephAudioStreamTest1.wav";
+	const std::filesystem::path nextFilePath = std::filesystem::temp_directory_path() / "HephAudioStreamTest2.wav";
+	const AudioBuffer firstBuffer = TestSignals::CreateStereoBuffer(12345, 0.01, 0.01, 0.5, 0.5);
+	const AudioBuffer nextBuffer = TestSignals::CreateStereoBuffer(30000, 0.03, 0.03, 0.5, 0.5);
+	WriteTestFile(firstFilePath, firstBuffer);
+	WriteTestFile(nextFilePath, nextBuffer);
+
+	constexpr uint32_t crossfadeDuration_ms = 100;
+	const size_t crossfadeFrameCount = TEST_FORMAT.sampleRate * crossfadeDuration_ms / 1000;
+	const size_t crossfadeStart = firstBuffer.FrameCount() - crossfadeFrameCount;
+
+	size_t eventCount = 0;
+	const AudioBuffer rendered = RenderSplice(firstFilePath, nextFilePath, crossfadeStart + nextBuffer.FrameCount(), crossfadeDuration_ms, eventCount);
+	ASSERT_GE(rendered.FrameCount(), crossfadeStart + nextBuffer.FrameCount());
+	EXPECT_EQ(eventCount, 1);
+
+	for (size_t i = 0; i < crossfadeStart; ++i)
+	{
+		ASSERT_EQ(rendered[i][0], firstBuffer[i][0]);
+	}
+
+	// both files contribute to the crossfade region.
+	const size_t middle = crossfadeStart + crossfadeFrameCount / 2;
+	const double expected = (HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(firstBuffer[middle][0]) + HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(nextBuffer[crossfadeFrameCount / 2][0])) * cos(HEPH_MATH_PI / 4);
+	EXPECT_NEAR(HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(rendered[middle][0]), expected, 1e-3);
+
+	for (size_t i = crossfadeFrameCount; i < nextBuffer.FrameCount(); ++i)
+	{
+		ASSERT_EQ(rendered[crossfadeStart + i][0], nextBuffer[i][0]);
+		ASSERT_EQ(rendered[crossfadeStart + i][1], nextBuffer[i][1]);
+	}
+
+	std::filesystem::remove(firstFilePath);
+	std::filesystem::remove(nextFilePath);
+}
\ No newline at end of file
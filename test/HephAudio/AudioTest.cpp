@@ -7,8 +7,17 @@
 #include "NativeAudio/WinAudio.h"
 #include "NativeAudio/WinAudioDS.h"
 #include "NativeAudio/WinAudioMME.h"
+#include "NativeAudio/NullAudio.h"
+#include "PcmAudioDecoder.h"
+#include "WavAudioEncoder.h"
+#include "AudioEvents/AudioCaptureEventArgs.h"
+#include "AudioEvents/AudioRenderEventArgs.h"
 #include "Exceptions/InvalidArgumentException.h"
+#include "Exceptions/NotFoundException.h"
 #include "TestFiles.h"
+#include <atomic>
+#include <fstream>
+#include <thread>
 
 using namespace Heph;
 using namespace HephAudio;
@@ -105,6 +114,11 @@ TEST(AudioTest, Constructors)
 	}
 
 #endif
+
+	{
+		Audio audio(AudioAPI::Headless);
+		EXPECT_TRUE(dynamic_cast<NullAudio*>(audio.GetNativeAudio().get()) != nullptr);
+	}
 }
 
 TEST(AudioTest, DecoderEncoder)
@@ -140,6 +154,139 @@ TEST(AudioTest, PlayLoad)
 	}
 }
 
+TEST(AudioTest, AssetCache)
+{
+	Audio audio(AudioAPI::Headless);
+	EXPECT_EQ(audio.GetAssetCache(), nullptr);
+
+	const std::filesystem::path filePath = std::filesystem::temp_directory_path() / "HephAudioAssetCacheLoadTest.wav";
+	{
+		WavAudioEncoder encoder(filePath, AudioFormatInfo(HEPHAUDIO_FORMAT_TAG_PCM, 16, HEPHAUDIO_CH_LAYOUT_STEREO, 48000), true);
+		encoder.Encode(AudioBuffer(480, HEPHAUDIO_CH_LAYOUT_STEREO, 48000));
+	}
+
+	// objects own their data unless a cache is set.
+	AudioObject* pAudioObject = audio.Load(filePath);
+	EXPECT_EQ(pAudioObject->buffer.FrameCount(), 480);
+	EXPECT_EQ(pAudioObject->pSharedBuffer, nullptr);
+	audio.DestroyAudioObject(pAudioObject);
+
+	audio.SetAssetCache(std::make_shared<AudioAssetCache>());
+	AudioObject* pFirstObject = audio.Load(filePath);
+	AudioObject* pSecondObject = audio.Load(filePath);
+	ASSERT_NE(pFirstObject->pSharedBuffer, nullptr);
+	EXPECT_EQ(pFirstObject->pSharedBuffer, pSecondObject->pSharedBuffer);
+	EXPECT_TRUE(pFirstObject->buffer.IsEmpty());
+	EXPECT_EQ(pFirstObject->GetBuffer().FrameCount(), 480);
+
+	audio.DestroyAudioObject(pFirstObject);
+	audio.DestroyAudioObject(pSecondObject);
+	std::filesystem::remove(filePath);
+}
+
+TEST(AudioTest, PlayLoadAsync)
+{
+	Audio audio(AudioAPI::Headless);
+
+	std::atomic<size_t> decoderCount(0);
+	audio.SetAudioDecoderFactory([&decoderCount]()
+		{
+			decoderCount++;
+			return std::make_shared<PcmAudioDecoder>(nullptr);
+		});
+	EXPECT_THROW(audio.SetAudioDecoderFactory(nullptr), InvalidArgumentException);
+
+	const std::filesystem::path filePath = std::filesystem::temp_directory_path() / "HephAudioLoadAsyncTest.wav";
+	{
+		AudioBuffer buffer(4800, HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+		buffer[100][0] = HEPH_AUDIO_SAMPLE_FROM_IEEE_FLT(0.5);
+		WavAudioEncoder encoder(filePath, AudioFormatInfo(HEPHAUDIO_FORMAT_TAG_IEEE_FLOAT, 32, HEPHAUDIO_CH_LAYOUT_STEREO, 48000), true);
+		encoder.Encode(buffer);
+	}
+
+	std::future<AudioObject*> playFuture = audio.PlayAsync(filePath, 5);
+	std::future<AudioObject*> loadFuture = audio.LoadAsync(filePath, 10);
+	std::future<AudioObject*> missingFuture = audio.LoadAsync(filePath.string() + ".missing");
+
+	AudioObject* pPlayObject = playFuture.get();
+	ASSERT_TRUE(audio.AudioObjectExists(pPlayObject));
+	EXPECT_EQ(pPlayObject->playCount, 5);
+	EXPECT_FALSE(pPlayObject->isPaused);
+	EXPECT_EQ(pPlayObject->name, filePath.filename().string());
+	EXPECT_EQ(pPlayObject->buffer.FrameCount(), 4800);
+	EXPECT_EQ(pPlayObject->buffer[100][0], HEPH_AUDIO_SAMPLE_FROM_IEEE_FLT(0.5));
+
+	AudioObject* pLoadObject = loadFuture.get();
+	ASSERT_TRUE(audio.AudioObjectExists(pLoadObject));
+	EXPECT_EQ(pLoadObject->playCount, 10);
+	EXPECT_TRUE(pLoadObject->isPaused);
+	EXPECT_EQ(pLoadObject->buffer.FrameCount(), 4800);
+
+	EXPECT_THROW(missingFuture.get(), NotFoundException);
+	EXPECT_EQ(audio.GetAudioObjectCount(), 2);
+
+	// each load that reached the decoder used its own instance.
+	EXPECT_EQ(decoderCount, 2);
+
+	audio.DestroyAudioObject(pPlayObject);
+	audio.DestroyAudioObject(pLoadObject);
+	std::filesystem::remove(filePath);
+}
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+namespace
+{
+	struct FireAndForget
+	{
+		struct promise_type
+		{
+			FireAndForget get_return_object() { return {}; }
+			std::suspend_never initial_suspend() noexcept { return {}; }
+			std::suspend_never final_suspend() noexcept { return {}; }
+			void return_void() {}
+			void unhandled_exception() {}
+		};
+	};
+
+	FireAndForget AwaitLoad(Audio& audio, std::filesystem::path filePath, std::promise<AudioObject*>& result)
+	{
+		try
+		{
+			result.set_value(co_await audio.AwaitLoad(filePath, 3));
+		}
+		catch (...)
+		{
+			result.set_exception(std::current_exception());
+		}
+	}
+}
+
+TEST(AudioTest, AwaitLoad)
+{
+	Audio audio(AudioAPI::Headless);
+
+	const std::filesystem::path filePath = std::filesystem::temp_directory_path() / "HephAudioAwaitLoadTest.wav";
+	{
+		WavAudioEncoder encoder(filePath, AudioFormatInfo(HEPHAUDIO_FORMAT_TAG_PCM, 16, HEPHAUDIO_CH_LAYOUT_STEREO, 48000), true);
+		encoder.Encode(AudioBuffer(480, HEPHAUDIO_CH_LAYOUT_STEREO, 48000));
+	}
+
+	std::promise<AudioObject*> result;
+	AwaitLoad(audio, filePath, result);
+	AudioObject* pAudioObject = result.get_future().get();
+	ASSERT_TRUE(audio.AudioObjectExists(pAudioObject));
+	EXPECT_EQ(pAudioObject->playCount, 3);
+	EXPECT_TRUE(pAudioObject->isPaused);
+
+	std::promise<AudioObject*> missingResult;
+	AwaitLoad(audio, filePath.string() + ".missing", missingResult);
+	EXPECT_THROW(missingResult.get_future().get(), NotFoundException);
+
+	audio.DestroyAudioObject(pAudioObject);
+	std::filesystem::remove(filePath);
+}
+#endif
+
 TEST(AudioTest, AudioObject)
 {
 	Audio audio;
@@ -216,4 +363,487 @@ TEST(AudioTest, DeviceEnumPeriod)
 	EXPECT_EQ(audio.GetDeviceEnumerationPeriod(), 100);
 	audio.SetDeviceEnumerationPeriod(300);
 	EXPECT_EQ(audio.GetDeviceEnumerationPeriod(), 300);
+}
+
+TEST(AudioTest, Headless)
+{
+	Audio audio(AudioAPI::Headless);
+	NullAudio* pNullAudio = dynamic_cast<NullAudio*>(audio.GetNativeAudio().get());
+	ASSERT_TRUE(pNullAudio != nullptr);
+
+	EXPECT_EQ(audio.GetAudioDevices(AudioDeviceType::Render).size(), 1);
+	EXPECT_EQ(audio.GetAudioDevices(AudioDeviceType::Capture).size(), 1);
+
+	const std::filesystem::path renderFilePath = std::filesystem::temp_directory_path() / "HephAudioHeadlessTest.wav";
+	NullAudioParams params;
+	params.clock = NullAudioClock::FreeRunning;
+	params.renderFilePath = renderFilePath;
+	audio.SetNativeParams(params);
+
+	// formats with more than 2 channels or more than 16 bits are written as WAVE_FORMAT_EXTENSIBLE.
+	for (const AudioFormatInfo& format : {
+		AudioFormatInfo(HEPHAUDIO_FORMAT_TAG_PCM, 16, HEPHAUDIO_CH_LAYOUT_STEREO, 48000),
+		AudioFormatInfo(HEPHAUDIO_FORMAT_TAG_PCM, 24, HEPHAUDIO_CH_LAYOUT_STEREO, 44100),
+		AudioFormatInfo(HEPHAUDIO_FORMAT_TAG_IEEE_FLOAT, 32, HEPHAUDIO_CH_LAYOUT_QUAD, 48000) })
+	{
+		audio.InitializeRender(format);
+		while (pNullAudio->GetRenderedFrameCount() < format.sampleRate / 10)
+		{
+			std::this_thread::yield();
+		}
+		audio.StopRendering();
+
+		const uint64_t dataSize = pNullAudio->GetRenderedFrameCount() * format.FrameSize();
+		EXPECT_EQ(std::filesystem::file_size(renderFilePath), WavAudioEncoder::CreateHeader(format, dataSize, true).size() + dataSize + (dataSize & 1));
+
+		// format tag of the fmt chunk, after the RIFF header and the JUNK chunk.
+		uint8_t formatTag[2] = { 0, 0 };
+		std::ifstream(renderFilePath, std::ios::binary).seekg(56).read((char*)formatTag, sizeof(formatTag));
+		const bool isExtensible = format.channelLayout.count > 2 || format.bitsPerSample > 16;
+		EXPECT_EQ(formatTag[0] | (formatTag[1] << 8), isExtensible ? HEPHAUDIO_FORMAT_TAG_EXTENSIBLE : format.formatTag);
+
+		PcmAudioDecoder decoder(nullptr);
+		decoder.ChangeFile(renderFilePath);
+		EXPECT_EQ(decoder.GetFileFormatInfo().formatTag, format.formatTag);
+		EXPECT_EQ(decoder.GetFileFormatInfo().bitsPerSample, format.bitsPerSample);
+		EXPECT_EQ(decoder.GetFileFormatInfo().channelLayout, format.channelLayout);
+		EXPECT_EQ(decoder.GetFileFormatInfo().sampleRate, format.sampleRate);
+		EXPECT_EQ(decoder.GetFrameCount(), pNullAudio->GetRenderedFrameCount());
+		decoder.CloseFile();
+		std::filesystem::remove(renderFilePath);
+	}
+
+	{
+		const AudioFormatInfo format(HEPHAUDIO_FORMAT_TAG_IEEE_FLOAT, 32, HEPHAUDIO_CH_LAYOUT_MONO, 48000);
+		audio.InitializeCapture(format);
+		while (audio.GetCaptureRingBuffer().GetReadableFrameCount() < 480)
+		{
+			std::this_thread::yield();
+		}
+		audio.StopCapturing();
+
+		AudioBuffer buffer(480, format.channelLayout, format.sampleRate);
+		buffer[0][0] = 1;
+		EXPECT_EQ(audio.GetCaptureRingBuffer().Read(buffer), 480);
+		EXPECT_EQ(buffer, AudioBuffer(480, format.channelLayout, format.sampleRate));
+	}
+}
+
+struct CaptureEventState
+{
+	bool takeBuffer = false;
+	AudioBuffer takenBuffer;
+	const heph_audio_sample_t* pFirstBuffer = nullptr;
+	bool isSameBuffer = true;
+	bool isFullPeriod = true;
+	size_t eventCount = 0;
+};
+
+TEST(AudioTest, Capture)
+{
+	Audio audio(AudioAPI::Headless);
+
+	for (const std::filesystem::path& path : TestFiles::wavFiles)
+	{
+		if (std::filesystem::exists(path))
+		{
+			NullAudioParams params;
+			params.clock = NullAudioClock::FreeRunning;
+			params.captureFilePath = path;
+			audio.SetNativeParams(params);
+
+			const Endian otherEndian = HEPH_SYSTEM_ENDIAN == Endian::Little ? Endian::Big : Endian::Little;
+			const AudioFormatInfo formats[2] =
+			{
+				AudioFormatInfo(HEPHAUDIO_FORMAT_TAG_PCM, 16, HEPHAUDIO_CH_LAYOUT_STEREO, 48000, HEPH_SYSTEM_ENDIAN),
+				AudioFormatInfo(HEPHAUDIO_FORMAT_TAG_PCM, 16, HEPHAUDIO_CH_LAYOUT_STEREO, 48000, otherEndian)
+			};
+			AudioBuffer capturedBuffers[2];
+
+			for (size_t i = 0; i < 2; ++i)
+			{
+				// the handlers get the same preallocated period buffer each time unless a handler takes it.
+				CaptureEventState state;
+				state.takeBuffer = i == 1;
+				audio.OnCapture = [](const EventParams& eventParams)
+					{
+						CaptureEventState* pState = (CaptureEventState*)eventParams.userEventArgs["state"];
+						AudioBuffer& captureBuffer = ((AudioCaptureEventArgs*)eventParams.pArgs)->captureBuffer;
+						if (pState->pFirstBuffer == nullptr)
+						{
+							pState->pFirstBuffer = captureBuffer.begin();
+						}
+						pState->isSameBuffer = pState->isSameBuffer && captureBuffer.begin() == pState->pFirstBuffer;
+						pState->isFullPeriod = pState->isFullPeriod && captureBuffer.FrameCount() == 480;
+						pState->eventCount++;
+
+						if (pState->takeBuffer)
+						{
+							pState->takenBuffer = std::move(captureBuffer);
+						}
+					};
+				audio.OnCapture.userEventArgs.Add("state", &state);
+
+				audio.InitializeCapture(formats[i]);
+				while (audio.GetCaptureRingBuffer().GetReadableFrameCount() < 4800)
+				{
+					std::this_thread::yield();
+				}
+				audio.StopCapturing();
+				audio.OnCapture.ClearAll();
+
+				EXPECT_GE(state.eventCount, 10);
+				EXPECT_TRUE(state.isFullPeriod);
+				EXPECT_EQ(state.isSameBuffer, !state.takeBuffer);
+
+				capturedBuffers[i] = AudioBuffer(4800, formats[i].channelLayout, formats[i].sampleRate);
+				EXPECT_EQ(audio.GetCaptureRingBuffer().Read(capturedBuffers[i]), 4800);
+			}
+
+			// the other byte order is swapped back before the conversion.
+			EXPECT_EQ(capturedBuffers[0], capturedBuffers[1]);
+			EXPECT_NE(capturedBuffers[0], AudioBuffer(4800, formats[0].channelLayout, formats[0].sampleRate));
+			return;
+		}
+	}
+}
+
+TEST(AudioTest, VoiceManagement)
+{
+	Audio audio(AudioAPI::Headless);
+	NullAudio* pNullAudio = dynamic_cast<NullAudio*>(audio.GetNativeAudio().get());
+	ASSERT_TRUE(pNullAudio != nullptr);
+
+	EXPECT_EQ(audio.GetMaxRealVoiceCount(), 0);
+	EXPECT_EQ(audio.GetVoiceStealingPolicy(), StealQuietest);
+	EXPECT_EQ(audio.GetVirtualVolumeThreshold(), 0.0);
+
+	const std::filesystem::path renderFilePath = std::filesystem::temp_directory_path() / "HephAudioVoiceTest.wav";
+	const AudioFormatInfo format(HEPHAUDIO_FORMAT_TAG_IEEE_FLOAT, 32, HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+	NullAudioParams params;
+	params.clock = NullAudioClock::FreeRunning;
+	params.renderFilePath = renderFilePath;
+	audio.SetNativeParams(params);
+
+	// each object plays a constant value, so the rendered audio shows which objects are mixed.
+	constexpr size_t objectCount = 10;
+	std::vector<AudioObject*> audioObjects;
+	for (size_t i = 0; i < objectCount; ++i)
+	{
+		AudioObject* pAudioObject = audio.CreateAudioObject("voice" + std::to_string(i), format.sampleRate * 10, format.channelLayout, format.sampleRate);
+		for (size_t j = 0; j < pAudioObject->buffer.FrameCount(); ++j)
+		{
+			pAudioObject->buffer[j][0] = HEPH_AUDIO_SAMPLE_FROM_IEEE_FLT(0.01 * (i + 1));
+			pAudioObject->buffer[j][1] = HEPH_AUDIO_SAMPLE_FROM_IEEE_FLT(0.01 * (i + 1));
+		}
+		pAudioObject->priority = (int32_t)i;
+		pAudioObject->playCount = HEPHAUDIO_INFINITE_LOOP;
+		pAudioObject->isPaused = false;
+		audioObjects.push_back(pAudioObject);
+	}
+
+	// the highest priority objects are silent or too far away, hence virtual regardless of the limit.
+	audioObjects[9]->volume = 0;
+	audioObjects[8]->distance = 20;
+	audioObjects[8]->maxDistance = 10;
+	audio.SetMaxRealVoiceCount(3);
+
+	audio.InitializeRender(format);
+	while (pNullAudio->GetRenderedFrameCount() < format.sampleRate)
+	{
+		std::this_thread::yield();
+	}
+	audio.StopRendering();
+
+	const RenderMetrics& metrics = audio.GetRenderMetrics();
+	EXPECT_EQ(metrics.GetRealVoiceCount(), 3);
+	EXPECT_EQ(metrics.GetVirtualVoiceCount(), 7);
+	EXPECT_EQ(metrics.GetStolenVoiceCount(), 0);
+
+	for (size_t i = 0; i < objectCount; ++i)
+	{
+		EXPECT_EQ(audioObjects[i]->isVirtual, i < 5 || i > 7);
+
+		// virtual objects keep their position.
+		EXPECT_EQ(audioObjects[i]->frameIndex, audioObjects[0]->frameIndex);
+	}
+
+	{
+		PcmAudioDecoder decoder(nullptr);
+		decoder.ChangeFile(renderFilePath);
+		const AudioBuffer rendered = decoder.Decode();
+		decoder.CloseFile();
+		std::filesystem::remove(renderFilePath);
+
+		ASSERT_GT(rendered.FrameCount(), 1000);
+		EXPECT_NEAR(HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(rendered[1000][0]), (0.06 + 0.07 + 0.08) / 3, 1e-6);
+	}
+
+	for (AudioObject* pAudioObject : audioObjects)
+	{
+		audio.DestroyAudioObject(pAudioObject);
+	}
+
+	// an object that goes out of range while playing is faded out in the next period.
+	{
+		constexpr size_t periodSize = 480;
+		constexpr double value = 0.5;
+		audio.SetMaxRealVoiceCount(0);
+
+		AudioObject* pAudioObject = audio.CreateAudioObject("moving", format.sampleRate * 10, format.channelLayout, format.sampleRate);
+		for (size_t j = 0; j < pAudioObject->buffer.FrameCount(); ++j)
+		{
+			pAudioObject->buffer[j][0] = HEPH_AUDIO_SAMPLE_FROM_IEEE_FLT(value);
+			pAudioObject->buffer[j][1] = HEPH_AUDIO_SAMPLE_FROM_IEEE_FLT(value);
+		}
+		pAudioObject->maxDistance = 10;
+		pAudioObject->playCount = HEPHAUDIO_INFINITE_LOOP;
+		pAudioObject->OnRender += [](const EventParams& eventParams)
+			{
+				AudioObject* pAudioObject = ((AudioRenderEventArgs*)eventParams.pArgs)->pAudioObject;
+				if (pAudioObject->frameIndex >= periodSize * 10)
+				{
+					pAudioObject->distance = 20;
+				}
+			};
+		pAudioObject->isPaused = false;
+
+		audio.InitializeRender(format);
+		while (pNullAudio->GetRenderedFrameCount() < periodSize * 20)
+		{
+			std::this_thread::yield();
+		}
+		audio.StopRendering();
+		EXPECT_TRUE(pAudioObject->isVirtual);
+
+		PcmAudioDecoder decoder(nullptr);
+		decoder.ChangeFile(renderFilePath);
+		const AudioBuffer rendered = decoder.Decode();
+		decoder.CloseFile();
+		std::filesystem::remove(renderFilePath);
+
+		ASSERT_GE(rendered.FrameCount(), periodSize * 12);
+		for (size_t i = 0; i < periodSize * 10; ++i)
+		{
+			ASSERT_NEAR(HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(rendered[i][0]), value, 1e-6);
+		}
+		for (size_t j = 0; j < periodSize; ++j)
+		{
+			ASSERT_NEAR(HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(rendered[periodSize * 10 + j][0]), value * (periodSize - j - 1.0) / periodSize, 1e-6);
+		}
+		for (size_t i = periodSize * 11; i < rendered.FrameCount(); ++i)
+		{
+			ASSERT_EQ(HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(rendered[i][0]), 0);
+		}
+
+		audio.DestroyAudioObject(pAudioObject);
+	}
+}
+
+struct ReplaceEventState
+{
+	AudioObject* pDestroyedObject = nullptr;
+	AudioObject* pCreatedObject = nullptr;
+};
+
+static AudioObject* CreateConstantObject(Audio& audio, const AudioFormatInfo& format, double value)
+{
+	AudioObject* pAudioObject = audio.CreateAudioObject("constant", format.sampleRate, format.channelLayout, format.sampleRate);
+	for (size_t j = 0; j < pAudioObject->buffer.FrameCount(); ++j)
+	{
+		pAudioObject->buffer[j][0] = HEPH_AUDIO_SAMPLE_FROM_IEEE_FLT(value);
+		pAudioObject->buffer[j][1] = HEPH_AUDIO_SAMPLE_FROM_IEEE_FLT(value);
+	}
+	pAudioObject->playCount = HEPHAUDIO_INFINITE_LOOP;
+	pAudioObject->isPaused = false;
+	return pAudioObject;
+}
+
+TEST(AudioTest, ReplaceInHandler)
+{
+	Audio audio(AudioAPI::Headless);
+	NullAudio* pNullAudio = dynamic_cast<NullAudio*>(audio.GetNativeAudio().get());
+	ASSERT_TRUE(pNullAudio != nullptr);
+
+	constexpr size_t periodSize = 480;
+	const std::filesystem::path renderFilePath = std::filesystem::temp_directory_path() / "HephAudioReplaceInHandlerTest.wav";
+	const AudioFormatInfo format(HEPHAUDIO_FORMAT_TAG_IEEE_FLOAT, 32, HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+	NullAudioParams params;
+	params.clock = NullAudioClock::FreeRunning;
+	params.renderFilePath = renderFilePath;
+	audio.SetNativeParams(params);
+
+	// the handler of the first object destroys the second one and creates another in its place,
+	// hence the number of objects does not change and the new object may reuse the memory of the destroyed one.
+	ReplaceEventState state;
+	AudioObject* pAudioObject = CreateConstantObject(audio, format, 0.1);
+	state.pDestroyedObject = CreateConstantObject(audio, format, 0.2);
+	pAudioObject->OnRender += [](const EventParams& eventParams)
+		{
+			ReplaceEventState* pState = (ReplaceEventState*)eventParams.userEventArgs["state"];
+			if (pState->pCreatedObject == nullptr)
+			{
+				Audio* pAudio = (Audio*)eventParams.userEventArgs["audio"];
+				const AudioFormatInfo format(HEPHAUDIO_FORMAT_TAG_IEEE_FLOAT, 32, HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+				pAudio->DestroyAudioObject(pState->pDestroyedObject);
+				pState->pCreatedObject = CreateConstantObject(*pAudio, format, 0.3);
+			}
+		};
+	pAudioObject->OnRender.userEventArgs.Add("state", &state);
+	pAudioObject->OnRender.userEventArgs.Add("audio", &audio);
+
+	audio.InitializeRender(format);
+	while (pNullAudio->GetRenderedFrameCount() < periodSize * 4)
+	{
+		std::this_thread::yield();
+	}
+	audio.StopRendering();
+
+	PcmAudioDecoder decoder(nullptr);
+	decoder.ChangeFile(renderFilePath);
+	const AudioBuffer rendered = decoder.Decode();
+	decoder.CloseFile();
+	std::filesystem::remove(renderFilePath);
+
+	// the destroyed object is skipped in the period it's destroyed, the new object is mixed from the next period on.
+	ASSERT_GE(rendered.FrameCount(), periodSize * 2);
+	EXPECT_NEAR(HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(rendered[periodSize / 2][0]), 0.1 / 2, 1e-6);
+	EXPECT_NEAR(HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(rendered[periodSize * 3 / 2][0]), (0.1 + 0.3) / 2, 1e-6);
+
+	audio.DestroyAudioObject(pAudioObject);
+	audio.DestroyAudioObject(state.pCreatedObject);
+}
+
+TEST(AudioTest, VoiceStealing)
+{
+	Audio audio(AudioAPI::Headless);
+	NullAudio* pNullAudio = dynamic_cast<NullAudio*>(audio.GetNativeAudio().get());
+	ASSERT_TRUE(pNullAudio != nullptr);
+
+	NullAudioParams params;
+	params.clock = NullAudioClock::FreeRunning;
+	audio.SetNativeParams(params);
+
+	const AudioFormatInfo format(HEPHAUDIO_FORMAT_TAG_IEEE_FLOAT, 32, HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+	auto render = [&audio, pNullAudio, &format]()
+		{
+			audio.InitializeRender(format);
+			while (pNullAudio->GetRenderedFrameCount() < format.sampleRate / 10)
+			{
+				std::this_thread::yield();
+			}
+			audio.StopRendering();
+		};
+
+	const double volumes[4] = { 1.0, 0.5, 0.8, 0.9 };
+	std::vector<AudioObject*> audioObjects;
+	for (size_t i = 0; i < 4; ++i)
+	{
+		AudioObject* pAudioObject = audio.CreateAudioObject("voice" + std::to_string(i), format.sampleRate, format.channelLayout, format.sampleRate);
+		pAudioObject->buffer[0][0] = 1;
+		pAudioObject->volume = volumes[i];
+		pAudioObject->playCount = HEPHAUDIO_INFINITE_LOOP;
+		pAudioObject->isPaused = false;
+		audioObjects.push_back(pAudioObject);
+	}
+	audio.SetMaxRealVoiceCount(2);
+
+	audio.SetVoiceStealingPolicy(StealNewest);
+	render();
+	EXPECT_FALSE(audioObjects[0]->isVirtual);
+	EXPECT_FALSE(audioObjects[1]->isVirtual);
+	EXPECT_TRUE(audioObjects[2]->isVirtual);
+	EXPECT_TRUE(audioObjects[3]->isVirtual);
+	EXPECT_EQ(audio.GetRenderMetrics().GetStolenVoiceCount(), 0);
+
+	// the playing objects are replaced by the newer ones.
+	audio.SetVoiceStealingPolicy(StealOldest);
+	render();
+	EXPECT_TRUE(audioObjects[0]->isVirtual);
+	EXPECT_TRUE(audioObjects[1]->isVirtual);
+	EXPECT_FALSE(audioObjects[2]->isVirtual);
+	EXPECT_FALSE(audioObjects[3]->isVirtual);
+	EXPECT_EQ(audio.GetRenderMetrics().GetStolenVoiceCount(), 2);
+
+	audio.SetVoiceStealingPolicy(StealQuietest);
+	render();
+	EXPECT_FALSE(audioObjects[0]->isVirtual);
+	EXPECT_TRUE(audioObjects[1]->isVirtual);
+	EXPECT_TRUE(audioObjects[2]->isVirtual);
+	EXPECT_FALSE(audioObjects[3]->isVirtual);
+	EXPECT_EQ(audio.GetRenderMetrics().GetStolenVoiceCount(), 3);
+
+	for (AudioObject* pAudioObject : audioObjects)
+	{
+		audio.DestroyAudioObject(pAudioObject);
+	}
+}
+
+TEST(AudioTest, Buses)
+{
+	Audio audio(AudioAPI::Headless);
+	NullAudio* pNullAudio = dynamic_cast<NullAudio*>(audio.GetNativeAudio().get());
+	ASSERT_TRUE(pNullAudio != nullptr);
+
+	EXPECT_EQ(audio.GetBusCount(), 1);
+	EXPECT_EQ(audio.GetBus(HEPHAUDIO_MASTER_BUS_NAME), audio.GetMasterBus());
+	EXPECT_THROW(audio.CreateBus(""), InvalidArgumentException);
+
+	AudioBus* pMusicBus = audio.CreateBus("music");
+	ASSERT_TRUE(pMusicBus != nullptr);
+	EXPECT_EQ(audio.GetBusCount(), 2);
+	pMusicBus->volume = 0.5;
+
+	EXPECT_TRUE(audio.CreateBus("temp") != nullptr);
+	EXPECT_TRUE(audio.DestroyBus("temp"));
+	EXPECT_FALSE(audio.DestroyBus(HEPHAUDIO_MASTER_BUS_NAME));
+
+	audio.SetBusThreadCount(2);
+	EXPECT_EQ(audio.GetBusThreadCount(), 2);
+
+	const std::filesystem::path renderFilePath = std::filesystem::temp_directory_path() / "HephAudioBusTest.wav";
+	const AudioFormatInfo format(HEPHAUDIO_FORMAT_TAG_IEEE_FLOAT, 32, HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+	NullAudioParams params;
+	params.clock = NullAudioClock::FreeRunning;
+	params.renderFilePath = renderFilePath;
+	audio.SetNativeParams(params);
+
+	// the first object plays through the music bus, the second one plays directly and sends a copy to the music bus.
+	const double values[2] = { 0.1, 0.2 };
+	for (size_t i = 0; i < 2; ++i)
+	{
+		AudioObject* pAudioObject = audio.CreateAudioObject("bus" + std::to_string(i), format.sampleRate * 10, format.channelLayout, format.sampleRate);
+		for (size_t j = 0; j < pAudioObject->buffer.FrameCount(); ++j)
+		{
+			pAudioObject->buffer[j][0] = HEPH_AUDIO_SAMPLE_FROM_IEEE_FLT(values[i]);
+			pAudioObject->buffer[j][1] = HEPH_AUDIO_SAMPLE_FROM_IEEE_FLT(values[i]);
+		}
+		pAudioObject->playCount = HEPHAUDIO_INFINITE_LOOP;
+		pAudioObject->isPaused = false;
+
+		if (i == 0)
+		{
+			pAudioObject->busName = "music";
+		}
+		else
+		{
+			pAudioObject->sends.push_back(AudioBusSend("music", 1.0));
+		}
+	}
+
+	audio.InitializeRender(format);
+	while (pNullAudio->GetRenderedFrameCount() < format.sampleRate)
+	{
+		std::this_thread::yield();
+	}
+	audio.StopRendering();
+
+	PcmAudioDecoder decoder(nullptr);
+	decoder.ChangeFile(renderFilePath);
+	const AudioBuffer rendered = decoder.Decode();
+	decoder.CloseFile();
+	std::filesystem::remove(renderFilePath);
+
+	ASSERT_GT(rendered.FrameCount(), 1000);
+	EXPECT_NEAR(HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(rendered[1000][0]), (0.1 / 2 + 0.2 / 2) * 0.5 + 0.2 / 2, 1e-6);
 }
\ No newline at end of file
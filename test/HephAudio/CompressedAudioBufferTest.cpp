@@ -0,0 +1,74 @@
+#include "gtest/gtest.h"
+#include "CompressedAudioBuffer.h"
+#include "TestSignals.h"
+#include "Exceptions/InvalidArgumentException.h"
+
+using namespace Heph;
+using namespace HephAudio;
+
+TEST(CompressedAudioBufferTest, Constructor)
+{
+	const AudioBuffer buffer = TestSignals::CreateStereoBuffer(5000, 0.05, 0.03);
+	const CompressedAudioBuffer compressedBuffer(buffer);
+
+	EXPECT_EQ(compressedBuffer.FrameCount(), 5000);
+	EXPECT_EQ(compressedBuffer.FormatInfo(), buffer.FormatInfo());
+	EXPECT_EQ(compressedBuffer.BlockFrameCount(), HEPHAUDIO_COMPRESSED_BUFFER_DEFAULT_BLOCK_FRAME_COUNT);
+	EXPECT_LT(compressedBuffer.Size() * 7, buffer.FrameCount() * buffer.FormatInfo().channelLayout.count * sizeof(heph_audio_sample_t));
+
+	EXPECT_THROW(CompressedAudioBuffer(buffer, 1024), InvalidArgumentException);
+	EXPECT_THROW(CompressedAudioBuffer(buffer, 1), InvalidArgumentException);
+}
+
+TEST(CompressedAudioBufferTest, Decode)
+{
+	const AudioBuffer buffer = TestSignals::CreateStereoBuffer(5000, 0.05, 0.03);
+	const CompressedAudioBuffer compressedBuffer(buffer, 255);
+	const AudioBuffer decodedBuffer = compressedBuffer.Decode();
+
+	ASSERT_EQ(decodedBuffer.FrameCount(), buffer.FrameCount());
+	for (size_t i = 0; i < buffer.FrameCount(); ++i)
+	{
+		EXPECT_NEAR(HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(decodedBuffer[i][0]), HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(buffer[i][0]), 0.02);
+		EXPECT_NEAR(HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(decodedBuffer[i][1]), HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(buffer[i][1]), 0.02);
+	}
+
+	// random access across the block boundaries must match the full decode, frames past the end are silent.
+	std::shared_ptr<CompressedAudioBuffer::DecoderState> pState = compressedBuffer.AcquireDecoderState();
+	AudioBuffer rangeBuffer(600, HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+	for (size_t frameIndex : { (size_t)4700, (size_t)100, (size_t)250, (size_t)0 })
+	{
+		compressedBuffer.Decode(frameIndex, rangeBuffer.FrameCount(), rangeBuffer.begin(), *pState);
+		for (size_t i = 0; i < rangeBuffer.FrameCount(); ++i)
+		{
+			const bool isInRange = (frameIndex + i) < decodedBuffer.FrameCount();
+			EXPECT_EQ(rangeBuffer[i][0], isInRange ? decodedBuffer[frameIndex + i][0] : 0);
+			EXPECT_EQ(rangeBuffer[i][1], isInRange ? decodedBuffer[frameIndex + i][1] : 0);
+		}
+	}
+}
+
+TEST(CompressedAudioBufferTest, DecoderStatePool)
+{
+	std::shared_ptr<CompressedAudioBuffer::DecoderState> pState3;
+	{
+		const CompressedAudioBuffer compressedBuffer(TestSignals::CreateStereoBuffer(2000, 0.05, 0.03));
+		EXPECT_EQ(compressedBuffer.GetIdleDecoderStateCount(), 0);
+
+		std::shared_ptr<CompressedAudioBuffer::DecoderState> pState1 = compressedBuffer.AcquireDecoderState();
+		std::shared_ptr<CompressedAudioBuffer::DecoderState> pState2 = compressedBuffer.AcquireDecoderState();
+		EXPECT_NE(pState1, pState2);
+
+		CompressedAudioBuffer::DecoderState* pRawState = pState2.get();
+		pState1 = nullptr;
+		pState2 = nullptr;
+		EXPECT_EQ(compressedBuffer.GetIdleDecoderStateCount(), 2);
+
+		pState3 = compressedBuffer.AcquireDecoderState();
+		EXPECT_EQ(pState3.get(), pRawState);
+		EXPECT_EQ(compressedBuffer.GetIdleDecoderStateCount(), 1);
+	}
+
+	// the pool outlives the buffer.
+	pState3 = nullptr;
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#include "gtest/gtest.h"
+#include "ConstantQTransform.h"
+#include "HephMath.h"
+#include "Exceptions/InvalidArgumentException.h"
+#include <cmath>
+#include <vector>
+
+using namespace Heph;
+using namespace HephAudio;
+
+TEST(ConstantQTransformTest, Constructor)
+{
+	const ConstantQTransform cqt(44100, 55.0, 7040.0, 12, 512);
+	EXPECT_EQ(cqt.GetBinCount(), 85);
+	EXPECT_EQ(cqt.GetBinsPerOctave(), 12);
+	EXPECT_EQ(cqt.GetHopSize(), 512);
+	EXPECT_NEAR(cqt.GetBinFrequency(12), 110.0, 1e-9);
+	EXPECT_NEAR(cqt.GetBinFrequency(84), 7040.0, 1e-6);
+	EXPECT_EQ(cqt.GetFFTSize(), 16384);
+
+	EXPECT_THROW(ConstantQTransform(44100, 0.0, 7040.0, 12, 512), InvalidArgumentException);
+	EXPECT_THROW(ConstantQTransform(44100, 55.0, 22050.0, 12, 512), InvalidArgumentException);
+	EXPECT_THROW(ConstantQTransform(44100, 55.0, 7040.0, 0, 512), InvalidArgumentException);
+}
+
+TEST(ConstantQTransformTest, Analyze)
+{
+	ConstantQTransform cqt(16000, 110.0, 3520.0, 12, 256);
+	const size_t binCount = cqt.GetBinCount();
+
+	for (size_t toneBin : { 20, 45 })
+	{
+		const double frequency = cqt.GetBinFrequency(toneBin);
+		AudioBuffer buffer(16000, HEPHAUDIO_CH_LAYOUT_MONO, 16000);
+		for (size_t i = 0; i < buffer.FrameCount(); ++i)
+		{
+			buffer[i][0] = HEPH_AUDIO_SAMPLE_FROM_IEEE_FLT(0.8 * sin(2.0 * HEPH_MATH_PI * frequency * i / 16000.0));
+		}
+
+		const size_t frameCount = cqt.CalculateFrameCount(buffer.FrameCount());
+		std::vector<double> magnitudes(frameCount * binCount);
+		cqt.SetThreadCount(1);
+		cqt.Analyze(buffer, 0, StftOutputType::Magnitude, magnitudes.data());
+
+		// a frame that's fully inside the tone peaks at the tone's bin with a quarter of its amplitude due to the Hann window.
+		const double* const pFrame = magnitudes.data() + 10 * binCount;
+		size_t peakBin = 0;
+		for (size_t k = 1; k < binCount; ++k)
+		{
+			if (pFrame[k] > pFrame[peakBin])
+			{
+				peakBin = k;
+			}
+		}
+		EXPECT_EQ(peakBin, toneBin);
+		EXPECT_NEAR(pFrame[peakBin], 0.2, 0.01);
+
+		std::vector<double> result(frameCount * binCount);
+		cqt.SetThreadCount(3);
+		cqt.Analyze(buffer, 0, StftOutputType::Magnitude, result.data());
+		for (size_t i = 0; i < result.size(); ++i)
+		{
+			ASSERT_NEAR(result[i], magnitudes[i], 1e-12);
+		}
+	}
+}
\ No newline at end of file
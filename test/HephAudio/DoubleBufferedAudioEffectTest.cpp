@@ -0,0 +1,100 @@
+#include "gtest/gtest.h"
+#include "AudioEffects/DoubleBufferedAudioEffect.h"
+#include "AudioEffects/Resampler.h"
+
+using namespace Heph;
+using namespace HephAudio;
+
+// adds twice the input to the output, like the effects that accumulate overlapping windows.
+class TestDoubleBufferedEffect : public DoubleBufferedAudioEffect
+{
+public:
+	std::string Name() const override
+	{
+		return "Test Double Buffered";
+	}
+
+	size_t ScratchFrameCount() const
+	{
+		return this->outputBuffer.FrameCount();
+	}
+
+protected:
+	void ProcessST(const AudioBuffer& inputBuffer, AudioBuffer& outputBuffer, size_t startIndex, size_t frameCount) override
+	{
+		const size_t channelCount = inputBuffer.FormatInfo().channelLayout.count;
+		for (size_t i = startIndex; i < startIndex + frameCount; ++i)
+		{
+			for (size_t j = 0; j < channelCount; ++j)
+			{
+				outputBuffer[i][j] += inputBuffer[i][j] * 2;
+			}
+		}
+	}
+};
+
+static AudioBuffer CreateRampBuffer(size_t frameCount)
+{
+	AudioBuffer buffer(frameCount, HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+	for (size_t i = 0; i < frameCount; ++i)
+	{
+		buffer[i][0] = HEPH_AUDIO_SAMPLE_FROM_IEEE_FLT(i * 1e-4);
+		buffer[i][1] = HEPH_AUDIO_SAMPLE_FROM_IEEE_FLT(-(i * 1e-4));
+	}
+	return buffer;
+}
+
+TEST(DoubleBufferedAudioEffectTest, Range)
+{
+	const AudioBuffer input = CreateRampBuffer(1000);
+	TestDoubleBufferedEffect effect;
+
+	for (size_t n = 0; n < 2; ++n)
+	{
+		AudioBuffer buffer = input;
+		effect.Process(buffer, 100, 500);
+		ASSERT_EQ(buffer.FrameCount(), input.FrameCount());
+
+		for (size_t i = 0; i < buffer.FrameCount(); ++i)
+		{
+			const double factor = (i >= 100 && i < 600) ? 2.0 : 1.0;
+			ASSERT_NEAR(HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(buffer[i][0]), HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(input[i][0]) * factor, 1e-6);
+			ASSERT_NEAR(HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(buffer[i][1]), HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(input[i][1]) * factor, 1e-6);
+		}
+	}
+}
+
+TEST(DoubleBufferedAudioEffectTest, Reuse)
+{
+	TestDoubleBufferedEffect effect;
+	AudioBuffer buffer = CreateRampBuffer(480);
+
+	// the processed range is copied back, the buffer keeps its storage.
+	const heph_audio_sample_t* pStorage = buffer.begin();
+	effect.Process(buffer);
+	effect.Process(buffer);
+	effect.Process(buffer);
+	EXPECT_EQ(buffer.begin(), pStorage);
+	EXPECT_EQ(effect.ScratchFrameCount(), 480);
+	EXPECT_NEAR(HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(buffer[100][0]), 100 * 1e-4 * 8, 1e-6);
+
+	// the temporary buffer ends at the end of the processed range and is released on reset.
+	effect.Process(buffer, 0, 200);
+	EXPECT_EQ(buffer.FrameCount(), 480);
+	EXPECT_EQ(effect.ScratchFrameCount(), 200);
+	effect.ResetInternalState();
+	EXPECT_EQ(effect.ScratchFrameCount(), 0);
+
+	// effects that change the shape create a new buffer.
+	Resampler resampler(24000);
+	resampler.Process(buffer);
+	EXPECT_EQ(buffer.FrameCount(), 240);
+	EXPECT_EQ(buffer.FormatInfo().sampleRate, 24000);
+
+	Resampler identity(24000);
+	const heph_audio_sample_t* pResampled = buffer.begin();
+	identity.Process(buffer);
+	identity.Process(buffer);
+	EXPECT_EQ(buffer.begin(), pResampled);
+	EXPECT_EQ(buffer.FrameCount(), 240);
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+#include "gtest/gtest.h"
+#include "AudioEffects/EffectChain.h"
+#include "AudioEffects/HardClipDistortion.h"
+#include "AudioEffects/LinearFadeIn.h"
+#include "AudioEffects/Resampler.h"
+#include "AudioEffects/Tremolo.h"
+#include "Oscillators/SineWaveOscillator.h"
+#include "TestSignals.h"
+#include "Exceptions/InvalidArgumentException.h"
+#include <cmath>
+
+using namespace Heph;
+using namespace HephAudio;
+
+static std::vector<std::shared_ptr<AudioEffect>> CreateTestEffects()
+{
+	return {
+		std::make_shared<LinearFadeIn>(0.05, 0.01),
+		std::make_shared<Tremolo>(0.5, SineWaveOscillator(1.0, 5.0, 48000, 0)),
+		std::make_shared<HardClipDistortion>(-3.0)
+	};
+}
+
+TEST(EffectChainTest, Effects)
+{
+	EffectChain chain;
+	EXPECT_EQ(chain.GetBlockFrameCount(), HEPHAUDIO_EFFECT_CHAIN_DEFAULT_BLOCK_FRAME_COUNT);
+	EXPECT_TRUE(chain.GetEffects().empty());
+	EXPECT_THROW(chain.AddEffect(nullptr), InvalidArgumentException);
+	EXPECT_THROW(chain.SetBlockFrameCount(0), InvalidArgumentException);
+
+	std::shared_ptr<AudioEffect> pFadeIn = std::make_shared<LinearFadeIn>(1.0);
+	std::shared_ptr<AudioEffect> pResampler = std::make_shared<Resampler>(24000);
+	chain.AddEffect(pResampler);
+	chain.InsertEffect(0, pFadeIn);
+	EXPECT_THROW(chain.InsertEffect(3, pFadeIn), InvalidArgumentException);
+	ASSERT_EQ(chain.GetEffects().size(), 2);
+	EXPECT_EQ(chain.GetEffects()[0], pFadeIn);
+	EXPECT_EQ(chain.GetEffects()[1], pResampler);
+
+	// the frame counts are negotiated through every effect.
+	const AudioFormatInfo formatInfo(HEPHAUDIO_FORMAT_TAG_IEEE_FLOAT, 32, HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+	EXPECT_EQ(chain.CalculateRequiredFrameCount(100, formatInfo), pResampler->CalculateRequiredFrameCount(100, formatInfo));
+	EXPECT_EQ(chain.CalculateAdvanceSize(100, formatInfo), pResampler->CalculateAdvanceSize(100, formatInfo));
+	EXPECT_EQ(chain.CalculateOutputFrameCount(100, formatInfo), 50);
+
+	chain.RemoveEffect(1);
+	EXPECT_THROW(chain.RemoveEffect(1), InvalidArgumentException);
+	ASSERT_EQ(chain.GetEffects().size(), 1);
+	EXPECT_EQ(chain.GetEffects()[0], pFadeIn);
+}
+
+TEST(EffectChainTest, Process)
+{
+	const AudioBuffer input = TestSignals::CreateStereoBuffer(10000, 0.01, 0.02, 0.9, 0.9);
+
+	AudioBuffer expected = input;
+	for (const std::shared_ptr<AudioEffect>& pEffect : CreateTestEffects())
+	{
+		pEffect->Process(expected);
+	}
+
+	// blocks that don't divide the buffer evenly give the same result as applying the effects one by one.
+	EffectChain chain(CreateTestEffects());
+	chain.SetBlockFrameCount(300);
+	AudioBuffer result = input;
+	chain.Process(result);
+
+	ASSERT_EQ(result.FrameCount(), expected.FrameCount());
+	for (size_t i = 0; i < result.FrameCount(); ++i)
+	{
+		ASSERT_NEAR(HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(result[i][0]), HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(expected[i][0]), 1e-6);
+		ASSERT_NEAR(HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(result[i][1]), HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(expected[i][1]), 1e-6);
+	}
+}
+
+TEST(EffectChainTest, FrameCountChange)
+{
+	const AudioBuffer input = TestSignals::CreateStereoBuffer(4800, 0.01, 0.02, 0.9, 0.9);
+
+	EffectChain chain({ std::make_shared<HardClipDistortion>(-3.0), std::make_shared<Resampler>(24000) });
+	chain.SetBlockFrameCount(256);
+
+	AudioBuffer result = input;
+	chain.Process(result);
+	ASSERT_EQ(result.FrameCount(), 2400);
+	EXPECT_EQ(result.FormatInfo().sampleRate, 24000);
+
+	// every other frame of the clipped input.
+	const double clippingLevel = pow(10.0, -3.0 / 20.0);
+	for (size_t i = 0; i < result.FrameCount(); ++i)
+	{
+		const double expected = HEPH_MATH_MIN(HEPH_MATH_MAX(HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(input[i * 2][0]), -clippingLevel), clippingLevel);
+		ASSERT_NEAR(HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(result[i][0]), expected, 1e-6);
+	}
+
+	// the rest of the buffer is kept when processing a range.
+	result = input;
+	chain.Process(result, 800, 3200);
+	ASSERT_EQ(result.FrameCount(), 800 + 1600 + 800);
+	EXPECT_EQ(result[799][0], input[799][0]);
+	EXPECT_EQ(result[800 + 1600][0], input[4000][0]);
+}
\ No newline at end of file
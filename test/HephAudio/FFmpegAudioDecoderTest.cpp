@@ -0,0 +1,130 @@
+#include "gtest/gtest.h"
+#include "FFmpeg/FFmpegAudioDecoder.h"
+#include "FFmpeg/FFmpegAudioEncoder.h"
+#include "HephMath.h"
+#include "Exceptions/Exception.h"
+#include <cmath>
+
+using namespace Heph;
+using namespace HephAudio;
+
+static constexpr double FREQUENCY = 250;
+static constexpr double AMPLITUDE = 0.5;
+
+// long enough to be split into 7 segments of at least 2^20 frames, not a multiple of the codec frame size so the last packet is padded.
+static constexpr size_t FRAME_COUNT = 7 * (1 << 20) + 12345;
+
+class FFmpegAudioDecoderTest : public testing::Test
+{
+protected:
+	std::filesystem::path filePath;
+
+protected:
+	void TearDown() override
+	{
+		if (!this->filePath.empty())
+		{
+			std::filesystem::remove(this->filePath);
+			std::filesystem::remove(AudioSeekIndex::GetIndexFilePath(this->filePath));
+		}
+	}
+
+	bool EncodeSine(const std::string& fileName, uint32_t formatTag, uint32_t sampleRate)
+	{
+		this->filePath = std::filesystem::temp_directory_path() / fileName;
+		try
+		{
+			FFmpegAudioEncoder encoder(this->filePath, AudioFormatInfo(formatTag, 16, HEPHAUDIO_CH_LAYOUT_MONO, sampleRate, 64000), true);
+
+			constexpr size_t chunkFrameCount = 1 << 16;
+			for (size_t i = 0; i < FRAME_COUNT; i += chunkFrameCount)
+			{
+				AudioBuffer chunk(HEPH_MATH_MIN(chunkFrameCount, FRAME_COUNT - i), HEPHAUDIO_CH_LAYOUT_MONO, sampleRate);
+				for (size_t j = 0; j < chunk.FrameCount(); ++j)
+				{
+					chunk[j][0] = HEPH_AUDIO_SAMPLE_FROM_IEEE_FLT(AMPLITUDE * sin(2.0 * HEPH_MATH_PI * FREQUENCY * (i + j) / sampleRate));
+				}
+				encoder.Encode(chunk);
+			}
+			encoder.CloseFile();
+		}
+		catch (const Exception&)
+		{
+			return false;
+		}
+		return true;
+	}
+
+	// the segments are seeked to with preroll, so each one must match the serial decode sample by sample.
+	// the frame count is not compared with FRAME_COUNT since it is estimated from the bit rate for some containers.
+	void TestDecodeParallel(bool checkPriming)
+	{
+		AudioBuffer expected;
+		{
+			FFmpegAudioDecoder decoder(this->filePath);
+			expected = decoder.Decode(0, decoder.GetFrameCount());
+			ASSERT_EQ(expected.FrameCount(), decoder.GetFrameCount());
+		}
+
+		// correlate the start of the output with the input to make sure the priming frames are not decoded.
+		if (checkPriming)
+		{
+			const uint32_t sampleRate = expected.FormatInfo().sampleRate;
+			const size_t periodFrameCount = (size_t)(sampleRate / FREQUENCY);
+			double re = 0.0, im = 0.0;
+			for (size_t i = 10 * periodFrameCount; i < 20 * periodFrameCount; ++i)
+			{
+				const double phase = 2.0 * HEPH_MATH_PI * FREQUENCY * i / sampleRate;
+				re += HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(expected[i][0]) * sin(phase);
+				im += HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(expected[i][0]) * cos(phase);
+			}
+			re *= 2.0 / (10 * periodFrameCount);
+			im *= 2.0 / (10 * periodFrameCount);
+			EXPECT_NEAR(sqrt(re * re + im * im), AMPLITUDE, 0.05);
+			EXPECT_NEAR(atan2(-im, re) * sampleRate / (2.0 * HEPH_MATH_PI * FREQUENCY), 0.0, 1.0);
+		}
+
+		for (size_t threadCount : { 1, 2, 7 })
+		{
+			FFmpegAudioDecoder decoder;
+			decoder.SetThreadCount(threadCount);
+			decoder.ChangeFile(this->filePath);
+
+			const AudioBuffer decodedBuffer = decoder.Decode();
+			ASSERT_EQ(decodedBuffer.FrameCount(), expected.FrameCount()) << "threadCount = " << threadCount;
+			ASSERT_EQ(decodedBuffer.FormatInfo().channelLayout, expected.FormatInfo().channelLayout) << "threadCount = " << threadCount;
+			if (threadCount > 1)
+			{
+				EXPECT_TRUE(decoder.HasSeekIndex()) << "threadCount = " << threadCount;
+			}
+
+			for (size_t i = 0; i < decodedBuffer.FrameCount(); ++i)
+			{
+				ASSERT_EQ(decodedBuffer[i][0], expected[i][0]) << "threadCount = " << threadCount << ", frameIndex = " << i;
+			}
+		}
+	}
+};
+
+TEST_F(FFmpegAudioDecoderTest, DecodeParallelAac)
+{
+	// mp4 cannot be seeked by byte offset, so the AAC stream is written as ADTS which is decoded in parallel.
+	if (!this->EncodeSine("HephAudioFFmpegAudioDecoderTest.aac", HEPHAUDIO_FORMAT_TAG_AAC, 16000))
+	{
+		GTEST_SKIP() << "FFmpeg cannot encode AAC.";
+	}
+
+	// ADTS does not store the encoder delay, so the priming frames are part of the stream.
+	this->TestDecodeParallel(false);
+}
+
+TEST_F(FFmpegAudioDecoderTest, DecodeParallelMp3)
+{
+	if (!this->EncodeSine("HephAudioFFmpegAudioDecoderTest.mp3", HEPHAUDIO_FORMAT_TAG_MP3, 22050))
+	{
+		GTEST_SKIP() << "FFmpeg cannot encode MP3.";
+	}
+
+	// the encoder delay is stored in the LAME header and trimmed by the demuxer.
+	this->TestDecodeParallel(true);
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+#include "gtest/gtest.h"
+#include "MfccExtractor.h"
+#include "PcmAudioDecoder.h"
+#include "WavAudioEncoder.h"
+#include "Windows/HannWindow.h"
+#include "Exceptions/InvalidArgumentException.h"
+#include <cmath>
+#include <string>
+#include <vector>
+
+using namespace Heph;
+using namespace HephAudio;
+
+static AudioBuffer CreateNoiseBuffer(size_t frameCount, uint32_t seed)
+{
+	AudioBuffer buffer(frameCount, HEPHAUDIO_CH_LAYOUT_STEREO, 16000);
+	for (size_t i = 0; i < frameCount; ++i)
+	{
+		seed = seed * 1664525 + 1013904223;
+		buffer[i][0] = HEPH_AUDIO_SAMPLE_FROM_IEEE_FLT(0.5 * sin(i * 0.3) + ((double)(seed >> 8) / (1 << 24) - 0.5) * 0.2);
+		buffer[i][1] = HEPH_AUDIO_SAMPLE_FROM_IEEE_FLT(0.3 * cos(i * 0.01));
+	}
+	return buffer;
+}
+
+TEST(MfccExtractorTest, Extract)
+{
+	const AudioBuffer buffer = CreateNoiseBuffer(4000, 1);
+	const MfccExtractor extractor(HannWindow(512), 160, 16000, 26, 13);
+	const size_t frameCount = extractor.CalculateFrameCount(buffer.FrameCount());
+	const size_t filterCount = extractor.GetFilterbank().GetFilterCount();
+	ASSERT_EQ(frameCount, 23);
+
+	std::vector<double> powerSpectra(frameCount * extractor.GetStftAnalyzer().GetBinCount());
+	extractor.GetStftAnalyzer().Analyze(buffer, 0, StftOutputType::Power, powerSpectra.data());
+
+	std::vector<double> energies(frameCount * filterCount);
+	extractor.ExtractLogEnergies(buffer, 0, energies.data());
+
+	std::vector<double> coefficients(frameCount * extractor.GetCoefficientCount());
+	extractor.Extract(buffer, 0, coefficients.data());
+
+	for (size_t i = 0; i < frameCount; ++i)
+	{
+		std::vector<double> expectedEnergies(filterCount);
+		extractor.GetFilterbank().Apply(powerSpectra.data() + i * extractor.GetStftAnalyzer().GetBinCount(), expectedEnergies.data());
+		for (size_t j = 0; j < filterCount; ++j)
+		{
+			ASSERT_NEAR(energies[i * filterCount + j], log(expectedEnergies[j]), 1e-9);
+		}
+
+		for (size_t j = 0; j < extractor.GetCoefficientCount(); ++j)
+		{
+			double expected = 0.0;
+			for (size_t k = 0; k < filterCount; ++k)
+			{
+				expected += energies[i * filterCount + k] * cos(HEPH_MATH_PI * j * (k + 0.5) / filterCount);
+			}
+			expected *= sqrt(((j == 0) ? 1.0 : 2.0) / filterCount);
+			ASSERT_NEAR(coefficients[i * extractor.GetCoefficientCount() + j], expected, 1e-9);
+		}
+	}
+
+	EXPECT_THROW(MfccExtractor(HannWindow(512), 160, 16000, 26, 27), InvalidArgumentException);
+	EXPECT_THROW(MfccExtractor(StftAnalyzer(HannWindow(512), 160), SpectralFilterbank(FrequencyScale::Mel, 26, 1024, 16000, 0, 8000), 13), InvalidArgumentException);
+}
+
+TEST(MfccExtractorTest, Files)
+{
+	std::vector<std::filesystem::path> filePaths;
+	std::vector<AudioBuffer> decodedBuffers;
+	for (size_t i = 0; i < 3; ++i)
+	{
+		filePaths.push_back(std::filesystem::temp_directory_path() / ("HephAudioMfccExtractorTest" + std::to_string(i) + ".wav"));
+		{
+			WavAudioEncoder encoder(filePaths.back(), AudioFormatInfo(HEPHAUDIO_FORMAT_TAG_PCM, 16, HEPHAUDIO_CH_LAYOUT_STEREO, 16000), true);
+			encoder.Encode(CreateNoiseBuffer(1000 + i * 20000, i + 1));
+		}
+
+		PcmAudioDecoder decoder(filePaths.back());
+		decodedBuffers.push_back(decoder.Decode());
+	}
+
+	MfccExtractor extractor(HannWindow(400), 160, 16000, 40, 20);
+	extractor.SetThreadCount(2);
+
+	const std::vector<std::vector<double>> results = extractor.Extract(filePaths, 1, []() { return std::make_shared<PcmAudioDecoder>(nullptr); });
+	ASSERT_EQ(results.size(), filePaths.size());
+
+	for (size_t i = 0; i < filePaths.size(); ++i)
+	{
+		std::vector<double> expected(extractor.CalculateFrameCount(decodedBuffers[i].FrameCount()) * extractor.GetCoefficientCount());
+		extractor.Extract(decodedBuffers[i], 1, expected.data());
+
+		ASSERT_EQ(results[i].size(), expected.size());
+		for (size_t j = 0; j < expected.size(); ++j)
+		{
+			ASSERT_NEAR(results[i][j], expected[j], 1e-9);
+		}
+	}
+
+	filePaths.push_back(std::filesystem::temp_directory_path() / "HephAudioMfccExtractorTestMissing.wav");
+	EXPECT_ANY_THROW(extractor.Extract(filePaths, 1, []() { return std::make_shared<PcmAudioDecoder>(nullptr); }));
+
+	for (size_t i = 0; i < decodedBuffers.size(); ++i)
+	{
+		std::filesystem::remove(filePaths[i]);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,244 @@
+#include "gtest/gtest.h"
+#include "PcmAudioDecoder.h"
+#include "WavAudioEncoder.h"
+#include "TestFiles.h"
+#include "TestSignals.h"
+#include "Exceptions/InvalidArgumentException.h"
+#include "Exceptions/NotSupportedException.h"
+#include <cstdio>
+#include <vector>
+
+using namespace Heph;
+using namespace HephAudio;
+
+static void AppendUInt(std::vector<uint8_t>& bytes, uint64_t value, size_t size, bool bigEndian)
+{
+	for (size_t i = 0; i < size; ++i)
+	{
+		bytes.push_back((uint8_t)(value >> ((bigEndian ? (size - 1 - i) : i) * 8)));
+	}
+}
+
+static void WriteFile(const std::filesystem::path& path, const std::vector<uint8_t>& bytes)
+{
+	FILE* pFile = fopen(path.string().c_str(), "wb");
+	ASSERT_NE(pFile, nullptr);
+	EXPECT_EQ(fwrite(bytes.data(), 1, bytes.size(), pFile), bytes.size());
+	fclose(pFile);
+}
+
+static void ExpectNear(const AudioBuffer& expected, const AudioBuffer& actual, double tolerance)
+{
+	ASSERT_EQ(expected.FrameCount(), actual.FrameCount());
+	ASSERT_EQ(expected.FormatInfo().channelLayout.count, actual.FormatInfo().channelLayout.count);
+	for (size_t i = 0; i < expected.FrameCount(); ++i)
+	{
+		for (size_t j = 0; j < expected.FormatInfo().channelLayout.count; ++j)
+		{
+			EXPECT_NEAR(HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(expected[i][j]), HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(actual[i][j]), tolerance);
+		}
+	}
+}
+
+TEST(PcmAudioDecoderTest, WavRoundTrip)
+{
+	const std::filesystem::path filePath = std::filesystem::temp_directory_path() / "HephAudioPcmDecoderTest.wav";
+	const AudioBuffer input = TestSignals::CreateStereoBuffer(10007);
+
+	for (uint16_t bitsPerSample : { 16, 24 })
+	{
+		{
+			WavAudioEncoder encoder(filePath, AudioFormatInfo(HEPHAUDIO_FORMAT_TAG_PCM, bitsPerSample, HEPHAUDIO_CH_LAYOUT_STEREO, 48000), true);
+			encoder.Encode(input);
+			EXPECT_EQ(encoder.GetDataSize(), input.FrameCount() * 2 * bitsPerSample / 8);
+		}
+
+		PcmAudioDecoder decoder(nullptr);
+		decoder.ChangeFile(filePath);
+		ASSERT_TRUE(decoder.IsFileOpen());
+		EXPECT_FALSE(decoder.IsFallbackActive());
+		EXPECT_EQ(decoder.GetFrameCount(), input.FrameCount());
+		EXPECT_EQ(decoder.GetFileFormatInfo().bitsPerSample, bitsPerSample);
+		EXPECT_EQ(decoder.GetOutputFormatInfo().sampleRate, 48000);
+		EXPECT_EQ(decoder.GetInternalFormatView(), nullptr);
+
+		const double tolerance = 1.0 / (1 << (bitsPerSample - 2));
+		ExpectNear(input, decoder.Decode(), tolerance);
+
+		EXPECT_TRUE(decoder.Seek(10000));
+		const AudioBuffer tail = decoder.Decode(100);
+		EXPECT_EQ(tail.FrameCount(), 100);
+		EXPECT_NEAR(HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(tail[6][0]), HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(input[10006][0]), tolerance);
+		EXPECT_EQ(tail[7][0], 0);
+	}
+
+	std::filesystem::remove(filePath);
+}
+
+TEST(PcmAudioDecoderTest, InternalFormatView)
+{
+	for (const std::filesystem::path& path : TestFiles::wavFiles)
+	{
+		if (std::filesystem::exists(path))
+		{
+			PcmAudioDecoder decoder(nullptr);
+			decoder.ChangeFile(path);
+			ASSERT_GT(decoder.GetFrameCount(), 0);
+
+			const AudioBuffer decodedBuffer = decoder.Decode(0, 1000);
+			const heph_audio_sample_t* pView = decoder.GetInternalFormatView();
+			if (decoder.GetFileFormatInfo().formatTag == HEPHAUDIO_FORMAT_TAG_HEPHAUDIO_INTERNAL &&
+				decoder.GetFileFormatInfo().bitsPerSample == sizeof(heph_audio_sample_t) * 8)
+			{
+				ASSERT_NE(pView, nullptr);
+				for (size_t i = 0; i < decodedBuffer.FrameCount(); ++i)
+				{
+					EXPECT_EQ(pView[i * decodedBuffer.FormatInfo().channelLayout.count], decodedBuffer[i][0]);
+				}
+			}
+			return;
+		}
+	}
+}
+
+TEST(PcmAudioDecoderTest, Aiff)
+{
+	const std::filesystem::path filePath = std::filesystem::temp_directory_path() / "HephAudioPcmDecoderTest.aiff";
+	const int16_t samples[] = { 0, 16384, -16384, 32767, -32768, 1000 };
+	const size_t frameCount = 3;
+
+	std::vector<uint8_t> bytes;
+	bytes.insert(bytes.end(), { 'F', 'O', 'R', 'M' });
+	AppendUInt(bytes, 4 + 26 + 16 + sizeof(samples), 4, true);
+	bytes.insert(bytes.end(), { 'A', 'I', 'F', 'F', 'C', 'O', 'M', 'M' });
+	AppendUInt(bytes, 18, 4, true);
+	AppendUInt(bytes, 2, 2, true);
+	AppendUInt(bytes, frameCount, 4, true);
+	AppendUInt(bytes, 16, 2, true);
+	// 44100 as 80 bit extended
+	AppendUInt(bytes, 0x400E, 2, true);
+	AppendUInt(bytes, 0xAC44000000000000ull, 8, true);
+	bytes.insert(bytes.end(), { 'S', 'S', 'N', 'D' });
+	AppendUInt(bytes, 8 + sizeof(samples), 4, true);
+	AppendUInt(bytes, 0, 8, true);
+	for (int16_t sample : samples)
+	{
+		AppendUInt(bytes, (uint16_t)sample, 2, true);
+	}
+	WriteFile(filePath, bytes);
+
+	PcmAudioDecoder decoder(nullptr);
+	decoder.ChangeFile(filePath);
+	EXPECT_EQ(decoder.GetFrameCount(), frameCount);
+	EXPECT_EQ(decoder.GetFileFormatInfo().endian, Endian::Big);
+	EXPECT_EQ(decoder.GetOutputFormatInfo().sampleRate, 44100);
+
+	const AudioBuffer decodedBuffer = decoder.Decode();
+	ASSERT_EQ(decodedBuffer.FrameCount(), frameCount);
+	for (size_t i = 0; i < frameCount; ++i)
+	{
+		EXPECT_NEAR(HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(decodedBuffer[i][0]), samples[i * 2] / 32768.0, 1e-6);
+		EXPECT_NEAR(HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(decodedBuffer[i][1]), samples[i * 2 + 1] / 32768.0, 1e-6);
+	}
+
+	decoder.CloseFile();
+	std::filesystem::remove(filePath);
+}
+
+TEST(PcmAudioDecoderTest, W64AndRaw)
+{
+	static constexpr uint8_t guidSuffix[12] = { 0xF3, 0xAC, 0xD3, 0x11, 0x8C, 0xD1, 0x00, 0xC0, 0x4F, 0x8E, 0xDB, 0x8A };
+	const std::filesystem::path w64Path = std::filesystem::temp_directory_path() / "HephAudioPcmDecoderTest.w64";
+	const std::filesystem::path rawPath = std::filesystem::temp_directory_path() / "HephAudioPcmDecoderTest.raw";
+	const int16_t samples[] = { 100, -100, 200, -200, 300, -300, 400, -400 };
+
+	std::vector<uint8_t> pcm;
+	for (int16_t sample : samples)
+	{
+		AppendUInt(pcm, (uint16_t)sample, 2, false);
+	}
+
+	std::vector<uint8_t> bytes = { 'r', 'i', 'f', 'f', 0x2E, 0x91, 0xCF, 0x11, 0xA5, 0xD6, 0x28, 0xDB, 0x04, 0xC1, 0x00, 0x00 };
+	AppendUInt(bytes, 40 + 40 + 24 + pcm.size(), 8, false);
+	bytes.insert(bytes.end(), { 'w', 'a', 'v', 'e' });
+	bytes.insert(bytes.end(), guidSuffix, guidSuffix + 12);
+	bytes.insert(bytes.end(), { 'f', 'm', 't', ' ' });
+	bytes.insert(bytes.end(), guidSuffix, guidSuffix + 12);
+	AppendUInt(bytes, 24 + 16, 8, false);
+	AppendUInt(bytes, HEPHAUDIO_FORMAT_TAG_PCM, 2, false);
+	AppendUInt(bytes, 2, 2, false);
+	AppendUInt(bytes, 48000, 4, false);
+	AppendUInt(bytes, 48000 * 4, 4, false);
+	AppendUInt(bytes, 4, 2, false);
+	AppendUInt(bytes, 16, 2, false);
+	bytes.insert(bytes.end(), { 'd', 'a', 't', 'a' });
+	bytes.insert(bytes.end(), guidSuffix, guidSuffix + 12);
+	AppendUInt(bytes, 24 + pcm.size(), 8, false);
+	bytes.insert(bytes.end(), pcm.begin(), pcm.end());
+	WriteFile(w64Path, bytes);
+	WriteFile(rawPath, pcm);
+
+	PcmAudioDecoder decoder(nullptr);
+	for (const std::filesystem::path& path : { w64Path, rawPath })
+	{
+		decoder.ChangeFile(path);
+		EXPECT_EQ(decoder.GetFrameCount(), 4);
+
+		const AudioBuffer decodedBuffer = decoder.Decode();
+		ASSERT_EQ(decodedBuffer.FrameCount(), 4);
+		for (size_t i = 0; i < 4; ++i)
+		{
+			EXPECT_NEAR(HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(decodedBuffer[i][0]), samples[i * 2] / 32768.0, 1e-6);
+			EXPECT_NEAR(HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(decodedBuffer[i][1]), samples[i * 2 + 1] / 32768.0, 1e-6);
+		}
+	}
+
+	decoder.CloseFile();
+	std::filesystem::remove(w64Path);
+	std::filesystem::remove(rawPath);
+}
+
+TEST(PcmAudioDecoderTest, Unsupported)
+{
+	const std::filesystem::path filePath = std::filesystem::temp_directory_path() / "HephAudioPcmDecoderTest.bin";
+	WriteFile(filePath, std::vector<uint8_t>(64, 0xAB));
+
+	PcmAudioDecoder decoder(nullptr);
+	EXPECT_THROW(decoder.ChangeFile(filePath), NotSupportedException);
+	EXPECT_FALSE(decoder.IsFileOpen());
+
+	std::filesystem::remove(filePath);
+}
+
+TEST(PcmAudioDecoderTest, DecodeInto)
+{
+	const std::filesystem::path filePath = std::filesystem::temp_directory_path() / "HephAudioPcmDecoderTest.wav";
+	const AudioBuffer input = TestSignals::CreateStereoBuffer(1000);
+	{
+		WavAudioEncoder encoder(filePath, HEPHAUDIO_INTERNAL_FORMAT(HEPHAUDIO_CH_LAYOUT_STEREO, 48000), true);
+		encoder.Encode(input);
+	}
+
+	PcmAudioDecoder decoder(nullptr);
+	decoder.ChangeFile(filePath);
+
+	AudioBuffer output(1200, HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+	EXPECT_EQ(decoder.DecodeInto(output, 0, 600), 600);
+	EXPECT_EQ(decoder.DecodeInto(output, 600, 600), 400);
+	ExpectNear(input, output.SubBuffer(0, 1000), 0);
+	EXPECT_EQ(output[1000][0], 0);
+	EXPECT_THROW(decoder.DecodeInto(output, 1100, 200), InvalidArgumentException);
+
+	// the writable region of the ring buffer wraps around.
+	AudioRingBuffer ringBuffer(256, HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+	AudioBuffer ringOutput(200, HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+	EXPECT_TRUE(decoder.Seek(0));
+	EXPECT_EQ(decoder.DecodeInto(ringBuffer, 200), 200);
+	EXPECT_EQ(ringBuffer.Read(ringOutput), 200);
+	EXPECT_EQ(decoder.DecodeInto(ringBuffer, 1000), 256);
+	EXPECT_EQ(ringBuffer.Read(ringOutput), 200);
+	ExpectNear(input.SubBuffer(200, 200), ringOutput, 0);
+
+	decoder.CloseFile();
+	std::filesystem::remove(filePath);
+}
\ No newline at end of file
@@ -0,0 +1,241 @@
+#include "gtest/gtest.h"
+#include "SampleFormatConverter.h"
+#include "TestSignals.h"
+#include "Exceptions/InvalidArgumentException.h"
+#include <cmath>
+#include <vector>
+
+using namespace Heph;
+using namespace HephAudio;
+
+TEST(SampleFormatConverterTest, IsSupported)
+{
+	EXPECT_TRUE(SampleFormatConverter::IsSupported(AudioFormatInfo(HEPHAUDIO_FORMAT_TAG_PCM, 8, HEPHAUDIO_CH_LAYOUT_STEREO, 48000)));
+	EXPECT_TRUE(SampleFormatConverter::IsSupported(AudioFormatInfo(HEPHAUDIO_FORMAT_TAG_PCM, 16, HEPHAUDIO_CH_LAYOUT_STEREO, 48000)));
+	EXPECT_TRUE(SampleFormatConverter::IsSupported(AudioFormatInfo(HEPHAUDIO_FORMAT_TAG_PCM, 24, HEPHAUDIO_CH_LAYOUT_STEREO, 48000)));
+	EXPECT_TRUE(SampleFormatConverter::IsSupported(AudioFormatInfo(HEPHAUDIO_FORMAT_TAG_PCM, 32, HEPHAUDIO_CH_LAYOUT_STEREO, 48000)));
+	EXPECT_TRUE(SampleFormatConverter::IsSupported(AudioFormatInfo(HEPHAUDIO_FORMAT_TAG_IEEE_FLOAT, 32, HEPHAUDIO_CH_LAYOUT_STEREO, 48000)));
+	EXPECT_TRUE(SampleFormatConverter::IsSupported(AudioFormatInfo(HEPHAUDIO_FORMAT_TAG_IEEE_FLOAT, 64, HEPHAUDIO_CH_LAYOUT_STEREO, 48000)));
+	EXPECT_TRUE(SampleFormatConverter::IsSupported(AudioFormatInfo(HEPHAUDIO_FORMAT_TAG_ALAW, 8, HEPHAUDIO_CH_LAYOUT_MONO, 8000)));
+	EXPECT_TRUE(SampleFormatConverter::IsSupported(AudioFormatInfo(HEPHAUDIO_FORMAT_TAG_MULAW, 8, HEPHAUDIO_CH_LAYOUT_MONO, 8000)));
+
+	EXPECT_FALSE(SampleFormatConverter::IsSupported(AudioFormatInfo(HEPHAUDIO_FORMAT_TAG_PCM, 12, HEPHAUDIO_CH_LAYOUT_STEREO, 48000)));
+	EXPECT_FALSE(SampleFormatConverter::IsSupported(AudioFormatInfo(HEPHAUDIO_FORMAT_TAG_IEEE_FLOAT, 16, HEPHAUDIO_CH_LAYOUT_STEREO, 48000)));
+	EXPECT_FALSE(SampleFormatConverter::IsSupported(AudioFormatInfo(HEPHAUDIO_FORMAT_TAG_MP3, 16, HEPHAUDIO_CH_LAYOUT_STEREO, 48000)));
+	EXPECT_FALSE(SampleFormatConverter::IsSupported(AudioFormatInfo(HEPHAUDIO_FORMAT_TAG_PCM, 16, HEPHAUDIO_CH_LAYOUT_STEREO, 48000, !HEPH_SYSTEM_ENDIAN)));
+}
+
+TEST(SampleFormatConverterTest, Integer)
+{
+	const AudioBuffer input = TestSignals::CreateStereoBuffer(1001);
+
+	{
+		const AudioFormatInfo format(HEPHAUDIO_FORMAT_TAG_PCM, 16, HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+		std::vector<int16_t> encoded(input.Size());
+		SampleFormatConverter::FromInternal(input, encoded.data(), format);
+		for (size_t i = 0; i < encoded.size(); ++i)
+		{
+			EXPECT_EQ(encoded[i], (int16_t)std::nearbyint(HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(input.begin()[i]) * 32768.0));
+		}
+
+		AudioBuffer decoded(input.FrameCount(), HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+		SampleFormatConverter::ToInternal(encoded.data(), format, input.FrameCount(), decoded);
+		for (size_t i = 0; i < encoded.size(); ++i)
+		{
+			EXPECT_EQ(HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(decoded.begin()[i]), encoded[i] / 32768.0);
+		}
+	}
+
+	{
+		const AudioFormatInfo format(HEPHAUDIO_FORMAT_TAG_PCM, 32, HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+		std::vector<int32_t> encoded(input.Size());
+		SampleFormatConverter::FromInternal(input, encoded.data(), format);
+		for (size_t i = 0; i < encoded.size(); ++i)
+		{
+			EXPECT_EQ(encoded[i], (int32_t)std::nearbyint(HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(input.begin()[i]) * 2147483648.0));
+		}
+	}
+
+	{
+		const AudioFormatInfo format(HEPHAUDIO_FORMAT_TAG_PCM, 24, HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+		std::vector<uint8_t> encoded(input.FrameCount() * format.FrameSize());
+		AudioBuffer decoded(input.FrameCount(), HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+		SampleFormatConverter::FromInternal(input, encoded.data(), format);
+		SampleFormatConverter::ToInternal(encoded.data(), format, input.FrameCount(), decoded);
+		for (size_t i = 0; i < input.Size(); ++i)
+		{
+			EXPECT_NEAR(HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(decoded.begin()[i]), HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(input.begin()[i]), 1.0 / 8388608.0);
+		}
+	}
+
+	{
+		const AudioFormatInfo format(HEPHAUDIO_FORMAT_TAG_PCM, 8, HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+		std::vector<uint8_t> encoded(input.Size());
+		AudioBuffer decoded(input.FrameCount(), HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+		SampleFormatConverter::FromInternal(input, encoded.data(), format);
+		SampleFormatConverter::ToInternal(encoded.data(), format, input.FrameCount(), decoded);
+		for (size_t i = 0; i < input.Size(); ++i)
+		{
+			EXPECT_NEAR(HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(decoded.begin()[i]), HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(input.begin()[i]), 1.0 / 256.0);
+		}
+	}
+}
+
+TEST(SampleFormatConverterTest, Clipping)
+{
+	AudioBuffer input(9, HEPHAUDIO_CH_LAYOUT_MONO, 48000);
+	for (size_t i = 0; i < input.FrameCount(); ++i)
+	{
+		input[i][0] = (i % 2 == 0) ? HEPH_AUDIO_SAMPLE_MAX : HEPH_AUDIO_SAMPLE_MIN;
+	}
+	input[0][0] = HEPH_AUDIO_SAMPLE_FROM_IEEE_FLT(2.0);
+	input[1][0] = HEPH_AUDIO_SAMPLE_FROM_IEEE_FLT(-2.0);
+
+	int16_t s16[9];
+	SampleFormatConverter::FromInternal(input, s16, AudioFormatInfo(HEPHAUDIO_FORMAT_TAG_PCM, 16, HEPHAUDIO_CH_LAYOUT_MONO, 48000));
+	int32_t s32[9];
+	SampleFormatConverter::FromInternal(input, s32, AudioFormatInfo(HEPHAUDIO_FORMAT_TAG_PCM, 32, HEPHAUDIO_CH_LAYOUT_MONO, 48000));
+
+	for (size_t i = 0; i < input.FrameCount(); ++i)
+	{
+		EXPECT_EQ(s16[i], (i % 2 == 0) ? INT16_MAX : INT16_MIN);
+		EXPECT_EQ(s32[i], (i % 2 == 0) ? INT32_MAX : INT32_MIN);
+	}
+}
+
+TEST(SampleFormatConverterTest, Float)
+{
+	const AudioBuffer input = TestSignals::CreateStereoBuffer(1001);
+
+	const AudioFormatInfo format(HEPHAUDIO_FORMAT_TAG_IEEE_FLOAT, 64, HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+	std::vector<double> encoded(input.Size());
+	AudioBuffer decoded(input.FrameCount(), HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+	SampleFormatConverter::FromInternal(input, encoded.data(), format);
+	SampleFormatConverter::ToInternal(encoded.data(), format, input.FrameCount(), decoded);
+	for (size_t i = 0; i < input.Size(); ++i)
+	{
+		EXPECT_DOUBLE_EQ(encoded[i], HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(input.begin()[i]));
+	}
+	EXPECT_EQ(decoded, input);
+}
+
+TEST(SampleFormatConverterTest, Companding)
+{
+	EXPECT_EQ(SampleFormatConverter::LinearToALaw(0), 0xD5);
+	EXPECT_EQ(SampleFormatConverter::LinearToMuLaw(0), 0xFF);
+	EXPECT_EQ(SampleFormatConverter::ALawToLinear(0xD5), 8);
+	EXPECT_EQ(SampleFormatConverter::MuLawToLinear(0xFF), 0);
+
+	for (int32_t i = 0; i < 256; ++i)
+	{
+		EXPECT_EQ(SampleFormatConverter::LinearToALaw(SampleFormatConverter::ALawToLinear(i)), i);
+		if (i != 0x7F)
+		{
+			// 0x7F and 0xFF both decode to 0.
+			EXPECT_EQ(SampleFormatConverter::LinearToMuLaw(SampleFormatConverter::MuLawToLinear(i)), i);
+		}
+	}
+
+	const AudioBuffer input = TestSignals::CreateStereoBuffer(256);
+	std::vector<uint8_t> encoded(input.Size());
+	AudioBuffer decoded(input.FrameCount(), HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+	const AudioFormatInfo format(HEPHAUDIO_FORMAT_TAG_MULAW, 8, HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+	SampleFormatConverter::FromInternal(input, encoded.data(), format);
+	SampleFormatConverter::ToInternal(encoded.data(), format, input.FrameCount(), decoded);
+	for (size_t i = 0; i < input.Size(); ++i)
+	{
+		const double expected = HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(input.begin()[i]);
+		EXPECT_NEAR(HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(decoded.begin()[i]), expected, fabs(expected) * 0.07 + 0.001);
+	}
+}
+
+TEST(SampleFormatConverterTest, Dither)
+{
+	constexpr size_t frameCount = 48000;
+	constexpr double dc = 0.3 / 32768.0;
+	AudioBuffer input(frameCount, HEPHAUDIO_CH_LAYOUT_MONO, 48000);
+	for (size_t i = 0; i < frameCount; ++i)
+	{
+		input[i][0] = HEPH_AUDIO_SAMPLE_FROM_IEEE_FLT(dc);
+	}
+
+	const AudioFormatInfo format(HEPHAUDIO_FORMAT_TAG_PCM, 16, HEPHAUDIO_CH_LAYOUT_MONO, 48000);
+	std::vector<int16_t> encoded(frameCount);
+
+	// without dither a DC offset below half an LSB vanishes.
+	SampleFormatConverter::FromInternal(input, encoded.data(), format);
+	for (size_t i = 0; i < frameCount; ++i)
+	{
+		EXPECT_EQ(encoded[i], 0);
+	}
+
+	for (DitherMode mode : { DitherMode::Tpdf, DitherMode::TpdfNoiseShaped })
+	{
+		DitherState ditherState(mode, 1);
+		SampleFormatConverter::FromInternal(input, encoded.data(), format, &ditherState);
+
+		double mean = 0;
+		for (size_t i = 0; i < frameCount; ++i)
+		{
+			EXPECT_LE(abs(encoded[i]), 2);
+			mean += encoded[i];
+		}
+		mean /= frameCount;
+		EXPECT_NEAR(mean, 0.3, 0.02);
+	}
+}
+
+TEST(SampleFormatConverterTest, Convert)
+{
+	const AudioBuffer input = TestSignals::CreateStereoBuffer(3001);
+
+	const AudioBufferS16 s16 = SampleFormatConverter::Convert<int16_t>(input);
+	EXPECT_EQ(s16.FrameCount(), input.FrameCount());
+	EXPECT_EQ(s16.FormatInfo(), AudioBufferS16::CreateFormatInfo(HEPHAUDIO_CH_LAYOUT_STEREO, 48000));
+	for (size_t i = 0; i < input.Size(); ++i)
+	{
+		EXPECT_EQ(s16.begin()[i], (int16_t)std::nearbyint(HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(input.begin()[i]) * 32768.0));
+	}
+
+	// neither type is the internal one for the default float samples, converted a block at a time.
+	const AudioBufferF64 f64 = SampleFormatConverter::Convert<double>(s16);
+	const AudioBufferS32 s32 = SampleFormatConverter::Convert<int32_t>(f64);
+	for (size_t i = 0; i < input.Size(); ++i)
+	{
+		EXPECT_DOUBLE_EQ(f64.begin()[i], s16.begin()[i] / 32768.0);
+		EXPECT_EQ(s32.begin()[i], s16.begin()[i] * 65536);
+	}
+
+	const AudioBuffer decoded = SampleFormatConverter::Convert<heph_audio_sample_t>(s32);
+	for (size_t i = 0; i < input.Size(); ++i)
+	{
+		EXPECT_NEAR(HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(decoded.begin()[i]), HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(input.begin()[i]), 1.0 / 32768.0);
+	}
+	EXPECT_EQ(SampleFormatConverter::Convert<heph_audio_sample_t>(input), input);
+	EXPECT_TRUE(SampleFormatConverter::Convert<float>(AudioBufferS16()).IsEmpty());
+
+	EXPECT_THROW(SampleFormatConverter::Convert(s16.begin(), s16.FormatInfo(), nullptr, AudioFormatInfo(HEPHAUDIO_FORMAT_TAG_PCM, 16, HEPHAUDIO_CH_LAYOUT_MONO, 48000), 1), InvalidArgumentException);
+}
+
+TEST(SampleFormatConverterTest, ConvertPrecision)
+{
+	// samples beyond the 24 bit precision of float, the conversions between two non-internal types must be exact.
+	constexpr size_t frameCount = 1000;
+	AudioBufferS32 s32(frameCount, HEPHAUDIO_CH_LAYOUT_MONO, 48000);
+	AudioBufferF64 f64(frameCount, HEPHAUDIO_CH_LAYOUT_MONO, 48000);
+	for (size_t i = 0; i < frameCount; ++i)
+	{
+		const int32_t value = (int32_t)((i % 2 == 0) ? (16777217 + i * 2097143) : -(33554433 + i * 1048572));
+		s32.begin()[i] = value;
+		f64.begin()[i] = value / 2147483648.0;
+	}
+
+	const AudioBufferF64 s32ToF64 = SampleFormatConverter::Convert<double>(s32);
+	const AudioBufferS32 f64ToS32 = SampleFormatConverter::Convert<int32_t>(f64);
+	for (size_t i = 0; i < frameCount; ++i)
+	{
+		EXPECT_NE((double)(float)f64.begin()[i], f64.begin()[i]);
+		EXPECT_EQ(s32ToF64.begin()[i], f64.begin()[i]);
+		EXPECT_EQ(f64ToS32.begin()[i], s32.begin()[i]);
+	}
+}
\ No newline at end of file
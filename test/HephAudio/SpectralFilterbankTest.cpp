@@ -0,0 +1,74 @@
+#include "gtest/gtest.h"
+#include "SpectralFilterbank.h"
+#include "Exceptions/InvalidArgumentException.h"
+#include <vector>
+
+using namespace Heph;
+using namespace HephAudio;
+
+TEST(SpectralFilterbankTest, Scales)
+{
+	for (FrequencyScale scale : { FrequencyScale::Mel, FrequencyScale::Bark })
+	{
+		for (double frequency : { 0.0, 100.0, 1000.0, 8000.0, 20000.0 })
+		{
+			EXPECT_NEAR(SpectralFilterbank::FromScale(scale, SpectralFilterbank::ToScale(scale, frequency)), frequency, 1e-6);
+		}
+	}
+
+	EXPECT_NEAR(SpectralFilterbank::ToScale(FrequencyScale::Mel, 1000.0), 1000.0, 0.1);
+	EXPECT_NEAR(SpectralFilterbank::ToScale(FrequencyScale::Bark, 1000.0), 8.527, 1e-3);
+}
+
+TEST(SpectralFilterbankTest, Filters)
+{
+	const SpectralFilterbank filterbank(FrequencyScale::Mel, 40, 1024, 16000, 0, 8000);
+	EXPECT_EQ(filterbank.GetFilterCount(), 40);
+	EXPECT_EQ(filterbank.GetBinCount(), 513);
+
+	// the weights of the neighbouring filters add up to 1 between the centers of the first and the last filters.
+	const double firstCenter = SpectralFilterbank::FromScale(FrequencyScale::Mel, SpectralFilterbank::ToScale(FrequencyScale::Mel, 8000.0) / 41);
+	const double lastCenter = SpectralFilterbank::FromScale(FrequencyScale::Mel, SpectralFilterbank::ToScale(FrequencyScale::Mel, 8000.0) * 40 / 41);
+	for (size_t k = 0; k < filterbank.GetBinCount(); ++k)
+	{
+		const double frequency = k * 16000.0 / 1024;
+		double sum = 0.0;
+		for (size_t i = 0; i < filterbank.GetFilterCount(); ++i)
+		{
+			const double weight = filterbank.GetWeight(i, k);
+			ASSERT_GE(weight, 0.0);
+			ASSERT_LE(weight, 1.0);
+			sum += weight;
+		}
+
+		if (frequency > firstCenter && frequency < lastCenter)
+		{
+			ASSERT_NEAR(sum, 1.0, 1e-9);
+		}
+	}
+
+	std::vector<double> spectra(2 * filterbank.GetBinCount());
+	for (size_t k = 0; k < filterbank.GetBinCount(); ++k)
+	{
+		spectra[k] = 1.0;
+		spectra[filterbank.GetBinCount() + k] = k;
+	}
+
+	std::vector<double> output(2 * filterbank.GetFilterCount());
+	filterbank.Apply(spectra.data(), 2, output.data());
+	for (size_t i = 0; i < filterbank.GetFilterCount(); ++i)
+	{
+		double expected1 = 0.0, expected2 = 0.0;
+		for (size_t k = 0; k < filterbank.GetBinCount(); ++k)
+		{
+			expected1 += filterbank.GetWeight(i, k);
+			expected2 += filterbank.GetWeight(i, k) * k;
+		}
+		EXPECT_NEAR(output[i], expected1, 1e-9);
+		EXPECT_NEAR(output[filterbank.GetFilterCount() + i], expected2, 1e-9);
+	}
+
+	EXPECT_THROW(SpectralFilterbank(FrequencyScale::Bark, 0, 1024, 16000, 0, 8000), InvalidArgumentException);
+	EXPECT_THROW(SpectralFilterbank(FrequencyScale::Bark, 24, 1024, 16000, 0, 9000), InvalidArgumentException);
+	EXPECT_THROW(filterbank.GetWeight(40, 0), InvalidArgumentException);
+}
\ No newline at end of file
@@ -0,0 +1,163 @@
+#include "gtest/gtest.h"
+#include "StftAnalyzer.h"
+#include "Windows/HannWindow.h"
+#include "Windows/RectangularWindow.h"
+#include "Fourier.h"
+#include "HephMath.h"
+#include "Exceptions/InvalidArgumentException.h"
+#include <cmath>
+#include <vector>
+
+using namespace Heph;
+using namespace HephAudio;
+
+static AudioBuffer CreateToneBuffer(size_t frameCount)
+{
+	AudioBuffer buffer(frameCount, HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+	for (size_t i = 0; i < frameCount; ++i)
+	{
+		buffer[i][0] = HEPH_AUDIO_SAMPLE_FROM_IEEE_FLT(0.5 * sin(2.0 * HEPH_MATH_PI * 1000.0 * i / 48000.0) + 0.1 * cos(0.37 * i));
+		buffer[i][1] = HEPH_AUDIO_SAMPLE_FROM_IEEE_FLT(0.25 * sin(0.05 * i));
+	}
+	return buffer;
+}
+
+TEST(StftAnalyzerTest, Constructor)
+{
+	StftAnalyzer stft(HannWindow(400), 160, 500);
+	EXPECT_EQ(stft.GetWindowSize(), 400);
+	EXPECT_EQ(stft.GetHopSize(), 160);
+	EXPECT_EQ(stft.GetFFTSize(), 512);
+	EXPECT_EQ(stft.GetBinCount(), 257);
+
+	EXPECT_EQ(stft.CalculateFrameCount(0), 0);
+	EXPECT_EQ(stft.CalculateFrameCount(1), 1);
+	EXPECT_EQ(stft.CalculateFrameCount(400), 1);
+	EXPECT_EQ(stft.CalculateFrameCount(401), 2);
+	EXPECT_EQ(stft.CalculateFrameCount(560), 2);
+	EXPECT_EQ(stft.CalculateFrameCount(561), 3);
+	EXPECT_EQ(stft.CalculateSampleCount(3), 720);
+
+	EXPECT_THROW(StftAnalyzer(HannWindow(256), 0), InvalidArgumentException);
+	EXPECT_THROW(StftAnalyzer(HannWindow(256), 64, 128), InvalidArgumentException);
+}
+
+TEST(StftAnalyzerTest, Analyze)
+{
+	const AudioBuffer buffer = CreateToneBuffer(3000);
+	const HannWindow wnd(256);
+	const DoubleBuffer wndBuffer = wnd.GenerateBuffer();
+	StftAnalyzer stft(wnd, 100, 512);
+
+	const size_t frameCount = stft.CalculateFrameCount(buffer.FrameCount());
+	const size_t binCount = stft.GetBinCount();
+	ASSERT_EQ(frameCount, 29);
+
+	std::vector<double> magnitudes(frameCount * binCount);
+	std::vector<double> powers(frameCount * binCount);
+	std::vector<double> decibels(frameCount * binCount);
+	stft.Analyze(buffer, 0, StftOutputType::Magnitude, magnitudes.data());
+	stft.Analyze(buffer, 0, StftOutputType::Power, powers.data());
+	stft.Analyze(buffer, 0, StftOutputType::Decibel, decibels.data());
+
+	for (size_t i = 0; i < frameCount; ++i)
+	{
+		DoubleBuffer frame(stft.GetWindowSize());
+		for (size_t j = 0; j < frame.Size() && (i * 100 + j) < buffer.FrameCount(); ++j)
+		{
+			frame[j] = HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(buffer[i * 100 + j][0]) * wndBuffer[j];
+		}
+
+		const ComplexBuffer expected = Fourier::FFT(frame, stft.GetFFTSize());
+		for (size_t k = 0; k < binCount; ++k)
+		{
+			const double magnitude = expected[k].Magnitude();
+			ASSERT_NEAR(magnitudes[i * binCount + k], magnitude, 1e-9);
+			ASSERT_NEAR(powers[i * binCount + k], magnitude * magnitude, 1e-9);
+			ASSERT_NEAR(decibels[i * binCount + k], GainToDecibel(magnitude), 1e-3);
+		}
+	}
+
+	// parallel analysis produces the same frames.
+	for (size_t threadCount : { 2, 3, 64 })
+	{
+		std::vector<double> result(frameCount * binCount);
+		stft.SetThreadCount(threadCount);
+		stft.Analyze(buffer, 0, StftOutputType::Magnitude, result.data());
+		for (size_t i = 0; i < result.size(); ++i)
+		{
+			ASSERT_NEAR(result[i], magnitudes[i], 1e-12);
+		}
+	}
+
+	EXPECT_THROW(stft.Analyze(buffer, 2, StftOutputType::Magnitude, magnitudes.data()), InvalidArgumentException);
+}
+
+TEST(StftAnalyzerTest, Stream)
+{
+	const AudioBuffer buffer = CreateToneBuffer(5000);
+
+	for (size_t hopSize : { 128, 300 })
+	{
+		StftAnalyzer stft(HannWindow(256), hopSize);
+		const size_t binCount = stft.GetBinCount();
+		const size_t frameCount = stft.CalculateFrameCount(buffer.FrameCount());
+
+		std::vector<double> expected(frameCount * binCount);
+		stft.Analyze(buffer, 1, StftOutputType::Power, expected.data());
+
+		std::vector<double> result(frameCount * binCount);
+		size_t resultFrameCount = 0;
+		for (size_t i = 0; i < buffer.FrameCount(); i += 77)
+		{
+			stft.Push(buffer.SubBuffer(i, HEPH_MATH_MIN((size_t)77, buffer.FrameCount() - i)), 1);
+			resultFrameCount += stft.Pop(StftOutputType::Power, result.data() + resultFrameCount * binCount, 2);
+		}
+		resultFrameCount += stft.Pop(StftOutputType::Power, result.data() + resultFrameCount * binCount, frameCount);
+
+		// the stream does not produce the zero padded last frame.
+		ASSERT_EQ(resultFrameCount, 1 + (buffer.FrameCount() - 256) / hopSize);
+		EXPECT_EQ(stft.GetAvailableFrameCount(), 0);
+		for (size_t i = 0; i < resultFrameCount * binCount; ++i)
+		{
+			ASSERT_NEAR(result[i], expected[i], 1e-9);
+		}
+
+		stft.Reset();
+		EXPECT_EQ(stft.Pop(StftOutputType::Power, result.data(), frameCount), 0);
+	}
+}
+
+TEST(StftAnalyzerTest, Synthesize)
+{
+	const AudioBuffer buffer = CreateToneBuffer(4000);
+
+	StftAnalyzer stft(HannWindow(512), 128);
+	stft.SetThreadCount(4);
+
+	SplitComplexBuffer frames;
+	stft.Analyze(buffer, 0, frames);
+	const size_t frameCount = stft.CalculateFrameCount(buffer.FrameCount());
+	ASSERT_EQ(frames.Size(), frameCount * stft.GetBinCount());
+
+	AudioBuffer result(buffer.FrameCount(), HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+	stft.Synthesize(frames, frameCount, result, 1);
+
+	// the first sample is not covered since the Hann window starts with zero.
+	for (size_t i = 1; i < buffer.FrameCount(); ++i)
+	{
+		ASSERT_NEAR(HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(result[i][1]), HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(buffer[i][0]), 1e-5);
+		ASSERT_EQ(result[i][0], 0);
+	}
+
+	// odd number of frames with a rectangular window.
+	StftAnalyzer rectStft(RectangularWindow(256), 256);
+	const AudioBuffer subBuffer = buffer.SubBuffer(0, 768);
+	rectStft.Analyze(subBuffer, 1, frames);
+	rectStft.Synthesize(frames, 3, result, 0);
+	for (size_t i = 0; i < result.FrameCount(); ++i)
+	{
+		const double expected = (i < 768) ? (HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(buffer[i][1])) : (0.0);
+		ASSERT_NEAR(HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(result[i][0]), expected, 1e-5);
+	}
+}
\ No newline at end of file
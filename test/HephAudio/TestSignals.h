@@ -0,0 +1,27 @@
+#pragma once
+#include "AudioBuffer.h"
+#include <cmath>
+
+namespace TestSignals
+{
+	/**
+	 * creates a 48 kHz stereo buffer with a sine on the left and a cosine on the right channel.
+	 *
+	 * @param frameCount number of frames.
+	 * @param leftStep phase increment of the left channel per frame in radians.
+	 * @param rightStep phase increment of the right channel per frame in radians.
+	 * @param leftAmplitude amplitude of the left channel.
+	 * @param rightAmplitude amplitude of the right channel.
+	 * @param offset index of the first frame in the signal, consecutive buffers form a continuous signal.
+	 */
+	inline HephAudio::AudioBuffer CreateStereoBuffer(size_t frameCount, double leftStep = 0.1, double rightStep = 0.07, double leftAmplitude = 0.9, double rightAmplitude = 0.5, size_t offset = 0)
+	{
+		HephAudio::AudioBuffer buffer(frameCount, HEPHAUDIO_CH_LAYOUT_STEREO, 48000);
+		for (size_t i = 0; i < frameCount; ++i)
+		{
+			buffer[i][0] = HEPH_AUDIO_SAMPLE_FROM_IEEE_FLT(sin((i + offset) * leftStep) * leftAmplitude);
+			buffer[i][1] = HEPH_AUDIO_SAMPLE_FROM_IEEE_FLT(cos((i + offset) * rightStep) * rightAmplitude);
+		}
+		return buffer;
+	}
+}
\ No newline at end of file
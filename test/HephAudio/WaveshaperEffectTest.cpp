@@ -0,0 +1,173 @@
+#include "gtest/gtest.h"
+#include "AudioEffects/ArctanDistortion.h"
+#include "AudioEffects/CubicDistortion.h"
+#include "AudioEffects/HardClipDistortion.h"
+#include "AudioEffects/Overdrive.h"
+#include "AudioEffects/Waveshaper.h"
+#include "Fourier.h"
+#include "HephMath.h"
+#include "Exceptions/InvalidArgumentException.h"
+#include <cmath>
+#include <functional>
+
+using namespace Heph;
+using namespace HephAudio;
+
+static constexpr uint32_t SAMPLE_RATE = 48000;
+static constexpr size_t FFT_SIZE = 4096;
+
+// fundamental of the aliasing test, an exact bin so the harmonics do not leak.
+// its 7th harmonic (35.8 kHz) folds back to the bin 1037 at 1x, no other harmonic lands there.
+static constexpr size_t FUNDAMENTAL_BIN = 437;
+static constexpr size_t ALIAS_BIN = FFT_SIZE - 7 * FUNDAMENTAL_BIN;
+
+static AudioBuffer CreateSineBuffer(size_t frameCount, double frequency, double amplitude)
+{
+	AudioBuffer buffer(frameCount, HEPHAUDIO_CH_LAYOUT_MONO, SAMPLE_RATE);
+	for (size_t i = 0; i < frameCount; ++i)
+	{
+		buffer[i][0] = HEPH_AUDIO_SAMPLE_FROM_IEEE_FLT(amplitude * sin(2.0 * HEPH_MATH_PI * frequency * i / SAMPLE_RATE));
+	}
+	return buffer;
+}
+
+static void TestTransferFunction(WaveshaperEffect& effect, const std::function<double(double)>& expected, double maxError)
+{
+	AudioBuffer buffer = CreateSineBuffer(4800, 100, 1.0);
+	const AudioBuffer input = buffer;
+	effect.Process(buffer);
+
+	for (size_t i = 0; i < buffer.FrameCount(); ++i)
+	{
+		const double x = HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(input[i][0]);
+		const double y = HEPH_MATH_MIN(HEPH_MATH_MAX(expected(x), -1.0), 1.0);
+		ASSERT_NEAR(HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(buffer[i][0]), y, maxError) << "x = " << x;
+	}
+}
+
+// level of the aliased 7th harmonic relative to the fundamental in dB.
+static double MeasureAliasLevel(WaveshaperEffect& effect)
+{
+	AudioBuffer buffer = CreateSineBuffer(3 * FFT_SIZE, (double)FUNDAMENTAL_BIN * SAMPLE_RATE / FFT_SIZE, 0.9);
+	effect.Process(buffer);
+
+	// skip the transient of the filters, the steady state is periodic in the FFT size.
+	DoubleBuffer samples(FFT_SIZE);
+	for (size_t i = 0; i < FFT_SIZE; ++i)
+	{
+		samples[i] = HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(buffer[2 * FFT_SIZE + i][0]);
+	}
+
+	const ComplexBuffer spectrum = Fourier::FFT(samples, FFT_SIZE);
+	return 20.0 * log10(spectrum[ALIAS_BIN].Magnitude() / spectrum[FUNDAMENTAL_BIN].Magnitude());
+}
+
+TEST(WaveshaperEffectTest, Distortions)
+{
+	// the effects are linear when their parameter is 0, the curves use the parameter + 1.
+	// FastMath::Sin has less than 1e-5 error in single precision, scaled by the drive since tanh' <= 1.
+	Overdrive overdrive(4.0);
+	TestTransferFunction(overdrive, [](double x) { return tanh(5.0 * sin(x)); }, 5.0 * 1e-5 + 3e-7 + 1e-6);
+
+	ArctanDistortion arctanDistortion(5.0);
+	TestTransferFunction(arctanDistortion, [](double x) { return atan(6.0 * x) * 2.0 / HEPH_MATH_PI; }, 2e-6 + 1e-6);
+
+	CubicDistortion cubicDistortion(1.2);
+	TestTransferFunction(cubicDistortion, [](double x) { return 2.2 * x - pow(2.2 * x, 3) / 3.0; }, 1e-6);
+
+	HardClipDistortion hardClipDistortion(-6.0);
+	const double clippingLevel = HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(HephAudio::DecibelToGain(-6.0) * HEPH_AUDIO_SAMPLE_MAX);
+	TestTransferFunction(hardClipDistortion, [clippingLevel](double x) { return HEPH_MATH_MIN(HEPH_MATH_MAX(x, -clippingLevel), clippingLevel); }, 1e-6);
+}
+
+TEST(WaveshaperEffectTest, LookupTable)
+{
+	// linear interpolation error is less than h^2 / 8 * max|f''|, h = 2 / (tableSize - 1).
+	const double h = 2.0 / (HEPHAUDIO_WAVESHAPER_DEFAULT_TABLE_SIZE - 1);
+
+	Waveshaper waveshaper([](double x) { return x * (1.5 - 0.5 * x * x); });
+	EXPECT_TRUE(waveshaper.IsLookupTableEnabled());
+	TestTransferFunction(waveshaper, [](double x) { return x * (1.5 - 0.5 * x * x); }, h * h / 8.0 * 3.0 + 1e-6);
+
+	// max|f''| of tanh(k * sin(x)) is less than k^2 + k.
+	Overdrive overdrive(4.0);
+	EXPECT_FALSE(overdrive.IsLookupTableEnabled());
+	overdrive.EnableLookupTable(HEPHAUDIO_WAVESHAPER_DEFAULT_TABLE_SIZE);
+	EXPECT_TRUE(overdrive.IsLookupTableEnabled());
+	TestTransferFunction(overdrive, [](double x) { return tanh(5.0 * sin(x)); }, h * h / 8.0 * 30.0 + 5.0 * 1e-5 + 1e-6);
+
+	// the table must follow the parameter changes.
+	overdrive.SetDrive(2.0);
+	TestTransferFunction(overdrive, [](double x) { return tanh(3.0 * sin(x)); }, h * h / 8.0 * 12.0 + 3.0 * 1e-5 + 1e-6);
+
+	overdrive.DisableLookupTable();
+	EXPECT_FALSE(overdrive.IsLookupTableEnabled());
+	TestTransferFunction(overdrive, [](double x) { return tanh(3.0 * sin(x)); }, 3.0 * 1e-5 + 3e-7 + 1e-6);
+
+	EXPECT_THROW(overdrive.EnableLookupTable(1), InvalidArgumentException);
+}
+
+TEST(WaveshaperEffectTest, OversamplingFactor)
+{
+	HardClipDistortion effect(-6.0);
+	EXPECT_EQ(effect.GetOversamplingFactor(), 1);
+
+	for (size_t oversamplingFactor : { 2, 4, 8, 1 })
+	{
+		effect.SetOversamplingFactor(oversamplingFactor);
+		EXPECT_EQ(effect.GetOversamplingFactor(), oversamplingFactor);
+	}
+
+	EXPECT_THROW(effect.SetOversamplingFactor(0), InvalidArgumentException);
+	EXPECT_THROW(effect.SetOversamplingFactor(3), InvalidArgumentException);
+	EXPECT_THROW(effect.SetOversamplingFactor(16), InvalidArgumentException);
+	EXPECT_EQ(effect.GetOversamplingFactor(), 1);
+}
+
+TEST(WaveshaperEffectTest, Aliasing)
+{
+	HardClipDistortion effect(-6.0);
+	const double aliasLevel = MeasureAliasLevel(effect);
+	EXPECT_GT(aliasLevel, -40.0);
+
+	for (size_t oversamplingFactor : { 2, 4, 8 })
+	{
+		effect.SetOversamplingFactor(oversamplingFactor);
+		EXPECT_LT(MeasureAliasLevel(effect), aliasLevel - 60.0) << "oversamplingFactor = " << oversamplingFactor;
+	}
+}
+
+TEST(WaveshaperEffectTest, Latency)
+{
+	constexpr double frequency = 100;
+	constexpr double amplitude = 0.5;
+	constexpr size_t periodFrameCount = (size_t)(SAMPLE_RATE / frequency);
+
+	// transfer function is linear for the input, so the output is the delayed input.
+	HardClipDistortion effect(0.0);
+	EXPECT_EQ(effect.GetLatency(), 0.0);
+
+	for (size_t oversamplingFactor : { 1, 2, 4, 8 })
+	{
+		effect.SetOversamplingFactor(oversamplingFactor);
+
+		AudioBuffer buffer = CreateSineBuffer(20 * periodFrameCount, frequency, amplitude);
+		effect.Process(buffer);
+
+		// correlate the steady state with the input to find its phase.
+		double re = 0.0, im = 0.0;
+		for (size_t i = 10 * periodFrameCount; i < buffer.FrameCount(); ++i)
+		{
+			const double phase = 2.0 * HEPH_MATH_PI * frequency * i / SAMPLE_RATE;
+			re += HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(buffer[i][0]) * sin(phase);
+			im += HEPH_AUDIO_SAMPLE_TO_IEEE_FLT(buffer[i][0]) * cos(phase);
+		}
+		re *= 2.0 / (10 * periodFrameCount);
+		im *= 2.0 / (10 * periodFrameCount);
+
+		const double delay = atan2(-im, re) * SAMPLE_RATE / (2.0 * HEPH_MATH_PI * frequency);
+		EXPECT_NEAR(sqrt(re * re + im * im), amplitude, 1e-3) << "oversamplingFactor = " << oversamplingFactor;
+		EXPECT_NEAR(delay, effect.GetLatency(), 0.01) << "oversamplingFactor = " << oversamplingFactor;
+	}
+	EXPECT_GT(effect.GetLatency(), 0.0);
+}
\ No newline at end of file
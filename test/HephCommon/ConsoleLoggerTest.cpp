@@ -0,0 +1,77 @@
+#include "gtest/gtest.h"
+#include "ConsoleLogger.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+using namespace Heph;
+
+static std::string ReadLogFile(const std::filesystem::path& filePath)
+{
+	std::ifstream file(filePath);
+	std::stringstream ss;
+	ss << file.rdbuf();
+	return ss.str();
+}
+
+static size_t CountOccurrences(const std::string& str, const std::string& value)
+{
+	size_t count = 0;
+	for (size_t pos = str.find(value); pos != std::string::npos; pos = str.find(value, pos + value.size()))
+	{
+		count++;
+	}
+	return count;
+}
+
+TEST(ConsoleLoggerTest, LogFile)
+{
+	const std::filesystem::path filePath = std::filesystem::temp_directory_path() / "heph_console_logger_test_sync.log";
+	std::filesystem::remove(filePath);
+
+	ConsoleLogger::SetLogFile(filePath);
+	ConsoleLogger::Log("sync message", HEPH_CL_INFO, "TestLib");
+	ConsoleLogger::Log(std::string("sync warning"), HEPH_CL_WARNING);
+	ConsoleLogger::CloseLogFile();
+
+	const std::string content = ReadLogFile(filePath);
+	EXPECT_NE(content.find("TestLib["), std::string::npos);
+	EXPECT_NE(content.find("[INFO]: sync message"), std::string::npos);
+	EXPECT_NE(content.find("[WARNING]: sync warning"), std::string::npos);
+
+	std::filesystem::remove(filePath);
+}
+
+TEST(ConsoleLoggerTest, AsyncLogging)
+{
+	const std::filesystem::path filePath = std::filesystem::temp_directory_path() / "heph_console_logger_test_async.log";
+	std::filesystem::remove(filePath);
+
+	const uint32_t oldInterval_ms = ConsoleLogger::GetRepeatSuppressionInterval();
+	ConsoleLogger::SetRepeatSuppressionInterval(60000);
+	ConsoleLogger::SetLogFile(filePath);
+	ConsoleLogger::EnableAsyncLogging(16);
+	EXPECT_TRUE(ConsoleLogger::IsAsyncLoggingEnabled());
+
+	ConsoleLogger::Log("repeated message", HEPH_CL_WARNING);
+	ConsoleLogger::Log("repeated message", HEPH_CL_WARNING);
+	ConsoleLogger::Log("repeated message", HEPH_CL_WARNING);
+	ConsoleLogger::Log("other message", HEPH_CL_INFO);
+	ConsoleLogger::Log(std::string(HEPH_CL_MAX_MESSAGE_LENGTH * 2, 'x'), HEPH_CL_INFO);
+	ConsoleLogger::Flush();
+
+	ConsoleLogger::DisableAsyncLogging();
+	EXPECT_FALSE(ConsoleLogger::IsAsyncLoggingEnabled());
+	ConsoleLogger::CloseLogFile();
+	ConsoleLogger::SetRepeatSuppressionInterval(oldInterval_ms);
+
+	const std::string content = ReadLogFile(filePath);
+	EXPECT_EQ(CountOccurrences(content, "repeated message"), 1);
+	EXPECT_EQ(CountOccurrences(content, "last message repeated 2 times."), 1);
+	EXPECT_EQ(CountOccurrences(content, "other message"), 1);
+	EXPECT_EQ(CountOccurrences(content, std::string(HEPH_CL_MAX_MESSAGE_LENGTH - 3, 'x') + "..."), 1);
+	EXPECT_EQ(CountOccurrences(content, std::string(HEPH_CL_MAX_MESSAGE_LENGTH, 'x')), 0);
+
+	std::filesystem::remove(filePath);
+}
\ No newline at end of file
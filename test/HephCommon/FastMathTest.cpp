@@ -0,0 +1,34 @@
+#include "gtest/gtest.h"
+#include "FastMath.h"
+#include <cmath>
+
+using namespace Heph;
+
+TEST(FastMathTest, Tanh)
+{
+	for (double x = -20.0; x <= 20.0; x += 1e-3)
+	{
+		EXPECT_NEAR(FastMath::Tanh(x), tanh(x), 3e-7);
+	}
+}
+
+TEST(FastMathTest, Atan)
+{
+	for (double x = -100.0; x <= 100.0; x += 1e-3)
+	{
+		EXPECT_NEAR(FastMath::Atan(x), atan(x), 2e-6);
+	}
+}
+
+TEST(FastMathTest, Sin)
+{
+	for (double x = -1e4; x <= 1e4; x += 1e-1)
+	{
+		EXPECT_NEAR(FastMath::Sin(x), sin(x), 1e-7);
+	}
+
+	for (float x = -100.0f; x <= 100.0f; x += 1e-2f)
+	{
+		EXPECT_NEAR(FastMath::Sin(x), sin(x), 1e-5);
+	}
+}
\ No newline at end of file
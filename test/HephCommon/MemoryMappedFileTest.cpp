@@ -0,0 +1,60 @@
+#include "gtest/gtest.h"
+#include "MemoryMappedFile.h"
+#include "Exceptions/NotFoundException.h"
+#include <cstdio>
+#include <cstring>
+
+using namespace Heph;
+
+TEST(MemoryMappedFileTest, Open)
+{
+	const std::filesystem::path filePath = std::filesystem::temp_directory_path() / "HephCommonMemoryMappedFileTest.bin";
+	const char content[] = "memory mapped file";
+
+	FILE* pFile = fopen(filePath.string().c_str(), "wb");
+	ASSERT_NE(pFile, nullptr);
+	fwrite(content, 1, sizeof(content), pFile);
+	fclose(pFile);
+
+	{
+		MemoryMappedFile file(filePath);
+		EXPECT_TRUE(file.IsOpen());
+		ASSERT_EQ(file.Size(), sizeof(content));
+		ASSERT_NE(file.Data(), nullptr);
+		EXPECT_EQ(memcmp(file.Data(), content, sizeof(content)), 0);
+
+		MemoryMappedFile movedFile(std::move(file));
+		EXPECT_FALSE(file.IsOpen());
+		EXPECT_EQ(file.Data(), nullptr);
+		EXPECT_TRUE(movedFile.IsOpen());
+		EXPECT_EQ(memcmp(movedFile.Data(), content, sizeof(content)), 0);
+
+		movedFile.Close();
+		EXPECT_FALSE(movedFile.IsOpen());
+		EXPECT_EQ(movedFile.Size(), 0);
+	}
+
+	std::filesystem::remove(filePath);
+
+	MemoryMappedFile file;
+	EXPECT_THROW(file.Open(filePath), NotFoundException);
+	EXPECT_FALSE(file.IsOpen());
+}
+
+TEST(MemoryMappedFileTest, EmptyFile)
+{
+	const std::filesystem::path filePath = std::filesystem::temp_directory_path() / "HephCommonMemoryMappedFileTestEmpty.bin";
+
+	FILE* pFile = fopen(filePath.string().c_str(), "wb");
+	ASSERT_NE(pFile, nullptr);
+	fclose(pFile);
+
+	{
+		MemoryMappedFile file(filePath);
+		EXPECT_TRUE(file.IsOpen());
+		EXPECT_EQ(file.Size(), 0);
+		EXPECT_EQ(file.Data(), nullptr);
+	}
+
+	std::filesystem::remove(filePath);
+}
\ No newline at end of file
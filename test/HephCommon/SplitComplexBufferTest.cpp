@@ -0,0 +1,171 @@
+#include "gtest/gtest.h"
+#include "Buffers/SplitComplexBuffer.h"
+#include "Fourier.h"
+#include "Exceptions/InvalidArgumentException.h"
+#include <cmath>
+#include <vector>
+
+using namespace Heph;
+
+static ComplexBuffer CreateComplexTestBuffer(size_t size, double phase)
+{
+	ComplexBuffer b(size);
+	for (size_t i = 0; i < size; ++i)
+	{
+		b[i] = Complex(sin(i * 0.3 + phase), cos(i * 0.17 - phase) * 0.5);
+	}
+	return b;
+}
+
+TEST(SplitComplexBufferTest, Constructors)
+{
+	{
+		SplitComplexBuffer b;
+		EXPECT_EQ(b.Size(), 0);
+		EXPECT_TRUE(b.IsEmpty());
+		EXPECT_TRUE(b.Real() == nullptr);
+	}
+
+	{
+		SplitComplexFloatBuffer b(7);
+		EXPECT_EQ(b.Size(), 7);
+		EXPECT_EQ(b.Imag(), b.Real() + 7);
+		for (size_t i = 0; i < b.Size(); ++i)
+		{
+			EXPECT_EQ(b.Get(i), Complex());
+		}
+	}
+
+	{
+		const ComplexBuffer complexBuffer = CreateComplexTestBuffer(9, 0.2);
+		const SplitComplexBuffer b1(complexBuffer);
+		EXPECT_EQ(b1.ToComplexBuffer(), complexBuffer);
+
+		SplitComplexBuffer b2(b1);
+		EXPECT_EQ(b1, b2);
+
+		SplitComplexBuffer b3(std::move(b2));
+		EXPECT_EQ(b1, b3);
+		EXPECT_TRUE(b2.IsEmpty());
+
+		b3.Resize(12);
+		EXPECT_EQ(b3.Get(8), complexBuffer[8]);
+		EXPECT_EQ(b3.Get(11), Complex());
+		EXPECT_THROW(b3.Get(12), InvalidArgumentException);
+	}
+}
+
+TEST(SplitComplexBufferTest, Arithmetic)
+{
+	// odd size to cover the scalar tails of the vectorized kernels.
+	const size_t size = 37;
+	const ComplexBuffer lhs = CreateComplexTestBuffer(size, 0.4);
+	const ComplexBuffer rhs = CreateComplexTestBuffer(size, 1.3);
+
+	{
+		SplitComplexBuffer b(lhs);
+		b.Multiply(SplitComplexBuffer(rhs));
+		for (size_t i = 0; i < size; ++i)
+		{
+			const Complex expected = lhs[i] * rhs[i];
+			EXPECT_NEAR(b.Get(i).real, expected.real, 1e-12);
+			EXPECT_NEAR(b.Get(i).imag, expected.imag, 1e-12);
+		}
+
+		b.MultiplyAccumulate(SplitComplexBuffer(lhs), SplitComplexBuffer(rhs));
+		b.Scale(0.5);
+		for (size_t i = 0; i < size; ++i)
+		{
+			const Complex expected = lhs[i] * rhs[i];
+			EXPECT_NEAR(b.Get(i).real, expected.real, 1e-12);
+			EXPECT_NEAR(b.Get(i).imag, expected.imag, 1e-12);
+		}
+
+		EXPECT_THROW(b.Multiply(SplitComplexBuffer(size - 1)), InvalidArgumentException);
+	}
+
+	{
+		SplitComplexFloatBuffer b(lhs);
+		b.Multiply(SplitComplexFloatBuffer(rhs));
+		for (size_t i = 0; i < size; ++i)
+		{
+			const Complex expected = lhs[i] * rhs[i];
+			EXPECT_NEAR(b.Get(i).real, expected.real, 1e-5);
+			EXPECT_NEAR(b.Get(i).imag, expected.imag, 1e-5);
+		}
+	}
+
+	{
+		SplitComplexBuffer b(lhs);
+		std::vector<double> magnitude(size), phase(size);
+		b.Magnitude(magnitude.data());
+		b.Phase(phase.data());
+		b.Conjugate();
+		for (size_t i = 0; i < size; ++i)
+		{
+			EXPECT_NEAR(magnitude[i], lhs[i].Magnitude(), 1e-12);
+			EXPECT_NEAR(phase[i], lhs[i].Phase(), 1e-12);
+			EXPECT_EQ(b.Get(i), lhs[i].Conjugate());
+		}
+	}
+}
+
+TEST(SplitComplexBufferTest, FFT)
+{
+	const ComplexBuffer input = CreateComplexTestBuffer(64, 0.7);
+
+	ComplexBuffer expected = input;
+	Fourier::FFT(expected);
+
+	SplitComplexBuffer b(input);
+	Fourier::FFT(b);
+	for (size_t i = 0; i < b.Size(); ++i)
+	{
+		EXPECT_NEAR(b.Get(i).real, expected[i].real, 1e-9);
+		EXPECT_NEAR(b.Get(i).imag, expected[i].imag, 1e-9);
+	}
+
+	SplitComplexFloatBuffer f(input);
+	Fourier::FFT(f);
+	for (size_t i = 0; i < f.Size(); ++i)
+	{
+		EXPECT_NEAR(f.Get(i).real, expected[i].real, 1e-4);
+		EXPECT_NEAR(f.Get(i).imag, expected[i].imag, 1e-4);
+	}
+
+	Fourier::IFFT(b, true);
+	Fourier::IFFT(f, true);
+	for (size_t i = 0; i < b.Size(); ++i)
+	{
+		EXPECT_NEAR(b.Get(i).real, input[i].real, 1e-9);
+		EXPECT_NEAR(b.Get(i).imag, input[i].imag, 1e-9);
+		EXPECT_NEAR(f.Get(i).real, input[i].real, 1e-5);
+		EXPECT_NEAR(f.Get(i).imag, input[i].imag, 1e-5);
+	}
+
+	// the buffer is padded to the next power of 2.
+	SplitComplexBuffer padded(input);
+	Fourier::FFT(padded, 100);
+	EXPECT_EQ(padded.Size(), 128);
+}
+
+TEST(SplitComplexBufferTest, Convolve)
+{
+	const DoubleBuffer source = { 1, 2, 3, 4, 5 };
+	const DoubleBuffer kernel = { 1, -1, 0.5 };
+	const DoubleBuffer result = Fourier::Convolve(source, kernel);
+
+	ASSERT_EQ(result.Size(), source.Size() + kernel.Size() - 1);
+	for (size_t i = 0; i < result.Size(); ++i)
+	{
+		double expected = 0;
+		for (size_t j = 0; j < kernel.Size(); ++j)
+		{
+			if (i >= j && (i - j) < source.Size())
+			{
+				expected += source[i - j] * kernel[j];
+			}
+		}
+		EXPECT_NEAR(result[i], expected, 1e-9);
+	}
+}
\ No newline at end of file
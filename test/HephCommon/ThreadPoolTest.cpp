@@ -0,0 +1,80 @@
+#include "gtest/gtest.h"
+#include "ThreadPool.h"
+#include <atomic>
+#include <future>
+#include <stdexcept>
+
+using namespace Heph;
+
+TEST(ThreadPoolTest, Constructor)
+{
+	ThreadPool pool(3);
+	EXPECT_EQ(pool.GetMaxThreadCount(), 3);
+	EXPECT_EQ(pool.GetThreadCount(), 0);
+	EXPECT_EQ(pool.GetPendingTaskCount(), 0);
+
+	ThreadPool defaultPool(0);
+	EXPECT_GE(defaultPool.GetMaxThreadCount(), 1);
+}
+
+TEST(ThreadPoolTest, Submit)
+{
+	constexpr size_t taskCount = 1000;
+	std::atomic<size_t> counter(0);
+	std::promise<void> done;
+	{
+		ThreadPool pool(4);
+		for (size_t i = 0; i < taskCount; ++i)
+		{
+			pool.Submit([&counter, &done]()
+				{
+					if (++counter == taskCount)
+					{
+						done.set_value();
+					}
+				});
+		}
+		done.get_future().wait();
+		EXPECT_LE(pool.GetThreadCount(), 4);
+	}
+	EXPECT_EQ(counter, taskCount);
+}
+
+TEST(ThreadPoolTest, Exception)
+{
+	ThreadPool pool(1);
+	std::promise<int> result;
+
+	// the worker survives a throwing task.
+	pool.Submit([]() { throw std::runtime_error("task failed"); });
+	pool.Submit([&result]() { result.set_value(5); });
+	EXPECT_EQ(result.get_future().get(), 5);
+	EXPECT_EQ(pool.GetThreadCount(), 1);
+}
+
+TEST(ThreadPoolTest, Discard)
+{
+	std::promise<void> started;
+	std::promise<void> release;
+	std::shared_future<void> releaseFuture = release.get_future().share();
+	std::future<void> discardedFuture;
+	{
+		ThreadPool pool(1);
+		std::shared_ptr<std::promise<void>> pDiscarded = std::make_shared<std::promise<void>>();
+		discardedFuture = pDiscarded->get_future();
+
+		pool.Submit([&started, releaseFuture]()
+			{
+				started.set_value();
+				releaseFuture.wait();
+			});
+		pool.Submit([pDiscarded]() { pDiscarded->set_value(); });
+
+		started.get_future().wait();
+		EXPECT_EQ(pool.GetPendingTaskCount(), 1);
+		release.set_value();
+
+		// the second task may or may not start before the pool is destroyed.
+	}
+	EXPECT_EQ(discardedFuture.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+}
\ No newline at end of file
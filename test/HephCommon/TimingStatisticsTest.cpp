@@ -0,0 +1,134 @@
+#include "gtest/gtest.h"
+#include "TimingStatistics.h"
+#include <thread>
+#include <vector>
+
+using namespace Heph;
+
+TEST(TimingStatisticsTest, Constructor)
+{
+	TimingStatistics ts;
+	const TimingStatisticsSnapshot snapshot = ts.GetSnapshot();
+
+	EXPECT_EQ(snapshot.count, 0);
+	EXPECT_EQ(snapshot.total_ns, 0);
+	EXPECT_EQ(snapshot.min_ns, 0);
+	EXPECT_EQ(snapshot.max_ns, 0);
+	EXPECT_EQ(snapshot.last_ns, 0);
+	EXPECT_EQ(snapshot.GetMean_ns(), 0.0);
+	EXPECT_EQ(snapshot.GetPercentile_ns(50), 0);
+	for (size_t i = 0; i < HEPH_TIMING_STATISTICS_BUCKET_COUNT; ++i)
+	{
+		EXPECT_EQ(snapshot.histogram[i], 0);
+	}
+}
+
+TEST(TimingStatisticsTest, Record)
+{
+	TimingStatistics ts;
+	ts.Record(500);
+	ts.Record(3000);
+	ts.Record(std::chrono::microseconds(10));
+
+	const TimingStatisticsSnapshot snapshot = ts.GetSnapshot();
+	EXPECT_EQ(snapshot.count, 3);
+	EXPECT_EQ(snapshot.total_ns, 13500);
+	EXPECT_EQ(snapshot.min_ns, 500);
+	EXPECT_EQ(snapshot.max_ns, 10000);
+	EXPECT_EQ(snapshot.last_ns, 10000);
+	EXPECT_DOUBLE_EQ(snapshot.GetMean_ns(), 4500.0);
+	EXPECT_EQ(snapshot.histogram[0], 1);
+	EXPECT_EQ(snapshot.histogram[2], 1);
+	EXPECT_EQ(snapshot.histogram[4], 1);
+}
+
+TEST(TimingStatisticsTest, Buckets)
+{
+	EXPECT_EQ(TimingStatistics::GetBucketIndex(0), 0);
+	EXPECT_EQ(TimingStatistics::GetBucketIndex(999), 0);
+	EXPECT_EQ(TimingStatistics::GetBucketIndex(1000), 1);
+	EXPECT_EQ(TimingStatistics::GetBucketIndex(1999), 1);
+	EXPECT_EQ(TimingStatistics::GetBucketIndex(2000), 2);
+	EXPECT_EQ(TimingStatistics::GetBucketIndex(UINT64_MAX), HEPH_TIMING_STATISTICS_BUCKET_COUNT - 1);
+
+	for (size_t i = 0; i < HEPH_TIMING_STATISTICS_BUCKET_COUNT - 1; ++i)
+	{
+		const uint64_t upperBound = TimingStatistics::GetBucketUpperBound_ns(i);
+		EXPECT_EQ(TimingStatistics::GetBucketIndex(upperBound - 1), i);
+		EXPECT_EQ(TimingStatistics::GetBucketIndex(upperBound), i + 1);
+	}
+	EXPECT_EQ(TimingStatistics::GetBucketUpperBound_ns(HEPH_TIMING_STATISTICS_BUCKET_COUNT - 1), UINT64_MAX);
+}
+
+TEST(TimingStatisticsTest, Percentile)
+{
+	TimingStatistics ts;
+	for (size_t i = 0; i < 99; ++i)
+	{
+		ts.Record(1500);
+	}
+	ts.Record(100000);
+
+	const TimingStatisticsSnapshot snapshot = ts.GetSnapshot();
+	EXPECT_EQ(snapshot.GetPercentile_ns(50), 2000);
+	EXPECT_EQ(snapshot.GetPercentile_ns(99), 2000);
+	EXPECT_EQ(snapshot.GetPercentile_ns(100), 100000);
+}
+
+TEST(TimingStatisticsTest, Reset)
+{
+	TimingStatistics ts;
+	ts.Record(1000);
+	ts.Reset();
+
+	const TimingStatisticsSnapshot snapshot = ts.GetSnapshot();
+	EXPECT_EQ(snapshot.count, 0);
+	EXPECT_EQ(snapshot.total_ns, 0);
+	EXPECT_EQ(snapshot.min_ns, 0);
+	EXPECT_EQ(snapshot.max_ns, 0);
+	EXPECT_EQ(snapshot.histogram[1], 0);
+}
+
+TEST(TimingStatisticsTest, Copy)
+{
+	TimingStatistics ts1;
+	ts1.Record(1000);
+
+	TimingStatistics ts2(ts1);
+	EXPECT_EQ(ts2.GetSnapshot().count, 1);
+	EXPECT_EQ(ts2.GetSnapshot().total_ns, 1000);
+
+	TimingStatistics ts3;
+	ts3 = ts1;
+	EXPECT_EQ(ts3.GetSnapshot().max_ns, 1000);
+}
+
+TEST(TimingStatisticsTest, Concurrent)
+{
+	constexpr size_t threadCount = 4;
+	constexpr size_t recordCount = 10000;
+	TimingStatistics ts;
+	std::vector<std::thread> threads(threadCount);
+
+	for (size_t i = 0; i < threadCount; ++i)
+	{
+		threads[i] = std::thread([&ts, i]()
+			{
+				for (size_t j = 0; j < recordCount; ++j)
+				{
+					ts.Record((i + 1) * 1000);
+				}
+			});
+	}
+
+	for (std::thread& t : threads)
+	{
+		t.join();
+	}
+
+	const TimingStatisticsSnapshot snapshot = ts.GetSnapshot();
+	EXPECT_EQ(snapshot.count, threadCount * recordCount);
+	EXPECT_EQ(snapshot.total_ns, (1 + 2 + 3 + 4) * 1000 * recordCount);
+	EXPECT_EQ(snapshot.min_ns, 1000);
+	EXPECT_EQ(snapshot.max_ns, 4000);
+}
\ No newline at end of file